@@ -60,7 +60,7 @@ KOBO_POWER_OFF_SOURCES = \
 	$(SRC)/Kobo/Model.cpp \
 	$(SRC)/Kobo/PowerOff.cpp
 KOBO_POWER_OFF_LDADD = $(FAKE_LIBS)
-KOBO_POWER_OFF_DEPENDS = SCREEN EVENT RESOURCE IO ASYNC OS MATH UTIL TIME
+KOBO_POWER_OFF_DEPENDS = SCREEN EVENT RESOURCE IO ASYNC OS THREAD MATH UTIL TIME
 KOBO_POWER_OFF_STRIP = y
 $(eval $(call link-program,PowerOff,KOBO_POWER_OFF))
 OPTIONAL_OUTPUTS += $(KOBO_POWER_OFF_BIN)
@@ -6,6 +6,8 @@ TIME_SOURCES = \
 	$(TIME_SRC_DIR)/Convert.cxx \
 	$(TIME_SRC_DIR)/DeltaTime.cpp \
 	$(TIME_SRC_DIR)/WrapClock.cpp \
+	$(TIME_SRC_DIR)/LatencyTrace.cpp \
+	$(TIME_SRC_DIR)/Instrument.cpp \
 	$(TIME_SRC_DIR)/LocalTime.cpp \
 	$(TIME_SRC_DIR)/BrokenTime.cpp \
 	$(TIME_SRC_DIR)/BrokenDate.cpp \
@@ -13,6 +13,7 @@ LUA_SOURCES = \
 	$(SRC)/lua/Ptr.cpp \
 	$(SRC)/lua/Error.cxx \
 	$(SRC)/lua/Catch.cpp \
+	$(SRC)/lua/FieldIndex.cpp \
 	$(SRC)/lua/Persistent.cpp \
 	$(SRC)/lua/Background.cpp \
 	$(SRC)/lua/Associate.cpp \
@@ -34,6 +35,7 @@ LUA_SOURCES = \
 	$(SRC)/lua/Logger.cpp \
 	$(SRC)/lua/Tracking.cpp \
 	$(SRC)/lua/Replay.cpp \
+	$(SRC)/lua/Instrument.cpp \
 	$(SRC)/lua/InputEvent.cpp \
 
 LUA_CPPFLAGS_INTERNAL = $(LIBLUA_CPPFLAGS) $(SCREEN_CPPFLAGS)
@@ -63,6 +63,7 @@ DIALOG_SOURCES = \
 	$(SRC)/Dialogs/FilePicker.cpp \
 	$(SRC)/Dialogs/HelpDialog.cpp \
 	$(SRC)/Dialogs/dlgInfoBoxAccess.cpp \
+	$(SRC)/Dialogs/dlgInstrument.cpp \
 	$(SRC)/Dialogs/ReplayDialog.cpp \
 	$(SRC)/Dialogs/dlgSimulatorPrompt.cpp \
 	$(SRC)/Dialogs/SimulatorPromptWindow.cpp \
@@ -178,6 +179,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Task/RoutePlannerGlue.cpp \
 	$(SRC)/Task/ProtectedRoutePlanner.cpp \
 	$(SRC)/Task/TaskStore.cpp \
+	$(SRC)/Task/TaskIndex.cpp \
 	$(SRC)/Task/TypeStrings.cpp \
 	$(SRC)/Task/ValidationErrorStrings.cpp \
 	\
@@ -249,6 +251,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/FLARM/Global.cpp \
 	$(SRC)/FLARM/Glue.cpp \
 	$(SRC)/Computer/CuComputer.cpp \
+	$(SRC)/Computer/CorridorComputer.cpp \
 	$(SRC)/Computer/FlyingComputer.cpp \
 	$(SRC)/Computer/CirclingComputer.cpp \
 	$(SRC)/Computer/ThermalBandComputer.cpp \
@@ -265,6 +268,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Computer/GlideRatioComputer.cpp \
 	$(SRC)/Computer/GlideComputer.cpp \
 	$(SRC)/Computer/GlideComputerBlackboard.cpp \
+	$(SRC)/Computer/IdleScheduler.cpp \
 	$(SRC)/Computer/GlideComputerAirData.cpp \
 	$(SRC)/Computer/WaveComputer.cpp \
 	$(SRC)/Computer/StatsComputer.cpp \
@@ -279,6 +283,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
 	$(SRC)/Logger/LoggerImpl.cpp \
+	$(SRC)/Logger/LogWriterThread.cpp \
 	$(SRC)/Logger/IGCFileCleanup.cpp \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
@@ -446,6 +451,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Renderer/TaskRenderer.cpp \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
+	$(SRC)/Renderer/AirspaceScreenCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
@@ -487,6 +493,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/MapWindow/MapWindowContest.cpp \
 	$(SRC)/MapWindow/MapWindowTask.cpp \
 	$(SRC)/MapWindow/MapWindowThermal.cpp \
+	$(SRC)/Thermal/HotspotDatabase.cpp \
 	$(SRC)/MapWindow/MapWindowTraffic.cpp \
 	$(SRC)/MapWindow/MapWindowTrail.cpp \
 	$(SRC)/MapWindow/MapWindowWaypoints.cpp \
@@ -495,6 +502,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/MapWindow/GlueMapWindowEvents.cpp \
 	$(SRC)/MapWindow/GlueMapWindowOverlays.cpp \
 	$(SRC)/MapWindow/GlueMapWindowDisplayMode.cpp \
+	$(SRC)/MapWindow/Prefetch.cpp \
 	$(SRC)/MapWindow/TargetMapWindow.cpp \
 	$(SRC)/MapWindow/TargetMapWindowEvents.cpp \
 	$(SRC)/MapWindow/TargetMapWindowDrag.cpp \
@@ -538,6 +546,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/DisplayMode.cpp \
 	\
 	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/CompiledTopography.cpp \
 	$(SRC)/Topography/TopographyStore.cpp \
 	$(SRC)/Topography/TopographyFileRenderer.cpp \
 	$(SRC)/Topography/TopographyRenderer.cpp \
@@ -20,6 +20,12 @@ ifeq ($(STOP_WATCH),y)
 TARGET_CPPFLAGS += -DSTOP_WATCH
 endif
 
+# record hot path timers and counters? (see src/time/Instrument.hpp)
+INSTRUMENT ?= n
+ifeq ($(INSTRUMENT),y)
+TARGET_CPPFLAGS += -DINSTRUMENT
+endif
+
 # compile without UI?
 HEADLESS ?= n
 
@@ -71,6 +71,7 @@ endif
 ifeq ($(FREETYPE),y)
 SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/freetype/Font.cpp \
+	$(CANVAS_SRC_DIR)/freetype/GlyphCache.cpp \
 	$(CANVAS_SRC_DIR)/freetype/Init.cpp
 endif
 
@@ -219,7 +220,8 @@ SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/memory/RawBitmap.cpp \
 	$(CANVAS_SRC_DIR)/memory/VirtualCanvas.cpp \
 	$(CANVAS_SRC_DIR)/memory/SubCanvas.cpp \
-	$(CANVAS_SRC_DIR)/memory/Canvas.cpp
+	$(CANVAS_SRC_DIR)/memory/Canvas.cpp \
+	$(CANVAS_SRC_DIR)/memory/RenderQueue.cpp
 MEMORY_CANVAS_CPPFLAGS = -DUSE_MEMORY_CANVAS
 endif
 
@@ -96,12 +96,20 @@ TEST_NAMES = \
 	TestValidity TestUTM TestProfile \
 	TestAllocatedGrid \
 	TestRadixTree TestGeoBounds TestGeoClip \
-	TestLogger TestGRecord TestDriver TestClimbAvCalc \
+	TestCompiledTopography \
+	TestArcTessellator \
+	TestLogger TestLogWriterThread TestGRecord TestDriver TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
 	TestFlarmNet \
+	TestTrafficList \
 	TestColorRamp TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
+	TestAirspaceScreenCache \
+	TestPackedRTree \
+	TestLatencyTrace \
+	TestInstrument \
+	TestIdleScheduler \
 	TestMacCready TestOrderedTask TestAATPoint \
 	TestPlanes \
 	TestTaskPoint \
@@ -122,8 +130,21 @@ TEST_NAMES = \
 	TestLXNToIGC \
 	TestLeastSquares \
 	TestHexString \
-	TestThermalBand
+	TestThermalBand \
+	TestTaskIndex \
+	TestHotspotDatabase
 
+ifeq ($(LUA),y)
+TEST_NAMES += TestLuaBindings
+endif
+
+ifeq ($(TARGET)$(HOST_IS_X86_64),UNIXy)
+TEST_NAMES += TestAVX2
+endif
+
+ifeq ($(USE_MEMORY_CANVAS),y)
+TEST_NAMES += TestRenderQueue
+endif
 
 TESTS = $(call name-to-bin,$(TEST_NAMES))
 
@@ -390,6 +411,13 @@ TEST_GEO_BOUNDS_SOURCES = \
 TEST_GEO_BOUNDS_DEPENDS = GEO MATH
 $(eval $(call link-program,TestGeoBounds,TEST_GEO_BOUNDS))
 
+TEST_COMPILED_TOPOGRAPHY_SOURCES = \
+	$(SRC)/Topography/CompiledTopography.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestCompiledTopography.cpp
+TEST_COMPILED_TOPOGRAPHY_DEPENDS = IO ZZIP OS GEO MATH UTIL
+$(eval $(call link-program,TestCompiledTopography,TEST_COMPILED_TOPOGRAPHY))
+
 TEST_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/FlarmNetReader.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
@@ -400,12 +428,47 @@ TEST_FLARM_NET_SOURCES = \
 TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_TRAFFIC_LIST_SOURCES = \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficList.cpp
+TEST_TRAFFIC_LIST_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestTrafficList,TEST_TRAFFIC_LIST))
+
+TEST_AVX2_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAVX2.cpp
+$(eval $(call link-program,TestAVX2,TEST_AVX2))
+
+# only this object may use AVX2 instructions; the test checks at
+# run time whether the CPU supports them
+$(call SRC_TO_OBJ,$(TEST_SRC_DIR)/TestAVX2.cpp): CXXFLAGS += -mavx2
+
+TEST_RENDER_QUEUE_SOURCES = \
+	$(SRC)/Hardware/CPU.cpp \
+	$(SRC)/ui/event/Idle.cpp \
+	$(SRC)/Look/FontDescription.cpp \
+	$(TEST_SRC_DIR)/FakeAsset.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRenderQueue.cpp
+TEST_RENDER_QUEUE_CPPFLAGS = $(SCREEN_CPPFLAGS)
+TEST_RENDER_QUEUE_DEPENDS = SCREEN EVENT MATH ASYNC OS IO THREAD UTIL
+$(eval $(call link-program,TestRenderQueue,TEST_RENDER_QUEUE))
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
 TEST_GEO_CLIP_DEPENDS = GEO MATH
 $(eval $(call link-program,TestGeoClip,TEST_GEO_CLIP))
 
+TEST_ARC_TESSELLATOR_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestArcTessellator.cpp
+TEST_ARC_TESSELLATOR_DEPENDS = GEO MATH
+$(eval $(call link-program,TestArcTessellator,TEST_ARC_TESSELLATOR))
+
 TEST_CLIMB_AV_CALC_SOURCES = \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -413,6 +476,17 @@ TEST_CLIMB_AV_CALC_SOURCES = \
 TEST_CLIMB_AV_CALC_DEPENDS = MATH
 $(eval $(call link-program,TestClimbAvCalc,TEST_CLIMB_AV_CALC))
 
+TEST_AIRSPACE_SCREEN_CACHE_SOURCES = \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Renderer/AirspaceScreenCache.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceScreenCache.cpp
+TEST_AIRSPACE_SCREEN_CACHE_DEPENDS = AIRSPACE GEO MATH UTIL
+TEST_AIRSPACE_SCREEN_CACHE_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,TestAirspaceScreenCache,TEST_AIRSPACE_SCREEN_CACHE))
+
 TEST_PROJECTION_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -452,7 +526,7 @@ TEST_HEX_COLOR_FORMATTER_SOURCES = \
 	$(SRC)/Formatter/HexColor.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestHexColorFormatter.cpp
-TEST_HEX_COLOR_FORMATTER_DEPENDS = MATH SCREEN EVENT UTIL
+TEST_HEX_COLOR_FORMATTER_DEPENDS = MATH SCREEN EVENT THREAD UTIL
 $(eval $(call link-program,TestHexColorFormatter,TEST_HEX_COLOR_FORMATTER))
 
 TEST_BYTE_SIZE_FORMATTER_SOURCES = \
@@ -525,6 +599,22 @@ TEST_FILE_UTIL_SOURCES = \
 TEST_FILE_UTIL_DEPENDS = UTIL
 $(eval $(call link-program,TestFileUtil,TEST_FILE_UTIL))
 
+TEST_TASK_INDEX_SOURCES = \
+	$(SRC)/Task/TaskIndex.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTaskIndex.cpp
+TEST_TASK_INDEX_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestTaskIndex,TEST_TASK_INDEX))
+
+TEST_HOTSPOT_DATABASE_SOURCES = \
+	$(SRC)/Thermal/HotspotDatabase.cpp \
+	$(SRC)/system/FileUtil.cpp \
+	$(SRC)/system/Path.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestHotspotDatabase.cpp
+TEST_HOTSPOT_DATABASE_DEPENDS = IO OS GEO MATH UTIL
+$(eval $(call link-program,TestHotspotDatabase,TEST_HOTSPOT_DATABASE))
+
 TEST_GEO_POINT_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoPoint.cpp
@@ -549,6 +639,31 @@ TEST_FLAT_GEO_POINT_SOURCES = \
 TEST_FLAT_GEO_POINT_DEPENDS = GEO MATH
 $(eval $(call link-program,TestFlatGeoPoint,TEST_FLAT_GEO_POINT))
 
+TEST_PACKED_RTREE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPackedRTree.cpp
+TEST_PACKED_RTREE_DEPENDS = GEO MATH
+$(eval $(call link-program,TestPackedRTree,TEST_PACKED_RTREE))
+
+TEST_LATENCY_TRACE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLatencyTrace.cpp
+TEST_LATENCY_TRACE_DEPENDS = TIME UTIL
+$(eval $(call link-program,TestLatencyTrace,TEST_LATENCY_TRACE))
+
+TEST_INSTRUMENT_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestInstrument.cpp
+TEST_INSTRUMENT_DEPENDS = TIME UTIL
+$(eval $(call link-program,TestInstrument,TEST_INSTRUMENT))
+
+TEST_IDLE_SCHEDULER_SOURCES = \
+	$(SRC)/Computer/IdleScheduler.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestIdleScheduler.cpp
+TEST_IDLE_SCHEDULER_DEPENDS = UTIL
+$(eval $(call link-program,TestIdleScheduler,TEST_IDLE_SCHEDULER))
+
 TEST_FLAT_LINE_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestFlatLine.cpp
@@ -616,14 +731,25 @@ TEST_LOGGER_SOURCES = \
 	$(SRC)/Logger/LoggerFRecord.cpp \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
+	$(SRC)/Logger/LogWriterThread.cpp \
 	$(SRC)/util/MD5.cpp \
 	$(SRC)/Version.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLogger.cpp
-TEST_LOGGER_DEPENDS = IO OS GEO MATH UTIL
+TEST_LOGGER_DEPENDS = IO OS GEO MATH THREAD UTIL
 $(eval $(call link-program,TestLogger,TEST_LOGGER))
 
+TEST_LOG_WRITER_THREAD_SOURCES = \
+	$(SRC)/Logger/GRecord.cpp \
+	$(SRC)/Logger/LogWriterThread.cpp \
+	$(SRC)/util/MD5.cpp \
+	$(SRC)/Version.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLogWriterThread.cpp
+TEST_LOG_WRITER_THREAD_DEPENDS = IO OS THREAD UTIL
+$(eval $(call link-program,TestLogWriterThread,TEST_LOG_WRITER_THREAD))
+
 TEST_GRECORD_SOURCES = \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/util/MD5.cpp \
@@ -728,6 +854,12 @@ DEBUG_PROGRAM_NAMES = \
 	FlightPath \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkAirspaces \
+	BenchmarkNMEAParser \
+	BenchmarkFlarmTraffic \
+	BenchmarkAudioVario \
+	BenchmarkWorkerThread \
+	BenchmarkBlackboard \
 	DumpTextFile DumpTextZip DumpTextInflate WriteTextFile RunTextWriter \
 	DumpHexColor \
 	RunXMLParser \
@@ -737,7 +869,7 @@ DEBUG_PROGRAM_NAMES = \
 	ReadGRecord VerifyGRecord AppendGRecord FixGRecord \
 	AddChecksum \
 	KeyCodeDumper \
-	LoadTopography LoadTerrain \
+	LoadTopography BenchmarkTopography LoadTerrain BenchmarkRasp BenchmarkTaskStore \
 	RunHeightMatrix \
 	RunInputParser \
 	RunWaypointParser RunAirspaceParser \
@@ -751,9 +883,13 @@ DEBUG_PROGRAM_NAMES = \
 	RunIGCWriter \
 	RunFlightLogger RunFlyingComputer \
 	RunCirclingWind RunWindEKF RunWindComputer \
+	BuildThermalHotspots \
+	RunMapPrefetch \
+	RunCorridorProfile \
 	RunExternalWind \
 	RunTask \
 	LoadImage ViewImage \
+	BenchmarkText \
 	RunCanvas RunMapWindow \
 	RunListControl \
 	RunTextEntry RunNumberEntry RunTimeEntry RunAngleEntry \
@@ -769,10 +905,12 @@ DEBUG_PROGRAM_NAMES = \
 	RunProgressWindow \
 	RunJobDialog \
 	RunAnalysis \
+	RunInstrumentReplay \
 	RunAirspaceWarningDialog \
 	RunProfileListDialog \
 	TestNotify \
 	FeedNMEA \
+	LatencyReport \
 	FeedVega EmulateDevice \
 	DebugDisplay \
 	RunVegaSettings \
@@ -786,6 +924,15 @@ DEBUG_PROGRAM_NAMES = \
 	RunKalmanFilter1d \
 	ArcApprox
 
+ifeq ($(OPENGL),y)
+DEBUG_PROGRAM_NAMES += CompileTopography
+endif
+
+ifeq ($(USE_MEMORY_CANVAS),y)
+DEBUG_PROGRAM_NAMES += BenchmarkCanvas
+DEBUG_PROGRAM_NAMES += BenchmarkMapWindow
+endif
+
 ifeq ($(TARGET),UNIX)
 DEBUG_PROGRAM_NAMES += \
 	AnalyseFlight \
@@ -921,6 +1068,11 @@ ARC_APPROX_SOURCES = \
 ARC_APPROX_DEPENDS = UTIL GEO MATH
 $(eval $(call link-program,ArcApprox,ARC_APPROX))
 
+LATENCY_REPORT_SOURCES = \
+	$(TEST_SRC_DIR)/LatencyReport.cpp
+LATENCY_REPORT_DEPENDS = TIME IO OS UTIL
+$(eval $(call link-program,LatencyReport,LATENCY_REPORT))
+
 DUMP_TEXT_ZIP_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextZip.cpp
 DUMP_TEXT_ZIP_DEPENDS = IO ZZIP UTIL
@@ -934,7 +1086,7 @@ $(eval $(call link-program,DumpTextInflate,DUMP_TEXT_INFLATE))
 DUMP_HEX_COLOR_SOURCES = \
 	$(SRC)/Formatter/HexColor.cpp \
 	$(TEST_SRC_DIR)/DumpHexColor.cpp
-DUMP_HEX_COLOR_DEPENDS = SCREEN EVENT UTIL
+DUMP_HEX_COLOR_DEPENDS = SCREEN EVENT THREAD UTIL
 $(eval $(call link-program,DumpHexColor,DUMP_HEX_COLOR))
 
 DEBUG_DISPLAY_SOURCES = \
@@ -1124,6 +1276,7 @@ $(eval $(call link-program,KeyCodeDumper,KEY_CODE_DUMPER))
 LOAD_TOPOGRAPHY_SOURCES = \
 	$(SRC)/Topography/TopographyStore.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/CompiledTopography.cpp \
 	$(SRC)/Topography/XShape.cpp \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
@@ -1137,6 +1290,40 @@ LOAD_TOPOGRAPHY_DEPENDS = RESOURCE GEO MATH THREAD IO UTIL SHAPELIB ZZIP
 LOAD_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,LoadTopography,LOAD_TOPOGRAPHY))
 
+BENCHMARK_TOPOGRAPHY_SOURCES = \
+	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/CompiledTopography.cpp \
+	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTopography.cpp
+ifeq ($(OPENGL),y)
+BENCHMARK_TOPOGRAPHY_SOURCES += \
+	$(CANVAS_SRC_DIR)/opengl/Triangulate.cpp
+endif
+BENCHMARK_TOPOGRAPHY_DEPENDS = RESOURCE GEO MATH THREAD IO OS UTIL SHAPELIB ZZIP
+BENCHMARK_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,BenchmarkTopography,BENCHMARK_TOPOGRAPHY))
+
+ifeq ($(OPENGL),y)
+COMPILE_TOPOGRAPHY_SOURCES = \
+	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/CompiledTopography.cpp \
+	$(SRC)/Topography/CompiledTopographyWriter.cpp \
+	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(CANVAS_SRC_DIR)/opengl/Triangulate.cpp \
+	$(TEST_SRC_DIR)/CompileTopography.cpp
+COMPILE_TOPOGRAPHY_DEPENDS = RESOURCE GEO MATH THREAD IO OS UTIL SHAPELIB ZZIP
+COMPILE_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,CompileTopography,COMPILE_TOPOGRAPHY))
+endif
+
 LOAD_TERRAIN_SOURCES = \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/LoadTerrain.cpp
@@ -1144,6 +1331,17 @@ LOAD_TERRAIN_CPPFLAGS = $(SCREEN_CPPFLAGS)
 LOAD_TERRAIN_DEPENDS = TERRAIN GEO MATH OS IO ZZIP UTIL
 $(eval $(call link-program,LoadTerrain,LOAD_TERRAIN))
 
+BENCHMARK_RASP_SOURCES = \
+	$(SRC)/Weather/Rasp/RaspStore.cpp \
+	$(SRC)/Weather/Rasp/RaspCache.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkRasp.cpp
+BENCHMARK_RASP_CPPFLAGS = $(SCREEN_CPPFLAGS)
+BENCHMARK_RASP_DEPENDS = TERRAIN GEO MATH THREAD IO OS ZZIP TIME UTIL
+$(eval $(call link-program,BenchmarkRasp,BENCHMARK_RASP))
+
 RUN_HEIGHT_MATRIX_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
@@ -1228,6 +1426,19 @@ RUN_AIRSPACE_PARSER_LDADD = $(FAKE_LIBS)
 RUN_AIRSPACE_PARSER_DEPENDS = IO OS AIRSPACE ZZIP GEO MATH UTIL
 $(eval $(call link-program,RunAirspaceParser,RUN_AIRSPACE_PARSER))
 
+BENCHMARK_AIRSPACES_SOURCES = \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAirspaces.cpp
+BENCHMARK_AIRSPACES_LDADD = $(FAKE_LIBS)
+BENCHMARK_AIRSPACES_DEPENDS = IO OS AIRSPACE ZZIP GEO MATH UTIL
+$(eval $(call link-program,BenchmarkAirspaces,BENCHMARK_AIRSPACES))
+
 ENUMERATE_PORTS_SOURCES = \
 	$(TEST_SRC_DIR)/EnumeratePorts.cpp
 ENUMERATE_PORTS_DEPENDS = PORT
@@ -1306,6 +1517,136 @@ RUN_DEVICE_DRIVER_SOURCES = \
 RUN_DEVICE_DRIVER_DEPENDS = DRIVER IO OS THREAD GEO MATH UTIL TIME
 $(eval $(call link-program,RunDeviceDriver,RUN_DEVICE_DRIVER))
 
+BENCHMARK_NMEA_PARSER_SOURCES = \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Device/Port/Port.cpp \
+	$(SRC)/Device/Port/NullPort.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/Device/Util/NMEAWriter.cpp \
+	$(SRC)/Device/Util/NMEAReader.cpp \
+	$(SRC)/Device/Config.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/GPSState.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/Generator.cpp \
+	$(SRC)/FLARM/FlarmCalculations.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/Operation/ProxyOperationEnvironment.cpp \
+	$(SRC)/Operation/NoCancelOperationEnvironment.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeMessage.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/BenchmarkNMEAParser.cpp
+BENCHMARK_NMEA_PARSER_DEPENDS = DRIVER IO OS THREAD GEO MATH UTIL TIME
+$(eval $(call link-program,BenchmarkNMEAParser,BENCHMARK_NMEA_PARSER))
+
+BENCHMARK_FLARM_TRAFFIC_SOURCES = \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/FLARM/FlarmComputer.cpp \
+	$(SRC)/FLARM/FlarmCalculations.cpp \
+	$(SRC)/FLARM/FlarmDetails.cpp \
+	$(SRC)/FLARM/FlarmNetRecord.cpp \
+	$(SRC)/FLARM/FlarmNetDatabase.cpp \
+	$(SRC)/FLARM/NameDatabase.cpp \
+	$(SRC)/FLARM/TrafficDatabases.cpp \
+	$(SRC)/FLARM/Global.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(SRC)/Device/Driver/FLARM/StaticParser.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/GPSState.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/BenchmarkFlarmTraffic.cpp
+BENCHMARK_FLARM_TRAFFIC_DEPENDS = IO OS GEO MATH UTIL TIME
+$(eval $(call link-program,BenchmarkFlarmTraffic,BENCHMARK_FLARM_TRAFFIC))
+
+BENCHMARK_CANVAS_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkCanvas.cpp
+BENCHMARK_CANVAS_DEPENDS = SCREEN IO OS THREAD MATH UTIL
+$(eval $(call link-program,BenchmarkCanvas,BENCHMARK_CANVAS))
+
+BENCHMARK_AUDIO_VARIO_SOURCES = \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/GPSState.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/FLARM/FlarmCalculations.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Audio/ToneSynthesiser.cpp \
+	$(SRC)/Audio/VarioSynthesiser.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAudioVario.cpp
+BENCHMARK_AUDIO_VARIO_DEPENDS = DRIVER IO OS THREAD GEO MATH UTIL TIME
+$(eval $(call link-program,BenchmarkAudioVario,BENCHMARK_AUDIO_VARIO))
+
+BENCHMARK_WORKER_THREAD_SOURCES = \
+	$(SRC)/Computer/IdleScheduler.cpp \
+	$(TEST_SRC_DIR)/BenchmarkWorkerThread.cpp
+BENCHMARK_WORKER_THREAD_DEPENDS = THREAD OS UTIL TIME
+$(eval $(call link-program,BenchmarkWorkerThread,BENCHMARK_WORKER_THREAD))
+
+BENCHMARK_BLACKBOARD_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Blackboard/InterfaceBlackboard.cpp \
+	$(SRC)/Blackboard/LiveBlackboard.cpp \
+	$(TEST_SRC_DIR)/BenchmarkBlackboard.cpp
+BENCHMARK_BLACKBOARD_LDADD = $(DEBUG_REPLAY_LDADD)
+BENCHMARK_BLACKBOARD_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,BenchmarkBlackboard,BENCHMARK_BLACKBOARD))
+
+ifeq ($(LUA),y)
+TEST_LUA_BINDINGS_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Blackboard/InterfaceBlackboard.cpp \
+	$(SRC)/Interface.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Formatter/GeoPointFormatter.cpp \
+	$(SRC)/lua/FieldIndex.cpp \
+	$(SRC)/lua/Ptr.cpp \
+	$(SRC)/lua/Geo.cpp \
+	$(SRC)/lua/Blackboard.cpp \
+	$(SRC)/lua/Settings.cpp \
+	$(SRC)/lua/Task.cpp \
+	$(SRC)/lua/Instrument.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLuaBindings.cpp
+TEST_LUA_BINDINGS_LDADD = $(DEBUG_REPLAY_LDADD)
+TEST_LUA_BINDINGS_DEPENDS = LIBLUA TASK ROUTE GLIDE WAYPOINT GEO MATH TIME UTIL
+$(eval $(call link-program,TestLuaBindings,TEST_LUA_BINDINGS))
+endif
+
 RUN_DECLARE_SOURCES = \
 	$(SRC)/Device/Port/ConfiguredPort.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -1547,11 +1888,12 @@ RUN_IGC_WRITER_SOURCES = \
 	$(SRC)/Logger/LoggerFRecord.cpp \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
+	$(SRC)/Logger/LogWriterThread.cpp \
 	$(SRC)/util/MD5.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/RunIGCWriter.cpp
 RUN_IGC_WRITER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_IGC_WRITER_DEPENDS = GEO MATH UTIL
+RUN_IGC_WRITER_DEPENDS = GEO MATH THREAD UTIL
 $(eval $(call link-program,RunIGCWriter,RUN_IGC_WRITER))
 
 RUN_FLIGHT_LOGGER_SOURCES = \
@@ -1583,6 +1925,58 @@ RUN_CIRCLING_WIND_LDADD = $(DEBUG_REPLAY_LDADD)
 RUN_CIRCLING_WIND_DEPENDS = GEO MATH UTIL
 $(eval $(call link-program,RunCirclingWind,RUN_CIRCLING_WIND))
 
+BUILD_THERMAL_HOTSPOTS_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Computer/CirclingComputer.cpp \
+	$(SRC)/Thermal/ClimbDetector.cpp \
+	$(SRC)/Thermal/HotspotDatabase.cpp \
+	$(TEST_SRC_DIR)/BuildThermalHotspots.cpp
+BUILD_THERMAL_HOTSPOTS_LDADD = $(DEBUG_REPLAY_LDADD)
+BUILD_THERMAL_HOTSPOTS_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,BuildThermalHotspots,BUILD_THERMAL_HOTSPOTS))
+
+RUN_CORRIDOR_PROFILE_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Computer/CirclingComputer.cpp \
+	$(SRC)/Computer/CorridorComputer.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(TEST_SRC_DIR)/RunCorridorProfile.cpp
+RUN_CORRIDOR_PROFILE_LDADD = $(TERRAIN_LDADD) $(DEBUG_REPLAY_LDADD)
+RUN_CORRIDOR_PROFILE_DEPENDS = TERRAIN AIRSPACE GLIDE IO OS ZZIP GEO MATH UTIL
+$(eval $(call link-program,RunCorridorProfile,RUN_CORRIDOR_PROFILE))
+
+RUN_MAP_PREFETCH_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Computer/CirclingComputer.cpp \
+	$(SRC)/MapWindow/Prefetch.cpp \
+	$(SRC)/Terrain/RasterTerrain.cpp \
+	$(SRC)/Terrain/Thread.cpp \
+	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/TopographyGlue.cpp \
+	$(SRC)/Topography/CompiledTopography.cpp \
+	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Topography/Thread.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/io/MapFile.cpp \
+	$(SRC)/io/FileCache.cpp \
+	$(SRC)/LocalPath.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/RunMapPrefetch.cpp
+ifeq ($(OPENGL),y)
+RUN_MAP_PREFETCH_SOURCES += \
+	$(CANVAS_SRC_DIR)/opengl/Triangulate.cpp
+endif
+RUN_MAP_PREFETCH_LDADD = $(PROFILE_LDADD) $(DEBUG_REPLAY_LDADD)
+RUN_MAP_PREFETCH_CPPFLAGS = $(SCREEN_CPPFLAGS)
+RUN_MAP_PREFETCH_DEPENDS = RESOURCE TERRAIN GEO MATH THREAD IO OS UTIL SHAPELIB ZZIP
+$(eval $(call link-program,RunMapPrefetch,RUN_MAP_PREFETCH))
+
 RUN_WIND_EKF_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/Computer/CirclingComputer.cpp \
@@ -1641,7 +2035,7 @@ RUN_TASK_SOURCES = \
 	$(TEST_SRC_DIR)/FakeTerrain.cpp \
 	$(TEST_SRC_DIR)/RunTask.cpp
 RUN_TASK_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_TASK_DEPENDS = TASK WAYPOINT GLIDE GEO MATH UTIL IO TIME
+RUN_TASK_DEPENDS = TASK WAYPOINT GLIDE GEO MATH THREAD UTIL IO TIME
 $(eval $(call link-program,RunTask,RUN_TASK))
 
 RUN_TRACE_SOURCES = \
@@ -1728,6 +2122,16 @@ LOAD_IMAGE_LDADD = $(FAKE_LIBS)
 LOAD_IMAGE_DEPENDS = SCREEN RESOURCE EVENT ASYNC OS IO THREAD MATH UTIL
 $(eval $(call link-program,LoadImage,LOAD_IMAGE))
 
+BENCHMARK_TEXT_SOURCES = \
+	$(MORE_SCREEN_SOURCES) \
+	$(SRC)/Compatibility/fmode.c \
+	$(TEST_SRC_DIR)/Fonts.cpp \
+	$(TEST_SRC_DIR)/FakeAsset.cpp \
+	$(TEST_SRC_DIR)/BenchmarkText.cpp
+BENCHMARK_TEXT_LDADD = $(FAKE_LIBS)
+BENCHMARK_TEXT_DEPENDS = SCREEN EVENT ASYNC OS IO THREAD MATH UTIL
+$(eval $(call link-program,BenchmarkText,BENCHMARK_TEXT))
+
 VIEW_IMAGE_SOURCES = \
 	$(MORE_SCREEN_SOURCES) \
 	$(SRC)/Compatibility/fmode.c \
@@ -1779,6 +2183,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Engine/Navigation/TraceHistory.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
 	$(SRC)/FLARM/Friends.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
 	$(SRC)/FLARM/List.cpp \
 	$(SRC)/FLARM/Global.cpp \
 	$(SRC)/Airspace/ActivePredicate.cpp \
@@ -1808,6 +2213,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/MapWindow/MapWindowContest.cpp \
 	$(SRC)/MapWindow/MapWindowTask.cpp \
 	$(SRC)/MapWindow/MapWindowThermal.cpp \
+	$(SRC)/Thermal/HotspotDatabase.cpp \
 	$(SRC)/MapWindow/MapWindowTraffic.cpp \
 	$(SRC)/MapWindow/MapWindowTrail.cpp \
 	$(SRC)/MapWindow/MapWindowWaypoints.cpp \
@@ -1819,6 +2225,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/TaskPointRenderer.cpp \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
+	$(SRC)/Renderer/AirspaceScreenCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
@@ -1859,6 +2266,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Task/ProtectedRoutePlanner.cpp \
 	$(SRC)/Task/RoutePlannerGlue.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/CompiledTopography.cpp \
 	$(SRC)/Topography/TopographyStore.cpp \
 	$(SRC)/Topography/Thread.cpp \
 	$(SRC)/Topography/TopographyFileRenderer.cpp \
@@ -1939,6 +2347,20 @@ RUN_MAP_WINDOW_DEPENDS = \
 	JASPER ZZIP UTIL GEO MATH TIME
 $(eval $(call link-program,RunMapWindow,RUN_MAP_WINDOW))
 
+BENCHMARK_MAP_WINDOW_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(filter-out $(DEBUG_REPLAY_SOURCES) $(TEST_SRC_DIR)/RunMapWindow.cpp,$(RUN_MAP_WINDOW_SOURCES)) \
+	$(SRC)/Task/Deserialiser.cpp \
+	$(SRC)/Task/LoadFile.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/TaskFile.cpp \
+	$(SRC)/Task/TaskFileXCSoar.cpp \
+	$(SRC)/Task/TaskFileSeeYou.cpp \
+	$(SRC)/Task/TaskFileIGC.cpp \
+	$(TEST_SRC_DIR)/BenchmarkMapWindow.cpp
+BENCHMARK_MAP_WINDOW_DEPENDS = DRIVER $(RUN_MAP_WINDOW_DEPENDS)
+$(eval $(call link-program,BenchmarkMapWindow,BENCHMARK_MAP_WINDOW))
+
 RUN_LIST_CONTROL_SOURCES = \
 	$(MORE_SCREEN_SOURCES) \
 	$(SRC)/Look/DialogLook.cpp \
@@ -2313,6 +2735,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Computer/GlideRatioComputer.cpp \
 	$(SRC)/Computer/GlideComputer.cpp \
 	$(SRC)/Computer/GlideComputerBlackboard.cpp \
+	$(SRC)/Computer/IdleScheduler.cpp \
 	$(SRC)/Computer/TaskComputer.cpp \
 	$(SRC)/Computer/RouteComputer.cpp \
 	$(SRC)/Computer/GlideComputerAirData.cpp \
@@ -2321,6 +2744,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Computer/GlideComputerInterface.cpp \
 	$(SRC)/Computer/LogComputer.cpp \
 	$(SRC)/Computer/CuComputer.cpp \
+	$(SRC)/Computer/CorridorComputer.cpp \
 	$(SRC)/Audio/Settings.cpp \
 	$(SRC)/Audio/VarioSettings.cpp \
 	$(SRC)/UISettings.cpp \
@@ -2369,6 +2793,91 @@ RUN_ANALYSIS_DEPENDS = \
 	CONTEST TASK ROUTE GLIDE WAYPOINT ROUTE AIRSPACE ZZIP UTIL GEO MATH TIME
 $(eval $(call link-program,RunAnalysis,RUN_ANALYSIS))
 
+RUN_INSTRUMENT_REPLAY_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(ENGINE_SRC_DIR)/ThermalBand/ThermalBand.cpp \
+	$(SRC)/Task/Deserialiser.cpp \
+	$(SRC)/Task/LoadFile.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Task/TaskFile.cpp \
+	$(SRC)/Task/TaskFileXCSoar.cpp \
+	$(SRC)/Task/TaskFileSeeYou.cpp \
+	$(SRC)/Task/TaskFileIGC.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/Computer/Wind/CirclingWind.cpp \
+	$(SRC)/Computer/Wind/Store.cpp \
+	$(SRC)/Computer/Wind/MeasurementList.cpp \
+	$(SRC)/Computer/Wind/WindEKF.cpp \
+	$(SRC)/Computer/Wind/WindEKFGlue.cpp \
+	$(SRC)/Units/Units.cpp \
+	$(SRC)/Units/Settings.cpp \
+	$(SRC)/Units/Temperature.cpp \
+	$(SRC)/LocalPath.cpp \
+	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/Computer/ThermalLocator.cpp \
+	$(SRC)/Computer/ThermalBase.cpp \
+	$(SRC)/Computer/ThermalBandComputer.cpp \
+	$(SRC)/Computer/GlideRatioCalculator.cpp \
+	$(SRC)/Computer/AutoQNH.cpp \
+	$(SRC)/Computer/CirclingComputer.cpp \
+	$(SRC)/Computer/Wind/Computer.cpp \
+	$(SRC)/Computer/Wind/Settings.cpp \
+	$(SRC)/Computer/ContestComputer.cpp \
+	$(SRC)/Computer/TraceComputer.cpp \
+	$(SRC)/Computer/WarningComputer.cpp \
+	$(SRC)/Computer/LiftDatabaseComputer.cpp \
+	$(SRC)/Computer/AverageVarioComputer.cpp \
+	$(SRC)/Computer/GlideRatioComputer.cpp \
+	$(SRC)/Computer/GlideComputer.cpp \
+	$(SRC)/Computer/GlideComputerBlackboard.cpp \
+	$(SRC)/Computer/IdleScheduler.cpp \
+	$(SRC)/Computer/TaskComputer.cpp \
+	$(SRC)/Computer/RouteComputer.cpp \
+	$(SRC)/Computer/GlideComputerAirData.cpp \
+	$(SRC)/Computer/WaveComputer.cpp \
+	$(SRC)/Computer/StatsComputer.cpp \
+	$(SRC)/Computer/GlideComputerInterface.cpp \
+	$(SRC)/Computer/LogComputer.cpp \
+	$(SRC)/Computer/CuComputer.cpp \
+	$(SRC)/Computer/CorridorComputer.cpp \
+	$(SRC)/Computer/Settings.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/Engine/Navigation/TraceHistory.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(IO_SRC_DIR)/MapFile.cpp \
+	$(SRC)/io/ConfiguredFile.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/RunInstrumentReplay.cpp
+RUN_INSTRUMENT_REPLAY_DEPENDS = \
+	TERRAIN \
+	DRIVER \
+	PROFILE \
+	IO OS THREAD \
+	CONTEST TASK ROUTE GLIDE WAYPOINT AIRSPACE ZZIP UTIL GEO MATH TIME
+$(eval $(call link-program,RunInstrumentReplay,RUN_INSTRUMENT_REPLAY))
+
 RUN_AIRSPACE_WARNING_DIALOG_SOURCES = \
 	$(SRC)/Engine/Navigation/Aircraft.cpp \
 	$(SRC)/NMEA/FlyingState.cpp \
@@ -2458,7 +2967,7 @@ DUMP_VARIO_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(TEST_SRC_DIR)/DumpVario.cpp
 DUMP_VARIO_LDADD = $(DEBUG_REPLAY_LDADD)
-DUMP_VARIO_DEPENDS = AUDIO GEO MATH SCREEN EVENT UTIL OS TIME
+DUMP_VARIO_DEPENDS = AUDIO GEO MATH SCREEN EVENT THREAD UTIL OS TIME
 $(eval $(call link-program,DumpVario,DUMP_VARIO))
 
 RUN_TASK_EDITOR_DIALOG_SOURCES = \
@@ -2615,6 +3124,17 @@ DUMP_TASK_FILE_SOURCES = \
 DUMP_TASK_FILE_DEPENDS = TASK GLIDE WAYPOINT IO OS THREAD ZZIP GEO TIME MATH UTIL
 $(eval $(call link-program,DumpTaskFile,DUMP_TASK_FILE))
 
+BENCHMARK_TASK_STORE_SOURCES = \
+	$(filter-out $(TEST_SRC_DIR)/DumpTaskFile.cpp,$(DUMP_TASK_FILE_SOURCES)) \
+	$(SRC)/Task/TaskStore.cpp \
+	$(SRC)/Task/TaskIndex.cpp \
+	$(SRC)/LocalPath.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTaskStore.cpp
+BENCHMARK_TASK_STORE_DEPENDS = $(DUMP_TASK_FILE_DEPENDS)
+$(eval $(call link-program,BenchmarkTaskStore,BENCHMARK_TASK_STORE))
+
 DUMP_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/FlarmNetReader.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
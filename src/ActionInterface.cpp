@@ -49,7 +49,7 @@ XCSoarInterface::ReceiveGPS()
   {
     std::lock_guard<Mutex> lock(device_blackboard->mutex);
 
-    ReadBlackboardBasic(device_blackboard->Basic());
+    ReadBlackboardBasic(device_blackboard->GetBasicSnapshot());
 
     const NMEAInfo &real = device_blackboard->RealState();
     Private::movement_detected = real.alive && real.gps.real &&
@@ -69,7 +69,7 @@ XCSoarInterface::ReceiveCalculated()
   {
     std::lock_guard<Mutex> lock(device_blackboard->mutex);
 
-    ReadBlackboardCalculated(device_blackboard->Calculated());
+    ReadBlackboardCalculated(device_blackboard->GetCalculatedSnapshot());
     device_blackboard->ReadComputerSettings(GetComputerSettings());
   }
 
@@ -292,6 +292,13 @@ ActionInterface::SendUIState()
   main_window->SetUIState(GetUIState());
 }
 
+void
+ActionInterface::SendCommonStats(const CommonStats &common_stats)
+{
+  ReadCommonStats(common_stats);
+  main_window->SetCommonStats(GetCommonStats());
+}
+
 void
 ActionInterface::SetActiveFrequency(const RadioFrequency & freq, const TCHAR * freq_name, bool to_devices)
 {
@@ -105,6 +105,13 @@ namespace ActionInterface {
    */
   void SendUIState();
 
+  /**
+   * Submit #CommonStats which were updated by the TaskManager after
+   * the last calculation to the #InterfaceBlackboard and to the map,
+   * so they are available before the next calculation.
+   */
+  void SendCommonStats(const CommonStats &common_stats);
+
   /**
    * Update the Active Radio Frequency in #ComputerSettings, and
    * forward it to all XCSoar modules that want it.
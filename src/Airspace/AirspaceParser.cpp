@@ -30,8 +30,10 @@ Copyright_License {
 #include "util/CharUtil.hxx"
 #include "util/StringAPI.hxx"
 #include "util/StringParser.hxx"
+#include "util/DecimalParser.hpp"
 #include "util/Macros.hpp"
 #include "Geo/Math.hpp"
+#include "Geo/ArcTessellator.hpp"
 #include "io/LineReader.hpp"
 #include "Airspace/AirspacePolygon.hpp"
 #include "Airspace/AirspaceCircle.hpp"
@@ -211,9 +213,7 @@ struct TempAirspaceType
     const auto radius = v.distance;
 
     // 5 or -5, depending on direction
-    const auto _step = ArcStepWidth(radius);
-    const auto step = Angle::Degrees(rotation * _step);
-    const auto threshold = _step * 1.5;
+    const int step = rotation * ArcStepWidth(radius);
 
     // Determine end bearing
     Angle end_bearing = center.Bearing(end);
@@ -230,10 +230,8 @@ struct TempAirspaceType
     points.push_back(start);
 
     // Add intermediate polygon points
-    while ((end_bearing - start_bearing).AbsoluteDegrees() > threshold) {
-      start_bearing += step;
-      points.push_back(FindLatitudeLongitude(center, start_bearing, radius));
-    }
+    ArcTessellator(center, radius).AppendArc(points, start_bearing,
+                                             end_bearing, step);
 
     // Add last polygon point
     points.push_back(end);
@@ -243,9 +241,7 @@ struct TempAirspaceType
   AppendArc(Angle start, Angle end)
   {
     // 5 or -5, depending on direction
-    const auto _step = ArcStepWidth(radius);
-    const auto step = Angle::Degrees(rotation * _step);
-    const auto threshold = _step * 1.5;
+    const int step = rotation * ArcStepWidth(radius);
 
     if (rotation > 0) {
       while (end < start)
@@ -255,17 +251,16 @@ struct TempAirspaceType
         end -= Angle::FullCircle();
     }
 
+    const ArcTessellator arc(center, radius);
+
     // Add first polygon point
-    points.push_back(FindLatitudeLongitude(center, start, radius));
+    points.push_back(arc.Calculate(start));
 
     // Add intermediate polygon points
-    while ((end - start).AbsoluteDegrees() > threshold) {
-      start += step;
-      points.push_back(FindLatitudeLongitude(center, start, radius));
-    }
+    arc.AppendArc(points, start, end, step);
 
     // Add last polygon point
-    points.push_back(FindLatitudeLongitude(center, end, radius));
+    points.push_back(arc.Calculate(end));
   }
 };
 
@@ -279,6 +274,23 @@ ShowParseWarning(int line, const TCHAR *str, OperationEnvironment &operation)
   return false;
 }
 
+/**
+ * Like StringParser::ReadDouble(), but decodes plain decimal numbers
+ * (i.e. nearly all numbers in airspace files) without strtod().
+ */
+static bool
+ReadDouble(StringParser<TCHAR> &input, double &value_r)
+{
+  input.Strip();
+
+  const TCHAR *end;
+  if (!ParsePlainDecimal(input.c_str(), &end, value_r))
+    return input.ReadDouble(value_r);
+
+  input.Skip(end - input.c_str());
+  return true;
+}
+
 static void
 ReadAltitude(StringParser<TCHAR> &input, AirspaceAltitude &altitude)
 {
@@ -290,7 +302,7 @@ ReadAltitude(StringParser<TCHAR> &input, AirspaceAltitude &altitude)
     input.Strip();
 
     if (IsDigitASCII(input.front())) {
-      input.ReadDouble(value);
+      ReadDouble(input, value);
     } else if (input.SkipMatchIgnoreCase(_T("GND"), 3) ||
                input.SkipMatchIgnoreCase(_T("AGL"), 3)) {
       type = AGL;
@@ -377,19 +389,19 @@ static Angle
 ReadNonNegativeAngle(StringParser<TCHAR> &input, double max_degrees)
 {
   double degrees;
-  if (!input.ReadDouble(degrees) || degrees < 0 || degrees > max_degrees)
+  if (!ReadDouble(input, degrees) || degrees < 0 || degrees > max_degrees)
     return Angle::Native(-1);
 
   if (input.SkipMatch(':')) {
     double minutes;
-    if (!input.ReadDouble(minutes) || minutes < 0 || minutes > 60)
+    if (!ReadDouble(input, minutes) || minutes < 0 || minutes > 60)
       return Angle::Native(-1);
 
     degrees += minutes / 60;
 
     if (input.SkipMatch(':')) {
       double seconds;
-      if (!input.ReadDouble(seconds) || seconds < 0 || seconds > 60)
+      if (!ReadDouble(input, seconds) || seconds < 0 || seconds > 60)
         return Angle::Native(-1);
 
       degrees += seconds / 3600;
@@ -437,7 +449,7 @@ static bool
 ParseBearingDegrees(StringParser<TCHAR> &input, Angle &value_r)
 {
   double value;
-  if (!input.ReadDouble(value) || value < 0 || value > 361)
+  if (!ReadDouble(input, value) || value < 0 || value > 361)
     return false;
 
   value_r = Angle::Degrees(value).AsBearing();
@@ -450,7 +462,7 @@ ParseArcBearings(StringParser<TCHAR> &input, TempAirspaceType &temp_area)
   // Determine radius and start/end bearing
 
   double radius;
-  if (!input.ReadDouble(radius) || radius <= 0 || radius > 1000)
+  if (!ReadDouble(input, radius) || radius <= 0 || radius > 1000)
     return false;
 
   temp_area.radius = Units::ToSysUnit(radius, Unit::NAUTICAL_MILES);
@@ -522,7 +534,7 @@ ParseLine(Airspaces &airspace_database, StringParser<TCHAR> &&input,
 
     case _T('C'):
     case _T('c'):
-      if (!input.ReadDouble(d) || d < 0 || d > 1000)
+      if (!ReadDouble(input, d) || d < 0 || d > 1000)
         return false;
 
       temp_area.radius = Units::ToSysUnit(d, Unit::NAUTICAL_MILES);
@@ -746,7 +758,7 @@ ParseCircleTNP(StringParser<TCHAR> &input, TempAirspaceType &temp_area)
     return false;
 
   double radius;
-  if (!input.ReadDouble(radius) || radius <= 0 || radius > 1000)
+  if (!ReadDouble(input, radius) || radius <= 0 || radius > 1000)
     return false;
 
   temp_area.radius = Units::ToSysUnit(radius, Unit::NAUTICAL_MILES);
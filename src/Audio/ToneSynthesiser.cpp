@@ -27,31 +27,59 @@ Copyright_License {
 
 #include <cassert>
 
+/**
+ * The number of fractional bits in ToneSynthesiser::phase.
+ */
+static constexpr unsigned PHASE_BITS = 16;
+
+static constexpr uint32_t PHASE_MASK =
+  (uint32_t(ARRAY_SIZE(ISINETABLE)) << PHASE_BITS) - 1;
+
+static_assert(ARRAY_SIZE(ISINETABLE) <= (1u << (32 - PHASE_BITS)),
+              "Sine table too large for the phase accumulator");
+
 void
 ToneSynthesiser::SetTone(unsigned tone_hz)
 {
-  increment = ARRAY_SIZE(ISINETABLE) * tone_hz / sample_rate;
+  target_increment = (uint64_t(ARRAY_SIZE(ISINETABLE)) << PHASE_BITS)
+    * tone_hz / sample_rate;
+
+  if (glide_samples == 0 || increment == 0) {
+    increment = target_increment;
+    glide_remaining = 0;
+  } else {
+    increment_step = (int32_t(target_increment) - int32_t(increment))
+      / int32_t(glide_samples);
+    glide_remaining = glide_samples;
+  }
 }
 
 void
 ToneSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  assert(angle < ARRAY_SIZE(ISINETABLE));
+  assert(phase <= PHASE_MASK);
 
   for (int16_t *end = buffer + n; buffer != end; ++buffer) {
-    *buffer = ISINETABLE[angle] * (32767 / 1024) * (int)volume / 100;
-    angle = (angle + increment) & (ARRAY_SIZE(ISINETABLE) - 1);
+    *buffer = ISINETABLE[phase >> PHASE_BITS] * (32767 / 1024) * (int)volume / 100;
+    phase = (phase + increment) & PHASE_MASK;
+
+    if (glide_remaining > 0) {
+      if (--glide_remaining == 0)
+        increment = target_increment;
+      else
+        increment += increment_step;
+    }
   }
 }
 
 unsigned
 ToneSynthesiser::ToZero() const
 {
-  assert(angle < ARRAY_SIZE(ISINETABLE));
+  assert(phase <= PHASE_MASK);
 
-  if (angle < increment)
+  if (phase < increment)
     /* close enough */
     return 0;
 
-  return (ARRAY_SIZE(ISINETABLE) - angle) / increment;
+  return (PHASE_MASK + 1 - phase) / increment;
 }
@@ -27,11 +27,46 @@ Copyright_License {
 #include "PCMSynthesiser.hpp"
 #include "util/Compiler.h"
 
+#include <cstdint>
+
 /**
  * This class generates tones with a sine wave.
  */
 class ToneSynthesiser : public PCMSynthesiser {
-  unsigned volume = 100, angle = 0, increment = 0;
+  unsigned volume = 100;
+
+  /**
+   * The position in the sine table, as a fixed-point value with 16
+   * fractional bits.
+   */
+  uint32_t phase = 0;
+
+  /**
+   * The phase increment per sample (fixed-point, see #phase).
+   */
+  uint32_t increment = 0;
+
+  /**
+   * The increment to be reached at the end of the current frequency
+   * glide.
+   */
+  uint32_t target_increment = 0;
+
+  /**
+   * The value added to #increment on each sample while gliding.
+   */
+  int32_t increment_step = 0;
+
+  /**
+   * The number of samples remaining in the current frequency glide.
+   */
+  unsigned glide_remaining = 0;
+
+  /**
+   * The duration of a frequency glide [samples].  Zero means the
+   * frequency changes immediately.
+   */
+  unsigned glide_samples = 0;
 
 public:
   explicit ToneSynthesiser(unsigned _sample_rate) : sample_rate(_sample_rate) {
@@ -51,8 +86,23 @@ public:
     volume = _volume;
   }
 
+  /**
+   * Set a new tone frequency.  If a glide duration was configured,
+   * the frequency is interpolated linearly sample by sample, which
+   * avoids audible steps.
+   */
   void SetTone(unsigned tone_hz);
 
+  /**
+   * Set the duration of frequency glides.
+   *
+   * @param samples the duration [samples]; 0 disables frequency
+   * interpolation
+   */
+  void SetGlide(unsigned samples) {
+    glide_samples = samples;
+  }
+
   /* methods from class PCMSynthesiser */
   virtual void Synthesise(int16_t *buffer, size_t n);
 
@@ -70,7 +120,7 @@ protected:
    * Start a new period.
    */
   void Restart() {
-    angle = 0;
+    phase = 0;
   }
 };
 
@@ -93,6 +93,7 @@ AudioVarioGlue::Configure(const VarioSoundSettings &settings)
     synthesiser->SetDeadBand(settings.dead_band_enabled);
     synthesiser->SetFrequencies(settings.min_frequency, settings.zero_frequency,
                                 settings.max_frequency);
+    synthesiser->SetSmoothFrequency(settings.smooth_frequency);
     synthesiser->SetPeriods(settings.min_period_ms, settings.max_period_ms);
     synthesiser->SetDeadBandRange(settings.min_dead, settings.max_dead);
     player->Start(*synthesiser);
@@ -48,7 +48,9 @@ namespace AudioVarioGlue {
   void Configure(const VarioSoundSettings &settings);
 
   /**
-   * Update the vario value.
+   * Update the vario value.  This does not block, and may be called
+   * from any thread, e.g. directly from a device driver's receive
+   * thread.
    *
    * @param vario the current vario value [m/s]
    */
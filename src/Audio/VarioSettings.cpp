@@ -33,6 +33,7 @@ VarioSoundSettings::SetDefaults()
   min_frequency = 200;
   zero_frequency = 500;
   max_frequency = 1500;
+  smooth_frequency = false;
 
   min_period_ms = 150;
   max_period_ms = 600;
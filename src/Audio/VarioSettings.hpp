@@ -36,6 +36,11 @@ struct VarioSoundSettings {
   unsigned zero_frequency;
   unsigned max_frequency;
 
+  /**
+   * Glide smoothly between tone frequencies?
+   */
+  bool smooth_frequency;
+
   unsigned min_period_ms;
   unsigned max_period_ms;
 
@@ -46,10 +46,24 @@ VarioSynthesiser::VarioToFrequency(int ivario)
 void
 VarioSynthesiser::SetVario(double vario)
 {
-  const std::lock_guard<Mutex> lock(mutex);
-
   const int ivario = Clamp((int)(vario * 100), min_vario, max_vario);
+  pending_vario.store(ivario, std::memory_order_release);
+}
+
+void
+VarioSynthesiser::ApplyPending()
+{
+  const int value = pending_vario.exchange(PENDING_NONE,
+                                           std::memory_order_acquire);
+  if (value == PENDING_SILENCE)
+    UnsafeSetSilence();
+  else if (value != PENDING_NONE)
+    UnsafeSetVario(value);
+}
 
+void
+VarioSynthesiser::UnsafeSetVario(int ivario)
+{
   if (dead_band_enabled && InDeadBand(ivario)) {
     /* inside the "dead band" */
     UnsafeSetSilence();
@@ -86,13 +100,6 @@ VarioSynthesiser::SetVario(double vario)
   }
 }
 
-void
-VarioSynthesiser::SetSilence()
-{
-  const std::lock_guard<Mutex> lock(mutex);
-  UnsafeSetSilence();
-}
-
 void
 VarioSynthesiser::UnsafeSetSilence()
 {
@@ -114,6 +121,8 @@ VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
   const std::lock_guard<Mutex> lock(mutex);
 
+  ApplyPending();
+
   assert(audible_count > 0 || silence_count > 0);
 
   if (silence_count == 0) {
@@ -28,13 +28,29 @@ Copyright_License {
 #include "thread/Mutex.hxx"
 #include "util/Compiler.h"
 
+#include <atomic>
+#include <climits>
+
 /**
  * This class generates vario sound.
  */
 class VarioSynthesiser final : public ToneSynthesiser {
   /**
-   * This mutex protects all atttributes below.  It is locked
-   * automatically by all public methods.
+   * Special values for #pending_vario.
+   */
+  static constexpr int PENDING_NONE = INT_MIN, PENDING_SILENCE = INT_MIN + 1;
+
+  /**
+   * The most recent vario value [cm/s] submitted by SetVario(), or
+   * one of the PENDING_ constants.  This is a lock-free single-value
+   * channel: writers overwrite it without waiting for the audio
+   * thread, and Synthesise() consumes it at the start of each block.
+   */
+  std::atomic<int> pending_vario{PENDING_NONE};
+
+  /**
+   * This mutex protects all atttributes below.  It is locked by
+   * Synthesise().
    */
   Mutex mutex;
 
@@ -100,17 +116,31 @@ public:
      min_dead(-30), max_dead(10) {}
 
   /**
-   * Update the vario value.  This calculates a new tone frequency and
-   * a new "silence" rate (for positive vario values).
+   * Update the vario value.  The new tone frequency and "silence"
+   * rate (for positive vario values) will be applied at the start of
+   * the next Synthesise() call.
+   *
+   * This method does not block, and it may be called from any thread.
    *
    * @param vario the current vario value [m/s]
    */
   void SetVario(double vario);
 
   /**
-   * Produce silence from now on.
+   * Produce silence from now on.  Like SetVario(), this is applied
+   * by the next Synthesise() call.
    */
-  void SetSilence();
+  void SetSilence() {
+    pending_vario.store(PENDING_SILENCE, std::memory_order_release);
+  }
+
+  /**
+   * Smooth frequency changes instead of stepping from one tone to
+   * the next.
+   */
+  void SetSmoothFrequency(bool enabled) {
+    SetGlide(enabled ? sample_rate / 50 : 0);
+  }
 
   /**
    * Enable/disable the dead band silence
@@ -149,7 +179,20 @@ public:
 
 private:
   /**
-   * Same as SetSilence(), but doesn't lock the mutex.
+   * Apply the value received by SetVario() or SetSilence().  Caller
+   * must lock the mutex.
+   */
+  void ApplyPending();
+
+  /**
+   * Apply a new vario value.  Caller must lock the mutex.
+   *
+   * @param ivario the current vario value [cm/s]
+   */
+  void UnsafeSetVario(int ivario);
+
+  /**
+   * Switch to silence.  Caller must lock the mutex.
    */
   void UnsafeSetSilence();
 
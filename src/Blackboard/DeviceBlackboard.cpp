@@ -37,7 +37,10 @@ DeviceBlackboard::DeviceBlackboard()
 {
   // Clear the gps_info and calculated_info
   gps_info.Reset();
-  calculated_info.Reset();
+
+  auto calculated = std::make_shared<DerivedInfo>();
+  calculated->Reset();
+  calculated_info = std::move(calculated);
 
   // Set GPS assumed time to system time
   gps_info.UpdateClock();
@@ -179,9 +182,22 @@ DeviceBlackboard::SetAltitude(double val)
  * by the GlideComputerBlackboard
  */
 void
-DeviceBlackboard::ReadBlackboard(const DerivedInfo &derived_info)
+DeviceBlackboard::ReadBlackboard(DerivedInfoSnapshot derived_info)
+{
+  calculated_info = std::move(derived_info);
+  ++calculated_serial;
+}
+
+MoreDataSnapshot
+DeviceBlackboard::GetBasicSnapshot()
 {
-  calculated_info = derived_info;
+  if (basic_snapshot == nullptr || basic_snapshot_serial != basic_serial) {
+    basic_snapshot = std::make_shared<const MoreData>(gps_info);
+    basic_snapshot_serial = basic_serial;
+    CountBlackboardCopy(sizeof(MoreData));
+  }
+
+  return basic_snapshot;
 }
 
 /**
@@ -258,6 +274,22 @@ DeviceBlackboard::Merge()
   }
 }
 
+bool
+DeviceBlackboard::IsPrimaryVarioSource(unsigned i) const
+{
+  assert(i < NUMDEV);
+
+  if (replay_data.alive || simulator_data.alive)
+    return false;
+
+  for (unsigned j = 0; j < i; ++j)
+    if (per_device_data[j].alive &&
+        per_device_data[j].total_energy_vario_available)
+      return false;
+
+  return true;
+}
+
 void
 DeviceBlackboard::SetBallast(double fraction, double overload,
                              OperationEnvironment &env)
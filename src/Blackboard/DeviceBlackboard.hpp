@@ -24,12 +24,13 @@ Copyright_License {
 #ifndef DEVICE_BLACKBOARD_H
 #define DEVICE_BLACKBOARD_H
 
-#include "Blackboard/BaseBlackboard.hpp"
+#include "Blackboard/SnapshotBlackboard.hpp"
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
 #include "Device/Simulator.hpp"
 #include "Device/Features.hpp"
 #include "thread/Mutex.hxx"
 #include "time/WrapClock.hpp"
+#include "util/Serial.hpp"
 
 #include <cassert>
 
@@ -44,12 +45,37 @@ class RadioFrequency;
  * 
  * The DeviceBlackboard is used as the global ground truth-state
  * since it is accessed quickly with only one mutex
+ *
+ * Other threads do not copy #gps_info and #DerivedInfo out of this
+ * blackboard; they obtain reference-counted immutable snapshots with
+ * GetBasicSnapshot() and GetCalculatedSnapshot(), which only need the
+ * mutex for copying a pointer.
  */
-class DeviceBlackboard
-  : public BaseBlackboard, public ComputerSettingsBlackboard
+class DeviceBlackboard : public ComputerSettingsBlackboard
 {
   friend class MergeThread;
 
+  MoreData gps_info;
+
+  /**
+   * Incremented each time #gps_info may have been modified.
+   */
+  Serial basic_serial;
+
+  /**
+   * A copy of #gps_info made by GetBasicSnapshot(); it is valid if
+   * #basic_snapshot_serial equals #basic_serial.
+   */
+  MoreDataSnapshot basic_snapshot;
+  Serial basic_snapshot_serial;
+
+  /**
+   * The most recent #DerivedInfo published by the calculation
+   * thread.
+   */
+  DerivedInfoSnapshot calculated_info;
+  Serial calculated_serial;
+
   Simulator simulator;
 
   MultipleDevices *devices;
@@ -91,12 +117,52 @@ public:
     devices = &_devices;
   }
 
-  void ReadBlackboard(const DerivedInfo &derived_info);
+  /**
+   * Publish a new #DerivedInfo version.  Caller must lock the
+   * blackboard.
+   */
+  void ReadBlackboard(DerivedInfoSnapshot derived_info);
   void ReadComputerSettings(const ComputerSettings &settings);
 
+  gcc_pure
+  const MoreData &Basic() const {
+    return gps_info;
+  }
+
+  gcc_pure
+  const DerivedInfo &Calculated() const {
+    return *calculated_info;
+  }
+
+  /**
+   * Returns an immutable copy of Basic().  The copy is made at most
+   * once per modification and is shared by all callers.  Caller must
+   * lock the blackboard.
+   */
+  MoreDataSnapshot GetBasicSnapshot();
+
+  /**
+   * Returns the most recent #DerivedInfo version.  Caller must lock
+   * the blackboard.
+   */
+  const DerivedInfoSnapshot &GetCalculatedSnapshot() const {
+    return calculated_info;
+  }
+
+  Serial GetCalculatedSerial() const {
+    return calculated_serial;
+  }
+
 protected:
-  NMEAInfo &SetBasic() { return gps_info; }
-  MoreData &SetMoreData() { return gps_info; }
+  NMEAInfo &SetBasic() {
+    ++basic_serial;
+    return gps_info;
+  }
+
+  MoreData &SetMoreData() {
+    ++basic_serial;
+    return gps_info;
+  }
 
 public:
   const NMEAInfo &RealState(unsigned i) const {
@@ -127,6 +193,15 @@ public:
     return RealState(i).flarm.IsDetected();
   }
 
+  /**
+   * Would Merge() use the total energy vario of the specified device?
+   * This is the case if no device with a lower index provides one
+   * and neither replay nor simulator are active.  Caller must lock
+   * the blackboard.
+   */
+  gcc_pure
+  bool IsPrimaryVarioSource(unsigned i) const;
+
   void SetStartupLocation(const GeoPoint &loc, double alt);
   void ProcessSimulation();
   void StopReplay();
@@ -24,7 +24,7 @@ Copyright_License {
 #ifndef XCSOAR_FULL_BLACKBOARD_HPP
 #define XCSOAR_FULL_BLACKBOARD_HPP
 
-#include "BaseBlackboard.hpp"
+#include "SnapshotBlackboard.hpp"
 #include "SettingsBlackboard.hpp"
 
 /**
@@ -32,7 +32,7 @@ Copyright_License {
  * base class for InterfaceBlackboard, and may be used to pass
  * everything we have in one pointer.
  */
-class FullBlackboard : public BaseBlackboard, public SettingsBlackboard {
+class FullBlackboard : public SnapshotBlackboard, public SettingsBlackboard {
 };
 
 #endif
@@ -23,15 +23,21 @@ Copyright_License {
 #include "InterfaceBlackboard.hpp"
 
 void
-InterfaceBlackboard::ReadBlackboardCalculated(const DerivedInfo &derived_info)
+InterfaceBlackboard::ReadCommonStats(const CommonStats &_common_stats)
 {
-  calculated_info = derived_info;
-}
-
-void
-InterfaceBlackboard::ReadBlackboardBasic(const MoreData &nmea_info)
-{
-  gps_info = nmea_info;
+  common_stats = _common_stats;
+
+  /* the working height band and the vario scale are calculated by
+     the GlideComputer, not by the TaskManager; keep them */
+  const CommonStats &calculated = calculated_info->common_stats;
+  common_stats.height_min_working = calculated.height_min_working;
+  common_stats.height_max_working = calculated.height_max_working;
+  common_stats.height_fraction_working = calculated.height_fraction_working;
+  common_stats.vario_scale_positive = calculated.vario_scale_positive;
+  common_stats.vario_scale_negative = calculated.vario_scale_negative;
+
+  common_stats_modified = true;
+  CountBlackboardCopy(sizeof(CommonStats));
 }
 
 void
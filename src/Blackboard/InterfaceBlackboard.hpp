@@ -30,8 +30,16 @@ Copyright_License {
 class InterfaceBlackboard : public LiveBlackboard
 {
 public:
-  void ReadBlackboardBasic(const MoreData &nmea_info);
-  void ReadBlackboardCalculated(const DerivedInfo &derived_info);
+  void ReadBlackboardBasic(MoreDataSnapshot nmea_info) {
+    gps_info = std::move(nmea_info);
+  }
+
+  void ReadBlackboardCalculated(DerivedInfoSnapshot derived_info) {
+    calculated_info = std::move(derived_info);
+
+    /* the new snapshot has been calculated from the current task */
+    common_stats_modified = false;
+  }
 
   gcc_const
   SystemSettings &SetSystemSettings() {
@@ -48,9 +56,13 @@ public:
     return ui_settings;
   }
 
-  inline void ReadCommonStats(const CommonStats &common_stats) {
-    calculated_info.common_stats = common_stats;
-  }
+  /**
+   * Replace the #CommonStats of the current #DerivedInfo snapshot
+   * until the next ReadBlackboardCalculated() call.  Snapshots are
+   * immutable, so they are stored separately, see GetCommonStats().
+   * The fields calculated by the GlideComputer are preserved.
+   */
+  void ReadCommonStats(const CommonStats &common_stats);
 
   void ReadComputerSettings(const ComputerSettings &settings);
 };
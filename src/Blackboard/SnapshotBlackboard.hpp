@@ -0,0 +1,117 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SNAPSHOT_BLACKBOARD_HPP
+#define XCSOAR_SNAPSHOT_BLACKBOARD_HPP
+
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "util/Compiler.h"
+
+#include <atomic>
+#include <memory>
+
+#include <cstdint>
+
+/**
+ * An immutable version of #MoreData.  Once published, it is never
+ * modified, so any number of threads may read it without a lock and
+ * without copying it.
+ */
+typedef std::shared_ptr<const MoreData> MoreDataSnapshot;
+
+/**
+ * An immutable version of #DerivedInfo, see #MoreDataSnapshot.
+ */
+typedef std::shared_ptr<const DerivedInfo> DerivedInfoSnapshot;
+
+/**
+ * Counts the bytes of #MoreData and #DerivedInfo which are copied
+ * between the merge, calculation and UI threads.
+ */
+inline std::atomic<uint_least64_t> blackboard_bytes_copied{0};
+
+static inline void
+CountBlackboardCopy(std::size_t size) noexcept
+{
+  blackboard_bytes_copied.fetch_add(size, std::memory_order_relaxed);
+}
+
+/**
+ * Base class for blackboards which receive their data from other
+ * threads.  Instead of owning a copy of #MoreData and #DerivedInfo,
+ * it holds references to immutable snapshots published by the
+ * #DeviceBlackboard and the calculation thread.
+ */
+class SnapshotBlackboard
+{
+protected:
+  MoreDataSnapshot gps_info;
+  DerivedInfoSnapshot calculated_info;
+
+  /**
+   * #CommonStats which are newer than the ones in #calculated_info,
+   * because the task was modified after the last calculation.  Only
+   * valid if #common_stats_modified is set, which is cleared when a
+   * new #calculated_info snapshot arrives.
+   */
+  CommonStats common_stats;
+
+  bool common_stats_modified = false;
+
+public:
+  SnapshotBlackboard() {
+    auto basic = std::make_shared<MoreData>();
+    basic->Reset();
+    gps_info = std::move(basic);
+
+    auto calculated = std::make_shared<DerivedInfo>();
+    calculated->Reset();
+    calculated_info = std::move(calculated);
+  }
+
+  // all blackboards can be read as const
+  gcc_pure
+  const MoreData &Basic() const {
+    return *gps_info;
+  }
+
+  gcc_pure
+  const DerivedInfo& Calculated() const {
+    return *calculated_info;
+  }
+
+  /**
+   * Returns the current #CommonStats, including task updates which
+   * were submitted since the last calculation.  Use this instead of
+   * Calculated().common_stats.
+   */
+  gcc_pure
+  const CommonStats &GetCommonStats() const {
+    return common_stats_modified
+      ? common_stats
+      : calculated_info->common_stats;
+  }
+};
+
+#endif
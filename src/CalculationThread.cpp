@@ -27,6 +27,12 @@ Copyright_License {
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Components.hpp"
 #include "Hardware/CPU.hpp"
+#include "time/LatencyTrace.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
+
+using std::chrono::steady_clock;
 
 /**
  * Constructor of the CalculationThread class
@@ -36,6 +42,7 @@ CalculationThread::CalculationThread(GlideComputer &_glide_computer)
   :WorkerThread("CalcThread", 450, 100, 50),
    force(false),
    glide_computer(_glide_computer) {
+  SetAdaptive(true);
 }
 
 void
@@ -62,17 +69,21 @@ CalculationThread::Tick() noexcept
   const ScopeLockCPU cpu;
 #endif
 
-  bool gps_updated;
+  const auto start = steady_clock::now();
 
-  // update and transfer master info to glide computer
+  // obtain the current master info; this only copies a pointer
+  // while the DeviceBlackboard is locked
+  MoreDataSnapshot basic;
   {
     std::lock_guard<Mutex> lock(device_blackboard->mutex);
+    basic = device_blackboard->GetBasicSnapshot();
+  }
 
-    gps_updated = device_blackboard->Basic().location_available.Modified(glide_computer.Basic().location_available);
+  bool gps_updated = basic->location_available.Modified(glide_computer.Basic().location_available);
 
-    // Copy data from DeviceBlackboard to GlideComputerBlackboard
-    glide_computer.ReadBlackboard(device_blackboard->Basic());
-  }
+  // Copy data from the snapshot to GlideComputerBlackboard
+  glide_computer.ReadBlackboard(*basic);
+  CountBlackboardCopy(sizeof(MoreData));
 
   bool force;
   {
@@ -98,20 +109,78 @@ CalculationThread::Tick() noexcept
   // values changed, so copy them back now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
   // that one back (otherwise we may write over new data)
+  auto calculated =
+    std::make_shared<DerivedInfo>(glide_computer.Calculated());
+  calculated->latency_stamp = basic->latency_stamp;
+  CountBlackboardCopy(sizeof(DerivedInfo));
+
   {
     std::lock_guard<Mutex> lock(device_blackboard->mutex);
-    device_blackboard->ReadBlackboard(glide_computer.Calculated());
+    device_blackboard->ReadBlackboard(std::move(calculated));
   }
 
   // if (new GPS data)
-  if (gps_updated || force)
+  if (gps_updated || force) {
+    LatencyTrace::Record(LatencyTrace::Stage::CALCULATED,
+                         basic->latency_stamp);
+
     // inform map new data is ready
     TriggerCalculatedUpdate();
+  }
+
+  if (gps_updated) {
+    if (!force && last_fix != steady_clock::time_point()) {
+      const steady_clock::duration interval =
+        std::min<steady_clock::duration>(start - last_fix,
+                                         std::chrono::seconds(5));
+      fix_interval += (interval - fix_interval) / 8;
+    }
+
+    last_fix = start;
+  }
 
   if (do_idle) {
-    // do slow calculations last, to minimise latency
-    glide_computer.ProcessIdle();
+    // the flight logs are never deferred
+    glide_computer.ProcessLogging();
+
+    if (force)
+      // a forced calculation (e.g. after a task change) updates
+      // everything, like it did before there were idle jobs
+      glide_computer.ProcessIdle();
+    else {
+      // do slow calculations last, to minimise latency; only those
+      // which fit into the remaining time (or are overdue) are run
+      const auto elapsed = steady_clock::now() - start;
+      const auto budget = fix_interval / 2;
+      glide_computer.RunIdleJobs(budget > elapsed
+                                 ? budget - elapsed
+                                 : steady_clock::duration::zero());
+    }
   }
+
+  if (overrun_clock.CheckUpdate(std::chrono::minutes(1))) {
+    const auto &scheduler = glide_computer.GetIdleScheduler();
+    const unsigned overruns = scheduler.GetOverruns();
+    if (overruns != last_overruns) {
+      scheduler.VisitStats([](const char *name,
+                              const IdleScheduler::Stats &stats){
+        const auto max_ms = std::chrono::duration_cast<std::chrono::milliseconds>(stats.max_duration);
+        LogFormat("Calculation job '%s': %u runs, %u overruns, %u late, max %lu ms",
+                  name, stats.runs, stats.overruns, stats.late,
+                  (unsigned long)max_ms.count());
+      });
+      last_overruns = overruns;
+    }
+  }
+
+#ifndef NDEBUG
+  if (copy_stats_clock.CheckUpdate(std::chrono::minutes(1))) {
+    const uint_least64_t bytes = blackboard_bytes_copied.load(std::memory_order_relaxed);
+    LogFormat("Blackboard: %lu bytes/s copied",
+              (unsigned long)((bytes - copy_stats_bytes) / 60));
+    copy_stats_bytes = bytes;
+  }
+#endif
 }
 
 void
@@ -27,6 +27,13 @@ Copyright_License {
 #include "thread/WorkerThread.hpp"
 #include "thread/Mutex.hxx"
 #include "Computer/Settings.hpp"
+#include "time/PeriodClock.hpp"
+
+#include <chrono>
+
+#ifndef NDEBUG
+#include <cstdint>
+#endif
 
 class GlideComputer;
 
@@ -56,6 +63,28 @@ class CalculationThread final : public WorkerThread {
   /** Pointer to the GlideComputer that should be used */
   GlideComputer &glide_computer;
 
+  /**
+   * Moving average of the interval between two GPS fixes.  Half of
+   * it is the time available to the fast path and the slow jobs
+   * together.
+   */
+  std::chrono::steady_clock::duration fix_interval = std::chrono::seconds(1);
+  std::chrono::steady_clock::time_point last_fix;
+
+  /**
+   * Used to log slow job overruns once per minute.
+   */
+  PeriodClock overrun_clock;
+  unsigned last_overruns = 0;
+
+#ifndef NDEBUG
+  /**
+   * Used to log the blackboard copy statistics once per minute.
+   */
+  PeriodClock copy_stats_clock;
+  uint_least64_t copy_stats_bytes = 0;
+#endif
+
 public:
   CalculationThread(GlideComputer &_glide_computer);
 
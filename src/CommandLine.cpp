@@ -48,6 +48,12 @@ namespace CommandLine {
 #ifdef HAVE_CMDLINE_REPLAY
   const char *replay_path;
 #endif
+
+  const char *latency_trace_path;
+
+#ifdef HAVE_CMDLINE_INSTRUMENT
+  const char *instrument_path;
+#endif
 }
 
 void
@@ -83,6 +89,16 @@ CommandLine::Parse(Args &args)
 #ifdef HAVE_CMDLINE_REPLAY
     } else if (StringIsEqual(s, "-replay=", 8)) {
       replay_path = s + 8;
+#endif
+    } else if (StringIsEqual(s, "-latency-trace=", 15)) {
+      latency_trace_path = s + 15;
+      if (StringIsEmpty(latency_trace_path))
+        args.UsageError();
+#ifdef HAVE_CMDLINE_INSTRUMENT
+    } else if (StringIsEqual(s, "-instrument=", 12)) {
+      instrument_path = s + 12;
+      if (StringIsEmpty(instrument_path))
+        args.UsageError();
 #endif
 #ifdef SIMULATOR_AVAILABLE
     } else if (StringIsEqual(s, "-simulator")) {
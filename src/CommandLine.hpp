@@ -43,6 +43,23 @@ namespace CommandLine {
   extern const char *replay_path;
 #endif
 
+  /**
+   * If set, record latency trace events and write them to this file
+   * on shutdown.
+   */
+  extern const char *latency_trace_path;
+
+#ifdef INSTRUMENT
+#define HAVE_CMDLINE_INSTRUMENT
+  /**
+   * If set, record the hot path timers and counters (see
+   * time/Instrument.hpp) and write the report to this file on
+   * shutdown.  Only available in "make INSTRUMENT=y" builds, because
+   * the probes are compiled out otherwise.
+   */
+  extern const char *instrument_path;
+#endif
+
 /**
  * Reads and parses arguments/options from the command line
  * @param CommandLine command line argument string
@@ -0,0 +1,343 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CorridorComputer.hpp"
+#include "Settings.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "NMEA/Aircraft.hpp"
+#include "Navigation/Aircraft.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Engine/Airspace/AirspaceIntersectionVisitor.hpp"
+#include "Engine/GlideSolvers/GlideState.hpp"
+#include "Engine/GlideSolvers/MacCready.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <algorithm>
+
+#include <cassert>
+
+/**
+ * Rebuild the corridor if the track deviates more than this from the
+ * corridor's bearing (except while circling).
+ */
+static constexpr Angle MAX_TRACK_DEVIATION = Angle::Degrees(10);
+
+/**
+ * Rebuild the corridor if the aircraft is farther than this from its
+ * center line [m].  This does not depend on the slice spacing, so
+ * finer slices do not cause more rebuilds.
+ */
+static constexpr double MAX_LATERAL_DEVIATION = 400;
+
+/**
+ * Collects the crossings of all airspaces intersecting a segment.
+ */
+class CorridorAirspaceVisitor final : public AirspaceIntersectionVisitor {
+public:
+  struct Crossing {
+    const AbstractAirspace *airspace;
+
+    /**
+     * Distance from the start of the segment; a negative end means
+     * the segment ends inside the airspace.
+     */
+    double start, end;
+  };
+
+  std::vector<Crossing> crossings;
+
+private:
+  const GeoPoint start;
+
+public:
+  explicit CorridorAirspaceVisitor(const GeoPoint &_start):start(_start) {}
+
+  void Visit(const AbstractAirspace &as) override {
+    for (const auto &i : intersections)
+      crossings.push_back({&as, start.Distance(i.first),
+                           /* only one edge found: the segment ends
+                              inside the airspace */
+                           i.first == i.second
+                           ? -1.
+                           : start.Distance(i.second)});
+  }
+};
+
+void
+CorridorComputer::Update(const MoreData &basic, const DerivedInfo &calculated,
+                         const ComputerSettings &settings, CorridorInfo &info)
+{
+  if (terrain != nullptr) {
+    RasterTerrain::Lease map(*terrain);
+    const RasterMap &_map = map;
+    Update(basic, calculated, settings, &_map, info);
+  } else
+    Update(basic, calculated, settings, nullptr, info);
+}
+
+void
+CorridorComputer::Update(const MoreData &basic, const DerivedInfo &calculated,
+                         const ComputerSettings &settings,
+                         const RasterMap *map, CorridorInfo &info)
+{
+  if (!basic.location_available || !basic.track_available) {
+    Reset();
+    info.Clear();
+    return;
+  }
+
+  /* terrain tiles were loaded or airspaces were modified: the cached
+     data is stale */
+  if ((map != nullptr && map->GetSerial() != terrain_serial) ||
+      (airspaces != nullptr && airspaces->GetSerial() != airspace_serial))
+    valid = false;
+
+  double along = 0;
+  if (valid) {
+    const GeoPoint end = GetSliceLocation(NUM_SLICES - 1);
+    along = basic.location.ProjectedDistance(origin, end);
+    const double lateral =
+      basic.location.Distance(GetSliceLocation(along / step));
+
+    if ((!calculated.circling &&
+         (basic.track - bearing).AsDelta().Absolute() > MAX_TRACK_DEVIATION) ||
+        lateral > MAX_LATERAL_DEVIATION || along < -step / 2 ||
+        along >= step * (NUM_SLICES - 1))
+      valid = false;
+    else if (along >= step) {
+      const unsigned n = unsigned(along / step);
+      Shift(n, map);
+      along -= n * step;
+    }
+  }
+
+  if (!valid) {
+    Rebuild(basic.location, basic.track, map);
+    along = 0;
+  }
+
+  info.available.Update(basic.clock);
+  info.origin = origin;
+  info.end = GetSliceLocation(NUM_SLICES - 1);
+  info.range = step * (NUM_SLICES - 1);
+  info.aircraft_distance = along;
+  std::copy_n(terrain_heights, NUM_SLICES, info.terrain);
+
+  UpdateAirspaces(ToAircraftState(basic, calculated), info);
+  UpdateReach(basic, calculated, settings, info);
+}
+
+void
+CorridorComputer::Rebuild(const GeoPoint &location, Angle track,
+                          const RasterMap *map)
+{
+  ++n_rebuilds;
+
+  valid = true;
+  bearing = track;
+  origin = location;
+
+  const GeoPoint end = GeoVector(RANGE, track).EndPoint(location);
+  slice_delta = (end - origin) * (1. / (NUM_SLICES - 1));
+  step = origin.Distance(end) / (NUM_SLICES - 1);
+
+  if (map != nullptr)
+    terrain_serial = map->GetSerial();
+  if (airspaces != nullptr)
+    airspace_serial = airspaces->GetSerial();
+
+  ScanTerrain(0, map);
+
+  intervals.clear();
+  ScanAirspaces(0);
+}
+
+void
+CorridorComputer::Shift(unsigned n, const RasterMap *map)
+{
+  assert(n > 0);
+  assert(n < NUM_SLICES);
+
+  std::copy(terrain_heights + n, terrain_heights + NUM_SLICES,
+            terrain_heights);
+
+  origin = GetSliceLocation(n);
+
+  const double offset = n * step;
+  intervals.erase(std::remove_if(intervals.begin(), intervals.end(),
+                                 [offset](Interval &i){
+                                   i.start = std::max(i.start - offset, 0.);
+                                   i.end -= offset;
+                                   return i.end <= 0;
+                                 }),
+                  intervals.end());
+
+  ScanTerrain(NUM_SLICES - n, map);
+  ScanAirspaces(NUM_SLICES - 1 - n);
+}
+
+void
+CorridorComputer::ScanTerrain(unsigned first, const RasterMap *map)
+{
+  assert(first < NUM_SLICES);
+
+  const unsigned n = NUM_SLICES - first;
+  n_scanned_slices += n;
+
+  if (map == nullptr)
+    std::fill_n(terrain_heights + first, n, TerrainHeight::Invalid());
+  else if (n == 1)
+    terrain_heights[first] =
+      map->GetInterpolatedHeight(GetSliceLocation(first));
+  else
+    map->ScanLine(GetSliceLocation(first), GetSliceLocation(NUM_SLICES - 1),
+                  terrain_heights + first, n, true);
+}
+
+void
+CorridorComputer::ScanAirspaces(unsigned first)
+{
+  if (airspaces == nullptr)
+    return;
+
+  const GeoPoint start = GetSliceLocation(first);
+  const double offset = first * step;
+  const double length = step * (NUM_SLICES - 1);
+
+  CorridorAirspaceVisitor visitor(start);
+  airspaces->VisitIntersecting(start, GetSliceLocation(NUM_SLICES - 1),
+                               true, visitor);
+
+  /* distances calculated from different origins are not exactly
+     equal */
+  const double tolerance = step / 4;
+
+  for (const auto &c : visitor.crossings) {
+    const double s = offset + c.start;
+    const double e = c.end < 0 ? length : offset + c.end;
+
+    if (first > 0 && s <= offset + tolerance) {
+      /* continues an airspace which was crossed by the previous end
+         of the corridor */
+      auto i = std::find_if(intervals.begin(), intervals.end(),
+                            [&c, offset, tolerance](const Interval &i){
+                              return i.airspace == c.airspace &&
+                                i.end >= offset - tolerance;
+                            });
+      if (i != intervals.end()) {
+        i->end = std::max(i->end, e);
+        continue;
+      }
+    }
+
+    intervals.push_back({c.airspace, s, e});
+  }
+
+  std::sort(intervals.begin(), intervals.end(),
+            [](const Interval &a, const Interval &b){
+              return a.start < b.start;
+            });
+}
+
+void
+CorridorComputer::UpdateAirspaces(const AltitudeState &state,
+                                  CorridorInfo &info) const
+{
+  info.airspaces.clear();
+  info.airspaces_truncated = false;
+
+  /* #intervals is sorted, so the airspaces nearest to the origin are
+     kept if there are too many */
+  for (const auto &i : intervals) {
+    if (info.airspaces.full()) {
+      info.airspaces_truncated = true;
+      break;
+    }
+
+    const AbstractAirspace &as = *i.airspace;
+
+    CorridorAirspace &a = info.airspaces.append();
+    a.start = i.start;
+    a.end = i.end;
+    a.base = as.GetBaseAltitude(state);
+    a.top = as.GetTopAltitude(state);
+    a.type = as.GetType();
+    a.base_terrain = as.IsBaseTerrain();
+    a.name = as.GetName();
+  }
+}
+
+void
+CorridorComputer::UpdateReach(const MoreData &basic,
+                              const DerivedInfo &calculated,
+                              const ComputerSettings &settings,
+                              CorridorInfo &info) const
+{
+  info.reach_available = false;
+
+  const double remaining = info.GetRemainingRange();
+  if (!basic.NavAltitudeAvailable() ||
+      !calculated.glide_polar_safety.IsValid() || remaining <= 0)
+    return;
+
+  const double altitude = basic.nav_altitude;
+
+  const MacCready mc(settings.task.glide, calculated.glide_polar_safety);
+  const GlideState state(GeoVector(remaining, bearing), 0, altitude,
+                         calculated.GetWindOrZero());
+  const GlideResult result = mc.SolveStraight(state);
+  if (!result.IsOk())
+    return;
+
+  /* the glide line is straight; this is its height loss per metre */
+  const double slope = (altitude - result.GetArrivalAltitude()) / remaining;
+  const double safety_height =
+    settings.task.route_planner.safety_height_terrain;
+
+  info.terrain_collision = false;
+  info.reach_distance = remaining;
+
+  for (unsigned i = 0; i < NUM_SLICES; ++i) {
+    const double distance = info.GetSliceDistance(i) - info.aircraft_distance;
+    const TerrainHeight h = info.terrain[i];
+    if (distance < 0 || h.IsInvalid())
+      continue;
+
+    const double clearance = altitude - distance * slope
+      - h.GetValueOr0() - safety_height;
+
+    if (!info.reach_available || clearance < info.min_clearance) {
+      info.reach_available = true;
+      info.min_clearance = clearance;
+      info.min_clearance_distance = distance;
+    }
+
+    if (clearance < 0 && !info.terrain_collision) {
+      info.terrain_collision = true;
+      info.reach_distance = distance;
+    }
+  }
+}
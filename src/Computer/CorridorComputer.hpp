@@ -0,0 +1,190 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_CORRIDOR_COMPUTER_HPP
+#define XCSOAR_CORRIDOR_COMPUTER_HPP
+
+#include "CorridorInfo.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Math/Angle.hpp"
+#include "util/Serial.hpp"
+
+#include <vector>
+
+struct MoreData;
+struct DerivedInfo;
+struct ComputerSettings;
+struct AltitudeState;
+class Airspaces;
+class AbstractAirspace;
+class RasterMap;
+class RasterTerrain;
+
+/**
+ * Maintains the look-ahead #CorridorInfo along the current track.
+ *
+ * The corridor consists of equally spaced slices.  As long as the
+ * aircraft follows the corridor, it is not recalculated: when the
+ * aircraft passes a slice, the profile is shifted and only the new
+ * slices at the far end are scanned, and only the new segment is
+ * checked for airspace.  The profile is rebuilt from scratch only
+ * when the aircraft turns away or leaves the corridor, or when
+ * terrain or airspace data changes.
+ */
+class CorridorComputer {
+public:
+  static constexpr unsigned NUM_SLICES = CorridorInfo::NUM_SLICES;
+
+  /**
+   * The length of the corridor [m].
+   */
+  static constexpr double RANGE = 50000;
+
+private:
+  const Airspaces *airspaces;
+  const RasterTerrain *terrain = nullptr;
+
+  /**
+   * Is the current corridor valid?
+   */
+  bool valid = false;
+
+  Angle bearing;
+
+  GeoPoint origin;
+
+  /**
+   * The (latitude/longitude) offset between two slices.
+   */
+  GeoPoint slice_delta;
+
+  /**
+   * The distance between two slices [m].
+   */
+  double step;
+
+  Serial terrain_serial, airspace_serial;
+
+  TerrainHeight terrain_heights[NUM_SLICES];
+
+  struct Interval {
+    const AbstractAirspace *airspace;
+
+    /**
+     * Distance from #origin [m].
+     */
+    double start, end;
+  };
+
+  /**
+   * The airspaces crossed by the corridor, sorted by #Interval::start.
+   */
+  std::vector<Interval> intervals;
+
+  unsigned n_rebuilds = 0, n_scanned_slices = 0;
+
+public:
+  explicit CorridorComputer(const Airspaces *_airspaces=nullptr)
+    :airspaces(_airspaces) {}
+
+  void SetTerrain(const RasterTerrain *_terrain) {
+    terrain = _terrain;
+    valid = false;
+  }
+
+  /**
+   * Forget the current corridor; the next update will rebuild it.
+   */
+  void Reset() {
+    valid = false;
+    intervals.clear();
+  }
+
+  /**
+   * Must be called before the airspace database is cleared.
+   */
+  void ClearAirspaces() {
+    Reset();
+  }
+
+  /**
+   * The number of times the profile was built from scratch.
+   */
+  unsigned GetRebuildCount() const {
+    return n_rebuilds;
+  }
+
+  /**
+   * The number of terrain slices which were scanned.
+   */
+  unsigned GetScannedSliceCount() const {
+    return n_scanned_slices;
+  }
+
+  /**
+   * Update the corridor for the current position, using the terrain
+   * set by SetTerrain().
+   */
+  void Update(const MoreData &basic, const DerivedInfo &calculated,
+              const ComputerSettings &settings, CorridorInfo &info);
+
+  /**
+   * Update the corridor for the current position.
+   *
+   * @param map the terrain (locked by the caller) or nullptr
+   */
+  void Update(const MoreData &basic, const DerivedInfo &calculated,
+              const ComputerSettings &settings, const RasterMap *map,
+              CorridorInfo &info);
+
+private:
+  GeoPoint GetSliceLocation(double i) const {
+    return origin + slice_delta * i;
+  }
+
+  void Rebuild(const GeoPoint &location, Angle track, const RasterMap *map);
+
+  /**
+   * Move the corridor forward by the specified number of slices.
+   */
+  void Shift(unsigned n, const RasterMap *map);
+
+  /**
+   * Scan terrain for the slices [first, NUM_SLICES).
+   */
+  void ScanTerrain(unsigned first, const RasterMap *map);
+
+  /**
+   * Add the airspaces crossed between the given slice and the end of
+   * the corridor, and restore the order of #intervals.
+   */
+  void ScanAirspaces(unsigned first);
+
+  void UpdateAirspaces(const AltitudeState &state, CorridorInfo &info) const;
+
+  void UpdateReach(const MoreData &basic, const DerivedInfo &calculated,
+                   const ComputerSettings &settings,
+                   CorridorInfo &info) const;
+};
+
+#endif
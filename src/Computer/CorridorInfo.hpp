@@ -0,0 +1,165 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_CORRIDOR_INFO_HPP
+#define XCSOAR_CORRIDOR_INFO_HPP
+
+#include "Geo/GeoPoint.hpp"
+#include "Terrain/Height.hpp"
+#include "NMEA/Validity.hpp"
+#include "Engine/Airspace/AirspaceClass.hpp"
+#include "util/TrivialArray.hxx"
+#include "util/StaticString.hxx"
+
+/**
+ * An airspace crossed by the look-ahead corridor.  This is a copy of
+ * what the cross section needs to draw it, kept small because it is
+ * part of #DerivedInfo.
+ */
+struct CorridorAirspace {
+  /**
+   * Start and end of the crossing, measured from
+   * CorridorInfo::origin [m].
+   */
+  float start, end;
+
+  /**
+   * Base and top altitude (MSL), resolved for the current aircraft
+   * altitude and terrain height [m].
+   */
+  float base, top;
+
+  AirspaceClass type;
+
+  bool base_terrain;
+
+  /**
+   * The airspace name, truncated; it is only used as a label.
+   */
+  StaticString<22> name;
+};
+
+/**
+ * A look-ahead profile of terrain, airspace and glide reach along the
+ * current track.  It is maintained incrementally by #CorridorComputer
+ * on the calculation thread.
+ */
+struct CorridorInfo {
+  /**
+   * The number of terrain slices.  With 128 slices over the 50 km
+   * corridor, they are 394 m apart, which is fine enough to replace
+   * the cross section's own terrain scan for ranges of 25 km and
+   * more (see CrossSectionRenderer::IsCorridorTerrainUsable()).
+   */
+  static constexpr unsigned NUM_SLICES = 128;
+
+  static constexpr unsigned MAX_AIRSPACES = 12;
+
+  Validity available;
+
+  /**
+   * The location of the first slice.  The aircraft is somewhere
+   * between the first and the second slice, see #aircraft_distance.
+   */
+  GeoPoint origin;
+
+  /**
+   * The location of the last slice.
+   */
+  GeoPoint end;
+
+  /**
+   * The distance from #origin to #end [m].
+   */
+  double range;
+
+  /**
+   * The distance of the aircraft from #origin along the corridor
+   * [m].
+   */
+  double aircraft_distance;
+
+  /**
+   * Terrain heights of slices which are equally spaced from #origin
+   * to #end.  All slices are invalid if no terrain is loaded.
+   */
+  TerrainHeight terrain[NUM_SLICES];
+
+  /**
+   * The airspaces crossed by the corridor, sorted by
+   * CorridorAirspace::start.
+   */
+  TrivialArray<CorridorAirspace, MAX_AIRSPACES> airspaces;
+
+  /**
+   * Were airspaces beyond #MAX_AIRSPACES dropped from #airspaces?
+   * The list is then complete only up to the start of its last
+   * element.
+   */
+  bool airspaces_truncated;
+
+  /**
+   * Is the glide reach below valid?  This requires altitude and a
+   * valid safety polar.
+   */
+  bool reach_available;
+
+  /**
+   * Does the glide line (safety MacCready, including the terrain
+   * safety height) hit the terrain inside the corridor?
+   */
+  bool terrain_collision;
+
+  /**
+   * The distance from the aircraft to the terrain collision, or to
+   * the end of the corridor if there is none [m].
+   */
+  double reach_distance;
+
+  /**
+   * The smallest height of the glide line above the terrain safety
+   * height, and the distance from the aircraft where it occurs [m].
+   * Negative if there is a terrain collision.
+   */
+  double min_clearance, min_clearance_distance;
+
+  double GetSliceDistance(unsigned i) const {
+    return range * i / (NUM_SLICES - 1);
+  }
+
+  /**
+   * The length of the corridor ahead of the aircraft [m].
+   */
+  double GetRemainingRange() const {
+    return range - aircraft_distance;
+  }
+
+  void Clear() {
+    available.Clear();
+    airspaces.clear();
+    airspaces_truncated = false;
+    reach_available = false;
+  }
+};
+
+#endif
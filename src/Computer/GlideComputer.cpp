@@ -38,6 +38,7 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
   :air_data_computer(_way_points),
    warning_computer(_settings.airspace.warnings, _airspace_database),
    task_computer(task, _airspace_database, &warning_computer.GetManager()),
+   corridor_computer(&_airspace_database),
    waypoints(_way_points),
    retrospective(_way_points),
    team_code_ref_id(-1)
@@ -45,6 +46,42 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
   ReadComputerSettings(_settings);
   events.SetComputer(*this);
   idle_clock.Update();
+  RegisterIdleJobs();
+}
+
+void
+GlideComputer::RegisterIdleJobs()
+{
+  using namespace std::chrono;
+
+  idle_scheduler.Add("task", milliseconds(500), seconds(5), milliseconds(50),
+                     [this](bool exhaustive){
+    task_computer.ProcessIdle(Basic(), SetCalculated(),
+                              GetComputerSettings(), exhaustive);
+  });
+
+  idle_scheduler.Add("warnings", milliseconds(500), seconds(1),
+                     milliseconds(20), [this](bool){
+    DerivedInfo &calculated = SetCalculated();
+    warning_computer.Update(GetComputerSettings(), Basic(),
+                            calculated, calculated.airspace_warnings);
+  });
+}
+
+void
+GlideComputer::ProcessLogging()
+{
+  const MoreData &basic = Basic();
+  DerivedInfo &calculated = SetCalculated();
+
+  // Log GPS fixes for internal usage
+  // (snail trail, stats, olc, ...)
+  stats_computer.DoLogging(basic, calculated);
+  log_computer.Run(basic, calculated, GetComputerSettings().logger);
+
+  // Calculate summary of flight
+  if (basic.location_available)
+    retrospective.UpdateSample(basic.location);
 }
 
 void
@@ -58,6 +95,7 @@ GlideComputer::ResetFlight(const bool full)
   retrospective.Reset();
 
   cu_computer.Reset();
+  corridor_computer.Reset();
   warning_computer.Reset();
 
   trace_history_time.Reset();
@@ -72,6 +110,8 @@ GlideComputer::Initialise()
 bool
 GlideComputer::ProcessGPS(bool force)
 {
+  INSTRUMENT_SCOPE(GLIDE_GPS);
+
   const MoreData &basic = Basic();
   DerivedInfo &calculated = SetCalculated();
   const ComputerSettings &settings = GetComputerSettings();
@@ -131,6 +171,8 @@ GlideComputer::ProcessGPS(bool force)
 
   cu_computer.Compute(basic, calculated, settings);
 
+  corridor_computer.Update(basic, calculated, settings, calculated.corridor);
+
   // Calculate the team code
   CalculateOwnTeamCode();
 
@@ -155,28 +197,6 @@ GlideComputer::ProcessGPS(bool force)
   return idle_clock.CheckUpdate(std::chrono::milliseconds(500));
 }
 
-void
-GlideComputer::ProcessIdle(bool exhaustive)
-{
-  const MoreData &basic = Basic();
-  DerivedInfo &calculated = SetCalculated();
-
-  // Log GPS fixes for internal usage
-  // (snail trail, stats, olc, ...)
-  stats_computer.DoLogging(basic, calculated);
-  log_computer.Run(basic, calculated, GetComputerSettings().logger);
-
-  task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
-                            exhaustive);
-
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
-
-  // Calculate summary of flight
-  if (basic.location_available)
-    retrospective.UpdateSample(basic.location);
-}
-
 bool
 GlideComputer::DetermineTeamCodeRefLocation()
 {
@@ -335,6 +355,7 @@ GlideComputer::SetTerrain(RasterTerrain* _terrain)
 {
   air_data_computer.SetTerrain(_terrain);
   task_computer.SetTerrain(_terrain);
+  corridor_computer.SetTerrain(_terrain);
 }
 
 void
@@ -27,12 +27,15 @@ Copyright_License {
 #include "GlideComputerBlackboard.hpp"
 #include "time/PeriodClock.hpp"
 #include "time/DeltaTime.hpp"
+#include "time/Instrument.hpp"
 #include "GlideComputerAirData.hpp"
 #include "StatsComputer.hpp"
 #include "TaskComputer.hpp"
 #include "LogComputer.hpp"
 #include "WarningComputer.hpp"
 #include "CuComputer.hpp"
+#include "CorridorComputer.hpp"
+#include "IdleScheduler.hpp"
 #include "util/Compiler.h"
 #include "Engine/Contest/Solvers/Retrospective.hpp"
 
@@ -53,6 +56,7 @@ class GlideComputer : public GlideComputerBlackboard
   StatsComputer stats_computer;
   LogComputer log_computer;
   CuComputer cu_computer;
+  CorridorComputer corridor_computer;
 
   const Waypoints &waypoints;
 
@@ -63,6 +67,12 @@ class GlideComputer : public GlideComputerBlackboard
 
   PeriodClock idle_clock;
 
+  /**
+   * Schedules the slow calculations which are deferred until the
+   * fast path (ProcessGPS()) has been published.
+   */
+  IdleScheduler idle_scheduler;
+
   /**
    * This object is used to check whether to update
    * DerivedInfo::trace_history.
@@ -106,9 +116,36 @@ public:
   bool ProcessGPS(bool force=false); // returns true if idle needs processing
 
   /**
-   * Process slow calculations. Called by the CalculationThread.
+   * Feed the IGC logger, the statistics and the flight summary.  This
+   * is cheap and must not be deferred, so it is not an idle job.
+   * Called by the CalculationThread when ProcessGPS() returns true.
+   */
+  void ProcessLogging();
+
+  /**
+   * Process all slow calculations now, regardless of their schedule.
    */
-  void ProcessIdle(bool exhaustive=false);
+  void ProcessIdle(bool exhaustive=false) {
+    INSTRUMENT_SCOPE(GLIDE_IDLE);
+    ProcessLogging();
+    idle_scheduler.RunAll(exhaustive);
+  }
+
+  /**
+   * Process those slow calculations which are due and fit into the
+   * given amount of time.  Called by the CalculationThread after
+   * ProcessLogging(), when the fast path results have been published.
+   *
+   * @return the number of jobs which were run
+   */
+  unsigned RunIdleJobs(IdleScheduler::Duration available) {
+    INSTRUMENT_SCOPE(GLIDE_IDLE);
+    return idle_scheduler.Run(available);
+  }
+
+  const IdleScheduler &GetIdleScheduler() const {
+    return idle_scheduler;
+  }
 
   void ProcessExhaustive() {
     ProcessIdle(true);
@@ -148,6 +185,7 @@ public:
 
   void ClearAirspaces() {
     task_computer.ClearAirspaces();
+    corridor_computer.ClearAirspaces();
   }
 
   const FlightStatistics &GetFlightStats() const {
@@ -191,6 +229,8 @@ private:
 
   void CalculateWorkingBand();
   void CalculateVarioScale();
+
+  void RegisterIdleJobs();
 };
 
 #endif
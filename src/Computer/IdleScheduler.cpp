@@ -0,0 +1,106 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IdleScheduler.hpp"
+
+#include <algorithm>
+
+void
+IdleScheduler::Job::Run(Clock::time_point now, bool exhaustive)
+{
+  if (IsOverdue(now) && last_run != Clock::time_point())
+    ++stats.late;
+
+  const auto start = Clock::now();
+  function(exhaustive);
+  const auto end = Clock::now();
+
+  const auto duration = end - start;
+  average += (duration - average) / 4;
+
+  ++stats.runs;
+  if (duration > budget)
+    ++stats.overruns;
+  if (duration > stats.max_duration)
+    stats.max_duration = duration;
+
+  last_run = now;
+}
+
+void
+IdleScheduler::Add(const char *name, Duration period, Duration deadline,
+                   Duration budget, Function function)
+{
+  jobs.emplace_back(name, period, std::max(period, deadline), budget,
+                    std::move(function));
+}
+
+unsigned
+IdleScheduler::Run(Clock::time_point now, Duration available)
+{
+  /* collect due jobs, earliest deadline first */
+  Job *due[16];
+  unsigned n_due = 0;
+
+  for (auto &job : jobs)
+    if (job.IsDue(now) && n_due < std::size(due))
+      due[n_due++] = &job;
+
+  std::stable_sort(due, due + n_due, [](const Job *a, const Job *b){
+    return a->last_run + a->deadline < b->last_run + b->deadline;
+  });
+
+  unsigned n_run = 0;
+  for (unsigned i = 0; i < n_due; ++i) {
+    Job &job = *due[i];
+
+    if (job.average > available && !job.IsOverdue(now))
+      /* doesn't fit; maybe a cheaper one does */
+      continue;
+
+    const auto start = Clock::now();
+    job.Run(now, false);
+    ++n_run;
+
+    available -= Clock::now() - start;
+  }
+
+  return n_run;
+}
+
+void
+IdleScheduler::RunAll(bool exhaustive)
+{
+  const auto now = Clock::now();
+  for (auto &job : jobs)
+    job.Run(now, exhaustive);
+}
+
+unsigned
+IdleScheduler::GetOverruns() const
+{
+  unsigned n = 0;
+  for (const auto &job : jobs)
+    n += job.stats.overruns;
+  return n;
+}
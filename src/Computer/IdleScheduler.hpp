@@ -0,0 +1,150 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IDLE_SCHEDULER_HPP
+#define XCSOAR_IDLE_SCHEDULER_HPP
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+/**
+ * Runs deferrable "slow" jobs in the time left over by the
+ * latency-critical "fast path".
+ *
+ * Each job has a period (how often it should run), a deadline (the
+ * longest it may be postponed) and a budget (how long it is expected
+ * to take).  Run() executes due jobs in deadline order as long as
+ * their measured duration fits into the available time; jobs past
+ * their deadline run even if they do not fit.
+ */
+class IdleScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  /**
+   * @param exhaustive perform a more thorough calculation, see
+   * RunAll()
+   */
+  typedef std::function<void(bool exhaustive)> Function;
+
+  struct Stats {
+    unsigned runs = 0;
+
+    /**
+     * The number of runs which exceeded the job's budget.
+     */
+    unsigned overruns = 0;
+
+    /**
+     * The number of runs which started after the job's deadline.
+     */
+    unsigned late = 0;
+
+    Duration max_duration = Duration::zero();
+  };
+
+private:
+  struct Job {
+    const char *name;
+    Function function;
+
+    Duration period, deadline, budget;
+
+    /**
+     * Moving average of the measured duration; initialised with the
+     * budget.
+     */
+    Duration average;
+
+    Clock::time_point last_run;
+
+    Stats stats;
+
+    Job(const char *_name, Duration _period, Duration _deadline,
+        Duration _budget, Function &&_function)
+      :name(_name), function(std::move(_function)),
+       period(_period), deadline(_deadline), budget(_budget),
+       average(_budget) {}
+
+    bool IsDue(Clock::time_point now) const {
+      return now >= last_run + period;
+    }
+
+    bool IsOverdue(Clock::time_point now) const {
+      return now >= last_run + deadline;
+    }
+
+    void Run(Clock::time_point now, bool exhaustive);
+  };
+
+  std::vector<Job> jobs;
+
+public:
+  /**
+   * Register a new job.  All jobs are due immediately after being
+   * added.
+   *
+   * @param period the job should run at most this often
+   * @param deadline the job must run at least this often, even if
+   * there is no time left
+   * @param budget the expected maximum duration of one run; runs
+   * taking longer are counted as overruns
+   */
+  void Add(const char *name, Duration period, Duration deadline,
+           Duration budget, Function function);
+
+  /**
+   * Run due jobs which fit into the given amount of time.
+   *
+   * @return the number of jobs which were run
+   */
+  unsigned Run(Clock::time_point now, Duration available);
+
+  unsigned Run(Duration available) {
+    return Run(Clock::now(), available);
+  }
+
+  /**
+   * Run all jobs now, regardless of their period.
+   */
+  void RunAll(bool exhaustive=false);
+
+  /**
+   * Invoke the given function with the name and the #Stats of each
+   * job.
+   */
+  template<typename F>
+  void VisitStats(F &&f) const {
+    for (const auto &job : jobs)
+      f(job.name, job.stats);
+  }
+
+  /**
+   * Returns the total number of overruns of all jobs.
+   */
+  unsigned GetOverruns() const;
+};
+
+#endif
@@ -28,6 +28,7 @@ Copyright_License {
 #include "NMEA/Derived.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Navigation/Aircraft.hpp"
+#include "time/Instrument.hpp"
 
 #include <algorithm>
 
@@ -117,6 +118,7 @@ RouteComputer::TerrainWarning(const MoreData &basic,
       last_active_tp = calculated.task_stats.active_index;
 
       if (dirty) {
+        INSTRUMENT_SCOPE(ROUTE_SOLVE);
         protected_route_planner.SolveRoute(dest, start, config, h_ceiling);
         calculated.planned_route = route_planner.GetSolution();
 
@@ -125,6 +127,7 @@ RouteComputer::TerrainWarning(const MoreData &basic,
       }
       return;
     } else {
+      INSTRUMENT_SCOPE(ROUTE_SOLVE);
       protected_route_planner.SolveRoute(start, start, config, h_ceiling);
       calculated.planned_route = route_planner.GetSolution();
     }
@@ -152,7 +155,10 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
                                (int)calculated.common_stats.height_max_working));
 
   if (reach_clock.CheckAdvance(basic.time, PERIOD)) {
-    protected_route_planner.SolveReach(start, config, h_ceiling, do_solve);
+    {
+      INSTRUMENT_SCOPE(ROUTE_REACH);
+      protected_route_planner.SolveReach(start, config, h_ceiling, do_solve);
+    }
 
     if (do_solve) {
       calculated.terrain_base = route_planner.GetTerrainBase();
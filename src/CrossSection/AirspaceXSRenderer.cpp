@@ -33,8 +33,90 @@
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "Geo/GeoVector.hpp"
+#include "Computer/CorridorInfo.hpp"
 #include "util/StringCompare.hxx"
 
+#include <algorithm>
+
+/**
+ * Render an airspace box to the canvas
+ * @param rc On-screen coordinates of the box
+ * @param type Airspace class
+ */
+static void
+RenderBox(Canvas &canvas, const PixelRect rc, AirspaceClass type,
+          const AirspaceLook &airspace_look,
+          const AirspaceRendererSettings &settings)
+{
+  if (AirspacePreviewRenderer::PrepareFill(canvas, type, airspace_look,
+                                           settings)) {
+    const auto &class_settings = settings.classes[type];
+
+    // Draw thick brushed outlines
+    const unsigned border_width = class_settings.fill_mode ==
+      AirspaceClassRendererSettings::FillMode::PADDING
+      ? Layout::ScalePenWidth(10)
+      : 0;
+
+    if (border_width > 0 &&
+        rc.GetWidth() > border_width * 2 &&
+        rc.GetHeight() > border_width * 2) {
+      PixelRect border = rc;
+      border.Grow(-(int)border_width);
+
+      // Left border
+      canvas.Rectangle(rc.left, rc.top, border.left, rc.bottom);
+
+      // Right border
+      canvas.Rectangle(border.right, rc.top, rc.right, rc.bottom);
+
+      // Bottom border
+      canvas.Rectangle(border.left, border.bottom, border.right, rc.bottom);
+
+      // Top border
+      canvas.Rectangle(border.left, rc.top, border.right, border.top);
+    } else {
+      // .. or fill the entire rect if the outlines would overlap
+      canvas.Rectangle(rc.left, rc.top, rc.right, rc.bottom);
+    }
+
+    AirspacePreviewRenderer::UnprepareFill(canvas);
+  }
+
+  // Use transparent brush and type-dependent pen for the outlines
+  if (AirspacePreviewRenderer::PrepareOutline(canvas, type, airspace_look,
+                                              settings))
+    canvas.Rectangle(rc.left, rc.top, rc.right, rc.bottom);
+}
+
+/**
+ * Draw the airspace name centered between min_x and max_x
+ * @param rc On-screen coordinates of the (last) box
+ */
+static void
+DrawName(Canvas &canvas, const TCHAR *name, int min_x, int max_x,
+         const PixelRect &rc)
+{
+  min_x += Layout::GetTextPadding();
+  max_x -= Layout::GetTextPadding();
+
+  if (name == nullptr || StringIsEmpty(name) || min_x >= max_x)
+    return;
+
+  canvas.SetBackgroundTransparent();
+  canvas.SetTextColor(COLOR_BLACK);
+
+  const unsigned max_width = max_x - min_x;
+
+  const PixelSize name_size = canvas.CalcTextSize(name);
+  const int x = unsigned(name_size.cx) >= max_width
+    ? min_x
+    : (min_x + max_x - name_size.cx) / 2;
+  const int y = (rc.top + rc.bottom - name_size.cy) / 2;
+
+  canvas.DrawClippedText(x, y, max_x - x, name);
+}
+
 /**
  * Local visitor class used for rendering airspaces in the CrossSectionRenderer
  */
@@ -74,15 +156,6 @@ public:
     airspace_look(_airspace_look),
     start(_start), state(_state) {}
 
-  /**
-   * Render an airspace box to the canvas
-   * @param rc On-screen coordinates of the box
-   * @param brush Brush to use
-   * @param black Use black pen?
-   * @param type Airspace class
-   */
-  void RenderBox(const PixelRect rc, AirspaceClass type) const;
-
   /**
    * Renders the AbstractAirspace on the canvas
    * @param as AbstractAirspace to render
@@ -94,51 +167,6 @@ public:
   }
 };
 
-inline void
-AirspaceIntersectionVisitorSlice::RenderBox(const PixelRect rc,
-                                            AirspaceClass type) const
-{
-  if (AirspacePreviewRenderer::PrepareFill(canvas, type, airspace_look,
-                                           settings)) {
-    const auto &class_settings = settings.classes[type];
-
-    // Draw thick brushed outlines
-    const unsigned border_width = class_settings.fill_mode ==
-      AirspaceClassRendererSettings::FillMode::PADDING
-      ? Layout::ScalePenWidth(10)
-      : 0;
-
-    if (border_width > 0 &&
-        rc.GetWidth() > border_width * 2 &&
-        rc.GetHeight() > border_width * 2) {
-      PixelRect border = rc;
-      border.Grow(-(int)border_width);
-
-      // Left border
-      canvas.Rectangle(rc.left, rc.top, border.left, rc.bottom);
-
-      // Right border
-      canvas.Rectangle(border.right, rc.top, rc.right, rc.bottom);
-
-      // Bottom border
-      canvas.Rectangle(border.left, border.bottom, border.right, rc.bottom);
-
-      // Top border
-      canvas.Rectangle(border.left, rc.top, border.right, border.top);
-    } else {
-      // .. or fill the entire rect if the outlines would overlap
-      canvas.Rectangle(rc.left, rc.top, rc.right, rc.bottom);
-    }
-
-    AirspacePreviewRenderer::UnprepareFill(canvas);
-  }
-
-  // Use transparent brush and type-dependent pen for the outlines
-  if (AirspacePreviewRenderer::PrepareOutline(canvas, type, airspace_look,
-                                              settings))
-    canvas.Rectangle(rc.left, rc.top, rc.right, rc.bottom);
-}
-
 inline void
 AirspaceIntersectionVisitorSlice::Render(const AbstractAirspace &as) const
 {
@@ -181,28 +209,11 @@ AirspaceIntersectionVisitorSlice::Render(const AbstractAirspace &as) const
       max_x = rcd.right;
 
     // Draw the airspace
-    RenderBox(rcd, type);
+    RenderBox(canvas, rcd, type, airspace_look, settings);
   }
 
-  min_x += Layout::GetTextPadding();
-  max_x -= Layout::GetTextPadding();
-
   /* draw the airspace name */
-  const TCHAR *name = as.GetName();
-  if (name != nullptr && !StringIsEmpty(name) && min_x < max_x) {
-    canvas.SetBackgroundTransparent();
-    canvas.SetTextColor(COLOR_BLACK);
-
-    const unsigned max_width = max_x - min_x;
-
-    const PixelSize name_size = canvas.CalcTextSize(name);
-    const int x = unsigned(name_size.cx) >= max_width
-      ? min_x
-      : (min_x + max_x - name_size.cx) / 2;
-    const int y = (rcd.top + rcd.bottom - name_size.cy) / 2;
-
-    canvas.DrawClippedText(x, y, max_x - x, name);
-  }
+  DrawName(canvas, as.GetName(), min_x, max_x, rcd);
 }
 
 
@@ -220,3 +231,29 @@ AirspaceXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
   // Call visitor with intersecting airspaces
   database.VisitIntersecting(start, vec.EndPoint(start), true, ivisitor);
 }
+
+void
+AirspaceXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
+                         const CorridorInfo &corridor) const
+{
+  canvas.Select(*look.name_font);
+
+  const double max_distance = chart.GetXMax();
+
+  for (const auto &as : corridor.airspaces) {
+    const double start = as.start - corridor.aircraft_distance;
+    const double end = as.end - corridor.aircraft_distance;
+    if (end <= 0 || start >= max_distance ||
+        !settings.classes[as.type].display)
+      continue;
+
+    PixelRect rcd;
+    rcd.top = chart.ScreenY(as.top);
+    rcd.bottom = chart.ScreenY(as.base_terrain ? 0. : as.base);
+    rcd.left = chart.ScreenX(std::max(start, 0.));
+    rcd.right = chart.ScreenX(std::min(end, max_distance));
+
+    RenderBox(canvas, rcd, as.type, look, settings);
+    DrawName(canvas, as.name, rcd.left, rcd.right, rcd);
+  }
+}
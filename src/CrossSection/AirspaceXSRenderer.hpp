@@ -33,6 +33,7 @@ class Airspaces;
 struct GeoPoint;
 struct GeoVector;
 struct AircraftState;
+struct CorridorInfo;
 
 /**
  * A Window which renders a terrain and airspace cross-section
@@ -51,6 +52,13 @@ public:
             const GeoPoint &start, const GeoVector &vec,
             const AircraftState &state) const;
 
+  /**
+   * Draw the airspaces of a look-ahead profile calculated by
+   * #CorridorComputer.
+   */
+  void Draw(Canvas &canvas, const ChartRenderer &chart,
+            const CorridorInfo &corridor) const;
+
   void SetSettings(const AirspaceRendererSettings &_settings) {
     settings = _settings;
   }
@@ -34,6 +34,9 @@
 #include "Engine/GlideSolvers/GlideState.hpp"
 #include "Engine/GlideSolvers/MacCready.hpp"
 #include "Language/Language.hpp"
+#include "Math/Util.hpp"
+
+#include <algorithm>
 
 CrossSectionRenderer::CrossSectionRenderer(const CrossSectionLook &_look,
                                            const AirspaceLook &_airspace_look,
@@ -84,10 +87,17 @@ CrossSectionRenderer::Paint(Canvas &canvas, const PixelRect rc) const
   chart.ScaleYFromValue(hmin);
   chart.ScaleYFromValue(hmax);
 
-  TerrainHeight elevations[NUM_SLICES];
-  UpdateTerrain(elevations);
+  const bool use_corridor = IsCorridorUsable();
 
-  if (airspace_database != nullptr) {
+  TerrainHeight elevations[NUM_SLICES];
+  if (use_corridor && IsCorridorTerrainUsable())
+    UpdateCorridorTerrain(elevations);
+  else
+    UpdateTerrain(elevations);
+
+  if (use_corridor && IsCorridorAirspaceUsable()) {
+    airspace_renderer.Draw(canvas, chart, calculated_info.corridor);
+  } else if (airspace_database != nullptr) {
     const AircraftState aircraft = ToAircraftState(Basic(), Calculated());
     airspace_renderer.Draw(canvas, chart, *airspace_database, start, vec,
                            aircraft);
@@ -96,6 +106,8 @@ CrossSectionRenderer::Paint(Canvas &canvas, const PixelRect rc) const
   terrain_renderer.Draw(canvas, chart, elevations);
   PaintWorking(chart);
   PaintGlide(chart);
+  if (use_corridor)
+    PaintTerrainCollision(chart);
   PaintAircraft(canvas, chart, rc);
 
   canvas.SetTextColor(inverse? COLOR_WHITE: look.text_color);
@@ -104,6 +116,42 @@ CrossSectionRenderer::Paint(Canvas &canvas, const PixelRect rc) const
   PaintGrid(canvas, chart);
 }
 
+bool
+CrossSectionRenderer::IsCorridorUsable() const
+{
+  const CorridorInfo &corridor = calculated_info.corridor;
+  if (!corridor.available || !gps_info.location_available ||
+      start != gps_info.location ||
+      vec.distance > corridor.GetRemainingRange())
+    return false;
+
+  /* the corridor is frozen while circling, and it is rebuilt only
+     after larger track changes; don't use it unless its far end is
+     less than one slice away from where we would look */
+  const Angle bearing = corridor.origin.Bearing(corridor.end);
+  const Angle delta = (bearing - vec.bearing).AsDelta().Absolute();
+  return delta < Angle::QuarterCircle() &&
+    vec.distance * delta.sin() <= corridor.GetSliceDistance(1);
+}
+
+bool
+CrossSectionRenderer::IsCorridorAirspaceUsable() const
+{
+  /* the airspace list is sorted; if it was truncated, it is complete
+     only up to the start of its last element */
+  const CorridorInfo &corridor = calculated_info.corridor;
+  return !corridor.airspaces_truncated ||
+    corridor.airspaces.back().start >
+    corridor.aircraft_distance + vec.distance;
+}
+
+bool
+CrossSectionRenderer::IsCorridorTerrainUsable() const
+{
+  const CorridorInfo &corridor = calculated_info.corridor;
+  return corridor.GetSliceDistance(1) <= vec.distance / (NUM_SLICES - 1);
+}
+
 void
 CrossSectionRenderer::UpdateTerrain(TerrainHeight *elevations) const
 {
@@ -124,6 +172,29 @@ CrossSectionRenderer::UpdateTerrain(TerrainHeight *elevations) const
   }
 }
 
+void
+CrossSectionRenderer::UpdateCorridorTerrain(TerrainHeight *elevations) const
+{
+  const CorridorInfo &corridor = calculated_info.corridor;
+  constexpr unsigned n = CorridorInfo::NUM_SLICES;
+
+  for (unsigned i = 0; i < NUM_SLICES; ++i) {
+    const double distance = corridor.aircraft_distance +
+      vec.distance * i / (NUM_SLICES - 1);
+    const double f = std::clamp(distance / corridor.range * (n - 1),
+                                0., double(n - 1));
+    const unsigned j = std::min(unsigned(f), n - 2);
+    const double t = f - j;
+
+    const TerrainHeight a = corridor.terrain[j], b = corridor.terrain[j + 1];
+    if (a.IsSpecial() || b.IsSpecial())
+      elevations[i] = t < 0.5 ? a : b;
+    else
+      elevations[i] = TerrainHeight(iround(a.GetValue() +
+                                           (b.GetValue() - a.GetValue()) * t));
+  }
+}
+
 void
 CrossSectionRenderer::PaintGlide(ChartRenderer &chart) const
 {
@@ -171,6 +242,19 @@ CrossSectionRenderer::PaintWorking(ChartRenderer &chart) const
   }
 }
 
+void
+CrossSectionRenderer::PaintTerrainCollision(ChartRenderer &chart) const
+{
+  const CorridorInfo &corridor = calculated_info.corridor;
+  if (!corridor.reach_available || !corridor.terrain_collision ||
+      corridor.reach_distance > chart.GetXMax())
+    return;
+
+  chart.DrawLine(corridor.reach_distance, chart.GetYMin(),
+                 corridor.reach_distance, chart.GetYMax(),
+                 ChartLook::STYLE_REDTHICKDASH);
+}
+
 void
 CrossSectionRenderer::PaintAircraft(Canvas &canvas, const ChartRenderer &chart,
                                     const PixelRect rc) const
@@ -140,13 +140,46 @@ public:
   }
 
 protected:
+  /**
+   * Can the look-ahead profile calculated by #CorridorComputer be
+   * drawn instead of sampling terrain and airspaces here?  That is
+   * the case if it starts at the aircraft, covers the whole range
+   * and points in the same direction, i.e. its center line is less
+   * than one slice away from ours at the end of the range.
+   */
+  [[gnu::pure]]
+  bool IsCorridorUsable() const;
+
+  /**
+   * Is the terrain of the (usable) look-ahead profile at least as
+   * detailed as our own terrain scan would be?  If not, the terrain
+   * is sampled here, and the profile is only used for airspaces.
+   */
+  [[gnu::pure]]
+  bool IsCorridorTerrainUsable() const;
+
+  /**
+   * Does the airspace list of the (usable) look-ahead profile cover
+   * the whole range?  It may have been truncated; then the airspace
+   * database is searched here.
+   */
+  [[gnu::pure]]
+  bool IsCorridorAirspaceUsable() const;
+
   void UpdateTerrain(TerrainHeight *elevations) const;
 
+  /**
+   * Resample the terrain of the look-ahead corridor to #NUM_SLICES
+   * slices covering the range of this cross section.
+   */
+  void UpdateCorridorTerrain(TerrainHeight *elevations) const;
+
   void PaintGlide(ChartRenderer &chart) const;
   void PaintAircraft(Canvas &canvas, const ChartRenderer &chart,
                      const PixelRect rc) const;
   void PaintGrid(Canvas &canvas, ChartRenderer &chart) const;
   void PaintWorking(ChartRenderer &chart) const;
+  void PaintTerrainCollision(ChartRenderer &chart) const;
 };
 
 #endif
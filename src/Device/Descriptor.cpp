@@ -45,6 +45,8 @@ Copyright_License {
 #include "Input/InputQueue.hpp"
 #include "LogFile.hpp"
 #include "Job/Job.hpp"
+#include "time/LatencyTrace.hpp"
+#include "Audio/VarioGlue.hpp"
 
 #ifdef ANDROID
 #include "java/Object.hxx"
@@ -1165,7 +1167,30 @@ DeviceDescriptor::ParseLine(const char *line)
   std::lock_guard<Mutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   basic.UpdateClock();
-  return ParseNMEA(line, basic);
+
+  const Validity old_vario_available = basic.total_energy_vario_available;
+  if (!ParseNMEA(line, basic))
+    return false;
+
+  basic.latency_stamp = received_stamp;
+  LatencyTrace::Record(LatencyTrace::Stage::PARSED, received_stamp);
+
+  FastForwardVario(basic, old_vario_available);
+  return true;
+}
+
+void
+DeviceDescriptor::FastForwardVario(const NMEAInfo &basic,
+                                   Validity old_available)
+{
+  if (basic.total_energy_vario_available.Modified(old_available) &&
+      device_blackboard->IsPrimaryVarioSource(index)) {
+    /* pass the new value to the audio vario right away; waiting for
+       the MergeThread would delay the tone by a few dozen
+       milliseconds */
+    AudioVarioGlue::SetValue(basic.total_energy_vario);
+    LatencyTrace::Record(LatencyTrace::Stage::AUDIO, basic.latency_stamp);
+  }
 }
 
 void
@@ -1217,6 +1242,8 @@ DeviceDescriptor::PortError(const char *msg) noexcept
 bool
 DeviceDescriptor::DataReceived(const void *data, size_t length) noexcept
 {
+  received_stamp = LatencyTrace::Begin();
+
   if (monitor != nullptr)
     monitor->DataReceived(data, length);
 
@@ -1227,11 +1254,16 @@ DeviceDescriptor::DataReceived(const void *data, size_t length) noexcept
     basic.UpdateClock();
 
     const ExternalSettings old_settings = basic.settings;
+    const Validity old_vario_available = basic.total_energy_vario_available;
 
     if (device->DataReceived(data, length, basic)) {
       if (!config.sync_from_device)
         basic.settings = old_settings;
 
+      basic.latency_stamp = received_stamp;
+      LatencyTrace::Record(LatencyTrace::Stage::PARSED, received_stamp);
+      FastForwardVario(basic, old_vario_available);
+
       device_blackboard->ScheduleMerge();
     }
 
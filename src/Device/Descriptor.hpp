@@ -32,6 +32,7 @@ Copyright_License {
 #include "Device/Parser.hpp"
 #include "RadioFrequency.hpp"
 #include "NMEA/ExternalSettings.hpp"
+#include "NMEA/Validity.hpp"
 #include "time/PeriodClock.hpp"
 #include "Job/Async.hpp"
 #include "ui/event/Notify.hpp"
@@ -45,6 +46,7 @@ Copyright_License {
 #include <memory>
 
 #include <cassert>
+#include <cstdint>
 #include <tchar.h>
 #include <stdio.h>
 
@@ -189,6 +191,12 @@ class DeviceDescriptor final : PortListener, PortLineSplitter {
    */
   NMEAParser parser;
 
+  /**
+   * The LatencyTrace::Stamp of the most recent DataReceived() call.
+   * Only used in the port's receive thread.
+   */
+  uint_least64_t received_stamp = 0;
+
   /**
    * The settings that were sent to the device.  This is used to check
    * if the device is sending back the new configuration; then the
@@ -471,6 +479,15 @@ public:
 private:
   bool ParseNMEA(const char *line, struct NMEAInfo &info);
 
+  /**
+   * Pass a total energy vario value which was just parsed directly
+   * to the audio vario, bypassing MergeThread.  Caller must lock the
+   * #DeviceBlackboard.
+   *
+   * @param old_available the vario's #Validity before parsing
+   */
+  void FastForwardVario(const NMEAInfo &basic, Validity old_available);
+
 public:
   void SetMonitor(DataHandler  *_monitor) {
     monitor = _monitor;
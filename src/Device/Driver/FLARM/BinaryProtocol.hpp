@@ -58,6 +58,48 @@ namespace FLARM {
     MT_GETIGCDATA = 0x22,
   };
 
+  /**
+   * Convert a baud rate to the code which is used by #MT_SETBAUDRATE
+   * and by the "BAUD" setting.
+   *
+   * @return the code or -1 if the FLARM does not support this baud
+   * rate
+   */
+  constexpr int
+  BaudRateToCode(unsigned baud_rate)
+  {
+    switch (baud_rate) {
+    case 4800: return 0;
+    case 9600: return 1;
+    case 19200: return 2;
+    case 38400: return 4;
+    case 57600: return 5;
+    case 115200: return 6;
+    case 230400: return 7;
+    default: return -1;
+    }
+  }
+
+  /**
+   * The reverse of BaudRateToCode().
+   *
+   * @return the baud rate or 0 if the code is unknown
+   */
+  constexpr unsigned
+  CodeToBaudRate(unsigned code)
+  {
+    switch (code) {
+    case 0: return 4800;
+    case 1: return 9600;
+    case 2: return 19200;
+    case 4: return 38400;
+    case 5: return 57600;
+    case 6: return 115200;
+    case 7: return 230400;
+    default: return 0;
+    }
+  }
+
   /**
    * The binary transfer mode works with "frames". Each frame consists of a
    * start byte (0x73), an 8-byte frame header and an optional payload. The
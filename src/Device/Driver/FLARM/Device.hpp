@@ -56,14 +56,32 @@ class FlarmDevice: public AbstractDevice
 
   uint16_t sequence_number = 0;
 
+  /**
+   * The baud rate for downloading flights in binary mode; 0 if the
+   * NMEA baud rate shall be used.
+   */
+  const unsigned bulk_baud_rate;
+
+  /**
+   * The NMEA baud rate which shall be restored when leaving binary
+   * mode; 0 if the baud rate has not been changed.
+   */
+  unsigned old_baud_rate = 0;
+
+  /**
+   * A buffer for received frame payloads, reused for all frames of a
+   * flight download.
+   */
+  AllocatedArray<uint8_t> receive_buffer;
+
   /**
    * Settings that were received in PDVSC sentences.
    */
   DeviceSettingsMap<std::string> settings;
 
 public:
-  FlarmDevice(Port &_port)
-    :port(_port) {}
+  explicit FlarmDevice(Port &_port, unsigned _bulk_baud_rate=0)
+    :port(_port), bulk_baud_rate(_bulk_baud_rate) {}
 
   /**
    * Write a setting to the FLARM.
@@ -95,6 +113,20 @@ protected:
   bool TextMode(OperationEnvironment &env);
   bool BinaryMode(OperationEnvironment &env);
 
+  /**
+   * Switch the FLARM (which must be in binary mode) and the port to
+   * #bulk_baud_rate.  On failure, both fall back to the old baud
+   * rate.
+   *
+   * @return false if the FLARM does not respond anymore
+   */
+  bool EnableBulkBaudRate(OperationEnvironment &env);
+
+  /**
+   * Restore the NMEA baud rate after the FLARM has left binary mode.
+   */
+  void RestoreBaudRate();
+
   bool ParsePFLAC(NMEAInputLine &line);
 
 public:
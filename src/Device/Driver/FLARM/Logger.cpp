@@ -324,28 +324,29 @@ FlarmDevice::DownloadFlight(Path path, OperationEnvironment &env)
       return false;
 
     // Wait for an answer and save the payload for further processing
-    AllocatedArray<uint8_t> data;
     uint16_t length;
-    bool ack = WaitForACKOrNACK(header.sequence_number, data,
+    bool ack = WaitForACKOrNACK(header.sequence_number, receive_buffer,
                                 length, env, std::chrono::seconds(10)) == FLARM::MT_ACK;
 
     // If no ACK was received
     if (!ack || length <= 3 || env.IsCancelled())
       return false;
 
+    // The buffer is reused for all frames and may be larger than
+    // this payload
+    const uint8_t *data = receive_buffer.data();
     length -= 3;
 
     // Read progress (in percent)
-    uint8_t progress = *(data.begin() + 2);
+    uint8_t progress = data[2];
     env.SetProgressPosition(std::min((unsigned)progress, 100u));
 
-    const char *last_char = (const char *)data.end() - 1;
-    bool is_last_packet = (*last_char == 0x1A);
+    const char *igc_data = (const char *)data + 3;
+    bool is_last_packet = (igc_data[length - 1] == 0x1A);
     if (is_last_packet)
       length--;
 
     // Read IGC data
-    const char *igc_data = (const char *)data.begin() + 3;
     os.Write(igc_data, length);
 
     if (is_last_packet)
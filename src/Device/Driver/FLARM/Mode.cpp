@@ -35,6 +35,7 @@ FlarmDevice::EnableNMEA(OperationEnvironment &env)
     if (!BinaryReset(env, std::chrono::milliseconds(500)))
       return false;
 
+    RestoreBaudRate();
     mode = Mode::NMEA;
 
     /* request self-test results and version information from FLARM */
@@ -58,6 +59,7 @@ FlarmDevice::EnableNMEA(OperationEnvironment &env)
       return false;
     }
 
+    RestoreBaudRate();
     mode = Mode::NMEA;
     return true;
   }
@@ -94,12 +96,84 @@ FlarmDevice::BinaryMode(OperationEnvironment &env)
       return false;
     }
 
-    if (BinaryPing(env, std::chrono::milliseconds(500)))
+    if (BinaryPing(env, std::chrono::milliseconds(500))) {
       // We are now in binary mode and have verified that with a binary ping
+      if (bulk_baud_rate != 0 && !EnableBulkBaudRate(env)) {
+        mode = Mode::UNKNOWN;
+        return false;
+      }
+
       return true;
+    }
   }
 
   // Apparently the switch to binary mode didn't work
   mode = Mode::UNKNOWN;
   return false;
 }
+
+bool
+FlarmDevice::EnableBulkBaudRate(OperationEnvironment &env)
+{
+  assert(mode == Mode::BINARY);
+  assert(bulk_baud_rate != 0);
+
+  const unsigned current_baud_rate = port.GetBaudrate();
+  if (current_baud_rate == 0 || current_baud_rate == bulk_baud_rate)
+    /* not a serial port, or already fast enough */
+    return true;
+
+  const int code = FLARM::BaudRateToCode(bulk_baud_rate);
+  if (code < 0)
+    return true;
+
+  /* the new baud rate is only valid until the FLARM leaves binary
+     mode, see RestoreBaudRate() */
+  const uint8_t payload[1] = { uint8_t(code) };
+  const FLARM::FrameHeader header =
+    PrepareFrameHeader(FLARM::MT_SETBAUDRATE, payload, sizeof(payload));
+
+  if (!SendStartByte() ||
+      !SendFrameHeader(header, env, std::chrono::seconds(1)) ||
+      !SendEscaped(payload, sizeof(payload), env, std::chrono::seconds(1)))
+    return false;
+
+  if (!WaitForACK(header.sequence_number, env, std::chrono::seconds(1)))
+    /* not supported by this FLARM; continue at the current baud
+       rate */
+    return true;
+
+  /* the FLARM switches after sending the ACK; give it some time, just
+     like the LX driver does */
+  port.Drain();
+  env.Sleep(std::chrono::milliseconds(100));
+
+  if (!port.SetBaudrate(bulk_baud_rate))
+    return false;
+
+  old_baud_rate = current_baud_rate;
+  port.Flush();
+
+  for (unsigned i = 0; i < 3; ++i)
+    if (BinaryPing(env, std::chrono::milliseconds(500)))
+      return true;
+
+  /* the FLARM did not follow; try to continue at the old baud
+     rate */
+  RestoreBaudRate();
+  port.Flush();
+  return BinaryPing(env, std::chrono::milliseconds(500));
+}
+
+void
+FlarmDevice::RestoreBaudRate()
+{
+  if (old_baud_rate == 0)
+    return;
+
+  /* leaving binary mode resets the FLARM to its configured baud
+     rate */
+  port.Drain();
+  port.SetBaudrate(old_baud_rate);
+  old_baud_rate = 0;
+}
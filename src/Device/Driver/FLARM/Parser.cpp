@@ -58,11 +58,12 @@ FlarmDevice::ParseNMEA(const char *_line, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(_line);
-  char type[16];
-  line.Read(type, 16);
 
-  if (StringIsEqual(type, "$PFLAC"))
+  switch (line.ReadSentenceId()) {
+  case MakeNMEASentenceId("$PFLAC"):
     return ParsePFLAC(line);
-  else
+
+  default:
     return false;
+  }
 }
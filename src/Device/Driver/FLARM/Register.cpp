@@ -23,15 +23,21 @@ Copyright_License {
 
 #include "Device/Driver/FLARM.hpp"
 #include "Device.hpp"
+#include "Device/Config.hpp"
 
 static Device *
 FlarmCreateOnPort(const DeviceConfig &config, Port &com_port)
 {
-  return new FlarmDevice(com_port);
+  const unsigned bulk_baud_rate = config.UsesSpeed()
+    ? config.bulk_baud_rate
+    : 0;
+
+  return new FlarmDevice(com_port, bulk_baud_rate);
 }
 
 const struct DeviceRegister flarm_driver = {
   _T("FLARM"), _T("FLARM"),
-  DeviceRegister::DECLARE | DeviceRegister::LOGGER | DeviceRegister::MANAGE,
+  DeviceRegister::DECLARE | DeviceRegister::LOGGER | DeviceRegister::MANAGE |
+  DeviceRegister::BULK_BAUD_RATE,
   FlarmCreateOnPort,
 };
@@ -26,13 +26,15 @@ Copyright_License {
 #include "util/ByteOrder.hxx"
 #include "io/BufferedOutputStream.hxx"
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <cstdio>
 
 #include <stdlib.h>
 #include <string.h>
 
-struct Context {
+struct LX::LXNToIGCConverter::Context {
   uint8_t flight_no;
   char date[7];
   LXN::FlightInfo flight_info;
@@ -44,11 +46,17 @@ struct Context {
   char vendor[3];
   LXN::ExtensionConfig k_ext, b_ext;
 
+  /**
+   * The length of the current run of #LXN::EMPTY bytes.
+   */
+  unsigned empty_length;
+
   Context()
     :flight_no(0),
      time(0), origin_time(0),
      origin_latitude(0), origin_longitude(0),
-     is_event(false) {
+     is_event(false),
+     empty_length(0) {
     memset(date, 0, sizeof(date));
     flight_info.competition_class_id = 0xff;
     memset(vendor, 0, sizeof(vendor));
@@ -57,6 +65,8 @@ struct Context {
   }
 };
 
+using Context = LX::LXNToIGCConverter::Context;
+
 static bool
 ValidString(const char *p, size_t size)
 {
@@ -132,37 +142,48 @@ HandleExtConfig(BufferedOutputStream &os, const struct LXN::ExtConfig &packet,
   os.Write("\r\n");
 }
 
-bool
-LX::ConvertLXNToIGC(const void *_data, size_t _length,
-                    BufferedOutputStream &os)
+LX::LXNToIGCConverter::Result
+LX::LXNToIGCConverter::ConvertPacket(const uint8_t *&_data,
+                                     const uint8_t *end, bool last)
 {
-  const uint8_t *data = (const uint8_t *)_data, *end = data + _length;
-  Context context;
+  const uint8_t *data = _data;
+  Context &context = *this->context;
   char ch;
   unsigned l;
 
-  while (data < end) {
+  assert(data < end);
+
+  if (context.empty_length > 0 && *data != LXN::EMPTY) {
+    os.Format("LFILEMPTY%u\r\n", context.empty_length);
+    context.empty_length = 0;
+  }
+
+  {
     union LXN::Packet packet = { data };
 
-    unsigned packet_length;
     switch ((LXN::Command)*packet.cmd) {
     case LXN::EMPTY:
-      packet_length = 0;
+      /* a run of empty bytes may continue in the next chunk, so it
+         is counted in the context and reported at its end */
       while (data < end && *data == LXN::EMPTY) {
-        ++packet_length;
+        ++context.empty_length;
         ++data;
       }
 
-      os.Format("LFILEMPTY%u\r\n", packet_length);
+      if (data == end && !last)
+        break;
+
+      os.Format("LFILEMPTY%u\r\n", context.empty_length);
+      context.empty_length = 0;
       break;
 
     case LXN::END:
-      return true;
+      return Result::END;
 
     case LXN::VERSION:
       data += sizeof(*packet.version);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       os.Format("HFRFWFIRMWAREVERSION:%3.1f\r\n"
                 "HFRHWHARDWAREVERSION:%3.1f\r\n",
@@ -172,9 +193,11 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
 
     case LXN::START:
       data += sizeof(*packet.start);
-      if (data > end ||
-          memcmp(packet.start->streraz, "STReRAZ", 8) != 0)
-        return false;
+      if (data > end)
+        return Result::INCOMPLETE;
+
+      if (memcmp(packet.start->streraz, "STReRAZ", 8) != 0)
+        return Result::MALFORMED;
 
       context.flight_no = packet.start->flight_no;
       break;
@@ -182,7 +205,7 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
     case LXN::ORIGIN:
       data += sizeof(*packet.origin);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       context.origin_time = FromBE32(packet.origin->time);
       context.origin_latitude = (int32_t)FromBE32(packet.origin->latitude);
@@ -203,7 +226,7 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
     case LXN::SECURITY_OLD:
       data += sizeof(*packet.security_old);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       os.Format("G%22.22s\r\n", packet.security_old->foo);
       break;
@@ -211,10 +234,10 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
     case LXN::SERIAL:
       data += sizeof(*packet.serial);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       if (!ValidString(packet.serial->serial, sizeof(packet.serial->serial)))
-        return false;
+        return Result::MALFORMED;
 
       os.Format("A%sFLIGHT:%u\r\nHFDTE%s\r\n",
                 packet.serial->serial, context.flight_no, context.date);
@@ -224,16 +247,18 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
     case LXN::POSITION_BAD:
       data += sizeof(*packet.position);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       HandlePosition(os, context, *packet.position);
       break;
 
     case LXN::SECURITY:
       data += sizeof(*packet.security);
-      if (data > end ||
-          packet.security->length > sizeof(packet.security->foo))
-        return false;
+      if (data > end)
+        return Result::INCOMPLETE;
+
+      if (packet.security->length > sizeof(packet.security->foo))
+        return Result::MALFORMED;
 
       if (packet.security->type == LXN::SECURITY_HIGH)
         ch = '2';
@@ -242,7 +267,7 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
       else if (packet.security->type == LXN::SECURITY_LOW)
         ch = '0';
       else
-        return false;
+        return Result::MALFORMED;
 
       os.Format("G%c", ch);
 
@@ -255,7 +280,7 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
     case LXN::SECURITY_7000:
       data += sizeof(*packet.security_7000);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       if (packet.security_7000->x40 == 0x12) {
         os.Write("G3");
@@ -287,11 +312,11 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
     case LXN::COMPETITION_CLASS:
       data += sizeof(*packet.competition_class);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       if (!ValidString(packet.competition_class->class_id,
                        sizeof(packet.competition_class->class_id)))
-        return false;
+        return Result::MALFORMED;
 
       if (context.flight_info.competition_class_id == 7)
         os.Format("HFFXA%03d\r\n"
@@ -318,7 +343,7 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
     case LXN::TASK:
       data += sizeof(*packet.task);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       context.time = FromBE32(packet.task->time);
 
@@ -338,7 +363,7 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
           int longitude = (int32_t)FromBE32(packet.task->longitude[i]);
 
           if (!ValidString(packet.task->name[i], sizeof(packet.task->name[i])))
-            return false;
+            return Result::MALFORMED;
 
           os.Format("C%02d%05d%c" "%03d%05d%c" "%s\r\n",
                     abs(latitude) / 60000, abs(latitude) % 60000,
@@ -352,9 +377,11 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
 
     case LXN::EVENT:
       data += sizeof(*packet.event);
-      if (data > end ||
-          !ValidString(packet.event->foo, sizeof(packet.event->foo)))
-        return false;
+      if (data > end)
+        return Result::INCOMPLETE;
+
+      if (!ValidString(packet.event->foo, sizeof(packet.event->foo)))
+        return Result::MALFORMED;
 
       context.event = *packet.event;
       context.is_event = true;
@@ -364,7 +391,7 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
       data += sizeof(*packet.b_ext) +
         context.b_ext.num * sizeof(packet.b_ext->data[0]);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       for (unsigned i = 0; i < context.b_ext.num; ++i)
         os.Format("%0*u",
@@ -378,7 +405,7 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
       data += sizeof(*packet.k_ext) +
         context.k_ext.num * sizeof(packet.k_ext->data[0]);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       l = context.time + packet.k_ext->foo;
       os.Format("K%02d%02d%02d", l / 3600, l % 3600 / 60, l % 60);
@@ -393,9 +420,11 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
 
     case LXN::DATE:
       data += sizeof(*packet.date);
-      if (data > end ||
-          packet.date->day > 31 || packet.date->month > 12)
-        return false;
+      if (data > end)
+        return Result::INCOMPLETE;
+
+      if (packet.date->day > 31 || packet.date->month > 12)
+        return Result::MALFORMED;
 
       snprintf(context.date, sizeof(context.date),
                "%02d%02d%02d",
@@ -405,8 +434,10 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
 
     case LXN::FLIGHT_INFO:
       data += sizeof(*packet.flight_info);
-      if (data > end ||
-          !ValidString(packet.flight_info->pilot,
+      if (data > end)
+        return Result::INCOMPLETE;
+
+      if (!ValidString(packet.flight_info->pilot,
                        sizeof(packet.flight_info->pilot)) ||
           !ValidString(packet.flight_info->copilot,
                        sizeof(packet.flight_info->copilot)) ||
@@ -417,10 +448,10 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
           !ValidString(packet.flight_info->competition_class,
                        sizeof(packet.flight_info->competition_class)) ||
           !ValidString(packet.flight_info->gps, sizeof(packet.flight_info->gps)))
-        return false;
+        return Result::MALFORMED;
 
       if (packet.flight_info->competition_class_id > 7)
-        return false;
+        return Result::MALFORMED;
 
       if (packet.flight_info->competition_class_id < 7)
         os.Format("HFFXA%03d\r\n"
@@ -449,7 +480,7 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
     case LXN::K_EXT_CONFIG:
       data += sizeof(*packet.ext_config);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       HandleExtConfig(os, *packet.ext_config, context.k_ext, 'J', 8);
       break;
@@ -457,7 +488,7 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
     case LXN::B_EXT_CONFIG:
       data += sizeof(*packet.ext_config);
       if (data > end)
-        return false;
+        return Result::INCOMPLETE;
 
       HandleExtConfig(os, *packet.ext_config, context.b_ext, 'I', 36);
       break;
@@ -469,11 +500,11 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
       if (*packet.cmd < 0x40) {
         data += sizeof(*packet.string);
         if (data > end)
-          return false;
+          return Result::INCOMPLETE;
 
         data += packet.string->length;
         if (data > end)
-          return false;
+          return Result::INCOMPLETE;
 
         os.Format("%.*s\r\n",
                   (int)packet.string->length, packet.string->value);
@@ -482,9 +513,116 @@ LX::ConvertLXNToIGC(const void *_data, size_t _length,
             memcmp(packet.string->value, "HFFTYFRTYPE:", 12) == 0)
           memcpy(context.vendor, packet.string->value + 12, sizeof(context.vendor));
       } else
-        return false;
+        return Result::MALFORMED;
+    }
+  }
+
+  _data = data;
+  return Result::OK;
+}
+
+const uint8_t *
+LX::LXNToIGCConverter::ConvertPackets(const uint8_t *data,
+                                      const uint8_t *end, bool last)
+{
+  while (data < end) {
+    switch (ConvertPacket(data, end, last)) {
+    case Result::OK:
+      break;
+
+    case Result::INCOMPLETE:
+      return data;
+
+    case Result::END:
+      end_found = true;
+      return end;
+
+    case Result::MALFORMED:
+      return nullptr;
+    }
+  }
+
+  return data;
+}
+
+LX::LXNToIGCConverter::LXNToIGCConverter(BufferedOutputStream &_os)
+  :os(_os), context(std::make_unique<Context>()) {}
+
+LX::LXNToIGCConverter::~LXNToIGCConverter() noexcept = default;
+
+bool
+LX::LXNToIGCConverter::Feed(const void *_data, size_t length)
+{
+  const uint8_t *data = (const uint8_t *)_data, *end = data + length;
+
+  while (!pending.empty() && data < end && !end_found) {
+    /* complete the packet which was split at the end of the previous
+       chunk by copying a few more bytes; LXN packets are small */
+    const size_t old_size = pending.size();
+    const size_t n = std::min(size_t(end - data), size_t(256));
+    pending.insert(pending.end(), data, data + n);
+
+    const uint8_t *rest = ConvertPackets(pending.data(),
+                                         pending.data() + pending.size(),
+                                         false);
+    if (rest == nullptr)
+      return false;
+
+    const size_t consumed = rest - pending.data();
+    if (consumed >= old_size) {
+      /* the split packet is complete; continue with the new chunk */
+      data += consumed - old_size;
+      pending.clear();
+    } else {
+      pending.erase(pending.begin(), pending.begin() + consumed);
+      data += n;
     }
   }
 
-  return false;
+  if (end_found) {
+    pending.clear();
+    return true;
+  }
+
+  if (data == end)
+    return true;
+
+  const uint8_t *rest = ConvertPackets(data, end, false);
+  if (rest == nullptr)
+    return false;
+
+  if (!end_found)
+    pending.assign(rest, end);
+  return true;
+}
+
+bool
+LX::LXNToIGCConverter::Finish()
+{
+  if (end_found)
+    return true;
+
+  if (!pending.empty()) {
+    const uint8_t *rest = ConvertPackets(pending.data(),
+                                         pending.data() + pending.size(),
+                                         true);
+    pending.clear();
+    if (rest == nullptr)
+      return false;
+  }
+
+  if (context->empty_length > 0) {
+    os.Format("LFILEMPTY%u\r\n", context->empty_length);
+    context->empty_length = 0;
+  }
+
+  return end_found;
+}
+
+bool
+LX::ConvertLXNToIGC(const void *data, size_t length,
+                    BufferedOutputStream &os)
+{
+  LXNToIGCConverter converter(os);
+  return converter.Feed(data, length) && converter.Finish();
 }
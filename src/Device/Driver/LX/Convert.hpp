@@ -24,11 +24,82 @@ Copyright_License {
 #ifndef XCSOAR_DEVICE_DRIVER_LX_CONVERT_HPP
 #define XCSOAR_DEVICE_DRIVER_LX_CONVERT_HPP
 
+#include <memory>
+#include <vector>
+
 #include <cstddef>
+#include <cstdint>
 
 class BufferedOutputStream;
 
 namespace LX {
+  /**
+   * Converts a stream of LXN data to IGC.  The data may be passed in
+   * arbitrary chunks while it is being received from the logger;
+   * packets which are split between two chunks are reassembled.
+   */
+  class LXNToIGCConverter {
+  public:
+    struct Context;
+
+  private:
+    BufferedOutputStream &os;
+
+    std::unique_ptr<Context> context;
+
+    /**
+     * The beginning of a packet which was incomplete at the end of
+     * the previous chunk.
+     */
+    std::vector<uint8_t> pending;
+
+    /**
+     * Has the END packet been found?  All following data is ignored.
+     */
+    bool end_found = false;
+
+  public:
+    explicit LXNToIGCConverter(BufferedOutputStream &_os);
+    ~LXNToIGCConverter() noexcept;
+
+    LXNToIGCConverter(const LXNToIGCConverter &) = delete;
+    LXNToIGCConverter &operator=(const LXNToIGCConverter &) = delete;
+
+    /**
+     * Convert the next chunk of LXN data.
+     *
+     * @return false if the data is malformed
+     */
+    bool Feed(const void *data, size_t length);
+
+    /**
+     * To be called after the last chunk has been passed to Feed().
+     *
+     * @return true if the end of the LXN data has been found
+     */
+    bool Finish();
+
+  private:
+    enum class Result {
+      OK,
+      INCOMPLETE,
+      END,
+      MALFORMED,
+    };
+
+    Result ConvertPacket(const uint8_t *&data, const uint8_t *end,
+                         bool last);
+
+    /**
+     * Convert as many packets as possible.
+     *
+     * @return a pointer to the first byte which was not consumed, or
+     * nullptr on error
+     */
+    const uint8_t *ConvertPackets(const uint8_t *data, const uint8_t *end,
+                                  bool last);
+  };
+
   /**
    * Convert a BLOB of LXN data to IGC, write to a file.
    */
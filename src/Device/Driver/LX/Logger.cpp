@@ -32,10 +32,9 @@
 #include "system/Path.hpp"
 #include "io/BufferedOutputStream.hxx"
 #include "io/FileOutputStream.hxx"
+#include "util/AllocatedArray.hxx"
 #include "util/ScopeExit.hxx"
 
-#include <memory>
-
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -205,22 +204,29 @@ DownloadFlightInner(Port &port, const RecordedFlightInfo &flight,
 
   env.SetProgressRange(total_length);
 
-  const auto data = std::make_unique<uint8_t[]>(total_length);
-  uint8_t *p = data.get();
+  /* convert each section as soon as it has been received (and its
+     CRC has been verified), reusing one buffer for all sections */
+  LX::LXNToIGCConverter converter(os);
+  AllocatedArray<uint8_t> buffer;
+  unsigned position = 0;
   for (unsigned i = 0; i < LX::MemorySection::N && lengths[i] > 0; ++i) {
+    buffer.GrowDiscard(lengths[i]);
     if (!LX::ReceivePacketRetry(port, (LX::Command)(LX::READ_LOGGER_DATA + i),
-                                p, lengths[i], env,
+                                buffer.data(), lengths[i], env,
                                 std::chrono::seconds(20),
                                 std::chrono::seconds(2),
                                 std::chrono::minutes(5), 2)) {
       return false;
     }
 
-    p += lengths[i];
-    env.SetProgressPosition(p - data.get());
+    if (!converter.Feed(buffer.data(), lengths[i]))
+      return false;
+
+    position += lengths[i];
+    env.SetProgressPosition(position);
   }
 
-  return LX::ConvertLXNToIGC(data.get(), total_length, os);
+  return converter.Finish();
 }
 
 bool
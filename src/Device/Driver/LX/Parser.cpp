@@ -343,13 +343,12 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
 
-  if (StringIsEqual(type, "$LXWP0"))
+  switch (line.ReadSentenceId()) {
+  case MakeNMEASentenceId("$LXWP0"):
     return LXWP0(line, info);
 
-  if (StringIsEqual(type, "$LXWP1")) {
+  case MakeNMEASentenceId("$LXWP1"): {
     /* if in pass-through mode, assume that this line was sent by the
        secondary device */
     DeviceInfo &device_info = mode == Mode::PASS_THROUGH
@@ -383,34 +382,31 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return true;
   }
 
-  if (StringIsEqual(type, "$LXWP2"))
+  case MakeNMEASentenceId("$LXWP2"):
     return LXWP2(line, info);
 
-  if (StringIsEqual(type, "$LXWP3"))
+  case MakeNMEASentenceId("$LXWP3"):
     return LXWP3(line, info);
 
-  if (StringIsEqual(type, "$PLXV0")) {
+  case MakeNMEASentenceId("$PLXV0"):
     is_v7 = true;
     is_colibri = false;
     return PLXV0(line, v7_settings);
-  }
 
-  if (StringIsEqual(type, "$PLXVC")) {
+  case MakeNMEASentenceId("$PLXVC"):
     is_nano = true;
     is_colibri = false;
     PLXVC(line, info.device, info.secondary_device, nano_settings);
     is_forwarded_nano = info.secondary_device.product.equals("NANO") ||
                           info.secondary_device.product.equals("NANO3");
     return true;
-  }
 
-  if (StringIsEqual(type, "$PLXVF")) {
+  case MakeNMEASentenceId("$PLXVF"):
     is_v7 = true;
     is_colibri = false;
     return PLXVF(line, info);
-  }
 
-  if (StringIsEqual(type, "$PLXVS")) {
+  case MakeNMEASentenceId("$PLXVS"):
     is_v7 = true;
     is_colibri = false;
     return PLXVS(line, info);
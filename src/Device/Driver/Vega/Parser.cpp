@@ -219,32 +219,44 @@ bool
 VegaDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
+  const auto type = line.ReadSentenceId();
 
-  if (memcmp(type, "$PD", 3) == 0)
+  if (GetNMEASentenceIdChar(type, 0) == '$' &&
+      GetNMEASentenceIdChar(type, 1) == 'P' &&
+      GetNMEASentenceIdChar(type, 2) == 'D')
     detected = true;
 
-  if (StringIsEqual(type, "$PDSWC"))
+  switch (type) {
+  case MakeNMEASentenceId("$PDSWC"):
     return PDSWC(line, info, volatile_data);
-  else if (StringIsEqual(type, "$PDAAV"))
+
+  case MakeNMEASentenceId("$PDAAV"):
     return PDAAV(line, info);
-  else if (StringIsEqual(type, "$PDVSC"))
+
+  case MakeNMEASentenceId("$PDVSC"):
     return PDVSC(line, info);
-  else if (StringIsEqual(type, "$PDVDV"))
+
+  case MakeNMEASentenceId("$PDVDV"):
     return PDVDV(line, info);
-  else if (StringIsEqual(type, "$PDVDS"))
+
+  case MakeNMEASentenceId("$PDVDS"):
     return PDVDS(line, info);
-  else if (StringIsEqual(type, "$PDVVT"))
+
+  case MakeNMEASentenceId("$PDVVT"):
     return PDVVT(line, info);
-  else if (StringIsEqual(type, "$PDVSD")) {
+
+  case MakeNMEASentenceId("$PDVSD"): {
     const auto message = line.Rest();
     StaticString<256> buffer;
     buffer.SetASCII(message.begin(), message.end());
     Message::AddMessage(buffer);
     return true;
-  } else if (StringIsEqual(type, "$PDTSM"))
+  }
+
+  case MakeNMEASentenceId("$PDTSM"):
     return PDTSM(line, info);
-  else
+
+  default:
     return false;
+  }
 }
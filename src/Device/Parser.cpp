@@ -58,61 +58,56 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
 
   NMEAInputLine line(string);
 
-  char type[16];
-  line.Read(type, 16);
+  const auto type = line.ReadSentenceId();
 
-  if (IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
-    if (StringIsEqual(type + 3, "GSA"))
+  if (IsAlphaASCII(GetNMEASentenceIdChar(type, 1)) &&
+      IsAlphaASCII(GetNMEASentenceIdChar(type, 2))) {
+    switch (StripNMEATalker(type)) {
+    case MakeNMEASentenceId("$--GSA"):
       return GSA(line, info);
 
-    if (StringIsEqual(type + 3, "GLL"))
+    case MakeNMEASentenceId("$--GLL"):
       return GLL(line, info);
 
-    if (StringIsEqual(type + 3, "RMC"))
+    case MakeNMEASentenceId("$--RMC"):
       return RMC(line, info);
 
-    if (StringIsEqual(type + 3, "GGA"))
+    case MakeNMEASentenceId("$--GGA"):
       return GGA(line, info);
 
-    if (StringIsEqual(type + 3, "HDM"))
+    case MakeNMEASentenceId("$--HDM"):
       return HDM(line, info);
 
-    if (StringIsEqual(type + 3, "MWV"))
+    case MakeNMEASentenceId("$--MWV"):
       return MWV(line, info);
+    }
   }
 
-  // if (proprietary sentence) ...
-  if (type[1] == 'P') {
-    // Airspeed and vario sentence
-    if (StringIsEqual(type + 1, "PTAS1"))
-      return PTAS1(line, info);
-
-    // FLARM sentences
-    if (StringIsEqual(type + 1, "PFLAE")) {
-      ParsePFLAE(line, info.flarm.error, info.clock);
-      return true;
-    }
+  switch (type) {
+  // Airspeed and vario sentence
+  case MakeNMEASentenceId("$PTAS1"):
+    return PTAS1(line, info);
 
-    if (StringIsEqual(type + 1, "PFLAV")) {
-      ParsePFLAV(line, info.flarm.version, info.clock);
-      return true;
-    }
+  // FLARM sentences
+  case MakeNMEASentenceId("$PFLAE"):
+    ParsePFLAE(line, info.flarm.error, info.clock);
+    return true;
 
-    if (StringIsEqual(type + 1, "PFLAA")) {
-      ParsePFLAA(line, info.flarm.traffic, info.clock);
-      return true;
-    }
+  case MakeNMEASentenceId("$PFLAV"):
+    ParsePFLAV(line, info.flarm.version, info.clock);
+    return true;
 
-    if (StringIsEqual(type + 1, "PFLAU")) {
-      ParsePFLAU(line, info.flarm.status, info.clock);
-      return true;
-    }
+  case MakeNMEASentenceId("$PFLAA"):
+    ParsePFLAA(line, info.flarm.traffic, info.clock);
+    return true;
 
-    // Garmin altitude sentence
-    if (StringIsEqual(type + 1, "PGRMZ"))
-      return RMZ(line, info);
+  case MakeNMEASentenceId("$PFLAU"):
+    ParsePFLAU(line, info.flarm.status, info.clock);
+    return true;
 
-    return false;
+  // Garmin altitude sentence
+  case MakeNMEASentenceId("$PGRMZ"):
+    return RMZ(line, info);
   }
 
   return false;
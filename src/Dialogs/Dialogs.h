@@ -36,6 +36,8 @@ void ShowWindSettingsDialog();
 
 void dlgStatusShowModal(int page);
 
+void dlgInstrumentShowModal();
+
 void dlgCreditsShowModal(UI::SingleWindow &parent);
 
 void dlgQuickMenuShowModal(UI::SingleWindow &parent);
@@ -41,6 +41,7 @@ enum ControlIndex {
   MIN_FREQUENCY,
   ZERO_FREQUENCY,
   MAX_FREQUENCY,
+  SMOOTH_FREQUENCY,
   SPACER2,
   DEAD_BAND_MIN,
   DEAD_BAND_MAX,
@@ -99,6 +100,12 @@ AudioVarioConfigPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
              50, 3000, 50, settings.max_frequency);
   SetExpertRow(MAX_FREQUENCY);
 
+  AddBoolean(_("Smooth frequency"),
+             _("Glide smoothly from one tone frequency to the next instead "
+               "of changing it in steps."),
+             settings.smooth_frequency);
+  SetExpertRow(SMOOTH_FREQUENCY);
+
   AddSpacer();
   SetExpertRow(SPACER2);
 
@@ -152,6 +159,9 @@ AudioVarioConfigPanel::Save(bool &changed)
   changed |= SaveValue(MAX_FREQUENCY, ProfileKeys::VarioMaxFrequency,
                        settings.max_frequency);
 
+  changed |= SaveValue(SMOOTH_FREQUENCY, ProfileKeys::VarioSmoothFrequency,
+                       settings.smooth_frequency);
+
   changed |= SaveValue(DEAD_BAND_MIN, UnitGroup::VERTICAL_SPEED,
                        ProfileKeys::VarioDeadBandMin, settings.min_dead);
 
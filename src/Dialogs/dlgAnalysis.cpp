@@ -381,6 +381,7 @@ ChartControl::OnPaint(Canvas &canvas)
 
     thermal_band_renderer.DrawThermalBand(basic,
                                           calculated,
+                                          blackboard.GetCommonStats(),
                                           settings_computer,
                                           canvas, rcgfx,
                                           settings_computer.task,
@@ -554,7 +555,8 @@ AnalysisWidget::Update()
     StringFormatUnsafe(sTmp, _T("%s: %s"), _("Analysis"),
                        _("Task"));
     dialog.SetCaption(sTmp);
-    FlightStatisticsRenderer::CaptionTask(sTmp, calculated);
+    FlightStatisticsRenderer::CaptionTask(sTmp, calculated,
+                                          blackboard.GetCommonStats());
     info.SetText(sTmp);
     SetCalcCaption(_("Task calc"));
     break;
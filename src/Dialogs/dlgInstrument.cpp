@@ -0,0 +1,163 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Dialogs/Dialogs.h"
+#include "Dialogs/WidgetDialog.hpp"
+#include "Dialogs/Error.hpp"
+#include "Widget/LargeTextWidget.hpp"
+#include "Form/Button.hpp"
+#include "Form/ActionListener.hpp"
+#include "ui/event/PeriodicTimer.hpp"
+#include "LocalPath.hpp"
+#include "UIGlobals.hpp"
+#include "Language/Language.hpp"
+#include "time/Instrument.hpp"
+#include "io/FileOutputStream.hxx"
+#include "util/ConvertString.hpp"
+
+/**
+ * Shows the report of the hot path timers and counters (see
+ * time/Instrument.hpp), refreshed once per second.
+ */
+class InstrumentWidget final : public LargeTextWidget, ActionListener {
+  enum Buttons {
+    TOGGLE,
+    RESET,
+    SAVE,
+  };
+
+  Button *toggle_button;
+
+  UI::PeriodicTimer update_timer{[this]{ Update(); }};
+
+public:
+  explicit InstrumentWidget(const DialogLook &look)
+    :LargeTextWidget(look) {}
+
+  void CreateButtons(WidgetDialog &buttons);
+
+private:
+  void Update();
+  void UpdateToggleButton();
+  void SaveClicked();
+
+  /* virtual methods from class Widget */
+  void Show(const PixelRect &rc) override;
+  void Hide() override;
+
+  /* virtual methods from class ActionListener */
+  void OnAction(int id) noexcept override;
+};
+
+void
+InstrumentWidget::CreateButtons(WidgetDialog &buttons)
+{
+  toggle_button = buttons.AddButton(_("Start"), *this, TOGGLE);
+  buttons.AddButton(_("Reset"), *this, RESET);
+  buttons.AddButton(_("Save"), *this, SAVE);
+  UpdateToggleButton();
+}
+
+void
+InstrumentWidget::Update()
+{
+#ifdef INSTRUMENT
+  const std::string report = Instrument::FormatReport();
+  const UTF8ToWideConverter text(report.c_str());
+  if (text.IsValid())
+    SetText(text);
+#else
+  SetText(_("This version was compiled without instrumentation."));
+#endif
+}
+
+void
+InstrumentWidget::UpdateToggleButton()
+{
+  toggle_button->SetCaption(Instrument::IsEnabled() ? _("Stop") : _("Start"));
+}
+
+inline void
+InstrumentWidget::SaveClicked()
+try {
+  const auto path = LocalPath(_T("instrument.txt"));
+  const std::string report = Instrument::FormatReport();
+
+  FileOutputStream file(path);
+  file.Write(report.data(), report.length());
+  file.Commit();
+} catch (...) {
+  ShowError(std::current_exception(), _("Save"));
+}
+
+void
+InstrumentWidget::Show(const PixelRect &rc)
+{
+  LargeTextWidget::Show(rc);
+  Update();
+  update_timer.Schedule(std::chrono::seconds(1));
+}
+
+void
+InstrumentWidget::Hide()
+{
+  update_timer.Cancel();
+  LargeTextWidget::Hide();
+}
+
+void
+InstrumentWidget::OnAction(int id) noexcept
+{
+  switch (id) {
+  case TOGGLE:
+    if (Instrument::IsEnabled())
+      Instrument::Disable();
+    else
+      Instrument::Enable();
+    UpdateToggleButton();
+    break;
+
+  case RESET:
+    Instrument::Reset();
+    Update();
+    break;
+
+  case SAVE:
+    SaveClicked();
+    break;
+  }
+}
+
+void
+dlgInstrumentShowModal()
+{
+  const DialogLook &look = UIGlobals::GetDialogLook();
+  WidgetDialog dialog(WidgetDialog::Full{}, UIGlobals::GetMainWindow(),
+                      look, _("Instrumentation"));
+  InstrumentWidget widget(look);
+  widget.CreateButtons(dialog);
+  dialog.AddButton(_("Close"), mrOK);
+  dialog.FinishPreliminary(&widget);
+  dialog.ShowModal();
+  dialog.StealWidget();
+}
@@ -26,11 +26,6 @@
 #include "Predicate/AirspacePredicate.hpp"
 #include "Navigation/Aircraft.hpp"
 
-#include <boost/geometry/geometries/linestring.hpp>
-#include <boost/geometry/algorithms/intersection.hpp>
-#include <boost/geometry/strategies/strategies.hpp>
-
-namespace bgi = boost::geometry::index;
 
 Airspaces::const_iterator_range
 Airspaces::QueryWithinRange(const GeoPoint &location, double range) const
@@ -39,8 +34,9 @@ Airspaces::QueryWithinRange(const GeoPoint &location, double range) const
     // nothing to do
     return {airspace_tree.qend(), airspace_tree.qend()};
 
-  const FlatBoundingBox box = task_projection.ProjectSquare(location, range);
-  return {airspace_tree.qbegin(bgi::intersects(box)), airspace_tree.qend()};
+  const AirspaceTree::Query query(task_projection.ProjectSquare(location,
+                                                                range));
+  return {airspace_tree.qbegin(query), airspace_tree.qend()};
 }
 
 Airspaces::const_iterator_range
@@ -50,12 +46,9 @@ Airspaces::QueryIntersecting(const GeoPoint &a, const GeoPoint &b) const
     // nothing to do
     return {airspace_tree.qend(), airspace_tree.qend()};
 
-  // TODO: use StaticArray instead of std::vector
-  boost::geometry::model::linestring<FlatGeoPoint> line;
-  line.push_back(task_projection.ProjectInteger(a));
-  line.push_back(task_projection.ProjectInteger(b));
-
-  return {airspace_tree.qbegin(bgi::intersects(line)), airspace_tree.qend()};
+  const AirspaceTree::Query query(task_projection.ProjectInteger(a),
+                                  task_projection.ProjectInteger(b));
+  return {airspace_tree.qbegin(query), airspace_tree.qend()};
 }
 
 void
@@ -90,25 +83,27 @@ Airspaces::Optimise()
     /* avoid assertion failure in uninitialised task_projection */
     return;
 
+  AirspaceVector v;
+
   if (!owns_children || task_projection.Update()) {
     // dont update task_projection if not owner!
 
     // task projection changed, so need to push items back onto stack
     // to re-build airspace envelopes
 
-    for (const auto &i : QueryAll())
+    for (const auto &i : airspace_tree.GetItems())
       tmp_as.push_back(&i.GetAirspace());
+  } else
+    v = airspace_tree.GetItems();
 
-    airspace_tree.clear();
-  }
-
-  for (AbstractAirspace *i : tmp_as) {
-    Airspace as(*i, task_projection);
-    airspace_tree.insert(as);
-  }
+  v.reserve(v.size() + tmp_as.size());
+  for (AbstractAirspace *i : tmp_as)
+    v.emplace_back(*i, task_projection);
 
   tmp_as.clear();
 
+  airspace_tree.Build(std::move(v));
+
   ++serial;
 }
 
@@ -151,7 +146,7 @@ Airspaces::Clear()
 
   // delete items in the tree
   if (owns_children) {
-    for (const auto &i : QueryAll()) {
+    for (const auto &i : airspace_tree.GetItems()) {
       Airspace a = i;
       a.Destroy();
     }
@@ -221,13 +216,7 @@ CompareAirspaceVectors(const AirspacesInterface::AirspaceVector &a,
 inline AirspacesInterface::AirspaceVector
 Airspaces::AsVector() const
 {
-  AirspaceVector v;
-  v.reserve(airspace_tree.size());
-
-  for (const auto &i : QueryAll())
-    v.push_back(i);
-
-  return v;
+  return airspace_tree.GetItems();
 }
 
 bool
@@ -248,12 +237,10 @@ Airspaces::SynchroniseInRange(const Airspaces &master,
   if (CompareAirspaceVectors(contents_master, AsVector()))
     return false;
 
-  for (auto &i : QueryAll())
+  for (auto &i : airspace_tree.GetItems())
     i.ClearClearance();
-  airspace_tree.clear();
 
-  for (const auto &i : contents_master)
-    airspace_tree.insert(i);
+  airspace_tree.Build(std::move(contents_master));
 
   ++serial;
 
@@ -270,13 +257,12 @@ Airspaces::QueryInside(const GeoPoint &loc) const
   const auto flat_location = task_projection.ProjectInteger(loc);
   const FlatBoundingBox box(flat_location, flat_location);
 
-  const auto _begin =
-    airspace_tree.qbegin(bgi::intersects(box) &&
-                         bgi::satisfies([&loc](const Airspace &as){
-                             return as.IsInside(loc);
-                           }));
+  AirspaceTree::Query query(box);
+  query.SetFilter([](const Airspace &as, const void *ctx){
+      return as.IsInside(*(const GeoPoint *)ctx);
+    }, &loc);
 
-  return {_begin, airspace_tree.qend()};
+  return {airspace_tree.qbegin(query), airspace_tree.qend()};
 }
 
 Airspaces::const_iterator_range
@@ -289,11 +275,10 @@ Airspaces::QueryInside(const AircraftState &aircraft) const
   const auto flat_location = task_projection.ProjectInteger(aircraft.location);
   const FlatBoundingBox box(flat_location, flat_location);
 
-  const auto _begin =
-    airspace_tree.qbegin(bgi::intersects(box) &&
-                         bgi::satisfies([&aircraft](const Airspace &as){
-                             return as.IsInside(aircraft);
-                           }));
+  AirspaceTree::Query query(box);
+  query.SetFilter([](const Airspace &as, const void *ctx){
+      return as.IsInside(*(const AircraftState *)ctx);
+    }, &aircraft);
 
-  return {_begin, airspace_tree.qend()};
+  return {airspace_tree.qbegin(query), airspace_tree.qend()};
 }
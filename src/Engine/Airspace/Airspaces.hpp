@@ -37,8 +37,9 @@ class AirspaceIntersectionVisitor;
 class AirspacePredicate;
 
 /**
- * Container for airspaces using kd-tree representation internally for
- * fast geospatial lookups.
+ * Container for airspaces using a packed R-tree internally for fast
+ * geospatial lookups.  The tree is immutable; it is rebuilt in one
+ * pass by Optimise() whenever the set of airspaces changes.
  */
 class Airspaces : public AirspacesInterface {
   AtmosphericPressure qnh;
@@ -97,6 +98,9 @@ public:
    * Re-organise the internal airspace tree after inserting/deleting.
    * Should be called after inserting/deleting airspaces prior to performing
    * any searches, but can be done once after a batch insert/delete.
+   *
+   * This bulk-loads a new tree from scratch, so it should be called
+   * once after a batch, not after each insertion.
    */
   void Optimise();
 
@@ -146,10 +150,11 @@ public:
 
   gcc_pure
   const_iterator_range QueryAll() const {
-    auto predicate = boost::geometry::index::satisfies([](const Airspace &){
-        return true;
-      });
-    return {airspace_tree.qbegin(predicate), airspace_tree.qend()};
+    if (airspace_tree.empty())
+      return {airspace_tree.qend(), airspace_tree.qend()};
+
+    const AirspaceTree::Query query(airspace_tree.GetBounds());
+    return {airspace_tree.qbegin(query), airspace_tree.qend()};
   }
 
   /**
@@ -23,10 +23,8 @@
 #define AIRSPACESINTERFACE_HPP
 
 #include "Airspace.hpp"
-#include "Geo/Flat/BoostFlatBoundingBox.hpp"
-#include "util/SliceAllocator.hxx"
+#include "Geo/Flat/PackedRTree.hpp"
 
-#include <boost/geometry/index/rtree.hpp>
 #include <boost/range/iterator_range_core.hpp>
 
 /**
@@ -35,22 +33,13 @@
  * facade protected class where locking is required.
  */
 class AirspacesInterface {
-  struct AirspaceIndexable {
-    typedef FlatBoundingBox result_type;
-
-    result_type operator()(const Airspace &airspace) const {
-      return airspace;
-    }
-  };
-
 public:
   typedef std::vector<Airspace> AirspaceVector; /**< Vector of airspaces (used internally) */
 
   /**
-   * Type of KD-tree data structure for airspace container
+   * Type of R-tree data structure for airspace container
    */
-  typedef boost::geometry::index::rtree<Airspace, boost::geometry::index::rstar<16>,
-                                        AirspaceIndexable> AirspaceTree;
+  typedef PackedRTree<Airspace> AirspaceTree;
 
   typedef AirspaceTree::const_query_iterator const_iterator;
 
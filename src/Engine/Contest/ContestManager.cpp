@@ -21,6 +21,7 @@
  */
 
 #include "ContestManager.hpp"
+#include "time/Instrument.hpp"
 
 ContestManager::ContestManager(const Contest _contest,
                                const Trace &trace_full,
@@ -119,6 +120,8 @@ RunContest(AbstractContest &_contest,
 bool
 ContestManager::UpdateIdle(bool exhaustive)
 {
+  INSTRUMENT_SCOPE(CONTEST_IDLE);
+
   bool retval = false;
 
   switch (contest) {
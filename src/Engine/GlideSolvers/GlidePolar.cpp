@@ -261,6 +261,7 @@ GlidePolar::IsGlidePossible(const GlideState &task) const
   return true;
 }
 
+#if 0
 /**
  * Finds speed to fly for a given MacCready setting
  * Intended to be used temporarily.
@@ -318,13 +319,31 @@ public:
     return Vopt + m_head_wind;
   }
 };
+#endif
 
 double
 GlidePolar::SpeedToFly(const double stf_sink_rate, const double head_wind) const
 {
   assert(IsValid());
+
+#if 0
+  // this method to be used if polar is not parabolic
   GlidePolarSpeedToFly gp_stf(*this, stf_sink_rate, head_wind, Vmin, Vmax);
   return gp_stf.solve(Vmax);
+#else
+  /* minimise the MacCready-adjusted inverse glide ratio over ground
+     (MSinkRate(V + head_wind) + stf_sink_rate) / V over the ground
+     speed V; with the parabolic polar, this is a.V + const + k/V,
+     which has its minimum at V = sqrt(k/a) */
+  const auto k = head_wind * (head_wind * polar.a + polar.b) + polar.c +
+    mc + stf_sink_rate;
+  const auto v_min = std::max(1., Vmin - head_wind);
+  const auto v_max = Vmax - head_wind;
+  const auto v = k > 0
+    ? Clamp(sqrt(k / polar.a), v_min, v_max)
+    : v_min;
+  return v + head_wind;
+#endif
 }
 
 double
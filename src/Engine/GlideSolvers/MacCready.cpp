@@ -26,9 +26,13 @@
 #include "GlideResult.hpp"
 #include "Math/ZeroFinder.hpp"
 #include "Util/Tolerances.hpp"
+#include "Math/Util.hpp"
+#include "util/Clamp.hpp"
 
 #include <cassert>
 
+#include <math.h>
+
 MacCready::MacCready(const GlideSettings &_settings,
                      const GlidePolar &_glide_polar,
                      const double _cruise_efficiency)
@@ -380,11 +384,80 @@ public:
   }
 };
 
+/**
+ * Calculate the cruise speed which minimises the height loss per
+ * distance over ground S(V)/G(V), with the parabolic polar
+ * S(V) = a.V^2 + b.V + c and the ground speed
+ * G(V) = sqrt((ce.V)^2 - X^2) - H.
+ *
+ * Without cross wind, this has a closed form solution.  With cross
+ * wind, that solution is refined with a few Newton steps on the
+ * derivative S'.G - S.G'.
+ *
+ * @param head_wind the head wind component H (m/s)
+ * @param cross_wind_squared the square of the cross wind component X
+ * @param ce the cruise efficiency
+ *
+ * @return the speed (m/s), or a negative value if there is no solution
+ */
+gcc_pure
+static double
+BestGlideSpeed(const PolarCoefficients &polar, const double head_wind,
+               const double cross_wind_squared, const double ce)
+{
+  const auto s = head_wind * head_wind +
+    ce * (polar.b * head_wind + ce * polar.c) / polar.a;
+  if (s < 0)
+    return -1;
+
+  auto v = (head_wind + sqrt(s)) / ce;
+  if (cross_wind_squared <= 0)
+    return v;
+
+  for (unsigned i = 0; i < 8; ++i) {
+    const auto r2 = Square(ce * v) - cross_wind_squared;
+    if (r2 <= 0)
+      return -1;
+
+    const auto r = sqrt(r2);
+    const auto g = r - head_wind;
+    if (g <= 0)
+      return -1;
+
+    const auto sink = v * (v * polar.a + polar.b) + polar.c;
+    const auto d_sink = 2 * polar.a * v + polar.b;
+    const auto d_g = ce * ce * v / r;
+
+    const auto h = d_sink * g - sink * d_g;
+    const auto d_h = 2 * polar.a * g + sink * ce * ce * cross_wind_squared / (r2 * r);
+    if (d_h <= 0)
+      return -1;
+
+    const auto step = h / d_h;
+    v -= step;
+    if (fabs(step) < 1e-6)
+      return v;
+  }
+
+  return -1;
+}
+
 GlideResult
 MacCready::OptimiseGlide(const GlideState &task, const bool allow_partial) const
 {
   assert(glide_polar.GetMC() <= 0);
 
+  const auto v = BestGlideSpeed(glide_polar.GetRealCoefficients(),
+                                task.head_wind,
+                                Square(task.wind.norm) - Square(task.head_wind),
+                                cruise_efficiency);
+  if (v > 0)
+    /* the height loss per distance has a single minimum, so the
+       best speed within the polar's range is at the nearest end */
+    return SolveGlide(task, Clamp(v, glide_polar.GetVMin(),
+                                  glide_polar.GetVMax()),
+                      allow_partial);
+
   MacCreadyVopt mc_vopt(task, *this,
                        glide_polar.GetVMin(), glide_polar.GetVMax(),
                        allow_partial);
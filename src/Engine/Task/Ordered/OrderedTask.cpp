@@ -174,6 +174,8 @@ OrderedTask::UpdateGeometry()
   // projection can now be determined
   task_projection = TaskProjection(bounds);
 
+  ResetTargetSearch();
+
   // update OZ's for items that depend on next-point geometry
   UpdateObservationZones(task_points, task_projection);
   UpdateObservationZones(optional_start_points, task_projection);
@@ -615,6 +617,14 @@ OrderedTask::CheckTransitionPoint(OrderedTaskPoint &point,
 
 // ADDITIONAL FUNCTIONS
 
+/**
+ * The maximum number of iterations of a target optimisation which
+ * continues from the previous solution.  The targets move slowly, so
+ * this is usually plenty; an unfinished search continues in the next
+ * call.
+ */
+static constexpr unsigned WARM_TARGET_ITERATIONS = 8;
+
 bool
 OrderedTask::UpdateIdle(const AircraftState &state,
                         const GlidePolar &glide_polar)
@@ -624,8 +634,10 @@ OrderedTask::UpdateIdle(const AircraftState &state,
   if (HasStart() && task_behaviour.optimise_targets_range &&
       GetOrderedTaskSettings().aat_min_time > 0) {
 
-    CalcMinTarget(state, glide_polar,
-                  GetOrderedTaskSettings().aat_min_time + task_behaviour.optimise_targets_margin);
+    last_min_target =
+      CalcMinTarget(state, glide_polar,
+                    GetOrderedTaskSettings().aat_min_time + task_behaviour.optimise_targets_margin,
+                    last_min_target);
 
     if (task_behaviour.optimise_targets_bearing &&
         task_points[active_task_point]->GetType() == TaskPointType::AAT) {
@@ -634,7 +646,9 @@ OrderedTask::UpdateIdle(const AircraftState &state,
       TaskOptTarget tot(task_points, active_task_point, state,
                         task_behaviour.glide, glide_polar,
                         *ap, task_projection, taskpoint_start);
-      tot.search(0.5);
+      if (last_opt_target >= 0)
+        tot.SetMaxIterations(WARM_TARGET_ITERATIONS);
+      last_opt_target = tot.search(last_opt_target);
     }
     retval = true;
   }
@@ -891,6 +905,7 @@ OrderedTask::SetActiveTaskPoint(unsigned index)
   task_advance.SetArmed(false);
   active_task_point = index;
   force_full_update = true;
+  ResetTargetSearch();
 }
 
 TaskWaypoint*
@@ -1056,7 +1071,7 @@ OrderedTask::CalcEffectiveMC(const AircraftState &aircraft,
 inline double
 OrderedTask::CalcMinTarget(const AircraftState &aircraft,
                            const GlidePolar &glide_polar,
-                           const double t_target)
+                           const double t_target, const double p_start)
 {
   if (stats.has_targets) {
     // only perform scan if modification is possible
@@ -1065,11 +1080,13 @@ OrderedTask::CalcMinTarget(const AircraftState &aircraft,
     TaskMinTarget bmt(task_points, active_task_point, aircraft,
                       task_behaviour.glide, glide_polar,
                       t_rem, taskpoint_start);
-    auto p = bmt.search(0);
+    if (p_start >= 0)
+      bmt.SetMaxIterations(WARM_TARGET_ITERATIONS);
+    auto p = bmt.search(p_start);
     return p;
   }
 
-  return 0;
+  return -1;
 }
 
 double
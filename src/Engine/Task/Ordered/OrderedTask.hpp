@@ -86,6 +86,13 @@ private:
   TaskDijkstraMin *dijkstra_min;
   TaskDijkstraMax *dijkstra_max;
 
+  /**
+   * Solutions of the previous target optimisations (range parameter
+   * and isoline parameter of the active task point), used as a warm
+   * start for the next ones.  Negative if there is none.
+   */
+  double last_min_target = -1, last_opt_target = -1;
+
   StaticString<64> name;
 
 public:
@@ -452,12 +459,21 @@ private:
    *
    * @param state_now Aircraft state
    * @param t_target Desired time for remainder of task (s)
+   * @param p_start The previous solution, or a negative value to
+   * search the whole range
    *
    * @return Target range parameter (0-1)
    */
   double CalcMinTarget(const AircraftState &state_now,
                        const GlidePolar &glide_polar,
-                       const double t_target);
+                       const double t_target, double p_start);
+
+  /**
+   * Forget the solutions of the previous target optimisations.
+   */
+  void ResetTargetSearch() {
+    last_min_target = last_opt_target = -1;
+  }
 
   /**
    * Sets previous/next taskpoint pointers for task point at specified
@@ -23,6 +23,7 @@
 #include "AATPoint.hpp"
 #include "Geo/Flat/FlatProjection.hpp"
 #include "Geo/Flat/FlatLine.hpp"
+#include "Util/Tolerances.hpp"
 #include "util/Clamp.hpp"
 
 const GeoPoint&
@@ -212,6 +213,41 @@ AATPoint::GetTargetRangeRadial(double oldrange) const
   return RangeAndRadial{ range, radial };
 }
 
+const AATIsolineSegment &
+AATPoint::GetIsolineSegment(const FlatProjection &projection)
+{
+  const auto previous =
+    projection.ProjectFloat(GetPrevious()->GetLocationRemaining());
+  const auto next = projection.ProjectFloat(GetNext()->GetLocationRemaining());
+  const auto target = projection.ProjectFloat(target_location);
+
+  /* the isoline is an ellipse in the flat projection, so the flat
+     double leg distance is constant along it */
+  const auto double_leg_distance =
+    target.Distance(previous) + target.Distance(next);
+
+  const auto tolerance = TOLERANCE_ISOLINE_CACHE * double_leg_distance;
+  if (isoline_cache &&
+      previous.Distance(isoline_cache->previous) <= tolerance &&
+      next.Distance(isoline_cache->next) <= tolerance &&
+      fabs(double_leg_distance - isoline_cache->double_leg_distance) <= tolerance)
+    return isoline_cache->segment;
+
+  isoline_cache.reset();
+  isoline_cache.emplace(IsolineCache{previous, next, double_leg_distance,
+                                     AATIsolineSegment(*this, projection)});
+  return isoline_cache->segment;
+}
+
+void
+AATPoint::UpdateOZ(const FlatProjection &projection)
+{
+  OrderedTaskPoint::UpdateOZ(projection);
+
+  /* the projection or the observation zone may have changed */
+  isoline_cache.reset();
+}
+
 bool
 AATPoint::Equals(const OrderedTaskPoint &other) const
 {
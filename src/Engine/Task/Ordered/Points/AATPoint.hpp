@@ -25,8 +25,12 @@
 #define AATPOINT_HPP
 
 #include "IntermediatePoint.hpp"
+#include "Task/Ordered/AATIsolineSegment.hpp"
+#include "Geo/Flat/FlatPoint.hpp"
 #include "Math/Angle.hpp"
 
+#include <optional>
+
 struct RangeAndRadial {
   /**
    * Thesigned range [-1,1] from near point on perimeter through
@@ -58,6 +62,18 @@ class AATPoint final : public IntermediateTaskPoint {
   /** Whether target can float */
   bool target_locked;
 
+  /**
+   * The isoline segment returned by GetIsolineSegment(), together
+   * with the geometry it was calculated for.
+   */
+  struct IsolineCache {
+    FlatPoint previous, next;
+    double double_leg_distance;
+    AATIsolineSegment segment;
+  };
+
+  std::optional<IsolineCache> isoline_cache;
+
 public:
   /**
    * Constructor.  Initialises to unlocked target, target is
@@ -155,6 +171,15 @@ public:
    */
   bool SetRange(double p, bool force_if_current);
 
+  /**
+   * Obtain the isoline segment through the current target.  The
+   * segment is expensive to calculate, so it is cached and only
+   * recalculated when the previous or next point's location or the
+   * target range have changed significantly, or when the observation
+   * zone has changed.
+   */
+  const AATIsolineSegment &GetIsolineSegment(const FlatProjection &projection);
+
   /**
    * If this TaskPoint has the capability to adjust the
    * target/range, this indicates whether it is locked from
@@ -214,6 +239,7 @@ public:
   }
 
   /* virtual methods from class OrderedTaskPoint */
+  void UpdateOZ(const FlatProjection &projection) override;
   bool Equals(const OrderedTaskPoint &other) const override;
   bool UpdateSampleNear(const AircraftState &state,
                         const FlatProjection &projection) override;
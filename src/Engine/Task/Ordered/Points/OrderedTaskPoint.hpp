@@ -222,7 +222,7 @@ public:
    */
   void ScanBounds(GeoBounds &bounds) const;
 
-  void UpdateOZ(const FlatProjection &projection);
+  virtual void UpdateOZ(const FlatProjection &projection);
 
   /**
    * Update the bounding box in flat projected coordinates
@@ -70,7 +70,7 @@ TaskMinTarget::search(const double tp)
 
   force_current = false;
   /// @todo if search fails, force current
-  const auto p = find_zero(tp);
+  const auto p = find_zero_near(tp, 5 * TOLERANCE_MIN_TARGET);
   if (valid(p)) {
     return p;
   } else {
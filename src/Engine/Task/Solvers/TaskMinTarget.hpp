@@ -66,6 +66,8 @@ public:
                 double _t_remaining,
                 StartPoint *_ts);
 
+  using ZeroFinder::SetMaxIterations;
+
 private:
   virtual double f(double p);
 
@@ -85,7 +87,8 @@ public:
    *
    * Running this adjusts the target values for AAT task points.
    *
-   * @param p Default range (0-1)
+   * @param p Previous solution (0-1) to search near, or a negative
+   * value to search the whole range
    *
    * @return Range value for solution
    */
@@ -41,7 +41,7 @@ TaskOptTarget::TaskOptTarget(const std::vector<OrderedTaskPoint*>& tps,
    aircraft(_aircraft),
    tp_start(_ts),
    tp_current(_tp_current),
-   iso(_tp_current, projection)
+   iso(_tp_current.GetIsolineSegment(projection))
 {
 }
 
@@ -72,7 +72,7 @@ TaskOptTarget::search(const double tp)
   }
   if (iso.IsValid()) {
     tm.target_save();
-    const auto t = find_min(tp);
+    const auto t = find_min_near(tp, 5 * TOLERANCE_OPT_TARGET);
     if (!valid(t)) {
       // invalid, so restore old value
       tm.target_restore();
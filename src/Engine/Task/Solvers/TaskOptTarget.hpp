@@ -51,8 +51,12 @@ class TaskOptTarget final : public ZeroFinder
   StartPoint *tp_start;
   /** Active AATPoint */
   AATPoint &tp_current;
-  /** Isoline for active AATPoint target */
-  AATIsolineSegment iso;
+  /**
+   * Isoline for active AATPoint target.  This is a copy, because
+   * the AATPoint's cached segment is discarded when the target is
+   * moved during the search.
+   */
+  const AATIsolineSegment iso;
 
 public:
   /**
@@ -90,9 +94,10 @@ public:
    *
    * Running this adjusts the target values for the active task point.
    *
-   * @param p Default isoline value (0-1)
+   * @param p Previous solution (0-1) to search near, or a negative
+   * value to search the whole isoline
    *
-   * @return Isoline value for solution
+   * @return Isoline value for solution, or -1 if none was found
    */
   virtual double search(double p);
 
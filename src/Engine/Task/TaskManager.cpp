@@ -26,6 +26,7 @@
 #include "Ordered/Points/AATPoint.hpp"
 #include "Unordered/GotoTask.hpp"
 #include "Unordered/AlternateTask.hpp"
+#include "time/Instrument.hpp"
 
 TaskManager::TaskManager(const TaskBehaviour &_task_behaviour,
                          const Waypoints &wps)
@@ -267,6 +268,8 @@ bool
 TaskManager::Update(const AircraftState &state,
                     const AircraftState &state_last)
 {
+  INSTRUMENT_SCOPE(TASK_UPDATE);
+
   /* always update ordered task so even if we are temporarily in a
      different mode, so the task stats are still updated.  Otherwise,
      the task stats would freeze and sampling etc would not be
@@ -36,4 +36,7 @@
 #define TOLERANCE_MIN_TARGET 0.002
 #define TOLERANCE_OPT_TARGET 0.01
 
+/** relative change of the double leg distance which invalidates a cached isoline */
+#define TOLERANCE_ISOLINE_CACHE 0.0001
+
 #endif
@@ -164,6 +164,39 @@ Waypoints::Append(WaypointPtr wp)
   ++serial;
 }
 
+void
+Waypoints::Append(std::vector<Waypoint> &&_waypoints)
+{
+  if (_waypoints.empty())
+    return;
+
+  const auto block =
+    std::make_shared<std::vector<Waypoint>>(std::move(_waypoints));
+
+  if (waypoint_tree.HaveBounds())
+    /* rebuild the whole tree in the next Optimise() call instead of
+       inserting the new waypoints one by one */
+    ScheduleOptimise();
+  else if (IsEmpty())
+    task_projection.Reset(block->front().location);
+
+  for (auto &w : *block) {
+    w.flags.watched = w.origin == WaypointOrigin::WATCHED;
+
+    task_projection.Scan(w.location);
+    w.id = next_id++;
+
+    waypoint_tree.AddQuick(WaypointPtr(block, &w));
+  }
+
+  /* a separate pass, so the QuadTree leaves get allocated next to
+     each other, which speeds up Optimise() */
+  for (auto &w : *block)
+    name_tree.Add(WaypointPtr(block, &w));
+
+  ++serial;
+}
+
 WaypointPtr
 Waypoints::GetNearest(const GeoPoint &loc, double range) const
 {
@@ -29,6 +29,8 @@
 #include "Waypoint.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 
+#include <vector>
+
 class WaypointVisitor;
 
 /**
@@ -121,6 +123,17 @@ public:
     return ptr;
   }
 
+  /**
+   * Add a batch of waypoints to the internal store.  They are moved
+   * into one contiguous block which is shared by all of them (and
+   * which is freed only after the last of them has been released),
+   * and the spatial tree is rebuilt only once, by the next
+   * Optimise() call, which must be called afterwards.
+   *
+   * @param waypoints Waypoints to add to internal store
+   */
+  void Append(std::vector<Waypoint> &&waypoints);
+
   /**
    * Erase waypoint from the internal store.  Requires Optimise() to
    * be called afterwards
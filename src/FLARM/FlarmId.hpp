@@ -65,6 +65,15 @@ public:
     return value < other.value;
   }
 
+  /**
+   * Calculate a hash value for a hash table.  The upper bits are the
+   * best ones.
+   */
+  constexpr uint32_t Hash() const {
+    /* Fibonacci hashing: ids are often assigned sequentially */
+    return value * 0x9e3779b1u;
+  }
+
   static FlarmId Parse(const char *input, char **endptr_r);
 #ifdef _UNICODE
   static FlarmId Parse(const TCHAR *input, TCHAR **endptr_r);
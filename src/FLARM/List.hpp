@@ -28,15 +28,38 @@ Copyright_License {
 #include "NMEA/Validity.hpp"
 #include "util/TrivialArray.hxx"
 
+#include <algorithm>
 #include <type_traits>
 
+#include <stdint.h>
+
 /**
  * This class keeps track of the traffic objects received from a
- * FLARM.
+ * FLARM (or another traffic source).
+ *
+ * Lookups by #FlarmId go through a small open addressing hash table
+ * which stores indexes into #list; it is rebuilt whenever objects are
+ * removed.  All of this is trivially copyable, because the object
+ * lives in the #NMEAInfo blackboard.
  */
 struct TrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+  /**
+   * The old limit of 25 was exceeded at busy sites with FLARM and
+   * ADS-B traffic.  The list is copied with every #NMEAInfo (about
+   * 21 kB), but the threads share #MoreData snapshots, so that
+   * happens only a few times per GPS update.
+   */
+  static constexpr size_t MAX_COUNT = 200;
+
+private:
+  static constexpr unsigned INDEX_BITS = 9;
+  static constexpr size_t INDEX_SIZE = 1 << INDEX_BITS;
+  static_assert(INDEX_SIZE >= 2 * MAX_COUNT, "Hash table too small");
+
+  static constexpr uint8_t EMPTY = 0xff;
+  static_assert(MAX_COUNT <= EMPTY, "Index type too small");
 
+public:
   /**
    * Time stamp of the latest modification to this object.
    */
@@ -47,13 +70,24 @@ struct TrafficList {
    */
   Validity new_traffic;
 
-  /** Flarm traffic information */
+  /**
+   * Flarm traffic information.  Do not add or remove items directly,
+   * because that would corrupt the index.
+   */
   TrivialArray<FlarmTraffic, MAX_COUNT> list;
 
+private:
+  /**
+   * Maps the hash of a #FlarmId to an index in #list, or #EMPTY.
+   */
+  uint8_t index[INDEX_SIZE];
+
+public:
   void Clear() {
     modified.Clear();
     new_traffic.Clear();
     list.clear();
+    ClearIndex();
   }
 
   bool IsEmpty() const {
@@ -68,7 +102,7 @@ struct TrafficList {
     // Add unique traffic from 'add' list
     for (auto &traffic : add.list) {
       if (FindTraffic(traffic.id) == nullptr) {
-        FlarmTraffic * new_traffic = AllocateTraffic();
+        FlarmTraffic * new_traffic = AllocateTraffic(traffic.id);
         if (new_traffic == nullptr)
           return;
         *new_traffic = traffic;
@@ -80,9 +114,16 @@ struct TrafficList {
     modified.Expire(clock, std::chrono::minutes(5));
     new_traffic.Expire(clock, std::chrono::minutes(1));
 
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
+    bool removed = false;
+    for (unsigned i = list.size(); i-- > 0;) {
+      if (!list[i].Refresh(clock)) {
         list.quick_remove(i);
+        removed = true;
+      }
+    }
+
+    if (removed)
+      RebuildIndex();
   }
 
   unsigned GetActiveTrafficCount() const {
@@ -96,11 +137,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   FlarmTraffic *FindTraffic(FlarmId id) {
-    for (auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = FindIndex(id);
+    return i >= 0 ? &list[i] : nullptr;
   }
 
   /**
@@ -110,11 +148,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   const FlarmTraffic *FindTraffic(FlarmId id) const {
-    for (const auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = FindIndex(id);
+    return i >= 0 ? &list[i] : nullptr;
   }
 
   /**
@@ -146,14 +181,21 @@ struct TrafficList {
   }
 
   /**
-   * Allocates a new FLARM_TRAFFIC object from the array.
+   * Allocates a new FLARM_TRAFFIC object from the array and
+   * initialises it with the specified id, which must not be in the
+   * list already.
    *
    * @return the FLARM_TRAFFIC pointer, NULL if the array is full
    */
-  FlarmTraffic *AllocateTraffic() {
-    return list.full()
-      ? NULL
-      : &list.append();
+  FlarmTraffic *AllocateTraffic(FlarmId id) {
+    if (list.full())
+      return NULL;
+
+    FlarmTraffic &traffic = list.append();
+    traffic.Clear();
+    traffic.id = id;
+    AddToIndex(list.size() - 1);
+    return &traffic;
   }
 
   /**
@@ -197,6 +239,49 @@ struct TrafficList {
   unsigned TrafficIndex(const FlarmTraffic *t) const {
     return t - list.begin();
   }
+
+private:
+  static constexpr unsigned GetBucket(FlarmId id) {
+    return id.Hash() >> (32 - INDEX_BITS);
+  }
+
+  static constexpr unsigned NextBucket(unsigned bucket) {
+    return (bucket + 1) & (INDEX_SIZE - 1);
+  }
+
+  void ClearIndex() {
+    std::fill_n(index, INDEX_SIZE, EMPTY);
+  }
+
+  void AddToIndex(unsigned i) {
+    unsigned bucket = GetBucket(list[i].id);
+    while (index[bucket] != EMPTY)
+      bucket = NextBucket(bucket);
+
+    index[bucket] = i;
+  }
+
+  void RebuildIndex() {
+    ClearIndex();
+
+    for (unsigned i = 0; i < list.size(); ++i)
+      AddToIndex(i);
+  }
+
+  /**
+   * @return the index in #list or -1 if not found
+   */
+  [[gnu::pure]]
+  int FindIndex(FlarmId id) const {
+    for (unsigned bucket = GetBucket(id);; bucket = NextBucket(bucket)) {
+      const unsigned i = index[bucket];
+      if (i == EMPTY)
+        return -1;
+
+      if (list[i].id == id)
+        return i;
+    }
+  }
 };
 
 static_assert(std::is_trivial<TrafficList>::value, "type is not trivial");
@@ -22,6 +22,16 @@ Copyright_License {
 */
 
 #include "FLARM/Traffic.hpp"
+#include "Geo/FAISphere.hpp"
+
+#include <algorithm>
+
+#include <cassert>
+
+/**
+ * Don't extrapolate a target's location more than this [s].
+ */
+static constexpr double MAX_PREDICTION = 5;
 
 static constexpr const TCHAR* acTypes[16] = {
   _T("Unknown"), _T("Glider"), _T("TowPlane"),
@@ -58,3 +68,44 @@ FlarmTraffic::Update(const FlarmTraffic &other)
   stealth = other.stealth;
   type = other.type;
 }
+
+GeoPoint
+FlarmTraffic::GetPredictedLocation(double clock) const
+{
+  assert(location_available);
+
+  /* only dead-reckon with values sent by the device; the ones
+     calculated by FlarmComputer are too noisy */
+  if (!valid || !track_received || !speed_received || speed <= 0)
+    return location;
+
+  /* the time stamps are unsigned; check the order before
+     subtracting */
+  const Validity now(clock);
+  if (!now.Modified(valid))
+    return location;
+
+  const double dt = std::min(now.GetTimeDifference(valid).count(),
+                             MAX_PREDICTION);
+
+  /* move along a circular arc: the chord is shorter than the arc and
+     points to the middle of the heading change */
+  const Angle half_turn = turn_rate_received
+    ? Angle::Degrees(turn_rate * dt / 2)
+    : Angle::Zero();
+  const double arc = speed * dt;
+  const double half = half_turn.Radians();
+  const double chord = fabs(half) > 1e-3
+    ? arc * sin(half) / half
+    : arc;
+
+  /* the distance is small; a local flat projection is good enough */
+  const auto sc = (Angle(track) + half_turn).SinCos();
+  const double east = chord * sc.first, north = chord * sc.second;
+
+  const double east_scale = 1. / location.latitude.cos();
+  return GeoPoint(location.longitude +
+                  FAISphere::EarthDistanceToAngle(east * east_scale),
+                  location.latitude +
+                  FAISphere::EarthDistanceToAngle(north));
+}
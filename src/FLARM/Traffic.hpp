@@ -185,6 +185,19 @@ struct FlarmTraffic {
     return valid;
   }
 
+  /**
+   * Extrapolate the location of this target from its last update to
+   * the specified time, assuming it keeps its speed and turn rate.
+   * The prediction is limited to a few seconds, and it is made only
+   * if the device sent the track and speed (#track_received,
+   * #speed_received); the turn rate is used only if
+   * #turn_rate_received.
+   *
+   * Requires #location_available.
+   */
+  [[gnu::pure]]
+  GeoPoint GetPredictedLocation(double clock) const;
+
   static const TCHAR* GetTypeString(AircraftType type);
 
   void Update(const FlarmTraffic &other);
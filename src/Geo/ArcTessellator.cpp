@@ -0,0 +1,124 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ArcTessellator.hpp"
+#include "WGS84.hpp"
+#include "Math/Util.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+
+/**
+ * Sine and cosine of 1 to 5 degrees.
+ */
+static constexpr std::pair<double, double> step_table[] = {
+  { 0, 1 },
+  { 0.017452406437283513, 0.99984769515639127 },
+  { 0.034899496702500969, 0.99939082701909576 },
+  { 0.052335956242943835, 0.99862953475457383 },
+  { 0.069756473744125302, 0.99756405025982420 },
+  { 0.087155742747658166, 0.99619469809174555 },
+};
+
+static_assert(std::size(step_table) == ArcTessellator::MAX_STEP + 1,
+              "Wrong step table size");
+
+ArcTessellator::ArcTessellator(const GeoPoint &_center,
+                               double radius) noexcept
+  :center(_center)
+{
+  const auto sc = center.latitude.SinCos();
+  sin_latitude = sc.first;
+  cos_latitude = sc.second;
+
+  /* radii of curvature in the meridian and in the prime vertical */
+  constexpr double e2 = WGS84::FLATTENING * (2 - WGS84::FLATTENING);
+  const double w2 = 1 - e2 * Square(sin_latitude);
+  const double n = WGS84::EQUATOR_RADIUS / sqrt(w2);
+  const double m = n * (1 - e2) / w2;
+
+  /* the Gaussian radius of curvature */
+  const double r = sqrt(m * n);
+
+  const double distance = radius / r;
+  sin_distance = sin(distance);
+  cos_distance = cos(distance);
+
+  latitude_scale = r / m;
+  longitude_scale = r / n;
+
+  /* first-order correction for the change of the meridional radius
+     of curvature along the way */
+  latitude_correction = 1.5 * e2 * sin_latitude * cos_latitude / w2;
+}
+
+GeoPoint
+ArcTessellator::Calculate(double sin_bearing,
+                          double cos_bearing) const noexcept
+{
+  const double sin_lat2 = sin_latitude * cos_distance +
+    cos_latitude * sin_distance * cos_bearing;
+  const double lat2 = asin(sin_lat2);
+
+  const double delta_lon = atan2(sin_bearing * sin_distance * cos_latitude,
+                                 cos_distance - sin_latitude * sin_lat2);
+
+  const double lat1 = center.latitude.Radians();
+  const double delta_lat = (lat2 - lat1) * latitude_scale;
+
+  GeoPoint p(center.longitude + Angle::Radians(delta_lon * longitude_scale),
+             Angle::Radians(lat1 + delta_lat * (1 - latitude_correction * delta_lat)));
+  p.Normalize();
+  return p;
+}
+
+void
+ArcTessellator::AppendArc(std::vector<GeoPoint> &points,
+                          Angle start, Angle end, int step) const noexcept
+{
+  assert(step != 0);
+  assert(unsigned(std::abs(step)) <= MAX_STEP);
+
+  const auto &rotation = step_table[std::abs(step)];
+  const double sin_step = step > 0 ? rotation.first : -rotation.first;
+  const double cos_step = rotation.second;
+
+  const double threshold = std::abs(step) * 1.5;
+  const Angle delta = Angle::Degrees(step);
+
+  auto sc = start.SinCos();
+  double sin_bearing = sc.first, cos_bearing = sc.second;
+
+  while ((end - start).AbsoluteDegrees() > threshold) {
+    start += delta;
+
+    /* rotate by one step */
+    const double s = sin_bearing * cos_step + cos_bearing * sin_step;
+    cos_bearing = cos_bearing * cos_step - sin_bearing * sin_step;
+    sin_bearing = s;
+
+    points.push_back(Calculate(sin_bearing, cos_bearing));
+  }
+}
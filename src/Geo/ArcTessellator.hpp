@@ -0,0 +1,101 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_GEO_ARC_TESSELLATOR_HPP
+#define XCSOAR_GEO_ARC_TESSELLATOR_HPP
+
+#include "GeoPoint.hpp"
+#include "util/Compiler.h"
+
+#include <vector>
+
+/**
+ * Calculates points on a circle around a center, e.g. to convert an
+ * arc into a polygon.
+ *
+ * This is much cheaper than calling FindLatitudeLongitude() for each
+ * point: everything which depends only on the center and the radius
+ * is calculated once, and AppendArc() steps the bearing by rotating
+ * its sine and cosine with a precomputed table.  The points are
+ * calculated on the sphere which osculates the WGS84 ellipsoid at the
+ * center, with the offsets scaled to the ellipsoid's radii of
+ * curvature; the error compared with FindLatitudeLongitude() is
+ * below 2 metres at 100 km.
+ */
+class ArcTessellator {
+  GeoPoint center;
+
+  double sin_latitude, cos_latitude;
+
+  /**
+   * Sine and cosine of the radius as an angle on the osculating
+   * sphere.
+   */
+  double sin_distance, cos_distance;
+
+  /**
+   * Factors converting latitude/longitude offsets on the osculating
+   * sphere to the ellipsoid.
+   */
+  double latitude_scale, longitude_scale;
+
+  /**
+   * Accounts for the change of the meridional radius of curvature
+   * with the latitude.
+   */
+  double latitude_correction;
+
+public:
+  /**
+   * The largest step width supported by AppendArc() [degrees].
+   */
+  static constexpr unsigned MAX_STEP = 5;
+
+  ArcTessellator(const GeoPoint &center, double radius) noexcept;
+
+  /**
+   * Calculate the point at the given bearing from the center.
+   */
+  gcc_pure
+  GeoPoint Calculate(double sin_bearing, double cos_bearing) const noexcept;
+
+  gcc_pure
+  GeoPoint Calculate(Angle bearing) const noexcept {
+    const auto sc = bearing.SinCos();
+    return Calculate(sc.first, sc.second);
+  }
+
+  /**
+   * Append the points between the two bearings (both excluded), one
+   * every #step degrees, beginning at #start.  The last step is
+   * omitted if it would end closer than 1.5 steps before #end.
+   *
+   * @param step the step width [degrees], 1 to #MAX_STEP; negative
+   * for counter-clockwise arcs, in which case #end must be smaller
+   * than #start
+   */
+  void AppendArc(std::vector<GeoPoint> &points,
+                 Angle start, Angle end, int step) const noexcept;
+};
+
+#endif
@@ -0,0 +1,472 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_PACKED_RTREE_HPP
+#define XCSOAR_PACKED_RTREE_HPP
+
+#include "FlatBoundingBox.hpp"
+#include "FlatRay.hpp"
+#include "util/Compiler.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+
+/**
+ * An immutable R-tree which is bulk-loaded in one pass and stored in
+ * flat arrays.
+ *
+ * The items are sorted along a Hilbert curve through their box
+ * centers, and then packed bottom-up into nodes of #NODE_SIZE
+ * entries.  Children of a node are contiguous, so no child pointers
+ * are needed: child #i of node #j on level #l is entry
+ * j*NODE_SIZE+i on level l-1.
+ *
+ * The bounding boxes of all levels are kept in four parallel
+ * coordinate arrays ("structure of arrays"), padded to a multiple of
+ * #NODE_SIZE.  Testing all children of a node against the query box
+ * is a fixed-length loop without branches which the compiler can
+ * vectorise.
+ *
+ * The tree cannot be modified after Build(); to change its contents,
+ * call Build() again with the new item list.
+ *
+ * @param T the item type; must be convertible to a const
+ * #FlatBoundingBox reference
+ */
+template<typename T>
+class PackedRTree {
+public:
+  static constexpr unsigned NODE_SIZE = 16;
+
+  /**
+   * The maximum number of levels, including the leaf level.  Enough
+   * for NODE_SIZE^(MAX_LEVELS-1) items.
+   */
+  static constexpr unsigned MAX_LEVELS = 9;
+
+  /**
+   * An optional exact test applied to each item which passed the
+   * bounding box test.
+   */
+  typedef bool (*Filter)(const T &item, const void *ctx);
+
+  struct Query {
+    /**
+     * Only items whose bounding box overlaps this box are returned.
+     */
+    FlatBoundingBox box;
+
+    /**
+     * If true, then nodes and items must also intersect with #ray.
+     */
+    bool use_ray;
+
+    FlatRay ray;
+
+    Filter filter;
+
+    /**
+     * Passed to #filter; must remain valid while the query is being
+     * iterated.
+     */
+    const void *filter_ctx;
+
+    explicit Query(const FlatBoundingBox &_box)
+      :box(_box), use_ray(false),
+       ray(FlatGeoPoint(0, 0), FlatGeoPoint(0, 0)),
+       filter(nullptr), filter_ctx(nullptr) {}
+
+    /**
+     * Construct a query for boxes intersecting the line segment
+     * between the two points.
+     */
+    Query(FlatGeoPoint a, FlatGeoPoint b)
+      :box(a, a), use_ray(true), ray(a, b),
+       filter(nullptr), filter_ctx(nullptr) {
+      box.Expand(b);
+    }
+
+    Query &SetFilter(Filter _filter, const void *_ctx) {
+      filter = _filter;
+      filter_ctx = _ctx;
+      return *this;
+    }
+  };
+
+private:
+  std::vector<T> items;
+
+  /**
+   * Bounding box coordinates of all levels, leaves first.
+   */
+  std::vector<int> min_x, min_y, max_x, max_y;
+
+  /**
+   * Index of the first entry of each level in the coordinate arrays.
+   */
+  std::array<unsigned, MAX_LEVELS> level_begin;
+
+  /**
+   * Number of (unpadded) entries on each level.
+   */
+  std::array<unsigned, MAX_LEVELS> level_size;
+
+  unsigned n_levels = 0;
+
+public:
+  class const_query_iterator {
+    friend class PackedRTree;
+
+    static constexpr unsigned END = ~0u;
+
+    const PackedRTree *tree;
+
+    Query query;
+
+    struct Cursor {
+      /**
+       * Index of the first child on this level.
+       */
+      unsigned base;
+
+      /**
+       * Children which matched the query box and have not yet been
+       * visited.
+       */
+      uint32_t pending;
+    };
+
+    /**
+     * One cursor per level below the root; stack[0] walks the
+     * items.
+     */
+    std::array<Cursor, MAX_LEVELS> stack;
+
+    unsigned level;
+
+    unsigned current = END;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T *pointer;
+    typedef const T &reference;
+
+    /**
+     * Construct an end iterator.
+     */
+    const_query_iterator()
+      :tree(nullptr), query(FlatBoundingBox(FlatGeoPoint(0, 0))) {}
+
+  private:
+    const_query_iterator(const PackedRTree &_tree, const Query &_query)
+      :tree(&_tree), query(_query) {
+      const unsigned root_level = tree->n_levels - 1;
+      const unsigned root = tree->level_begin[root_level];
+      if (!query.box.Overlaps(tree->GetBox(root)) ||
+          (query.use_ray && !tree->GetBox(root).Intersects(query.ray)))
+        return;
+
+      level = root_level - 1;
+      stack[level] = {0, tree->Match(level, 0, query.box)};
+      Next();
+    }
+
+    void Next() {
+      while (true) {
+        Cursor &cursor = stack[level];
+        if (cursor.pending == 0) {
+          if (++level == tree->n_levels - 1) {
+            current = END;
+            return;
+          }
+
+          continue;
+        }
+
+        const unsigned i = cursor.base + __builtin_ctz(cursor.pending);
+        cursor.pending &= cursor.pending - 1;
+
+        if (query.use_ray &&
+            !tree->GetBox(tree->level_begin[level] + i).Intersects(query.ray))
+          continue;
+
+        if (level == 0) {
+          if (query.filter != nullptr &&
+              !query.filter(tree->items[i], query.filter_ctx))
+            continue;
+
+          current = i;
+          return;
+        }
+
+        --level;
+        const unsigned base = i * NODE_SIZE;
+        stack[level] = {base, tree->Match(level, base, query.box)};
+      }
+    }
+
+  public:
+    bool operator==(const const_query_iterator &other) const {
+      return current == other.current;
+    }
+
+    bool operator!=(const const_query_iterator &other) const {
+      return current != other.current;
+    }
+
+    const_query_iterator &operator++() {
+      assert(current != END);
+      Next();
+      return *this;
+    }
+
+    const_query_iterator operator++(int) {
+      const_query_iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    reference operator*() const {
+      assert(current != END);
+      return tree->items[current];
+    }
+
+    pointer operator->() const {
+      assert(current != END);
+      return &tree->items[current];
+    }
+  };
+
+  bool empty() const {
+    return items.empty();
+  }
+
+  std::size_t size() const {
+    return items.size();
+  }
+
+  void clear() {
+    items.clear();
+    min_x.clear();
+    min_y.clear();
+    max_x.clear();
+    max_y.clear();
+    n_levels = 0;
+  }
+
+  /**
+   * Returns all items in tree order.
+   */
+  const std::vector<T> &GetItems() const {
+    return items;
+  }
+
+  /**
+   * Returns the bounding box of all items.  The tree must not be
+   * empty.
+   */
+  gcc_pure
+  FlatBoundingBox GetBounds() const {
+    assert(!empty());
+    return GetBox(level_begin[n_levels - 1]);
+  }
+
+  /**
+   * Replace the contents of this tree with the given items.
+   */
+  void Build(std::vector<T> &&_items);
+
+  const_query_iterator qbegin(const Query &query) const {
+    if (empty())
+      return qend();
+
+    return const_query_iterator(*this, query);
+  }
+
+  const_query_iterator qend() const {
+    return const_query_iterator();
+  }
+
+private:
+  gcc_pure
+  FlatBoundingBox GetBox(unsigned i) const {
+    return FlatBoundingBox(FlatGeoPoint(min_x[i], min_y[i]),
+                           FlatGeoPoint(max_x[i], max_y[i]));
+  }
+
+  void SetBox(unsigned i, const FlatBoundingBox &box) {
+    min_x[i] = box.lower_left.x;
+    min_y[i] = box.lower_left.y;
+    max_x[i] = box.upper_right.x;
+    max_y[i] = box.upper_right.y;
+  }
+
+  /**
+   * Test the #NODE_SIZE entries starting at #base on the given level
+   * against the query box.
+   *
+   * @return a bit mask of matching entries
+   */
+  gcc_pure
+  uint32_t Match(unsigned level, unsigned base,
+                 const FlatBoundingBox &box) const {
+    const unsigned offset = level_begin[level] + base;
+    const int *gcc_restrict x0 = min_x.data() + offset;
+    const int *gcc_restrict y0 = min_y.data() + offset;
+    const int *gcc_restrict x1 = max_x.data() + offset;
+    const int *gcc_restrict y1 = max_y.data() + offset;
+
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < NODE_SIZE; ++i)
+      mask |= uint32_t((x0[i] <= box.upper_right.x) &
+                       (x1[i] >= box.lower_left.x) &
+                       (y0[i] <= box.upper_right.y) &
+                       (y1[i] >= box.lower_left.y)) << i;
+
+    /* mask out the padding */
+    const unsigned n = std::min(level_size[level] - base, NODE_SIZE);
+    if (n < 32)
+      mask &= (uint32_t(1) << n) - 1;
+    return mask;
+  }
+
+  static constexpr unsigned Pad(unsigned n) {
+    return (n + NODE_SIZE - 1) / NODE_SIZE * NODE_SIZE;
+  }
+
+  /**
+   * Calculate the position of a point on a Hilbert curve of order 16.
+   */
+  static constexpr uint32_t HilbertIndex(uint32_t x, uint32_t y) {
+    uint32_t d = 0;
+    for (uint32_t s = 1u << 15; s > 0; s >>= 1) {
+      const uint32_t rx = (x & s) != 0;
+      const uint32_t ry = (y & s) != 0;
+      d += s * s * ((3 * rx) ^ ry);
+
+      if (ry == 0) {
+        if (rx == 1) {
+          x = 0xffff - x;
+          y = 0xffff - y;
+        }
+
+        std::swap(x, y);
+      }
+    }
+
+    return d;
+  }
+};
+
+template<typename T>
+void
+PackedRTree<T>::Build(std::vector<T> &&_items)
+{
+  clear();
+
+  if (_items.empty())
+    return;
+
+  const unsigned n = _items.size();
+
+  /* sort the items along a Hilbert curve */
+
+  FlatBoundingBox bounds = _items.front();
+  for (const T &i : _items)
+    bounds.Merge(i);
+
+  const double scale_x = bounds.GetWidth() > 0
+    ? 0xffff / (double)bounds.GetWidth()
+    : 0;
+  const double scale_y = bounds.GetHeight() > 0
+    ? 0xffff / (double)bounds.GetHeight()
+    : 0;
+
+  std::vector<std::pair<uint32_t, unsigned>> order;
+  order.reserve(n);
+  for (unsigned i = 0; i < n; ++i) {
+    const FlatBoundingBox &box = _items[i];
+    const double cx = ((double)box.lower_left.x + box.upper_right.x) / 2;
+    const double cy = ((double)box.lower_left.y + box.upper_right.y) / 2;
+    order.emplace_back(HilbertIndex(uint32_t((cx - bounds.lower_left.x) * scale_x),
+                                    uint32_t((cy - bounds.lower_left.y) * scale_y)),
+                       i);
+  }
+
+  std::sort(order.begin(), order.end());
+
+  items.reserve(n);
+  for (const auto &i : order)
+    items.push_back(std::move(_items[i.second]));
+
+  _items.clear();
+
+  /* calculate the level sizes */
+
+  unsigned total = 0;
+  for (unsigned size = n;; size = (size + NODE_SIZE - 1) / NODE_SIZE) {
+    assert(n_levels < MAX_LEVELS);
+
+    level_begin[n_levels] = total;
+    level_size[n_levels] = size;
+    ++n_levels;
+    total += Pad(size);
+
+    if (size == 1 && n_levels > 1)
+      break;
+  }
+
+  min_x.assign(total, 0);
+  min_y.assign(total, 0);
+  max_x.assign(total, 0);
+  max_y.assign(total, 0);
+
+  /* fill the leaf boxes and pack the upper levels */
+
+  for (unsigned i = 0; i < n; ++i)
+    SetBox(i, items[i]);
+
+  for (unsigned level = 1; level < n_levels; ++level) {
+    const unsigned child_begin = level_begin[level - 1];
+    const unsigned child_size = level_size[level - 1];
+
+    for (unsigned i = 0; i < level_size[level]; ++i) {
+      const unsigned first = i * NODE_SIZE;
+      const unsigned last = std::min(first + NODE_SIZE, child_size);
+
+      FlatBoundingBox box = GetBox(child_begin + first);
+      for (unsigned j = first + 1; j < last; ++j)
+        box.Merge(GetBox(child_begin + j));
+
+      SetBox(level_begin[level] + i, box);
+    }
+  }
+}
+
+#endif
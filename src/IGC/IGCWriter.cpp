@@ -31,24 +31,23 @@ Copyright_License {
 #include <cassert>
 
 IGCWriter::IGCWriter(Path path)
-  :file(path,
-        /* we use CREATE_VISIBLE here so the user can recover partial
-           IGC files after a crash/battery failure/etc. */
-        FileOutputStream::Mode::CREATE_VISIBLE),
-   buffered(file)
+  :writer(path,
+          /* we use CREATE_VISIBLE here so the user can recover partial
+             IGC files after a crash/battery failure/etc. */
+          FileOutputStream::Mode::CREATE_VISIBLE,
+          &grecord)
 {
   fix.Clear();
 
+  /* the writer thread doesn't use the G record before the first
+     line has been submitted */
   grecord.Initialize();
 }
 
 void
 IGCWriter::CommitLine(char *line)
 {
-  buffered.Write(line);
-  buffered.Write('\n');
-
-  grecord.AppendRecordToBuffer(line);
+  writer.Write(line);
 }
 
 void
@@ -281,6 +280,5 @@ IGCWriter::LogFRecord(const BrokenTime &time, const int *satellite_ids)
 void
 IGCWriter::Sign()
 {
-  grecord.FinalizeBuffer();
-  grecord.WriteTo(buffered);
+  writer.Sign();
 }
@@ -25,9 +25,8 @@ Copyright_License {
 #define XCSOAR_IGC_WRITER_HPP
 
 #include "Logger/GRecord.hpp"
+#include "Logger/LogWriterThread.hpp"
 #include "IGCFix.hpp"
-#include "io/FileOutputStream.hxx"
-#include "io/BufferedOutputStream.hxx"
 
 #include <tchar.h>
 
@@ -37,28 +36,55 @@ struct BrokenDateTime;
 struct NMEAInfo;
 struct GeoPoint;
 
+/**
+ * Writes an IGC file.  The records are formatted by the caller's
+ * thread, but written (and added to the G record) by a
+ * #LogWriterThread, so the caller waits for the storage device only
+ * if it has stalled for so long that the queue is full.
+ */
 class IGCWriter {
   enum {
     MAX_IGC_BUFF = 255,
   };
 
-  FileOutputStream file;
-  BufferedOutputStream buffered;
+  static_assert(MAX_IGC_BUFF <= LogWriterThread::MAX_LINE,
+                "IGC line does not fit into LogWriterThread");
 
+  /**
+   * Owned by the #writer thread while it is running.
+   */
   GRecord grecord;
 
+  LogWriterThread writer;
+
   IGCFix fix;
 
   char buffer[MAX_IGC_BUFF];
 
 public:
   /**
-   * Create a new IGC file.  The caller must check IsOpen().
+   * Create a new IGC file.
+   *
+   * Throws on error.
    */
   explicit IGCWriter(Path path);
 
+  /**
+   * Ask the writer thread to write all records to the file soon.
+   * Does not block.
+   */
   void Flush() {
-    buffered.Flush();
+    writer.Flush();
+  }
+
+  /**
+   * Wait until all records have been written to the file and synced
+   * to the device.
+   *
+   * Throws on error.
+   */
+  void Sync() {
+    writer.Sync();
   }
 
   void Sign();
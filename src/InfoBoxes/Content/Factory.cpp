@@ -1091,6 +1091,14 @@ static constexpr MetaData meta_data[] = {
     UpdateInfoBoxThermalTime,
   },
 
+  // e_Corridor_Clearance
+  {
+    N_("Terrain clearance ahead"),
+    N_("Clr Ahead"),
+    N_("The smallest clearance of the safety glide line above the terrain safety height along the current track, up to 50 km ahead. Negative if the glide line hits the terrain. The comment shows the distance to that point, or to the collision."),
+    UpdateInfoBoxCorridorClearance,
+  },
+
 };
 
 static_assert(ARRAY_SIZE(meta_data) == NUM_TYPES,
@@ -71,6 +71,6 @@ InfoBoxContentMacCready::Update(InfoBoxData &data)
 
   SetVSpeed(data, settings_computer.polar.glide_polar_task.GetMC());
 
-  const CommonStats &common_stats = CommonInterface::Calculated().common_stats;
+  const CommonStats &common_stats = CommonInterface::GetCommonStats();
   data.SetCommentFromSpeed(common_stats.V_block, false);
 }
@@ -33,7 +33,7 @@ void
 UpdateInfoBoxHomeDistance(InfoBoxData &data)
 {
   const NMEAInfo &basic = CommonInterface::Basic();
-  const CommonStats &common_stats = CommonInterface::Calculated().common_stats;
+  const CommonStats &common_stats = CommonInterface::GetCommonStats();
 
   if (!common_stats.vector_home.IsValid()) {
     data.SetInvalid();
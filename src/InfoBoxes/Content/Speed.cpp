@@ -104,7 +104,7 @@ UpdateInfoBoxSpeed(InfoBoxData &data)
 void
 UpdateInfoBoxSpeedMacCready(InfoBoxData &data)
 {
-  const CommonStats &common_stats = CommonInterface::Calculated().common_stats;
+  const CommonStats &common_stats = CommonInterface::GetCommonStats();
   data.SetValueFromSpeed(common_stats.V_block, false);
 }
 
@@ -539,7 +539,7 @@ UpdateInfoBoxTaskAATime(InfoBoxData &data)
 {
   const auto &calculated = CommonInterface::Calculated();
   const TaskStats &task_stats = calculated.ordered_task_stats;
-  const CommonStats &common_stats = calculated.common_stats;
+  const CommonStats &common_stats = CommonInterface::GetCommonStats();
 
   if (!task_stats.has_targets ||
       !task_stats.total.IsAchievable()) {
@@ -556,7 +556,7 @@ UpdateInfoBoxTaskAATimeDelta(InfoBoxData &data)
 {
   const auto &calculated = CommonInterface::Calculated();
   const TaskStats &task_stats = calculated.ordered_task_stats;
-  const CommonStats &common_stats = calculated.common_stats;
+  const CommonStats &common_stats = CommonInterface::GetCommonStats();
 
   if (!task_stats.has_targets ||
       !task_stats.total.IsAchievable()) {
@@ -627,7 +627,7 @@ UpdateInfoBoxTaskAASpeed(InfoBoxData &data)
 {
   const auto &calculated = CommonInterface::Calculated();
   const TaskStats &task_stats = calculated.ordered_task_stats;
-  const CommonStats &common_stats = calculated.common_stats;
+  const CommonStats &common_stats = CommonInterface::GetCommonStats();
 
   if (!task_stats.has_targets || common_stats.aat_speed_target <= 0) {
     data.SetInvalid();
@@ -643,7 +643,7 @@ UpdateInfoBoxTaskAASpeedMax(InfoBoxData &data)
 {
   const auto &calculated = CommonInterface::Calculated();
   const TaskStats &task_stats = calculated.ordered_task_stats;
-  const CommonStats &common_stats = calculated.common_stats;
+  const CommonStats &common_stats = CommonInterface::GetCommonStats();
 
   if (!task_stats.has_targets || common_stats.aat_speed_max <= 0) {
     data.SetInvalid();
@@ -659,7 +659,7 @@ UpdateInfoBoxTaskAASpeedMin(InfoBoxData &data)
 {
   const auto &calculated = CommonInterface::Calculated();
   const TaskStats &task_stats = calculated.ordered_task_stats;
-  const CommonStats &common_stats = calculated.common_stats;
+  const CommonStats &common_stats = CommonInterface::GetCommonStats();
 
   if (!task_stats.has_targets ||
       !task_stats.task_valid || common_stats.aat_speed_min <= 0) {
@@ -676,7 +676,7 @@ UpdateInfoBoxTaskTimeUnderMaxHeight(InfoBoxData &data)
 {
   const auto &calculated = CommonInterface::Calculated();
   const auto &task_stats = calculated.ordered_task_stats;
-  const auto &common_stats = calculated.common_stats;
+  const auto &common_stats = CommonInterface::GetCommonStats();
   const double maxheight = protected_task_manager->GetOrderedTaskSettings().start_constraints.max_height;
 
   if (!task_stats.task_valid || maxheight <= 0
@@ -799,7 +799,7 @@ UpdateInfoBoxStartOpen(InfoBoxData &data)
   const NMEAInfo &basic = CommonInterface::Basic();
   const auto &calculated = CommonInterface::Calculated();
   const TaskStats &task_stats = calculated.ordered_task_stats;
-  const CommonStats &common_stats = CommonInterface::Calculated().common_stats;
+  const CommonStats &common_stats = CommonInterface::GetCommonStats();
   const RoughTimeSpan &open = common_stats.start_open_time_span;
 
   /* reset color that may have been set by a previous call */
@@ -843,7 +843,7 @@ UpdateInfoBoxStartOpenArrival(InfoBoxData &data)
   const TaskStats &task_stats = calculated.ordered_task_stats;
   const GlideResult &current_remaining =
     task_stats.current_leg.solution_remaining;
-  const CommonStats &common_stats = CommonInterface::Calculated().common_stats;
+  const CommonStats &common_stats = CommonInterface::GetCommonStats();
   const RoughTimeSpan &open = common_stats.start_open_time_span;
 
   /* reset color that may have been set by a previous call */
@@ -54,3 +54,18 @@ UpdateInfoBoxTerrainCollision(InfoBoxData &data)
     basic.location.DistanceS(calculated.terrain_warning_location);
   data.SetValueFromDistance(distance);
 }
+
+void
+UpdateInfoBoxCorridorClearance(InfoBoxData &data)
+{
+  const CorridorInfo &corridor = CommonInterface::Calculated().corridor;
+  if (!corridor.available || !corridor.reach_available) {
+    data.SetInvalid();
+    return;
+  }
+
+  data.SetValueFromArrival(corridor.min_clearance);
+  data.SetCommentFromDistance(corridor.terrain_collision
+                              ? corridor.reach_distance
+                              : corridor.min_clearance_distance);
+}
@@ -32,4 +32,7 @@ UpdateInfoBoxTerrainHeight(InfoBoxData &data);
 void
 UpdateInfoBoxTerrainCollision(InfoBoxData &data);
 
+void
+UpdateInfoBoxCorridorClearance(InfoBoxData &data);
+
 #endif
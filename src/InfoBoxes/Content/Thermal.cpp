@@ -61,7 +61,7 @@ UpdateInfoBoxThermal30s(InfoBoxData &data)
 
   // Set Color (red/black)
   data.SetValueColor(2 * CommonInterface::Calculated().average <
-      CommonInterface::Calculated().common_stats.current_risk_mc ? 1 : 0);
+      CommonInterface::GetCommonStats().current_risk_mc ? 1 : 0);
 }
 
 void
@@ -125,7 +125,7 @@ UpdateInfoBoxThermalAvg(InfoBoxData &data)
 
   // Set Color (red/black)
   data.SetValueColor(thermal.lift_rate * 1.5 <
-      CommonInterface::Calculated().common_stats.current_risk_mc ? 1 : 0);
+      CommonInterface::GetCommonStats().current_risk_mc ? 1 : 0);
 }
 
 void
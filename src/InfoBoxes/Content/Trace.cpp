@@ -62,8 +62,8 @@ InfoBoxContentSpark::Paint(Canvas &canvas, const PixelRect &rc,
   TraceHistoryRenderer renderer(look.trace_history, look.vario, look.chart);
   renderer.RenderVario(canvas, GetSparkRect(rc), var, center,
                        CommonInterface::GetComputerSettings().polar.glide_polar_task.GetMC(),
-                       CommonInterface::Calculated().common_stats.vario_scale_positive,
-                       CommonInterface::Calculated().common_stats.vario_scale_negative * (center? 1:0));
+                       CommonInterface::GetCommonStats().vario_scale_positive,
+                       CommonInterface::GetCommonStats().vario_scale_negative * (center? 1:0));
 }
 
 void
@@ -180,6 +180,7 @@ InfoBoxContentThermalBand::OnCustomPaint(Canvas &canvas, const PixelRect &rc)
   ThermalBandRenderer renderer(look.thermal_band, look.chart);
   renderer.DrawThermalBandSpark(CommonInterface::Basic(),
                                 CommonInterface::Calculated(),
+                                CommonInterface::GetCommonStats(),
                                 CommonInterface::GetComputerSettings(),
                                 canvas, rc,
                                 CommonInterface::GetComputerSettings().task);
@@ -196,8 +197,7 @@ InfoBoxContentTaskProgress::OnCustomPaint(Canvas &canvas, const PixelRect &rc)
 {
   const Look &look = UIGlobals::GetLook();
   TaskProgressRenderer renderer(look.map.task);
-  renderer.Draw(CommonInterface::Calculated().
-                common_stats.ordered_summary,
+  renderer.Draw(CommonInterface::GetCommonStats().ordered_summary,
                 canvas, rc,
                 look.info_box.inverse);
 }
@@ -168,6 +168,7 @@ namespace InfoBoxFactory
 
     e_StandbyRadio, /* Standby Radio Frequency */
     e_Thermal_Time, /* Time in Thermal*/
+    e_Corridor_Clearance, /* Terrain clearance of the glide line ahead */
 
     e_NUM_TYPES /* Last item */
   };
@@ -126,6 +126,7 @@ namespace InputEvents
   void eventChecklist(const TCHAR *misc);
   void eventClearAirspaceWarnings(const TCHAR *misc);
   void eventClearStatusMessages(const TCHAR *misc);
+  void eventInstrument(const TCHAR *misc);
   void eventLogger(const TCHAR *misc);
   void eventMacCready(const TCHAR *misc);
   void eventMainMenu(const TCHAR *misc);
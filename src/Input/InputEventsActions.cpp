@@ -273,6 +273,14 @@ InputEvents::eventChecklist(gcc_unused const TCHAR *misc)
   dlgChecklistShowModal();
 }
 
+// Instrument
+// Displays the hot path timers and counters (debugging aid)
+void
+InputEvents::eventInstrument(gcc_unused const TCHAR *misc)
+{
+  dlgInstrumentShowModal();
+}
+
 // Status
 // Displays one of the three status dialogs:
 //    system: display the system status
@@ -98,9 +98,10 @@ InputEvents::eventArmAdvance(const TCHAR *misc)
   }
 
   /* quickly propagate the updated values from the TaskManager to the
-     InterfaceBlackboard, so they are available immediately */
+     InterfaceBlackboard and the map, so they are available
+     immediately */
   task_manager->UpdateCommonStatsTask();
-  CommonInterface::ReadCommonStats(task_manager->GetCommonStats());
+  ActionInterface::SendCommonStats(task_manager->GetCommonStats());
 }
 
 void
@@ -196,10 +197,11 @@ InputEvents::eventAdjustWaypoint(const TCHAR *misc)
 
   {
     /* quickly propagate the updated values from the TaskManager to
-       the InterfaceBlackboard, so they are available immediately */
+       the InterfaceBlackboard and the map, so they are available
+       immediately */
     ProtectedTaskManager::ExclusiveLease tm(*protected_task_manager);
     tm->UpdateCommonStatsTask();
-    CommonInterface::ReadCommonStats(tm->GetCommonStats());
+    ActionInterface::SendCommonStats(tm->GetCommonStats());
   }
 
   trigger_redraw();
@@ -258,9 +260,10 @@ InputEvents::eventAbortTask(const TCHAR *misc)
   }
 
   /* quickly propagate the updated values from the TaskManager to the
-     InterfaceBlackboard, so they are available immediately */
+     InterfaceBlackboard and the map, so they are available
+     immediately */
   task_manager->UpdateCommonStatsTask();
-  CommonInterface::ReadCommonStats(task_manager->GetCommonStats());
+  ActionInterface::SendCommonStats(task_manager->GetCommonStats());
 
   trigger_redraw();
 }
@@ -75,6 +75,16 @@ namespace CommonInterface {
     return Private::blackboard.Calculated();
   }
 
+  /**
+   * @see InterfaceBlackboard::GetCommonStats()
+   */
+  gcc_pure
+  static inline const CommonStats &GetCommonStats() {
+    assert(InMainThread());
+
+    return Private::blackboard.GetCommonStats();
+  }
+
   gcc_const
   static inline const SystemSettings &GetSystemSettings() {
     assert(InMainThread());
@@ -180,16 +190,16 @@ namespace CommonInterface {
     return Private::ui_state;
   }
 
-  static inline void ReadBlackboardBasic(const MoreData &nmea_info) {
+  static inline void ReadBlackboardBasic(MoreDataSnapshot nmea_info) {
     assert(InMainThread());
 
-    Private::blackboard.ReadBlackboardBasic(nmea_info);
+    Private::blackboard.ReadBlackboardBasic(std::move(nmea_info));
   }
 
-  static inline void ReadBlackboardCalculated(const DerivedInfo &derived_info) {
+  static inline void ReadBlackboardCalculated(DerivedInfoSnapshot derived_info) {
     assert(InMainThread());
 
-    Private::blackboard.ReadBlackboardCalculated(derived_info);
+    Private::blackboard.ReadBlackboardCalculated(std::move(derived_info));
   }
 
   static inline void ReadCommonStats(const CommonStats &common_stats) {
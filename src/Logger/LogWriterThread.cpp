@@ -0,0 +1,313 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LogWriterThread.hpp"
+#include "GRecord.hpp"
+#include "system/Path.hpp"
+#include "util/StringUtil.hpp"
+
+#include <stdexcept>
+
+LogWriterThread::LogWriterThread(Path path, FileOutputStream::Mode mode,
+                                 GRecord *_grecord)
+  :Thread("LogWriter"),
+   file(std::make_unique<FileOutputStream>(path, mode)),
+   buffered(*file),
+   grecord(_grecord)
+{
+  Start();
+}
+
+LogWriterThread::LogWriterThread(OutputStream &os, GRecord *_grecord)
+  :Thread("LogWriter"),
+   buffered(os),
+   grecord(_grecord)
+{
+  Start();
+}
+
+LogWriterThread::~LogWriterThread() noexcept
+{
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    stop = true;
+    wake_cond.notify_one();
+  }
+
+  Join();
+}
+
+void
+LogWriterThread::Start()
+{
+  last_sync = std::chrono::steady_clock::now();
+
+  if (!Thread::Start())
+    throw std::runtime_error("Failed to start the log writer thread");
+}
+
+inline LogWriterThread::Record *
+LogWriterThread::BeginPush() noexcept
+{
+  return queue.BeginPush();
+}
+
+inline void
+LogWriterThread::Wake() noexcept
+{
+  /* pairs with the fence in Run(): either the writer thread sees the
+     new record (or flush request) before sleeping, or we see
+     #sleeping and notify it under the lock */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  /* the lock is needed only if the writer thread is about to sleep;
+     it is never held during I/O, so this doesn't block for long */
+  if (sleeping.load(std::memory_order_relaxed)) {
+    const std::lock_guard<Mutex> lock(mutex);
+    wake_cond.notify_one();
+  }
+}
+
+void
+LogWriterThread::Push() noexcept
+{
+  queue.Push();
+  Wake();
+}
+
+LogWriterThread::Record &
+LogWriterThread::WaitPush() noexcept
+{
+  Record *record = BeginPush();
+  if (record == nullptr) {
+    std::unique_lock<Mutex> lock(mutex);
+    wake_cond.notify_one();
+    done_cond.wait(lock, [this, &record]{
+      return (record = BeginPush()) != nullptr;
+    });
+  }
+
+  return *record;
+}
+
+void
+LogWriterThread::Write(const char *line) noexcept
+{
+  Record &record = WaitPush();
+  record.type = Record::Type::LINE;
+  CopyString(record.line, line, sizeof(record.line));
+  Push();
+}
+
+bool
+LogWriterThread::TryWrite(const char *line) noexcept
+{
+  Record *record = BeginPush();
+  if (record == nullptr) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  record->type = Record::Type::LINE;
+  CopyString(record->line, line, sizeof(record->line));
+  Push();
+  return true;
+}
+
+void
+LogWriterThread::Flush() noexcept
+{
+  flush_requested.store(true);
+  Wake();
+}
+
+void
+LogWriterThread::Sign() noexcept
+{
+  WaitPush().type = Record::Type::SIGN;
+  Push();
+}
+
+void
+LogWriterThread::Sync()
+{
+  WaitPush().type = Record::Type::SYNC;
+  const unsigned n = ++sync_requested;
+  Push();
+
+  std::unique_lock<Mutex> lock(mutex);
+  done_cond.wait(lock, [this, n]{ return synced >= n; });
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void
+LogWriterThread::WriteAndSync()
+{
+  buffered.Flush();
+
+  if (file != nullptr)
+    file->Sync();
+
+  flush_pending = false;
+  last_sync = std::chrono::steady_clock::now();
+}
+
+inline void
+LogWriterThread::Handle(const Record &record)
+{
+  switch (record.type) {
+  case Record::Type::LINE:
+    buffered.Write(record.line);
+    buffered.Write('\n');
+
+    if (grecord != nullptr)
+      grecord->AppendRecordToBuffer(record.line);
+    break;
+
+  case Record::Type::SIGN:
+    if (grecord != nullptr) {
+      grecord->FinalizeBuffer();
+      grecord->WriteTo(buffered);
+    }
+    break;
+
+  case Record::Type::SYNC:
+    WriteAndSync();
+    break;
+  }
+}
+
+bool
+LogWriterThread::ProcessQueue()
+{
+  bool progress = false;
+  bool failed;
+
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    failed = error != nullptr;
+  }
+
+  Record *record;
+  while ((record = queue.Front()) != nullptr) {
+    if (!failed) {
+      try {
+        Handle(*record);
+      } catch (...) {
+        /* discard all further records; the error is reported by
+           Sync() */
+        failed = true;
+        const std::lock_guard<Mutex> lock(mutex);
+        error = std::current_exception();
+      }
+    }
+
+    const bool sync = record->type == Record::Type::SYNC;
+    queue.Pop();
+    progress = true;
+
+    if (sync) {
+      const std::lock_guard<Mutex> lock(mutex);
+      ++synced;
+    }
+  }
+
+  if (flush_requested.exchange(false) && !failed) {
+    /* all flush requests of this batch are merged: hand the data to
+       the operating system now, but sync to the device only once per
+       SYNC_INTERVAL */
+    progress = true;
+
+    try {
+      buffered.Flush();
+      flush_pending = true;
+
+      if (std::chrono::steady_clock::now() >= last_sync + SYNC_INTERVAL)
+        WriteAndSync();
+    } catch (...) {
+      const std::lock_guard<Mutex> lock(mutex);
+      error = std::current_exception();
+    }
+  }
+
+  return progress;
+}
+
+void
+LogWriterThread::Run() noexcept
+{
+  std::unique_lock<Mutex> lock(mutex);
+
+  while (true) {
+    bool progress;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      progress = ProcessQueue();
+    }
+
+    if (progress) {
+      /* wake up producers waiting for room or for Sync() */
+      done_cond.notify_all();
+      continue;
+    }
+
+    if (stop)
+      break;
+
+    sleeping.store(true, std::memory_order_relaxed);
+    /* pairs with the fence in Wake() */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (queue.IsEmpty() && !flush_requested.load()) {
+      if (flush_pending && error == nullptr) {
+        /* wake up to sync the file when the interval has passed */
+        const auto deadline = last_sync + SYNC_INTERVAL;
+        wake_cond.wait_for(lock,
+                           deadline - std::chrono::steady_clock::now());
+
+        if (queue.IsEmpty() &&
+            std::chrono::steady_clock::now() >= deadline) {
+          const ScopeUnlock unlock(mutex);
+          try {
+            WriteAndSync();
+          } catch (...) {
+            const std::lock_guard<Mutex> lock2(mutex);
+            error = std::current_exception();
+          }
+        }
+      } else
+        wake_cond.wait(lock);
+    }
+    sleeping.store(false, std::memory_order_relaxed);
+  }
+
+  if (error == nullptr) {
+    const ScopeUnlock unlock(mutex);
+    try {
+      WriteAndSync();
+    } catch (...) {
+    }
+  }
+}
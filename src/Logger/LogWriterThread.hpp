@@ -0,0 +1,267 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LOG_WRITER_THREAD_HPP
+#define XCSOAR_LOG_WRITER_THREAD_HPP
+
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/SPSCQueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+
+#include <stdint.h>
+
+class Path;
+class OutputStream;
+class GRecord;
+
+/**
+ * A thread which writes text lines to a file, so the producer
+ * (e.g. the calculation thread) never waits for the storage device.
+ *
+ * Lines are submitted pre-formatted through a bounded lock-free queue
+ * and may be submitted by one thread at a time only; callers with
+ * more than one producer thread must serialize calls with their own
+ * mutex.
+ *
+ * Back-pressure: submitting a line does not wait for I/O unless the
+ * queue is full because the device has stalled for a long time.  Then
+ * Write() waits for room, because the IGC file must be complete for
+ * its G record to verify; TryWrite() drops and counts the line
+ * instead (see GetDroppedCount()), which is preferable for logs where
+ * a gap is harmless, e.g. the raw NMEA log.
+ *
+ * Crash safety: every flush request writes the buffered data to the
+ * operating system, so it survives a crash of this process; at most
+ * every #SYNC_INTERVAL, the file is additionally synced to the device,
+ * so a power failure loses at most the data of that interval plus
+ * whatever is still in the queue.
+ */
+class LogWriterThread final : Thread {
+public:
+  /**
+   * The maximum length of a line, including the null terminator.
+   */
+  static constexpr std::size_t MAX_LINE = 256;
+
+  /**
+   * The number of lines which can be queued.
+   */
+  static constexpr std::size_t QUEUE_SIZE = 256;
+
+  /**
+   * The minimum interval between two syncs to the device.
+   */
+  static constexpr std::chrono::steady_clock::duration SYNC_INTERVAL =
+    std::chrono::seconds(10);
+
+private:
+  struct Record {
+    enum class Type : uint8_t {
+      LINE,
+
+      /**
+       * Finish the G record and append it.
+       */
+      SIGN,
+
+      /**
+       * Write and sync everything, then notify Sync().
+       */
+      SYNC,
+    } type;
+
+    char line[MAX_LINE];
+  };
+
+  SPSCQueue<Record, QUEUE_SIZE> queue;
+
+  std::unique_ptr<FileOutputStream> file;
+  BufferedOutputStream buffered;
+
+  /**
+   * If not nullptr, then all lines are added to this G record.  It
+   * is accessed only by the writer thread.
+   */
+  GRecord *const grecord;
+
+  /**
+   * Protects #stop, #synced and #error and is used with the
+   * condition variables.  It is never held during I/O.
+   */
+  Mutex mutex;
+
+  /**
+   * The writer thread waits on this for new records.
+   */
+  Cond wake_cond;
+
+  /**
+   * Producers wait on this for room in the queue and for Sync().
+   */
+  Cond done_cond;
+
+  /**
+   * Is the writer thread waiting on #wake_cond?  Producers only
+   * need to lock the mutex to wake it up if this is set.  Both sides
+   * separate their store (this flag or the queue) from the following
+   * load of the other one with a sequentially consistent fence, so
+   * at least one of them observes the other's store.
+   */
+  std::atomic_bool sleeping{false};
+
+  /**
+   * Set by Flush().  This is a flag and not a queued record, so
+   * flush requests are merged and never fail.
+   */
+  std::atomic_bool flush_requested{false};
+
+  bool stop = false;
+
+  /**
+   * The number of SYNC records submitted (producer only) and
+   * completed (protected by #mutex).
+   */
+  unsigned sync_requested = 0, synced = 0;
+
+  std::atomic_uint dropped{0};
+
+  std::exception_ptr error;
+
+  /* writer thread only */
+
+  /**
+   * Has data been flushed to the operating system, but not yet been
+   * synced to the device?
+   */
+  bool flush_pending = false;
+
+  std::chrono::steady_clock::time_point last_sync;
+
+public:
+  /**
+   * Open (or create) the file and start the thread.
+   *
+   * Throws on error.
+   *
+   * @param grecord if not nullptr, then all lines are added to this
+   * G record, which must not be accessed by anybody else until this
+   * object is destructed
+   */
+  LogWriterThread(Path path, FileOutputStream::Mode mode,
+                  GRecord *grecord=nullptr);
+
+  /**
+   * Write to an existing stream which must outlive this object.  The
+   * stream cannot be synced to the device.
+   */
+  explicit LogWriterThread(OutputStream &os, GRecord *grecord=nullptr);
+
+  /**
+   * Write all pending records, sync the file and stop the thread.
+   * Errors are ignored; call Sync() before to catch them.
+   */
+  ~LogWriterThread() noexcept;
+
+  LogWriterThread(const LogWriterThread &) = delete;
+  LogWriterThread &operator=(const LogWriterThread &) = delete;
+
+  /**
+   * Submit one line (without the line terminator).  Waits for room
+   * in the queue if it is full; lines are never dropped.
+   */
+  void Write(const char *line) noexcept;
+
+  /**
+   * Submit one line (without the line terminator).  Never blocks.
+   *
+   * @return false if the queue was full and the line was dropped
+   */
+  bool TryWrite(const char *line) noexcept;
+
+  /**
+   * Ask the thread to write all submitted lines to the file soon.
+   * Never blocks; requests are batched.
+   */
+  void Flush() noexcept;
+
+  /**
+   * Finish the G record and append it to the file.  Waits for room
+   * in the queue.
+   */
+  void Sign() noexcept;
+
+  /**
+   * Wait until all submitted lines have been written to the file and
+   * synced to the device.
+   *
+   * Throws if the thread has failed to write.
+   */
+  void Sync();
+
+  /**
+   * The number of lines which were dropped by TryWrite() because the
+   * queue was full.
+   */
+  unsigned GetDroppedCount() const noexcept {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  void Start();
+
+  Record *BeginPush() noexcept;
+  void Push() noexcept;
+
+  /**
+   * Wake up the writer thread if it is sleeping.
+   */
+  void Wake() noexcept;
+
+  /**
+   * Like BeginPush(), but wait until there is room in the queue.
+   */
+  Record &WaitPush() noexcept;
+
+  /**
+   * Handle all queued records and flush requests.
+   *
+   * @return true if at least one record or request was handled
+   */
+  bool ProcessQueue();
+
+  void Handle(const Record &record);
+  void WriteAndSync();
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
+
+#endif
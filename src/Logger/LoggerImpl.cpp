@@ -93,12 +93,16 @@ LoggerImpl::StopLogger(const NMEAInfo &gps_info)
   if (writer == nullptr)
     return;
 
-  writer->Flush();
-
   if (!simulator)
     writer->Sign();
 
-  writer->Flush();
+  /* this is the only place where the calculation thread waits for
+     the writer thread */
+  try {
+    writer->Sync();
+  } catch (...) {
+    LogError(std::current_exception());
+  }
 
   LogFormat(_T("Logger stopped: %s"), filename.c_str());
 
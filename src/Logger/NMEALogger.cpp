@@ -22,7 +22,7 @@ Copyright_License {
 */
 
 #include "Logger/NMEALogger.hpp"
-#include "io/TextWriter.hpp"
+#include "Logger/LogWriterThread.hpp"
 #include "LocalPath.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "thread/Mutex.hxx"
@@ -31,8 +31,12 @@ Copyright_License {
 
 namespace NMEALogger
 {
+  /**
+   * Serializes the device threads, because #LogWriterThread accepts
+   * only one producer at a time.
+   */
   static Mutex mutex;
-  static TextWriter *writer;
+  static LogWriterThread *writer;
 
   bool enabled = false;
 
@@ -56,13 +60,11 @@ NMEALogger::Start()
   const auto logs_path = MakeLocalPath(_T("logs"));
 
   const auto path = AllocatedPath::Build(logs_path, name);
-  writer = new TextWriter(path, false);
-  if (writer == nullptr)
-    return false;
 
-  if (!writer->IsOpen()) {
-    delete writer;
-    writer = nullptr;
+  try {
+    writer = new LogWriterThread(path,
+                                 FileOutputStream::Mode::CREATE_VISIBLE);
+  } catch (...) {
     return false;
   }
 
@@ -82,6 +84,11 @@ NMEALogger::Log(const char *text)
     return;
 
   std::lock_guard<Mutex> lock(mutex);
-  if (Start())
-    writer->WriteLine(text);
+  if (Start()) {
+    /* this never blocks on I/O; a gap in the NMEA log is preferable
+       to a stalled device thread; the writer thread merges the flush
+       requests */
+    writer->TryWrite(text);
+    writer->Flush();
+  }
 }
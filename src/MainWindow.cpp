@@ -779,6 +779,13 @@ MainWindow::SetUIState(const UIState &ui_state)
   }
 }
 
+void
+MainWindow::SetCommonStats(const CommonStats &common_stats)
+{
+  if (map != nullptr)
+    map->SetCommonStats(common_stats);
+}
+
 GlueMapWindow *
 MainWindow::GetMapIfActive()
 {
@@ -42,6 +42,7 @@ Copyright_License {
 struct ComputerSettings;
 struct MapSettings;
 struct UIState;
+struct CommonStats;
 struct Look;
 class GlueMapWindow;
 class Widget;
@@ -270,6 +271,12 @@ public:
   void SetMapSettings(const MapSettings &settings_map);
   void SetUIState(const UIState &ui_state);
 
+  /**
+   * Pass #CommonStats which are newer than the current calculation
+   * results to the map.
+   */
+  void SetCommonStats(const CommonStats &common_stats);
+
   /**
    * Returns the map even if it is not active.  May return nullptr if
    * there is no map.
@@ -123,6 +123,20 @@ GlueMapWindow::SetUIState(const UIState &new_value)
 #endif
 }
 
+void
+GlueMapWindow::SetCommonStats(const CommonStats &new_value)
+{
+  AssertThreadOrUndefined();
+
+#ifdef ENABLE_OPENGL
+  ReadCommonStats(new_value);
+#else
+  std::lock_guard<Mutex> lock(next_mutex);
+  next_common_stats = new_value;
+  next_common_stats_modified = true;
+#endif
+}
+
 void
 GlueMapWindow::ExchangeBlackboard()
 {
@@ -130,8 +144,8 @@ GlueMapWindow::ExchangeBlackboard()
 
   {
     const std::lock_guard<Mutex> lock(device_blackboard->mutex);
-    ReadBlackboard(device_blackboard->Basic(),
-                   device_blackboard->Calculated());
+    ReadBlackboard(device_blackboard->GetBasicSnapshot(),
+                   device_blackboard->GetCalculatedSnapshot());
   }
 
 #ifndef ENABLE_OPENGL
@@ -140,6 +154,11 @@ GlueMapWindow::ExchangeBlackboard()
     ReadMapSettings(next_settings_map);
     ReadComputerSettings(next_settings_computer);
     ReadUIState(next_ui_state);
+
+    if (next_common_stats_modified) {
+      ReadCommonStats(next_common_stats);
+      next_common_stats_modified = false;
+    }
   }
 #endif
 }
@@ -41,6 +41,8 @@ Copyright_License {
 
 #include <array>
 
+#include <cstdint>
+
 struct Look;
 struct GestureLook;
 class TopographyThread;
@@ -105,6 +107,12 @@ class GlueMapWindow : public MapWindow {
 
   DisplayMode last_display_mode = DisplayMode::NONE;
 
+  /**
+   * The NMEAInfo::latency_stamp of the most recently drawn frame.
+   * Used to record each sample only once.
+   */
+  uint_least64_t last_drawn_stamp = 0;
+
   OffsetHistory offset_history;
 
   /*
@@ -133,6 +141,14 @@ class GlueMapWindow : public MapWindow {
   ComputerSettings next_settings_computer;
 
   UIState next_ui_state;
+
+  /**
+   * The new #CommonStats submitted by SetCommonStats().  Only valid
+   * if #next_common_stats_modified is set.
+   */
+  CommonStats next_common_stats;
+
+  bool next_common_stats_modified = false;
 #endif
 
   ThermalBandRenderer thermal_band_renderer;
@@ -156,6 +172,12 @@ public:
   void SetComputerSettings(const ComputerSettings &new_value);
   void SetUIState(const UIState &new_value);
 
+  /**
+   * Pass #CommonStats which are newer than the current calculation
+   * results, see InterfaceBlackboard::ReadCommonStats().
+   */
+  void SetCommonStats(const CommonStats &new_value);
+
   /**
    * Sets a relative margin at the bottom of the screen where no HUD
    * elements should be drawn.
@@ -203,6 +225,9 @@ protected:
                            const PixelPoint aircraft_pos) override;
   virtual void RenderTrackBearing(Canvas &canvas,
                                   const PixelPoint aircraft_pos) override;
+  void OnRaspLoaded() noexcept override {
+    redraw_notify.SendNotification();
+  }
 
   /* virtual methods from class Window */
   virtual void OnCreate() override;
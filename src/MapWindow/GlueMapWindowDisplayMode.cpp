@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "GlueMapWindow.hpp"
+#include "Prefetch.hpp"
 #include "Terrain/RasterTerrain.hpp"
 #include "Topography/Thread.hpp"
 #include "Terrain/Thread.hpp"
@@ -113,17 +114,25 @@ GlueMapWindow::UpdateScreenBounds()
 {
   visible_projection.UpdateScreenBounds();
 
+  if (!visible_projection.IsValid())
+    return;
+
+  /* while following the aircraft, load terrain and topography ahead
+     of it */
+  const GeoPoint lookahead = IsNearSelf()
+    ? PredictMapLocation(Basic(), Calculated(),
+                         visible_projection.GetScreenWidthMeters() / 2)
+    : GeoPoint::Invalid();
+
   if (topography_thread != nullptr &&
-      visible_projection.IsValid() &&
       CommonInterface::GetMapSettings().topography_enabled)
-    topography_thread->Trigger(visible_projection);
+    topography_thread->Trigger(visible_projection, lookahead);
 
   /* always service terrain even if it's not used by the map, because
      it's used by other calculations, therefore don't check if terrain
      display is enabled */
-  if (terrain_thread != nullptr &&
-      visible_projection.IsValid())
-    terrain_thread->Trigger(visible_projection);
+  if (terrain_thread != nullptr)
+    terrain_thread->Trigger(visible_projection, lookahead);
 }
 
 void
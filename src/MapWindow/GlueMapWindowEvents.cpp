@@ -33,6 +33,8 @@ Copyright_License {
 #include "Pan.hpp"
 #include "util/Clamp.hpp"
 #include "Topography/Thread.hpp"
+#include "time/LatencyTrace.hpp"
+#include "time/Instrument.hpp"
 
 #ifdef USE_X11
 #include "ui/event/Globals.hpp"
@@ -408,12 +410,19 @@ GlueMapWindow::OnPaintBuffer(Canvas &canvas)
   EnterDrawThread();
 #endif
 
+  INSTRUMENT_SCOPE(DRAW_FRAME);
+
   MapWindow::OnPaintBuffer(canvas);
 
   DrawMapScale(canvas, GetClientRect(), render_projection);
   if (IsPanning())
     DrawPanInfo(canvas);
 
+  if (Basic().latency_stamp != last_drawn_stamp) {
+    last_drawn_stamp = Basic().latency_stamp;
+    LatencyTrace::Record(LatencyTrace::Stage::DRAWN, last_drawn_stamp);
+  }
+
 #ifdef ENABLE_OPENGL
   LeaveDrawThread();
 #endif
@@ -184,7 +184,7 @@ GlueMapWindow::DrawFlightMode(Canvas &canvas, const PixelRect &rc) const
   // draw flight mode
   const MaskedIcon *bmp;
 
-  if (Calculated().common_stats.task_type == TaskType::ABORT)
+  if (GetCommonStats().task_type == TaskType::ABORT)
     bmp = &look.abort_mode_icon;
   else if (GetDisplayMode() == DisplayMode::CIRCLING)
     bmp = &look.climb_mode_icon;
@@ -384,21 +384,9 @@ GlueMapWindow::DrawThermalEstimate(Canvas &canvas) const
 void
 GlueMapWindow::RenderTrail(Canvas &canvas, const PixelPoint aircraft_pos)
 {
-  unsigned min_time;
-  switch(GetMapSettings().trail.length) {
-  case TrailSettings::Length::OFF:
+  const int min_time = GetTrailMinTime();
+  if (min_time < 0)
     return;
-  case TrailSettings::Length::LONG:
-    min_time = std::max(0, (int)Basic().time - 3600);
-    break;
-  case TrailSettings::Length::SHORT:
-    min_time = std::max(0, (int)Basic().time - 600);
-    break;
-  case TrailSettings::Length::FULL:
-  default:
-    min_time = 0; // full
-    break;
-  }
 
   DrawTrail(canvas, aircraft_pos, min_time,
             GetMapSettings().trail.wind_drift_enabled && InCirclingMode());
@@ -429,6 +417,7 @@ GlueMapWindow::DrawThermalBand(Canvas &canvas, const PixelRect &rc) const
     ProtectedTaskManager::Lease task_manager(*task);
     renderer.DrawThermalBand(Basic(),
                              Calculated(),
+                             GetCommonStats(),
                              GetComputerSettings(),
                              canvas,
                              tb_rect,
@@ -438,6 +427,7 @@ GlueMapWindow::DrawThermalBand(Canvas &canvas, const PixelRect &rc) const
   } else {
     renderer.DrawThermalBand(Basic(),
                              Calculated(),
+                             GetCommonStats(),
                              GetComputerSettings(),
                              canvas,
                              tb_rect,
@@ -0,0 +1,160 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_MAP_LAYER_TIMER_HPP
+#define XCSOAR_MAP_LAYER_TIMER_HPP
+
+#include <array>
+#include <chrono>
+
+#include <stdint.h>
+
+/**
+ * Accumulates the time spent in each layer of MapWindow::Render().
+ * This is used by benchmark programs; the #MapWindow does not measure
+ * anything unless a #MapLayerTimer has been registered with
+ * MapWindow::SetLayerTimer().  With deferred rendering, the
+ * #MapWindow then flushes the queue at the end of each layer, so each
+ * layer includes the time to rasterise its own pixels.
+ */
+class MapLayerTimer {
+public:
+  enum class Layer : uint8_t {
+    TERRAIN,
+    TOPOGRAPHY,
+    OVERLAYS,
+    AIRSPACE,
+    TASK,
+    WAYPOINTS,
+    TRAIL,
+    LABELS,
+    MISC,
+
+    /**
+     * The number of layers, not a valid value.
+     */
+    COUNT
+  };
+
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+private:
+  std::array<Duration, unsigned(Layer::COUNT)> totals;
+
+  Clock::time_point start;
+
+  Layer current;
+
+  bool running = false;
+
+  unsigned n_frames = 0;
+
+public:
+  MapLayerTimer() noexcept {
+    Reset();
+  }
+
+  void Reset() noexcept {
+    totals.fill(Duration::zero());
+    running = false;
+    n_frames = 0;
+  }
+
+  /**
+   * Stop the clock of the current layer (if any) and start the clock
+   * of the specified one.
+   */
+  void Begin(Layer layer) noexcept {
+    const auto now = Clock::now();
+    if (running)
+      totals[unsigned(current)] += now - start;
+
+    current = layer;
+    start = now;
+    running = true;
+  }
+
+  /**
+   * Stop the clock of the current layer and count the frame.
+   */
+  void Finish() noexcept {
+    if (!running)
+      return;
+
+    totals[unsigned(current)] += Clock::now() - start;
+    running = false;
+    ++n_frames;
+  }
+
+  unsigned GetFrameCount() const noexcept {
+    return n_frames;
+  }
+
+  Duration GetTotal(Layer layer) const noexcept {
+    return totals[unsigned(layer)];
+  }
+
+  Duration GetTotal() const noexcept {
+    Duration total = Duration::zero();
+    for (const auto &i : totals)
+      total += i;
+    return total;
+  }
+
+  static constexpr const char *GetName(Layer layer) noexcept {
+    switch (layer) {
+    case Layer::TERRAIN:
+      return "terrain";
+
+    case Layer::TOPOGRAPHY:
+      return "topography";
+
+    case Layer::OVERLAYS:
+      return "overlays";
+
+    case Layer::AIRSPACE:
+      return "airspace";
+
+    case Layer::TASK:
+      return "task";
+
+    case Layer::WAYPOINTS:
+      return "waypoints";
+
+    case Layer::TRAIL:
+      return "trail";
+
+    case Layer::LABELS:
+      return "labels";
+
+    case Layer::MISC:
+    case Layer::COUNT:
+      break;
+    }
+
+    return "misc";
+  }
+};
+
+#endif
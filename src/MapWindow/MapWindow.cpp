@@ -89,12 +89,13 @@ MapWindow::FlushCaches()
  * @param settings_map Map settings to exchange
  */
 void
-MapWindow::ReadBlackboard(const MoreData &nmea_info,
-                          const DerivedInfo &derived_info,
+MapWindow::ReadBlackboard(MoreDataSnapshot nmea_info,
+                          DerivedInfoSnapshot derived_info,
                           const ComputerSettings &settings_computer,
                           const MapSettings &settings_map)
 {
-  MapWindowBlackboard::ReadBlackboard(nmea_info, derived_info);
+  MapWindowBlackboard::ReadBlackboard(std::move(nmea_info),
+                                      std::move(derived_info));
   ReadComputerSettings(settings_computer);
   ReadMapSettings(settings_map);
 }
@@ -136,8 +137,20 @@ MapWindow::OnPaintBuffer(Canvas &canvas)
   GLCanvasScissor scissor(canvas);
 #endif
 
+#ifdef USE_MEMORY_CANVAS
+  const bool deferred = render_queue.IsParallel();
+  if (deferred)
+    canvas.BeginDeferred(render_queue);
+#endif
+
   // Render the moving map
   Render(canvas, GetClientRect());
+
+#ifdef USE_MEMORY_CANVAS
+  if (deferred)
+    canvas.EndDeferred();
+#endif
+
   draw_sw.Finish();
 
 #ifndef ENABLE_OPENGL
@@ -30,8 +30,12 @@ Copyright_License {
 #ifndef ENABLE_OPENGL
 #include "ui/canvas/BufferCanvas.hpp"
 #endif
+#ifdef USE_MEMORY_CANVAS
+#include "ui/canvas/memory/RenderQueue.hpp"
+#endif
 #include "Renderer/LabelBlock.hpp"
 #include "Screen/StopWatch.hpp"
+#include "LayerTimer.hpp"
 #include "MapWindowBlackboard.hpp"
 #include "Renderer/AirspaceLabelRenderer.hpp"
 #include "Renderer/BackgroundRenderer.hpp"
@@ -50,6 +54,7 @@ class CachedTopographyRenderer;
 class RasterTerrain;
 class RaspStore;
 class RaspRenderer;
+class HotspotDatabase;
 class MapOverlay;
 class Waypoints;
 class Airspaces;
@@ -132,6 +137,12 @@ protected:
    */
   std::unique_ptr<RaspRenderer> rasp_renderer;
 
+  /**
+   * Thermal hotspots found in past flights; drawn together with the
+   * thermal estimate.
+   */
+  std::shared_ptr<const HotspotDatabase> hotspot_database;
+
 #ifdef ENABLE_OPENGL
   std::unique_ptr<MapOverlay> overlay;
 #endif
@@ -176,12 +187,25 @@ protected:
   unsigned scale_buffer = 0;
 #endif
 
+#ifdef USE_MEMORY_CANVAS
+  /**
+   * Records the map geometry in OnPaintBuffer(), to be rasterised by
+   * multiple threads.  Only used if there is more than one CPU core.
+   */
+  RenderQueue render_queue;
+#endif
+
   /**
    * The #StopWatch used to benchmark the DrawThread,
    * i.e. OnPaintBuffer().
    */
   ScreenStopWatch draw_sw;
 
+  /**
+   * If set, then Render() accumulates the time spent in each layer.
+   */
+  MapLayerTimer *layer_timer = nullptr;
+
   friend class DrawThread;
 
 public:
@@ -229,6 +253,10 @@ public:
 
   void SetRasp(const std::shared_ptr<RaspStore> &_rasp_store);
 
+  void SetHotspotDatabase(std::shared_ptr<const HotspotDatabase> _database) {
+    hotspot_database = std::move(_database);
+  }
+
 #ifdef ENABLE_OPENGL
   void SetOverlay(std::unique_ptr<MapOverlay> &&_overlay);
 
@@ -249,12 +277,16 @@ public:
   }
 #endif
 
+  void SetLayerTimer(MapLayerTimer *_layer_timer) {
+    layer_timer = _layer_timer;
+  }
+
   void FlushCaches();
 
   using MapWindowBlackboard::ReadBlackboard;
 
-  void ReadBlackboard(const MoreData &nmea_info,
-                      const DerivedInfo &derived_info,
+  void ReadBlackboard(MoreDataSnapshot nmea_info,
+                      DerivedInfoSnapshot derived_info,
                       const ComputerSettings &settings_computer,
                       const MapSettings &settings_map);
 
@@ -278,6 +310,17 @@ public:
   }
 
 protected:
+  /**
+   * Start accounting the time spent in Render() to the specified
+   * layer (if a #MapLayerTimer is registered).
+   */
+  void BeginLayer(Canvas &canvas, MapLayerTimer::Layer layer);
+
+  /**
+   * Stop the #MapLayerTimer (if any) at the end of Render().
+   */
+  void FinishLayers(Canvas &canvas);
+
   void DrawBestCruiseTrack(Canvas &canvas, PixelPoint aircraft_pos) const;
   void DrawTrackBearing(Canvas &canvas,
                         PixelPoint aircraft_pos, bool circling) const;
@@ -286,6 +329,14 @@ protected:
                            const PixelRect &rc) const;
   void DrawWaypoints(Canvas &canvas);
 
+  /**
+   * Returns the time of the oldest trail point to be drawn according
+   * to the configured #TrailSettings::Length, or -1 if the trail is
+   * disabled.
+   */
+  [[gnu::pure]]
+  int GetTrailMinTime() const noexcept;
+
   void DrawTrail(Canvas &canvas, PixelPoint aircraft_pos,
                  unsigned min_time, bool enable_traildrift = false);
   virtual void RenderTrail(Canvas &canvas, PixelPoint aircraft_pos);
@@ -316,6 +367,13 @@ protected:
    */
   virtual void Render(Canvas &canvas, const PixelRect &rc);
 
+  /**
+   * Called by the RASP loader thread after a map has been decoded in
+   * background.  The default implementation does nothing; the new
+   * map will appear with the next redraw.
+   */
+  virtual void OnRaspLoaded() noexcept {}
+
   unsigned UpdateTopography(unsigned max_update=1024);
 
   /**
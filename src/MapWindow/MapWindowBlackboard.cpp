@@ -37,11 +37,3 @@ MapWindowBlackboard::ReadMapSettings(const MapSettings
   settings_map = settings;
 }
 
-void
-MapWindowBlackboard::ReadBlackboard(const MoreData &nmea_info,
-				    const DerivedInfo &derived_info)
-{
-  gps_info = nmea_info;
-  calculated_info = derived_info;
-}
-
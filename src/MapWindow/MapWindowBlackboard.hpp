@@ -24,7 +24,7 @@ Copyright_License {
 #ifndef MAP_WINDOW_BLACKBOARD_H
 #define MAP_WINDOW_BLACKBOARD_H
 
-#include "Blackboard/BaseBlackboard.hpp"
+#include "Blackboard/SnapshotBlackboard.hpp"
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
 #include "Blackboard/MapSettingsBlackboard.hpp"
 #include "thread/Debug.hpp"
@@ -36,7 +36,7 @@ Copyright_License {
  * 
  */
 class MapWindowBlackboard:
-  public BaseBlackboard,
+  public SnapshotBlackboard,
   public ComputerSettingsBlackboard,
   public MapSettingsBlackboard
 {
@@ -47,14 +47,21 @@ protected:
   const MoreData &Basic() const {
     assert(InDrawThread());
 
-    return BaseBlackboard::Basic();
+    return SnapshotBlackboard::Basic();
   }
 
   gcc_const
   const DerivedInfo &Calculated() const {
     assert(InDrawThread());
 
-    return BaseBlackboard::Calculated();
+    return SnapshotBlackboard::Calculated();
+  }
+
+  gcc_pure
+  const CommonStats &GetCommonStats() const {
+    assert(InDrawThread());
+
+    return SnapshotBlackboard::GetCommonStats();
   }
 
   gcc_const
@@ -78,8 +85,28 @@ protected:
     return ui_state;
   }
 
-  void ReadBlackboard(const MoreData &nmea_info,
-                      const DerivedInfo &derived_info);
+  void ReadBlackboard(MoreDataSnapshot nmea_info,
+                      DerivedInfoSnapshot derived_info) {
+    gps_info = std::move(nmea_info);
+
+    if (derived_info != calculated_info) {
+      calculated_info = std::move(derived_info);
+
+      /* the new snapshot has been calculated from the current task */
+      common_stats_modified = false;
+    }
+  }
+
+  /**
+   * Replace the #CommonStats of the current #DerivedInfo snapshot
+   * until a new snapshot is read, see
+   * InterfaceBlackboard::ReadCommonStats().
+   */
+  void ReadCommonStats(const CommonStats &new_value) {
+    common_stats = new_value;
+    common_stats_modified = true;
+  }
+
   void ReadComputerSettings(const ComputerSettings &settings);
   void ReadMapSettings(const MapSettings &settings);
 
@@ -29,8 +29,8 @@ Copyright_License {
 #include "Topography/CachedTopographyRenderer.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/WaveRenderer.hpp"
-#include "Operation/Operation.hpp"
 #include "Tracking/SkyLines/Data.hpp"
+#include "ui/canvas/Canvas.hpp"
 
 #ifdef HAVE_NOAA
 #include "Weather/NOAAStore.hpp"
@@ -73,15 +73,13 @@ MapWindow::RenderRasp(Canvas &canvas)
 #ifndef ENABLE_OPENGL
     const std::lock_guard<Mutex> lock(mutex);
 #endif
-    rasp_renderer.reset(new RaspRenderer(*rasp_store, state.map));
+    rasp_renderer.reset(new RaspRenderer(*rasp_store, state.map,
+                                         [this](){ OnRaspLoaded(); }));
   }
 
   rasp_renderer->SetTime(state.time);
 
-  {
-    QuietOperationEnvironment operation;
-    rasp_renderer->Update(Calculated().date_time_local, operation);
-  }
+  rasp_renderer->Update(Calculated().date_time_local);
 
   const auto &terrain_settings = GetMapSettings().terrain;
   if (rasp_renderer->Generate(render_projection, terrain_settings))
@@ -181,6 +179,35 @@ MapWindow::RenderGlide(Canvas &canvas)
     DrawGlideThroughTerrain(canvas);
 }
 
+void
+MapWindow::BeginLayer(gcc_unused Canvas &canvas, MapLayerTimer::Layer layer)
+{
+  if (layer_timer == nullptr)
+    return;
+
+#ifdef USE_MEMORY_CANVAS
+  /* rasterise the commands deferred by the previous layer now, or
+     their pixels would be accounted to whichever layer flushes the
+     queue next */
+  canvas.FlushDeferred();
+#endif
+
+  layer_timer->Begin(layer);
+}
+
+void
+MapWindow::FinishLayers(gcc_unused Canvas &canvas)
+{
+  if (layer_timer == nullptr)
+    return;
+
+#ifdef USE_MEMORY_CANVAS
+  canvas.FlushDeferred();
+#endif
+
+  layer_timer->Finish();
+}
+
 void
 MapWindow::Render(Canvas &canvas, const PixelRect &rc)
 {
@@ -211,15 +238,18 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   // Render terrain, groundline and topography
   draw_sw.Mark("RenderTerrain");
+  BeginLayer(canvas, MapLayerTimer::Layer::TERRAIN);
   RenderTerrain(canvas);
 
   draw_sw.Mark("RenderRasp");
   RenderRasp(canvas);
 
   draw_sw.Mark("RenderTopography");
+  BeginLayer(canvas, MapLayerTimer::Layer::TOPOGRAPHY);
   RenderTopography(canvas);
 
   draw_sw.Mark("RenderOverlays");
+  BeginLayer(canvas, MapLayerTimer::Layer::OVERLAYS);
   RenderOverlays(canvas);
 
   draw_sw.Mark("DrawNOAAStations");
@@ -228,28 +258,33 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
   //////////////////////////////////////////////// glide range info
 
   draw_sw.Mark("RenderFinalGlideShading");
+  BeginLayer(canvas, MapLayerTimer::Layer::MISC);
   RenderFinalGlideShading(canvas);
 
   //////////////////////////////////////////////// airspace
 
   // Render airspace
   draw_sw.Mark("RenderAirspace");
+  BeginLayer(canvas, MapLayerTimer::Layer::AIRSPACE);
   RenderAirspace(canvas);
 
   //////////////////////////////////////////////// task
 
   // Render task, waypoints
   draw_sw.Mark("DrawContest");
+  BeginLayer(canvas, MapLayerTimer::Layer::TASK);
   DrawContest(canvas);
 
   draw_sw.Mark("DrawTask");
   DrawTask(canvas);
 
   draw_sw.Mark("DrawWaypoints");
+  BeginLayer(canvas, MapLayerTimer::Layer::WAYPOINTS);
   DrawWaypoints(canvas);
 
   //////////////////////////////////////////////// aircraft level items
   // Render the snail trail
+  BeginLayer(canvas, MapLayerTimer::Layer::TRAIL);
   if (basic.location_available)
     RenderTrail(canvas, aircraft_pos);
 
@@ -261,11 +296,13 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
   //////////////////////////////////////////////// text items
   // Render topography on top of airspace, to keep the text readable
   draw_sw.Mark("RenderTopographyLabels");
+  BeginLayer(canvas, MapLayerTimer::Layer::LABELS);
   RenderTopographyLabels(canvas);
 
   //////////////////////////////////////////////// navigation overlays
   // Render glide through terrain range
   draw_sw.Mark("RenderGlide");
+  BeginLayer(canvas, MapLayerTimer::Layer::MISC);
   RenderGlide(canvas);
 
   draw_sw.Mark("RenderMisc1");
@@ -311,4 +348,6 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
   //////////////////////////////////////////////// important overlays
   // Draw intersections on top of aircraft
   airspace_renderer.DrawIntersections(canvas, render_projection);
+
+  FinishLayers(canvas);
 }
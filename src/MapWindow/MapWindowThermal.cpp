@@ -25,6 +25,8 @@ Copyright_License {
 #include "Look/MapLook.hpp"
 #include "ui/canvas/Icon.hpp"
 #include "Tracking/SkyLines/Data.hpp"
+#include "Thermal/HotspotDatabase.hpp"
+#include "Geo/GeoBounds.hpp"
 
 template<typename T>
 static void
@@ -78,4 +80,20 @@ MapWindow::DrawThermalEstimate(Canvas &canvas) const
         look.thermal_source_icon.Draw(canvas, pt);
     }
   }
+
+  if (hotspot_database != nullptr && basic.time_available &&
+      basic.location_available) {
+    /* show the hotspots which were active at this time of day */
+    const unsigned hour =
+      HotspotDatabase::SolarHour(basic.time,
+                                 basic.location.longitude.Degrees());
+
+    hotspot_database->VisitWithin(render_projection.GetScreenBounds(),
+                                  hour, 1,
+                                  [this, &canvas](const HotspotRecord &r){
+      PixelPoint pt;
+      if (render_projection.GeoToScreenIfVisible(r.GetLocation(), pt))
+        look.thermal_source_icon.Draw(canvas, pt);
+    });
+  }
 }
@@ -67,8 +67,9 @@ MapWindow::DrawFLARMTraffic(Canvas &canvas,
     if (!traffic.location_available)
       continue;
 
-    // Save the location of the FLARM target
-    GeoPoint target_loc = traffic.location;
+    // Extrapolate the location of the FLARM target to the time of
+    // the current fix
+    GeoPoint target_loc = traffic.GetPredictedLocation(Basic().clock);
 
     // Points for the screen coordinates for the icon, name and average climb
     PixelPoint sc, sc_name, sc_av;
@@ -25,6 +25,22 @@ Copyright_License {
 #include "Renderer/TrailRenderer.hpp"
 #include "Computer/GlideComputer.hpp"
 
+int
+MapWindow::GetTrailMinTime() const noexcept
+{
+  switch (GetMapSettings().trail.length) {
+  case TrailSettings::Length::OFF:
+    return -1;
+  case TrailSettings::Length::LONG:
+    return std::max(0, (int)Basic().time - 3600);
+  case TrailSettings::Length::SHORT:
+    return std::max(0, (int)Basic().time - 600);
+  case TrailSettings::Length::FULL:
+  default:
+    return 0; // full
+  }
+}
+
 void
 MapWindow::RenderTrail(Canvas &canvas, const PixelPoint aircraft_pos)
 {
@@ -0,0 +1,73 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Prefetch.hpp"
+#include "NMEA/Info.hpp"
+#include "NMEA/Derived.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <algorithm>
+
+/**
+ * How far into the future shall the prediction look?  This is long
+ * enough to load a few terrain tiles, but short enough to remain
+ * plausible.  [s]
+ */
+static constexpr double LOOKAHEAD_TIME = 120;
+
+/**
+ * Below this ground speed, the caches are fast enough to keep up
+ * without prefetching.  [m/s]
+ */
+static constexpr double MIN_GROUND_SPEED = 10;
+
+GeoPoint
+PredictMapLocation(const NMEAInfo &basic, const DerivedInfo &calculated,
+                   double screen_radius)
+{
+  if (!basic.location_available || !basic.track_available ||
+      !basic.ground_speed_available ||
+      basic.ground_speed < MIN_GROUND_SPEED ||
+      calculated.circling)
+    return GeoPoint::Invalid();
+
+  double distance = std::min(basic.ground_speed * LOOKAHEAD_TIME,
+                             screen_radius);
+  Angle bearing = basic.track;
+
+  const auto &leg = calculated.task_stats.current_leg;
+  if (calculated.task_stats.task_valid &&
+      leg.location_remaining.IsValid() &&
+      leg.vector_remaining.IsValid() &&
+      (leg.vector_remaining.bearing - basic.track).AsDelta().Absolute()
+      < Angle::Degrees(45)) {
+    /* heading towards the active turn point: follow the leg, which
+       is more stable than the track, but don't predict beyond the
+       turn point, because we don't know where the pilot will go
+       from there */
+    bearing = leg.vector_remaining.bearing;
+    distance = std::min(distance, leg.vector_remaining.distance);
+  }
+
+  return GeoVector(distance, bearing).EndPoint(basic.location);
+}
@@ -0,0 +1,49 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_MAP_PREFETCH_HPP
+#define XCSOAR_MAP_PREFETCH_HPP
+
+#include "util/Compiler.h"
+
+struct GeoPoint;
+struct NMEAInfo;
+struct DerivedInfo;
+
+/**
+ * Predict the screen center in the near future, to allow the terrain
+ * and topography caches to load data ahead of the aircraft.  The
+ * prediction follows the track, or the active task leg if the
+ * aircraft is heading roughly towards the active turn point.
+ *
+ * @param screen_radius the radius of the visible area [m]; the
+ * prediction will not be farther away than that
+ * @return the predicted location or GeoPoint::Invalid() if the
+ * aircraft is not moving fast enough or is circling
+ */
+gcc_pure
+GeoPoint
+PredictMapLocation(const NMEAInfo &basic, const DerivedInfo &calculated,
+                   double screen_radius);
+
+#endif
@@ -27,13 +27,11 @@ Copyright_License {
 #include "ui/canvas/Canvas.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Renderer/AirspaceRendererSettings.hpp"
-#include "Geo/SearchPointVector.hpp"
 
 StencilMapCanvas::StencilMapCanvas(Canvas &_buffer, Canvas &_stencil,
                                    const WindowProjection &_proj,
                                    const AirspaceRendererSettings &_settings)
-  :clip(_proj.GetScreenBounds().Scale(1.1)),
-   buffer(_buffer),
+  :buffer(_buffer),
    stencil(_stencil),
    proj(_proj),
    buffer_drawn(false),
@@ -43,8 +41,7 @@ StencilMapCanvas::StencilMapCanvas(Canvas &_buffer, Canvas &_stencil,
 }
 
 StencilMapCanvas::StencilMapCanvas(const StencilMapCanvas &other)
-  :clip(other.clip),
-   buffer(other.buffer),
+  :buffer(other.buffer),
    stencil(other.stencil),
    proj(other.proj),
    buffer_drawn(other.buffer_drawn),
@@ -54,31 +51,12 @@ StencilMapCanvas::StencilMapCanvas(const StencilMapCanvas &other)
 }
 
 void
-StencilMapCanvas::DrawSearchPointVector(const SearchPointVector &points)
+StencilMapCanvas::DrawPolygon(const BulkPixelPoint *points, unsigned size,
+                              PixelPoint offset)
 {
-  size_t size = points.size();
-  if (size < 3)
-    return;
-
-  /* copy all SearchPointVector elements to geo_points */
-  geo_points.GrowDiscard(size * 3);
-  for (unsigned i = 0; i < size; ++i)
-    geo_points[i] = points[i].GetLocation();
-
-  /* clip them */
-  size = clip.ClipPolygon(geo_points.begin(), geo_points.begin(), size);
-  if (size < 3)
-    /* it's completely outside the screen */
-    return;
-
-  /* draw it all */
-  BulkPixelPoint screen[size];
-  for (unsigned i = 0; i < size; ++i)
-    screen[i] = proj.GeoToScreen(geo_points[i]);
-
-  buffer.DrawPolygon(&screen[0], size);
+  buffer.DrawPolygon(points, size, offset);
   if (use_stencil)
-    stencil.DrawPolygon(&screen[0], size);
+    stencil.DrawPolygon(points, size, offset);
 }
 
 void
@@ -26,28 +26,19 @@ Copyright_License {
 
 #ifndef ENABLE_OPENGL
 
-#include "Geo/GeoClip.hpp"
-#include "util/AllocatedArray.hxx"
+#include "ui/dim/BulkPoint.hpp"
 
 struct PixelPoint;
 class Canvas;
 class Projection;
 class WindowProjection;
 struct AirspaceRendererSettings;
-class SearchPointVector;
 
 /**
  * Utility class to draw multilayer items on a canvas with stencil masking
  */
 class StencilMapCanvas
 {
-  const GeoClip clip;
-
-  /**
-   * A variable-length buffer for clipped GeoPoints.
-   */
-  AllocatedArray<GeoPoint> geo_points;
-
 public:
   Canvas &buffer;
   Canvas &stencil;
@@ -65,7 +56,14 @@ public:
 
   StencilMapCanvas(const StencilMapCanvas &other);
 
-  void DrawSearchPointVector(const SearchPointVector &points);
+  /**
+   * Draw a polygon which has already been projected to screen
+   * coordinates.
+   *
+   * @param offset is added to all points
+   */
+  void DrawPolygon(const BulkPixelPoint *points, unsigned size,
+                   PixelPoint offset);
 
   void DrawCircle(const PixelPoint &center, unsigned radius);
 
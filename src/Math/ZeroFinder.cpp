@@ -21,6 +21,7 @@
  */
 #include "ZeroFinder.hpp"
 
+#include <algorithm>
 #include <limits>
 
 #include <math.h>
@@ -138,32 +139,72 @@ ZeroFinder::find_zero(const double xstart)
   zero_total++;
 #endif
   if ((xmin<=xstart) || (xstart<=xmax) ||
-      (f(xstart)> sqrt_epsilon))
-    return find_zero_actual(xstart);
+      (f(xstart)> sqrt_epsilon)) {
+    const auto fa = f(xmin);
+    const auto fb = f(xmax);
+    return find_zero_actual(xmin, fa, xmax, fb, true);
+  }
 #ifdef INSTRUMENT_ZERO
   zero_skipped++;
 #endif
   return xstart;
 }
 
-inline double
-ZeroFinder::find_zero_actual(const double xstart)
+static constexpr bool
+SameSign(double a, double b)
+{
+  return (a > 0 && b > 0) || (a < 0 && b < 0);
+}
+
+double
+ZeroFinder::find_zero_near(const double xstart, double step)
 {
-  double a, b, c; // Abscissae, descr. see above
-  double fa; // f(a)
-  double fb; // f(b)
-  double fc; // f(c)
+  assert(step > 0);
+
+  if (!(xstart >= xmin && xstart <= xmax))
+    return find_zero(xstart);
 
-  bool b_best = true; // b is best and last called
+#ifdef INSTRUMENT_ZERO
+  zero_total++;
+#endif
 
-  c = a = xmin;  
-  fc = fa = f(a);  
+  double a = std::max(xstart - step, xmin);
+  double b = std::min(xstart + step, xmax);
+  double fa = f(a);
+  double fb = f(b);
+  bool b_last = true;
 
-  b = xmax;  
-  fb = f(b);
+  // widen the bracket until it contains a sign change
+  while (SameSign(fa, fb) && (a > xmin || b < xmax)) {
+    step *= 4;
+
+    if (a > xmin) {
+      a = std::max(xstart - step, xmin);
+      fa = f(a);
+      b_last = false;
+    }
+
+    if (b < xmax) {
+      b = std::min(xstart + step, xmax);
+      fb = f(b);
+      b_last = true;
+    }
+  }
+
+  return find_zero_actual(a, fa, b, fb, b_last);
+}
+
+inline double
+ZeroFinder::find_zero_actual(double a, double fa, double b, double fb,
+                             const bool b_last)
+{
+  double c = a; // Abscissae, descr. see above
+  double fc = fa; // f(c)
+
+  bool b_best = b_last; // b is best and last called
 
   // Main iteration loop
-  for (;;) {
+  for (unsigned iteration = 0;; ++iteration) {
     // Distance from the last but one to the last approximation
     auto prev_step = b - a;
    
@@ -178,8 +219,6 @@ ZeroFinder::find_zero_actual(const double xstart)
       fc = fa;
 
       b_best = false;
-    } else {
-      b_best = true;
     }
 
     // Actual tolerance
@@ -188,7 +227,8 @@ ZeroFinder::find_zero_actual(const double xstart)
     // Step at this iteration
     auto new_step = (c - b) / 2;
 
-    if (fabs(new_step) <= tol_act || fabs(fb) < sqrt_epsilon) {
+    if (fabs(new_step) <= tol_act || fabs(fb) < sqrt_epsilon ||
+        iteration >= max_iterations) {
       if (!b_best)
         // call once more
         f(b);
@@ -248,6 +288,7 @@ ZeroFinder::find_zero_actual(const double xstart)
     // Do step to a new approxim.
     b += new_step;
     fb = f(b);
+    b_best = true;
 
     // Adjust c for it to have a sign opposite to that of b
     if ((fb > 0 && fc > 0) || (fb < 0 && fc < 0)) {
@@ -319,22 +360,54 @@ ZeroFinder::find_min(const double xstart)
   zero_total++;
 #endif
   if (!solution_within_tolerance(xstart, tolerance_actual_min(xstart)))
-    return find_min_actual(xstart);
+    return find_min_actual(xmin, xmax);
 #ifdef INSTRUMENT_ZERO
   zero_skipped++;
 #endif
   return xstart;
 }
 
+double
+ZeroFinder::find_min_near(const double xstart, const double step)
+{
+  assert(step > 0);
+
+  if (!(xstart >= xmin && xstart <= xmax))
+    return find_min(xstart);
+
+#ifdef INSTRUMENT_ZERO
+  zero_total++;
+#endif
+
+  const auto tol_act = tolerance_actual_min(xstart);
+  if (solution_within_tolerance(xstart, tol_act)) {
+#ifdef INSTRUMENT_ZERO
+    zero_skipped++;
+#endif
+    return xstart;
+  }
+
+  const auto a = std::max(xstart - step, xmin);
+  const auto b = std::min(xstart + step, xmax);
+  const auto x = find_min_actual(a, b);
+
+  /* if the minimum is at an edge of the bracket which is not an edge
+     of the range, it may be outside the bracket: search again */
+  const auto edge_tolerance = 3 * tolerance_actual_min(x);
+  if ((a > xmin && x - a <= edge_tolerance) ||
+      (b < xmax && b - x <= edge_tolerance))
+    return find_min_actual(xmin, xmax);
+
+  return x;
+}
+
 inline double
-ZeroFinder::find_min_actual(const double xstart)
+ZeroFinder::find_min_actual(double a, double b)
 {
   double x, v, w; // Abscissae, descr. see above
   double fx; // f(x)
   double fv; // f(v)
   double fw; // f(w)
-  double a = xmin;
-  double b = xmax;
   bool x_best = true;
 
   assert(tolerance > 0 && b > a);
@@ -344,7 +417,7 @@ ZeroFinder::find_min_actual(const double xstart)
   fx = fw = fv = f(v);
 
   // Main iteration loop
-  for (;;) {
+  for (unsigned iteration = 0;; ++iteration) {
     // Range over which the minimum is seeked for
     const auto range = b - a;
     const auto middle_range = (a + b) / 2;
@@ -353,7 +426,8 @@ ZeroFinder::find_min_actual(const double xstart)
     const auto tol_act = tolerance_actual_min(x);
     const auto double_tol_act = 2 * tol_act;
 
-    if (fabs(x-middle_range) + range / 2 <= double_tol_act) {
+    if (fabs(x-middle_range) + range / 2 <= double_tol_act ||
+        iteration >= max_iterations) {
       if (!x_best)
         // call once more
         f(x);
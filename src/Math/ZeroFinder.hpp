@@ -26,6 +26,7 @@
 #include "util/Compiler.h"
 
 #include <cassert>
+#include <climits>
 
 /**
  * Zero finding and minimisation search algorithm
@@ -42,6 +43,12 @@ protected:
   /** search tolerance in x */
   const double tolerance;
 
+  /**
+   * Maximum number of iterations of one search; when exceeded, the
+   * best approximation found so far is returned.
+   */
+  unsigned max_iterations = UINT_MAX;
+
 public:
   /**
    * Constructor of zero finder search algorithm
@@ -65,6 +72,15 @@ public:
    */
   virtual double f(const double x) = 0;
 
+  /**
+   * Limit the number of iterations of each search.  This bounds the
+   * cost of a search which is repeated periodically with a warm
+   * start: an unfinished search continues in the next period.
+   */
+  void SetMaxIterations(unsigned _max_iterations) {
+    max_iterations = _max_iterations;
+  }
+
   /**
    * Find closest value of x that produces f(x)=0
    * Method used is a variant of a bisector search.
@@ -89,12 +105,49 @@ public:
   gcc_pure
   double find_min(const double xstart);
 
+  /**
+   * Like find_zero(), but first looks for a sign change of f in a
+   * small bracket around xstart, which is widened until it contains
+   * the solution or covers the whole range.  This is much cheaper
+   * than find_zero() if xstart is the solution of a previous,
+   * similar search.
+   *
+   * @param xstart Initial guess of x, e.g. the previous solution
+   * @param step Initial half width of the bracket
+   *
+   * @return x value of best solution
+   */
+  gcc_pure
+  double find_zero_near(double xstart, double step);
+
+  /**
+   * Like find_min(), but searches a small bracket around xstart
+   * first, and only searches the whole range if the minimum is not
+   * inside that bracket.
+   *
+   * @param xstart Initial guess of x, e.g. the previous solution
+   * @param step Half width of the bracket
+   *
+   * @return x value of best solution
+   */
+  gcc_pure
+  double find_min_near(double xstart, double step);
+
 private:
+  /**
+   * Search for a zero in [a,b]
+   *
+   * @param b_last true if f(b) was the most recent call of f()
+   */
   gcc_pure
-  double find_zero_actual(const double xstart);
+  double find_zero_actual(double a, double fa, double b, double fb,
+                          bool b_last);
 
+  /**
+   * Search for a minimum in [a,b]
+   */
   gcc_pure
-  double find_min_actual(const double xstart);
+  double find_min_actual(double a, double b);
 
   /**
    * Tolerance in f of minimisation routine at x
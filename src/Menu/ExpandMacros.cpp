@@ -50,11 +50,11 @@ static const TCHAR *
 ExpandTaskMacros(const TCHAR *name,
                  bool &invalid,
                  const DerivedInfo &calculated,
+                 const CommonStats &common_stats,
                  const ComputerSettings &settings_computer)
 {
   const TaskStats &task_stats = calculated.task_stats;
   const TaskStats &ordered_task_stats = calculated.ordered_task_stats;
-  const CommonStats &common_stats = calculated.common_stats;
 
   if (StringIsEqual(name, _T("CheckTaskResumed"))) {
     // TODO code: check, does this need to be set with temporary task?
@@ -243,6 +243,12 @@ Calculated()
   return CommonInterface::Calculated();
 }
 
+static const CommonStats &
+GetCommonStats()
+{
+  return CommonInterface::GetCommonStats();
+}
+
 static const ComputerSettings &
 GetComputerSettings()
 {
@@ -270,7 +276,8 @@ LookupMacro(const TCHAR *name, bool &invalid)
   }
 
   const TCHAR *value = ExpandTaskMacros(name, invalid,
-                                        Calculated(), GetComputerSettings());
+                                        Calculated(), GetCommonStats(),
+                                        GetComputerSettings());
   if (value != nullptr)
     return value;
 
@@ -28,11 +28,13 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "Audio/VarioGlue.hpp"
 #include "Device/MultipleDevices.hpp"
+#include "time/LatencyTrace.hpp"
 
 MergeThread::MergeThread(DeviceBlackboard &_device_blackboard)
   :WorkerThread("MergeThread", 50, 20, 10),
    device_blackboard(_device_blackboard)
 {
+  SetAdaptive(true);
   last_fix.Reset();
   last_any.Reset();
 }
@@ -60,6 +62,7 @@ void
 MergeThread::Tick() noexcept
 {
   bool gps_updated, calculated_updated;
+  uint_least64_t latency_stamp = 0;
 
 #ifdef HAVE_PCM_PLAYER
   bool vario_available;
@@ -91,6 +94,9 @@ MergeThread::Tick() noexcept
     vario = vario_available ? basic.brutto_vario : 0;
 #endif
 
+    if (basic.latency_stamp != last_any.latency_stamp)
+      latency_stamp = basic.latency_stamp;
+
     /* update last_any in every iteration */
     last_any = basic;
 
@@ -101,10 +107,13 @@ MergeThread::Tick() noexcept
       last_fix = basic;
   }
 
+  LatencyTrace::Record(LatencyTrace::Stage::MERGED, latency_stamp);
+
 #ifdef HAVE_PCM_PLAYER
-  if (vario_available)
+  if (vario_available) {
     AudioVarioGlue::SetValue(vario);
-  else
+    LatencyTrace::Record(LatencyTrace::Stage::AUDIO, latency_stamp);
+  } else
     AudioVarioGlue::NoValue();
 #endif
 
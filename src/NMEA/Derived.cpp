@@ -55,6 +55,8 @@ AirspaceWarningsInfo::Clear()
 void
 DerivedInfo::Reset()
 {
+  latency_stamp = 0;
+
   date_time_local = BrokenDateTime::Invalid();
 
   VarioInfo::Clear();
@@ -96,6 +98,8 @@ DerivedInfo::Reset()
   airspace_warnings.Clear();
 
   planned_route.clear();
+
+  corridor.Clear();
 }
 
 void
@@ -111,6 +115,7 @@ DerivedInfo::Expire(double Time)
   estimated_wind_available.Expire(Time, std::chrono::hours(1));
 
   head_wind_available.Expire(Time, std::chrono::seconds(3));
+  corridor.available.Expire(Time, std::chrono::seconds(10));
 
   auto_mac_cready_available.Expire(Time, std::chrono::hours(1));
   sun_data_available.Expire(Time, std::chrono::hours(1));
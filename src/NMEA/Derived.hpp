@@ -45,8 +45,11 @@ Copyright_License {
 #include "Atmosphere/Pressure.hpp"
 #include "Engine/Route/Route.hpp"
 #include "Computer/WaveResult.hpp"
+#include "Computer/CorridorInfo.hpp"
 #include "util/TypeTraits.hpp"
 
+#include <cstdint>
+
 /** Derived terrain altitude information, including glide range */
 struct TerrainInfo
 {
@@ -142,6 +145,12 @@ struct DerivedInfo:
   public TerrainInfo,
   public TeamInfo
 {
+  /**
+   * The NMEAInfo::latency_stamp of the data these values were
+   * calculated from.
+   */
+  uint_least64_t latency_stamp;
+
   /**
    * GPS date and time (local).
    *
@@ -249,6 +258,9 @@ struct DerivedInfo:
   /** Route plan for current leg avoiding airspace */
   StaticRoute planned_route;
 
+  /** Look-ahead terrain/airspace profile along the track */
+  CorridorInfo corridor;
+
   /**
    * Thermal value of next leg that is equivalent (gives the same average
    * speed) to the current MacCready setting. A negative value should be
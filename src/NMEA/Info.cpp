@@ -117,6 +117,8 @@ NMEAInfo::Reset()
 {
   UpdateClock();
 
+  latency_stamp = 0;
+
   alive.Clear();
 
   gps.Reset();
@@ -253,6 +255,9 @@ NMEAInfo::Complement(const NMEAInfo &add)
        useful information */
     return;
 
+  if (add.latency_stamp > latency_stamp)
+    latency_stamp = add.latency_stamp;
+
   if (!alive) {
     gps = add.gps;
   }
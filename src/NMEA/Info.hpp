@@ -44,6 +44,8 @@ Copyright_License {
 
 #include <type_traits>
 
+#include <cstdint>
+
 /**
  * A struct that holds all the parsed data read from the connected devices
  */
@@ -56,6 +58,12 @@ struct NMEAInfo {
    */
   double clock;
 
+  /**
+   * The LatencyTrace::Stamp of the most recent input which was
+   * parsed into this object, or zero if latency tracing is disabled.
+   */
+  uint_least64_t latency_stamp;
+
   /**
    * Is the device alive?  This attribute gets updated each time a
    * NMEA line was successfully parsed.
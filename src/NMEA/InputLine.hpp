@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_NMEA_INPUT_LINE_HPP
 
 #include "io/CSVLine.hpp"
+#include "SentenceId.hpp"
 
 /**
  * A helper class which can dissect a NMEA input line.
@@ -32,6 +33,14 @@ Copyright_License {
 class NMEAInputLine: public CSVLine {
 public:
   NMEAInputLine(const char* line);
+
+  /**
+   * Read the next column as a sentence type.
+   */
+  NMEASentenceId ReadSentenceId() {
+    const char *src = data;
+    return MakeNMEASentenceId(src, Skip());
+  }
 };
 
 #endif
@@ -0,0 +1,89 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_NMEA_SENTENCE_ID_HPP
+#define XCSOAR_NMEA_SENTENCE_ID_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * A NMEA sentence type (the first field of a sentence, e.g.
+ * "$GPRMC") packed into an integer.  Up to 8 characters fit, which
+ * covers all sentence types, so the mapping is collision-free: it
+ * is a perfect hash which needs no table.  Parsers read it with
+ * NMEAInputLine::ReadSentenceId() and dispatch with a "switch"
+ * statement, which the compiler turns into a jump table or a binary
+ * search instead of a chain of string comparisons.
+ *
+ * Types which are longer than 8 characters map to 0, which never
+ * matches a registered type.
+ */
+typedef uint_least64_t NMEASentenceId;
+
+static constexpr NMEASentenceId
+MakeNMEASentenceId(const char *s, std::size_t length) noexcept
+{
+  if (length > 8)
+    return 0;
+
+  NMEASentenceId id = 0;
+  for (std::size_t i = 0; i < length; ++i)
+    id |= NMEASentenceId((unsigned char)s[i]) << (8 * i);
+  return id;
+}
+
+/**
+ * Calculate the id of a string literal at compile time, for use in
+ * "case" labels.
+ */
+template<std::size_t N>
+static constexpr NMEASentenceId
+MakeNMEASentenceId(const char (&s)[N]) noexcept
+{
+  static_assert(N - 1 <= 8, "NMEA sentence type too long");
+  return MakeNMEASentenceId(s, N - 1);
+}
+
+/**
+ * Returns the character at the given position of the sentence type.
+ */
+static constexpr char
+GetNMEASentenceIdChar(NMEASentenceId id, unsigned i) noexcept
+{
+  return char(id >> (8 * i));
+}
+
+/**
+ * Replace the talker id (the two characters after the "$") with
+ * "--", to match standard sentences from any talker: the result can
+ * be compared with MakeNMEASentenceId("$--RMC").
+ */
+static constexpr NMEASentenceId
+StripNMEATalker(NMEASentenceId id) noexcept
+{
+  return (id & ~NMEASentenceId(0xffff00)) |
+    (NMEASentenceId('-') << 8) | (NMEASentenceId('-') << 16);
+}
+
+#endif
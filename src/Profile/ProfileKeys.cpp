@@ -273,6 +273,7 @@ const char VarioZeroFrequency[] = "VarioZeroFrequency";
 const char VarioMaxFrequency[] = "VarioMaxFrequency";
 const char VarioMinPeriod[] = "VarioMinPeriod";
 const char VarioMaxPeriod[] = "VarioMaxPeriod";
+const char VarioSmoothFrequency[] = "VarioSmoothFrequency";
 const char VarioDeadBandEnabled[] = "VarioDeadBandEnabled";
 const char VarioDeadBandMin[] = "VarioDeadBandMin";
 const char VarioDeadBandMax[] = "VarioDeadBandMax";
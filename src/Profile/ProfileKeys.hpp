@@ -271,6 +271,7 @@ extern const char VarioZeroFrequency[];
 extern const char VarioMaxFrequency[];
 extern const char VarioMinPeriod[];
 extern const char VarioMaxPeriod[];
+extern const char VarioSmoothFrequency[];
 extern const char VarioDeadBandEnabled[];
 extern const char VarioDeadBandMin[];
 extern const char VarioDeadBandMax[];
@@ -96,6 +96,7 @@ Profile::Load(const ProfileMap &map, VarioSoundSettings &settings)
   map.Get(ProfileKeys::VarioMinFrequency, settings.min_frequency);
   map.Get(ProfileKeys::VarioZeroFrequency, settings.zero_frequency);
   map.Get(ProfileKeys::VarioMaxFrequency, settings.max_frequency);
+  map.Get(ProfileKeys::VarioSmoothFrequency, settings.smooth_frequency);
 
   map.Get(ProfileKeys::VarioMinPeriod, settings.min_period_ms);
   map.Get(ProfileKeys::VarioMaxPeriod, settings.max_period_ms);
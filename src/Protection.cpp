@@ -103,7 +103,7 @@ CreateCalculationThread()
   glide_computer->ProcessGPS(true);
 
   /* copy GlideComputer results to DeviceBlackboard */
-  device_blackboard->ReadBlackboard(glide_computer->Calculated());
+  device_blackboard->ReadBlackboard(std::make_shared<const DerivedInfo>(glide_computer->Calculated()));
 
   calculation_thread = new CalculationThread(*glide_computer);
   calculation_thread->SetComputerSettings(CommonInterface::GetComputerSettings());
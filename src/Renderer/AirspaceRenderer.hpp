@@ -24,6 +24,7 @@ Copyright_License {
 #ifndef XCSOAR_AIRSPACE_RENDERER_HPP
 #define XCSOAR_AIRSPACE_RENDERER_HPP
 
+#include "AirspaceScreenCache.hpp"
 #include "util/StaticArray.hxx"
 #include "Geo/GeoPoint.hpp"
 
@@ -52,6 +53,11 @@ class AirspaceRenderer
 
   StaticArray<GeoPoint,32> intersections;
 
+  /**
+   * The projected airspace polygons of the previous frames.
+   */
+  AirspaceScreenCache screen_cache;
+
 #ifndef ENABLE_OPENGL
   /**
    * This object caches the airspace fill.  This avoids drawing it
@@ -96,6 +102,7 @@ public:
   }
 
   void Flush() {
+    screen_cache.Invalidate();
 #ifndef ENABLE_OPENGL
     fill_cache.Invalidate();
 #endif
@@ -119,7 +126,7 @@ private:
   void DrawOutline(Canvas &canvas,
                    const WindowProjection &projection,
                    const AirspaceRendererSettings &settings,
-                   const AirspacePredicate &visible) const;
+                   const AirspacePredicate &visible);
 #endif
 
   void DrawInternal(Canvas &canvas,
@@ -42,15 +42,24 @@ class AirspaceVisitorRenderer final
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
+  AirspaceScreenCache &screen_cache;
+
+  /**
+   * The screen points of the current polygon, obtained from
+   * #screen_cache.
+   */
+  ConstBuffer<BulkPixelPoint> polygon;
 
 public:
   AirspaceVisitorRenderer(Canvas &_canvas, const WindowProjection &_projection,
                           const AirspaceLook &_look,
                           const AirspaceWarningCopy &_warnings,
-                          const AirspaceRendererSettings &_settings)
+                          const AirspaceRendererSettings &_settings,
+                          AirspaceScreenCache &_screen_cache)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
-     look(_look), warning_manager(_warnings), settings(_settings)
+     look(_look), warning_manager(_warnings), settings(_settings),
+     screen_cache(_screen_cache)
   {
     glStencilMask(0xff);
     glClear(GL_STENCIL_BUFFER_BIT);
@@ -100,7 +109,8 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    polygon = screen_cache.GetPolygon(airspace, projection);
+    if (polygon.empty())
       return;
 
     const AirspaceClassRendererSettings &class_settings =
@@ -119,7 +129,7 @@ private:
       if (!fill_airspace) {
         // set stencil for filling (bit 0)
         SetFillStencil();
-        DrawPrepared();
+        DrawCachedPolygon();
         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
       }
 
@@ -127,20 +137,24 @@ private:
       {
         SetupInterior(airspace, !fill_airspace);
         const GLEnable<GL_BLEND> blend;
-        DrawPrepared();
+        DrawCachedPolygon();
       }
 
       if (!fill_airspace) {
         // clear fill stencil (bit 0)
         ClearFillStencil();
-        DrawPrepared();
+        DrawCachedPolygon();
         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
       }
     }
 
     // draw outline
     if (SetupOutline(airspace))
-      DrawPrepared();
+      DrawCachedPolygon();
+  }
+
+  void DrawCachedPolygon() {
+    canvas.DrawPolygon(polygon.data, polygon.size, screen_cache.GetOffset());
   }
 
 public:
@@ -220,15 +234,24 @@ class AirspaceFillRenderer final
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
+  AirspaceScreenCache &screen_cache;
+
+  /**
+   * The screen points of the current polygon, obtained from
+   * #screen_cache.
+   */
+  ConstBuffer<BulkPixelPoint> polygon;
 
 public:
   AirspaceFillRenderer(Canvas &_canvas, const WindowProjection &_projection,
                        const AirspaceLook &_look,
                        const AirspaceWarningCopy &_warnings,
-                       const AirspaceRendererSettings &_settings)
+                       const AirspaceRendererSettings &_settings,
+                       AirspaceScreenCache &_screen_cache)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
-     look(_look), warning_manager(_warnings), settings(_settings)
+     look(_look), warning_manager(_warnings), settings(_settings),
+     screen_cache(_screen_cache)
   {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
   }
@@ -249,18 +272,23 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    polygon = screen_cache.GetPolygon(airspace, projection);
+    if (polygon.empty())
       return;
 
     if (!warning_manager.IsAcked(airspace) && SetupInterior(airspace)) {
       // fill interior without overpainting any previous outlines
       GLEnable<GL_BLEND> blend;
-      DrawPrepared();
+      DrawCachedPolygon();
     }
 
     // draw outline
     if (SetupOutline(airspace))
-      DrawPrepared();
+      DrawCachedPolygon();
+  }
+
+  void DrawCachedPolygon() {
+    canvas.DrawPolygon(polygon.data, polygon.size, screen_cache.GetOffset());
   }
 
 public:
@@ -319,14 +347,16 @@ AirspaceRenderer::DrawInternal(Canvas &canvas,
 
   if (settings.fill_mode == AirspaceRendererSettings::FillMode::ALL ||
       settings.fill_mode == AirspaceRendererSettings::FillMode::NONE) {
-    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings,
+                                  screen_cache);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
         renderer.Visit(airspace);
     }
   } else {
-    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings,
+                                     screen_cache);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
@@ -50,14 +50,17 @@ class AirspaceVisitorMap final
 {
   const AirspaceLook &look;
   const AirspaceWarningCopy &warnings;
+  AirspaceScreenCache &screen_cache;
 
 public:
   AirspaceVisitorMap(StencilMapCanvas &_helper,
                      const AirspaceWarningCopy &_warnings,
                      const AirspaceRendererSettings &_settings,
-                     const AirspaceLook &_airspace_look)
+                     const AirspaceLook &_airspace_look,
+                     AirspaceScreenCache &_screen_cache)
     :StencilMapCanvas(_helper),
-     look(_airspace_look), warnings(_warnings)
+     look(_airspace_look), warnings(_warnings),
+     screen_cache(_screen_cache)
   {
     switch (settings.fill_mode) {
     case AirspaceRendererSettings::FillMode::DEFAULT:
@@ -80,7 +83,9 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    DrawSearchPointVector(airspace.GetPoints());
+    const auto points = screen_cache.GetPolygon(airspace, proj);
+    if (!points.empty())
+      DrawPolygon(points.data, points.size, screen_cache.GetOffset());
   }
 
 public:
@@ -155,14 +160,16 @@ class AirspaceOutlineRenderer final
 {
   const AirspaceLook &look;
   const AirspaceRendererSettings &settings;
+  AirspaceScreenCache &screen_cache;
 
 public:
   AirspaceOutlineRenderer(Canvas &_canvas, const WindowProjection &_projection,
                           const AirspaceLook &_look,
-                          const AirspaceRendererSettings &_settings)
+                          const AirspaceRendererSettings &_settings,
+                          AirspaceScreenCache &_screen_cache)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
-     look(_look), settings(_settings)
+     look(_look), settings(_settings), screen_cache(_screen_cache)
   {
     if (settings.black_outline)
       canvas.SelectBlackPen();
@@ -190,7 +197,9 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    DrawPolygon(airspace.GetPoints());
+    const auto points = screen_cache.GetPolygon(airspace, projection);
+    if (!points.empty())
+      canvas.DrawPolygon(points.data, points.size, screen_cache.GetOffset());
   }
 
 public:
@@ -220,7 +229,7 @@ AirspaceRenderer::DrawFill(Canvas &buffer_canvas, Canvas &stencil_canvas,
   StencilMapCanvas helper(buffer_canvas, stencil_canvas, projection,
                           settings);
   AirspaceVisitorMap v(helper, awc, settings,
-                       look);
+                       look, screen_cache);
 
   // JMW TODO wasteful to draw twice, can't it be drawn once?
   // we are using two draws so borders go on top of everything
@@ -274,13 +283,14 @@ inline void
 AirspaceRenderer::DrawOutline(Canvas &canvas,
                               const WindowProjection &projection,
                               const AirspaceRendererSettings &settings,
-                              const AirspacePredicate &visible) const
+                              const AirspacePredicate &visible)
 {
   const auto range =
     airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
                                 projection.GetScreenDistanceMeters());
 
-  AirspaceOutlineRenderer outline_renderer(canvas, projection, look, settings);
+  AirspaceOutlineRenderer outline_renderer(canvas, projection, look, settings,
+                                           screen_cache);
   for (const auto &i : range) {
     const AbstractAirspace &airspace = i.GetAirspace();
     if (visible(airspace))
@@ -0,0 +1,172 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AirspaceScreenCache.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Airspace/Airspaces.hpp"
+#include "Airspace/AirspacePolygon.hpp"
+#include "Geo/GeoClip.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "util/Compiler.h"
+
+#include <algorithm>
+#include <cassert>
+
+/**
+ * The cached area is this much larger than the screen bounds.  A
+ * larger factor allows panning further before the cache needs to be
+ * rebuilt, at the cost of projecting more off-screen vertices.
+ */
+static constexpr double CACHE_BOUNDS_SCALE = 2.0;
+
+/**
+ * Returns the maximum difference between the cosine of the given
+ * latitude and the cosine of any latitude within the given bounds.
+ */
+gcc_pure
+static double
+CalcCosineSpread(Angle latitude, const GeoBounds &bounds)
+{
+  const double c = latitude.fastcosine();
+  const double c_south = bounds.GetSouth().fastcosine();
+  const double c_north = bounds.GetNorth().fastcosine();
+
+  /* the cosine is largest at the equator and decreases towards both
+     poles */
+  const double c_min = std::min(c_south, c_north);
+  const double c_max =
+    bounds.GetSouth().Native() < 0 && bounds.GetNorth().Native() > 0
+    ? 1.
+    : std::max(c_south, c_north);
+
+  return std::max(c_max - c, c - c_min);
+}
+
+void
+AirspaceScreenCache::Update(const Airspaces &airspaces,
+                            const WindowProjection &projection)
+{
+  if (defined &&
+      airspaces.GetSerial() == serial &&
+      projection.GetScale() == scale &&
+      projection.GetScreenAngle() == screen_angle &&
+      bounds.IsInside(projection.GetScreenBounds())) {
+    /* a latitude pan is a translation, but a longitude pan moves
+       each vertex by an amount proportional to the cosine of its own
+       latitude; reuse the cached polygons only if the difference to
+       the translation of the reference location is small enough */
+    const Angle delta_longitude =
+      (projection.GetGeoLocation().longitude -
+       reference_location.longitude).Absolute();
+    const double pan_error =
+      cos_latitude_spread * projection.AngleToPixels(delta_longitude);
+    if (pan_error <= MAX_PAN_ERROR) {
+      const auto p = projection.GeoToScreen(reference_location);
+      offset = PixelPoint(p.x - reference_origin.x,
+                          p.y - reference_origin.y);
+      return;
+    }
+  }
+
+  defined = true;
+  serial = airspaces.GetSerial();
+  scale = projection.GetScale();
+  screen_angle = projection.GetScreenAngle();
+  reference_location = projection.GetGeoLocation();
+  reference_origin = projection.GetScreenOrigin();
+  bounds = projection.GetScreenBounds().Scale(CACHE_BOUNDS_SCALE);
+  cos_latitude_spread = CalcCosineSpread(reference_location.latitude,
+                                         bounds);
+  offset = PixelPoint(0, 0);
+
+  polygons.clear();
+  points.clear();
+}
+
+AirspaceScreenCache::Polygon
+AirspaceScreenCache::Project(const AirspacePolygon &airspace,
+                             const Projection &projection)
+{
+  Polygon polygon{unsigned(points.size()), 0};
+
+  const SearchPointVector &src = airspace.GetPoints();
+  unsigned size = src.size();
+  if (size < 3)
+    return polygon;
+
+  /* copy all SearchPointVector elements to geo_points */
+  geo_points.GrowDiscard(size * 3);
+  for (unsigned i = 0; i < size; ++i)
+    geo_points[i] = src[i].GetLocation();
+
+  /* clip them to the cached area */
+  const GeoClip clip(bounds);
+  size = clip.ClipPolygon(geo_points.begin(), geo_points.begin(), size);
+  if (size < 3)
+    return polygon;
+
+  /* project them, store them relative to the reference projection
+     and drop vertices which fall onto the same pixel as their
+     predecessor */
+  BulkPixelPoint last;
+  for (unsigned i = 0; i < size; ++i) {
+    const auto p = projection.GeoToScreen(geo_points[i]);
+    const BulkPixelPoint q(PixelPoint(p.x - offset.x, p.y - offset.y));
+    if (polygon.size > 0 && q.x == last.x && q.y == last.y)
+      continue;
+
+    points.push_back(q);
+    last = q;
+    ++polygon.size;
+  }
+
+  if (polygon.size > 1 &&
+      points[polygon.start].x == last.x && points[polygon.start].y == last.y) {
+    points.pop_back();
+    --polygon.size;
+  }
+
+  if (polygon.size < 3) {
+    points.resize(polygon.start);
+    polygon.size = 0;
+  }
+
+  return polygon;
+}
+
+ConstBuffer<BulkPixelPoint>
+AirspaceScreenCache::GetPolygon(const AirspacePolygon &airspace,
+                                const Projection &projection)
+{
+  assert(defined);
+
+  auto i = polygons.find(&airspace);
+  if (i == polygons.end())
+    i = polygons.emplace(&airspace, Project(airspace, projection)).first;
+
+  const Polygon polygon = i->second;
+  if (polygon.size == 0)
+    return nullptr;
+
+  return {points.data() + polygon.start, polygon.size};
+}
@@ -0,0 +1,172 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_SCREEN_CACHE_HPP
+#define XCSOAR_AIRSPACE_SCREEN_CACHE_HPP
+
+#include "ui/dim/BulkPoint.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "Math/Angle.hpp"
+#include "util/AllocatedArray.hxx"
+#include "util/ConstBuffer.hxx"
+#include "util/Serial.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+class Airspaces;
+class AbstractAirspace;
+class AirspacePolygon;
+class Projection;
+class WindowProjection;
+
+/**
+ * Caches the projected, clipped and simplified screen polygons of
+ * airspaces across frames.
+ *
+ * The cache is keyed by the projection's scale and rotation and by
+ * the serial of the #Airspaces container.  As long as these remain
+ * the same, panning the map is nearly a translation: the cached
+ * polygons are drawn with a pixel offset (see GetOffset()) instead of
+ * being projected again.  Polygons are clipped to an area larger than
+ * the screen, and the cache is rebuilt when the screen leaves that
+ * area.
+ *
+ * Panning east or west is not an exact translation, because the
+ * projection scales longitudes by the cosine of each vertex's own
+ * latitude.  The cache is rebuilt when the resulting error may exceed
+ * #MAX_PAN_ERROR pixels.
+ *
+ * Polygons are projected lazily, on the first lookup after a
+ * rebuild, so the cost of a frame depends on the number of airspaces
+ * on the screen, and not on their total vertex count.
+ */
+class AirspaceScreenCache {
+  struct Polygon {
+    /**
+     * Index of the first point in #points.
+     */
+    unsigned start;
+
+    /**
+     * The number of points; zero if the airspace is outside of the
+     * cached area.
+     */
+    unsigned size;
+  };
+
+public:
+  /**
+   * The maximum error (in pixels) of a cached vertex caused by
+   * panning east or west.
+   */
+  static constexpr double MAX_PAN_ERROR = 1;
+
+private:
+  bool defined = false;
+
+  Serial serial;
+  double scale;
+  Angle screen_angle;
+
+  /**
+   * The geographic location and the screen origin of the projection
+   * which was used to build the cache.  The translation of a later
+   * projection is determined by projecting #reference_location again.
+   */
+  GeoPoint reference_location;
+  PixelPoint reference_origin;
+
+  /**
+   * The area which was used to clip the cached polygons.
+   */
+  GeoBounds bounds;
+
+  /**
+   * The maximum difference between the cosine of the latitude of
+   * #reference_location and the cosine of any latitude within
+   * #bounds.  Multiplied with the east-west pan distance, this is
+   * the error of treating that pan as a translation.
+   */
+  double cos_latitude_spread;
+
+  /**
+   * The translation from cached screen coordinates to the current
+   * projection.
+   */
+  PixelPoint offset;
+
+  std::unordered_map<const AbstractAirspace *, Polygon> polygons;
+
+  /**
+   * Contiguous storage for the screen points of all polygons.
+   */
+  std::vector<BulkPixelPoint> points;
+
+  /**
+   * A variable-length buffer for clipped GeoPoints.
+   */
+  AllocatedArray<GeoPoint> geo_points;
+
+public:
+  AirspaceScreenCache() = default;
+  AirspaceScreenCache(const AirspaceScreenCache &) = delete;
+  AirspaceScreenCache &operator=(const AirspaceScreenCache &) = delete;
+
+  void Invalidate() {
+    defined = false;
+  }
+
+  /**
+   * Prepare the cache for drawing a frame with the given projection.
+   * This discards all polygons if the airspaces, the scale or the
+   * rotation have changed, if the screen has left the cached area or
+   * if the map was panned too far east or west.
+   */
+  void Update(const Airspaces &airspaces, const WindowProjection &projection);
+
+  /**
+   * Returns the offset which must be added to the points returned
+   * by GetPolygon() to obtain screen coordinates of the projection
+   * passed to Update().  Pass it to Canvas::DrawPolygon().
+   */
+  PixelPoint GetOffset() const {
+    return offset;
+  }
+
+  /**
+   * Look up the screen polygon of the given airspace, projecting it
+   * if it is not yet in the cache.  Must be called after Update().
+   *
+   * @return the screen points relative to GetOffset(), or an empty
+   * buffer if the polygon is not visible
+   */
+  ConstBuffer<BulkPixelPoint> GetPolygon(const AirspacePolygon &airspace,
+                                         const Projection &projection);
+
+private:
+  Polygon Project(const AirspacePolygon &airspace,
+                  const Projection &projection);
+};
+
+#endif
@@ -290,10 +290,10 @@ FlightStatisticsRenderer::RenderTask(Canvas &canvas, const PixelRect rc,
 }
 
 void
-FlightStatisticsRenderer::CaptionTask(TCHAR *sTmp, const DerivedInfo &derived)
+FlightStatisticsRenderer::CaptionTask(TCHAR *sTmp, const DerivedInfo &derived,
+                                      const CommonStats &common)
 {
   const TaskStats &task_stats = derived.ordered_task_stats;
-  const CommonStats &common = derived.common_stats;
 
   if (!task_stats.task_valid ||
       !derived.task_stats.total.remaining.IsDefined()) {
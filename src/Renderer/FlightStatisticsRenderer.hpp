@@ -31,6 +31,7 @@ Copyright_License {
 struct PixelRect;
 struct NMEAInfo;
 struct DerivedInfo;
+struct CommonStats;
 struct ContestSettings;
 struct ComputerSettings;
 struct MapSettings;
@@ -68,7 +69,8 @@ public:
                   const ProtectedTaskManager &task,
                   const TraceComputer *trace_computer) const;
 
-  static void CaptionTask(TCHAR *sTmp, const DerivedInfo &derived);
+  static void CaptionTask(TCHAR *sTmp, const DerivedInfo &derived,
+                          const CommonStats &common);
   static void CaptionOLC(TCHAR *sTmp, const ContestSettings &settings,
                          const DerivedInfo &derived);
 
@@ -39,14 +39,14 @@ Copyright_License {
 #include <algorithm>
 
 void
-ThermalBandRenderer::ScaleChart(const DerivedInfo &calculated,
+ThermalBandRenderer::ScaleChart(const CommonStats &common_stats,
                                  const ComputerSettings &settings_computer,
                                  const TaskBehaviour& task_props,
                                 ChartRenderer &chart,
                                 const double hoffset) const
 {
   chart.ScaleYFromValue(task_props.route_planner.safety_height_terrain);
-  chart.ScaleYFromValue(calculated.common_stats.height_max_working-hoffset);
+  chart.ScaleYFromValue(common_stats.height_max_working-hoffset);
 
   chart.ScaleXFromValue(0);
   chart.ScaleXFromValue(0.5);
@@ -158,6 +158,7 @@ ThermalBandRenderer::DrawRiskMC(const DerivedInfo& calculated,
 void
 ThermalBandRenderer::_DrawThermalBand(const MoreData &basic,
                                       const DerivedInfo& calculated,
+                                      const CommonStats &common_stats,
                                       const ComputerSettings &settings_computer,
                                       ChartRenderer &chart,
                                       const TaskBehaviour& task_props,
@@ -168,7 +169,7 @@ ThermalBandRenderer::_DrawThermalBand(const MoreData &basic,
   // all heights here are relative to ground
   const auto hoffset = calculated.GetTerrainBaseFallback();
 
-  ScaleChart(calculated, settings_computer, task_props, chart, hoffset);
+  ScaleChart(common_stats, settings_computer, task_props, chart, hoffset);
 
   double h = 0;
   if (basic.NavAltitudeAvailable()) {
@@ -212,7 +213,7 @@ ThermalBandRenderer::_DrawThermalBand(const MoreData &basic,
   }
 
   // draw working band lines
-  DrawWorkingBand(calculated, chart, hoffset);
+  DrawWorkingBand(common_stats, chart, hoffset);
 
   // position of MC
   if (basic.NavAltitudeAvailable()) {
@@ -233,6 +234,7 @@ ThermalBandRenderer::_DrawThermalBand(const MoreData &basic,
 void
 ThermalBandRenderer::DrawThermalBand(const MoreData &basic,
                                      const DerivedInfo& calculated,
+                                     const CommonStats &common_stats,
                                      const ComputerSettings &settings_computer,
                                      Canvas &canvas,
                                      const PixelRect &rc,
@@ -242,12 +244,12 @@ ThermalBandRenderer::DrawThermalBand(const MoreData &basic,
 {
   ChartRenderer chart(chart_look, canvas, rc, !is_map);
 
-  if (!is_map && (calculated.common_stats.height_max_working <= 0)) {
+  if (!is_map && (common_stats.height_max_working <= 0)) {
     // no climbs recorded
     chart.DrawNoData();
     return;
   }
-  _DrawThermalBand(basic, calculated, settings_computer,
+  _DrawThermalBand(basic, calculated, common_stats, settings_computer,
                    chart, task_props, false, is_map, ordered_props);
 
   if (!is_map) {
@@ -261,26 +263,27 @@ ThermalBandRenderer::DrawThermalBand(const MoreData &basic,
 void
 ThermalBandRenderer::DrawThermalBandSpark(const MoreData &basic,
                                           const DerivedInfo& calculated,
+                                          const CommonStats &common_stats,
                                           const ComputerSettings &settings_computer,
                                           Canvas &canvas,
                                           const PixelRect &rc,
                                           const TaskBehaviour &task_props) const
 {
   ChartRenderer chart(chart_look, canvas, rc, false);
-  _DrawThermalBand(basic, calculated, settings_computer,
+  _DrawThermalBand(basic, calculated, common_stats, settings_computer,
                    chart, task_props, true, false, nullptr);
 }
 
 void
-ThermalBandRenderer::DrawWorkingBand(const DerivedInfo& calculated_info,
+ThermalBandRenderer::DrawWorkingBand(const CommonStats &common_stats,
                                      ChartRenderer &chart,
                                      const double hoffset) const
 {
-  const auto h_max = calculated_info.common_stats.height_max_working-hoffset;
+  const auto h_max = common_stats.height_max_working-hoffset;
   if ((h_max> chart.GetYMin()) && (h_max< chart.GetYMax())) {
     chart.DrawLine(0, h_max, chart.GetXMax(), h_max, look.working_band_pen);
   }
-  const auto h_min = calculated_info.common_stats.height_min_working-hoffset;
+  const auto h_min = common_stats.height_min_working-hoffset;
   if ((h_min> chart.GetYMin()) && (h_min< chart.GetYMax())) {
     chart.DrawLine(0, h_min, chart.GetXMax(), h_min, look.working_band_pen);
   }
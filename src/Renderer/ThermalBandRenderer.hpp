@@ -31,6 +31,7 @@ class ChartRenderer;
 class Canvas;
 struct MoreData;
 struct DerivedInfo;
+struct CommonStats;
 struct ComputerSettings;
 struct OrderedTaskSettings;
 struct TaskBehaviour;
@@ -47,6 +48,7 @@ public:
 
   void DrawThermalBand(const MoreData& basic,
                        const DerivedInfo& calculated,
+                       const CommonStats &common_stats,
                        const ComputerSettings &settings_computer,
                        Canvas &canvas,
                        const PixelRect &rc,
@@ -56,6 +58,7 @@ public:
 
   void DrawThermalBandSpark(const MoreData &basic,
                             const DerivedInfo& calculated,
+                            const CommonStats &common_stats,
                             const ComputerSettings &settings_computer,
                             Canvas &canvas,
                             const PixelRect &rc,
@@ -64,6 +67,7 @@ public:
 protected:
   void _DrawThermalBand(const MoreData &basic,
                         const DerivedInfo& calculated,
+                        const CommonStats &common_stats,
                         const ComputerSettings &settings_computer,
                         ChartRenderer &chart,
                         const TaskBehaviour& task_props,
@@ -71,13 +75,13 @@ protected:
                         const bool is_map,
                         const OrderedTaskSettings* ordered_props) const;
 
-  void ScaleChart(const DerivedInfo &calculated,
+  void ScaleChart(const CommonStats &common_stats,
                   const ComputerSettings &settings_computer,
                   const TaskBehaviour& task_props,
                   ChartRenderer &chart,
                   const double hoffset) const;
 
-  void DrawWorkingBand(const DerivedInfo& calculated,
+  void DrawWorkingBand(const CommonStats &common_stats,
                        ChartRenderer &chart,
                        const double hoffset) const;
 
@@ -32,6 +32,7 @@
 #include "Interface.hpp"
 #include "CatmullRomInterpolator.hpp"
 #include "time/Cast.hxx"
+#include "time/LatencyTrace.hpp"
 #include "util/Clamp.hpp"
 
 #include <stdexcept>
@@ -134,7 +135,9 @@ Replay::Update()
 
     {
       std::lock_guard<Mutex> lock(device_blackboard->mutex);
-      device_blackboard->SetReplayState() = next_data;
+      NMEAInfo &replay_state = device_blackboard->SetReplayState();
+      replay_state = next_data;
+      replay_state.latency_stamp = LatencyTrace::Begin();
       device_blackboard->ScheduleMerge();
     }
 
@@ -208,7 +211,9 @@ Replay::Update()
 
     {
       std::lock_guard<Mutex> lock(device_blackboard->mutex);
-      device_blackboard->SetReplayState() = data;
+      NMEAInfo &replay_state = device_blackboard->SetReplayState();
+      replay_state = data;
+      replay_state.latency_stamp = LatencyTrace::Begin();
       device_blackboard->ScheduleMerge();
     }
   }
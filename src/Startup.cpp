@@ -32,6 +32,7 @@ Copyright_License {
 #include "InfoBoxes/InfoBoxManager.hpp"
 #include "Terrain/RasterTerrain.hpp"
 #include "Weather/Rasp/RaspStore.hpp"
+#include "Thermal/HotspotDatabase.hpp"
 #include "Input/InputEvents.hpp"
 #include "Input/InputQueue.hpp"
 #include "Dialogs/StartupDialog.hpp"
@@ -58,6 +59,9 @@ Copyright_License {
 #include "Audio/VolumeController.hpp"
 #include "Screen/Busy.hpp"
 #include "CommandLine.hpp"
+#include "time/LatencyTrace.hpp"
+#include "time/Instrument.hpp"
+#include "system/ConvertPathName.hpp"
 #include "MainWindow.hpp"
 #include "Computer/GlideComputer.hpp"
 #include "Computer/GlideComputerInterface.hpp"
@@ -68,6 +72,8 @@ Copyright_License {
 #include "Replay/Replay.hpp"
 #include "LocalPath.hpp"
 #include "io/FileCache.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
 #include "io/async/AsioThread.hpp"
 #include "io/async/GlobalAsioThread.hpp"
 #include "net/http/DownloadManager.hpp"
@@ -130,6 +136,50 @@ LoadProfile()
   return true;
 }
 
+/**
+ * Write all recorded latency trace events to a text file, one event
+ * per line: stage name, origin time stamp and latency (both in
+ * nanoseconds).  See test/src/LatencyReport.cpp.
+ */
+static void
+DumpLatencyTrace(Path path)
+{
+  const auto events = LatencyTrace::Collect();
+
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+
+  for (const auto &event : events)
+    os.Format("%s %llu %llu\n", LatencyTrace::GetStageName(event.stage),
+              (unsigned long long)event.origin,
+              (unsigned long long)event.GetLatency());
+
+  os.Flush();
+  file.Commit();
+
+  LogFormat("Wrote %u latency trace events", unsigned(events.size()));
+}
+
+#ifdef HAVE_CMDLINE_INSTRUMENT
+
+/**
+ * Write the report of the hot path timers and counters to a text
+ * file.
+ */
+static void
+DumpInstrumentReport(Path path)
+{
+  const auto report = Instrument::FormatReport();
+
+  FileOutputStream file(path);
+  file.Write(report.data(), report.length());
+  file.Commit();
+
+  LogFormat("Wrote instrument report");
+}
+
+#endif
+
 static void
 AfterStartup()
 {
@@ -179,6 +229,14 @@ Startup()
 {
   VerboseOperationEnvironment operation;
 
+  if (CommandLine::latency_trace_path != nullptr)
+    LatencyTrace::Enable();
+
+#ifdef HAVE_CMDLINE_INSTRUMENT
+  if (CommandLine::instrument_path != nullptr)
+    Instrument::Enable();
+#endif
+
 #ifdef HAVE_DOWNLOAD_MANAGER
   Net::DownloadManager::Initialise();
 #endif
@@ -342,13 +400,21 @@ Startup()
 
   // ReSynchronise the blackboards here since SetHome touches them
   device_blackboard->Merge();
-  CommonInterface::ReadBlackboardBasic(device_blackboard->Basic());
+  CommonInterface::ReadBlackboardBasic(device_blackboard->GetBasicSnapshot());
 
   // Scan for weather forecast
   LogFormat("RASP load");
   auto rasp = std::make_shared<RaspStore>(LocalPath(_T(RASP_FILENAME)));
   rasp->ScanAll();
 
+  // Thermal hotspots from past flights (see BuildThermalHotspots)
+  std::shared_ptr<const HotspotDatabase> hotspots;
+  try {
+    hotspots = HotspotDatabase::Open(LocalPath(_T("hotspots.dat")));
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to load thermal hotspots");
+  }
+
   // Reads the airspace files
   ReadAirspace(airspace_database, terrain, computer_settings.pressure,
                operation);
@@ -397,6 +463,7 @@ Startup()
     map_window->SetTopography(topography);
     map_window->SetTerrain(terrain);
     map_window->SetRasp(rasp);
+    map_window->SetHotspotDatabase(std::move(hotspots));
 
 #ifdef HAVE_NOAA
     map_window->SetNOAAStore(noaa_store);
@@ -567,12 +634,27 @@ Shutdown()
   }
 #endif
 
+  if (CommandLine::latency_trace_path != nullptr) {
+    try {
+      DumpLatencyTrace(PathName(CommandLine::latency_trace_path));
+    } catch (...) {
+      LogError(std::current_exception());
+    }
+  }
+
+#ifdef HAVE_CMDLINE_INSTRUMENT
+  if (CommandLine::instrument_path != nullptr) {
+    try {
+      DumpInstrumentReport(PathName(CommandLine::instrument_path));
+    } catch (...) {
+      LogError(std::current_exception());
+    }
+  }
+#endif
+
   LogFormat("delete MapWindow");
   main_window->Deinitialise();
 
-  // Stop sound
-  AudioVarioGlue::Deinitialise();
-
   // Save the task for the next time
   operation.SetText(_("Shutdown, saving task..."));
 
@@ -600,6 +682,10 @@ Shutdown()
   // Close any device connections
   devShutdown();
 
+  // Stop sound; this must be done after the devices are closed,
+  // because device drivers feed the audio vario directly
+  AudioVarioGlue::Deinitialise();
+
   NMEALogger::Shutdown();
 
   delete replay;
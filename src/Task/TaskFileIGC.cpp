@@ -46,6 +46,10 @@ try {
   char *line;
   bool header_found = false;
   while ((line = reader.ReadLine()) != nullptr) {
+    // The declaration precedes the first fix (B record)
+    if (*line == 'B')
+      break;
+
     // Skip lines which are not declaration records
     if (*line != _T('C'))
       continue;
@@ -154,6 +158,11 @@ try {
   // Search for declaration
   char *line;
   while ((line = reader.ReadLine()) != nullptr) {
+    if (*line == 'B')
+      /* the declaration precedes the first fix; don't read the
+         whole flight */
+      break;
+
     if (*line != 'C')
       continue;
 
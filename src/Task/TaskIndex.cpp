@@ -0,0 +1,177 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TaskIndex.hpp"
+#include "system/Path.hpp"
+#include "io/FileLineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/NumberParser.hpp"
+#include "util/StringAPI.hxx"
+
+/**
+ * The first line of the file; it must be changed whenever the format
+ * or the meaning of the cached data changes.
+ */
+static constexpr TCHAR MAGIC[] = _T("XCSoar task index 1");
+
+/**
+ * Parse the file header line "SIZE MTIME COUNT PATH".
+ */
+static const TCHAR *
+ParseFileLine(const TCHAR *line, TaskIndex::Entry &entry, unsigned &count)
+{
+  TCHAR *endptr;
+  entry.size = ParseUint64(line, &endptr);
+  if (endptr == line || *endptr != _T(' '))
+    return nullptr;
+
+  line = endptr + 1;
+  entry.mtime = ParseUint64(line, &endptr);
+  if (endptr == line || *endptr != _T(' '))
+    return nullptr;
+
+  line = endptr + 1;
+  count = ParseUnsigned(line, &endptr);
+  if (endptr == line || *endptr != _T(' ') || endptr[1] == 0)
+    return nullptr;
+
+  return endptr + 1;
+}
+
+void
+TaskIndex::Load(Path path) noexcept
+try {
+  entries.clear();
+  modified = false;
+
+  FileLineReader reader(path);
+
+  const TCHAR *line = reader.ReadLine();
+  if (line == nullptr || !StringIsEqual(line, MAGIC))
+    return;
+
+  while ((line = reader.ReadLine()) != nullptr) {
+    Entry entry;
+    entry.used = false;
+
+    unsigned count;
+    const TCHAR *file = ParseFileLine(line, entry, count);
+    if (file == nullptr) {
+      /* malformed; discard the whole index */
+      entries.clear();
+      return;
+    }
+
+    tstring key(file);
+
+    for (unsigned i = 0; i < count; ++i) {
+      line = reader.ReadLine();
+      if (line == nullptr || (*line != _T('-') && *line != _T('+'))) {
+        entries.clear();
+        return;
+      }
+
+      if (*line == _T('+'))
+        entry.names.emplace_back(line + 1);
+      else
+        entry.names.emplace_back(std::nullopt);
+    }
+
+    entries.emplace(std::move(key), std::move(entry));
+  }
+} catch (...) {
+  /* no index yet or not readable: start from scratch */
+  entries.clear();
+}
+
+void
+TaskIndex::Save(Path path, bool purge)
+{
+  if (purge) {
+    for (auto i = entries.begin(); i != entries.end();) {
+      if (i->second.used) {
+        ++i;
+      } else {
+        i = entries.erase(i);
+        modified = true;
+      }
+    }
+  }
+
+  if (!modified)
+    return;
+
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+
+  os.Write(MAGIC);
+  os.Write('\n');
+
+  for (const auto &i : entries) {
+    const Entry &entry = i.second;
+    os.Format("%llu %llu %u ",
+              (unsigned long long)entry.size,
+              (unsigned long long)entry.mtime,
+              unsigned(entry.names.size()));
+    os.Write(i.first.c_str());
+    os.Write('\n');
+
+    for (const auto &name : entry.names) {
+      if (name) {
+        os.Write('+');
+        os.Write(name->c_str());
+      } else
+        os.Write('-');
+      os.Write('\n');
+    }
+  }
+
+  os.Flush();
+  file.Commit();
+  modified = false;
+}
+
+const TaskIndex::Entry *
+TaskIndex::Lookup(Path path, uint64_t size, uint64_t mtime) noexcept
+{
+  auto i = entries.find(path.c_str());
+  if (i == entries.end() ||
+      i->second.size != size || i->second.mtime != mtime)
+    return nullptr;
+
+  i->second.used = true;
+  return &i->second;
+}
+
+void
+TaskIndex::Put(Path path, uint64_t size, uint64_t mtime,
+               std::vector<std::optional<tstring>> &&names) noexcept
+{
+  Entry &entry = entries[path.c_str()];
+  entry.size = size;
+  entry.mtime = mtime;
+  entry.names = std::move(names);
+  entry.used = true;
+  modified = true;
+}
@@ -0,0 +1,99 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TASK_INDEX_HPP
+#define XCSOAR_TASK_INDEX_HPP
+
+#include "util/tstring.hpp"
+#include "util/Compiler.h"
+
+#include <map>
+#include <optional>
+#include <vector>
+
+#include <cstdint>
+
+class Path;
+
+/**
+ * An on-disk cache of the task names found in task files.  Each
+ * entry is keyed by the file's path, and is only valid as long as
+ * the file's size and modification time are unchanged.  This allows
+ * #TaskStore to parse only new or modified files.
+ */
+class TaskIndex {
+public:
+  struct Entry {
+    uint64_t size, mtime;
+
+    /**
+     * The name of each task in the file, as returned by
+     * TaskFile::GetName(); std::nullopt if the task has no name.
+     * The size of this vector is the number of tasks.
+     */
+    std::vector<std::optional<tstring>> names;
+
+    /**
+     * Was this entry looked up or added since Load()?
+     */
+    bool used;
+  };
+
+private:
+  std::map<tstring, Entry> entries;
+
+  bool modified = false;
+
+public:
+  /**
+   * Load the index from a file.  Errors are ignored; the index is
+   * empty then.
+   */
+  void Load(Path path) noexcept;
+
+  /**
+   * Write the index to a file, but only if anything has changed.
+   *
+   * Throws on error.
+   *
+   * @param purge omit all entries which have not been used since
+   * Load(), i.e. files which have been deleted
+   */
+  void Save(Path path, bool purge=true);
+
+  /**
+   * Look up the entry for a file.  Returns nullptr if there is none
+   * or if the file has been modified since.
+   */
+  const Entry *Lookup(Path path, uint64_t size, uint64_t mtime) noexcept;
+
+  void Put(Path path, uint64_t size, uint64_t mtime,
+           std::vector<std::optional<tstring>> &&names) noexcept;
+
+  gcc_pure
+  std::size_t size() const noexcept {
+    return entries.size();
+  }
+};
+
+#endif
@@ -23,44 +23,77 @@ Copyright_License {
 
 #include "Task/TaskStore.hpp"
 #include "Task/TaskFile.hpp"
+#include "Task/TaskIndex.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "Components.hpp"
 #include "system/FileUtil.hpp"
 #include "system/Path.hpp"
 #include "LocalPath.hpp"
 #include "Language/Language.hpp"
+#include "LogFile.hpp"
 
 #include <algorithm>
 #include <memory>
 
+#include <cassert>
+
 class TaskFileVisitor: public File::Visitor
 {
 private:
   TaskStore::ItemVector &store;
 
+  TaskIndex &index;
+
 public:
-  TaskFileVisitor(TaskStore::ItemVector &_store):
-    store(_store) {}
+  TaskFileVisitor(TaskStore::ItemVector &_store, TaskIndex &_index):
+    store(_store), index(_index) {}
 
   void Visit(Path path, Path base_name) override {
-    // Create a TaskFile instance to determine how many
-    // tasks are inside of this task file
-    std::unique_ptr<TaskFile> task_file(TaskFile::Create(path));
-    if (!task_file)
-      return;
-
-    // Count the tasks in the task file
-    unsigned count = task_file->Count();
+    const uint64_t size = File::GetSize(path);
+    const uint64_t mtime = File::GetLastModification(path);
+
+    const TaskIndex::Entry *entry = index.Lookup(path, size, mtime);
+    if (entry == nullptr) {
+      // Create a TaskFile instance to determine how many
+      // tasks are inside of this task file
+      std::unique_ptr<TaskFile> task_file(TaskFile::Create(path));
+      if (!task_file)
+        return;
+
+      // Count the tasks in the task file and remember their names
+      const unsigned count = task_file->Count();
+      std::vector<std::optional<tstring>> names;
+      names.reserve(count);
+      for (unsigned i = 0; i < count; i++) {
+        const TCHAR *saved_name = task_file->GetName(i);
+        if (saved_name != nullptr)
+          names.emplace_back(saved_name);
+        else
+          names.emplace_back(std::nullopt);
+      }
+
+      index.Put(path, size, mtime, std::move(names));
+      entry = index.Lookup(path, size, mtime);
+      assert(entry != nullptr);
+    }
+
+    Add(path, base_name, entry->names);
+  }
+
+private:
+  void Add(Path path, Path base_name,
+           const std::vector<std::optional<tstring>> &names) {
+    const unsigned count = names.size();
+
     // For each task in the task file
     for (unsigned i = 0; i < count; i++) {
       // Copy base name of the file into task name
       StaticString<256> name(base_name.c_str());
 
       // If the task file holds more than one task
-      const TCHAR *saved_name = task_file->GetName(i);
-      if (saved_name != nullptr) {
+      if (names[i]) {
         name += _T(": ");
-        name += saved_name;
+        name += names[i]->c_str();
       } else if (count > 1) {
         // .. append " - Task #[n]" suffix to the task name
         name.AppendFormat(_T(": %s #%d"), _("Task"), i + 1);
@@ -79,23 +112,60 @@ TaskStore::Clear()
   store.erase(store.begin(), store.end());
 }
 
-void
-TaskStore::Scan(bool extra)
+template<typename V>
+static void
+ScanFiles(TaskStore::ItemVector &store, V &&visit, bool extra,
+          Path index_path)
 {
-  Clear();
+  TaskIndex index;
+  if (index_path != nullptr)
+    index.Load(index_path);
 
   // scan files
-  TaskFileVisitor tfv(store);
-  VisitDataFiles(_T("*.tsk"), tfv);
+  TaskFileVisitor tfv(store, index);
+  visit(_T("*.tsk"), tfv);
 
   if (extra) {
-    VisitDataFiles(_T("*.cup"), tfv);
-    VisitDataFiles(_T("*.igc"), tfv);
+    visit(_T("*.cup"), tfv);
+    visit(_T("*.igc"), tfv);
+  }
+
+  if (index_path != nullptr) {
+    try {
+      /* only a full scan has seen all files; a normal scan must not
+         purge the *.cup and *.igc entries */
+      index.Save(index_path, extra);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to save task index");
+    }
   }
 
   std::sort(store.begin(), store.end());
 }
 
+void
+TaskStore::Scan(bool extra)
+{
+  Clear();
+
+  const auto cache_path = LocalPath(_T("cache"));
+  Directory::Create(cache_path);
+
+  ScanFiles(store, [](const TCHAR *filter, File::Visitor &visitor){
+      VisitDataFiles(filter, visitor);
+    }, extra, AllocatedPath::Build(cache_path, _T("tasks.idx")));
+}
+
+void
+TaskStore::Scan(Path directory, bool extra, Path index_path)
+{
+  Clear();
+
+  ScanFiles(store, [directory](const TCHAR *filter, File::Visitor &visitor){
+      Directory::VisitSpecificFiles(directory, filter, visitor, true);
+    }, extra, index_path);
+}
+
 TaskStore::Item::~Item()
 {
   if (!filename.IsNull())
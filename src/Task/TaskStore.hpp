@@ -89,13 +89,24 @@ private:
 
 public:
   /**
-   * Scan the XCSoarData folder for .tsk files and add them to the TaskStore
+   * Scan the XCSoarData folder for .tsk files and add them to the
+   * TaskStore.  Task names are cached in "cache/tasks.idx", so only
+   * new or modified files need to be parsed.
    *
    * @param extra scan all "extra" (non-XCSoar) task files, e.g. *.cup
    * and task declarations from *.igc
    */
   void Scan(bool extra=false);
 
+  /**
+   * Scan the given directory (recursively) instead of the
+   * XCSoarData folder.
+   *
+   * @param index_path the file name of the #TaskIndex which caches
+   * the task names; nullptr to parse all files
+   */
+  void Scan(Path directory, bool extra, Path index_path);
+
   /**
    * Clear all the tasks from the TaskStore
    */
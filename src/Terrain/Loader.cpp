@@ -37,6 +37,12 @@ extern "C" {
 
 #include <string.h>
 
+bool
+TerrainLoader::IsCancelled() const noexcept
+{
+  return env.IsCancelled();
+}
+
 long
 TerrainLoader::SkipMarkerSegment(long file_offset) const
 {
@@ -62,6 +62,12 @@ public:
 
   /* callback methods for libjasper (via jas_rtc.cpp) */
 
+  /**
+   * Shall the decoder give up?  This is checked before each marker
+   * segment.
+   */
+  bool IsCancelled() const noexcept;
+
   long SkipMarkerSegment(long file_offset) const;
   void MarkerSegment(long file_offset, unsigned id);
 
@@ -88,6 +88,19 @@ public:
     return projection;
   }
 
+  /**
+   * Count the tiles around the given location which are not loaded
+   * yet.
+   *
+   * @param radius the radius in meters
+   */
+  gcc_pure
+  unsigned CountMissingTiles(const GeoPoint &location, double radius) const {
+    const auto p = projection.ProjectCoarse(location);
+    const unsigned r = projection.DistancePixelsCoarse(radius);
+    return raster_tile_cache.CountMissingTiles(p.x, p.y, r);
+  }
+
   /**
    * The geographical distance in meters of the given amount
    * of pixels multiplied by 256.
@@ -160,6 +160,21 @@ RasterTileCache::PollTiles(int x, int y, unsigned radius)
   return num_activate > 0;
 }
 
+unsigned
+RasterTileCache::CountMissingTiles(int x, int y, unsigned radius) const
+{
+  const int r = radius;
+
+  unsigned n = 0;
+  for (const RasterTile &tile : tiles)
+    if (tile.IsDefined() && !tile.IsEnabled() &&
+        x + r >= (int)tile.xstart && x - r < (int)tile.xend &&
+        y + r >= (int)tile.ystart && y - r < (int)tile.yend)
+      ++n;
+
+  return n;
+}
+
 TerrainHeight
 RasterTileCache::GetHeight(unsigned px, unsigned py) const
 {
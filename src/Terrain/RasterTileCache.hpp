@@ -276,6 +276,13 @@ public:
 
   bool PollTiles(int x, int y, unsigned radius);
 
+  /**
+   * Count the tiles overlapping the given square which are not
+   * loaded, i.e. where lookups fall back to the coarse overview.
+   */
+  gcc_pure
+  unsigned CountMissingTiles(int x, int y, unsigned radius) const;
+
   void PutTileData(unsigned index, const struct jas_matrix &m);
 
   void FinishTileUpdate();
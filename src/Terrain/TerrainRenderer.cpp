@@ -27,6 +27,7 @@ Copyright_License {
 #include "ui/canvas//RawBitmap.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "util/Macros.hpp"
+#include "time/Instrument.hpp"
 
 #include <cassert>
 
@@ -318,20 +319,26 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
       !IsLargeSizeDifference(old_bounds, new_bounds) &&
       terrain_serial == terrain.GetSerial() &&
       sunazimuth.CompareRoughly(last_sun_azimuth) &&
-      !raster_renderer.UpdateQuantisation())
+      !raster_renderer.UpdateQuantisation()) {
     /* no change since previous frame */
+    INSTRUMENT_COUNT(TERRAIN_UNCHANGED, 1);
     return true;
+  }
 
 #else
   if (compare_projection.Compare(map_projection) &&
       terrain_serial == terrain.GetSerial() &&
-      sunazimuth.CompareRoughly(last_sun_azimuth))
+      sunazimuth.CompareRoughly(last_sun_azimuth)) {
     /* no change since previous frame */
+    INSTRUMENT_COUNT(TERRAIN_UNCHANGED, 1);
     return true;
+  }
 
   compare_projection = CompareProjection(map_projection);
 #endif
 
+  INSTRUMENT_SCOPE(TERRAIN_GENERATE);
+
   terrain_serial = terrain.GetSerial();
 
   last_sun_azimuth = sunazimuth;
@@ -31,8 +31,21 @@ TerrainThread::TerrainThread(RasterTerrain &_terrain,
   :StandbyThread("Terrain"), terrain(_terrain),
    callback(std::move(_callback)) {}
 
+inline bool
+TerrainThread::IsFresh(const GeoPoint &center, double radius,
+                       const GeoPoint &lookahead) const
+{
+  if (!last_center.IsValid() || last_radius < radius ||
+      last_center.DistanceS(center) >= 1000)
+    return false;
+
+  return !lookahead.IsValid() ||
+    (last_lookahead.IsValid() && last_lookahead.DistanceS(lookahead) < 1000);
+}
+
 void
-TerrainThread::Trigger(const WindowProjection &projection)
+TerrainThread::Trigger(const WindowProjection &projection,
+                       const GeoPoint &lookahead)
 {
   assert(projection.IsValid());
 
@@ -40,12 +53,12 @@ TerrainThread::Trigger(const WindowProjection &projection)
 
   GeoPoint center = projection.GetGeoScreenCenter();
   auto radius = projection.GetScreenWidthMeters() / 2;
-  if (last_center.IsValid() && last_radius >= radius &&
-      last_center.DistanceS(center) < 1000)
+  if (IsFresh(center, radius, lookahead))
     return;
 
   next_center = center;
   next_radius = radius;
+  next_lookahead = lookahead;
   StandbyThread::Trigger();
 }
 
@@ -68,6 +81,29 @@ TerrainThread::Tick() noexcept
     last_radius = radius;
   }
 
+  /* the visible area is complete; now load the tiles ahead of the
+     aircraft, unless a new request has arrived meanwhile, which
+     always takes precedence */
+  bool more = !again;
+  while (more && next_lookahead.IsValid() &&
+         !IsStopped() && !IsPending()) {
+    const GeoPoint center = next_center;
+    const GeoPoint lookahead = next_lookahead;
+
+    /* a circle which encloses both the visible area and the
+       predicted one, so the tile cache doesn't discard visible
+       tiles */
+    const auto radius = next_radius + center.DistanceS(lookahead) / 2;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      more = terrain.UpdateTiles(center.Middle(lookahead), radius);
+    }
+
+    if (!more)
+      last_lookahead = lookahead;
+  }
+
   /* notify the client */
   if (callback) {
     const ScopeUnlock unlock(mutex);
@@ -26,6 +26,7 @@ Copyright_License {
 
 #include "thread/StandbyThread.hpp"
 #include "Geo/GeoPoint.hpp"
+#include "util/Compiler.h"
 
 #include <functional>
 
@@ -46,14 +47,37 @@ class TerrainThread final : private StandbyThread {
   GeoPoint next_center;
   double next_radius;
 
+  /**
+   * The predicted screen center (see PredictMapLocation()).  Tiles
+   * around it are loaded after the visible area is complete.  Invalid
+   * if there is no prediction.
+   */
+  GeoPoint next_lookahead = GeoPoint::Invalid();
+
+  /**
+   * The prediction which has been loaded completely.
+   */
+  GeoPoint last_lookahead = GeoPoint::Invalid();
+
 public:
   TerrainThread(RasterTerrain &_terrain, std::function<void()> &&_callback);
 
   using StandbyThread::LockStop;
 
-  void Trigger(const WindowProjection &projection);
+  /**
+   * Load the terrain tiles visible in the given projection.
+   *
+   * @param lookahead the predicted screen center; tiles around it are
+   * loaded with lower priority
+   */
+  void Trigger(const WindowProjection &projection,
+               const GeoPoint &lookahead=GeoPoint::Invalid());
 
 private:
+  gcc_pure
+  bool IsFresh(const GeoPoint &center, double radius,
+               const GeoPoint &lookahead) const;
+
   /* virtual methods from class StandbyThread*/
   void Tick() noexcept override;
 };
@@ -410,6 +410,9 @@ int jpc_dec_decode(jpc_dec_t *dec)
 	dec->state = JPC_MHSOC;
 
 	for (;;) {
+		if (jas_rtc_IsCancelled(dec->loader))
+			return -1;
+
 		long file_offset = jas_stream_tell(dec->in);
 		long seek_offset = jas_rtc_SkipMarkerSegment(dec->loader,
 							     file_offset);
@@ -3,6 +3,11 @@
 
 extern "C" {
 
+  int jas_rtc_IsCancelled(void *_loader) {
+    const auto &loader = *(const TerrainLoader *)_loader;
+    return loader.IsCancelled();
+  }
+
   long jas_rtc_SkipMarkerSegment(void *_loader, long file_offset) {
     auto &loader = *(TerrainLoader *)_loader;
     return loader.SkipMarkerSegment(file_offset);
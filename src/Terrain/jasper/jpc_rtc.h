@@ -9,6 +9,8 @@ struct jas_matrix;
 extern "C" {
 #endif
 
+  int jas_rtc_IsCancelled(void *loader);
+
   gcc_const
   long jas_rtc_SkipMarkerSegment(void *loader, long file_offset);
   void jas_rtc_MarkerSegment(void *loader, long file_offset, unsigned id);
@@ -0,0 +1,101 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ClimbDetector.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/CirclingInfo.hpp"
+
+void
+ClimbDetector::Reset()
+{
+  circling = false;
+}
+
+bool
+ClimbDetector::Update(const MoreData &basic, const CirclingInfo &circling_info,
+                      DetectedClimb &climb)
+{
+  if (!basic.time_available || !basic.location_available ||
+      !basic.NavAltitudeAvailable())
+    return false;
+
+  const double altitude = basic.nav_altitude;
+
+  if (!circling_info.circling)
+    return Finish(climb);
+
+  if (!circling) {
+    circling = true;
+    start_time = last_time = basic.time;
+    base_altitude = top_altitude = last_altitude = altitude;
+    sum_latitude = sum_longitude = sum_weight = 0;
+    return false;
+  }
+
+  if (basic.time <= last_time) {
+    /* time warp or duplicate fix */
+    if (basic.time < last_time)
+      Reset();
+    return false;
+  }
+
+  /* weight each fix by the height it gained, so the centre moves
+     towards the core of the thermal */
+  const double gain = altitude - last_altitude;
+  if (gain > 0) {
+    sum_latitude += gain * basic.location.latitude.Degrees();
+    sum_longitude += gain * basic.location.longitude.Degrees();
+    sum_weight += gain;
+  }
+
+  if (altitude < base_altitude)
+    base_altitude = altitude;
+  if (altitude > top_altitude)
+    top_altitude = altitude;
+
+  last_time = basic.time;
+  last_altitude = altitude;
+  return false;
+}
+
+bool
+ClimbDetector::Finish(DetectedClimb &climb)
+{
+  if (!circling)
+    return false;
+
+  circling = false;
+
+  const double duration = last_time - start_time;
+  if (sum_weight <= 0 || duration < MIN_DURATION ||
+      top_altitude - base_altitude < MIN_GAIN)
+    return false;
+
+  climb.location = GeoPoint(Angle::Degrees(sum_longitude / sum_weight),
+                            Angle::Degrees(sum_latitude / sum_weight));
+  climb.start_time = start_time;
+  climb.duration = duration;
+  climb.base_altitude = base_altitude;
+  climb.top_altitude = top_altitude;
+  return true;
+}
@@ -0,0 +1,103 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THERMAL_CLIMB_DETECTOR_HPP
+#define XCSOAR_THERMAL_CLIMB_DETECTOR_HPP
+
+#include "Geo/GeoPoint.hpp"
+
+struct MoreData;
+struct CirclingInfo;
+
+/**
+ * A climb found by #ClimbDetector.
+ */
+struct DetectedClimb {
+  /**
+   * The lift-weighted centre of the climb.
+   */
+  GeoPoint location;
+
+  /**
+   * UTC time of day when circling started [s].
+   */
+  double start_time;
+
+  double duration;
+
+  double base_altitude, top_altitude;
+
+  double GetGain() const {
+    return top_altitude - base_altitude;
+  }
+
+  double GetClimbRate() const {
+    return duration > 0
+      ? GetGain() / duration
+      : 0;
+  }
+};
+
+/**
+ * Extracts climbs from a flight, using the circling state calculated
+ * by #CirclingComputer.  Only climbs with a significant gain are
+ * reported, to filter out short turns and weak lift.
+ */
+class ClimbDetector {
+  static constexpr double MIN_GAIN = 100;
+  static constexpr double MIN_DURATION = 60;
+
+  bool circling;
+
+  double start_time, last_time;
+  double base_altitude, top_altitude, last_altitude;
+
+  /**
+   * Sum of the lift-weighted coordinates [degrees] and the weight.
+   */
+  double sum_latitude, sum_longitude, sum_weight;
+
+public:
+  ClimbDetector() {
+    Reset();
+  }
+
+  void Reset();
+
+  /**
+   * Feed a new fix.
+   *
+   * @return true if a climb has ended and was stored in the
+   * parameter
+   */
+  bool Update(const MoreData &basic, const CirclingInfo &circling,
+              DetectedClimb &climb);
+
+  /**
+   * Call at the end of the flight to obtain a climb which is still in
+   * progress.
+   */
+  bool Finish(DetectedClimb &climb);
+};
+
+#endif
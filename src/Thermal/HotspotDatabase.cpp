@@ -0,0 +1,302 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "HotspotDatabase.hpp"
+#include "ClimbDetector.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/RuntimeError.hxx"
+
+#include <algorithm>
+
+#include <math.h>
+#include <string.h>
+
+static constexpr char MAGIC[8] = { 'X', 'C', 'S', 'H', 'O', 'T', 'S', 'P' };
+static constexpr unsigned GRID_SIZE = 1u << HotspotDatabase::LEVEL;
+
+GeoPoint
+HotspotRecord::GetLocation() const noexcept
+{
+  return GeoPoint(Angle::Degrees(longitude * 1e-7),
+                  Angle::Degrees(latitude * 1e-7));
+}
+
+/**
+ * Spread the lower 16 bits of the value over the even bits of the
+ * result.
+ */
+static constexpr uint32_t
+SpreadBits(uint32_t x) noexcept
+{
+  x &= 0xffff;
+  x = (x | (x << 8)) & 0x00ff00ff;
+  x = (x | (x << 4)) & 0x0f0f0f0f;
+  x = (x | (x << 2)) & 0x33333333;
+  x = (x | (x << 1)) & 0x55555555;
+  return x;
+}
+
+/**
+ * The reverse of SpreadBits().
+ */
+static constexpr unsigned
+CompactBits(uint32_t x) noexcept
+{
+  x &= 0x55555555;
+  x = (x | (x >> 1)) & 0x33333333;
+  x = (x | (x >> 2)) & 0x0f0f0f0f;
+  x = (x | (x >> 4)) & 0x00ff00ff;
+  x = (x | (x >> 8)) & 0x0000ffff;
+  return x;
+}
+
+uint32_t
+HotspotDatabase::Encode(unsigned x, unsigned y) noexcept
+{
+  return SpreadBits(x) | (SpreadBits(y) << 1);
+}
+
+unsigned
+HotspotDatabase::DecodeX(uint32_t cell) noexcept
+{
+  return CompactBits(cell);
+}
+
+unsigned
+HotspotDatabase::DecodeY(uint32_t cell) noexcept
+{
+  return CompactBits(cell >> 1);
+}
+
+static unsigned
+ToGrid(double value) noexcept
+{
+  const int i = (int)floor(value * GRID_SIZE);
+  return std::clamp(i, 0, int(GRID_SIZE - 1));
+}
+
+unsigned
+HotspotDatabase::LongitudeToX(double longitude) noexcept
+{
+  return ToGrid((longitude + 180) / 360);
+}
+
+unsigned
+HotspotDatabase::LatitudeToY(double latitude) noexcept
+{
+  return ToGrid((latitude + 90) / 180);
+}
+
+unsigned
+HotspotDatabase::SolarHour(double time_of_day, double longitude) noexcept
+{
+  /* 15 degrees of longitude shift the sun by one hour */
+  const int hour = (int)floor(time_of_day / 3600 + longitude / 15);
+  return unsigned(((hour % 24) + 24) % 24);
+}
+
+HotspotDatabase::HotspotDatabase(Path path)
+  :mapping(path)
+{
+  if (mapping.error())
+    throw FormatRuntimeError("Failed to map %s", path.ToUTF8().c_str());
+
+  if (mapping.size() < sizeof(Header))
+    throw std::runtime_error("Hotspot database is truncated");
+
+  header = (const Header *)mapping.data();
+  if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header->byte_order != 1)
+    throw std::runtime_error("Not a hotspot database");
+
+  if (header->version != VERSION)
+    throw std::runtime_error("Unsupported hotspot database version");
+
+  if (mapping.size() != sizeof(Header) +
+      size_t(header->n_records) * sizeof(HotspotRecord))
+    throw std::runtime_error("Hotspot database is truncated");
+
+  records = (const HotspotRecord *)mapping.at(sizeof(Header));
+}
+
+std::shared_ptr<const HotspotDatabase>
+HotspotDatabase::Open(Path path)
+{
+  if (!File::Exists(path))
+    return nullptr;
+
+  return std::make_shared<HotspotDatabase>(path);
+}
+
+static const HotspotRecord *
+LowerBound(const HotspotRecord *begin, const HotspotRecord *end,
+           uint64_t cell) noexcept
+{
+  return std::lower_bound(begin, end, cell,
+                          [](const HotspotRecord &r, uint64_t c){
+                            return r.cell < c;
+                          });
+}
+
+unsigned
+HotspotDatabase::FindRanges(const GeoBounds &bounds, CellBounds &cb,
+                            Range *ranges) const noexcept
+{
+  if (header->n_records == 0 || !bounds.IsValid())
+    return 0;
+
+  cb.y0 = LatitudeToY(bounds.GetSouth().Degrees());
+  cb.y1 = LatitudeToY(bounds.GetNorth().Degrees());
+
+  const double west = bounds.GetWest().Degrees();
+  const double east = bounds.GetEast().Degrees();
+  if (west <= east) {
+    cb.x0 = LongitudeToX(west);
+    cb.x1 = LongitudeToX(east);
+  } else {
+    /* crosses the date line; not worth optimising */
+    cb.x0 = 0;
+    cb.x1 = GRID_SIZE - 1;
+  }
+
+  /* choose the finest quadtree level which needs no more than
+     MAX_RANGES nodes */
+  unsigned shift = 0;
+  while (uint64_t((cb.x1 >> shift) - (cb.x0 >> shift) + 1) *
+         ((cb.y1 >> shift) - (cb.y0 >> shift) + 1) > MAX_RANGES)
+    ++shift;
+
+  const HotspotRecord *const end = records + header->n_records;
+  unsigned n = 0;
+
+  for (unsigned ty = cb.y0 >> shift; ty <= cb.y1 >> shift; ++ty) {
+    for (unsigned tx = cb.x0 >> shift; tx <= cb.x1 >> shift; ++tx) {
+      const uint64_t first = uint64_t(Encode(tx, ty)) << (2 * shift);
+      const uint64_t last = first + (uint64_t(1) << (2 * shift));
+
+      const HotspotRecord *i = LowerBound(records, end, first);
+      const HotspotRecord *j = LowerBound(i, end, last);
+      if (i != j)
+        ranges[n++] = {i, j};
+    }
+  }
+
+  return n;
+}
+
+void
+HotspotDatabaseBuilder::Accumulator::Add(const Accumulator &other) noexcept
+{
+  weight += other.weight;
+  latitude += other.latitude;
+  longitude += other.longitude;
+  climb_rate += other.climb_rate;
+  base_altitude += other.base_altitude;
+  top_altitude += other.top_altitude;
+  n_climbs += other.n_climbs;
+}
+
+void
+HotspotDatabaseBuilder::Add(const DetectedClimb &climb) noexcept
+{
+  const double latitude = climb.location.latitude.Degrees();
+  const double longitude = climb.location.longitude.Degrees();
+
+  const uint32_t cell =
+    HotspotDatabase::Encode(HotspotDatabase::LongitudeToX(longitude),
+                            HotspotDatabase::LatitudeToY(latitude));
+  const unsigned hour = HotspotDatabase::SolarHour(climb.start_time,
+                                                   longitude);
+
+  /* stronger climbs pull the centre of the hotspot towards them */
+  const double weight = std::max(climb.GetGain(), 1.);
+
+  Accumulator a;
+  a.weight = weight;
+  a.latitude = weight * latitude;
+  a.longitude = weight * longitude;
+  a.climb_rate = climb.GetClimbRate();
+  a.base_altitude = climb.base_altitude;
+  a.top_altitude = climb.top_altitude;
+  a.n_climbs = 1;
+
+  cells[(uint64_t(cell) << 8) | hour].Add(a);
+  ++n_climbs;
+}
+
+void
+HotspotDatabaseBuilder::Merge(const HotspotDatabaseBuilder &other) noexcept
+{
+  for (const auto &i : other.cells)
+    cells[i.first].Add(i.second);
+
+  n_flights += other.n_flights;
+  n_climbs += other.n_climbs;
+}
+
+static int16_t
+ToInt16(double value) noexcept
+{
+  return (int16_t)std::clamp(lround(value), -32768L, 32767L);
+}
+
+void
+HotspotDatabaseBuilder::Save(Path path) const
+{
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+
+  HotspotDatabase::Header header{};
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.byte_order = 1;
+  header.version = HotspotDatabase::VERSION;
+  header.n_records = cells.size();
+  header.n_flights = n_flights;
+  header.n_climbs = n_climbs;
+  os.Write(&header, sizeof(header));
+
+  /* std::map is sorted by cell and hour, which is the order needed
+     by HotspotDatabase::FindRanges() */
+  for (const auto &i : cells) {
+    const Accumulator &a = i.second;
+    const double n = a.n_climbs;
+
+    HotspotRecord record{};
+    record.cell = uint32_t(i.first >> 8);
+    record.hour = uint8_t(i.first);
+    record.latitude = (int32_t)lround(a.latitude / a.weight * 1e7);
+    record.longitude = (int32_t)lround(a.longitude / a.weight * 1e7);
+    record.n_climbs = a.n_climbs;
+    record.climb_rate = float(a.climb_rate / n);
+    record.base_altitude = ToInt16(a.base_altitude / n);
+    record.top_altitude = ToInt16(a.top_altitude / n);
+    os.Write(&record, sizeof(record));
+  }
+
+  os.Flush();
+  file.Commit();
+}
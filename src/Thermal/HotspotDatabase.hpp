@@ -0,0 +1,280 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THERMAL_HOTSPOT_DATABASE_HPP
+#define XCSOAR_THERMAL_HOTSPOT_DATABASE_HPP
+
+#include "system/FileMapping.hpp"
+#include "util/Compiler.h"
+
+#include <map>
+#include <memory>
+
+#include <cstdint>
+
+class Path;
+class GeoBounds;
+struct GeoPoint;
+struct DetectedClimb;
+
+/**
+ * One entry of the #HotspotDatabase: all climbs which were found in
+ * one grid cell during one hour of the day.
+ */
+struct HotspotRecord {
+  /**
+   * The Morton code (Z-order) of the grid cell.  Records are sorted
+   * by this key, which makes all cells of a quadtree node
+   * contiguous.
+   */
+  uint32_t cell;
+
+  /**
+   * The lift-weighted centre of all climbs [1e-7 degrees].
+   */
+  int32_t latitude, longitude;
+
+  uint32_t n_climbs;
+
+  /**
+   * The average climb rate [m/s].
+   */
+  float climb_rate;
+
+  /**
+   * The average base and top altitude [m].
+   */
+  int16_t base_altitude, top_altitude;
+
+  /**
+   * The local solar time of the climbs [hours, 0..23].
+   */
+  uint8_t hour;
+
+  uint8_t reserved[3];
+
+  gcc_pure
+  GeoPoint GetLocation() const noexcept;
+};
+
+static_assert(sizeof(HotspotRecord) == 28, "Wrong size");
+
+/**
+ * A database of thermal hotspots found in a collection of flights.
+ * It is built offline by #HotspotDatabaseBuilder (see
+ * test/src/BuildThermalHotspots.cpp) and accessed through a memory
+ * mapping, i.e. a query touches only the pages it needs.
+ *
+ * The world is divided into a grid of 2^16 x 2^16 cells (about
+ * 600 x 300 m at the equator).  Records are sorted by the Morton
+ * code of their cell, so each quadtree node is a contiguous range
+ * which can be found with a binary search.
+ */
+class HotspotDatabase {
+public:
+  static constexpr unsigned LEVEL = 16;
+  static constexpr uint32_t VERSION = 1;
+
+  struct Header {
+    char magic[8];
+
+    /**
+     * Always 1; rejects files written on a machine with a different
+     * byte order.
+     */
+    uint32_t byte_order;
+
+    uint32_t version;
+
+    uint32_t n_records;
+    uint32_t n_flights;
+    uint32_t n_climbs;
+    uint32_t reserved;
+  };
+
+  static_assert(sizeof(Header) == 32, "Wrong size");
+
+  /**
+   * The inclusive cell range of a query.
+   */
+  struct CellBounds {
+    unsigned x0, y0, x1, y1;
+
+    constexpr bool Contains(unsigned x, unsigned y) const noexcept {
+      return x >= x0 && x <= x1 && y >= y0 && y <= y1;
+    }
+  };
+
+  struct Range {
+    const HotspotRecord *begin, *end;
+  };
+
+  /**
+   * The maximum number of quadtree nodes visited by one query.
+   */
+  static constexpr unsigned MAX_RANGES = 16;
+
+private:
+  FileMapping mapping;
+
+  const Header *header;
+  const HotspotRecord *records;
+
+public:
+  /**
+   * Throws on error.
+   */
+  explicit HotspotDatabase(Path path);
+
+  /**
+   * Open the database.  Throws if the file is not usable.
+   *
+   * @return the database or nullptr if the file does not exist
+   */
+  static std::shared_ptr<const HotspotDatabase> Open(Path path);
+
+  unsigned GetRecordCount() const noexcept {
+    return header->n_records;
+  }
+
+  unsigned GetFlightCount() const noexcept {
+    return header->n_flights;
+  }
+
+  unsigned GetClimbCount() const noexcept {
+    return header->n_climbs;
+  }
+
+  /**
+   * Invoke the visitor for all records inside the given bounds.
+   *
+   * @param hour only return records of this hour (local solar time);
+   * -1 for all hours
+   * @param min_climbs only return records with at least this number
+   * of climbs
+   */
+  template<typename V>
+  void VisitWithin(const GeoBounds &bounds, int hour, unsigned min_climbs,
+                   V &&visitor) const {
+    CellBounds cb;
+    Range ranges[MAX_RANGES];
+    const unsigned n = FindRanges(bounds, cb, ranges);
+
+    for (unsigned r = 0; r < n; ++r) {
+      for (const HotspotRecord *i = ranges[r].begin; i != ranges[r].end; ++i)
+        if (i->n_climbs >= min_climbs &&
+            (hour < 0 || i->hour == unsigned(hour)) &&
+            cb.Contains(DecodeX(i->cell), DecodeY(i->cell)))
+          visitor(*i);
+    }
+  }
+
+  gcc_const
+  static uint32_t Encode(unsigned x, unsigned y) noexcept;
+
+  gcc_const
+  static unsigned DecodeX(uint32_t cell) noexcept;
+
+  gcc_const
+  static unsigned DecodeY(uint32_t cell) noexcept;
+
+  gcc_const
+  static unsigned LongitudeToX(double longitude) noexcept;
+
+  gcc_const
+  static unsigned LatitudeToY(double latitude) noexcept;
+
+  /**
+   * Calculate the local solar time from the UTC time of day [s] and
+   * the longitude [degrees].
+   *
+   * @return the hour (0..23)
+   */
+  gcc_const
+  static unsigned SolarHour(double time_of_day, double longitude) noexcept;
+
+private:
+  /**
+   * Determine the ranges of records which may be inside the given
+   * bounds, using as few quadtree nodes as possible (at most
+   * #MAX_RANGES).
+   *
+   * @return the number of ranges
+   */
+  unsigned FindRanges(const GeoBounds &bounds, CellBounds &cb,
+                      Range *ranges) const noexcept;
+};
+
+/**
+ * Aggregates climbs and writes a #HotspotDatabase file.  Several
+ * builders (e.g. one per thread) may be merged.
+ */
+class HotspotDatabaseBuilder {
+  struct Accumulator {
+    double weight = 0, latitude = 0, longitude = 0;
+    double climb_rate = 0, base_altitude = 0, top_altitude = 0;
+    unsigned n_climbs = 0;
+
+    void Add(const Accumulator &other) noexcept;
+  };
+
+  /**
+   * Key is the cell (upper 32 bits) and the hour (lower 8 bits),
+   * i.e. iterating the map yields the order of the file.
+   */
+  std::map<uint64_t, Accumulator> cells;
+
+  unsigned n_flights = 0, n_climbs = 0;
+
+public:
+  unsigned GetFlightCount() const noexcept {
+    return n_flights;
+  }
+
+  unsigned GetClimbCount() const noexcept {
+    return n_climbs;
+  }
+
+  unsigned GetRecordCount() const noexcept {
+    return cells.size();
+  }
+
+  /**
+   * Count a flight which was analysed (regardless of whether it
+   * contained any climbs).
+   */
+  void AddFlight() noexcept {
+    ++n_flights;
+  }
+
+  void Add(const DetectedClimb &climb) noexcept;
+
+  void Merge(const HotspotDatabaseBuilder &other) noexcept;
+
+  /**
+   * Write the database file.  Throws on error.
+   */
+  void Save(Path path) const;
+};
+
+#endif
@@ -0,0 +1,216 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CompiledTopography.hpp"
+#include "io/ZipReader.hpp"
+#include "shapelib/mapserver.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <string.h>
+
+namespace CompiledTopography {
+
+template<typename T>
+static const T *
+Section(const uint8_t *&p, size_t n)
+{
+  const T *result = (const T *)p;
+  p += Align(n * sizeof(T));
+  return result;
+}
+
+/**
+ * Check that the index set at the given offset (counts followed by
+ * vertex indices, see Shape::indices) lies completely within the
+ * index array and refers only to the points of its shape.
+ */
+static bool
+CheckIndexSet(const uint16_t *indices, size_t num_indices, size_t offset,
+              unsigned num_counts, size_t num_points)
+{
+  if (offset > num_indices || num_indices - offset < num_counts)
+    return false;
+
+  const uint16_t *const counts = indices + offset;
+  size_t total = 0;
+  for (unsigned i = 0; i < num_counts; ++i)
+    total += counts[i];
+
+  if (num_indices - offset - num_counts < total)
+    return false;
+
+  const uint16_t *const vertices = counts + num_counts;
+  for (size_t i = 0; i < total; ++i)
+    if (vertices[i] >= num_points)
+      return false;
+
+  return true;
+}
+
+bool
+Reader::Load(zzip_dir *dir, const char *path)
+{
+  header = nullptr;
+
+  AllocatedArray<uint8_t> data;
+
+  try {
+    ZipReader reader(dir, path);
+    const uint64_t size = reader.GetSize();
+    if (size < sizeof(FileHeader) || size > 0x40000000)
+      return false;
+
+    data.ResizeDiscard(size);
+
+    uint8_t *p = data.begin(), *const end = p + size;
+    while (p < end) {
+      size_t nbytes = reader.Read(p, end - p);
+      if (nbytes == 0)
+        return false;
+
+      p += nbytes;
+    }
+  } catch (const std::runtime_error &) {
+    return false;
+  }
+
+  return Load(std::move(data));
+}
+
+bool
+Reader::Load(AllocatedArray<uint8_t> &&data)
+{
+  header = nullptr;
+  buffer = std::move(data);
+
+  if (buffer.size() < sizeof(FileHeader))
+    return false;
+
+  const FileHeader &h = *(const FileHeader *)buffer.begin();
+  if (memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      h.version != VERSION || h.byte_order != BYTE_ORDER_MARK ||
+      h.num_shapes == 0 ||
+      h.tile_columns == 0 || h.tile_rows == 0 ||
+      h.west >= h.east || h.south >= h.north)
+    return false;
+
+  /* 64 bit arithmetic, so bogus counts cannot overflow the size
+     calculation on 32 bit machines */
+  const uint64_t num_tiles = uint64_t(h.tile_columns) * h.tile_rows;
+  if (num_tiles >= buffer.size())
+    return false;
+
+  const uint64_t expected_size = sizeof(FileHeader) +
+    Align(uint64_t(h.num_shapes) * sizeof(Shape)) +
+    Align(uint64_t(h.num_points) * sizeof(Point)) +
+    Align(uint64_t(h.num_lines) * sizeof(uint16_t)) +
+    Align(uint64_t(h.num_indices) * sizeof(uint16_t)) +
+    Align((num_tiles + 1) * sizeof(uint32_t)) +
+    Align(uint64_t(h.num_tile_entries) * sizeof(uint32_t)) +
+    Align(h.labels_size);
+  if (buffer.size() < expected_size)
+    return false;
+
+  const uint8_t *p = buffer.begin() + sizeof(FileHeader);
+  shapes = Section<Shape>(p, h.num_shapes);
+  points = Section<Point>(p, h.num_points);
+  lines = Section<uint16_t>(p, h.num_lines);
+  indices = Section<uint16_t>(p, h.num_indices);
+  tile_offsets = Section<uint32_t>(p, num_tiles + 1);
+  tile_entries = Section<uint32_t>(p, h.num_tile_entries);
+  labels = Section<char>(p, h.labels_size);
+
+  /* validate the references, so the rest of the code doesn't need
+     to check them */
+
+  if (tile_offsets[num_tiles] != h.num_tile_entries ||
+      (h.labels_size > 0 && labels[h.labels_size - 1] != 0))
+    return false;
+
+  /* with monotonic offsets, each tile's entry range lies within
+     the entry array */
+  for (size_t i = 0; i < num_tiles; ++i)
+    if (tile_offsets[i] > tile_offsets[i + 1])
+      return false;
+
+  for (unsigned i = 0; i < h.num_tile_entries; ++i)
+    if (tile_entries[i] >= h.num_shapes)
+      return false;
+
+  for (unsigned i = 0; i < h.num_shapes; ++i) {
+    const Shape &shape = shapes[i];
+    if (size_t(shape.first_line) + shape.num_lines > h.num_lines ||
+        (shape.label != NONE && shape.label >= h.labels_size))
+      return false;
+
+    size_t num_points = 0;
+    for (unsigned l = 0; l < shape.num_lines; ++l)
+      num_points += lines[shape.first_line + l];
+
+    if (uint64_t(shape.first_point) + num_points > h.num_points)
+      return false;
+
+    const unsigned num_counts =
+      shape.type == MS_SHAPE_POLYGON ? 1 : shape.num_lines;
+    for (unsigned level = 0; level < THINNING_LEVELS; ++level)
+      if (shape.indices[level] != NONE &&
+          !CheckIndexSet(indices, h.num_indices, shape.indices[level],
+                         num_counts, num_points))
+        return false;
+  }
+
+  header = &h;
+  return true;
+}
+
+bool
+Reader::GetTileRange(const GeoBounds &bounds,
+                     unsigned &column_begin, unsigned &column_end,
+                     unsigned &row_begin, unsigned &row_end) const
+{
+  const double west = std::max(bounds.GetWest().Native(), header->west);
+  const double east = std::min(bounds.GetEast().Native(), header->east);
+  const double south = std::max(bounds.GetSouth().Native(), header->south);
+  const double north = std::min(bounds.GetNorth().Native(), header->north);
+  if (west > east || south > north)
+    return false;
+
+  const double column_scale =
+    header->tile_columns / (header->east - header->west);
+  const double row_scale =
+    header->tile_rows / (header->north - header->south);
+
+  column_begin = std::min(unsigned((west - header->west) * column_scale),
+                          header->tile_columns - 1);
+  column_end = std::min(unsigned((east - header->west) * column_scale),
+                        header->tile_columns - 1) + 1;
+  row_begin = std::min(unsigned((south - header->south) * row_scale),
+                       header->tile_rows - 1);
+  row_end = std::min(unsigned((north - header->south) * row_scale),
+                     header->tile_rows - 1) + 1;
+  return true;
+}
+
+}
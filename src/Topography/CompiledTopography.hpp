@@ -0,0 +1,267 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_COMPILED_HPP
+#define XCSOAR_TOPOGRAPHY_COMPILED_HPP
+
+#include "Geo/GeoBounds.hpp"
+#include "util/AllocatedArray.hxx"
+#include "util/Compiler.h"
+
+#include <cstddef>
+#include <cstdint>
+
+struct zzip_dir;
+
+/**
+ * The on-disk layout of a "compiled" topography file (*.xtp).  It is
+ * generated offline from an ESRI shapefile by the CompileTopography
+ * program, and contains everything #TopographyFile needs at runtime:
+ * projected coordinates, all thinning levels and polygon
+ * triangulations (#XShape::THINNING_LEVELS), UTF-8 labels and a
+ * spatial tile index.
+ *
+ * All sections are contiguous arrays of fixed-size little-endian
+ * records, aligned to 8 bytes, so the whole file can be used in
+ * place after loading (or mapping) it into memory.
+ */
+namespace CompiledTopography {
+
+static constexpr char MAGIC[8] = { 'X', 'C', 'S', 'T', 'O', 'P', 'O', 0 };
+static constexpr uint32_t VERSION = 1;
+static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/**
+ * The number of thinning levels stored per shape; this must match
+ * #XShape::THINNING_LEVELS.
+ */
+static constexpr unsigned THINNING_LEVELS = 4;
+
+/**
+ * Marks a missing index set or a missing label.
+ */
+static constexpr uint32_t NONE = 0xffffffff;
+
+/**
+ * A point relative to the center of the file, in native angle
+ * units.  This is the layout of #ShapePoint.
+ */
+struct Point {
+  float x, y;
+};
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+
+  /**
+   * The center of the file bounds; all coordinates are relative to
+   * this point (native angle units).
+   */
+  double center_longitude, center_latitude;
+
+  /**
+   * The bounds of all shapes (native angle units).
+   */
+  double west, south, east, north;
+
+  uint32_t num_shapes, num_lines, num_points, num_indices;
+  uint32_t tile_columns, tile_rows, num_tile_entries;
+  uint32_t labels_size;
+};
+
+static_assert(sizeof(FileHeader) % 8 == 0, "Wrong FileHeader size");
+
+struct Shape {
+  /**
+   * The bounds of this shape relative to the file center.
+   */
+  Point south_west, north_east;
+
+  /**
+   * The #MS_SHAPE_TYPE.
+   */
+  uint8_t type;
+
+  uint8_t num_lines;
+
+  uint16_t reserved;
+
+  /**
+   * Index of the first line length in the line array.
+   */
+  uint32_t first_line;
+
+  /**
+   * Index of the first point in the point array.
+   */
+  uint32_t first_point;
+
+  /**
+   * Offset of the NUL-terminated UTF-8 label in the label table, or
+   * #NONE.
+   */
+  uint32_t label;
+
+  /**
+   * Offsets of the index sets in the index array, or #NONE.  Each
+   * index set has the layout used by #XShape: line point counts (one
+   * per line) or the total triangle strip length (one value for
+   * polygons), followed by the vertex indices.
+   */
+  uint32_t indices[THINNING_LEVELS];
+};
+
+static_assert(sizeof(Shape) % 8 == 0, "Wrong Shape size");
+
+/**
+ * Round up to the section alignment.
+ */
+constexpr uint64_t
+Align(uint64_t size)
+{
+  return (size + 7) & ~uint64_t(7);
+}
+
+/**
+ * A compiled topography file loaded into memory.
+ */
+class Reader {
+  AllocatedArray<uint8_t> buffer;
+
+  const FileHeader *header = nullptr;
+  const Shape *shapes;
+  const Point *points;
+  const uint16_t *lines;
+  const uint16_t *indices;
+  const uint32_t *tile_offsets;
+  const uint32_t *tile_entries;
+  const char *labels;
+
+public:
+  /**
+   * Load and validate the given file.
+   *
+   * @return false if the file does not exist or is not a valid
+   * compiled topography file
+   */
+  bool Load(zzip_dir *dir, const char *path);
+
+  /**
+   * Validate and take over the given file contents.
+   *
+   * @return false if this is not a valid compiled topography file
+   */
+  bool Load(AllocatedArray<uint8_t> &&data);
+
+  bool IsDefined() const {
+    return header != nullptr;
+  }
+
+  const FileHeader &GetHeader() const {
+    return *header;
+  }
+
+  GeoPoint GetCenter() const {
+    return GeoPoint(Angle::Native(header->center_longitude),
+                    Angle::Native(header->center_latitude));
+  }
+
+  GeoBounds GetBounds() const {
+    return GeoBounds(GeoPoint(Angle::Native(header->west),
+                              Angle::Native(header->north)),
+                     GeoPoint(Angle::Native(header->east),
+                              Angle::Native(header->south)));
+  }
+
+  unsigned GetNumShapes() const {
+    return header->num_shapes;
+  }
+
+  const Shape &GetShape(unsigned i) const {
+    return shapes[i];
+  }
+
+  GeoBounds GetShapeBounds(const Shape &shape) const {
+    const GeoPoint center = GetCenter();
+    return GeoBounds(GeoPoint(center.longitude +
+                              Angle::Native(shape.south_west.x),
+                              center.latitude +
+                              Angle::Native(shape.north_east.y)),
+                     GeoPoint(center.longitude +
+                              Angle::Native(shape.north_east.x),
+                              center.latitude +
+                              Angle::Native(shape.south_west.y)));
+  }
+
+  const Point *GetPoints(const Shape &shape) const {
+    return points + shape.first_point;
+  }
+
+  const uint16_t *GetLines(const Shape &shape) const {
+    return lines + shape.first_line;
+  }
+
+  const uint16_t *GetIndices(const Shape &shape, unsigned level) const {
+    return shape.indices[level] != NONE
+      ? indices + shape.indices[level]
+      : nullptr;
+  }
+
+  const char *GetLabel(const Shape &shape) const {
+    return shape.label != NONE
+      ? labels + shape.label
+      : nullptr;
+  }
+
+  /**
+   * Invoke the given function for the index of each shape which may
+   * intersect the given bounds.  A shape may be visited more than
+   * once.
+   */
+  template<typename F>
+  void VisitTiles(const GeoBounds &bounds, F &&f) const {
+    unsigned column_begin, column_end, row_begin, row_end;
+    if (!GetTileRange(bounds, column_begin, column_end, row_begin, row_end))
+      return;
+
+    for (unsigned row = row_begin; row < row_end; ++row) {
+      const unsigned tile = row * header->tile_columns;
+      for (unsigned i = tile_offsets[tile + column_begin],
+             end = tile_offsets[tile + column_end];
+           i < end; ++i)
+        f(tile_entries[i]);
+    }
+  }
+
+private:
+  gcc_pure
+  bool GetTileRange(const GeoBounds &bounds,
+                    unsigned &column_begin, unsigned &column_end,
+                    unsigned &row_begin, unsigned &row_end) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,243 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CompiledTopographyWriter.hpp"
+#include "CompiledTopography.hpp"
+#include "TopographyFile.hpp"
+#include "XShape.hpp"
+#include "Geo/FAISphere.hpp"
+#include "io/BufferedOutputStream.hxx"
+
+#ifdef _UNICODE
+#include "util/ConvertString.hpp"
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <math.h>
+#include <string.h>
+
+using namespace CompiledTopography;
+
+template<typename T>
+static void
+WriteSection(BufferedOutputStream &os, const std::vector<T> &v)
+{
+  static constexpr uint8_t zero[8]{};
+
+  const size_t size = v.size() * sizeof(T);
+  os.Write(v.data(), size);
+  os.Write(zero, Align(size) - size);
+}
+
+static void
+AppendIndices(std::vector<uint16_t> &dest, const XShape &shape,
+              const uint16_t *count, const uint16_t *indices)
+{
+  size_t n = 0;
+  if (shape.get_type() == MS_SHAPE_POLYGON) {
+    dest.push_back(*count);
+    n = *count;
+  } else {
+    for (unsigned i = 0; i < shape.GetLines().size; ++i) {
+      dest.push_back(count[i]);
+      n += count[i];
+    }
+  }
+
+  dest.insert(dest.end(), indices, indices + n);
+}
+
+static Point
+ToPoint(const GeoPoint &p, const GeoPoint &center)
+{
+  const GeoPoint relative = p - center;
+  return { float(relative.longitude.Native()),
+           float(relative.latitude.Native()) };
+}
+
+void
+WriteCompiledTopography(const TopographyFile &file, BufferedOutputStream &os)
+{
+  const GeoPoint center = file.GetCenter();
+
+  std::vector<Shape> shapes;
+  std::vector<Point> points;
+  std::vector<uint16_t> lines, indices;
+  std::vector<char> labels;
+  std::vector<GeoBounds> bounds;
+
+  GeoBounds file_bounds = GeoBounds::Invalid();
+
+  const std::lock_guard<Mutex> lock(file.mutex);
+
+  for (const XShape &xshape : file) {
+    Shape shape{};
+    shape.type = MS_SHAPE_NULL;
+    shape.first_line = lines.size();
+    shape.first_point = points.size();
+    shape.label = NONE;
+    std::fill_n(shape.indices, THINNING_LEVELS, NONE);
+
+    const auto src_lines = xshape.GetLines();
+    if (xshape.GetPoints() == nullptr || src_lines.empty() ||
+        !xshape.get_bounds().Check()) {
+      /* keep the shape numbering, but don't index it */
+      bounds.push_back(GeoBounds::Invalid());
+      shapes.push_back(shape);
+      continue;
+    }
+
+    shape.type = xshape.get_type();
+    shape.num_lines = src_lines.size;
+
+    const GeoBounds &b = xshape.get_bounds();
+    shape.south_west = ToPoint(b.GetSouthWest(), center);
+    shape.north_east = ToPoint(b.GetNorthEast(), center);
+    bounds.push_back(b);
+
+    if (file_bounds.IsValid()) {
+      file_bounds.Extend(b.GetSouthWest());
+      file_bounds.Extend(b.GetNorthEast());
+    } else
+      file_bounds = b;
+
+    unsigned num_points = 0;
+    for (unsigned n : src_lines) {
+      lines.push_back(n);
+      num_points += n;
+    }
+
+    const ShapePoint *src_points = xshape.GetPoints();
+    for (unsigned i = 0; i < num_points; ++i)
+      points.push_back({src_points[i].x, src_points[i].y});
+
+    if (shape.type != MS_SHAPE_POINT) {
+      for (unsigned level = 0; level < THINNING_LEVELS; ++level) {
+        if (level == 0 && shape.type == MS_SHAPE_LINE)
+          /* lines are drawn without indices at full resolution */
+          continue;
+
+        const ShapeScalar min_distance =
+          ShapeScalar(file.GetMinimumPointDistance(level)) / FAISphere::REARTH;
+
+        const uint16_t *count;
+        const uint16_t *src_indices =
+          xshape.GetIndices(level, min_distance, count);
+        if (src_indices == nullptr)
+          continue;
+
+        shape.indices[level] = indices.size();
+        AppendIndices(indices, xshape, count, src_indices);
+      }
+    }
+
+    const TCHAR *label = xshape.GetLabel();
+    if (label != nullptr) {
+#ifdef _UNICODE
+      const WideToUTF8Converter utf8(label);
+      const char *src = utf8;
+#else
+      const char *src = label;
+#endif
+      shape.label = labels.size();
+      labels.insert(labels.end(), src, src + strlen(src) + 1);
+    }
+
+    shapes.push_back(shape);
+  }
+
+  if (!file_bounds.IsValid())
+    throw std::runtime_error("No shapes");
+
+  FileHeader header{};
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byte_order = BYTE_ORDER_MARK;
+  header.center_longitude = center.longitude.Native();
+  header.center_latitude = center.latitude.Native();
+
+  /* make sure the file bounds are not empty (e.g. a single point) */
+  static constexpr double EPSILON = 1e-9;
+  header.west = file_bounds.GetWest().Native() - EPSILON;
+  header.east = file_bounds.GetEast().Native() + EPSILON;
+  header.south = file_bounds.GetSouth().Native() - EPSILON;
+  header.north = file_bounds.GetNorth().Native() + EPSILON;
+
+  /* build a tile grid with roughly 8 shapes per tile */
+  const unsigned grid_size =
+    std::clamp(unsigned(sqrt(shapes.size() / 8.)), 1u, 256u);
+  header.tile_columns = header.tile_rows = grid_size;
+
+  const double column_scale = grid_size / (header.east - header.west);
+  const double row_scale = grid_size / (header.north - header.south);
+
+  std::vector<std::vector<uint32_t>> tiles(grid_size * grid_size);
+  for (unsigned i = 0; i < shapes.size(); ++i) {
+    const GeoBounds &b = bounds[i];
+    if (!b.IsValid())
+      continue;
+
+    const unsigned column_begin =
+      std::min(unsigned((b.GetWest().Native() - header.west) * column_scale),
+               grid_size - 1);
+    const unsigned column_end =
+      std::min(unsigned((b.GetEast().Native() - header.west) * column_scale),
+               grid_size - 1);
+    const unsigned row_begin =
+      std::min(unsigned((b.GetSouth().Native() - header.south) * row_scale),
+               grid_size - 1);
+    const unsigned row_end =
+      std::min(unsigned((b.GetNorth().Native() - header.south) * row_scale),
+               grid_size - 1);
+
+    for (unsigned row = row_begin; row <= row_end; ++row)
+      for (unsigned column = column_begin; column <= column_end; ++column)
+        tiles[row * grid_size + column].push_back(i);
+  }
+
+  std::vector<uint32_t> tile_offsets, tile_entries;
+  for (const auto &tile : tiles) {
+    tile_offsets.push_back(tile_entries.size());
+    tile_entries.insert(tile_entries.end(), tile.begin(), tile.end());
+  }
+  tile_offsets.push_back(tile_entries.size());
+
+  header.num_shapes = shapes.size();
+  header.num_lines = lines.size();
+  header.num_points = points.size();
+  header.num_indices = indices.size();
+  header.num_tile_entries = tile_entries.size();
+  header.labels_size = labels.size();
+
+  os.Write(&header, sizeof(header));
+  WriteSection(os, shapes);
+  WriteSection(os, points);
+  WriteSection(os, lines);
+  WriteSection(os, indices);
+  WriteSection(os, tile_offsets);
+  WriteSection(os, tile_entries);
+  WriteSection(os, labels);
+}
@@ -0,0 +1,47 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_COMPILED_WRITER_HPP
+#define XCSOAR_TOPOGRAPHY_COMPILED_WRITER_HPP
+
+class TopographyFile;
+class BufferedOutputStream;
+
+/**
+ * Write all shapes of the given #TopographyFile to a compiled
+ * topography file (see #CompiledTopography).  The caller must have
+ * loaded all shapes with TopographyFile::LoadAll().
+ *
+ * The thinning levels are built for a display scale of 1; on
+ * high-dpi screens, this keeps slightly more vertices than the
+ * runtime thinning would.
+ *
+ * This requires OpenGL, because it uses the OpenGL triangulation
+ * code.
+ *
+ * Throws on I/O error.
+ */
+void
+WriteCompiledTopography(const TopographyFile &file, BufferedOutputStream &os);
+
+#endif
@@ -35,13 +35,36 @@ TopographyThread::~TopographyThread()
 {
 }
 
+/**
+ * Move the bounds so the given reference point becomes the new
+ * location.
+ */
+gcc_pure
+static GeoBounds
+MoveBounds(const GeoBounds &bounds, const GeoPoint &from, const GeoPoint &to)
+{
+  const Angle dlon = to.longitude - from.longitude;
+  const Angle dlat = to.latitude - from.latitude;
+  return GeoBounds(GeoPoint(bounds.GetWest() + dlon,
+                            bounds.GetNorth() + dlat),
+                   GeoPoint(bounds.GetEast() + dlon,
+                            bounds.GetSouth() + dlat));
+}
+
 void
-TopographyThread::Trigger(const WindowProjection &_projection)
+TopographyThread::Trigger(const WindowProjection &_projection,
+                          const GeoPoint &lookahead)
 {
   assert(_projection.IsValid());
 
   const GeoBounds new_bounds = _projection.GetScreenBounds();
-  if (last_bounds.IsValid() && last_bounds.IsInside(new_bounds)) {
+  const GeoBounds lookahead_bounds = lookahead.IsValid()
+    ? MoveBounds(new_bounds, _projection.GetGeoScreenCenter(), lookahead)
+    : GeoBounds::Invalid();
+
+  if (last_bounds.IsValid() && last_bounds.IsInside(new_bounds) &&
+      (!lookahead_bounds.IsValid() ||
+       last_bounds.IsInside(lookahead_bounds))) {
     /* still inside cache bounds - now check if we crossed a scale
        threshold for at least one file, which would mean we have to
        update a file which was not updated for the current cache
@@ -53,11 +76,17 @@ TopographyThread::Trigger(const WindowProjection &_projection)
   }
 
   last_bounds = new_bounds.Scale(1.1);
+  if (lookahead_bounds.IsValid()) {
+    last_bounds.Extend(lookahead_bounds.GetNorthWest());
+    last_bounds.Extend(lookahead_bounds.GetSouthEast());
+  }
+
   scale_threshold = store.GetNextScaleThreshold(_projection.GetMapScale());
 
   {
     const std::lock_guard<Mutex> lock(mutex);
     next_projection = _projection;
+    next_lookahead = lookahead_bounds;
     StandbyThread::Trigger();
   }
 }
@@ -76,6 +105,19 @@ TopographyThread::Tick() noexcept
     again = store.ScanVisibility(projection, 1) > 0;
   }
 
+  /* the visible area is complete; now load the shapes ahead of the
+     aircraft, unless a new request has arrived meanwhile, which
+     always takes precedence */
+  again = next_projection.IsValid();
+  while (again && next_lookahead.IsValid() &&
+         !IsStopped() && !IsPending()) {
+    const WindowProjection projection = next_projection;
+    const GeoBounds bounds = next_lookahead;
+
+    const ScopeUnlock unlock(mutex);
+    again = store.Prefetch(projection, bounds, 1) > 0;
+  }
+
   /* notify the client that we have updated the topography cache */
   if (callback) {
     const ScopeUnlock unlock(mutex);
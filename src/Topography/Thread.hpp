@@ -42,6 +42,13 @@ class TopographyThread final : private StandbyThread {
 
   WindowProjection next_projection;
 
+  /**
+   * The predicted screen bounds (see PredictMapLocation()).  Shapes
+   * within are loaded after the visible area is complete.  Invalid if
+   * there is no prediction.
+   */
+  GeoBounds next_lookahead = GeoBounds::Invalid();
+
   GeoBounds last_bounds;
   double scale_threshold;
 
@@ -51,7 +58,14 @@ public:
 
   using StandbyThread::LockStop;
 
-  void Trigger(const WindowProjection &_projection);
+  /**
+   * Load the shapes visible in the given projection.
+   *
+   * @param lookahead the predicted screen center; shapes around it
+   * are loaded with lower priority
+   */
+  void Trigger(const WindowProjection &_projection,
+               const GeoPoint &lookahead=GeoPoint::Invalid());
 
 private:
   /* virtual methods from class StandbyThread*/
@@ -30,6 +30,28 @@ Copyright_License {
 
 #include <algorithm>
 
+#include <string.h>
+
+/**
+ * Extract the base name (without directory and suffix) from a
+ * shapefile path.
+ */
+static AllocatedString
+GetBaseName(const char *path)
+{
+  const char *slash = strrchr(path, '/');
+  if (slash == nullptr)
+    slash = strrchr(path, '\\');
+  if (slash != nullptr)
+    path = slash + 1;
+
+  const char *dot = strrchr(path, '.');
+  return AllocatedString(std::string_view(path,
+                                          dot != nullptr
+                                          ? size_t(dot - path)
+                                          : strlen(path)));
+}
+
 TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                double _threshold,
                                double _label_threshold,
@@ -37,15 +59,20 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                const Color _color,
                                int _label_field,
                                ResourceId _icon, ResourceId _big_icon,
-                               unsigned _pen_width)
-  :dir(_dir), first(nullptr),
+                               unsigned _pen_width,
+                               bool use_compiled)
+  :dir(_dir), name(GetBaseName(filename)), first(nullptr),
    label_field(_label_field), icon(_icon), big_icon(_big_icon),
    pen_width(_pen_width),
    color(_color), scale_threshold(_threshold),
    label_threshold(_label_threshold),
    important_label_threshold(_important_label_threshold),
-   cache_bounds(GeoBounds::Invalid())
+   cache_bounds(GeoBounds::Invalid()),
+   loaded_bounds(GeoBounds::Invalid())
 {
+  if (use_compiled && LoadCompiled(filename))
+    return;
+
   if (msShapefileOpen(&file, "rb", dir, filename, 0) == -1)
     return;
 
@@ -72,12 +99,53 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
   ++serial;
 }
 
+bool
+TopographyFile::LoadCompiled(const char *filename)
+{
+  /* replace the ".shp" suffix with ".xtp" */
+  const size_t length = strlen(filename);
+  if (length < 4)
+    return false;
+
+  AllocatedArray<char> path(length + 1);
+  memcpy(path.begin(), filename, length - 3);
+  strcpy(path.begin() + length - 3, "xtp");
+
+  if (!compiled.Load(dir, path.begin()))
+    return false;
+
+  const unsigned num_shapes = compiled.GetNumShapes();
+  center = compiled.GetCenter();
+
+  shapes.ResizeDiscard(num_shapes);
+  std::fill(shapes.begin(), shapes.end(), ShapeList(nullptr));
+
+  compiled_shapes.ResizeDiscard(num_shapes);
+
+#ifdef ENABLE_OPENGL
+  for (unsigned i = 0; i < num_shapes; ++i)
+    compiled_shapes[i].Import(compiled, i);
+#else
+  compiled_points.ResizeDiscard(compiled.GetHeader().num_points);
+  for (unsigned i = 0; i < num_shapes; ++i)
+    compiled_shapes[i].Import(compiled, i,
+                              compiled_points.begin() +
+                              compiled.GetShape(i).first_point);
+#endif
+
+  ++serial;
+  return true;
+}
+
 TopographyFile::~TopographyFile()
 {
   if (IsEmpty())
     return;
 
   ClearCache();
+
+  if (IsCompiled())
+    return;
   msShapefileClose(&file);
 
   if (dir != nullptr) {
@@ -90,11 +158,52 @@ void
 TopographyFile::ClearCache()
 {
   for (auto i = shapes.begin(), end = shapes.end(); i != end; ++i) {
-    delete i->shape;
+    if (!IsCompiled())
+      delete i->shape;
     i->shape = nullptr;
   }
 
   first = nullptr;
+  compiled_visible.clear();
+}
+
+void
+TopographyFile::UpdateCompiled(const GeoBounds &bounds)
+{
+  compiled_candidates.clear();
+  compiled.VisitTiles(bounds, [this](unsigned i){
+      compiled_candidates.push_back(i);
+    });
+
+  /* a shape may be listed in more than one tile; restore the
+     shapefile order, which is also the drawing order */
+  std::sort(compiled_candidates.begin(), compiled_candidates.end());
+  compiled_candidates.erase(std::unique(compiled_candidates.begin(),
+                                        compiled_candidates.end()),
+                            compiled_candidates.end());
+
+  const std::lock_guard<Mutex> lock(mutex);
+
+  for (unsigned i : compiled_visible)
+    shapes[i].shape = nullptr;
+  compiled_visible.clear();
+
+  const ShapeList **current = &first;
+  for (unsigned i : compiled_candidates) {
+    const XShape &shape = compiled_shapes[i];
+    if (!shape.get_bounds().Overlaps(bounds))
+      continue;
+
+    ShapeList &item = shapes[i];
+    item.shape = &shape;
+    *current = &item;
+    current = &item.next;
+
+    compiled_visible.push_back(i);
+  }
+
+  *current = nullptr;
+  ++serial;
 }
 
 static XShape *
@@ -104,8 +213,45 @@ LoadShape(shapefileObj *file, const GeoPoint &center, int i,
   return new XShape(file, center, i, label_field);
 }
 
+bool
+TopographyFile::NeedsUpdate(const WindowProjection &map_projection) const
+{
+  if (IsEmpty())
+    return false;
+
+  if (map_projection.GetMapScale() > scale_threshold)
+    /* not visible, don't update cache now */
+    return false;
+
+  /* is the cache still fresh? */
+  return !cache_bounds.IsValid() ||
+    !cache_bounds.IsInside(map_projection.GetScreenBounds());
+}
+
+bool
+TopographyFile::IsLoaded(const WindowProjection &map_projection) const
+{
+  if (IsEmpty() || map_projection.GetMapScale() > scale_threshold)
+    return true;
+
+  const std::lock_guard<Mutex> lock(mutex);
+  return loaded_bounds.IsValid() &&
+    loaded_bounds.IsInside(map_projection.GetScreenBounds());
+}
+
 bool
 TopographyFile::Update(const WindowProjection &map_projection)
+{
+  if (!NeedsUpdate(map_projection))
+    return false;
+
+  cache_bounds = map_projection.GetScreenBounds().Scale(2);
+  return UpdateCache();
+}
+
+bool
+TopographyFile::Prefetch(const WindowProjection &map_projection,
+                         const GeoBounds &bounds)
 {
   if (IsEmpty())
     return false;
@@ -114,13 +260,25 @@ TopographyFile::Update(const WindowProjection &map_projection)
     /* not visible, don't update cache now */
     return false;
 
-  const GeoBounds screenRect =
-    map_projection.GetScreenBounds();
-  if (cache_bounds.IsValid() && cache_bounds.IsInside(screenRect))
-    /* the cache is still fresh */
+  if (cache_bounds.IsValid() && cache_bounds.IsInside(bounds))
+    /* already cached */
     return false;
 
-  cache_bounds = screenRect.Scale(2);
+  /* keep the visible area, which has precedence */
+  cache_bounds = map_projection.GetScreenBounds().Scale(2);
+  cache_bounds.Extend(bounds.GetNorthWest());
+  cache_bounds.Extend(bounds.GetSouthEast());
+  return UpdateCache();
+}
+
+bool
+TopographyFile::UpdateCache()
+{
+  if (IsCompiled()) {
+    UpdateCompiled(cache_bounds);
+    SetLoadedBounds(cache_bounds);
+    return true;
+  }
 
   rectObj deg_bounds = ConvertRect(cache_bounds);
 
@@ -129,10 +287,12 @@ TopographyFile::Update(const WindowProjection &map_projection)
   switch (msShapefileWhichShapes(&file, dir, deg_bounds, 0)) {
   case MS_FAILURE:
     ClearCache();
+    SetLoadedBounds(GeoBounds::Invalid());
     return false;
 
   case MS_DONE:
     /* screen is outside of map bounds */
+    SetLoadedBounds(cache_bounds);
     return false;
 
   case MS_SUCCESS:
@@ -186,6 +346,7 @@ TopographyFile::Update(const WindowProjection &map_projection)
   // end of list marker
   assert(*current == nullptr);
 
+  SetLoadedBounds(cache_bounds);
   return true;
 }
 
@@ -195,10 +356,12 @@ TopographyFile::LoadAll()
   // Iterate through the shapefile entries
   const ShapeList **current = &first;
   auto it = shapes.begin();
-  for (int i = 0; i < file.numshapes; ++i, ++it) {
+  for (unsigned i = 0; i < shapes.size(); ++i, ++it) {
     if (it->shape == nullptr)
       // shape isn't cached yet -> cache the shape
-      it->shape = LoadShape(&file, center, i, label_field);
+      it->shape = IsCompiled()
+        ? &compiled_shapes[i]
+        : LoadShape(&file, center, i, label_field);
     // update list pointer
     *current = it;
     current = &it->next;
@@ -26,8 +26,10 @@ Copyright_License {
 #define TOPOGRAPHY_HPP
 
 #include "shapelib/mapserver.h"
+#include "CompiledTopography.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "util/AllocatedArray.hxx"
+#include "util/AllocatedString.hxx"
 #include "util/Serial.hpp"
 #include "ui/canvas/Color.hpp"
 #include "ResourceId.hpp"
@@ -38,6 +40,7 @@ Copyright_License {
 #endif
 
 #include <cassert>
+#include <vector>
 
 class WindowProjection;
 class XShape;
@@ -60,8 +63,35 @@ class TopographyFile {
 
   zzip_dir *const dir;
 
+  /**
+   * The base name of the file, without directory and suffix.
+   */
+  const AllocatedString name;
+
   shapefileObj file;
 
+  /**
+   * The contents of the compiled topography file (*.xtp).  If this
+   * is defined, then #file is not used, and all #XShape objects are
+   * kept in #compiled_shapes.
+   */
+  CompiledTopography::Reader compiled;
+
+  AllocatedArray<XShape> compiled_shapes;
+
+#ifndef ENABLE_OPENGL
+  /**
+   * The points of all #compiled_shapes, converted to #GeoPoint.
+   */
+  AllocatedArray<GeoPoint> compiled_points;
+#endif
+
+  /**
+   * The indices of the compiled shapes which are currently in the
+   * linked list.  Used by UpdateCompiled().
+   */
+  std::vector<unsigned> compiled_visible, compiled_candidates;
+
   /**
    * The center of shapefileObj::bounds.
    */
@@ -103,9 +133,16 @@ class TopographyFile {
    */
   GeoBounds cache_bounds;
 
+  /**
+   * The area where all shapes have been loaded, i.e. a copy of
+   * #cache_bounds which is updated only after UpdateCache() has
+   * finished.  Protected by #mutex.
+   */
+  GeoBounds loaded_bounds;
+
 public:
   /**
-   * Protects #serial, #shapes, #first.
+   * Protects #serial, #shapes, #first, #loaded_bounds.
    * The caller is responsible for locking it.
    */
   mutable Mutex mutex;
@@ -160,6 +197,8 @@ public:
    * @param label_threshold the zoom threshold for label rendering
    * @param important_label_threshold labels below this zoom threshold will
    * be rendered in default style
+   * @param use_compiled use the compiled topography file (*.xtp)
+   * instead of the shapefile if there is one
    * @return
    */
   TopographyFile(zzip_dir *dir, const char *shpname,
@@ -169,7 +208,8 @@ public:
                  int label_field=-1,
                  ResourceId icon=ResourceId::Null(),
                  ResourceId big_icon=ResourceId::Null(),
-                 unsigned pen_width=1);
+                 unsigned pen_width=1,
+                 bool use_compiled=true);
 
   TopographyFile(const TopographyFile &) = delete;
 
@@ -182,6 +222,21 @@ public:
     return serial;
   }
 
+  const char *GetName() const {
+    return name.c_str();
+  }
+
+  /**
+   * Was this object loaded from a compiled topography file?
+   */
+  bool IsCompiled() const {
+    return compiled.IsDefined();
+  }
+
+  double GetScaleThreshold() const {
+    return scale_threshold;
+  }
+
   const GeoPoint &GetCenter() const {
     return center;
   }
@@ -271,11 +326,35 @@ public:
   unsigned GetMinimumPointDistance(unsigned level) const;
 #endif
 
+  /**
+   * Is this file visible in the given projection, but its cache does
+   * not cover the visible area?
+   */
+  gcc_pure
+  bool NeedsUpdate(const WindowProjection &map_projection) const;
+
+  /**
+   * Have all shapes visible in the given projection been loaded?
+   * Unlike NeedsUpdate(), this may be called by any thread while
+   * another one updates the cache.
+   */
+  gcc_pure
+  bool IsLoaded(const WindowProjection &map_projection) const;
+
   /**
    * @return true if new data from the topography file has been loaded
    */
   bool Update(const WindowProjection &map_projection);
 
+  /**
+   * Extend the cache so it covers the given bounds in addition to the
+   * visible area.  This is used to load shapes ahead of the aircraft.
+   *
+   * @return true if new data from the topography file has been loaded
+   */
+  bool Prefetch(const WindowProjection &map_projection,
+                const GeoBounds &bounds);
+
   /**
    * Load all shapes into memory.  For debugging purposes.
    */
@@ -283,6 +362,25 @@ public:
 
 protected:
   void ClearCache();
+
+private:
+  bool LoadCompiled(const char *shpname);
+
+  /**
+   * Load all shapes within #cache_bounds and discard all others.
+   */
+  bool UpdateCache();
+
+  void SetLoadedBounds(const GeoBounds &bounds) {
+    const std::lock_guard<Mutex> lock(mutex);
+    loaded_bounds = bounds;
+  }
+
+  /**
+   * Update the linked list from the tile index of the compiled
+   * topography file.
+   */
+  void UpdateCompiled(const GeoBounds &bounds);
 };
 
 #endif
@@ -127,6 +127,23 @@ TopographyStore::ScanVisibility(const WindowProjection &m_projection,
   return num_updated;
 }
 
+unsigned
+TopographyStore::Prefetch(const WindowProjection &m_projection,
+                          const GeoBounds &bounds, unsigned max_update)
+{
+  unsigned num_updated = 0;
+  for (auto *file : files) {
+    if (file->Prefetch(m_projection, bounds)) {
+      ++num_updated;
+      if (num_updated >= max_update)
+        break;
+    }
+  }
+
+  serial += num_updated;
+  return num_updated;
+}
+
 void
 TopographyStore::LoadAll()
 {
@@ -143,7 +160,8 @@ TopographyStore::~TopographyStore()
 
 void
 TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
-                      const TCHAR *directory, struct zzip_dir *zdir)
+                      const TCHAR *directory, struct zzip_dir *zdir,
+                      bool use_compiled)
 {
   Reset();
 
@@ -289,7 +307,7 @@ TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
                                               Color(red, green, blue),
 #endif
                                               shape_field, icon, big_icon,
-                                              pen_width);
+                                              pen_width, use_compiled);
     if (file->IsEmpty())
       // If the shape file could not be read -> skip this line/file
       delete file;
@@ -32,6 +32,7 @@ Copyright_License {
 
 class WindowProjection;
 class TopographyFile;
+class GeoBounds;
 class NLineReader;
 class OperationEnvironment;
 struct zzip_dir;
@@ -86,14 +87,31 @@ public:
   unsigned ScanVisibility(const WindowProjection &m_projection,
                           unsigned max_update=1024);
 
+  /**
+   * Extend the caches of all visible files to cover the given
+   * bounds, e.g. the area ahead of the aircraft.
+   *
+   * @param max_update the maximum number of files updated in this
+   * call
+   * @return the number of files which were updated
+   */
+  unsigned Prefetch(const WindowProjection &m_projection,
+                    const GeoBounds &bounds,
+                    unsigned max_update=1024);
+
   /**
    * Load all shapes of all files into memory.  For debugging
    * purposes.
    */
   void LoadAll();
 
+  /**
+   * @param use_compiled use compiled topography files (*.xtp) where
+   * available
+   */
   void Load(OperationEnvironment &operation, NLineReader &reader,
-            const TCHAR *directory, struct zzip_dir *zdir = nullptr);
+            const TCHAR *directory, struct zzip_dir *zdir = nullptr,
+            bool use_compiled=true);
   void Reset();
 };
 
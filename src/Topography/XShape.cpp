@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Topography/XShape.hpp"
+#include "Topography/CompiledTopography.hpp"
 #include "Convert.hpp"
 #include "util/StringAPI.hxx"
 #include "util/UTF8.hpp"
@@ -89,7 +90,7 @@ GetMinPointsForShapeType(int shapelib_type)
 
 XShape::XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
                int label_field)
-  :label(nullptr)
+  :label(nullptr), compiled(false)
 {
 #ifdef ENABLE_OPENGL
   std::fill_n(index_count, THINNING_LEVELS, nullptr);
@@ -167,8 +168,78 @@ XShape::XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
   }
 }
 
+XShape::XShape() noexcept
+  :type(MS_SHAPE_NULL), num_lines(0), points(nullptr), label(nullptr),
+   compiled(true)
+{
+#ifdef ENABLE_OPENGL
+  std::fill_n(index_count, THINNING_LEVELS, nullptr);
+  std::fill_n(indices, THINNING_LEVELS, nullptr);
+#endif
+}
+
+void
+#ifdef ENABLE_OPENGL
+XShape::Import(const CompiledTopography::Reader &reader, unsigned i)
+#else
+XShape::Import(const CompiledTopography::Reader &reader, unsigned i,
+               GeoPoint *_points)
+#endif
+{
+  assert(compiled);
+
+  const auto &src = reader.GetShape(i);
+
+  bounds = reader.GetShapeBounds(src);
+  type = src.type;
+  num_lines = std::min(unsigned(src.num_lines), MAX_LINES);
+  std::copy_n(reader.GetLines(src), num_lines, lines);
+
+#ifdef ENABLE_OPENGL
+  static_assert(sizeof(ShapePoint) == sizeof(CompiledTopography::Point),
+                "Incompatible ShapePoint layout");
+
+  /* OpenGL: use the points, the thinned lines and the triangulated
+     polygons in place */
+  points = const_cast<ShapePoint *>((const ShapePoint *)
+                                    reader.GetPoints(src));
+
+  for (unsigned level = 0; level < THINNING_LEVELS; ++level) {
+    const uint16_t *p = reader.GetIndices(src, level);
+    if (p == nullptr)
+      continue;
+
+    index_count[level] = const_cast<uint16_t *>(p);
+    indices[level] = index_count[level] +
+      (type == MS_SHAPE_POLYGON ? 1 : num_lines);
+  }
+#else
+  /* convert all points of all lines to GeoPoints */
+  const GeoPoint center = reader.GetCenter();
+  const auto *p = reader.GetPoints(src);
+  points = _points;
+  for (unsigned l = 0; l < num_lines; ++l) {
+    for (unsigned j = 0; j < lines[l]; ++j, ++p)
+      *_points++ = GeoPoint(center.longitude + Angle::Native(p->x),
+                            center.latitude + Angle::Native(p->y));
+  }
+#endif
+
+  const char *src_label = reader.GetLabel(src);
+  if (src_label != nullptr) {
+#ifdef _UNICODE
+    label = BasicAllocatedString<TCHAR>::Donate(ConvertUTF8ToWide(src_label));
+#else
+    label = BasicAllocatedString<TCHAR>(src_label);
+#endif
+  }
+}
+
 XShape::~XShape()
 {
+  if (compiled)
+    return;
+
   delete[] points;
 #ifdef ENABLE_OPENGL
   // Note: index_count and indices share one buffer
@@ -254,6 +325,10 @@ XShape::GetIndices(int thinning_level, ShapeScalar min_distance,
                    const uint16_t *&count) const
 {
   if (indices[thinning_level] == nullptr) {
+    if (compiled)
+      /* the compiler has already built all possible index sets */
+      return nullptr;
+
     XShape &deconst = const_cast<XShape &>(*this);
     if (!deconst.BuildIndices(thinning_level, min_distance))
       return nullptr;
@@ -38,11 +38,15 @@ Copyright_License {
 #include <cstdint>
 
 struct GeoPoint;
+namespace CompiledTopography { class Reader; }
 
 class XShape {
   static constexpr unsigned MAX_LINES = 32;
 #ifdef ENABLE_OPENGL
+public:
   static constexpr unsigned THINNING_LEVELS = 4;
+
+private:
 #endif
 
   GeoBounds bounds;
@@ -91,12 +95,37 @@ class XShape {
 
   BasicAllocatedString<TCHAR> label;
 
+  /**
+   * Was this object imported from a compiled topography file?  Then
+   * the points and the indices are not owned by this object.
+   */
+  bool compiled;
+
 public:
   XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
          int label_field=-1);
 
+  /**
+   * Create an empty shape; call Import() to fill it.
+   */
+  XShape() noexcept;
+
   XShape(const XShape &) = delete;
 
+  /**
+   * Import a shape from a compiled topography file, which must
+   * outlive this object.
+   *
+   * @param points the converted points of this shape (non-OpenGL
+   * only); the caller is responsible for freeing them
+   */
+#ifdef ENABLE_OPENGL
+  void Import(const CompiledTopography::Reader &reader, unsigned i);
+#else
+  void Import(const CompiledTopography::Reader &reader, unsigned i,
+              GeoPoint *points);
+#endif
+
   ~XShape();
 
 #ifdef ENABLE_OPENGL
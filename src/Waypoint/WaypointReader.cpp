@@ -32,9 +32,7 @@ Copyright_License {
 #include "io/ZipLineReader.hpp"
 #include "io/FileLineReader.hpp"
 
-#include <memory>
-
-static WaypointReaderBase *
+std::unique_ptr<WaypointReaderBase>
 CreateWaypointReader(WaypointFileType type, WaypointFactory factory)
 {
   switch (type) {
@@ -42,22 +40,22 @@ CreateWaypointReader(WaypointFileType type, WaypointFactory factory)
     break;
 
   case WaypointFileType::WINPILOT:
-    return new WaypointReaderWinPilot(factory);
+    return std::make_unique<WaypointReaderWinPilot>(factory);
 
   case WaypointFileType::SEEYOU:
-    return new WaypointReaderSeeYou(factory);
+    return std::make_unique<WaypointReaderSeeYou>(factory);
 
   case WaypointFileType::ZANDER:
-    return new WaypointReaderZander(factory);
+    return std::make_unique<WaypointReaderZander>(factory);
 
   case WaypointFileType::FS:
-    return new WaypointReaderFS(factory);
+    return std::make_unique<WaypointReaderFS>(factory);
 
   case WaypointFileType::OZI_EXPLORER:
-    return new WaypointReaderOzi(factory);
+    return std::make_unique<WaypointReaderOzi>(factory);
 
   case WaypointFileType::COMPE_GPS:
-    return new WaypointReaderCompeGPS(factory);
+    return std::make_unique<WaypointReaderCompeGPS>(factory);
   }
 
   return nullptr;
@@ -68,8 +66,7 @@ ReadWaypointFile(Path path, WaypointFileType file_type,
                  Waypoints &way_points,
                  WaypointFactory factory, OperationEnvironment &operation)
 try {
-  std::unique_ptr<WaypointReaderBase> reader(CreateWaypointReader(file_type,
-                                                                  factory));
+  auto reader = CreateWaypointReader(file_type, factory);
   if (!reader)
     return false;
 
@@ -93,8 +90,7 @@ ReadWaypointFile(struct zzip_dir *dir, const char *path,
                  WaypointFileType file_type, Waypoints &way_points,
                  WaypointFactory factory, OperationEnvironment &operation)
 try {
-  std::unique_ptr<WaypointReaderBase> reader(CreateWaypointReader(file_type,
-                                                                  factory));
+  auto reader = CreateWaypointReader(file_type, factory);
   if (!reader)
     return false;
 
@@ -26,14 +26,24 @@ Copyright_License {
 #define WAYPOINT_READER_HPP
 
 #include <cstdint>
+#include <memory>
 
 enum class WaypointFileType: uint8_t;
 struct zzip_dir;
 class Path;
 class Waypoints;
 class WaypointFactory;
+class WaypointReaderBase;
 class OperationEnvironment;
 
+/**
+ * Create a parser for the specified file type.
+ *
+ * @return nullptr if the file type is not supported
+ */
+std::unique_ptr<WaypointReaderBase>
+CreateWaypointReader(WaypointFileType type, WaypointFactory factory);
+
 bool
 ReadWaypointFile(Path path, WaypointFileType file_type,
                  Waypoints &way_points,
@@ -22,8 +22,88 @@ Copyright_License {
 */
 
 #include "WaypointReaderBase.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
 #include "Operation/Operation.hpp"
 #include "io/LineReader.hpp"
+#include "thread/Thread.hpp"
+#include "thread/Util.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <list>
+
+/**
+ * Files with fewer lines than this (after the header) are parsed
+ * sequentially; starting threads is not worth the overhead.
+ */
+static constexpr std::size_t MIN_LINES_PER_THREAD = 4096;
+
+/**
+ * Parses one range of lines with a private copy of the reader.
+ */
+class WaypointReaderBase::ChunkThread final : Thread {
+  const std::unique_ptr<WaypointReaderBase> reader;
+  const TCHAR *const*const begin, *const*const end;
+
+  std::exception_ptr error;
+
+public:
+  std::vector<Waypoint> waypoints;
+
+  ChunkThread(std::unique_ptr<WaypointReaderBase> &&_reader,
+              const TCHAR *const*_begin, const TCHAR *const*_end) noexcept
+    :Thread("WaypointReader"),
+     reader(std::move(_reader)), begin(_begin), end(_end) {}
+
+  /**
+   * Start the thread.  If that fails, the lines are parsed right
+   * here.
+   */
+  void Start() noexcept {
+    if (!Thread::Start())
+      Run();
+  }
+
+  /**
+   * Wait for the thread to finish.
+   *
+   * @return the exception thrown by the parser, if any
+   */
+  std::exception_ptr Finish() noexcept {
+    if (IsDefined())
+      Join();
+
+    return error;
+  }
+
+  /**
+   * Were all following lines to be ignored?  Only valid after
+   * Finish().
+   */
+  bool IsFinished() const noexcept {
+    return reader->IsFinished();
+  }
+
+protected:
+  void Run() noexcept override {
+    try {
+      reader->ParseLines(begin, end, waypoints);
+    } catch (...) {
+      error = std::current_exception();
+    }
+  }
+};
+
+void
+WaypointReaderBase::ParseLines(const TCHAR *const*begin,
+                               const TCHAR *const*end,
+                               std::vector<Waypoint> &waypoints)
+{
+  waypoints.reserve(waypoints.size() + (end - begin));
+
+  for (auto i = begin; i != end && !IsFinished(); ++i)
+    ParseLine(*i, waypoints);
+}
 
 void
 WaypointReaderBase::Parse(Waypoints &way_points, TLineReader &reader,
@@ -32,13 +112,118 @@ WaypointReaderBase::Parse(Waypoints &way_points, TLineReader &reader,
   const long filesize = std::max(reader.GetSize(), 1l);
   operation.SetProgressRange(100);
 
-  // Read through the lines of the file
-  TCHAR *line;
+  std::vector<Waypoint> waypoints;
+
+  /* parse the header sequentially, until the first waypoint has been
+     found; after that, the reader state (file format variant, column
+     layout) is known and can be passed to the worker threads */
+  TCHAR *line = nullptr;
+  while (waypoints.empty() && !IsFinished() &&
+         (line = reader.ReadLine()) != nullptr)
+    ParseLine(line, waypoints);
+
+  if (IsFinished() || line == nullptr) {
+    way_points.Append(std::move(waypoints));
+    return;
+  }
+
+  const unsigned n_threads = max_threads > 0
+    ? max_threads
+    : GetProcessorCount();
+  auto clone = n_threads > 1
+    ? Clone()
+    : nullptr;
+  if (!clone) {
+    /* single CPU, or this format does not support parallel parsing:
+       parse the rest of the file while reading it */
+    for (unsigned i = 0; (line = reader.ReadLine()) != nullptr; i++) {
+      ParseLine(line, waypoints);
+
+      if ((i & 0x3f) == 0)
+        operation.SetProgressPosition(reader.Tell() * 100 / filesize);
+    }
+
+    way_points.Append(std::move(waypoints));
+    return;
+  }
+
+  /* load the remaining lines into one buffer; this is a cheap
+     sequential pass (the character set conversion can't be split)
+     which keeps the parser threads busy afterwards */
+  std::vector<TCHAR> text;
+  std::vector<std::size_t> offsets;
   for (unsigned i = 0; (line = reader.ReadLine()) != nullptr; i++) {
-    // and parse them
-    ParseLine(line, way_points);
+    offsets.push_back(text.size());
+    text.insert(text.end(), line, line + _tcslen(line) + 1);
+
+    if ((i & 0x3ff) == 0)
+      operation.SetProgressPosition(reader.Tell() * 50 / filesize);
+  }
+
+  std::vector<const TCHAR *> lines;
+  lines.reserve(offsets.size());
+  for (const auto offset : offsets)
+    lines.push_back(text.data() + offset);
+
+  offsets.clear();
+  offsets.shrink_to_fit();
+
+  const TCHAR *const*const lines_end = lines.data() + lines.size();
+
+  const std::size_t n_chunks =
+    std::clamp<std::size_t>(lines.size() / MIN_LINES_PER_THREAD,
+                            1, n_threads);
+  const std::size_t chunk_size = (lines.size() + n_chunks - 1) / n_chunks;
+
+  /* the calling thread parses the first chunk itself */
+  const TCHAR *const*const first_end =
+    lines.data() + std::min(chunk_size, lines.size());
+
+  std::list<ChunkThread> threads;
+  for (auto i = first_end; i != lines_end;) {
+    const auto chunk_end =
+      i + std::min<std::size_t>(chunk_size, lines_end - i);
+
+    if (!clone)
+      clone = Clone();
+
+    threads.emplace_back(std::move(clone), i, chunk_end);
+    i = chunk_end;
+  }
+
+  for (auto &thread : threads)
+    thread.Start();
+
+  std::exception_ptr error;
+  try {
+    ParseLines(lines.data(), first_end, waypoints);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  operation.SetProgressPosition(50 + 50 / (threads.size() + 1));
+
+  for (auto &thread : threads) {
+    auto thread_error = thread.Finish();
+    if (thread_error && !error)
+      error = std::move(thread_error);
+  }
+
+  if (error)
+    std::rethrow_exception(error);
+
+  /* append the results in file order; each chunk becomes one
+     contiguous block in the Waypoints container */
+  bool finished = IsFinished();
+  way_points.Append(std::move(waypoints));
+
+  for (auto &thread : threads) {
+    if (finished)
+      /* a previous chunk has reached the end of the waypoint
+         section */
+      break;
 
-    if ((i & 0x3f) == 0)
-      operation.SetProgressPosition(reader.Tell() * 100 / filesize);
+    way_points.Append(std::move(thread.waypoints));
+    finished = thread.IsFinished();
   }
 }
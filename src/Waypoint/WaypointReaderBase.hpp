@@ -27,6 +27,9 @@ Copyright_License {
 
 #include "Factory.hpp"
 
+#include <memory>
+#include <vector>
+
 #include <tchar.h>
 
 class Waypoints;
@@ -35,6 +38,14 @@ class OperationEnvironment;
 
 class WaypointReaderBase 
 {
+  class ChunkThread;
+
+  /**
+   * The maximum number of threads used by Parse(); 0 means one per
+   * CPU core.
+   */
+  unsigned max_threads = 0;
+
 protected:
   const WaypointFactory factory;
 
@@ -45,6 +56,10 @@ protected:
 public:
   virtual ~WaypointReaderBase() {}
 
+  void SetMaxThreads(unsigned _max_threads) {
+    max_threads = _max_threads;
+  }
+
   /**
    * Parses a waypoint file into the given waypoint list
    * @param way_points The waypoint list to fill
@@ -54,15 +69,38 @@ public:
              OperationEnvironment &operation);
 
 protected:
+  /**
+   * Create a copy of this object, including the state collected from
+   * the lines parsed so far, which parses a range of the remaining
+   * lines on another thread.  This is called after the first waypoint
+   * has been parsed, i.e. after the file header.
+   *
+   * @return nullptr if the file must be parsed sequentially
+   */
+  virtual std::unique_ptr<WaypointReaderBase> Clone() const {
+    return nullptr;
+  }
+
+  /**
+   * Shall all following lines be ignored?
+   */
+  virtual bool IsFinished() const {
+    return false;
+  }
+
   /**
    * Parse a file line
    * @param line The line to parse
-   * @param linenum The line number in the file
-   * @param way_points The waypoint list to fill
+   * @param waypoints The list to append new waypoints to
    * @return True if the line was parsed correctly or ignored, False if
    * parsing error occured
    */
-  virtual bool ParseLine(const TCHAR* line, Waypoints &way_points) = 0;
+  virtual bool ParseLine(const TCHAR* line,
+                         std::vector<Waypoint> &waypoints) = 0;
+
+private:
+  void ParseLines(const TCHAR *const*begin, const TCHAR *const*end,
+                  std::vector<Waypoint> &waypoints);
 };
 
 #endif
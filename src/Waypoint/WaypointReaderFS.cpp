@@ -22,9 +22,9 @@ Copyright_License {
 */
 
 #include "WaypointReaderFS.hpp"
-#include "Waypoint/Waypoints.hpp"
 #include "Geo/UTM.hpp"
 #include "io/LineReader.hpp"
+#include "util/StringCompare.hxx"
 
 #include <stdlib.h>
 
@@ -145,7 +145,8 @@ ParseString(const TCHAR *src, tstring &dest, unsigned len = 0)
 }
 
 bool
-WaypointReaderFS::ParseLine(const TCHAR *line, Waypoints &way_points)
+WaypointReaderFS::ParseLine(const TCHAR *line,
+                           std::vector<Waypoint> &waypoints)
 {
   //$FormatGEO
   //ACONCAGU  S 32 39 12.00    W 070 00 42.00  6962  Aconcagua
@@ -195,7 +196,7 @@ WaypointReaderFS::ParseLine(const TCHAR *line, Waypoints &way_points)
   if (len > (is_utm ? 38 : 47))
     ParseString(line + (is_utm ? 38 : 47), new_waypoint.comment);
 
-  way_points.Append(std::move(new_waypoint));
+  waypoints.emplace_back(std::move(new_waypoint));
   return true;
 }
 
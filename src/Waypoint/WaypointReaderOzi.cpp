@@ -22,12 +22,12 @@ Copyright_License {
 */
 
 #include "WaypointReaderOzi.hpp"
-#include "Waypoint/Waypoints.hpp"
 #include "io/LineReader.hpp"
 #include "Units/System.hpp"
 #include "util/Macros.hpp"
 #include "util/ExtractParameters.hpp"
 #include "util/StringStrip.hxx"
+#include "util/StringCompare.hxx"
 
 #include <stdlib.h>
 
@@ -68,7 +68,8 @@ ParseString(const TCHAR *src, tstring &dest)
 }
 
 bool
-WaypointReaderOzi::ParseLine(const TCHAR *line, Waypoints &way_points)
+WaypointReaderOzi::ParseLine(const TCHAR *line,
+                            std::vector<Waypoint> &waypoints)
 {
   if (line[0] == '\0')
     return true;
@@ -122,7 +123,7 @@ WaypointReaderOzi::ParseLine(const TCHAR *line, Waypoints &way_points)
   // Description
   ParseString(params[10], new_waypoint.comment);
 
-  way_points.Append(std::move(new_waypoint));
+  waypoints.emplace_back(std::move(new_waypoint));
   return true;
 }
 
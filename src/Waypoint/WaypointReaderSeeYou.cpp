@@ -23,9 +23,9 @@ Copyright_License {
 
 #include "WaypointReaderSeeYou.hpp"
 #include "Units/System.hpp"
-#include "Waypoint/Waypoints.hpp"
 #include "util/ExtractParameters.hpp"
 #include "util/Macros.hpp"
+#include "util/StringCompare.hxx"
 
 #include <stdlib.h>
 
@@ -160,7 +160,8 @@ ParseStyle(const TCHAR* src, Waypoint::Type &type)
 }
 
 bool
-WaypointReaderSeeYou::ParseLine(const TCHAR* line, Waypoints &waypoints)
+WaypointReaderSeeYou::ParseLine(const TCHAR *line,
+                               std::vector<Waypoint> &waypoints)
 {
   enum {
     iName = 0,
@@ -291,6 +292,6 @@ WaypointReaderSeeYou::ParseLine(const TCHAR* line, Waypoints &waypoints)
     new_waypoint.comment = params[iDescription];
   }
 
-  waypoints.Append(std::move(new_waypoint));
+  waypoints.emplace_back(std::move(new_waypoint));
   return true;
 }
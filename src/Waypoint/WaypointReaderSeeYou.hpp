@@ -48,7 +48,16 @@ public:
 
 protected:
   /* virtual methods from class WaypointReaderBase */
-  bool ParseLine(const TCHAR* line, Waypoints &way_points) override;
+  std::unique_ptr<WaypointReaderBase> Clone() const override {
+    return std::make_unique<WaypointReaderSeeYou>(*this);
+  }
+
+  bool IsFinished() const override {
+    return ignore_following;
+  }
+
+  bool ParseLine(const TCHAR *line,
+                 std::vector<Waypoint> &waypoints) override;
 };
 
 #endif
@@ -23,7 +23,6 @@ Copyright_License {
 
 #include "WaypointReaderWinPilot.hpp"
 #include "Units/System.hpp"
-#include "Waypoint/Waypoints.hpp"
 #include "util/ExtractParameters.hpp"
 #include "util/StringAPI.hxx"
 #include "util/NumberParser.hpp"
@@ -188,7 +187,8 @@ ParseFlags(const TCHAR* src, Waypoint &dest)
 }
 
 bool
-WaypointReaderWinPilot::ParseLine(const TCHAR *line, Waypoints &waypoints)
+WaypointReaderWinPilot::ParseLine(const TCHAR *line,
+                                 std::vector<Waypoint> &waypoints)
 {
   TCHAR ctemp[4096];
   const TCHAR *params[20];
@@ -211,6 +211,11 @@ WaypointReaderWinPilot::ParseLine(const TCHAR *line, Waypoints &waypoints)
     return true;
   }
 
+  /* the WELT2000 banner is only recognized before the first
+     waypoint; this keeps the format of all lines parsed in parallel
+     consistent */
+  first = false;
+
   if (_tcslen(line) >= ARRAY_SIZE(ctemp))
     /* line too long for buffer */
     return false;
@@ -254,6 +259,6 @@ WaypointReaderWinPilot::ParseLine(const TCHAR *line, Waypoints &waypoints)
   // Waypoint Flags (e.g. AT)
   ParseFlags(params[4], new_waypoint);
 
-  waypoints.Append(std::move(new_waypoint));
+  waypoints.emplace_back(std::move(new_waypoint));
   return true;
 }
@@ -40,7 +40,12 @@ public:
 
 protected:
   /* virtual methods from class WaypointReaderBase */
-  bool ParseLine(const TCHAR *line, Waypoints &way_points) override;
+  std::unique_ptr<WaypointReaderBase> Clone() const override {
+    return std::make_unique<WaypointReaderWinPilot>(*this);
+  }
+
+  bool ParseLine(const TCHAR *line,
+                 std::vector<Waypoint> &waypoints) override;
 };
 
 #endif
@@ -24,13 +24,14 @@ Copyright_License {
 #include "RaspCache.hpp"
 #include "RaspStore.hpp"
 #include "Terrain/RasterMap.hpp"
-#include "Terrain/Loader.hpp"
 #include "Language/Language.hpp"
-#include "system/Path.hpp"
+#include "Operation/Operation.hpp"
 #include "io/ZipArchive.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
 
 #include <cassert>
-#include <windef.h> // for MAX_PATH
 
 static constexpr unsigned
 ToHalfHours(BrokenTime t)
@@ -38,6 +39,34 @@ ToHalfHours(BrokenTime t)
   return t.hour * 2u + t.minute / 30;
 }
 
+RaspCache::Slot::Slot() noexcept
+  :time(RaspStore::MAX_WEATHER_TIMES) {}
+
+RaspCache::Slot::Slot(unsigned _time,
+                      std::unique_ptr<RasterMap> &&_map) noexcept
+  :time(_time), map(std::move(_map)) {}
+
+RaspCache::Slot::Slot(Slot &&) noexcept = default;
+RaspCache::Slot::~Slot() noexcept = default;
+
+RaspCache::Slot &
+RaspCache::Slot::operator=(Slot &&) noexcept = default;
+
+RaspCache::RaspCache(const RaspStore &_store, unsigned _parameter,
+                     std::function<void()> &&_callback) noexcept
+  :StandbyThread("RASP"),
+   store(_store), parameter(_parameter),
+   callback(std::move(_callback)),
+   map_time(RaspStore::MAX_WEATHER_TIMES),
+   loading(RaspStore::MAX_WEATHER_TIMES) {}
+
+RaspCache::~RaspCache() noexcept
+{
+  /* this does not wait for the map being decoded, because the
+     decoder checks IsStopped() (see CancelOperationEnvironment) */
+  LockStop();
+}
+
 const TCHAR *
 RaspCache::GetMapName() const
 {
@@ -68,15 +97,144 @@ RaspCache::GetTime() const
     : RaspStore::IndexToTime(time);
 }
 
+BrokenTime
+RaspCache::GetMapTime() const
+{
+  return map_time < RaspStore::MAX_WEATHER_TIMES
+    ? RaspStore::IndexToTime(map_time)
+    : BrokenTime::Invalid();
+}
+
 bool
 RaspCache::IsInside(GeoPoint p) const
 {
   return map != nullptr && map->IsInside(p);
 }
 
+RaspCache::Slot *
+RaspCache::FindSlot(unsigned t) noexcept
+{
+  for (auto &slot : slots)
+    if (slot.time == t)
+      return &slot;
+
+  return nullptr;
+}
+
+void
+RaspCache::CollectFinished() noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+
+  for (auto &i : finished) {
+    if (FindSlot(i.time) != nullptr)
+      continue;
+
+    /* evict the least recently used slot, but never the one being
+       displayed */
+    Slot *victim = nullptr;
+    for (auto &slot : slots) {
+      if (slot.time == RaspStore::MAX_WEATHER_TIMES) {
+        victim = &slot;
+        break;
+      }
+
+      if (slot.time != map_time &&
+          (victim == nullptr || slot.last_used < victim->last_used))
+        victim = &slot;
+    }
+
+    assert(victim != nullptr);
+
+    *victim = std::move(i);
+    victim->last_used = ++use_counter;
+  }
+
+  finished.clear();
+}
+
+/**
+ * Find the next available time index after the given one.  Returns
+ * RaspStore::MAX_WEATHER_TIMES if there is none.
+ */
+gcc_pure
+static unsigned
+FindNextTime(const RaspStore &store, unsigned parameter, unsigned t) noexcept
+{
+  while (++t < RaspStore::MAX_WEATHER_TIMES)
+    if (store.IsTimeAvailable(parameter, t))
+      return t;
+
+  return RaspStore::MAX_WEATHER_TIMES;
+}
+
+/**
+ * Find the previous available time index before the given one.
+ * Returns RaspStore::MAX_WEATHER_TIMES if there is none.
+ */
+gcc_pure
+static unsigned
+FindPreviousTime(const RaspStore &store, unsigned parameter,
+                 unsigned t) noexcept
+{
+  while (t-- > 0)
+    if (store.IsTimeAvailable(parameter, t))
+      return t;
+
+  return RaspStore::MAX_WEATHER_TIMES;
+}
+
 void
-RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
+RaspCache::Request(unsigned t) noexcept
 {
+  /* the selected time first, then the next one, the previous one and
+     the one after the next one, because stepping forward is more
+     common */
+  StaticArray<unsigned, 4> wanted;
+  wanted.push_back(t);
+
+  const unsigned next = FindNextTime(store, parameter, t);
+  if (next != RaspStore::MAX_WEATHER_TIMES)
+    wanted.push_back(next);
+
+  const unsigned previous = FindPreviousTime(store, parameter, t);
+  if (previous != RaspStore::MAX_WEATHER_TIMES)
+    wanted.push_back(previous);
+
+  if (next != RaspStore::MAX_WEATHER_TIMES) {
+    const unsigned after_next = FindNextTime(store, parameter, next);
+    if (after_next != RaspStore::MAX_WEATHER_TIMES)
+      wanted.push_back(after_next);
+  }
+
+  const std::lock_guard<Mutex> lock(mutex);
+
+  requests.clear();
+  for (const unsigned i : wanted) {
+    Slot *slot = FindSlot(i);
+    if (slot != nullptr) {
+      /* protect it from eviction */
+      slot->last_used = ++use_counter;
+      continue;
+    }
+
+    if (i == loading ||
+        std::any_of(finished.begin(), finished.end(),
+                    [i](const Slot &s){ return s.time == i; }))
+      continue;
+
+    requests.push_back(i);
+  }
+
+  if (!requests.empty())
+    Trigger();
+}
+
+void
+RaspCache::Reload(BrokenTime time_local)
+{
+  CollectFinished();
+
   unsigned effective_time = time;
   if (effective_time == 0) {
     // "Now" time, so find time in half hours
@@ -89,42 +247,94 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
     assert(effective_time < RaspStore::MAX_WEATHER_TIMES);
   }
 
-  if (effective_time == last_time)
-    // no change, quick exit.
-    return;
-
-  last_time = effective_time;
-
   effective_time = store.GetNearestTime(parameter, effective_time);
   if (effective_time == RaspStore::MAX_WEATHER_TIMES)
     return;
 
-  Close();
+  if (effective_time != map_time) {
+    Slot *slot = FindSlot(effective_time);
+    if (slot != nullptr) {
+      slot->last_used = ++use_counter;
+      map = slot->map.get();
+      map_time = effective_time;
+    }
 
-  auto archive = store.OpenArchive();
-  if (!archive)
+    /* else: keep displaying the previous map until the background
+       thread has finished decoding */
+  }
+
+  if (effective_time == last_time)
+    // no change, quick exit.
     return;
 
-  char new_name[MAX_PATH];
-  store.NarrowWeatherFilename(new_name, Path(store.GetItemInfo(parameter).name),
-                              effective_time);
+  last_time = effective_time;
+  Request(effective_time);
+}
 
-  RasterMap *new_map = new RasterMap();
-  if (!LoadTerrainOverview(archive->get(), new_name, nullptr,
-                           new_map->GetTileCache(),
-                           true, operation)) {
-    delete new_map;
-    return;
-  }
+/**
+ * Cancels the map decoder as soon as the thread is asked to stop.
+ */
+class RaspCache::CancelOperationEnvironment final
+  : public NullOperationEnvironment {
+  RaspCache &cache;
 
-  new_map->UpdateProjection();
+public:
+  explicit CancelOperationEnvironment(RaspCache &_cache) noexcept
+    :cache(_cache) {}
 
-  map = new_map;
+  /* virtual methods from class OperationEnvironment */
+  bool IsCancelled() const override {
+    const std::lock_guard<Mutex> lock(cache.mutex);
+    return cache.IsStopped();
+  }
+};
+
+void
+RaspCache::OnThreadStart() noexcept
+{
+  SetLowPriority();
 }
 
 void
-RaspCache::Close()
+RaspCache::Tick() noexcept
 {
-  delete map;
-  map = nullptr;
+  std::unique_ptr<ZipArchive> archive;
+
+  while (!requests.empty() && !IsStopped()) {
+    const unsigned t = requests.front();
+    requests.remove(0);
+    loading = t;
+
+    std::unique_ptr<RasterMap> new_map;
+
+    {
+      const ScopeUnlock unlock(mutex);
+
+      try {
+        if (!archive)
+          archive = store.OpenArchive();
+
+        CancelOperationEnvironment operation(*this);
+        new_map = store.LoadMap(*archive, parameter, t, operation);
+      } catch (...) {
+        LogError(std::current_exception(), "Failed to load RASP map");
+      }
+    }
+
+    loading = RaspStore::MAX_WEATHER_TIMES;
+
+    if (IsStopped())
+      /* the decoder may have been cancelled, and nobody is
+         interested in the result anymore */
+      break;
+
+    /* a failed map is stored, too, so it is not retried over and
+       over */
+    finished.emplace_back(t, std::move(new_map));
+
+    if (callback) {
+      const ScopeUnlock unlock(mutex);
+      callback();
+    }
+  }
 }
@@ -24,40 +24,121 @@ Copyright_License {
 #ifndef XCSOAR_WEATHER_RASP_CACHE_HPP
 #define XCSOAR_WEATHER_RASP_CACHE_HPP
 
+#include "thread/StandbyThread.hpp"
+#include "util/StaticArray.hxx"
 #include "util/Compiler.h"
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include <tchar.h>
 
 struct BrokenTime;
 struct GeoPoint;
 class RaspStore;
 class RasterMap;
-class OperationEnvironment;
 
 /**
  * Class to manage the raster weather map, to be loaded/selected from
  * a #RaspStore instance.
+ *
+ * Maps are decoded by a background thread into a small
+ * least-recently-used cache of time slices.  The neighbouring time
+ * steps of the selected one are prefetched, so stepping through the
+ * forecast does not need to wait for the decoder.
+ *
+ * Except for the background thread, all methods must be called from
+ * the same thread.
  */
-class RaspCache {
+class RaspCache final : private StandbyThread {
+  class CancelOperationEnvironment;
+
+  /**
+   * The number of decoded time slices kept in memory.
+   */
+  static constexpr unsigned MAX_SLOTS = 6;
+
+  struct Slot {
+    /**
+     * The time index or RaspStore::MAX_WEATHER_TIMES if this slot is
+     * empty.
+     */
+    unsigned time;
+
+    /**
+     * The decoded map; nullptr if decoding has failed.
+     */
+    std::unique_ptr<RasterMap> map;
+
+    /**
+     * The value of #use_counter when this slot was last used.
+     */
+    unsigned last_used;
+
+    Slot() noexcept;
+    Slot(unsigned _time, std::unique_ptr<RasterMap> &&_map) noexcept;
+    Slot(Slot &&) noexcept;
+    ~Slot() noexcept;
+
+    Slot &operator=(Slot &&) noexcept;
+  };
+
   const RaspStore &store;
 
   const unsigned parameter;
 
+  /**
+   * Called by the background thread each time a map has been
+   * decoded.
+   */
+  const std::function<void()> callback;
+
   unsigned time = 0;
   unsigned last_time = 0;
 
-  RasterMap *map = nullptr;
+  std::array<Slot, MAX_SLOTS> slots;
+
+  unsigned use_counter = 0;
+
+  /**
+   * The map being displayed, pointing into #slots.
+   */
+  const RasterMap *map = nullptr;
+
+  /**
+   * The time index of #map or RaspStore::MAX_WEATHER_TIMES.
+   */
+  unsigned map_time;
+
+  /**
+   * Time indexes which shall be decoded, the most important one
+   * first.  Protected by StandbyThread::mutex.
+   */
+  StaticArray<unsigned, 4> requests;
+
+  /**
+   * The time index being decoded right now or
+   * RaspStore::MAX_WEATHER_TIMES.  Protected by StandbyThread::mutex.
+   */
+  unsigned loading;
+
+  /**
+   * Maps which have been decoded, but have not yet been moved to
+   * #slots.  Protected by StandbyThread::mutex.
+   */
+  std::vector<Slot> finished;
 
 public:
-  /** 
-   * Default constructor
+  /**
+   * @param _callback a function that is invoked by the background
+   * thread after a map has been decoded; may be empty
    */
-  RaspCache(const RaspStore &_store, unsigned _parameter)
-    :store(_store), parameter(_parameter) {}
+  RaspCache(const RaspStore &_store, unsigned _parameter,
+            std::function<void()> &&_callback={}) noexcept;
 
-  ~RaspCache() {
-    Close();
-  }
+  ~RaspCache() noexcept;
 
   const RaspStore &GetStore() const {
     return store;
@@ -93,9 +174,15 @@ public:
   bool IsInside(GeoPoint p) const;
 
   /**
-   * @param day_time the local time, in seconds since midnight
+   * Select the map for the current time index.  If it has not been
+   * decoded yet, this schedules it (and its neighbours) for the
+   * background thread and keeps the previous map until it is ready;
+   * call this method again after the callback has been invoked.
+   *
+   * @param time_local the local time, used if no explicit time index
+   * has been set
    */
-  void Reload(BrokenTime time_local, OperationEnvironment &operation);
+  void Reload(BrokenTime time_local);
 
   /**
    * Returns the current time index.
@@ -108,8 +195,32 @@ public:
    */
   void SetTime(BrokenTime t);
 
+  /**
+   * Returns the time of the map returned by GetMap().  This may
+   * differ from GetTime() while the selected map is still being
+   * decoded.
+   */
+  gcc_pure
+  BrokenTime GetMapTime() const;
+
 private:
-  void Close();
+  gcc_pure
+  Slot *FindSlot(unsigned t) noexcept;
+
+  /**
+   * Move maps from #finished to #slots, evicting the least recently
+   * used ones.
+   */
+  void CollectFinished() noexcept;
+
+  /**
+   * Schedule the given time index and its neighbours for decoding.
+   */
+  void Request(unsigned t) noexcept;
+
+  /* virtual methods from class StandbyThread */
+  void OnThreadStart() noexcept override;
+  void Tick() noexcept override;
 };
 
 #endif
@@ -46,8 +46,13 @@ class RaspRenderer {
   const ColorRamp *last_color_ramp = nullptr;
 
 public:
-  RaspRenderer(const RaspStore &_store, unsigned parameter)
-    :cache(_store, parameter) {}
+  /**
+   * @param callback invoked by a background thread after a map has
+   * been decoded; see #RaspCache
+   */
+  RaspRenderer(const RaspStore &_store, unsigned parameter,
+               std::function<void()> &&callback={})
+    :cache(_store, parameter, std::move(callback)) {}
 
   /**
    * Flush the cache.
@@ -82,8 +87,8 @@ public:
     cache.SetTime(t);
   }
 
-  void Update(BrokenTime time_local, OperationEnvironment &operation) {
-    cache.Reload(time_local, operation);
+  void Update(BrokenTime time_local) {
+    cache.Reload(time_local);
   }
 
   /**
@@ -24,6 +24,8 @@ Copyright_License {
 #include "RaspStore.hpp"
 #include "Language/Language.hpp"
 #include "Units/Units.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
 #include "system/ConvertPathName.hpp"
 #include "system/Path.hpp"
 #include "io/ZipArchive.hpp"
@@ -145,6 +147,28 @@ RaspStore::OpenArchive() const
   return std::make_unique<ZipArchive>(path);
 }
 
+std::unique_ptr<RasterMap>
+RaspStore::LoadMap(ZipArchive &archive, unsigned item_index,
+                   unsigned time_index,
+                   OperationEnvironment &operation) const
+{
+  assert(item_index < maps.size());
+  assert(time_index < MAX_WEATHER_TIMES);
+
+  char name[MAX_PATH];
+  if (!NarrowWeatherFilename(name, Path(maps[item_index].name), time_index))
+    return nullptr;
+
+  auto map = std::make_unique<RasterMap>();
+  if (!LoadTerrainOverview(archive.get(), name, nullptr,
+                           map->GetTileCache(),
+                           true, operation))
+    return nullptr;
+
+  map->UpdateProjection();
+  return map;
+}
+
 bool
 RaspStore::ExistsItem(const ZipArchive &archive, Path name, unsigned time_index)
 {
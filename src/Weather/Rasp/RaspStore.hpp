@@ -40,6 +40,7 @@ Copyright_License {
 class Path;
 class RasterMap;
 class ZipArchive;
+class OperationEnvironment;
 struct GeoPoint;
 
 /**
@@ -149,6 +150,18 @@ public:
 
   std::unique_ptr<ZipArchive> OpenArchive() const;
 
+  /**
+   * Decode the map of one parameter at one time index.  This may
+   * take a while; it does not access any mutable attribute and may
+   * be called from any thread.
+   *
+   * @return the map or nullptr on error
+   */
+  std::unique_ptr<RasterMap> LoadMap(ZipArchive &archive,
+                                     unsigned item_index,
+                                     unsigned time_index,
+                                     OperationEnvironment &operation) const;
+
   static bool NarrowWeatherFilename(char *filename, Path name,
                                     unsigned time_index);
 
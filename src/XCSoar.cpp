@@ -75,6 +75,10 @@ static const char *const Usage = "\n"
   "  -portrait       use a 480x640 screen resolution\n"
   "  -square         use a 480x480 screen resolution\n"
   "  -small          use a 320x240 screen resolution\n"
+  "  -latency-trace=FILE  write latency trace events to FILE on exit\n"
+#ifdef HAVE_CMDLINE_INSTRUMENT
+  "  -instrument=FILE  write hot path timings to FILE on exit\n"
+#endif
 #if !defined(ANDROID)
   "  -dpi=DPI        force usage of DPI for pixel density\n"
   "  -dpi=XDPIxYDPI  force usage of XDPI and YDPI for pixel density\n"
@@ -23,6 +23,8 @@ Copyright_License {
 
 #include "CSVLine.hpp"
 #include "util/StringAPI.hxx"
+#include "util/CharUtil.hxx"
+#include "util/DecimalParser.hpp"
 
 #include <algorithm>
 
@@ -35,6 +37,69 @@ EndOfLine(const char *line)
   return line + strlen(line);
 }
 
+/**
+ * Parse a decimal number like strtod(), with a fast path for plain
+ * numbers (which is what NMEA fields contain), see
+ * ParsePlainDecimal().
+ */
+static double
+ParseDecimal(const char *p, char **endptr)
+{
+  const char *end;
+  double value;
+  if (!ParsePlainDecimal(p, &end, value))
+    return strtod(p, endptr);
+
+  *endptr = const_cast<char *>(end);
+  return value;
+}
+
+/**
+ * Parse a decimal integer like strtol(), with a fast path for plain
+ * numbers which cannot overflow.
+ */
+static long
+ParseDecimalLong(const char *p, char **endptr)
+{
+  const char *s = p;
+
+  const bool negative = *s == '-';
+  if (negative || *s == '+')
+    ++s;
+
+  long value = 0;
+  unsigned n_digits = 0;
+  for (; IsDigitASCII(*s); ++s, ++n_digits)
+    value = value * 10 + (*s - '0');
+
+  if (n_digits == 0 || n_digits > 9)
+    return strtol(p, endptr, 10);
+
+  *endptr = const_cast<char *>(s);
+  return negative ? -value : value;
+}
+
+/**
+ * Parse a decimal integer like strtoul(), with a fast path for plain
+ * numbers which cannot overflow.
+ */
+static unsigned long
+ParseDecimalUnsignedLong(const char *p, char **endptr)
+{
+  const char *s = p;
+
+  unsigned long value = 0;
+  unsigned n_digits = 0;
+  for (; IsDigitASCII(*s); ++s, ++n_digits)
+    value = value * 10 + (*s - '0');
+
+  if (n_digits == 0 || n_digits > 9)
+    return strtoul(p, endptr, 10);
+
+  *endptr = const_cast<char *>(s);
+  return value;
+}
+
 CSVLine::CSVLine(const char *line):
   data(line), end(EndOfLine(line)) {}
 
@@ -127,7 +192,7 @@ bool
 CSVLine::ReadChecked(double &value_r)
 {
   char *endptr;
-  double value = strtod(data, &endptr);
+  double value = ParseDecimal(data, &endptr);
   assert(endptr >= data && endptr <= end);
 
   bool success = endptr > data;
@@ -161,7 +226,7 @@ bool
 CSVLine::ReadChecked(long &value_r)
 {
   char *endptr;
-  long value = strtol(data, &endptr, 10);
+  long value = ParseDecimalLong(data, &endptr);
   assert(endptr >= data && endptr <= end);
 
   bool success = endptr > data;
@@ -207,7 +272,7 @@ bool
 CSVLine::ReadChecked(unsigned long &value_r)
 {
   char *endptr;
-  unsigned long value = strtoul(data, &endptr, 10);
+  unsigned long value = ParseDecimalUnsignedLong(data, &endptr);
   assert(endptr >= data && endptr <= end);
 
   bool success = endptr > data;
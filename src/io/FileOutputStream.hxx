@@ -136,6 +136,12 @@ public:
 	/* virtual methods from class OutputStream */
 	void Write(const void *data, size_t size) override;
 
+	/**
+	 * Wait until all data written so far has been stored on the
+	 * device, so it survives a power failure.
+	 */
+	void Sync();
+
 	void Commit();
 	void Cancel() noexcept;
 
@@ -22,72 +22,157 @@ Copyright_License {
 */
 
 #include "Blackboard.hpp"
+#include "FieldIndex.hpp"
 #include "Geo.hpp"
 #include "Util.hxx"
-#include "util/StringAPI.hxx"
 #include "Interface.hpp"
 
+#include <iterator>
+
 namespace Lua {
 
 template<typename V>
-static void PushOptional(lua_State *L, bool available, V &&value) {
-  if (available)
-    Push(L, value);
-  else
-    lua_pushnil(L);
+static bool PushOptional(lua_State *L, bool available, V &&value) {
+  if (!available)
+    return false;
+
+  Push(L, value);
+  return true;
+}
+
 }
 
+enum class BlackboardField {
+  LOCATION,
+  ALTITUDE,
+  TRACK,
+  GROUND_SPEED,
+  AIR_SPEED,
+  BANK_ANGLE,
+  PITCH_ANGLE,
+  HEADING,
+  G_LOAD,
+  STATIC_PRESSURE,
+  PITOT_PRESSURE,
+  DYNAMIC_PRESSURE,
+  TEMPERATURE,
+  HUMIDITY,
+  VOLTAGE,
+  BATTERY_LEVEL,
+  NONCOMP_VARIO,
+  TOTAL_ENERGY_VARIO,
+  NETTO_VARIO,
+  COUNT,
+};
+
+static constexpr const char *blackboard_field_names[] = {
+  "location",
+  "altitude",
+  "track",
+  "ground_speed",
+  "air_speed",
+  "bank_angle",
+  "pitch_angle",
+  "heading",
+  "g_load",
+  "static_pressure",
+  "pitot_pressure",
+  "dynamic_pressure",
+  "temperature",
+  "humidity",
+  "voltage",
+  "battery_level",
+  "noncomp_vario",
+  "total_energy_vario",
+  "netto_vario",
+};
+
+static_assert(std::size(blackboard_field_names) == unsigned(BlackboardField::COUNT),
+              "Wrong number of blackboard field names");
+
+/**
+ * Push the value of the specified field.
+ *
+ * @return false if the value is not available (and nothing was
+ * pushed)
+ */
+static bool
+PushBlackboardField(lua_State *L, const MoreData &basic, int field)
+{
+  using Lua::PushOptional;
+
+  switch (BlackboardField(field)) {
+  case BlackboardField::LOCATION:
+    return PushOptional(L, basic.location_available, basic.location);
+  case BlackboardField::ALTITUDE:
+    return PushOptional(L, basic.NavAltitudeAvailable(), basic.nav_altitude);
+  case BlackboardField::TRACK:
+    return PushOptional(L, basic.track_available, basic.track);
+  case BlackboardField::GROUND_SPEED:
+    return PushOptional(L, basic.ground_speed_available, basic.ground_speed);
+  case BlackboardField::AIR_SPEED:
+    return PushOptional(L, basic.airspeed_available, basic.true_airspeed);
+  case BlackboardField::BANK_ANGLE:
+    return PushOptional(L, basic.attitude.IsBankAngleUseable(), basic.attitude.bank_angle);
+  case BlackboardField::PITCH_ANGLE:
+    return PushOptional(L, basic.attitude.IsPitchAngleUseable(), basic.attitude.pitch_angle);
+  case BlackboardField::HEADING:
+    return PushOptional(L, basic.attitude.IsHeadingUseable(), basic.attitude.heading);
+  case BlackboardField::G_LOAD:
+    return PushOptional(L, basic.acceleration.available, basic.acceleration.g_load);
+  case BlackboardField::STATIC_PRESSURE:
+    return PushOptional(L, basic.static_pressure_available, basic.static_pressure.GetPascal());
+  case BlackboardField::PITOT_PRESSURE:
+    return PushOptional(L, basic.pitot_pressure_available, basic.pitot_pressure.GetPascal());
+  case BlackboardField::DYNAMIC_PRESSURE:
+    return PushOptional(L, basic.dyn_pressure_available, basic.dyn_pressure.GetPascal());
+  case BlackboardField::TEMPERATURE:
+    return PushOptional(L, basic.temperature_available,
+                        basic.temperature.ToKelvin());
+  case BlackboardField::HUMIDITY:
+    return PushOptional(L, basic.humidity_available, basic.humidity);
+  case BlackboardField::VOLTAGE:
+    return PushOptional(L, basic.voltage_available, basic.voltage);
+  case BlackboardField::BATTERY_LEVEL:
+    return PushOptional(L, basic.battery_level_available, basic.battery_level);
+  case BlackboardField::NONCOMP_VARIO:
+    return PushOptional(L, basic.noncomp_vario_available, basic.noncomp_vario);
+  case BlackboardField::TOTAL_ENERGY_VARIO:
+    return PushOptional(L, basic.total_energy_vario_available, basic.total_energy_vario);
+  case BlackboardField::NETTO_VARIO:
+    return PushOptional(L, basic.netto_vario_available, basic.netto_vario);
+  case BlackboardField::COUNT:
+    break;
+  }
+
+  return false;
 }
 
 static int
 l_blackboard_index(lua_State *L)
+{
+  const int field = Lua::LookupField(L, lua_upvalueindex(1), 2);
+  if (field < 0)
+    return 0;
+
+  if (!PushBlackboardField(L, CommonInterface::Basic(), field))
+    lua_pushnil(L);
+
+  return 1;
+}
+
+/**
+ * Returns a new table with all values which are currently available.
+ * This is cheaper than looking up many fields one by one.
+ */
+static int
+l_blackboard_snapshot(lua_State *L)
 {
   const auto &basic = CommonInterface::Basic();
 
-  const char *name = lua_tostring(L, 2);
-  if (name == nullptr)
-    return 0;
-  else if (StringIsEqual(name, "location"))
-    Lua::PushOptional(L, basic.location_available, basic.location);
-  else if (StringIsEqual(name, "altitude"))
-    Lua::PushOptional(L, basic.NavAltitudeAvailable(), basic.nav_altitude);
-  else if (StringIsEqual(name, "track"))
-    Lua::PushOptional(L, basic.track_available, basic.track);
-  else if (StringIsEqual(name, "ground_speed"))
-    Lua::PushOptional(L, basic.ground_speed_available, basic.ground_speed);
-  else if (StringIsEqual(name, "air_speed"))
-    Lua::PushOptional(L, basic.airspeed_available, basic.true_airspeed);
-  else if (StringIsEqual(name, "bank_angle"))
-    Lua::PushOptional(L, basic.attitude.IsBankAngleUseable(), basic.attitude.bank_angle);
-  else if (StringIsEqual(name, "pitch_angle"))
-    Lua::PushOptional(L, basic.attitude.IsPitchAngleUseable(), basic.attitude.pitch_angle); 
-  else if (StringIsEqual(name, "heading"))
-    Lua::PushOptional(L, basic.attitude.IsHeadingUseable(), basic.attitude.heading);
-  else if (StringIsEqual(name, "g_load"))
-    Lua::PushOptional(L, basic.acceleration.available, basic.acceleration.g_load);
-  else if (StringIsEqual(name, "static_pressure"))
-    Lua::PushOptional(L, basic.static_pressure_available, basic.static_pressure.GetPascal());
-  else if (StringIsEqual(name, "pitot_pressure"))
-    Lua::PushOptional(L, basic.pitot_pressure_available, basic.pitot_pressure.GetPascal());
-  else if (StringIsEqual(name, "dynamic_pressure"))
-    Lua::PushOptional(L, basic.dyn_pressure_available, basic.dyn_pressure.GetPascal());
-  else if (StringIsEqual(name, "temperature"))
-    Lua::PushOptional(L, basic.temperature_available,
-                      basic.temperature.ToKelvin());
-  else if (StringIsEqual(name, "humidity"))
-    Lua::PushOptional(L, basic.humidity_available, basic.humidity);
-  else if (StringIsEqual(name, "voltage"))
-    Lua::PushOptional(L, basic.voltage_available, basic.voltage);
-  else if (StringIsEqual(name, "battery_level"))
-    Lua::PushOptional(L, basic.battery_level_available, basic.battery_level);
-  else if (StringIsEqual(name, "noncomp_vario"))
-    Lua::PushOptional(L, basic.noncomp_vario_available, basic.noncomp_vario);
-  else if (StringIsEqual(name, "total_energy_vario"))
-    Lua::PushOptional(L, basic.total_energy_vario_available, basic.total_energy_vario);
-  else if (StringIsEqual(name, "netto_vario"))
-    Lua::PushOptional(L, basic.netto_vario_available, basic.netto_vario);
-  else
-    return 0;
+  Lua::PushFieldSnapshot(L, lua_upvalueindex(1), [L, &basic](int field){
+    return PushBlackboardField(L, basic, field);
+  });
 
   return 1;
 }
@@ -99,8 +184,17 @@ Lua::InitBlackboard(lua_State *L)
 
   lua_newtable(L);
 
+  /* both functions share one field index */
+  PushFieldIndex(L, blackboard_field_names);
+
+  lua_pushvalue(L, -1);
+  lua_pushcclosure(L, l_blackboard_snapshot, 1);
+  lua_setfield(L, -3, "snapshot");
+
   lua_newtable(L);
-  SetField(L, -2, "__index", l_blackboard_index);
+  lua_insert(L, -2);
+  lua_pushcclosure(L, l_blackboard_index, 1);
+  lua_setfield(L, -2, "__index");
   lua_setmetatable(L, -2);
 
   lua_setfield(L, -2, "blackboard");
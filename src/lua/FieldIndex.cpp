@@ -0,0 +1,52 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FieldIndex.hpp"
+
+void
+Lua::PushFieldIndex(lua_State *L, const char *const*names, unsigned n)
+{
+  lua_createtable(L, 0, n);
+
+  for (unsigned i = 0; i < n; ++i) {
+    lua_pushinteger(L, i);
+    lua_setfield(L, -2, names[i]);
+  }
+}
+
+int
+Lua::LookupField(lua_State *L, int index_idx, int key_idx)
+{
+  if (lua_type(L, key_idx) != LUA_TSTRING)
+    return -1;
+
+  lua_pushvalue(L, key_idx);
+  lua_rawget(L, index_idx < 0 && index_idx > LUA_REGISTRYINDEX
+             ? index_idx - 1
+             : index_idx);
+
+  int isnum;
+  const int field = lua_tointegerx(L, -1, &isnum);
+  lua_pop(L, 1);
+  return isnum ? field : -1;
+}
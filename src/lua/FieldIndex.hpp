@@ -0,0 +1,119 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LUA_FIELD_INDEX_HPP
+#define XCSOAR_LUA_FIELD_INDEX_HPP
+
+extern "C" {
+#include <lua.h>
+}
+
+/*
+ * Helpers for "__index" metamethods which provide a fixed set of
+ * named fields.
+ *
+ * Instead of comparing the key with each field name on every access,
+ * the names are resolved once: a Lua table mapping each name to its
+ * position in the name array is created when the binding is
+ * registered, and passed to the metamethod as an upvalue.  Since Lua
+ * strings are interned, looking up the key in this table costs one
+ * hash lookup, regardless of the number of fields.
+ */
+
+namespace Lua {
+
+/**
+ * Push a table which maps each of the given names to its index in
+ * the array.
+ */
+void
+PushFieldIndex(lua_State *L, const char *const*names, unsigned n);
+
+template<unsigned n>
+static inline void
+PushFieldIndex(lua_State *L, const char *const(&names)[n])
+{
+  PushFieldIndex(L, names, n);
+}
+
+/**
+ * Push a C closure with a field index (see PushFieldIndex()) as its
+ * first upvalue.
+ */
+template<unsigned n>
+static inline void
+PushFieldIndexClosure(lua_State *L, lua_CFunction fn,
+                      const char *const(&names)[n])
+{
+  PushFieldIndex(L, names, n);
+  lua_pushcclosure(L, fn, 1);
+}
+
+/**
+ * Look up the value at stack position #key_idx in the field index at
+ * stack position #index_idx (which may be a pseudo-index such as
+ * lua_upvalueindex(1)).
+ *
+ * @return the field's index in the name array, or -1 if there is no
+ * such field
+ */
+int
+LookupField(lua_State *L, int index_idx, int key_idx);
+
+/**
+ * Create a new table containing all fields of a field index, and
+ * leave it on the stack.
+ *
+ * @param push a function which gets the field index, pushes its
+ * value and returns true, or returns false without pushing anything
+ * if the field is not available; unavailable fields are omitted
+ * from the table
+ */
+template<typename F>
+void
+PushFieldSnapshot(lua_State *L, int index_idx, F &&push)
+{
+  if (index_idx < 0 && index_idx > LUA_REGISTRYINDEX)
+    /* convert to an absolute index because we're going to push
+       values */
+    index_idx = lua_gettop(L) + index_idx + 1;
+
+  lua_newtable(L);
+  const int table_idx = lua_gettop(L);
+
+  /* iterating the field index gives us each interned name together
+     with its field number, so no string needs to be created or
+     hashed here */
+  for (lua_pushnil(L); lua_next(L, index_idx); lua_pop(L, 1)) {
+    const int field = lua_tointeger(L, -1);
+    if (push(field)) {
+      lua_pushvalue(L, -3);
+      lua_insert(L, -2);
+      lua_rawset(L, table_idx);
+    }
+  }
+}
+
+}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Instrument.hpp"
+#include "Util.hxx"
+#include "time/Instrument.hpp"
+#include "util/StringAPI.hxx"
+
+extern "C" {
+#include <lauxlib.h>
+}
+
+static int
+l_instrument_index(lua_State *L)
+{
+  const char *name = lua_tostring(L, 2);
+  if (name == nullptr) {
+    return 0;
+  } else if (StringIsEqual(name, "enabled")) {
+    Lua::Push(L, Instrument::IsEnabled());
+  } else
+    return 0;
+
+  return 1;
+}
+
+static int
+l_instrument_enable(lua_State *L)
+{
+  Instrument::Enable();
+  return 0;
+}
+
+static int
+l_instrument_disable(lua_State *L)
+{
+  Instrument::Disable();
+  return 0;
+}
+
+static int
+l_instrument_reset(lua_State *L)
+{
+  Instrument::Reset();
+  return 0;
+}
+
+static int
+l_instrument_report(lua_State *L)
+{
+  const std::string report = Instrument::FormatReport();
+  lua_pushlstring(L, report.data(), report.length());
+  return 1;
+}
+
+static constexpr struct luaL_Reg instrument_funcs[] = {
+  {"enable", l_instrument_enable},
+  {"disable", l_instrument_disable},
+  {"reset", l_instrument_reset},
+  {"report", l_instrument_report},
+  {nullptr, nullptr}
+};
+
+void
+Lua::InitInstrument(lua_State *L)
+{
+  lua_getglobal(L, "xcsoar");
+
+  lua_newtable(L);
+
+  lua_newtable(L);
+  SetField(L, -2, "__index", l_instrument_index);
+  lua_setmetatable(L, -2);
+
+  luaL_setfuncs(L, instrument_funcs, 0);
+
+  lua_setfield(L, -2, "instrument");
+
+  lua_pop(L, 1);
+}
@@ -22,8 +22,8 @@ Copyright_License {
 */
 
 #include "Settings.hpp"
+#include "FieldIndex.hpp"
 #include "Util.hxx"
-#include "util/StringAPI.hxx"
 #include "Interface.hpp"
 #include "ActionInterface.hpp"
 
@@ -31,49 +31,85 @@ extern "C" {
 #include <lauxlib.h>
 }
 
+#include <iterator>
+
+enum class SettingsField {
+  MC,
+  BUGS,
+  WINGLOAD,
+  BALLAST,
+  QNH,
+  MAX_TEMP,
+  SAFETYMC,
+  RISKFACTOR,
+  POLARDEGRADATION,
+  ARRIVALHEIGHT,
+  TERRAINHEIGHT,
+  COUNT,
+};
+
+static constexpr const char *settings_field_names[] = {
+  "mc",
+  "bugs",
+  "wingload",
+  "ballast",
+  "qnh",
+  "max_temp",
+  "safetymc",
+  "riskfactor",
+  "polardegradation",
+  "arrivalheight",
+  "terrainheight",
+};
+
+static_assert(std::size(settings_field_names) == unsigned(SettingsField::COUNT),
+              "Wrong number of field names");
+
 static int
 l_settings_index(lua_State *L)
 {
-  const char *name = lua_tostring(L, 2);
-  if (name == nullptr)
+  const int i = Lua::LookupField(L, lua_upvalueindex(1), 2);
+  if (i < 0)
     return 0;
-  else if (StringIsEqual(name, "mc")) {
+
+  const auto field = SettingsField(i);
+  if (field == SettingsField::MC) {
     const ComputerSettings &settings_computer =
       CommonInterface::GetComputerSettings();
     
     Lua::Push(L, settings_computer.polar.glide_polar_task.GetMC());
-  } else if (StringIsEqual(name, "bugs")) {
+  } else if (field == SettingsField::BUGS) {
       /* How clean the glider is. */
       const ComputerSettings &settings_computer = 
         CommonInterface::GetComputerSettings();
     
       Lua::Push(L, settings_computer.polar.bugs);
-  } else if (StringIsEqual(name, "wingload")) {
+  } else if (field == SettingsField::WINGLOAD) {
       /* Current used wingload */
       const ComputerSettings &settings_computer =
         CommonInterface::GetComputerSettings();
     
       Lua::Push(L, settings_computer.polar.glide_polar_task.GetWingLoading());
-  } else if (StringIsEqual(name, "ballast")) {
+  } else if (field == SettingsField::BALLAST) {
       /* Ballast of the glider */
       const ComputerSettings &settings_computer =
         CommonInterface::GetComputerSettings();
     
       Lua::Push(L, settings_computer.polar.glide_polar_task.GetBallast());
-  } else if (StringIsEqual(name, "qnh")) {
+  } else if (field == SettingsField::QNH) {
       /* Area pressure for barometric altimeter calibration */
       const ComputerSettings &settings_computer =
         CommonInterface::GetComputerSettings();
     
       Lua::Push(L, settings_computer.pressure.GetPascal());
-  } else if (StringIsEqual(name, "max_temp")) {
+  } else if (field == SettingsField::MAX_TEMP) {
       /* The forecast ground temperature.  Used by 
          convection estimator. */
       const ComputerSettings &settings_computer =
         CommonInterface::GetComputerSettings();
     
       Lua::Push(L, settings_computer.forecast_temperature.ToKelvin());
-  } else if (StringIsEqual(name, "safetymc")) {
+  } else if (field == SettingsField::SAFETYMC) {
       /* The MacCready setting used, when safety MC is enabled 
          for reach calculations, in task abort mode and for 
          determining arrival altitude at airfields. */
@@ -82,7 +118,7 @@ l_settings_index(lua_State *L)
       const TaskBehaviour &task_behaviour = settings_computer.task;
     
       Lua::Push(L, task_behaviour.safety_mc);
-  } else if (StringIsEqual(name, "riskfactor")) {
+  } else if (field == SettingsField::RISKFACTOR) {
       /* The STF risk factor reduces the MacCready setting used to 
          calculate speed to fly as the glider gets low, in order to 
          compensate for risk. Set to 0.0 for no compensation, 
@@ -93,14 +129,14 @@ l_settings_index(lua_State *L)
       const TaskBehaviour &task_behaviour = settings_computer.task;
     
       Lua::Push(L, task_behaviour.risk_gamma);
-  } else if (StringIsEqual(name, "polardegradation")) {
+  } else if (field == SettingsField::POLARDEGRADATION) {
       /* A permanent polar degradation, 0% means no degradation, 
          50% indicates the glider's sink rate is doubled. */
       const ComputerSettings &settings_computer =
         CommonInterface::GetComputerSettings();
     
       Lua::Push(L, settings_computer.polar.degradation_factor);
-  } else if (StringIsEqual(name, "arrivalheight")) {
+  } else if (field == SettingsField::ARRIVALHEIGHT) {
       /* The height above terrain that the glider should arrive 
          at for a safe landing. */
       const ComputerSettings &settings_computer =
@@ -108,7 +144,7 @@ l_settings_index(lua_State *L)
       const TaskBehaviour &task_behaviour = settings_computer.task;
     
       Lua::Push(L, task_behaviour.safety_height_arrival);
-  } else if (StringIsEqual(name, "terrainheight")) {
+  } else if (field == SettingsField::TERRAINHEIGHT) {
       /* The height above terrain that the glider must clear during 
          final glide. */
       const ComputerSettings &settings_computer =
@@ -194,7 +230,8 @@ Lua::InitSettings(lua_State *L)
   lua_newtable(L);
 
   lua_newtable(L);
-  SetField(L, -2, "__index", l_settings_index);
+  PushFieldIndexClosure(L, l_settings_index, settings_field_names);
+  lua_setfield(L, -2, "__index");
   lua_setmetatable(L, -2);
 
   luaL_setfuncs(L, settings_funcs, 0);
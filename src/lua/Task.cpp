@@ -23,21 +23,105 @@ Copyright_License {
 
 #include "Task.hpp"
 #include "Geo.hpp"
+#include "FieldIndex.hpp"
 #include "Util.hxx"
-#include "util/StringAPI.hxx"
 #include "Interface.hpp"
 #include "Components.hpp"
 #include "Task/ProtectedTaskManager.hpp"
 #include "Engine/Waypoint/Waypoint.hpp"
 #include "Engine/Util/Gradient.hpp"
 
+#include <iterator>
+
+enum class TaskField {
+  BEARING,
+  BEARING_DIFF,
+  RADIAL,
+  NEXT_DISTANCE,
+  NEXT_DISTANCE_NOMINAL,
+  NEXT_ETE,
+  NEXT_ETA,
+  NEXT_ALTITUDE_DIFF,
+  NEXTMC0_ALTITUDE_DIFF,
+  NEXT_ALTITUDE_REQUIRE,
+  NEXT_ALTITUDE_ARRIVAL,
+  NEXT_GR,
+  FINAL_DISTANCE,
+  FINAL_ETE,
+  FINAL_ETA,
+  FINAL_ALTITUDE_DIFF,
+  FINALMC0_ALTITUDE_DIFF,
+  FINAL_ALTITUDE_REQUIRE,
+  TASK_SPEED,
+  TASK_SPEED_ACHIEVED,
+  TASK_SPEED_INSTANT,
+  TASK_SPEED_HOUR,
+  FINAL_GR,
+  AAT_TIME,
+  AAT_TIME_DELTA,
+  AAT_DISTANCE,
+  AAT_DISTANCE_MAX,
+  AAT_DISTANCE_MIN,
+  AAT_SPEED,
+  AAT_SPEED_MAX,
+  AAT_SPEED_MIN,
+  TIME_UNDER_MAX_HEIGHT,
+  NEXT_ETEVMG,
+  FINAL_ETEVMG,
+  CRUISE_EFFICIENCY,
+  COUNT,
+};
+
+static constexpr const char *task_field_names[] = {
+  "bearing",
+  "bearing_diff",
+  "radial",
+  "next_distance",
+  "next_distance_nominal",
+  "next_ete",
+  "next_eta",
+  "next_altitude_diff",
+  "nextmc0_altitude_diff",
+  "next_altitude_require",
+  "next_altitude_arrival",
+  "next_gr",
+  "final_distance",
+  "final_ete",
+  "final_eta",
+  "final_altitude_diff",
+  "finalmc0_altitude_diff",
+  "final_altitude_require",
+  "task_speed",
+  "task_speed_achieved",
+  "task_speed_instant",
+  "task_speed_hour",
+  "final_gr",
+  "aat_time",
+  "aat_time_delta",
+  "aat_distance",
+  "aat_distance_max",
+  "aat_distance_min",
+  "aat_speed",
+  "aat_speed_max",
+  "aat_speed_min",
+  "time_under_max_height",
+  "next_etevmg",
+  "final_etevmg",
+  "cruise_efficiency",
+};
+
+static_assert(std::size(task_field_names) == unsigned(TaskField::COUNT),
+              "Wrong number of field names");
+
 static int
 l_task_index(lua_State *L)
 {
-  const char *name = lua_tostring(L, 2);
-  if (name == nullptr)
+  const int i = Lua::LookupField(L, lua_upvalueindex(1), 2);
+  if (i < 0)
     return 0;
-  else if (StringIsEqual(name, "bearing")) {
+
+  const auto field = TaskField(i);
+  if (field == TaskField::BEARING) {
     const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
     const GeoVector &vector_remaining = task_stats.current_leg.vector_remaining;
     if (!task_stats.task_valid || !vector_remaining.IsValid() ||
@@ -45,7 +129,7 @@ l_task_index(lua_State *L)
       return 0;
     }
     Lua::Push(L, vector_remaining.bearing);
-  } else if (StringIsEqual(name, "bearing_diff")) {
+  } else if (field == TaskField::BEARING_DIFF) {
       const NMEAInfo &basic = CommonInterface::Basic();
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       const GeoVector &vector_remaining = task_stats.current_leg.vector_remaining;
@@ -54,7 +138,7 @@ l_task_index(lua_State *L)
         return 0;
       }      
       Lua::Push(L, vector_remaining.bearing - basic.track);
-  } else if (StringIsEqual(name, "radial")) {
+  } else if (field == TaskField::RADIAL) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       const GeoVector &vector_remaining = task_stats.current_leg.vector_remaining;
       if (!task_stats.task_valid || !vector_remaining.IsValid() ||
@@ -62,14 +146,14 @@ l_task_index(lua_State *L)
         return 0;
       }
       Lua::Push(L, vector_remaining.bearing.Reciprocal());
-  } else if (StringIsEqual(name, "next_distance")) {
+  } else if (field == TaskField::NEXT_DISTANCE) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       const GeoVector &vector_remaining = task_stats.current_leg.vector_remaining;
       if (!task_stats.task_valid || !vector_remaining.IsValid()) 
         return 0;
      
       Lua::Push(L, vector_remaining.distance);
-  } else if (StringIsEqual(name, "next_distance_nominal")) {
+  } else if (field == TaskField::NEXT_DISTANCE_NOMINAL) {
       const auto way_point = protected_task_manager != nullptr
           ? protected_task_manager->GetActiveWaypoint() : NULL;
 
@@ -83,14 +167,14 @@ l_task_index(lua_State *L)
 
       if (!vector.IsValid()) return 0;
       Lua::Push(L, vector.distance);
-  } else if (StringIsEqual(name, "next_ete")) {
+  } else if (field == TaskField::NEXT_ETE) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       if (!task_stats.task_valid || !task_stats.current_leg.IsAchievable()) 
         return 0; 
       assert(task_stats.current_leg.time_remaining_now >= 0);
 
       Lua::Push(L, task_stats.current_leg.time_remaining_now);
-  } else if (StringIsEqual(name, "next_eta")) {
+  } else if (field == TaskField::NEXT_ETA) {
       const auto &task_stats = CommonInterface::Calculated().task_stats;
       const BrokenTime &now_local = CommonInterface::Calculated().date_time_local;
 
@@ -104,7 +188,7 @@ l_task_index(lua_State *L)
       float time = t.hour + (float)(t.second/60);
 
       Lua::Push(L, time);
-  } else if (StringIsEqual(name, "next_altitude_diff")) {    
+  } else if (field == TaskField::NEXT_ALTITUDE_DIFF) {    
       const auto &task_stats = CommonInterface::Calculated().task_stats;
       const auto &next_solution = task_stats.current_leg.solution_remaining;
 
@@ -114,7 +198,7 @@ l_task_index(lua_State *L)
       const auto &settings = CommonInterface::GetComputerSettings();
       auto altitude_difference = next_solution.SelectAltitudeDifference(settings.task.glide);
       Lua::Push(L, altitude_difference);
-  } else if (StringIsEqual(name, "nextmc0_altitude_diff")) {
+  } else if (field == TaskField::NEXTMC0_ALTITUDE_DIFF) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       if (!task_stats.task_valid || !task_stats.current_leg.solution_mc0.IsAchievable())
         return 0;
@@ -122,14 +206,14 @@ l_task_index(lua_State *L)
       const auto &settings = CommonInterface::GetComputerSettings();
       auto altitude_difference = task_stats.current_leg.solution_mc0.SelectAltitudeDifference(settings.task.glide);
       Lua::Push(L, altitude_difference);
-  } else if (StringIsEqual(name, "next_altitude_require")) {
+  } else if (field == TaskField::NEXT_ALTITUDE_REQUIRE) {
       const auto &task_stats = CommonInterface::Calculated().task_stats;
       const auto &next_solution = task_stats.current_leg.solution_remaining;
       if (!task_stats.task_valid || !next_solution.IsAchievable()) 
         return 0;
 
       Lua::Push(L, next_solution.GetRequiredAltitude());
-  } else if (StringIsEqual(name, "next_altitude_arrival")) {
+  } else if (field == TaskField::NEXT_ALTITUDE_ARRIVAL) {
       const auto &basic = CommonInterface::Basic();
       const auto &task_stats = CommonInterface::Calculated().task_stats;
       const auto next_solution = task_stats.current_leg.solution_remaining;
@@ -139,7 +223,7 @@ l_task_index(lua_State *L)
       }
 
       Lua::Push(L, next_solution.GetArrivalAltitude(basic.nav_altitude));
-  } else if (StringIsEqual(name, "next_gr")) {
+  } else if (field == TaskField::NEXT_GR) {
       if (!CommonInterface::Calculated().task_stats.task_valid) 
         return 0;
 
@@ -150,7 +234,7 @@ l_task_index(lua_State *L)
         Lua::Push(L, gradient);
       else 
         return 0;         
-  } else if (StringIsEqual(name, "final_distance")) {
+  } else if (field == TaskField::FINAL_DISTANCE) {
       const auto &calculated = CommonInterface::Calculated();
       const TaskStats &task_stats = calculated.task_stats;
 
@@ -161,7 +245,7 @@ l_task_index(lua_State *L)
       }
 
       Lua::Push(L, task_stats.total.remaining.GetDistance());
-  } else if (StringIsEqual(name, "final_ete")) {
+  } else if (field == TaskField::FINAL_ETE) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
 
       if (!task_stats.task_valid || !task_stats.total.IsAchievable()) 
@@ -169,7 +253,7 @@ l_task_index(lua_State *L)
       assert(task_stats.total.time_remaining_now >= 0);
 
       Lua::Push(L, task_stats.total.time_remaining_now);
-  } else if (StringIsEqual(name, "final_eta")) {
+  } else if (field == TaskField::FINAL_ETA) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       const BrokenTime &now_local = CommonInterface::Calculated().date_time_local;
 
@@ -182,7 +266,7 @@ l_task_index(lua_State *L)
 
       float time = t.hour + (float)(t.minute/60);
       Lua::Push(L, time);
-  } else if (StringIsEqual(name, "final_altitude_diff")) {
+  } else if (field == TaskField::FINAL_ALTITUDE_DIFF) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       const auto &settings = CommonInterface::GetComputerSettings();
       if (!task_stats.task_valid || !task_stats.total.solution_remaining.IsAchievable())
@@ -191,7 +275,7 @@ l_task_index(lua_State *L)
         task_stats.total.solution_remaining.SelectAltitudeDifference(settings.task.glide);
 
       Lua::Push(L, altitude_difference);
-  } else if (StringIsEqual(name, "finalmc0_altitude_diff")) {
+  } else if (field == TaskField::FINALMC0_ALTITUDE_DIFF) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       const auto &settings = CommonInterface::GetComputerSettings();
       if (!task_stats.task_valid || !task_stats.total.solution_mc0.IsAchievable())
@@ -200,7 +284,7 @@ l_task_index(lua_State *L)
         task_stats.total.solution_mc0.SelectAltitudeDifference(settings.task.glide);
 
       Lua::Push(L, altitude_difference);
-  } else if (StringIsEqual(name, "final_altitude_require")) {
+  } else if (field == TaskField::FINAL_ALTITUDE_REQUIRE) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       if (!task_stats.task_valid ||
           !task_stats.total.solution_remaining.IsOk()) {
@@ -208,31 +292,31 @@ l_task_index(lua_State *L)
       }
    
       Lua::Push(L, task_stats.total.solution_remaining.GetRequiredAltitude());
-  } else if (StringIsEqual(name, "task_speed")) {
+  } else if (field == TaskField::TASK_SPEED) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       if (!task_stats.task_valid || !task_stats.total.travelled.IsDefined()) 
         return 0;
 
       Lua::Push(L, task_stats.total.travelled.GetSpeed());
-  } else if (StringIsEqual(name, "task_speed_achieved")) {
+  } else if (field == TaskField::TASK_SPEED_ACHIEVED) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       if (!task_stats.task_valid || !task_stats.total.remaining_effective.IsDefined()) 
         return 0;
 
       Lua::Push(L, task_stats.total.remaining_effective.GetSpeed());
-  } else if (StringIsEqual(name, "task_speed_instant")) {
+  } else if (field == TaskField::TASK_SPEED_INSTANT) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       if (!task_stats.task_valid)
         return -1;
 
       Lua::Push(L, task_stats.inst_speed_fast);
-  } else if (StringIsEqual(name, "task_speed_hour")) {
+  } else if (field == TaskField::TASK_SPEED_HOUR) {
       const WindowStats &window = CommonInterface::Calculated().task_stats.last_hour;
       if (window.duration < 0)
         return 0;
 
       Lua::Push(L, window.speed);
-  } else if (StringIsEqual(name, "final_gr")) {
+  } else if (field == TaskField::FINAL_GR) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       if (!task_stats.task_valid) 
         return 0;
@@ -245,19 +329,19 @@ l_task_index(lua_State *L)
         Lua::Push(L, gradient);
       else
         return 0;
-  } else if (StringIsEqual(name, "aat_time")) {
+  } else if (field == TaskField::AAT_TIME) {
       const auto &calculated = CommonInterface::Calculated();
       const TaskStats &task_stats = calculated.ordered_task_stats;
-      const CommonStats &common_stats = calculated.common_stats;
+      const CommonStats &common_stats = CommonInterface::GetCommonStats();
 
       if (!task_stats.has_targets || !task_stats.total.IsAchievable()) 
         return 0;
 
       Lua::Push(L, common_stats.aat_time_remaining);
-  } else if (StringIsEqual(name, "aat_time_delta")) {
+  } else if (field == TaskField::AAT_TIME_DELTA) {
       const auto &calculated = CommonInterface::Calculated();
       const TaskStats &task_stats = calculated.ordered_task_stats;
-      const CommonStats &common_stats = calculated.common_stats;
+      const CommonStats &common_stats = CommonInterface::GetCommonStats();
       if (!task_stats.has_targets || !task_stats.total.IsAchievable()) 
         return 0;
    
@@ -267,7 +351,7 @@ l_task_index(lua_State *L)
         common_stats.aat_time_remaining;
 
       Lua::Push(L, diff);
-  } else if (StringIsEqual(name, "aat_distance")) {
+  } else if (field == TaskField::AAT_DISTANCE) {
       const auto &calculated = CommonInterface::Calculated();
       const TaskStats &task_stats = calculated.ordered_task_stats;
 
@@ -275,7 +359,7 @@ l_task_index(lua_State *L)
         return 0;
        
       Lua::Push(L, task_stats.total.planned.GetDistance());
-  } else if (StringIsEqual(name, "aat_distance_max")) {
+  } else if (field == TaskField::AAT_DISTANCE_MAX) {
       const auto &calculated = CommonInterface::Calculated();
       const TaskStats &task_stats = calculated.ordered_task_stats;
 
@@ -283,7 +367,7 @@ l_task_index(lua_State *L)
         return 0;
 
       Lua::Push(L, task_stats.distance_max);
-  } else if (StringIsEqual(name, "aat_distance_min")) {
+  } else if (field == TaskField::AAT_DISTANCE_MIN) {
       const auto &calculated = CommonInterface::Calculated();
       const TaskStats &task_stats = calculated.ordered_task_stats;
 
@@ -291,38 +375,38 @@ l_task_index(lua_State *L)
         return 0;
 
       Lua::Push(L, task_stats.distance_min);
-  } else if (StringIsEqual(name, "aat_speed")) {
+  } else if (field == TaskField::AAT_SPEED) {
       const auto &calculated = CommonInterface::Calculated();
       const TaskStats &task_stats = calculated.ordered_task_stats;
-      const CommonStats &common_stats = calculated.common_stats;
+      const CommonStats &common_stats = CommonInterface::GetCommonStats();
 
       if (!task_stats.has_targets || common_stats.aat_speed_target <= 0) 
         return 0;
 
       Lua::Push(L, common_stats.aat_speed_target);
-  } else if (StringIsEqual(name, "aat_speed_max")) {
+  } else if (field == TaskField::AAT_SPEED_MAX) {
       const auto &calculated = CommonInterface::Calculated();
       const TaskStats &task_stats = calculated.ordered_task_stats;
-      const CommonStats &common_stats = calculated.common_stats;
+      const CommonStats &common_stats = CommonInterface::GetCommonStats();
 
       if (!task_stats.has_targets || common_stats.aat_speed_max <= 0) 
         return 0;
 
       Lua::Push(L, common_stats.aat_speed_max);
-  } else if (StringIsEqual(name, "aat_speed_min")) {
+  } else if (field == TaskField::AAT_SPEED_MIN) {
       const auto &calculated = CommonInterface::Calculated();
       const TaskStats &task_stats = calculated.ordered_task_stats;
-      const CommonStats &common_stats = calculated.common_stats;
+      const CommonStats &common_stats = CommonInterface::GetCommonStats();
 
       if (!task_stats.has_targets ||
         !task_stats.task_valid || common_stats.aat_speed_min <= 0) 
         return 0;
     
       Lua::Push(L, common_stats.aat_speed_min);
-  } else if (StringIsEqual(name, "time_under_max_height")) {
+  } else if (field == TaskField::TIME_UNDER_MAX_HEIGHT) {
       const auto &calculated = CommonInterface::Calculated();
       const auto &task_stats = calculated.ordered_task_stats;
-      const auto &common_stats = calculated.common_stats;
+      const auto &common_stats = CommonInterface::GetCommonStats();
       const double maxheight = protected_task_manager->GetOrderedTaskSettings().start_constraints.max_height;
 
       if (!task_stats.task_valid || maxheight <= 0
@@ -334,7 +418,7 @@ l_task_index(lua_State *L)
       common_stats.TimeUnderStartMaxHeight);
 
       Lua::Push(L, time);
-  } else if (StringIsEqual(name, "next_etevmg")) {
+  } else if (field == TaskField::NEXT_ETEVMG) {
       const NMEAInfo &basic = CommonInterface::Basic();
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
 
@@ -352,7 +436,7 @@ l_task_index(lua_State *L)
       }
    
       Lua::Push(L, d/v);
-  } else if (StringIsEqual(name, "final_etevmg")) {
+  } else if (field == TaskField::FINAL_ETEVMG) {
       const NMEAInfo &basic = CommonInterface::Basic();
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
 
@@ -370,7 +454,7 @@ l_task_index(lua_State *L)
       }
  
       Lua::Push(L, d/v);
-  } else if (StringIsEqual(name, "cruise_efficiency")) {
+  } else if (field == TaskField::CRUISE_EFFICIENCY) {
       const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
       if (!task_stats.task_valid || !task_stats.start.task_started) 
         return 0;
@@ -390,7 +474,8 @@ Lua::InitTask(lua_State *L)
   lua_newtable(L);
 
   lua_newtable(L);
-  SetField(L, -2, "__index", l_task_index);
+  PushFieldIndexClosure(L, l_task_index, task_field_names);
+  lua_setfield(L, -2, "__index");
   lua_setmetatable(L, -2);
 
   lua_setfield(L, -2, "task");
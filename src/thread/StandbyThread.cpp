@@ -92,6 +92,8 @@ StandbyThread::Run() noexcept
 
   alive = true;
 
+  OnThreadStart();
+
   while (!stop) {
     assert(!busy);
 
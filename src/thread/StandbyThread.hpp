@@ -117,6 +117,18 @@ protected:
     return pending || busy;
   }
 
+  /**
+   * Has Trigger() been called again since Tick() was invoked?  A
+   * Tick() implementation may use this to abandon low-priority work
+   * in favour of the new request.
+   *
+   * Caller must lock the mutex.
+   */
+  gcc_pure
+  bool IsPending() const {
+    return pending;
+  }
+
   /**
    * Was the thread asked to stop?  The Tick() implementation should
    * use this to check whether to cancel the operation.
@@ -174,6 +186,12 @@ protected:
     Stop();
   }
 
+  /**
+   * Called by the new thread before it waits for work, e.g. to
+   * adjust its priority.  The mutex is locked.
+   */
+  virtual void OnThreadStart() noexcept {}
+
   /**
    * Implement this to do the actual work.  The mutex will be locked,
    * but you should unlock it while doing real work (and re-lock it
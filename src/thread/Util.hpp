@@ -38,6 +38,10 @@
 #include <windows.h>
 #endif
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 #if defined(__linux__) && !defined(ANDROID)
 
 static int
@@ -103,4 +107,23 @@ SetThreadRealtime()
 #endif
 };
 
+/**
+ * Determine the number of CPU cores which are currently online.
+ * Returns 1 if that is unknown.
+ */
+static inline unsigned
+GetProcessorCount()
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+  const long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? unsigned(n) : 1;
+#else
+  return 1;
+#endif
+}
+
 #endif
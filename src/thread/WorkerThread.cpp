@@ -24,16 +24,75 @@ Copyright_License {
 #include "thread/WorkerThread.hpp"
 #include "time/PeriodClock.hpp"
 
+#include <algorithm>
+
+/**
+ * Calculate a new exponential moving average; the new sample has a
+ * weight of 1/8.
+ */
+static constexpr WorkerThread::Duration
+MovingAverage(WorkerThread::Duration average, WorkerThread::Duration sample)
+{
+  return average + (sample - average) / 8;
+}
+
 WorkerThread::WorkerThread(const char *_name,
                            unsigned _period_min, unsigned _idle_min,
                            unsigned _delay)
   :SuspensibleThread(_name),
    period_min(std::chrono::milliseconds(_period_min)),
    idle_min(std::chrono::milliseconds(_idle_min)),
-   delay(std::chrono::milliseconds(_delay))
+   delay(std::chrono::milliseconds(_delay)),
+   /* start with the full delay until bursts have been observed */
+   burst_gap_average(delay / 2)
 {
 }
 
+void
+WorkerThread::UpdateBurstGap()
+{
+  const auto now = std::chrono::steady_clock::now();
+  const auto gap = now - last_trigger;
+  last_trigger = now;
+
+  /* only gaps within the current delay window belong to a burst;
+     longer ones separate two bursts and are ignored */
+  if (gap < GetDelay())
+    burst_gap_average = MovingAverage(burst_gap_average, gap);
+}
+
+WorkerThread::Duration
+WorkerThread::GetPeriodMin() const
+{
+  if (!adaptive)
+    return period_min;
+
+  return std::min<Duration>(period_min,
+                            tick_average * 100 / MAX_LOAD_PERCENT);
+}
+
+WorkerThread::Duration
+WorkerThread::GetIdleMin() const
+{
+  if (!adaptive)
+    return idle_min;
+
+  return std::min<Duration>(idle_min,
+                            tick_average * (100 - MAX_LOAD_PERCENT)
+                            / MAX_LOAD_PERCENT);
+}
+
+WorkerThread::Duration
+WorkerThread::GetDelay() const
+{
+  if (!adaptive)
+    return delay;
+
+  /* wait for twice the typical gap within a burst, which should be
+     enough to catch the rest of it */
+  return std::min<Duration>(delay, burst_gap_average * 2);
+}
+
 void
 WorkerThread::Run() noexcept
 {
@@ -55,8 +114,9 @@ WorkerThread::Run() noexcept
     }
 
     /* got the "stop" trigger? */
-    if (delay.count() > 0
-        ? _WaitForStopped(lock, delay)
+    const auto current_delay = GetDelay();
+    if (current_delay.count() > 0
+        ? _WaitForStopped(lock, current_delay)
         : _CheckStoppedOrSuspended(lock))
       break;
 
@@ -69,18 +129,18 @@ WorkerThread::Run() noexcept
       const ScopeUnlock unlock(mutex);
 
       /* do the actual work */
-      if (period_min.count() > 0)
-        clock.Update();
+      clock.Update();
 
       Tick();
     }
 
-    auto idle = idle_min;
-    if (period_min.count() > 0) {
-      const auto elapsed = clock.Elapsed();
-      if (elapsed + idle < period_min)
-        idle = period_min - elapsed;
-    }
+    const auto elapsed = clock.Elapsed();
+    tick_average = MovingAverage(tick_average, elapsed);
+
+    auto idle = GetIdleMin();
+    const auto current_period_min = GetPeriodMin();
+    if (elapsed + idle < current_period_min)
+      idle = current_period_min - elapsed;
 
     if (idle.count() > 0 && _WaitForStopped(lock, idle))
       break;
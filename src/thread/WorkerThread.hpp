@@ -28,12 +28,48 @@ Copyright_License {
 
 /**
  * A thread which performs regular work in background.
+ *
+ * If the adaptive rate limit is enabled (see SetAdaptive()), the
+ * limits passed to the constructor are upper bounds: the thread
+ * measures how long Tick() takes and how Trigger() calls are spaced,
+ * and scales the limits down when there is CPU headroom.  It may then
+ * use up to #MAX_LOAD_PERCENT of one CPU, and it delays only as long
+ * as needed to group a burst of Trigger() calls.
  */
 class WorkerThread : public SuspensibleThread {
+public:
+  using Duration = std::chrono::steady_clock::duration;
+
+  /**
+   * The maximum share of one CPU that the adaptive rate limit allows
+   * this thread to use.
+   */
+  static constexpr unsigned MAX_LOAD_PERCENT = 50;
+
+private:
   Cond trigger_cond;
   bool trigger_flag = false;
 
-  const std::chrono::steady_clock::duration period_min, idle_min, delay;
+  /**
+   * Scale the limits according to measured load?
+   */
+  bool adaptive = false;
+
+  const Duration period_min, idle_min, delay;
+
+  /**
+   * Moving average of the Tick() duration.  Protected by the mutex.
+   */
+  Duration tick_average = Duration::zero();
+
+  /**
+   * Moving average of the gap between two Trigger() calls which
+   * belong to the same burst (i.e. gaps shorter than the current
+   * effective delay).  Protected by the mutex.
+   */
+  Duration burst_gap_average;
+
+  std::chrono::steady_clock::time_point last_trigger;
 
 public:
   /**
@@ -50,11 +86,32 @@ public:
                unsigned period_min=0, unsigned idle_min=0,
                unsigned delay=0);
 
+  /**
+   * Enable or disable the adaptive rate limit.  If disabled, the
+   * values passed to the constructor are used as they are.  Must be
+   * called before the thread is started.
+   */
+  void SetAdaptive(bool _adaptive) {
+    adaptive = _adaptive;
+  }
+
+  /**
+   * Returns the moving average of the Tick() duration.
+   */
+  Duration GetTickAverage() {
+    const std::lock_guard<Mutex> lock(mutex);
+    return tick_average;
+  }
+
   /**
    * Wakes up the thread to do work, calls tick().
    */
   void Trigger() {
     const std::lock_guard<Mutex> lock(mutex);
+
+    if (adaptive && delay.count() > 0)
+      UpdateBurstGap();
+
     if (!trigger_flag) {
       trigger_flag = true;
       trigger_cond.notify_one();
@@ -93,6 +150,16 @@ public:
     trigger_cond.notify_one();
   }
 
+private:
+  void UpdateBurstGap();
+
+  /**
+   * Calculate the effective limits.  Caller must lock the mutex.
+   */
+  Duration GetPeriodMin() const;
+  Duration GetIdleMin() const;
+  Duration GetDelay() const;
+
 protected:
   virtual void Run() noexcept;
 
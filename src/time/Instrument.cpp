@@ -0,0 +1,159 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Instrument.hpp"
+#include "util/StringFormat.hpp"
+#include "util/Macros.hpp"
+
+#include <cassert>
+
+namespace Instrument {
+
+static constexpr const char *probe_names[] = {
+  "glide.gps",
+  "glide.idle",
+  "task.update",
+  "contest.idle",
+  "route.solve",
+  "route.reach",
+  "terrain.generate",
+  "terrain.unchanged",
+  "draw.frame",
+};
+
+static_assert(ARRAY_SIZE(probe_names) == unsigned(Probe::COUNT),
+              "Wrong number of probe names");
+
+Stamp
+Summary::GetPercentile(double fraction) const noexcept
+{
+  if (count == 0)
+    return 0;
+
+  const uint_least64_t rank = uint_least64_t(fraction * count);
+  uint_least64_t sum = 0;
+  for (unsigned i = 0; i < N_BUCKETS; ++i) {
+    sum += buckets[i];
+    if (sum > rank) {
+      const Stamp upper = Stamp(1000) << i;
+      return upper < max ? upper : max;
+    }
+  }
+
+  return max;
+}
+
+Report
+Collect() noexcept
+{
+  Report report{};
+
+  const unsigned g = generation.load(std::memory_order_relaxed);
+  const auto relaxed = std::memory_order_relaxed;
+
+  for (const ThreadBuffer *buffer = buffers.load(std::memory_order_acquire);
+       buffer != nullptr; buffer = buffer->next) {
+    if (buffer->generation.load(std::memory_order_acquire) != g)
+      /* not cleared since the last Reset() call; these samples are
+         obsolete */
+      continue;
+
+    for (unsigned i = 0; i < unsigned(Probe::COUNT); ++i) {
+      const Slot &src = buffer->slots[i];
+      Summary &dest = report[i];
+
+      dest.count += src.count.load(relaxed);
+      dest.total += src.total.load(relaxed);
+
+      const uint_least64_t max = src.max.load(relaxed);
+      if (max > dest.max)
+        dest.max = max;
+
+      for (unsigned j = 0; j < N_BUCKETS; ++j)
+        dest.buckets[j] += src.buckets[j].load(relaxed);
+    }
+  }
+
+  return report;
+}
+
+const char *
+GetProbeName(Probe probe) noexcept
+{
+  assert(probe < Probe::COUNT);
+
+  return probe_names[unsigned(probe)];
+}
+
+bool
+IsCounter(Probe probe) noexcept
+{
+  return probe == Probe::TERRAIN_UNCHANGED;
+}
+
+static constexpr double
+ToMilliseconds(Stamp ns) noexcept
+{
+  return ns / 1e6;
+}
+
+std::string
+FormatReport(const Report &report)
+{
+  std::string result;
+  char line[160];
+
+  StringFormat(line, sizeof(line), "%-18s %9s %11s %9s %9s %9s %9s %9s\n",
+               "probe", "count", "total[ms]", "mean[ms]",
+               "p50[ms]", "p90[ms]", "p99[ms]", "max[ms]");
+  result.append(line);
+
+  for (unsigned i = 0; i < unsigned(Probe::COUNT); ++i) {
+    const Probe probe = Probe(i);
+    const Summary &summary = report[i];
+    if (summary.count == 0)
+      continue;
+
+    if (IsCounter(probe))
+      StringFormat(line, sizeof(line), "%-18s %9llu\n",
+                   GetProbeName(probe),
+                   (unsigned long long)summary.count);
+    else
+      StringFormat(line, sizeof(line),
+                   "%-18s %9llu %11.1f %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+                   GetProbeName(probe),
+                   (unsigned long long)summary.count,
+                   ToMilliseconds(summary.total),
+                   ToMilliseconds(summary.GetMean()),
+                   ToMilliseconds(summary.GetPercentile(0.5)),
+                   ToMilliseconds(summary.GetPercentile(0.9)),
+                   ToMilliseconds(summary.GetPercentile(0.99)),
+                   ToMilliseconds(summary.max));
+
+    result.append(line);
+  }
+
+  return result;
+}
+
+}
@@ -0,0 +1,368 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_INSTRUMENT_HPP
+#define XCSOAR_INSTRUMENT_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <cstdint>
+
+/**
+ * Timers and counters for the hot paths of the various subsystems
+ * (glide computer, task engine, route planner, terrain renderer, map
+ * drawing).
+ *
+ * Each thread records into its own buffer, which is allocated on
+ * first use and linked into a global list; only the owning thread
+ * writes to it, therefore no locking and no atomic read-modify-write
+ * operations are needed.  Buffers are never freed, so the samples of
+ * threads which have already exited still show up in the report.
+ *
+ * The probes in the code (#INSTRUMENT_SCOPE, #INSTRUMENT_COUNT)
+ * compile to nothing unless the macro INSTRUMENT is defined (make
+ * INSTRUMENT=y).  Even then, recording is disabled by default, and
+ * the overhead is one atomic load per probe.
+ *
+ * The recording side is header-only, so that the low-level
+ * libraries can be instrumented without adding link dependencies.
+ */
+namespace Instrument {
+
+/**
+ * A time span in nanoseconds.
+ */
+typedef uint_least64_t Stamp;
+
+enum class Probe : uint_least8_t {
+  /**
+   * GlideComputer::ProcessGPS()
+   */
+  GLIDE_GPS,
+
+  /**
+   * One run of the glide computer's idle jobs.
+   */
+  GLIDE_IDLE,
+
+  /**
+   * TaskManager::Update()
+   */
+  TASK_UPDATE,
+
+  /**
+   * ContestManager::UpdateIdle()
+   */
+  CONTEST_IDLE,
+
+  /**
+   * Solving the terrain route to the current task point.
+   */
+  ROUTE_SOLVE,
+
+  /**
+   * Calculating the reach footprint.
+   */
+  ROUTE_REACH,
+
+  /**
+   * TerrainRenderer::Generate() producing a new terrain image.
+   */
+  TERRAIN_GENERATE,
+
+  /**
+   * Counter: TerrainRenderer::Generate() calls which reused the
+   * previous image.
+   */
+  TERRAIN_UNCHANGED,
+
+  /**
+   * Drawing one map frame.
+   */
+  DRAW_FRAME,
+
+  COUNT
+};
+
+/**
+ * The number of histogram buckets.  Bucket 0 counts samples below
+ * one microsecond, bucket n counts samples from 2^(n-1) up to 2^n
+ * microseconds; the last bucket collects everything above.
+ */
+static constexpr unsigned N_BUCKETS = 24;
+
+struct Slot {
+  std::atomic<uint_least64_t> count{0}, total{0}, max{0};
+  std::array<std::atomic<uint_least64_t>, N_BUCKETS> buckets{};
+
+  void Clear() noexcept {
+    count.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+    for (auto &i : buckets)
+      i.store(0, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * The per-thread buffer.  All attributes are atomic only to allow
+ * another thread to read them while the owning thread is writing.
+ */
+struct ThreadBuffer {
+  ThreadBuffer *next = nullptr;
+
+  /**
+   * The value of #generation when this buffer was last cleared.
+   */
+  std::atomic<unsigned> generation{0};
+
+  std::array<Slot, unsigned(Probe::COUNT)> slots;
+};
+
+inline std::atomic<bool> enabled{false};
+
+/**
+ * Incremented by Reset(); each thread clears its buffer when it sees
+ * a new value.
+ */
+inline std::atomic<unsigned> generation{0};
+
+/**
+ * The head of the list of all #ThreadBuffer instances.
+ */
+inline std::atomic<ThreadBuffer *> buffers{nullptr};
+
+static inline bool
+IsEnabled() noexcept
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+static inline void
+Enable() noexcept
+{
+  enabled.store(true, std::memory_order_relaxed);
+}
+
+static inline void
+Disable() noexcept
+{
+  enabled.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * Discard all samples recorded so far.
+ */
+static inline void
+Reset() noexcept
+{
+  generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+static inline Stamp
+Now() noexcept
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static constexpr unsigned
+GetBucket(Stamp duration) noexcept
+{
+  const uint_least64_t us = duration / 1000;
+  if (us == 0)
+    return 0;
+
+  const unsigned bucket = 64 - __builtin_clzll(us);
+  return bucket < N_BUCKETS ? bucket : N_BUCKETS - 1;
+}
+
+/**
+ * Returns the calling thread's buffer, allocating and registering it
+ * on the first call.
+ */
+inline ThreadBuffer &
+GetThreadBuffer() noexcept
+{
+  static thread_local ThreadBuffer *buffer = nullptr;
+  if (buffer == nullptr) {
+    buffer = new ThreadBuffer();
+    buffer->generation.store(generation.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+
+    ThreadBuffer *head = buffers.load(std::memory_order_relaxed);
+    do {
+      buffer->next = head;
+    } while (!buffers.compare_exchange_weak(head, buffer,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed));
+  }
+
+  return *buffer;
+}
+
+/**
+ * Returns the calling thread's slot for the given probe, after
+ * clearing the buffer if Reset() has been called meanwhile.
+ */
+inline Slot &
+GetSlot(Probe probe) noexcept
+{
+  ThreadBuffer &buffer = GetThreadBuffer();
+
+  const unsigned g = generation.load(std::memory_order_relaxed);
+  if (buffer.generation.load(std::memory_order_relaxed) != g) {
+    for (auto &i : buffer.slots)
+      i.Clear();
+    buffer.generation.store(g, std::memory_order_release);
+  }
+
+  return buffer.slots[unsigned(probe)];
+}
+
+/**
+ * Record one timer sample.  The caller is responsible for checking
+ * IsEnabled().
+ */
+inline void
+Record(Probe probe, Stamp duration) noexcept
+{
+  Slot &slot = GetSlot(probe);
+
+  const auto relaxed = std::memory_order_relaxed;
+  slot.count.store(slot.count.load(relaxed) + 1, relaxed);
+  slot.total.store(slot.total.load(relaxed) + duration, relaxed);
+  if (duration > slot.max.load(relaxed))
+    slot.max.store(duration, relaxed);
+
+  auto &bucket = slot.buckets[GetBucket(duration)];
+  bucket.store(bucket.load(relaxed) + 1, relaxed);
+}
+
+/**
+ * Increment a counter.
+ */
+inline void
+Count(Probe probe, unsigned n=1) noexcept
+{
+  if (!IsEnabled())
+    return;
+
+  Slot &slot = GetSlot(probe);
+
+  const auto relaxed = std::memory_order_relaxed;
+  slot.count.store(slot.count.load(relaxed) + n, relaxed);
+}
+
+/**
+ * Measures the time from construction to destruction.
+ */
+class ScopedTimer {
+  const Probe probe;
+  const Stamp start;
+
+public:
+  explicit ScopedTimer(Probe _probe) noexcept
+    :probe(_probe), start(IsEnabled() ? Now() : 0) {}
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+  ~ScopedTimer() noexcept {
+    if (start != 0)
+      Record(probe, Now() - start);
+  }
+};
+
+/**
+ * The samples of one probe, summed over all threads.
+ */
+struct Summary {
+  uint_least64_t count, total, max;
+  std::array<uint_least64_t, N_BUCKETS> buckets;
+
+  Stamp GetMean() const noexcept {
+    return count > 0 ? total / count : 0;
+  }
+
+  /**
+   * Estimate a percentile from the histogram: returns the upper
+   * bound of the bucket which contains it, but not more than the
+   * maximum.
+   *
+   * @param fraction the percentile divided by 100
+   */
+  Stamp GetPercentile(double fraction) const noexcept;
+};
+
+typedef std::array<Summary, unsigned(Probe::COUNT)> Report;
+
+/**
+ * Sum up the buffers of all threads.  May be called from any thread,
+ * concurrently with recording threads.
+ */
+Report
+Collect() noexcept;
+
+/**
+ * Returns a short lower-case name for the probe, which is used in the
+ * report.
+ */
+const char *
+GetProbeName(Probe probe) noexcept;
+
+/**
+ * Is this probe a plain counter instead of a timer?
+ */
+bool
+IsCounter(Probe probe) noexcept;
+
+/**
+ * Format the report as a plain-text table, one line per probe which
+ * has recorded at least one sample.
+ */
+std::string
+FormatReport(const Report &report);
+
+static inline std::string
+FormatReport()
+{
+  return FormatReport(Collect());
+}
+
+}
+
+#ifdef INSTRUMENT
+#define INSTRUMENT_SCOPE(probe) \
+  const Instrument::ScopedTimer instrument_scoped_timer(Instrument::Probe::probe)
+#define INSTRUMENT_COUNT(probe, n) \
+  Instrument::Count(Instrument::Probe::probe, n)
+#else
+#define INSTRUMENT_SCOPE(probe) do {} while (false)
+#define INSTRUMENT_COUNT(probe, n) do {} while (false)
+#endif
+
+#endif
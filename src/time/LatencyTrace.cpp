@@ -0,0 +1,145 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LatencyTrace.hpp"
+#include "util/StringAPI.hxx"
+#include "util/Macros.hpp"
+
+#include <cassert>
+#include <memory>
+
+namespace LatencyTrace {
+
+struct Slot {
+  /**
+   * The index of the event stored in this slot, plus one.  Zero while
+   * the slot is being written.
+   */
+  std::atomic<uint_least32_t> sequence{0};
+
+  std::atomic<Stamp> origin{0}, time{0};
+  std::atomic<uint_least8_t> stage{0};
+};
+
+std::atomic<bool> enabled{false};
+
+static std::unique_ptr<Slot[]> ring;
+static unsigned ring_mask;
+static std::atomic<uint_least32_t> head{0};
+
+static constexpr const char *stage_names[] = {
+  "parsed",
+  "merged",
+  "audio",
+  "calculated",
+  "drawn",
+};
+
+static_assert(ARRAY_SIZE(stage_names) == unsigned(Stage::COUNT),
+              "Wrong number of stage names");
+
+void
+Enable(unsigned capacity)
+{
+  assert(capacity > 0);
+  assert((capacity & (capacity - 1)) == 0);
+  assert(!IsEnabled());
+
+  ring.reset(new Slot[capacity]);
+  ring_mask = capacity - 1;
+  head.store(0, std::memory_order_relaxed);
+
+  enabled.store(true, std::memory_order_release);
+}
+
+void
+Push(Stage stage, Stamp origin, Stamp time) noexcept
+{
+  const uint_least32_t i = head.fetch_add(1, std::memory_order_relaxed);
+  Slot &slot = ring[i & ring_mask];
+
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.origin.store(origin, std::memory_order_relaxed);
+  slot.time.store(time, std::memory_order_relaxed);
+  slot.stage.store(uint_least8_t(stage), std::memory_order_relaxed);
+
+  slot.sequence.store(i + 1, std::memory_order_release);
+}
+
+std::vector<Event>
+Collect()
+{
+  std::vector<Event> events;
+  if (!IsEnabled())
+    return events;
+
+  const uint_least32_t end = head.load(std::memory_order_acquire);
+  const uint_least32_t capacity = ring_mask + 1;
+  const uint_least32_t begin = end > capacity ? end - capacity : 0;
+
+  events.reserve(end - begin);
+
+  for (uint_least32_t i = begin; i != end; ++i) {
+    const Slot &slot = ring[i & ring_mask];
+
+    if (slot.sequence.load(std::memory_order_acquire) != i + 1)
+      /* not yet written or already overwritten */
+      continue;
+
+    Event event;
+    event.origin = slot.origin.load(std::memory_order_relaxed);
+    event.time = slot.time.load(std::memory_order_relaxed);
+    event.stage = Stage(slot.stage.load(std::memory_order_relaxed));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != i + 1)
+      /* overwritten while we were reading it */
+      continue;
+
+    events.push_back(event);
+  }
+
+  return events;
+}
+
+const char *
+GetStageName(Stage stage) noexcept
+{
+  assert(stage < Stage::COUNT);
+
+  return stage_names[unsigned(stage)];
+}
+
+Stage
+ParseStageName(const char *name) noexcept
+{
+  for (unsigned i = 0; i < unsigned(Stage::COUNT); ++i)
+    if (StringIsEqual(name, stage_names[i]))
+      return Stage(i);
+
+  return Stage::COUNT;
+}
+
+}
@@ -0,0 +1,170 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LATENCY_TRACE_HPP
+#define XCSOAR_LATENCY_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <cstdint>
+
+/**
+ * A lightweight facility which measures how long a sample takes from
+ * arriving at a device port until it is consumed by the various
+ * threads.
+ *
+ * Each sample carries the time stamp of its arrival (see
+ * NMEAInfo::latency_stamp); each stage records an event with that
+ * "origin" time stamp and the current time into a lock-free ring
+ * buffer.  After the ring has been filled, the oldest events are
+ * overwritten.
+ *
+ * Tracing is disabled by default, and then the overhead is one
+ * atomic load per stage.
+ */
+namespace LatencyTrace {
+
+/**
+ * A time stamp in nanoseconds on the steady clock.  Zero means "no
+ * time stamp".
+ */
+typedef uint_least64_t Stamp;
+
+enum class Stage : uint_least8_t {
+  /**
+   * The sample was parsed into the per-device #NMEAInfo.
+   */
+  PARSED,
+
+  /**
+   * The MergeThread has merged the sample into the
+   * #DeviceBlackboard.
+   */
+  MERGED,
+
+  /**
+   * The vario value was passed to the audio vario synthesiser.
+   */
+  AUDIO,
+
+  /**
+   * The CalculationThread has published a #DerivedInfo based on the
+   * sample.
+   */
+  CALCULATED,
+
+  /**
+   * The map was rendered with the sample.
+   */
+  DRAWN,
+
+  COUNT
+};
+
+struct Event {
+  Stamp origin, time;
+  Stage stage;
+
+  Stamp GetLatency() const noexcept {
+    return time - origin;
+  }
+};
+
+extern std::atomic<bool> enabled;
+
+static inline Stamp
+Now() noexcept
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static inline bool
+IsEnabled() noexcept
+{
+  return enabled.load(std::memory_order_acquire);
+}
+
+/**
+ * Allocate the ring buffer and start recording.  Must be called
+ * before the threads which record events are started.
+ *
+ * @param capacity the number of events in the ring buffer; must be
+ * a power of two
+ */
+void
+Enable(unsigned capacity=65536);
+
+/**
+ * Returns the current time if tracing is enabled, zero otherwise.
+ * This is used to stamp new samples.
+ */
+static inline Stamp
+Begin() noexcept
+{
+  return IsEnabled() ? Now() : 0;
+}
+
+void
+Push(Stage stage, Stamp origin, Stamp time) noexcept;
+
+/**
+ * Record that the sample with the given origin time stamp has
+ * reached the given stage.  Does nothing if tracing is disabled or
+ * if the sample has no time stamp.
+ */
+static inline void
+Record(Stage stage, Stamp origin) noexcept
+{
+  if (origin != 0 && IsEnabled())
+    Push(stage, origin, Now());
+}
+
+/**
+ * Returns a copy of all events currently in the ring buffer, oldest
+ * first.  Events which are being overwritten concurrently are
+ * omitted.
+ */
+std::vector<Event>
+Collect();
+
+/**
+ * Returns a short lower-case name for the stage, which is used in
+ * the dump file.
+ */
+const char *
+GetStageName(Stage stage) noexcept;
+
+/**
+ * Parse a stage name returned by GetStageName().
+ *
+ * @return Stage::COUNT if the name is not known
+ */
+Stage
+ParseStageName(const char *name) noexcept;
+
+}
+
+#endif
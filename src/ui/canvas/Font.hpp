@@ -41,8 +41,13 @@ typedef struct FT_FaceRec_ *FT_Face;
 
 #include <tchar.h>
 
+#ifdef USE_FREETYPE
+#include <memory>
+#endif
+
 class FontDescription;
 class TextUtil;
+class GlyphCache;
 struct TStringView;
 
 /**
@@ -52,6 +57,11 @@ class Font {
 protected:
 #ifdef USE_FREETYPE
   FT_Face face = nullptr;
+
+  /**
+   * Glyphs which have already been rendered by FreeType.
+   */
+  std::unique_ptr<GlyphCache> glyph_cache;
 #elif defined(ANDROID)
   TextUtil *text_util_object = nullptr;
 
@@ -69,10 +79,16 @@ protected:
   void CalculateHeights();
 
 public:
+#ifdef USE_FREETYPE
+  /* not inline, because #GlyphCache is an incomplete type here */
+  Font() noexcept;
+  ~Font() noexcept;
+#else
   Font() = default;
 
 #if !defined(USE_APPKIT) && !defined(USE_UIKIT)
   ~Font() { Destroy(); }
+#endif
 #endif
 
   Font(const Font &other) = delete;
@@ -84,6 +100,14 @@ public:
    */
   static void Initialise();
   static void Deinitialise();
+
+  /**
+   * Returns the number of glyphs which have been rendered by
+   * FreeType so far.  Each glyph is rendered only once per #Font;
+   * this is meant for benchmarks.
+   */
+  gcc_pure
+  static unsigned long GetRenderedGlyphCount() noexcept;
 #endif
 
 public:
@@ -27,6 +27,7 @@ Copyright_License {
 #include "Look/FontDescription.hpp"
 #include "util/TStringView.hxx"
 #include "Init.hpp"
+#include "GlyphCache.hpp"
 #include "Asset.hpp"
 #include "system/Path.hpp"
 
@@ -63,6 +64,12 @@ static Mutex freetype_mutex;
 static FT_Int32 load_flags = FT_LOAD_DEFAULT;
 static FT_Render_Mode render_mode = FT_RENDER_MODE_NORMAL;
 
+/**
+ * The number of glyphs rendered by FreeType so far.  Protected by
+ * #freetype_mutex.
+ */
+static unsigned long n_rendered_glyphs = 0;
+
 static AllocatedPath font_path = nullptr;
 static AllocatedPath bold_font_path = nullptr;
 static AllocatedPath italic_font_path = nullptr;
@@ -181,6 +188,7 @@ Font::LoadFile(const char *file, unsigned ptsize, bool bold, bool italic)
   // TODO: handle bold/italic
 
   face = new_face;
+  glyph_cache = std::make_unique<GlyphCache>();
   return true;
 }
 
@@ -218,6 +226,13 @@ Font::Load(const FontDescription &d)
   return LoadFile(path.c_str(), d.GetHeight(), bold, italic);
 }
 
+Font::Font() noexcept = default;
+
+Font::~Font() noexcept
+{
+  Destroy();
+}
+
 void
 Font::Destroy()
 {
@@ -226,10 +241,22 @@ Font::Destroy()
 
   assert(IsScreenInitialized());
 
+  glyph_cache.reset();
+
   ::FT_Done_Face(face);
   face = nullptr;
 }
 
+unsigned long
+Font::GetRenderedGlyphCount() noexcept
+{
+#ifndef ENABLE_OPENGL
+  const std::lock_guard<Mutex> lock(freetype_mutex);
+#endif
+
+  return n_rendered_glyphs;
+}
+
 template<typename F>
 static void
 ForEachChar(TStringView text, F &&f)
@@ -245,9 +272,98 @@ ForEachChar(TStringView text, F &&f)
   }
 }
 
+static void
+ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n)
+{
+  for (; n >= 8; n -= 8, ++src) {
+    for (unsigned i = 0x80; i != 0; i >>= 1)
+      *dest++ = (*src & i) ? 0xff : 0x00;
+  }
+
+  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
+    *dest++ = (*src & i) ? 0xff : 0x00;
+}
+
+/**
+ * Copy a FreeType bitmap to a packed 8 bit alpha buffer.
+ */
+static void
+CopyBitmap(uint8_t *dest, const FT_Bitmap &src)
+{
+  const unsigned char *s = src.buffer;
+  for (unsigned y = 0; y < unsigned(src.rows);
+       ++y, dest += src.width, s += src.pitch) {
+    if (IsMono())
+      /* with anti-aliasing disabled, FreeType writes each pixel in
+         one bit; convert it to 1 byte per pixel */
+      ConvertMono(dest, s, src.width);
+    else
+      std::copy_n(s, src.width, dest);
+  }
+}
+
+/**
+ * Load and render a glyph with FreeType and add it to the
+ * #GlyphCache.  Characters which are not available in this font are
+ * added, too (with index 0), so FreeType will not be asked again.
+ *
+ * Caller must hold #freetype_mutex.
+ */
+static const CachedGlyph &
+LoadGlyph(const FT_Face face, GlyphCache &cache, unsigned ch)
+{
+  CachedGlyph glyph{};
+
+  const FT_UInt i = FT_Get_Char_Index(face, ch);
+  if (i == 0 || FT_Load_Glyph(face, i, load_flags) != 0)
+    return cache.Add(ch, glyph);
+
+  const FT_GlyphSlot slot = face->glyph;
+  const FT_Glyph_Metrics &metrics = slot->metrics;
+
+  glyph.index = i;
+  glyph.left = FT_FLOOR(metrics.horiBearingX);
+  glyph.top = FT_FLOOR(metrics.horiBearingY);
+  glyph.width = FT_CEIL(metrics.width);
+  glyph.advance = FT_CEIL(metrics.horiAdvance);
+
+  ++n_rendered_glyphs;
+  const bool rendered = FT_Render_Glyph(slot, render_mode) == 0;
+  if (rendered) {
+    glyph.bitmap_width = slot->bitmap.width;
+    glyph.bitmap_height = slot->bitmap.rows;
+  }
+
+  const CachedGlyph &result = cache.Add(ch, glyph);
+  if (rendered)
+    CopyBitmap(cache.GetBitmap(result), slot->bitmap);
+
+  return result;
+}
+
+/**
+ * Caller must hold #freetype_mutex.
+ */
+static int
+GetKerning(const FT_Face face, GlyphCache &cache,
+           unsigned a, unsigned b)
+{
+  const int *cached = cache.LookupKerning(a, b);
+  if (cached != nullptr)
+    return *cached;
+
+  FT_Vector delta;
+  int result = FT_Get_Kerning(face, a, b, ft_kerning_default, &delta) == 0
+    ? int(delta.x >> 6)
+    : 0;
+  cache.AddKerning(a, b, result);
+  return result;
+}
+
 template<typename T, typename F>
 static void
-ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
+ForEachGlyph(const FT_Face face, GlyphCache &cache,
+             unsigned ascent_height, T &&text,
              F &&f)
 {
   const bool use_kerning = FT_HAS_KERNING(face);
@@ -260,35 +376,25 @@ ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
 #endif
 
   ForEachChar(std::forward<T>(text),
-              [face, ascent_height, &f, use_kerning,
+              [face, &cache, ascent_height, &f, use_kerning,
                &x, &prev_index](unsigned ch){
-      const FT_UInt i = FT_Get_Char_Index(face, ch);
-      if (i == 0)
-        return;
+      const CachedGlyph *glyph = cache.Lookup(ch);
+      if (glyph == nullptr)
+        glyph = &LoadGlyph(face, cache, ch);
 
-      const FT_Error error = FT_Load_Glyph(face, i, load_flags);
-      if (error)
+      if (!glyph->IsDefined())
         return;
 
-      const FT_GlyphSlot glyph = face->glyph;
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-
       if (use_kerning) {
-        if (prev_index != 0 && i != 0) {
-          FT_Vector delta;
-          FT_Get_Kerning(face, prev_index, i, ft_kerning_default,
-                         &delta);
-          x += delta.x >> 6;
-        }
-
-        prev_index = i;
+        if (prev_index != 0)
+          x += GetKerning(face, cache, prev_index, glyph->index);
+
+        prev_index = glyph->index;
       }
 
-      f(x + FT_FLOOR(metrics.horiBearingX),
-        ascent_height - FT_FLOOR(metrics.horiBearingY),
-        glyph);
+      f(x + glyph->left, int(ascent_height) - glyph->top, *glyph);
 
-      x += FT_CEIL(metrics.horiAdvance);
+      x += glyph->advance;
     });
 }
 
@@ -297,13 +403,10 @@ Font::TextSize(TStringView text) const noexcept
 {
   int maxx = 0;
 
-  ForEachGlyph(face, ascent_height, text,
-               [&maxx](int x, int y, const FT_GlyphSlot glyph){
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-      const int glyph_minx = FT_FLOOR(metrics.horiBearingX);
-      const int glyph_maxx = glyph_minx + FT_CEIL(metrics.width);
-
-      int z = x + glyph_maxx;
+  ForEachGlyph(face, *glyph_cache, ascent_height, text,
+               [&maxx](int x, int, const CachedGlyph &glyph){
+      /* x already includes the glyph's horizontal bearing */
+      int z = x + int(glyph.width);
       if (z > maxx)
         maxx = z;
     });
@@ -321,11 +424,9 @@ MixLine(uint8_t *dest, const uint8_t *src, size_t n)
 
 static void
 RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
-            const FT_Bitmap &bitmap, int x, int y)
+            const uint8_t *src, int width, int height, int x, int y)
 {
-  const uint8_t *src = (const uint8_t *)bitmap.buffer;
-  int width = bitmap.width, height = bitmap.rows;
-  int pitch = bitmap.pitch;
+  const int pitch = width;
 
   if (x < 0) {
     src -= x;
@@ -357,59 +458,18 @@ RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
     MixLine(buffer, src, width);
 }
 
-static void
-ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n)
-{
-  for (; n >= 8; n -= 8, ++src) {
-    for (unsigned i = 0x80; i != 0; i >>= 1)
-      *dest++ = (*src & i) ? 0xff : 0x00;
-  }
-
-  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
-    *dest++ = (*src & i) ? 0xff : 0x00;
-}
-
-static void
-ConvertMono(FT_Bitmap &dest, const FT_Bitmap &src)
-{
-  dest = src;
-  dest.pitch = dest.width;
-  dest.buffer = new unsigned char[dest.pitch * dest.rows];
-
-  unsigned char *d = dest.buffer, *s = src.buffer;
-  for (unsigned y = 0; y < unsigned(dest.rows);
-       ++y, d += dest.pitch, s += src.pitch)
-    ConvertMono(d, s, dest.width);
-}
-
-static void
-RenderGlyph(uint8_t *buffer, size_t width, size_t height,
-            FT_GlyphSlot glyph, int x, int y)
-{
-  FT_Error error = FT_Render_Glyph(glyph, render_mode);
-  if (error)
-    return;
-
-  if (IsMono()) {
-    /* with anti-aliasing disabled, FreeType writes each pixel in one
-       bit; hack: convert it to 1 byte per pixel and then render it */
-    FT_Bitmap bitmap;
-    ConvertMono(bitmap, glyph->bitmap);
-    RenderGlyph(buffer, width, height, bitmap, x, y);
-    delete[] bitmap.buffer;
-  } else
-    RenderGlyph(buffer, width, height, glyph->bitmap, x, y);
-}
-
 void
 Font::Render(TStringView text, const PixelSize size, void *_buffer) const
 {
   uint8_t *buffer = (uint8_t *)_buffer;
   std::fill_n(buffer, BufferSize(size), 0);
 
-  ForEachGlyph(face, ascent_height, text,
-               [size, buffer](int x, int y, const FT_GlyphSlot glyph){
-      RenderGlyph(buffer, size.cx, size.cy, glyph,
+  const GlyphCache &cache = *glyph_cache;
+  ForEachGlyph(face, *glyph_cache, ascent_height, text,
+               [size, buffer, &cache](int x, int y,
+                                      const CachedGlyph &glyph){
+      RenderGlyph(buffer, size.cx, size.cy, cache.GetBitmap(glyph),
+                  glyph.bitmap_width, glyph.bitmap_height,
                   x, y);
     });
 }
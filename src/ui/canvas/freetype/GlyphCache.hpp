@@ -0,0 +1,183 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_FREETYPE_GLYPH_CACHE_HPP
+#define XCSOAR_SCREEN_FREETYPE_GLYPH_CACHE_HPP
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * A rendered glyph in the #GlyphCache.
+ */
+struct CachedGlyph {
+  /**
+   * The FreeType glyph index, used for kerning.  Zero if the font
+   * does not have this character (or if loading it has failed); such
+   * a glyph is skipped.
+   */
+  unsigned index;
+
+  /**
+   * The horizontal bearing and the vertical bearing (distance from
+   * the base line to the top edge) in pixels.
+   */
+  int left, top;
+
+  /**
+   * The width of the glyph outline in pixels.  This is used for
+   * measuring text and may differ from #bitmap_width.
+   */
+  unsigned width;
+
+  /**
+   * The horizontal advance in pixels.
+   */
+  unsigned advance;
+
+  /**
+   * Dimensions of the 8 bit alpha bitmap.
+   */
+  unsigned bitmap_width, bitmap_height;
+
+  /**
+   * Position of the bitmap inside the atlas buffer.
+   */
+  std::size_t offset;
+
+  bool IsDefined() const noexcept {
+    return index != 0;
+  }
+};
+
+/**
+ * A per-font glyph atlas: each glyph is rendered by FreeType only
+ * once, and its 8 bit alpha bitmap is appended to one contiguous
+ * buffer.  Strings are then composed from these bitmaps without
+ * calling FreeType again.
+ *
+ * This class is not thread-safe; the caller is responsible for
+ * locking.
+ */
+class GlyphCache {
+  static constexpr unsigned N_DIRECT = 256;
+  static constexpr unsigned NONE = unsigned(-1);
+
+  /**
+   * Glyph lookup table for Latin-1 characters, which are the vast
+   * majority.  Each element is an index into #glyphs or #NONE.
+   */
+  std::array<unsigned, N_DIRECT> direct;
+
+  /**
+   * Glyph lookup for all other characters.
+   */
+  std::unordered_map<unsigned, unsigned> other;
+
+  std::vector<CachedGlyph> glyphs;
+
+  /**
+   * The bitmaps of all glyphs.
+   */
+  std::vector<uint8_t> pixels;
+
+  /**
+   * Kerning distances in pixels, indexed by both glyph indices.
+   */
+  std::unordered_map<uint_least64_t, int> kerning;
+
+public:
+  GlyphCache() noexcept {
+    direct.fill(NONE);
+  }
+
+  GlyphCache(const GlyphCache &) = delete;
+  GlyphCache &operator=(const GlyphCache &) = delete;
+
+  const CachedGlyph *Lookup(unsigned ch) const noexcept {
+    unsigned i;
+    if (ch < N_DIRECT) {
+      i = direct[ch];
+      if (i == NONE)
+        return nullptr;
+    } else {
+      auto j = other.find(ch);
+      if (j == other.end())
+        return nullptr;
+      i = j->second;
+    }
+
+    return &glyphs[i];
+  }
+
+  /**
+   * Add a new glyph.  The bitmap size is taken from
+   * #CachedGlyph::bitmap_width and #CachedGlyph::bitmap_height, and
+   * the #CachedGlyph::offset attribute is ignored.
+   *
+   * The new bitmap is uninitialised and must be filled by the
+   * caller with GetBitmap().
+   *
+   * @return the new glyph; the reference is valid until the next
+   * Add() call
+   */
+  const CachedGlyph &Add(unsigned ch, const CachedGlyph &glyph);
+
+  uint8_t *GetBitmap(const CachedGlyph &glyph) noexcept {
+    return pixels.data() + glyph.offset;
+  }
+
+  const uint8_t *GetBitmap(const CachedGlyph &glyph) const noexcept {
+    return pixels.data() + glyph.offset;
+  }
+
+  const int *LookupKerning(unsigned a, unsigned b) const noexcept {
+    auto i = kerning.find(KerningKey(a, b));
+    return i != kerning.end()
+      ? &i->second
+      : nullptr;
+  }
+
+  void AddKerning(unsigned a, unsigned b, int delta) {
+    kerning.emplace(KerningKey(a, b), delta);
+  }
+
+  /**
+   * Returns the size of the atlas buffer in bytes.
+   */
+  std::size_t GetAtlasSize() const noexcept {
+    return pixels.size();
+  }
+
+private:
+  static constexpr uint_least64_t KerningKey(unsigned a,
+                                             unsigned b) noexcept {
+    return (uint_least64_t(a) << 32) | b;
+  }
+};
+
+#endif
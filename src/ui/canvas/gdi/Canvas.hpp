@@ -345,6 +345,19 @@ public:
     ::Polygon(dc, lppt, cPoints);
   }
 
+  /**
+   * Draw a polygon whose points are relative to the given offset.
+   */
+  void DrawPolygon(const BulkPixelPoint *lppt, unsigned cPoints,
+                   PixelPoint offset) {
+    assert(IsDefined());
+
+    POINT old;
+    ::OffsetViewportOrgEx(dc, offset.x, offset.y, &old);
+    ::Polygon(dc, lppt, cPoints);
+    ::SetViewportOrgEx(dc, old.x, old.y, nullptr);
+  }
+
   void DrawTriangleFan(const BulkPixelPoint *points, unsigned num_points) {
     DrawPolygon(points, num_points);
   }
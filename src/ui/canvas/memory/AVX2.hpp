@@ -0,0 +1,136 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_AVX2_HPP
+#define XCSOAR_SCREEN_AVX2_HPP
+
+#include "ui/canvas/PortableColor.hpp"
+#include "util/Compiler.h"
+
+#ifndef __AVX2__
+#error AVX2 required
+#endif
+
+#include <immintrin.h>
+
+#include <stdint.h>
+
+/**
+ * Fill #n 32 bit pixels, eight at a time; the remainder is filled
+ * with scalar stores.
+ */
+gcc_hot gcc_nonnull_all
+static inline void
+AVX2FillPixels(uint32_t *p, unsigned n, uint32_t c)
+{
+  const __m256i v = _mm256_set1_epi32(c);
+
+  for (; n >= 8; n -= 8, p += 8)
+    _mm256_storeu_si256((__m256i *)p, v);
+
+  for (; n > 0; --n)
+    *p++ = c;
+}
+
+/**
+ * Implementation of AlphaPixelOperations using Intel AVX2
+ * instructions.  It processes eight BGRA pixels at a time with the
+ * same arithmetic as #MMXAlphaPixelOperations, therefore the results
+ * are identical.
+ */
+class AVX2AlphaPixelOperations {
+  uint8_t alpha;
+
+public:
+  constexpr AVX2AlphaPixelOperations(uint8_t _alpha):alpha(_alpha) {}
+
+  gcc_hot gcc_always_inline
+  static __m256i FillPixel(__m256i x, __m256i v_alpha, __m256i v_color) {
+    x = _mm256_mullo_epi16(x, v_alpha);
+    x = _mm256_add_epi16(x, v_color);
+    return _mm256_srli_epi16(x, 8);
+  }
+
+  gcc_hot gcc_flatten gcc_nonnull_all
+  void FillPixels(BGRA8Color *p, unsigned n, BGRA8Color c) const {
+    const __m256i v_alpha = _mm256_set1_epi16(alpha ^ 0xff);
+    const __m256i v_color =
+      _mm256_mullo_epi16(_mm256_setr_epi16(c.Blue(), c.Green(),
+                                           c.Red(), c.Alpha(),
+                                           c.Blue(), c.Green(),
+                                           c.Red(), c.Alpha(),
+                                           c.Blue(), c.Green(),
+                                           c.Red(), c.Alpha(),
+                                           c.Blue(), c.Green(),
+                                           c.Red(), c.Alpha()),
+                         _mm256_set1_epi16(alpha));
+    const __m256i zero = _mm256_setzero_si256();
+
+    __m256i *p2 = (__m256i *)p;
+
+    for (unsigned i = 0; i < n / 8; ++i) {
+      __m256i x = _mm256_loadu_si256(p2 + i);
+
+      __m256i lo = FillPixel(_mm256_unpacklo_epi8(x, zero), v_alpha, v_color);
+      __m256i hi = FillPixel(_mm256_unpackhi_epi8(x, zero), v_alpha, v_color);
+
+      _mm256_storeu_si256(p2 + i, _mm256_packus_epi16(lo, hi));
+    }
+  }
+
+  gcc_hot gcc_always_inline
+  static __m256i AlphaBlend8(__m256i p, __m256i q,
+                             __m256i alpha, __m256i inverse_alpha) {
+    p = _mm256_mullo_epi16(p, inverse_alpha);
+    q = _mm256_mullo_epi16(q, alpha);
+    return _mm256_srli_epi16(_mm256_add_epi16(p, q), 8);
+  }
+
+  gcc_hot gcc_flatten gcc_nonnull_all
+  void CopyPixels(BGRA8Color *gcc_restrict p,
+                  const BGRA8Color *gcc_restrict q, unsigned n) const {
+    const __m256i v_alpha = _mm256_set1_epi16(alpha);
+    const __m256i inverse_alpha = _mm256_set1_epi16(alpha ^ 0xff);
+    const __m256i zero = _mm256_setzero_si256();
+
+    __m256i *p2 = (__m256i *)p;
+    const __m256i *q2 = (const __m256i *)q;
+
+    for (unsigned i = 0; i < n / 8; ++i) {
+      __m256i pv = _mm256_loadu_si256(p2 + i);
+      __m256i qv = _mm256_loadu_si256(q2 + i);
+
+      __m256i lo = AlphaBlend8(_mm256_unpacklo_epi8(pv, zero),
+                               _mm256_unpacklo_epi8(qv, zero),
+                               v_alpha, inverse_alpha);
+
+      __m256i hi = AlphaBlend8(_mm256_unpackhi_epi8(pv, zero),
+                               _mm256_unpackhi_epi8(qv, zero),
+                               v_alpha, inverse_alpha);
+
+      _mm256_storeu_si256(p2 + i, _mm256_packus_epi16(lo, hi));
+    }
+  }
+};
+
+#endif
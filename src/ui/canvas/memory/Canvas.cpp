@@ -24,8 +24,8 @@ Copyright_License {
 #include "ui/canvas/Canvas.hpp"
 #include "ui/canvas/Bitmap.hpp"
 #include "ui/canvas/Util.hpp"
-#include "Optimised.hpp"
-#include "RasterCanvas.hpp"
+#include "SDLRasterCanvas.hpp"
+#include "RenderQueue.hpp"
 #include "ui/canvas/custom/Cache.hpp"
 #include "Math/Angle.hpp"
 #include "util/TStringView.hxx"
@@ -46,24 +46,22 @@ Copyright_License {
 #include <cassert>
 #include <string.h>
 
-class SDLRasterCanvas : public RasterCanvas<ActivePixelTraits> {
-public:
-  SDLRasterCanvas(WritableImageBuffer<ActivePixelTraits> buffer)
-    :RasterCanvas<ActivePixelTraits>(buffer) {}
-
-  static constexpr ActivePixelTraits::color_type Import(Color color) {
-#ifdef GREYSCALE
-    return Luminosity8(color.GetLuminosity());
-#else
-    return BGRA8Color(color.Red(), color.Green(), color.Blue(), color.Alpha());
-#endif
-  }
-};
+void
+Canvas::FlushDeferred() noexcept
+{
+  if (queue != nullptr)
+    queue->Flush(buffer);
+}
 
 void
 Canvas::DrawOutlineRectangle(int left, int top, int right, int bottom,
                              Color color)
 {
+  if (queue != nullptr) {
+    queue->OutlineRectangle(left, top, right, bottom, color);
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
   canvas.DrawRectangle(left, top, right, bottom,
                        canvas.Import(color));
@@ -76,6 +74,11 @@ Canvas::DrawFilledRectangle(int left, int top, int right, int bottom,
   if (left >= right || top >= bottom)
     return;
 
+  if (queue != nullptr) {
+    queue->FilledRectangle(left, top, right, bottom, color);
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
   canvas.FillRectangle(left, top, right, bottom,
                        canvas.Import(color));
@@ -91,25 +94,16 @@ Canvas::InvertRectangle(PixelRect r)
           buffer, r.left, r.top);
 }
 
-template<typename Canvas, typename PixelOperations>
-static void
-DrawPolyline(Canvas &canvas, PixelOperations operations, const Pen &pen,
-             const BulkPixelPoint *lppt, unsigned n_points,
-             bool loop)
-{
-  const unsigned thickness = pen.GetWidth();
-  const unsigned mask = pen.GetMask();
-  const auto color = canvas.Import(pen.GetColor());
-
-  canvas.DrawPolyline(lppt, n_points, loop, color, thickness, mask);
-}
-
 void
 Canvas::DrawPolyline(const BulkPixelPoint *p, unsigned cPoints)
 {
+  if (queue != nullptr) {
+    queue->Polyline(pen, p, cPoints, false);
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
-  ::DrawPolyline(canvas, ActivePixelTraits(), pen,
-                 p, cPoints, false);
+  canvas.PaintPolyline(pen, p, cPoints, false);
 }
 
 void
@@ -118,25 +112,39 @@ Canvas::DrawPolygon(const BulkPixelPoint *lppt, unsigned cPoints)
   if (brush.IsHollow() && !pen.IsDefined())
     return;
 
+  if (queue != nullptr) {
+    queue->Polygon(pen, brush, lppt, cPoints);
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
+  canvas.PaintPolygon(pen, brush, lppt, cPoints);
+}
+
+void
+Canvas::DrawPolygon(const BulkPixelPoint *lppt, unsigned cPoints,
+                    PixelPoint offset)
+{
+  if (brush.IsHollow() && !pen.IsDefined())
+    return;
 
-  if (!brush.IsHollow()) {
-    const auto color = canvas.Import(brush.GetColor());
-    if (brush.GetColor().IsOpaque())
-      canvas.FillPolygon(lppt, cPoints, color);
-    else
-      canvas.FillPolygon(lppt, cPoints, color,
-                         AlphaPixelOperations<ActivePixelTraits>(brush.GetColor().Alpha()));
+  if (queue != nullptr) {
+    queue->Polygon(pen, brush, lppt, cPoints, offset);
+    return;
   }
 
-  if (IsPenOverBrush())
-    ::DrawPolyline(canvas, ActivePixelTraits(), pen,
-                   lppt, cPoints, true);
+  SDLRasterCanvas canvas(buffer);
+  canvas.PaintPolygon(pen, brush, lppt, cPoints, offset);
 }
 
 void
 Canvas::DrawHLine(int x1, int x2, int y, Color color)
 {
+  if (queue != nullptr) {
+    queue->HLine(x1, x2, y, color);
+    return;
+  }
+
   SDLRasterCanvas canvas(buffer);
   canvas.DrawHLine(x1, x2, y, canvas.Import(color));
 }
@@ -144,45 +152,25 @@ Canvas::DrawHLine(int x1, int x2, int y, Color color)
 void
 Canvas::DrawLine(int ax, int ay, int bx, int by)
 {
-  const unsigned thickness = pen.GetWidth();
-  const unsigned mask = pen.GetMask();
+  if (queue != nullptr) {
+    queue->Line(pen, ax, ay, bx, by);
+    return;
+  }
 
   SDLRasterCanvas canvas(buffer);
-  const auto color = canvas.Import(pen.GetColor());
-  unsigned mask_position = 0;
-  if (thickness > 1)
-    canvas.DrawThickLine(ax, ay, bx, by, thickness, color,
-                         mask, mask_position);
-  else
-    canvas.DrawLine(ax, ay, bx, by, color, mask);
+  canvas.PaintLine(pen, ax, ay, bx, by);
 }
 
 void
 Canvas::DrawCircle(int x, int y, unsigned radius)
 {
-  SDLRasterCanvas canvas(buffer);
-
-  if (!brush.IsHollow()) {
-    const auto color = canvas.Import(brush.GetColor());
-
-    if (brush.GetColor().IsOpaque())
-      canvas.FillCircle(x, y, radius, color);
-    else
-      canvas.FillCircle(x, y, radius, color,
-                        AlphaPixelOperations<ActivePixelTraits>(brush.GetColor().Alpha()));
+  if (queue != nullptr) {
+    queue->Circle(pen, brush, x, y, radius);
+    return;
   }
 
-  if (IsPenOverBrush()) {
-    if (pen.GetWidth() < 2) {
-      canvas.DrawCircle(x, y, radius, canvas.Import(pen.GetColor()));
-      return;
-    }
-
-    // no thickCircleColor in SDL_gfx, so need to emulate it with multiple draws (slow!)
-    for (int i= (pen.GetWidth()/2); i>= -(int)(pen.GetWidth()-1)/2; --i) {
-      canvas.DrawCircle(x, y, radius + i, canvas.Import(pen.GetColor()));
-    }
-  }
+  SDLRasterCanvas canvas(buffer);
+  canvas.PaintCircle(pen, brush, x, y, radius);
 }
 
 void
@@ -304,6 +292,8 @@ Canvas::DrawText(int x, int y, const TCHAR *text)
   if (s.data == nullptr)
     return;
 
+  FlushDeferred();
+
   SDLRasterCanvas canvas(buffer);
   CopyTextRectangle(canvas, x, y, s.width, s.height, s,
                     text_color, background_color,
@@ -322,6 +312,8 @@ Canvas::DrawTransparentText(int x, int y, const TCHAR *text)
   if (s.data == nullptr)
     return;
 
+  FlushDeferred();
+
   SDLRasterCanvas canvas(buffer);
   ColoredAlphaPixelOperations<ActivePixelTraits, GreyscalePixelTraits>
     transparent(canvas.Import(text_color));
@@ -348,6 +340,8 @@ Canvas::DrawClippedText(int x, int y, unsigned width, const TCHAR *text)
   if (s.data == nullptr)
     return;
 
+  FlushDeferred();
+
   if (width > s.width)
     width = s.width;
 
@@ -411,6 +405,7 @@ Canvas::Copy(int dest_x, int dest_y,
       !Clip(dest_y, dest_height, GetHeight(), src_y))
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   canvas.CopyRectangle(dest_x, dest_y, dest_width, dest_height,
                        src.At(src_x, src_y), src.pitch);
@@ -454,6 +449,7 @@ Canvas::CopyTransparentWhite(PixelPoint dest_position, PixelSize dest_size,
       !Clip(dest_position.y, dest_size.cy, GetHeight(), src_position.y))
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   TransparentPixelOperations<ActivePixelTraits> operations(canvas.Import(COLOR_WHITE));
   canvas.CopyRectangle(dest_position.x, dest_position.y,
@@ -472,6 +468,7 @@ Canvas::StretchTransparentWhite(PixelPoint dest_position, PixelSize dest_size,
       !Clip(dest_position.y, dest_size.cy, GetHeight(), src_position.y))
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   TransparentPixelOperations<ActivePixelTraits> operations(canvas.Import(COLOR_WHITE));
   canvas.ScaleRectangle(dest_position, dest_size,
@@ -490,6 +487,7 @@ Canvas::StretchNot(const Bitmap &_src)
   const unsigned dest_x = 0, dest_y = 0;
   const auto dest_size = GetSize();
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
   BitNotPixelOperations<ActivePixelTraits> operations;
 
@@ -518,6 +516,7 @@ Canvas::Stretch(PixelPoint dest_position, PixelSize dest_size,
     /* paranoid sanity check; shouldn't ever happen */
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   canvas.ScaleRectangle(dest_position, dest_size,
@@ -573,6 +572,7 @@ Canvas::StretchMono(PixelPoint dest_position, PixelSize dest_size,
     /* paranoid sanity check; shouldn't ever happen */
     return;
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   OpaqueTextPixelOperations<ActivePixelTraits, GreyscalePixelTraits>
@@ -589,6 +589,7 @@ Canvas::CopyNot(int dest_x, int dest_y,
                 unsigned dest_width, unsigned dest_height,
                 ConstImageBuffer src, int src_x, int src_y)
 {
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   canvas.CopyRectangle(dest_x, dest_y, dest_width, dest_height,
@@ -601,6 +602,7 @@ Canvas::CopyOr(int dest_x, int dest_y,
                unsigned dest_width, unsigned dest_height,
                ConstImageBuffer src, int src_x, int src_y)
 {
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   canvas.CopyRectangle(dest_x, dest_y, dest_width, dest_height,
@@ -613,6 +615,7 @@ Canvas::CopyNotOr(int dest_x, int dest_y,
                   unsigned dest_width, unsigned dest_height,
                   ConstImageBuffer src, int src_x, int src_y)
 {
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   canvas.CopyRectangle(dest_x, dest_y, dest_width, dest_height,
@@ -636,6 +639,7 @@ Canvas::CopyAnd(int dest_x, int dest_y,
                 unsigned dest_width, unsigned dest_height,
                 ConstImageBuffer src, int src_x, int src_y)
 {
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   canvas.CopyRectangle(dest_x, dest_y, dest_width, dest_height,
@@ -701,6 +705,7 @@ Canvas::AlphaBlend(PixelPoint dest_position, PixelSize dest_size,
 {
   // TODO: support scaling
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   AlphaPixelOperations<ActivePixelTraits> operations(alpha);
@@ -730,6 +735,7 @@ Canvas::AlphaBlendNotWhite(PixelPoint dest_position, PixelSize dest_size,
 {
   // TODO: support scaling
 
+  FlushDeferred();
   SDLRasterCanvas canvas(buffer);
 
   NotWhiteCondition<ActivePixelTraits> c;
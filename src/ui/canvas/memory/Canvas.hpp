@@ -35,6 +35,8 @@ Copyright_License {
 #include "ActivePixelTraits.hpp"
 #include "util/Compiler.h"
 
+#include <cassert>
+
 #include <tchar.h>
 
 #ifdef _WIN32
@@ -46,6 +48,7 @@ Copyright_License {
 
 class Angle;
 class Bitmap;
+class RenderQueue;
 
 /**
  * Base drawable canvas class
@@ -67,6 +70,12 @@ protected:
     OPAQUE, TRANSPARENT
   } background_mode = OPAQUE;
 
+  /**
+   * If set, then geometric primitives are recorded here instead of
+   * being rasterised immediately.  See BeginDeferred().
+   */
+  RenderQueue *queue = nullptr;
+
 public:
   Canvas()
     :buffer(WritableImageBuffer<ActivePixelTraits>::Empty()) {}
@@ -78,6 +87,38 @@ public:
     buffer = _buffer;
   }
 
+  /**
+   * Enable deferred rendering: from now on, polygons, lines,
+   * rectangles and circles are recorded into the given queue, and
+   * rasterised in parallel when another operation (text, bitmaps,
+   * copies) needs the pixels, or when EndDeferred() is called.  The
+   * result is the same as with immediate rendering.
+   *
+   * While deferred rendering is active, this canvas must not be used
+   * as the source of a copy without calling FlushDeferred() first,
+   * and it must not be resized or destroyed.
+   */
+  void BeginDeferred(RenderQueue &_queue) noexcept {
+    assert(queue == nullptr);
+
+    queue = &_queue;
+  }
+
+  /**
+   * Rasterise all pending commands and switch back to immediate
+   * rendering.
+   */
+  void EndDeferred() noexcept {
+    FlushDeferred();
+    queue = nullptr;
+  }
+
+  /**
+   * Rasterise all pending commands (if deferred rendering is
+   * active).
+   */
+  void FlushDeferred() noexcept;
+
 protected:
   /**
    * Returns true if the outline should be drawn after the area has
@@ -249,6 +290,12 @@ public:
   void DrawPolyline(const BulkPixelPoint *points, unsigned num_points);
   void DrawPolygon(const BulkPixelPoint *points, unsigned num_points);
 
+  /**
+   * Draw a polygon whose points are relative to the given offset.
+   */
+  void DrawPolygon(const BulkPixelPoint *points, unsigned num_points,
+                   PixelPoint offset);
+
   void DrawTriangleFan(const BulkPixelPoint *points, unsigned num_points) {
     DrawPolygon(points, num_points);
   }
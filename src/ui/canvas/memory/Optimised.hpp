@@ -34,6 +34,10 @@ Copyright_License {
 #include "MMX.hpp"
 #endif
 
+#ifdef __AVX2__
+#include "AVX2.hpp"
+#endif
+
 /**
  * This class hosts two base classes: one that is optimised (e.g. via
  * SIMD) and one that is portable (but slow).  The optimised one will
@@ -149,15 +153,37 @@ public:
 
 #ifndef GREYSCALE
 
+using MMXBGRAAlphaPixelOperations =
+  SelectOptimisedPixelOperations<MMXAlphaPixelOperations, 2,
+                                 PortableAlphaPixelOperations<BGRAPixelTraits>>;
+
+#ifdef __AVX2__
+
+/**
+ * Blend eight pixels at a time with AVX2, and the remainder with MMX
+ * (which uses the same arithmetic).
+ */
 template<>
 class AlphaPixelOperations<BGRAPixelTraits>
-  : public SelectOptimisedPixelOperations<MMXAlphaPixelOperations, 2,
-                                          PortableAlphaPixelOperations<BGRAPixelTraits>> {
+  : public SelectOptimisedPixelOperations<AVX2AlphaPixelOperations, 8,
+                                          MMXBGRAAlphaPixelOperations> {
 public:
   explicit constexpr AlphaPixelOperations(const uint8_t alpha)
     :SelectOptimisedPixelOperations(alpha) {}
 };
 
+#else
+
+template<>
+class AlphaPixelOperations<BGRAPixelTraits>
+  : public MMXBGRAAlphaPixelOperations {
+public:
+  explicit constexpr AlphaPixelOperations(const uint8_t alpha)
+    :SelectOptimisedPixelOperations(alpha) {}
+};
+
+#endif /* !__AVX2__ */
+
 #endif /* !GREYSCALE */
 
 #endif
@@ -28,6 +28,7 @@ Copyright_License {
 #include "Bresenham.hpp"
 #include "Murphy.hpp"
 #include "ui/dim/Point.hpp"
+#include "ui/dim/Size.hpp"
 #include "util/AllocatedArray.hxx"
 #include "util/Compiler.h"
 
@@ -62,13 +63,34 @@ public:
 private:
   WritableImageBuffer<PixelTraits> buffer;
 
+  /**
+   * Only rows in the range [clip_top, clip_bottom) are written.  This
+   * is used to rasterise horizontal bands of the buffer in parallel;
+   * unlike a smaller #buffer, it does not change how primitives are
+   * clipped at the buffer edges, so the result within the band is
+   * identical.
+   */
+  int clip_top = 0, clip_bottom;
+
   AllocatedArray<int> polygon_buffer;
   AllocatedArray<BresenhamIterator> edge_buffer;
 
 public:
   RasterCanvas(WritableImageBuffer<PixelTraits> _buffer,
                PixelTraits _traits=PixelTraits())
-    :PixelTraits(_traits), buffer(_buffer) {}
+    :PixelTraits(_traits), buffer(_buffer), clip_bottom(_buffer.height) {}
+
+  /**
+   * Restrict all following drawing operations to the rows
+   * [top, bottom).
+   */
+  void ClipRows(unsigned top, unsigned bottom) {
+    assert(top <= bottom);
+    assert(bottom <= buffer.height);
+
+    clip_top = top;
+    clip_bottom = bottom;
+  }
 
 protected:
   PixelTraits &GetPixelTraits() {
@@ -76,7 +98,15 @@ protected:
   }
 
   constexpr bool Check(unsigned x, unsigned y) const {
-    return buffer.Check(x, y);
+    return buffer.Check(x, y) && IsRowVisible(y);
+  }
+
+  constexpr bool IsRowVisible(int y) const {
+    return y >= clip_top && y < clip_bottom;
+  }
+
+  constexpr bool IsRowClipped() const {
+    return clip_top > 0 || unsigned(clip_bottom) < buffer.height;
   }
 
   pointer At(unsigned x, unsigned y) {
@@ -263,14 +293,14 @@ public:
     if (x1 < 0)
       x1 = 0;
 
-    if (y1 < 0)
-      y1 = 0;
+    if (y1 < clip_top)
+      y1 = clip_top;
 
     if (x2 > int(buffer.width))
       x2 = buffer.width;
 
-    if (y2 > int(buffer.height))
-      y2 = buffer.height;
+    if (y2 > clip_bottom)
+      y2 = clip_bottom;
 
     if (x1 >= x2 || y1 >= y2)
       return;
@@ -290,7 +320,7 @@ public:
   template<typename PixelOperations>
   void DrawHLine(int x1, int x2, int y, color_type c,
                  PixelOperations operations) {
-    if (y < 0 || unsigned(y) >= buffer.height)
+    if (!IsRowVisible(y))
       return;
 
     if (x1 < 0)
@@ -317,11 +347,11 @@ public:
     if (x < 0 || unsigned(x) >= buffer.width)
       return;
 
-    if (y1 < 0)
-      y1 = 0;
+    if (y1 < clip_top)
+      y1 = clip_top;
 
-    if (y2 > int(buffer.height))
-      y2 = buffer.height;
+    if (y2 > clip_bottom)
+      y2 = clip_bottom;
 
     if (y1 >= y2)
       return;
@@ -363,13 +393,36 @@ public:
     int pixx = PixelTraits::CalcIncrement(sx) * sizeof(*p);
     int pixy = sy * buffer.pitch;
 
-    if (dx < dy) {
+    const bool steep = dx < dy;
+    if (steep) {
       std::swap(dx, dy);
       std::swap(pixx, pixy);
     }
 
     unsigned lmp = line_mask_position;
 
+    if (IsRowClipped()) {
+      /* slow path: track the current row and skip pixels outside of
+         the clipped band */
+      const int rowx = steep ? sy : 0, rowy = steep ? 0 : sy;
+
+      for (int x = 0, y = 0, row = y1; x < dx;
+           x++, p = PixelTraits::NextByte(p, pixx), row += rowx) {
+        if ((lmp++ | line_mask) == unsigned(-1) && IsRowVisible(row))
+          PixelTraits::WritePixel(p, c);
+
+        y += dy;
+        if (y >= dx) {
+          y -= dx;
+          p = PixelTraits::NextByte(p, pixy);
+          row += rowy;
+        }
+      }
+
+      line_mask_position = lmp;
+      return;
+    }
+
     for (int x = 0, y = 0; x < dx; x++, p = PixelTraits::NextByte(p, pixx)) {
       if ((lmp++ | line_mask) == unsigned(-1))
         PixelTraits::WritePixel(p, c);
@@ -415,12 +468,16 @@ public:
     line_mask_position = murphy.GetLineMaskPosition();
   }
 
+  /**
+   * @param offset is added to all points
+   */
   void DrawPolyline(const PixelPoint *points, unsigned n, bool loop,
                     color_type color,
                     unsigned thickness,
-                    unsigned line_mask=-1) {
+                    unsigned line_mask=-1,
+                    PixelPoint offset=PixelPoint(0, 0)) {
 
-    auto p_last = points[loop? n-1 : 0];
+    auto p_last = points[loop? n-1 : 0] + offset;
     unsigned code2_orig;
     unsigned code2;
     bool last_visible = false;
@@ -430,7 +487,7 @@ public:
     unsigned line_mask_position = 0;
 
     for (unsigned i= loop? 0: 1; i<n; ++i) {
-      auto p_this = points[i];
+      auto p_this = points[i] + offset;
       if (!last_visible) {
         // don't have a start point yet
         code2_orig = ClipEncode(p_last.x, p_last.y);
@@ -460,19 +517,23 @@ public:
           code2_orig = code1_orig;
         } else {
           last_visible = false;
-          p_last = points[i];
+          p_last = points[i] + offset;
         }
       } else {
         last_visible = false;
-        p_last = points[i];
+        p_last = points[i] + offset;
       }
     }
 
   }
 
+  /**
+   * @param offset is added to all points
+   */
   template<typename PixelOperations>
   void FillPolygonFast(const PixelPoint *points, unsigned n, color_type color,
-                       PixelOperations operations) {
+                       PixelOperations operations,
+                       PixelPoint offset=PixelPoint(0, 0)) {
 
     assert(points != nullptr);
 
@@ -482,27 +543,28 @@ public:
     edge_buffer.GrowDiscard(n);
 
     // initialise buffer of edge iterators, and find y range to scan
-    int miny = points[0].y;
-    int maxy = points[0].y;
+    int miny = points[0].y + offset.y;
+    int maxy = miny;
 
     const auto *p_1 = points;
-    const auto *p_0 = points + n - 1;
+    auto p_0 = points[n - 1] + offset;
     int n_edges = 0;
 
     while (p_1 < points+n) {
-      if (p_1->y == p_0->y) {
+      const auto p = *p_1 + offset;
+      if (p.y == p_0.y) {
         // don't add horizontal line, just draw it now?
-      } else if (p_1->y < p_0->y) {
-        edge_buffer[n_edges] = BresenhamIterator(p_1->x, p_1->y, p_0->x, p_0->y);
+      } else if (p.y < p_0.y) {
+        edge_buffer[n_edges] = BresenhamIterator(p.x, p.y, p_0.x, p_0.y);
         n_edges++;
       } else {
-        edge_buffer[n_edges] = BresenhamIterator(p_0->x, p_0->y, p_1->x, p_1->y);
+        edge_buffer[n_edges] = BresenhamIterator(p_0.x, p_0.y, p.x, p.y);
         n_edges++;
       }
-      miny = std::min(p_0->y, miny);
-      maxy = std::max(p_0->y, maxy);
+      miny = std::min(p_0.y, miny);
+      maxy = std::max(p_0.y, maxy);
 
-      p_0 = p_1;
+      p_0 = p;
       p_1++;
     }
 
@@ -515,6 +577,9 @@ public:
     // sort array by y value (top best), then x value (left best)
     std::sort(edge_start, edge_end, BresenhamIterator::CompareVerticalHorizontal);
 
+    /* rows below the clipped band don't influence the rows above */
+    maxy = std::min(maxy, clip_bottom - 1);
+
     // perform scans
 
     for (int y = miny; y <= maxy; y++) {
@@ -571,7 +636,8 @@ public:
 
   template<typename PixelOperations>
   void FillPolygon(const PixelPoint *points, unsigned n, color_type color,
-                   PixelOperations operations) {
+                   PixelOperations operations,
+                   PixelPoint offset=PixelPoint(0, 0)) {
     assert(points != nullptr);
 
     if (n < 3)
@@ -592,8 +658,12 @@ public:
         maxy = points[i].y;
     }
 
-    // Draw, scanning y
-    for (int y = miny; y <= maxy; y++) {
+    // Draw, scanning y (each row is independent from the others)
+    for (int screen_y = std::max(miny + offset.y, clip_top),
+           y_end = std::min(maxy + offset.y, clip_bottom - 1);
+         screen_y <= y_end; screen_y++) {
+      /* the row in the coordinate system of the points */
+      const int y = screen_y - offset.y;
       unsigned n_ints = 0;
       for (unsigned i = 0; i < n; i++) {
         unsigned ind1, ind2;
@@ -632,14 +702,15 @@ public:
         xa = (xa >> 16) + ((xa & 32768) >> 15);
         int xb = ints[i+1] - 1;
         xb = (xb >> 16) + ((xb & 32768) >> 15);
-        DrawHLine(xa, xb, y, color, operations);
+        DrawHLine(xa + offset.x, xb + offset.x, screen_y, color, operations);
       }
     }
   }
 
-  void FillPolygon(const PixelPoint *points, unsigned n, color_type color) {
+  void FillPolygon(const PixelPoint *points, unsigned n, color_type color,
+                   PixelPoint offset=PixelPoint(0, 0)) {
     FillPolygonFast(points, n, color,
-                    GetPixelTraits());
+                    GetPixelTraits(), offset);
 //    FillPolygon(points, n, color,
 //                GetPixelTraits());
   }
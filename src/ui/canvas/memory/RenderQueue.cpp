@@ -0,0 +1,347 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "RenderQueue.hpp"
+#include "SDLRasterCanvas.hpp"
+#include "thread/StandbyThread.hpp"
+#include "thread/Util.hpp"
+
+#include <algorithm>
+
+/**
+ * Don't use threads for less than this many pixels (estimated from
+ * the bounding boxes); waking them up would cost more than it
+ * saves.
+ */
+static constexpr uint64_t MIN_PARALLEL_AREA = 128 * 1024;
+
+/**
+ * The minimum height of one band.
+ */
+static constexpr unsigned MIN_BAND_HEIGHT = 16;
+
+/**
+ * Rasterises one band of the buffer.  The threads are started on the
+ * first parallel Flush() and then wait for the next one, so a frame
+ * does not pay for creating and joining threads.
+ */
+class RenderQueue::BandThread final : StandbyThread {
+  const RenderQueue &queue;
+
+  /* the job; protected by the mutex */
+  WritableImageBuffer<ActivePixelTraits> buffer;
+  unsigned top, bottom;
+
+  /**
+   * Was the current job done by the thread?  If the thread could not
+   * be started, Finish() does it.
+   */
+  bool done;
+
+public:
+  explicit BandThread(const RenderQueue &_queue) noexcept
+    :StandbyThread("RenderBand"), queue(_queue) {}
+
+  ~BandThread() noexcept {
+    LockStop();
+  }
+
+  void Start(WritableImageBuffer<ActivePixelTraits> _buffer,
+             unsigned _top, unsigned _bottom) noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    buffer = _buffer;
+    top = _top;
+    bottom = _bottom;
+    done = false;
+    Trigger();
+  }
+
+  /**
+   * Wait for the job to finish.
+   */
+  void Finish() noexcept {
+    std::unique_lock<Mutex> lock(mutex);
+    WaitDone(lock);
+
+    if (!done) {
+      /* the thread could not be started: render the band here */
+      const ScopeUnlock unlock(mutex);
+      Render();
+    }
+  }
+
+private:
+  void Render() const noexcept {
+    SDLRasterCanvas canvas(buffer);
+    canvas.ClipRows(top, bottom);
+    queue.Render(canvas, top, bottom);
+  }
+
+protected:
+  void Tick() noexcept override {
+    {
+      const ScopeUnlock unlock(mutex);
+      Render();
+    }
+
+    done = true;
+  }
+};
+
+RenderQueue::RenderQueue(unsigned _n_threads) noexcept
+{
+  SetThreadCount(_n_threads);
+}
+
+RenderQueue::~RenderQueue() noexcept = default;
+
+void
+RenderQueue::SetThreadCount(unsigned _n_threads) noexcept
+{
+  /* surplus threads are kept, but won't get any work */
+  n_threads = _n_threads > 0 ? _n_threads : GetProcessorCount();
+}
+
+RenderQueue::Command &
+RenderQueue::Append(Type type, int top, int bottom,
+                    int left, int right) noexcept
+{
+  if (bottom > top && right > left)
+    area += uint64_t(bottom - top) * uint64_t(right - left);
+
+  commands.emplace_back();
+  Command &c = commands.back();
+  c.type = type;
+  c.top = top;
+  c.bottom = bottom;
+  c.n_points = 0;
+  return c;
+}
+
+RenderQueue::Command &
+RenderQueue::Append(Type type, const Pen &pen,
+                    const BulkPixelPoint *p, unsigned n,
+                    PixelPoint offset) noexcept
+{
+  const unsigned first_point = points.size();
+  points.resize(first_point + n);
+  BulkPixelPoint *dest = points.data() + first_point;
+
+  /* translate the points while copying them */
+  int left = p[0].x, right = p[0].x, top = p[0].y, bottom = p[0].y;
+  for (unsigned i = 0; i < n; ++i) {
+    left = std::min<int>(left, p[i].x);
+    right = std::max<int>(right, p[i].x);
+    top = std::min<int>(top, p[i].y);
+    bottom = std::max<int>(bottom, p[i].y);
+    dest[i] = BulkPixelPoint(p[i].x + offset.x, p[i].y + offset.y);
+  }
+
+  left += offset.x;
+  right += offset.x;
+  top += offset.y;
+  bottom += offset.y;
+
+  /* wide lines may extend beyond the points */
+  const int margin = pen.IsDefined() ? int(pen.GetWidth()) + 2 : 1;
+
+  Command &c = Append(type, top - margin, bottom + margin,
+                      left - margin, right + margin);
+  c.pen = pen;
+  c.first_point = first_point;
+  c.n_points = n;
+  return c;
+}
+
+void
+RenderQueue::Polyline(const Pen &pen,
+                      const BulkPixelPoint *p, unsigned n,
+                      bool loop) noexcept
+{
+  if (n == 0)
+    return;
+
+  Command &c = Append(Type::POLYLINE, pen, p, n, PixelPoint(0, 0));
+  c.a = loop;
+}
+
+void
+RenderQueue::Polygon(const Pen &pen, const Brush &brush,
+                     const BulkPixelPoint *p, unsigned n,
+                     PixelPoint offset) noexcept
+{
+  if (n == 0)
+    return;
+
+  Command &c = Append(Type::POLYGON, pen, p, n, offset);
+  c.brush = brush;
+}
+
+void
+RenderQueue::Line(const Pen &pen, int ax, int ay, int bx, int by) noexcept
+{
+  const int margin = int(pen.GetWidth()) + 2;
+  Command &c = Append(Type::LINE,
+                      std::min(ay, by) - margin, std::max(ay, by) + margin,
+                      std::min(ax, bx) - margin, std::max(ax, bx) + margin);
+  c.pen = pen;
+  c.a = ax;
+  c.b = ay;
+  c.c = bx;
+  c.d = by;
+}
+
+void
+RenderQueue::Circle(const Pen &pen, const Brush &brush,
+                    int x, int y, unsigned radius) noexcept
+{
+  const int extent = int(radius + pen.GetWidth()) + 1;
+  Command &c = Append(Type::CIRCLE, y - extent, y + extent + 1,
+                      x - extent, x + extent + 1);
+  c.pen = pen;
+  c.brush = brush;
+  c.a = x;
+  c.b = y;
+  c.c = radius;
+}
+
+void
+RenderQueue::HLine(int x1, int x2, int y, Color color) noexcept
+{
+  Command &c = Append(Type::HLINE, y, y + 1, x1, x2);
+  c.color = color;
+  c.a = x1;
+  c.b = x2;
+  c.c = y;
+}
+
+void
+RenderQueue::FilledRectangle(int left, int top, int right, int bottom,
+                             Color color) noexcept
+{
+  Command &c = Append(Type::FILLED_RECTANGLE, top, bottom, left, right);
+  c.color = color;
+  c.a = left;
+  c.b = top;
+  c.c = right;
+  c.d = bottom;
+}
+
+void
+RenderQueue::OutlineRectangle(int left, int top, int right, int bottom,
+                              Color color) noexcept
+{
+  /* only the outline is painted; count it as four lines */
+  Command &c = Append(Type::OUTLINE_RECTANGLE, top, bottom, 0, 0);
+  area += 2 * uint64_t(std::max(right - left, 0) +
+                       std::max(bottom - top, 0));
+  c.color = color;
+  c.a = left;
+  c.b = top;
+  c.c = right;
+  c.d = bottom;
+}
+
+void
+RenderQueue::Render(SDLRasterCanvas &canvas,
+                    int top, int bottom) const noexcept
+{
+  for (const auto &c : commands) {
+    if (c.bottom <= top || c.top >= bottom)
+      /* doesn't touch this band */
+      continue;
+
+    switch (c.type) {
+    case Type::POLYLINE:
+      canvas.PaintPolyline(c.pen, points.data() + c.first_point,
+                           c.n_points, c.a);
+      break;
+
+    case Type::POLYGON:
+      canvas.PaintPolygon(c.pen, c.brush, points.data() + c.first_point,
+                          c.n_points);
+      break;
+
+    case Type::LINE:
+      canvas.PaintLine(c.pen, c.a, c.b, c.c, c.d);
+      break;
+
+    case Type::CIRCLE:
+      canvas.PaintCircle(c.pen, c.brush, c.a, c.b, c.c);
+      break;
+
+    case Type::HLINE:
+      canvas.DrawHLine(c.a, c.b, c.c, canvas.Import(c.color));
+      break;
+
+    case Type::FILLED_RECTANGLE:
+      canvas.FillRectangle(c.a, c.b, c.c, c.d, canvas.Import(c.color));
+      break;
+
+    case Type::OUTLINE_RECTANGLE:
+      canvas.DrawRectangle(c.a, c.b, c.c, c.d, canvas.Import(c.color));
+      break;
+    }
+  }
+}
+
+void
+RenderQueue::Flush(WritableImageBuffer<ActivePixelTraits> buffer) noexcept
+{
+  if (commands.empty())
+    return;
+
+  const unsigned n_bands = area >= MIN_PARALLEL_AREA
+    ? std::clamp(buffer.height / MIN_BAND_HEIGHT, 1u, n_threads)
+    : 1u;
+
+  if (n_bands <= 1) {
+    SDLRasterCanvas canvas(buffer);
+    Render(canvas, 0, buffer.height);
+    Clear();
+    return;
+  }
+
+  const unsigned band_height = (buffer.height + n_bands - 1) / n_bands;
+
+  auto thread = threads.begin();
+  for (unsigned top = band_height; top < buffer.height;
+       top += band_height, ++thread) {
+    if (thread == threads.end())
+      thread = threads.emplace(thread, *this);
+
+    thread->Start(buffer, top, std::min(top + band_height, buffer.height));
+  }
+
+  const auto end = thread;
+
+  /* the calling thread rasterises the first band itself */
+  SDLRasterCanvas canvas(buffer);
+  canvas.ClipRows(0, band_height);
+  Render(canvas, 0, band_height);
+
+  for (thread = threads.begin(); thread != end; ++thread)
+    thread->Finish();
+
+  Clear();
+}
@@ -0,0 +1,180 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_MEMORY_RENDER_QUEUE_HPP
+#define XCSOAR_SCREEN_MEMORY_RENDER_QUEUE_HPP
+
+#include "Buffer.hpp"
+#include "ActivePixelTraits.hpp"
+#include "ui/canvas/Pen.hpp"
+#include "ui/canvas/Brush.hpp"
+#include "ui/dim/BulkPoint.hpp"
+
+#include <list>
+#include <vector>
+#include <cstdint>
+
+class SDLRasterCanvas;
+
+/**
+ * A list of geometric primitives recorded by a #Canvas in deferred
+ * mode (see Canvas::BeginDeferred()).  Flush() splits the buffer into
+ * horizontal bands and rasterises them in parallel; each band replays
+ * all commands touching it, in the order they were recorded, which
+ * gives exactly the same pixels as drawing them immediately.
+ *
+ * Only operations which are pure geometry are recorded; everything
+ * else (text, bitmaps, copies) flushes the queue first.
+ */
+class RenderQueue {
+  enum class Type : uint8_t {
+    POLYLINE,
+    POLYGON,
+    LINE,
+    CIRCLE,
+    HLINE,
+    FILLED_RECTANGLE,
+    OUTLINE_RECTANGLE,
+  };
+
+  struct Command {
+    Type type;
+
+    Pen pen;
+    Brush brush;
+    Color color;
+
+    /**
+     * The range of rows which may be modified by this command
+     * (conservative, including the pen width).
+     */
+    int top, bottom;
+
+    /**
+     * Coordinates; for #CIRCLE, this is x, y and the radius.
+     */
+    int a, b, c, d;
+
+    /**
+     * A range in #RenderQueue::points.
+     */
+    unsigned first_point, n_points;
+  };
+
+  std::vector<Command> commands;
+  std::vector<BulkPixelPoint> points;
+
+  /**
+   * The sum of the bounding box areas of all #commands.  This is a
+   * rough estimate of the rasterisation cost, used to decide whether
+   * it's worth starting threads.
+   */
+  uint64_t area = 0;
+
+  unsigned n_threads;
+
+  class BandThread;
+
+  /**
+   * Worker threads for all bands but the first one; created on
+   * demand and kept until this object is destroyed.
+   */
+  std::list<BandThread> threads;
+
+public:
+  /**
+   * @param _n_threads the maximum number of threads (including the
+   * calling thread) used by Flush(); 0 means one per CPU core
+   */
+  explicit RenderQueue(unsigned _n_threads=0) noexcept;
+  ~RenderQueue() noexcept;
+
+  RenderQueue(const RenderQueue &) = delete;
+  RenderQueue &operator=(const RenderQueue &) = delete;
+
+  unsigned GetThreadCount() const noexcept {
+    return n_threads;
+  }
+
+  /**
+   * @param _n_threads see constructor
+   */
+  void SetThreadCount(unsigned _n_threads) noexcept;
+
+  /**
+   * Does it make sense to use this queue, i.e. is there more than
+   * one thread to rasterise?
+   */
+  bool IsParallel() const noexcept {
+    return n_threads > 1;
+  }
+
+  bool IsEmpty() const noexcept {
+    return commands.empty();
+  }
+
+  void Clear() noexcept {
+    commands.clear();
+    points.clear();
+    area = 0;
+  }
+
+  void Polyline(const Pen &pen,
+                const BulkPixelPoint *p, unsigned n, bool loop) noexcept;
+
+  /**
+   * @param offset is added to all points
+   */
+  void Polygon(const Pen &pen, const Brush &brush,
+               const BulkPixelPoint *p, unsigned n,
+               PixelPoint offset=PixelPoint(0, 0)) noexcept;
+
+  void Line(const Pen &pen, int ax, int ay, int bx, int by) noexcept;
+  void Circle(const Pen &pen, const Brush &brush,
+              int x, int y, unsigned radius) noexcept;
+  void HLine(int x1, int x2, int y, Color color) noexcept;
+  void FilledRectangle(int left, int top, int right, int bottom,
+                       Color color) noexcept;
+  void OutlineRectangle(int left, int top, int right, int bottom,
+                        Color color) noexcept;
+
+  /**
+   * Rasterise all recorded commands into the buffer and clear the
+   * queue.
+   */
+  void Flush(WritableImageBuffer<ActivePixelTraits> buffer) noexcept;
+
+private:
+  Command &Append(Type type, int top, int bottom,
+                  int left, int right) noexcept;
+  Command &Append(Type type, const Pen &pen,
+                  const BulkPixelPoint *p, unsigned n,
+                  PixelPoint offset) noexcept;
+
+  /**
+   * Replay all commands which touch the given band.
+   */
+  void Render(SDLRasterCanvas &canvas, int top, int bottom) const noexcept;
+};
+
+#endif
@@ -0,0 +1,129 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_MEMORY_SDL_RASTER_CANVAS_HPP
+#define XCSOAR_SCREEN_MEMORY_SDL_RASTER_CANVAS_HPP
+
+#include "RasterCanvas.hpp"
+#include "Optimised.hpp"
+#include "ActivePixelTraits.hpp"
+#include "ui/canvas/Pen.hpp"
+#include "ui/canvas/Brush.hpp"
+#include "ui/dim/BulkPoint.hpp"
+
+/**
+ * The #RasterCanvas for the active pixel format.  Its Paint*()
+ * methods implement the geometric primitives of #Canvas with a given
+ * pen and brush; they are shared by the immediate and the deferred
+ * (#RenderQueue) code paths, so both produce the same pixels.
+ */
+class SDLRasterCanvas : public RasterCanvas<ActivePixelTraits> {
+public:
+  SDLRasterCanvas(WritableImageBuffer<ActivePixelTraits> buffer)
+    :RasterCanvas<ActivePixelTraits>(buffer) {}
+
+  static constexpr ActivePixelTraits::color_type Import(Color color) {
+#ifdef GREYSCALE
+    return Luminosity8(color.GetLuminosity());
+#else
+    return BGRA8Color(color.Red(), color.Green(), color.Blue(), color.Alpha());
+#endif
+  }
+
+  /**
+   * Returns true if the outline should be drawn after the area has
+   * been filled.  As an optimization, this function returns false if
+   * brush and pen share the same color.
+   */
+  static bool IsPenOverBrush(const Pen &pen, const Brush &brush) {
+    return pen.IsDefined() &&
+      (brush.IsHollow() || brush.GetColor() != pen.GetColor());
+  }
+
+  void PaintPolyline(const Pen &pen,
+                     const BulkPixelPoint *points, unsigned n,
+                     bool loop, PixelPoint offset=PixelPoint(0, 0)) {
+    DrawPolyline(points, n, loop, Import(pen.GetColor()),
+                 pen.GetWidth(), pen.GetMask(), offset);
+  }
+
+  void PaintPolygon(const Pen &pen, const Brush &brush,
+                    const BulkPixelPoint *points, unsigned n,
+                    PixelPoint offset=PixelPoint(0, 0)) {
+    if (brush.IsHollow() && !pen.IsDefined())
+      return;
+
+    if (!brush.IsHollow()) {
+      const auto color = Import(brush.GetColor());
+      if (brush.GetColor().IsOpaque())
+        FillPolygon(points, n, color, offset);
+      else
+        FillPolygon(points, n, color,
+                    AlphaPixelOperations<ActivePixelTraits>(brush.GetColor().Alpha()),
+                    offset);
+    }
+
+    if (IsPenOverBrush(pen, brush))
+      PaintPolyline(pen, points, n, true, offset);
+  }
+
+  void PaintLine(const Pen &pen, int ax, int ay, int bx, int by) {
+    const unsigned thickness = pen.GetWidth();
+    const unsigned mask = pen.GetMask();
+
+    const auto color = Import(pen.GetColor());
+    unsigned mask_position = 0;
+    if (thickness > 1)
+      DrawThickLine(ax, ay, bx, by, thickness, color,
+                    mask, mask_position);
+    else
+      DrawLine(ax, ay, bx, by, color, mask);
+  }
+
+  void PaintCircle(const Pen &pen, const Brush &brush,
+                   int x, int y, unsigned radius) {
+    if (!brush.IsHollow()) {
+      const auto color = Import(brush.GetColor());
+
+      if (brush.GetColor().IsOpaque())
+        FillCircle(x, y, radius, color);
+      else
+        FillCircle(x, y, radius, color,
+                   AlphaPixelOperations<ActivePixelTraits>(brush.GetColor().Alpha()));
+    }
+
+    if (IsPenOverBrush(pen, brush)) {
+      if (pen.GetWidth() < 2) {
+        DrawCircle(x, y, radius, Import(pen.GetColor()));
+        return;
+      }
+
+      // no thickCircleColor in SDL_gfx, so need to emulate it with multiple draws (slow!)
+      for (int i= (pen.GetWidth()/2); i>= -(int)(pen.GetWidth()-1)/2; --i) {
+        DrawCircle(x, y, radius + i, Import(pen.GetColor()));
+      }
+    }
+  }
+};
+
+#endif
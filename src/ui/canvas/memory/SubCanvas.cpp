@@ -33,6 +33,10 @@ ClipMax(unsigned limit, int offset, unsigned size) {
 
 SubCanvas::SubCanvas(Canvas &canvas, PixelPoint _offset, PixelSize _size)
 {
+  /* the SubCanvas draws immediately; rasterise what the parent has
+     deferred so far to keep the order */
+  canvas.FlushDeferred();
+
   buffer = canvas.buffer;
   buffer.data = buffer.At(_offset.x, _offset.y);
   buffer.width = ClipMax(buffer.width, _offset.x, _size.cx);
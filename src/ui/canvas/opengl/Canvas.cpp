@@ -220,6 +220,29 @@ Canvas::DrawPolygon(const BulkPixelPoint *points, unsigned num_points)
   }
 }
 
+void
+Canvas::DrawPolygon(const BulkPixelPoint *points, unsigned num_points,
+                    PixelPoint _offset)
+{
+  assert(offset == OpenGL::translate);
+
+  if (_offset.x == 0 && _offset.y == 0) {
+    DrawPolygon(points, num_points);
+    return;
+  }
+
+  /* translate in the vertex shader instead of copying the points */
+  OpenGL::translate += _offset;
+  glVertexAttrib4f(OpenGL::Attribute::TRANSLATE,
+                   OpenGL::translate.x, OpenGL::translate.y, 0, 0);
+
+  DrawPolygon(points, num_points);
+
+  OpenGL::translate -= _offset;
+  glVertexAttrib4f(OpenGL::Attribute::TRANSLATE,
+                   OpenGL::translate.x, OpenGL::translate.y, 0, 0);
+}
+
 void
 Canvas::DrawTriangleFan(const BulkPixelPoint *points, unsigned num_points)
 {
@@ -276,6 +276,12 @@ public:
 
   void DrawPolygon(const BulkPixelPoint *points, unsigned num_points);
 
+  /**
+   * Draw a polygon whose points are relative to the given offset.
+   */
+  void DrawPolygon(const BulkPixelPoint *points, unsigned num_points,
+                   PixelPoint offset);
+
   /**
    * Draw a triangle fan (GL_TRIANGLE_FAN).  The first point is the
    * origin of the fan.
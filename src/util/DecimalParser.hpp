@@ -0,0 +1,80 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_DECIMAL_PARSER_HPP
+#define XCSOAR_DECIMAL_PARSER_HPP
+
+#include <cstdint>
+
+/**
+ * Exact powers of ten which can be represented by a double.
+ */
+static constexpr double decimal_pow10_table[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/**
+ * Parse a plain decimal number ("12", "-12.345") with integer
+ * arithmetic: a mantissa below 2^53 divided by an exact power of ten
+ * is rounded correctly, so the result is the same as with strtod(),
+ * but without consulting the locale.
+ *
+ * Unlike strtod(), this does not skip leading whitespace.
+ *
+ * @return false if this is not a plain decimal number (e.g. it has an
+ * exponent, it is hexadecimal, "inf" or has too many digits); the
+ * caller should then use strtod()
+ */
+template<typename C>
+static inline bool
+ParsePlainDecimal(const C *p, const C **endptr, double &value_r) noexcept
+{
+  const bool negative = *p == '-';
+  if (negative || *p == '+')
+    ++p;
+
+  uint_least64_t mantissa = 0;
+  unsigned n_digits = 0, n_fraction = 0;
+
+  for (; *p >= '0' && *p <= '9'; ++p, ++n_digits)
+    mantissa = mantissa * 10 + (*p - '0');
+
+  if (*p == '.')
+    for (++p; *p >= '0' && *p <= '9'; ++p, ++n_digits, ++n_fraction)
+      mantissa = mantissa * 10 + (*p - '0');
+
+  if (n_digits == 0 || n_digits > 19 ||
+      mantissa > (uint_least64_t(1) << 53) ||
+      n_fraction >= sizeof(decimal_pow10_table) / sizeof(decimal_pow10_table[0]) ||
+      (*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z'))
+    return false;
+
+  *endptr = p;
+
+  const double value = double(mantissa) / decimal_pow10_table[n_fraction];
+  value_r = negative ? -value : value;
+  return true;
+}
+
+#endif
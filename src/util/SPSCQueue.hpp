@@ -0,0 +1,110 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SPSC_QUEUE_HPP
+#define XCSOAR_SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * A fixed-size lock-free queue for exactly one producer thread and
+ * exactly one consumer thread.  Items are written and read in place,
+ * which avoids copying large items twice.
+ *
+ * @param N the capacity; must be a power of two
+ */
+template<typename T, std::size_t N>
+class SPSCQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+  std::array<T, N> items;
+
+  /**
+   * The number of items ever consumed.  Written only by the
+   * consumer.
+   */
+  alignas(64) std::atomic_size_t head{0};
+
+  /**
+   * The number of items ever produced.  Written only by the
+   * producer.
+   */
+  alignas(64) std::atomic_size_t tail{0};
+
+public:
+  /**
+   * May be called by both threads, but the result may be outdated
+   * already.
+   */
+  bool IsEmpty() const noexcept {
+    return head.load(std::memory_order_acquire) ==
+      tail.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Producer: obtain the next free item.  Call Push() after filling
+   * it.
+   *
+   * @return nullptr if the queue is full
+   */
+  T *BeginPush() noexcept {
+    const std::size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) >= N)
+      return nullptr;
+
+    return &items[t % N];
+  }
+
+  /**
+   * Producer: publish the item returned by BeginPush().
+   */
+  void Push() noexcept {
+    tail.store(tail.load(std::memory_order_relaxed) + 1,
+               std::memory_order_seq_cst);
+  }
+
+  /**
+   * Consumer: obtain the oldest item.  Call Pop() when done with it.
+   *
+   * @return nullptr if the queue is empty
+   */
+  T *Front() noexcept {
+    const std::size_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire))
+      return nullptr;
+
+    return &items[h % N];
+  }
+
+  /**
+   * Consumer: release the item returned by Front().
+   */
+  void Pop() noexcept {
+    head.store(head.load(std::memory_order_relaxed) + 1,
+               std::memory_order_seq_cst);
+  }
+};
+
+#endif
@@ -0,0 +1,223 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program compares the packed airspace R-tree with an R*-tree
+ * built by inserting one airspace at a time, which is what the
+ * #Airspaces class used before.  It measures build time and the
+ * throughput of box, segment and point queries.
+ */
+
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Geo/Flat/BoostFlatBoundingBox.hpp"
+#include "system/Args.hpp"
+#include "system/Clock.hpp"
+#include "io/FileLineReader.hpp"
+#include "Operation/Operation.hpp"
+#include "util/PrintException.hxx"
+
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/geometries/linestring.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace bgi = boost::geometry::index;
+
+struct AirspaceIndexable {
+  typedef FlatBoundingBox result_type;
+
+  result_type operator()(const Airspace &airspace) const {
+    return airspace;
+  }
+};
+
+typedef bgi::rtree<Airspace, bgi::rstar<16>, AirspaceIndexable> BoostTree;
+typedef PackedRTree<Airspace> PackedTree;
+
+static constexpr unsigned NUM_QUERIES = 100000;
+
+struct QuerySet {
+  std::vector<FlatBoundingBox> boxes;
+  std::vector<std::pair<FlatGeoPoint, FlatGeoPoint>> segments;
+  std::vector<FlatGeoPoint> points;
+};
+
+static FlatGeoPoint
+RandomPoint(const FlatBoundingBox &bounds)
+{
+  return FlatGeoPoint(bounds.GetLeft() + rand() % (bounds.GetWidth() + 1),
+                      bounds.GetBottom() + rand() % (bounds.GetHeight() + 1));
+}
+
+/**
+ * Generate random queries within the bounds of the airspace
+ * database.  Boxes and segments are about 1/20 of the database
+ * extent, which is roughly what a zoomed-in map or an airspace
+ * warning look-ahead covers.
+ */
+static QuerySet
+MakeQueries(const FlatBoundingBox &bounds)
+{
+  const unsigned size = std::max(std::max(bounds.GetWidth(),
+                                          bounds.GetHeight()) / 20, 1u);
+
+  QuerySet q;
+  for (unsigned i = 0; i < NUM_QUERIES; ++i) {
+    const FlatGeoPoint p = RandomPoint(bounds);
+    q.boxes.emplace_back(p, size / 2);
+    q.segments.emplace_back(p, p + FlatGeoPoint(rand() % size - size / 2,
+                                                rand() % size - size / 2));
+    q.points.push_back(RandomPoint(bounds));
+  }
+
+  return q;
+}
+
+static void
+PrintResult(const char *name, const char *what,
+            uint64_t duration, unsigned hits)
+{
+  printf("%s %s: %.1fms (%.0f queries/s) hits=%u\n",
+         name, what, duration / 1000.,
+         NUM_QUERIES * 1e6 / std::max(duration, uint64_t(1)), hits);
+}
+
+static void
+BenchmarkBoost(const std::vector<Airspace> &items, const QuerySet &q)
+{
+  uint64_t start = MonotonicClockUS();
+  BoostTree tree;
+  for (const auto &i : items)
+    tree.insert(i);
+  printf("boost build: %.2fms\n", (MonotonicClockUS() - start) / 1000.);
+
+  unsigned hits = 0;
+  start = MonotonicClockUS();
+  for (const auto &box : q.boxes)
+    for (auto i = tree.qbegin(bgi::intersects(box)); i != tree.qend(); ++i)
+      ++hits;
+  PrintResult("boost", "box", MonotonicClockUS() - start, hits);
+
+  hits = 0;
+  start = MonotonicClockUS();
+  for (const auto &s : q.segments) {
+    boost::geometry::model::linestring<FlatGeoPoint> line;
+    line.push_back(s.first);
+    line.push_back(s.second);
+    for (auto i = tree.qbegin(bgi::intersects(line)); i != tree.qend(); ++i)
+      ++hits;
+  }
+  PrintResult("boost", "segment", MonotonicClockUS() - start, hits);
+
+  hits = 0;
+  start = MonotonicClockUS();
+  for (const auto &p : q.points) {
+    const FlatBoundingBox box(p, p);
+    for (auto i = tree.qbegin(bgi::intersects(box)); i != tree.qend(); ++i)
+      ++hits;
+  }
+  PrintResult("boost", "point", MonotonicClockUS() - start, hits);
+}
+
+static void
+BenchmarkPacked(const std::vector<Airspace> &items, const QuerySet &q)
+{
+  uint64_t start = MonotonicClockUS();
+  PackedTree tree;
+  tree.Build(std::vector<Airspace>(items));
+  printf("packed build: %.2fms\n", (MonotonicClockUS() - start) / 1000.);
+
+  unsigned hits = 0;
+  start = MonotonicClockUS();
+  for (const auto &box : q.boxes)
+    for (auto i = tree.qbegin(PackedTree::Query(box)); i != tree.qend(); ++i)
+      ++hits;
+  PrintResult("packed", "box", MonotonicClockUS() - start, hits);
+
+  hits = 0;
+  start = MonotonicClockUS();
+  for (const auto &s : q.segments) {
+    const PackedTree::Query query(s.first, s.second);
+    for (auto i = tree.qbegin(query); i != tree.qend(); ++i)
+      ++hits;
+  }
+  PrintResult("packed", "segment", MonotonicClockUS() - start, hits);
+
+  hits = 0;
+  start = MonotonicClockUS();
+  for (const auto &p : q.points) {
+    const PackedTree::Query query(FlatBoundingBox(p, p));
+    for (auto i = tree.qbegin(query); i != tree.qend(); ++i)
+      ++hits;
+  }
+  PrintResult("packed", "point", MonotonicClockUS() - start, hits);
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH");
+  const auto path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  FileLineReader reader(path, Charset::AUTO);
+
+  Airspaces airspaces;
+  AirspaceParser parser(airspaces);
+
+  NullOperationEnvironment operation;
+  if (!parser.Parse(reader, operation)) {
+    fprintf(stderr, "Failed to parse input file\n");
+    return EXIT_FAILURE;
+  }
+
+  airspaces.Optimise();
+
+  if (airspaces.IsEmpty()) {
+    fprintf(stderr, "No airspaces\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Airspace> items;
+  FlatBoundingBox bounds = *airspaces.QueryAll().begin();
+  for (const auto &i : airspaces.QueryAll()) {
+    items.push_back(i);
+    bounds.Merge(i);
+  }
+
+  printf("%u airspaces\n", unsigned(items.size()));
+
+  const QuerySet queries = MakeQueries(bounds);
+  BenchmarkBoost(items, queries);
+  BenchmarkPacked(items, queries);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,259 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program measures the latency from an NMEA vario sentence to
+ * the corresponding frequency change in the synthesised audio vario
+ * PCM stream.
+ *
+ * A feeder thread generates $PTAS1 sentences which alternate between
+ * two vario values (i.e. two tone frequencies), stamps them, and
+ * parses them with the generic NMEA parser.  An "audio" thread
+ * synthesises blocks of PCM data at the real sample rate, estimates
+ * each block's frequency by counting zero crossings, and stamps the
+ * block where the frequency changes.
+ *
+ * This is done twice: once with the value being passed to the
+ * synthesiser by a WorkerThread with the timings of MergeThread
+ * ("merge"), and once with the value being passed directly after
+ * parsing ("direct"), which is what DeviceDescriptor does now.
+ */
+
+#include "Audio/VarioSynthesiser.hpp"
+#include "Device/Parser.hpp"
+#include "NMEA/Info.hpp"
+#include "NMEA/Checksum.hpp"
+#include "thread/WorkerThread.hpp"
+#include "thread/Mutex.hxx"
+#include "system/Args.hpp"
+#include "util/NumberParser.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned sample_rate = 44100;
+
+/**
+ * The size of one audio block; 10 ms, which is a typical period size
+ * for ALSA and OpenSL/ES.
+ */
+static constexpr unsigned block_size = sample_rate / 100;
+
+/**
+ * Two $PTAS1 sentences: -5 m/s (minimum frequency) and 0 m/s (zero
+ * frequency).  Both produce a continuous tone.
+ */
+static const char *const sentences[2] = {
+  "$PTAS1,103,200,02000,080",
+  "$PTAS1,200,200,02000,080",
+};
+
+/**
+ * Shared state between the "device" (the feeder) and the simulated
+ * MergeThread, i.e. a minimal DeviceBlackboard.
+ */
+struct Blackboard {
+  Mutex mutex;
+  NMEAInfo basic;
+};
+
+/**
+ * Passes the vario value to the synthesiser with the timings of the
+ * real MergeThread.
+ */
+class MergeSimulation final : public WorkerThread {
+  Blackboard &blackboard;
+  VarioSynthesiser &synthesiser;
+
+public:
+  MergeSimulation(Blackboard &_blackboard, VarioSynthesiser &_synthesiser)
+    :WorkerThread("MergeThread", 50, 20, 10),
+     blackboard(_blackboard), synthesiser(_synthesiser) {}
+
+protected:
+  void Tick() noexcept override {
+    NMEAInfo basic;
+
+    {
+      const std::lock_guard<Mutex> lock(blackboard.mutex);
+      basic = blackboard.basic;
+    }
+
+    if (basic.total_energy_vario_available)
+      synthesiser.SetVario(basic.total_energy_vario);
+  }
+};
+
+/**
+ * Estimate which of the two sentences the block was synthesised from
+ * by counting its rising zero crossings.
+ */
+static unsigned
+ClassifyBlock(const int16_t *buffer, std::size_t n)
+{
+  unsigned crossings = 0;
+  for (std::size_t i = 1; i < n; ++i)
+    if (buffer[i - 1] < 0 && buffer[i] >= 0)
+      ++crossings;
+
+  /* 200 Hz gives 2 crossings per 10 ms block, 500 Hz gives 5 */
+  return crossings >= 4;
+}
+
+static double
+Percentile(const std::vector<double> &sorted, unsigned percent)
+{
+  std::size_t i = sorted.size() * percent / 100;
+  if (i >= sorted.size())
+    i = sorted.size() - 1;
+  return sorted[i];
+}
+
+static void
+Run(const char *name, bool direct, unsigned rate, unsigned seconds,
+    bool smooth)
+{
+  VarioSynthesiser synthesiser(sample_rate);
+  synthesiser.SetSmoothFrequency(smooth);
+
+  Blackboard blackboard;
+  blackboard.basic.Reset();
+
+  MergeSimulation merge(blackboard, synthesiser);
+  if (!direct)
+    merge.Start();
+
+  /* the time each kind of sentence was last received */
+  std::atomic<Clock::rep> received[2] = {{0}, {0}};
+
+  std::atomic<bool> running{true};
+  std::vector<double> latencies;
+
+  std::thread audio([&]{
+    std::vector<int16_t> buffer(block_size);
+    unsigned previous = 0;
+    auto deadline = Clock::now();
+
+    while (running.load(std::memory_order_relaxed)) {
+      synthesiser.Synthesise(buffer.data(), buffer.size());
+      const auto now = Clock::now();
+
+      const unsigned current = ClassifyBlock(buffer.data(), buffer.size());
+      const auto stamp = received[current].load(std::memory_order_acquire);
+      if (current != previous && stamp != 0)
+        latencies.push_back(std::chrono::duration<double, std::milli>(now.time_since_epoch() - Clock::duration(stamp)).count());
+      previous = current;
+
+      /* simulate a sound card consuming one block per period */
+      deadline += std::chrono::milliseconds(10);
+      std::this_thread::sleep_until(deadline);
+    }
+  });
+
+  NMEAParser parser;
+  const auto interval = std::chrono::microseconds(1000000 / rate);
+  auto next = Clock::now();
+
+  for (unsigned i = 0; i < rate * seconds; ++i) {
+    next += interval;
+
+    /* random jitter, to avoid running in lockstep with the audio
+       thread */
+    std::this_thread::sleep_until(next + std::chrono::microseconds(rand() % 10000));
+
+    char line[64];
+    snprintf(line, sizeof(line), "%s", sentences[i % 2]);
+    AppendNMEAChecksum(line);
+
+    received[i % 2].store(Clock::now().time_since_epoch().count(),
+                          std::memory_order_release);
+
+    {
+      const std::lock_guard<Mutex> lock(blackboard.mutex);
+      NMEAInfo &basic = blackboard.basic;
+      basic.clock = std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+      basic.alive.Update(basic.clock);
+
+      if (parser.ParseLine(line, basic) && direct)
+        synthesiser.SetVario(basic.total_energy_vario);
+    }
+
+    if (!direct)
+      merge.Trigger();
+  }
+
+  running.store(false, std::memory_order_relaxed);
+  audio.join();
+
+  if (!direct) {
+    merge.BeginStop();
+    merge.Join();
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  if (latencies.empty()) {
+    printf("%s: no frequency changes detected\n", name);
+    return;
+  }
+
+  printf("%s: %u changes, p50=%.1f ms p99=%.1f ms max=%.1f ms\n",
+         name, unsigned(latencies.size()),
+         Percentile(latencies, 50), Percentile(latencies, 99),
+         latencies.back());
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[RATE_HZ [SECONDS]]");
+
+  unsigned rate = 10, seconds = 5;
+  if (!args.IsEmpty())
+    rate = ParseUnsigned(args.ExpectNext());
+  if (!args.IsEmpty())
+    seconds = ParseUnsigned(args.ExpectNext());
+  args.ExpectEnd();
+
+  if (rate == 0 || rate > 100 || seconds == 0) {
+    fprintf(stderr, "Invalid arguments\n");
+    return EXIT_FAILURE;
+  }
+
+  Run("merge", false, rate, seconds, false);
+  Run("direct", true, rate, seconds, false);
+  Run("direct+smooth", true, rate, seconds, true);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
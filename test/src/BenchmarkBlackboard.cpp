@@ -0,0 +1,197 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program replays a flight and measures the cost of passing
+ * each fix's #MoreData and #DerivedInfo from the merge thread through
+ * the calculation thread to the UI and map window blackboards, once
+ * with owned copies at every stage ("copy", the scheme used before
+ * #SnapshotBlackboard), and once with shared immutable snapshots
+ * ("snapshot", the current scheme).
+ *
+ * It also measures InterfaceBlackboard::ReadCommonStats() against the
+ * full #DerivedInfo copy which updating an immutable snapshot would
+ * need.
+ */
+
+#include "Blackboard/InterfaceBlackboard.hpp"
+#include "Blackboard/SnapshotBlackboard.hpp"
+#include "DebugReplay.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <memory>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+  const char *name;
+  unsigned cycles = 0;
+  uint_least64_t bytes = 0;
+  Clock::duration duration{};
+
+  explicit Result(const char *_name):name(_name) {}
+
+  void Print() const {
+    if (cycles == 0)
+      return;
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    printf("%-24s %8u cycles %8lu bytes/cycle %8lu ns/cycle\n",
+           name, cycles,
+           (unsigned long)(bytes / cycles),
+           (unsigned long)(ns / cycles));
+  }
+};
+
+/**
+ * Every stage owns a copy: the calculation thread copies #MoreData
+ * from the #DeviceBlackboard and #DerivedInfo back, and each UI
+ * blackboard copies both.
+ */
+struct CopyPipeline {
+  MoreData device_basic, computer_basic, ui_basic, map_basic;
+  DerivedInfo computer_calculated, device_calculated;
+  DerivedInfo ui_calculated, map_calculated;
+
+  Result result{"copy"};
+
+  CopyPipeline() {
+    device_basic.Reset();
+    computer_calculated.Reset();
+  }
+
+  void Step(const MoreData &basic, const DerivedInfo &calculated) {
+    /* the merge thread's and the glide computer's own work, which
+       both schemes share */
+    device_basic = basic;
+    computer_calculated = calculated;
+
+    const auto start = Clock::now();
+    computer_basic = device_basic;
+    device_calculated = computer_calculated;
+    ui_basic = device_basic;
+    ui_calculated = device_calculated;
+    map_basic = ui_basic;
+    map_calculated = ui_calculated;
+    result.bytes += 3 * sizeof(MoreData) + 3 * sizeof(DerivedInfo);
+    result.duration += Clock::now() - start;
+    ++result.cycles;
+  }
+};
+
+/**
+ * Snapshots are copied once per modification and then shared.
+ */
+struct SnapshotPipeline {
+  MoreData device_basic, computer_basic;
+  DerivedInfo computer_calculated;
+
+  InterfaceBlackboard ui;
+  MoreDataSnapshot map_basic;
+  DerivedInfoSnapshot map_calculated;
+
+  Result result{"snapshot"};
+  Result common_stats_full{"common stats (copy all)"};
+  Result common_stats{"common stats"};
+
+  SnapshotPipeline() {
+    device_basic.Reset();
+    computer_calculated.Reset();
+  }
+
+  void Step(const MoreData &basic, const DerivedInfo &calculated) {
+    device_basic = basic;
+    computer_calculated = calculated;
+
+    const auto start = Clock::now();
+    MoreDataSnapshot basic_snapshot =
+      std::make_shared<const MoreData>(device_basic);
+    computer_basic = *basic_snapshot;
+    DerivedInfoSnapshot calculated_snapshot =
+      std::make_shared<DerivedInfo>(computer_calculated);
+    ui.ReadBlackboardBasic(basic_snapshot);
+    ui.ReadBlackboardCalculated(calculated_snapshot);
+    map_basic = std::move(basic_snapshot);
+    map_calculated = std::move(calculated_snapshot);
+    result.bytes += 2 * sizeof(MoreData) + sizeof(DerivedInfo);
+    result.duration += Clock::now() - start;
+    ++result.cycles;
+  }
+
+  /**
+   * Emulate a task navigation event (see InputEvents::eventAdjustWaypoint()).
+   */
+  void ReadCommonStats(const CommonStats &stats) {
+    auto start = Clock::now();
+    auto modified = std::make_shared<DerivedInfo>(ui.Calculated());
+    modified->common_stats = stats;
+    common_stats_full.duration += Clock::now() - start;
+    common_stats_full.bytes += sizeof(DerivedInfo);
+    ++common_stats_full.cycles;
+
+    start = Clock::now();
+    ui.ReadCommonStats(stats);
+    common_stats.duration += Clock::now() - start;
+    common_stats.bytes += sizeof(CommonStats);
+    ++common_stats.cycles;
+  }
+};
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "DRIVER FILE");
+  std::unique_ptr<DebugReplay> replay(CreateDebugReplay(args));
+  if (!replay)
+    return EXIT_FAILURE;
+
+  args.ExpectEnd();
+
+  printf("sizeof(MoreData)=%zu sizeof(DerivedInfo)=%zu"
+         " sizeof(CommonStats)=%zu\n",
+         sizeof(MoreData), sizeof(DerivedInfo), sizeof(CommonStats));
+
+  auto copy = std::make_unique<CopyPipeline>();
+  auto snapshot = std::make_unique<SnapshotPipeline>();
+
+  while (replay->Next()) {
+    copy->Step(replay->Basic(), replay->Calculated());
+    snapshot->Step(replay->Basic(), replay->Calculated());
+    snapshot->ReadCommonStats(replay->Calculated().common_stats);
+  }
+
+  copy->result.Print();
+  snapshot->result.Print();
+  snapshot->common_stats_full.Print();
+  snapshot->common_stats.Print();
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,274 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program renders a dense synthetic map scene (topography
+ * areas and lines, translucent airspaces, waypoints with labels, a
+ * task) into an off-screen memory canvas, first with immediate and
+ * then with deferred (multi-threaded) rasterisation, reports the
+ * time per frame and verifies that both produce the same pixels.
+ */
+
+#include "ui/canvas/VirtualCanvas.hpp"
+#include "ui/canvas/memory/RenderQueue.hpp"
+#include "system/Args.hpp"
+#include "system/Clock.hpp"
+#include "util/PrintException.hxx"
+
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static constexpr unsigned DEFAULT_WIDTH = 1280, DEFAULT_HEIGHT = 800;
+static constexpr unsigned DEFAULT_COUNT = 20;
+
+class BenchmarkCanvas final : public VirtualCanvas {
+public:
+  using VirtualCanvas::VirtualCanvas;
+
+  [[gnu::pure]]
+  bool operator==(const BenchmarkCanvas &other) const noexcept {
+    for (unsigned y = 0; y < buffer.height; ++y)
+      if (memcmp(buffer.At(0, y), other.buffer.At(0, y),
+                 buffer.width * sizeof(*buffer.data)) != 0)
+        return false;
+
+    return true;
+  }
+};
+
+struct Shape {
+  std::vector<BulkPixelPoint> points;
+  Color color;
+  unsigned width;
+  Pen::Style style;
+};
+
+struct Scene {
+  std::vector<Shape> areas, lines, airspaces;
+  std::vector<BulkPixelPoint> waypoints;
+  std::vector<BulkPixelPoint> task;
+  BenchmarkCanvas label;
+
+  Scene(PixelSize size);
+
+  void Paint(Canvas &canvas) const;
+};
+
+static Color
+RandomColor(std::minstd_rand &r, uint8_t alpha=Color::OPAQUE)
+{
+  return Color(r() & 0xff, r() & 0xff, r() & 0xff, alpha);
+}
+
+/**
+ * Generate a closed, roughly star-shaped polygon.
+ */
+static std::vector<BulkPixelPoint>
+MakeArea(std::minstd_rand &r, PixelPoint center, int radius, unsigned n)
+{
+  std::vector<BulkPixelPoint> points;
+  for (unsigned i = 0; i < n; ++i) {
+    const double angle = 2 * M_PI * i / n;
+    const int rho = radius / 2 + int(r() % (radius / 2 + 1));
+    points.emplace_back(center.x + int(rho * cos(angle)),
+                        center.y + int(rho * sin(angle)));
+  }
+
+  return points;
+}
+
+/**
+ * Generate a random walk.
+ */
+static std::vector<BulkPixelPoint>
+MakeLine(std::minstd_rand &r, PixelPoint start, unsigned n)
+{
+  std::vector<BulkPixelPoint> points;
+  for (unsigned i = 0; i < n; ++i) {
+    points.emplace_back(start);
+    start.x += int(r() % 61) - 30;
+    start.y += int(r() % 61) - 30;
+  }
+
+  return points;
+}
+
+Scene::Scene(PixelSize size)
+  :label(PixelSize{48, 12})
+{
+  std::minstd_rand r(42);
+
+  const auto random_point = [&r, size](int margin){
+    return PixelPoint(int(r() % (size.cx + 2 * margin)) - margin,
+                      int(r() % (size.cy + 2 * margin)) - margin);
+  };
+
+  for (unsigned i = 0; i < 400; ++i)
+    areas.push_back({MakeArea(r, random_point(50), 10 + r() % 60,
+                              6 + r() % 20),
+                     RandomColor(r), 1, Pen::SOLID});
+
+  for (unsigned i = 0; i < 600; ++i)
+    lines.push_back({MakeLine(r, random_point(50), 4 + r() % 30),
+                     RandomColor(r), 1 + unsigned(r() % 3),
+                     i % 5 == 0 ? Pen::DASH1 : Pen::SOLID});
+
+  for (unsigned i = 0; i < 40; ++i)
+    airspaces.push_back({MakeArea(r, random_point(200), 50 + r() % 250,
+                                  12 + r() % 40),
+                         RandomColor(r, 0x60), 2, Pen::SOLID});
+
+  for (unsigned i = 0; i < 300; ++i)
+    waypoints.push_back(random_point(0));
+
+  task = MakeLine(r, PixelPoint(size.cx / 2, size.cy / 2), 8);
+  for (auto &p : task) {
+    p.x = size.cx / 2 + (p.x - int(size.cx / 2)) * 8;
+    p.y = size.cy / 2 + (p.y - int(size.cy / 2)) * 8;
+  }
+
+  label.Clear(COLOR_WHITE);
+  label.SelectBlackPen();
+  label.SelectHollowBrush();
+  label.DrawOutlineRectangle(0, 0, 48, 12, COLOR_BLACK);
+  label.DrawLine(4, 6, 44, 6);
+}
+
+void
+Scene::Paint(Canvas &canvas) const
+{
+  canvas.Clear(Color(0xf0, 0xf0, 0xe0));
+
+  canvas.SelectNullPen();
+  for (const auto &i : areas) {
+    canvas.Select(Brush(i.color));
+    canvas.DrawPolygon(i.points.data(), i.points.size());
+  }
+
+  for (const auto &i : lines) {
+    canvas.Select(Pen(i.style, i.width, i.color));
+    canvas.DrawPolyline(i.points.data(), i.points.size());
+  }
+
+  for (const auto &i : airspaces) {
+    canvas.Select(Brush(i.color));
+    canvas.Select(Pen(i.width, Color(i.color.Red(), i.color.Green(),
+                                     i.color.Blue())));
+    canvas.DrawPolygon(i.points.data(), i.points.size());
+  }
+
+  canvas.Select(Pen(Pen::DASH2, 4, Color(0x00, 0x80, 0x00)));
+  canvas.DrawPolyline(task.data(), task.size());
+
+  canvas.SelectBlackPen();
+  canvas.Select(Brush(Color(0xff, 0x00, 0xff)));
+  unsigned n = 0;
+  for (const auto &i : waypoints) {
+    canvas.DrawCircle(i.x, i.y, 4 + n % 5);
+
+    /* labels are bitmap copies which cannot be deferred; this
+       emulates how they interrupt the recorded geometry */
+    if (n++ % 25 == 0)
+      canvas.CopyTransparentWhite({i.x + 6, i.y - 6}, label.GetSize(),
+                                  label, {0, 0});
+  }
+
+  canvas.Select(Pen(2, COLOR_BLACK));
+  canvas.DrawLine(canvas.GetWidth() / 2 - 20, canvas.GetHeight() / 2,
+                  canvas.GetWidth() / 2 + 20, canvas.GetHeight() / 2);
+  canvas.DrawLine(canvas.GetWidth() / 2, canvas.GetHeight() / 2 - 20,
+                  canvas.GetWidth() / 2, canvas.GetHeight() / 2 + 20);
+}
+
+/**
+ * @return the average duration of one frame [us]
+ */
+static uint64_t
+Benchmark(const Scene &scene, Canvas &canvas, RenderQueue *queue,
+          unsigned count)
+{
+  const auto start = MonotonicClockUS();
+
+  for (unsigned i = 0; i < count; ++i) {
+    if (queue != nullptr)
+      canvas.BeginDeferred(*queue);
+
+    scene.Paint(canvas);
+
+    if (queue != nullptr)
+      canvas.EndDeferred();
+  }
+
+  return (MonotonicClockUS() - start) / count;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[COUNT [THREADS [WIDTH HEIGHT]]]");
+  const unsigned count = args.IsEmpty()
+    ? DEFAULT_COUNT
+    : strtoul(args.ExpectNext(), nullptr, 10);
+  const unsigned n_threads = args.IsEmpty()
+    ? 0
+    : strtoul(args.ExpectNext(), nullptr, 10);
+  PixelSize size{DEFAULT_WIDTH, DEFAULT_HEIGHT};
+  if (!args.IsEmpty()) {
+    size.cx = strtoul(args.ExpectNext(), nullptr, 10);
+    size.cy = strtoul(args.ExpectNext(), nullptr, 10);
+  }
+  args.ExpectEnd();
+
+  if (count == 0 || size.cx == 0 || size.cy == 0) {
+    fprintf(stderr, "Invalid arguments\n");
+    return EXIT_FAILURE;
+  }
+
+  const Scene scene(size);
+  BenchmarkCanvas immediate(size), deferred(size);
+  RenderQueue queue(n_threads);
+
+  const auto immediate_us = Benchmark(scene, immediate, nullptr, count);
+  const auto deferred_us = Benchmark(scene, deferred, &queue, count);
+
+  printf("%ux%u, %u frames, %u threads\n",
+         size.cx, size.cy, count, queue.GetThreadCount());
+  printf("immediate: %8.2f ms/frame\n", immediate_us / 1000.);
+  printf("deferred:  %8.2f ms/frame (%.2fx)\n", deferred_us / 1000.,
+         double(immediate_us) / deferred_us);
+
+  if (!(immediate == deferred)) {
+    fprintf(stderr, "Deferred rendering differs from immediate rendering\n");
+    return EXIT_FAILURE;
+  }
+
+  printf("output identical\n");
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,230 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program feeds a synthetic traffic stream (PFLAA sentences of
+ * many targets circling around the aircraft) into the FLARM parser
+ * and FlarmComputer, and measures the time spent parsing, processing,
+ * looking up targets and extrapolating their locations.
+ */
+
+#include "FLARM/FlarmComputer.hpp"
+#include "FLARM/Data.hpp"
+#include "Device/Driver/FLARM/StaticParser.hpp"
+#include "NMEA/Info.hpp"
+#include "NMEA/InputLine.hpp"
+#include "system/Args.hpp"
+#include "system/Clock.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Repeat each benchmark until this duration (in microseconds) has
+ * elapsed.
+ */
+static constexpr uint64_t MIN_DURATION = 1000000;
+
+static constexpr unsigned DEFAULT_COUNT = 200;
+
+struct Target {
+  unsigned id;
+
+  /** distance from the aircraft [m] and initial position [rad] */
+  double radius, phase;
+
+  /** angular velocity around the aircraft [rad/s] */
+  double omega;
+
+  int relative_altitude;
+
+  void Format(char *buffer, double t) const {
+    const double angle = phase + omega * t;
+    const double north = radius * cos(angle);
+    const double east = radius * sin(angle);
+    const double speed = fabs(omega) * radius;
+    const double track = fmod((angle + (omega > 0 ? M_PI_2 : -M_PI_2))
+                              * 180 / M_PI + 720, 360);
+
+    sprintf(buffer, "$PFLAA,0,%d,%d,%d,2,%06X,%u,%.0f,%.0f,%.1f,1",
+            int(north), int(east), relative_altitude, id,
+            unsigned(track), omega * 180 / M_PI, speed, 0.5);
+  }
+};
+
+static std::vector<Target>
+MakeTargets(unsigned n)
+{
+  std::vector<Target> targets;
+  targets.reserve(n);
+
+  for (unsigned i = 0; i < n; ++i) {
+    const double radius = 500 + (i * 7919) % 9500;
+    const double speed = 20 + i % 30;
+    targets.push_back({0xDD0000 + i * 17,
+                       radius, i * 0.7,
+                       (i & 1 ? 1 : -1) * speed / radius,
+                       int(i % 40) * 25 - 500});
+  }
+
+  return targets;
+}
+
+static void
+Parse(const char *sentence, TrafficList &traffic, double clock)
+{
+  NMEAInputLine line(sentence);
+  line.Skip();
+  ParsePFLAA(line, traffic, clock);
+}
+
+/**
+ * The linear search which TrafficList::FindTraffic() used to do,
+ * for comparison.
+ */
+[[gnu::pure]]
+static const FlarmTraffic *
+LinearFind(const TrafficList &traffic, FlarmId id)
+{
+  for (const auto &i : traffic.list)
+    if (i.id == id)
+      return &i;
+
+  return nullptr;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[COUNT]");
+  const unsigned n = args.IsEmpty()
+    ? DEFAULT_COUNT
+    : strtoul(args.ExpectNext(), nullptr, 10);
+  args.ExpectEnd();
+
+  if (n == 0 || n > TrafficList::MAX_COUNT) {
+    fprintf(stderr, "COUNT must be between 1 and %u\n",
+            unsigned(TrafficList::MAX_COUNT));
+    return EXIT_FAILURE;
+  }
+
+  const auto targets = MakeTargets(n);
+
+  NMEAInfo basic;
+  basic.Reset();
+  basic.location = GeoPoint(Angle::Degrees(7.7), Angle::Degrees(51.4));
+  basic.gps_altitude = 1500;
+
+  FlarmData last_flarm;
+  last_flarm.Clear();
+
+  FlarmComputer computer;
+
+  char sentence[256];
+  uint64_t parse_us = 0, process_us = 0;
+  unsigned n_seconds = 0;
+
+  const uint64_t start = MonotonicClockUS();
+  do {
+    basic.clock = basic.time = n_seconds + 1;
+    basic.time_available.Update(basic.clock);
+    basic.location_available.Update(basic.clock);
+    basic.gps_altitude_available.Update(basic.clock);
+
+    uint64_t t0 = MonotonicClockUS();
+    for (const auto &target : targets) {
+      target.Format(sentence, n_seconds);
+      Parse(sentence, basic.flarm.traffic, basic.clock);
+    }
+    basic.flarm.traffic.Expire(basic.clock);
+
+    uint64_t t1 = MonotonicClockUS();
+    computer.Process(basic.flarm, last_flarm, basic);
+    last_flarm = basic.flarm;
+    uint64_t t2 = MonotonicClockUS();
+
+    parse_us += t1 - t0;
+    process_us += t2 - t1;
+    ++n_seconds;
+  } while (MonotonicClockUS() - start < MIN_DURATION);
+
+  const TrafficList &traffic = basic.flarm.traffic;
+  printf("%u targets (%u in list), %u updates\n",
+         n, traffic.GetActiveTrafficCount(), n_seconds);
+  printf("parse:   %.2f us/sentence\n",
+         double(parse_us) / (n_seconds * n));
+  printf("process: %.1f us/update\n",
+         double(process_us) / n_seconds);
+
+  std::vector<FlarmId> ids;
+  for (const auto &i : traffic.list)
+    ids.push_back(i.id);
+
+  unsigned n_lookups = 0, n_found = 0;
+  uint64_t lookup_start = MonotonicClockUS(), duration;
+  do {
+    for (const auto id : ids)
+      n_found += traffic.FindTraffic(id) != nullptr;
+    n_lookups += ids.size();
+    duration = MonotonicClockUS() - lookup_start;
+  } while (duration < MIN_DURATION);
+  printf("lookup:  %.1f ns (hashed)\n", duration * 1000. / n_lookups);
+
+  n_lookups = 0;
+  lookup_start = MonotonicClockUS();
+  do {
+    for (const auto id : ids)
+      n_found += LinearFind(traffic, id) != nullptr;
+    n_lookups += ids.size();
+    duration = MonotonicClockUS() - lookup_start;
+  } while (duration < MIN_DURATION);
+  printf("lookup:  %.1f ns (linear)\n", duration * 1000. / n_lookups);
+
+  unsigned n_frames = 0;
+  double sum = 0;
+  const uint64_t predict_start = MonotonicClockUS();
+  do {
+    /* 25 frames per second between two updates */
+    const double clock = basic.clock + (n_frames % 25) / 25.;
+    for (const auto &i : traffic.list)
+      if (i.location_available)
+        sum += i.GetPredictedLocation(clock).latitude.Native();
+    ++n_frames;
+    duration = MonotonicClockUS() - predict_start;
+  } while (duration < MIN_DURATION);
+  printf("predict: %.1f us/frame\n", double(duration) / n_frames);
+
+  /* prevent the compiler from optimising the loops away */
+  if (n_found == 0 || sum == 0)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,521 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Render a scripted sequence of map views (pan, zoom, rotate) from a
+ * fixed data set, and report the time spent in each layer of
+ * MapWindow::Render().  Each frame is painted the way the DrawThread
+ * does it: MapWindow::Repaint() renders into the hidden buffer (with
+ * deferred rendering if there are multiple threads) and flips it.
+ *
+ * The frames can be written to a directory as PPM files, and a later
+ * run (e.g. with a modified renderer) can compare its frames with
+ * them to detect rendering regressions.
+ *
+ * This program requires the software renderer (USE_MEMORY_CANVAS),
+ * because it reads the pixels of the off-screen buffer.
+ */
+
+#define ENABLE_RESOURCE_LOADER
+#define ENABLE_DATA_PATH
+#define ENABLE_LOOK
+#define ENABLE_MAIN_WINDOW
+#define ENABLE_CMDLINE
+#define USAGE "[-WxH] [--frames=N] [--threads=N] [--write=DIR|--compare=DIR]" \
+  " MAP.xcm WAYPOINTS AIRSPACE TASK REPLAY.igc"
+
+#include "Main.hpp"
+#include "Blackboard/DeviceBlackboard.hpp"
+#include "MapWindow/MapWindow.hpp"
+#include "MapWindow/LayerTimer.hpp"
+#include "ui/canvas/VirtualCanvas.hpp"
+#include "Renderer/TrailRenderer.hpp"
+#include "Computer/TraceComputer.hpp"
+#include "Computer/Settings.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyGlue.hpp"
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/Factory.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Task/LoadFile.hpp"
+#include "Profile/Profile.hpp"
+#include "Profile/ProfileKeys.hpp"
+#include "MapSettings.hpp"
+#include "DebugReplayIGC.hpp"
+#include "io/FileLineReader.hpp"
+#include "Operation/Operation.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "util/StringCompare.hxx"
+#include "util/NumberParser.hpp"
+#include "thread/Debug.hpp"
+#include "thread/Util.hpp"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+void
+DeviceBlackboard::SetStartupLocation(const GeoPoint &loc, const double alt) {}
+
+#ifndef NDEBUG
+
+bool
+InDrawThread()
+{
+  return InMainThread();
+}
+
+#endif
+
+static unsigned n_frames = 120;
+
+/**
+ * The number of threads for deferred rendering; 0 means one per CPU
+ * core.
+ */
+static unsigned n_threads = 0;
+static const char *write_dir = nullptr, *compare_dir = nullptr;
+
+static AllocatedPath map_path = nullptr, waypoint_path = nullptr,
+  airspace_path = nullptr, task_path = nullptr, replay_path = nullptr;
+
+static void
+ParseCommandLine(Args &args)
+{
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    char *endptr;
+    if ((value = StringAfterPrefix(arg, "--frames=")) != nullptr) {
+      n_frames = ParseUnsigned(value, &endptr);
+      if (endptr == value || *endptr != 0 || n_frames == 0)
+        args.UsageError();
+    } else if ((value = StringAfterPrefix(arg, "--threads=")) != nullptr) {
+      n_threads = ParseUnsigned(value, &endptr);
+      if (endptr == value || *endptr != 0 || n_threads == 0)
+        args.UsageError();
+    } else if ((value = StringAfterPrefix(arg, "--write=")) != nullptr) {
+      write_dir = value;
+    } else if ((value = StringAfterPrefix(arg, "--compare=")) != nullptr) {
+      compare_dir = value;
+    } else
+      args.UsageError();
+  }
+
+  if (write_dir != nullptr && compare_dir != nullptr)
+    args.UsageError();
+
+  map_path = args.ExpectNextPath();
+  waypoint_path = args.ExpectNextPath();
+  airspace_path = args.ExpectNextPath();
+  task_path = args.ExpectNextPath();
+  replay_path = args.ExpectNextPath();
+}
+
+/**
+ * An off-screen canvas which can be saved to and compared with PPM
+ * files.
+ */
+class FrameCanvas final : public VirtualCanvas {
+  std::vector<uint8_t> row;
+
+public:
+  explicit FrameCanvas(PixelSize size)
+    :VirtualCanvas(size), row(size.cx * 3) {}
+
+  bool WritePPM(const char *path) noexcept;
+
+  /**
+   * @return the number of pixels which differ from the PPM file, or
+   * -1 if the file could not be read or has different dimensions
+   */
+  int ComparePPM(const char *path) noexcept;
+
+private:
+  static void ToRGB(BGRA8Color c, uint8_t *rgb) noexcept {
+    rgb[0] = c.Red();
+    rgb[1] = c.Green();
+    rgb[2] = c.Blue();
+  }
+
+  static void ToRGB(Luminosity8 c, uint8_t *rgb) noexcept {
+    rgb[0] = rgb[1] = rgb[2] = c.GetLuminosity();
+  }
+
+  /**
+   * Convert one row of the frame buffer to RGB into #row.
+   */
+  void ConvertRow(unsigned y) noexcept {
+    const auto *src = buffer.At(0, y);
+    uint8_t *dest = row.data();
+    for (unsigned x = 0; x < buffer.width; ++x, dest += 3)
+      ToRGB(ActivePixelTraits::ReadPixel(src++), dest);
+  }
+};
+
+bool
+FrameCanvas::WritePPM(const char *path) noexcept
+{
+  FILE *file = fopen(path, "wb");
+  if (file == nullptr)
+    return false;
+
+  fprintf(file, "P6\n%u %u\n255\n", buffer.width, buffer.height);
+
+  bool success = true;
+  for (unsigned y = 0; y < buffer.height && success; ++y) {
+    ConvertRow(y);
+    success = fwrite(row.data(), row.size(), 1, file) == 1;
+  }
+
+  return fclose(file) == 0 && success;
+}
+
+int
+FrameCanvas::ComparePPM(const char *path) noexcept
+{
+  FILE *file = fopen(path, "rb");
+  if (file == nullptr)
+    return -1;
+
+  unsigned width, height, max_value;
+  if (fscanf(file, "P6 %u %u %u", &width, &height, &max_value) != 3 ||
+      fgetc(file) == EOF ||
+      width != buffer.width || height != buffer.height ||
+      max_value != 255) {
+    fclose(file);
+    return -1;
+  }
+
+  std::vector<uint8_t> expected(row.size());
+
+  int n_different = 0;
+  for (unsigned y = 0; y < buffer.height; ++y) {
+    if (fread(expected.data(), expected.size(), 1, file) != 1) {
+      fclose(file);
+      return -1;
+    }
+
+    ConvertRow(y);
+    for (unsigned x = 0; x < row.size(); x += 3)
+      if (memcmp(row.data() + x, expected.data() + x, 3) != 0)
+        ++n_different;
+  }
+
+  fclose(file);
+  return n_different;
+}
+
+class BenchmarkMapWindow final : public MapWindow {
+  const TraceComputer &trace_computer;
+
+public:
+  BenchmarkMapWindow(const MapLook &map_look, const TrafficLook &traffic_look,
+                     const TraceComputer &_trace_computer)
+    :MapWindow(map_look, traffic_look),
+     trace_computer(_trace_computer) {}
+
+  void SetThreadCount(unsigned n) noexcept {
+    render_queue.SetThreadCount(n);
+  }
+
+  void SetView(const GeoPoint &location, double radius, Angle angle) {
+    visible_projection.SetGeoLocation(location);
+    visible_projection.SetScaleFromRadius(radius);
+    visible_projection.SetScreenAngle(angle);
+    visible_projection.UpdateScreenBounds();
+  }
+
+  /**
+   * Load all terrain tiles and topography shapes which are visible
+   * with the current projection.  This is done by background threads
+   * in XCSoar, and is not part of the measured rendering time.
+   */
+  void LoadVisible() {
+    while (UpdateTerrain()) {}
+    while (UpdateTopography() > 0) {}
+  }
+
+  /**
+   * Copy the frame which was painted last into the specified canvas.
+   */
+  void CopyFrame(Canvas &canvas) const {
+    const std::lock_guard<Mutex> lock(mutex);
+    canvas.Copy(GetVisibleCanvas());
+  }
+
+protected:
+  /* virtual methods from class MapWindow */
+  void RenderTrail(Canvas &canvas, PixelPoint aircraft_pos) override {
+    /* like GlueMapWindow::RenderTrail(), but there is no
+       GlideComputer which owns the TraceComputer */
+    const int min_time = GetTrailMinTime();
+    if (min_time < 0)
+      return;
+
+    trail_renderer.Draw(canvas, trace_computer, render_projection, min_time,
+                        GetMapSettings().trail.wind_drift_enabled &&
+                        Calculated().circling,
+                        aircraft_pos, Basic(), Calculated(),
+                        GetMapSettings().trail);
+  }
+};
+
+/**
+ * Replay the flight into the #TraceComputer, and return the flight
+ * path (one point per minute) for the scripted views.
+ */
+static std::vector<GeoPoint>
+Replay(DebugReplay &replay, const ComputerSettings &settings_computer,
+       TraceComputer &trace_computer, MoreData &basic, DerivedInfo &calculated)
+{
+  std::vector<GeoPoint> path;
+  double next_time = 0;
+
+  while (replay.Next()) {
+    trace_computer.Update(settings_computer,
+                          replay.Basic(), replay.Calculated());
+
+    if (replay.Basic().location_available &&
+        replay.Basic().time >= next_time) {
+      path.push_back(replay.Basic().location);
+      next_time = replay.Basic().time + 60;
+    }
+  }
+
+  basic = replay.Basic();
+  calculated = replay.Calculated();
+  return path;
+}
+
+struct View {
+  GeoPoint location;
+  double radius;
+  Angle angle;
+};
+
+/**
+ * Calculate the view of the specified frame.  The first third of the
+ * frames pans along the flight path, the second third zooms out from
+ * 1 km to 100 km, and the last third rotates the map once.
+ */
+gcc_pure
+static View
+GetView(const std::vector<GeoPoint> &path, const GeoPoint &center,
+        unsigned frame)
+{
+  const unsigned phase_length = std::max(n_frames / 3, 1u);
+  const unsigned phase = std::min(frame / phase_length, 2u);
+  const double t = double(frame - phase * phase_length) / phase_length;
+
+  switch (phase) {
+  case 0:
+    return {path[unsigned(t * (path.size() - 1))], 10000, Angle::Zero()};
+
+  case 1:
+    return {center, 1000 * pow(100., t), Angle::Zero()};
+
+  default:
+    return {center, 10000, Angle::FullCircle() * t};
+  }
+}
+
+static void
+Main()
+{
+  if (!normal_font.IsDefined() || !bold_font.IsDefined())
+    throw std::runtime_error("Failed to load fonts");
+
+  ComputerSettings settings_computer;
+  settings_computer.SetDefaults();
+
+  MapSettings settings_map;
+  settings_map.SetDefaults();
+
+  NullOperationEnvironment operation;
+
+  /* RasterTerrain and the topography loader obtain the map file from
+     the profile */
+  Profile::SetPath(ProfileKeys::MapFile, map_path);
+
+  std::unique_ptr<RasterTerrain> terrain(RasterTerrain::OpenTerrain(nullptr,
+                                                                    operation));
+  if (terrain == nullptr)
+    throw std::runtime_error("Failed to load terrain");
+
+  TopographyStore topography;
+  LoadConfiguredTopography(topography, operation);
+
+  Waypoints way_points;
+  if (!ReadWaypointFile(waypoint_path, way_points,
+                        WaypointFactory(WaypointOrigin::PRIMARY,
+                                        terrain.get()),
+                        operation))
+    throw std::runtime_error("Failed to load waypoints");
+  way_points.Optimise();
+
+  Airspaces airspace_database;
+  {
+    FileLineReader reader(airspace_path, Charset::AUTO);
+    AirspaceParser parser(airspace_database);
+    parser.Parse(reader, operation);
+    airspace_database.Optimise();
+  }
+
+  TaskManager task_manager(settings_computer.task, way_points);
+  ProtectedTaskManager protected_task_manager(task_manager,
+                                              settings_computer.task);
+  {
+    std::unique_ptr<OrderedTask> task(LoadTask(task_path,
+                                               settings_computer.task,
+                                               &way_points));
+    if (task == nullptr)
+      throw std::runtime_error("Failed to load task");
+
+    protected_task_manager.TaskCommit(*task);
+  }
+
+  std::unique_ptr<DebugReplay> replay(DebugReplayIGC::Create(replay_path));
+  if (replay == nullptr)
+    throw std::runtime_error("Failed to open replay");
+
+  TraceComputer trace_computer;
+  MoreData basic;
+  DerivedInfo calculated;
+  const auto path = Replay(*replay, settings_computer, trace_computer,
+                           basic, calculated);
+  replay.reset();
+  if (path.empty())
+    throw std::runtime_error("No fixes in replay");
+
+  GeoBounds bounds(path.front());
+  for (const auto &i : path)
+    bounds.Extend(i);
+  const GeoPoint center = bounds.GetCenter();
+
+  BenchmarkMapWindow map(look->map, look->traffic, trace_computer);
+  map.SetWaypoints(&way_points);
+  map.SetAirspaces(&airspace_database);
+  map.SetTopography(&topography);
+  map.SetTerrain(terrain.get());
+  map.SetTask(&protected_task_manager);
+  map.ReadBlackboard(std::make_shared<const MoreData>(basic),
+                     std::make_shared<const DerivedInfo>(calculated),
+                     settings_computer, settings_map);
+
+  map.Create(main_window, main_window.GetClientRect());
+  main_window.SetFullWindow(map);
+  map.SetThreadCount(n_threads);
+
+  const PixelSize canvas_size = map.GetSize();
+  FrameCanvas canvas(canvas_size);
+
+  MapLayerTimer layer_timer;
+  map.SetLayerTimer(&layer_timer);
+
+  using Clock = std::chrono::steady_clock;
+  Clock::duration total = Clock::duration::zero();
+  Clock::duration slowest = Clock::duration::zero();
+  unsigned slowest_frame = 0;
+  unsigned n_failed = 0;
+
+  for (unsigned frame = 0; frame < n_frames; ++frame) {
+    const View view = GetView(path, center, frame);
+    map.SetView(view.location, view.radius, view.angle);
+    map.LoadVisible();
+
+    const auto start = Clock::now();
+    map.Repaint();
+    const auto duration = Clock::now() - start;
+
+    total += duration;
+    if (duration > slowest) {
+      slowest = duration;
+      slowest_frame = frame;
+    }
+
+    if (write_dir != nullptr || compare_dir != nullptr)
+      map.CopyFrame(canvas);
+
+    char ppm_path[4096];
+    if (write_dir != nullptr) {
+      snprintf(ppm_path, sizeof(ppm_path), "%s/%04u.ppm", write_dir, frame);
+      if (!canvas.WritePPM(ppm_path))
+        throw std::runtime_error("Failed to write frame");
+    } else if (compare_dir != nullptr) {
+      snprintf(ppm_path, sizeof(ppm_path), "%s/%04u.ppm", compare_dir, frame);
+      const int n_different = canvas.ComparePPM(ppm_path);
+      if (n_different != 0) {
+        ++n_failed;
+        if (n_different < 0)
+          fprintf(stderr, "frame %u: failed to read %s\n", frame, ppm_path);
+        else
+          fprintf(stderr, "frame %u: %d pixels differ\n",
+                  frame, n_different);
+      }
+    }
+  }
+
+  map.Destroy();
+
+  using Millis = std::chrono::duration<double, std::milli>;
+  const unsigned n = layer_timer.GetFrameCount();
+
+  printf("%u frames %ux%u, %u render threads\n", n,
+         canvas_size.cx, canvas_size.cy,
+         n_threads > 0 ? n_threads : GetProcessorCount());
+  for (unsigned i = 0; i < unsigned(MapLayerTimer::Layer::COUNT); ++i) {
+    const auto layer = MapLayerTimer::Layer(i);
+    printf("%-12s %8.2f ms/frame\n", MapLayerTimer::GetName(layer),
+           Millis(layer_timer.GetTotal(layer)).count() / n);
+  }
+
+  printf("%-12s %8.2f ms/frame\n", "total",
+         Millis(layer_timer.GetTotal()).count() / n);
+
+  /* this includes rasterising the deferred commands, which the
+     layer timer cannot attribute to a layer */
+  printf("%-12s %8.2f ms/frame\n", "repaint",
+         Millis(total).count() / n_frames);
+  printf("slowest frame %u: %.2f ms\n", slowest_frame,
+         Millis(slowest).count());
+
+  if (compare_dir != nullptr) {
+    printf("%u of %u frames differ from %s\n", n_failed, n_frames,
+           compare_dir);
+    if (n_failed > 0)
+      throw std::runtime_error("Rendering differs from the reference");
+  }
+}
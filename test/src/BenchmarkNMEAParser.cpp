@@ -0,0 +1,146 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program measures the NMEA parser throughput.  It reads NMEA
+ * sentences from a file (e.g. a log which is replayed with
+ * FeedNMEA), and parses them over and over, once with the generic
+ * parser only and once with each given driver in front of it.
+ */
+
+#include "NMEA/Info.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "Device/Driver.hpp"
+#include "Device/Register.hpp"
+#include "Device/Parser.hpp"
+#include "Device/Config.hpp"
+#include "system/Args.hpp"
+#include "system/Clock.hpp"
+#include "io/FileLineReader.hpp"
+#include "util/ConvertString.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringStrip.hxx"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+
+/**
+ * Repeat parsing the input until this duration (in microseconds)
+ * has elapsed.
+ */
+static constexpr uint64_t MIN_DURATION = 1000000;
+
+static void
+Benchmark(const char *name, const DeviceRegister *driver,
+          const std::vector<std::string> &lines)
+{
+  DeviceConfig config;
+  config.Clear();
+
+  NullPort port;
+  std::unique_ptr<Device> device(driver != nullptr &&
+                                 driver->CreateOnPort != nullptr
+                                 ? driver->CreateOnPort(config, port)
+                                 : nullptr);
+
+  NMEAParser parser;
+
+  NMEAInfo data;
+  data.Reset();
+  data.clock = 1;
+
+  unsigned n_sentences = 0, n_parsed = 0;
+
+  const uint64_t start = MonotonicClockUS();
+  uint64_t duration;
+
+  do {
+    for (const auto &line : lines) {
+      data.clock += 0.1;
+
+      if ((device != nullptr && device->ParseNMEA(line.c_str(), data)) ||
+          parser.ParseLine(line.c_str(), data))
+        ++n_parsed;
+    }
+
+    n_sentences += lines.size();
+    duration = MonotonicClockUS() - start;
+  } while (duration < MIN_DURATION);
+
+  printf("%s: %u sentences (%u parsed) in %.1fms, %.0f sentences/s\n",
+         name, n_sentences, n_parsed, duration / 1000.,
+         n_sentences * 1e6 / duration);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE [DRIVER...]");
+  const auto path = args.ExpectNextPath();
+
+  std::vector<std::string> lines;
+
+  {
+    FileLineReaderA reader(path);
+    char *line;
+    while ((line = reader.ReadLine()) != nullptr) {
+      StripRight(line);
+      if (*line == '$')
+        lines.emplace_back(line);
+    }
+  }
+
+  if (lines.empty()) {
+    fprintf(stderr, "No NMEA sentences in file\n");
+    return EXIT_FAILURE;
+  }
+
+  Benchmark("generic", nullptr, lines);
+
+  if (args.IsEmpty()) {
+    /* no drivers specified: run all of them */
+    const DeviceRegister *driver;
+    for (unsigned i = 0; (driver = GetDriverByIndex(i)) != nullptr; ++i)
+      if (driver->CreateOnPort != nullptr)
+        Benchmark(WideToUTF8Converter(driver->name), driver, lines);
+  }
+
+  while (!args.IsEmpty()) {
+    const tstring driver_name = args.ExpectNextT();
+    const DeviceRegister *driver = FindDriverByName(driver_name.c_str());
+    if (driver == nullptr) {
+      _ftprintf(stderr, _T("No such driver: %s\n"), driver_name.c_str());
+      return EXIT_FAILURE;
+    }
+
+    Benchmark(WideToUTF8Converter(driver->name), driver, lines);
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
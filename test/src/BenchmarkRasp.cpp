@@ -0,0 +1,203 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure how long it takes to step through a full day of one RASP
+ * parameter: first by decoding each time step synchronously, then
+ * through #RaspCache, which decodes in background and prefetches the
+ * neighbouring time steps.
+ */
+
+#include "Weather/Rasp/RaspStore.hpp"
+#include "Weather/Rasp/RaspCache.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Operation/Operation.hpp"
+#include "system/Args.hpp"
+#include "io/ZipArchive.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+#include "util/PrintException.hxx"
+#include "util/StringAPI.hxx"
+#include "util/ConvertString.hpp"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+
+using std::chrono::steady_clock;
+using Millis = std::chrono::duration<double, std::milli>;
+
+/**
+ * How long each time step is displayed, like in an animated forecast
+ * loop.
+ */
+static constexpr std::chrono::milliseconds step_interval(200);
+
+struct StepStatistics {
+  unsigned n = 0, instant = 0;
+  double total = 0, max = 0;
+
+  void Add(double ms) {
+    ++n;
+    total += ms;
+    if (ms > max)
+      max = ms;
+    if (ms < 1)
+      ++instant;
+  }
+
+  void Print(const char *name) const {
+    printf("%s: %u steps, %u instant, wait avg %.1f ms, max %.1f ms\n",
+           name, n, instant, n > 0 ? total / n : 0., max);
+  }
+};
+
+static Mutex mutex;
+static Cond cond;
+
+/**
+ * Select the given time index and wait until its map is displayed.
+ *
+ * @return the time spent waiting in milliseconds
+ */
+static double
+Step(RaspCache &cache, unsigned t)
+{
+  const BrokenTime bt = RaspStore::IndexToTime(t);
+  cache.SetTime(bt);
+
+  const auto start = steady_clock::now();
+
+  std::unique_lock<Mutex> lock(mutex);
+  while (true) {
+    cache.Reload(BrokenTime::Invalid());
+    if (cache.GetMapTime() == bt)
+      break;
+
+    cond.wait_for(lock, std::chrono::milliseconds(100));
+  }
+
+  return Millis(steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH [PARAMETER]");
+  auto path = args.ExpectNextPath();
+  const char *name = args.IsEmpty() ? nullptr : args.GetNext();
+  args.ExpectEnd();
+
+  RaspStore store(std::move(path));
+  store.ScanAll();
+
+  unsigned parameter = 0;
+  if (name != nullptr) {
+    const UTF8ToWideConverter name2(name);
+    while (parameter < store.GetItemCount() &&
+           !StringIsEqual(store.GetItemInfo(parameter).name.c_str(), name2))
+      ++parameter;
+  }
+
+  if (parameter >= store.GetItemCount()) {
+    fprintf(stderr, "No such RASP parameter\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<unsigned> times;
+  for (unsigned i = 1; i < RaspStore::MAX_WEATHER_TIMES; ++i)
+    if (store.IsTimeAvailable(parameter, i))
+      times.push_back(i);
+
+  _tprintf(_T("parameter '%s', %u time steps\n"),
+           store.GetItemInfo(parameter).name.c_str(),
+           unsigned(times.size()));
+
+  {
+    /* the old way: decode each map when it gets selected */
+    auto archive = store.OpenArchive();
+    NullOperationEnvironment operation;
+
+    StepStatistics statistics;
+    for (const unsigned t : times) {
+      const auto start = steady_clock::now();
+      auto map = store.LoadMap(*archive, parameter, t, operation);
+      statistics.Add(Millis(steady_clock::now() - start).count());
+
+      if (!map) {
+        fprintf(stderr, "Failed to decode time step %u\n", t);
+        return EXIT_FAILURE;
+      }
+    }
+
+    statistics.Print("synchronous");
+    printf("synchronous: %.0f ms for the whole day\n", statistics.total);
+  }
+
+  RaspCache cache(store, parameter, [](){
+    const std::lock_guard<Mutex> lock(mutex);
+    cond.notify_all();
+  });
+
+  StepStatistics forward, backward, loop;
+
+  for (const unsigned t : times) {
+    forward.Add(Step(cache, t));
+    std::this_thread::sleep_for(step_interval);
+  }
+
+  for (auto i = times.rbegin(); i != times.rend(); ++i) {
+    backward.Add(Step(cache, *i));
+    std::this_thread::sleep_for(step_interval);
+  }
+
+  for (const unsigned t : times) {
+    loop.Add(Step(cache, t));
+    std::this_thread::sleep_for(step_interval);
+  }
+
+  forward.Print("cached, forward");
+  backward.Print("cached, backward");
+  loop.Print("cached, loop");
+
+  {
+    /* destroying a RaspCache must not wait for the map being
+       decoded */
+    auto busy = std::make_unique<RaspCache>(store, parameter);
+    busy->SetTime(RaspStore::IndexToTime(times.front()));
+    busy->Reload(BrokenTime::Invalid());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    const auto start = steady_clock::now();
+    busy.reset();
+    printf("destroy while decoding: %.1f ms\n",
+           Millis(steady_clock::now() - start).count());
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,176 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure how long TaskStore::Scan() takes on a directory of task
+ * files, without the task index, with a cold index, with a warm index
+ * and after a few files have been modified.
+ *
+ * If a file count is given, the directory is filled with that many
+ * synthetic *.cup and *.igc files first.
+ */
+
+#include "Task/TaskStore.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "system/Args.hpp"
+#include "system/FileUtil.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* referenced by TaskStore.cpp via Components.hpp */
+Waypoints way_points;
+
+using std::chrono::steady_clock;
+using Millis = std::chrono::duration<double, std::milli>;
+
+static AllocatedPath
+MakePath(Path directory, const char *suffix, unsigned i)
+{
+  char name[32];
+  sprintf(name, "task%05u.%s", i, suffix);
+  return AllocatedPath::Build(directory, name);
+}
+
+static void
+WriteCup(Path path, unsigned i, unsigned n_waypoints, unsigned n_tasks)
+{
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+
+  os.Write("name,code,country,lat,lon,elev,style,rwdir,rwlen,freq,desc\n");
+  for (unsigned j = 0; j < n_waypoints; ++j)
+    os.Format("\"WP%u-%u\",\"W%u\",DE,%02u%02u.%03uN,%03u%02u.%03uE,"
+              "%um,1,,,,\"\"\n",
+              i, j, j, 45 + j % 10, j % 60, (i * 7 + j) % 1000,
+              5 + j % 10, (j * 3) % 60, (i + j * 13) % 1000,
+              100 + j);
+
+  os.Write("-----Related Tasks-----\n");
+  for (unsigned t = 0; t < n_tasks; ++t)
+    os.Format("\"Day %u\",\"???\",\"WP%u-0\",\"WP%u-1\",\"WP%u-2\","
+              "\"WP%u-0\",\"???\"\n",
+              t + 1, i, i, i, i);
+
+  os.Flush();
+  file.Commit();
+}
+
+static void
+WriteIGC(Path path, unsigned i, unsigned n_fixes)
+{
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+
+  os.Write("AXCSBENCH\n"
+           "HFDTE010720\n");
+  os.Format("C010720120000010720%04u01Flight %u\n", i % 10000, i);
+  os.Write("C0000000N00000000ETAKEOFF\n"
+           "C5103117N00742367EBERGNEUSTADT\n"
+           "C5118550N00807083ESTART\n"
+           "C5129567N00928383ETP1\n"
+           "C5103117N00742367EBERGNEUSTADT\n"
+           "C0000000N00000000ELANDING\n");
+
+  for (unsigned j = 0; j < n_fixes; ++j) {
+    const unsigned t = 12 * 3600 + j;
+    os.Format("B%02u%02u%02u51%05uN007%05uEA%05u%05u\n",
+              t / 3600, t / 60 % 60, t % 60,
+              (j * 7) % 60000, (j * 11) % 60000,
+              500 + j % 1000, 520 + j % 1000);
+  }
+
+  os.Flush();
+  file.Commit();
+}
+
+static void
+Generate(Path directory, unsigned n)
+{
+  for (unsigned i = 0; i < n; ++i) {
+    WriteCup(MakePath(directory, "cup", i), i, 50, 5);
+    WriteIGC(MakePath(directory, "igc", i), i, 3600);
+  }
+}
+
+/**
+ * Modify roughly 1% of the generated files.
+ */
+static unsigned
+Modify(Path directory, unsigned n)
+{
+  unsigned modified = 0;
+  for (unsigned i = 0; i < n; i += 100, ++modified)
+    WriteCup(MakePath(directory, "cup", i), i, 50, 6);
+  return modified;
+}
+
+static double
+Scan(TaskStore &store, Path directory, Path index_path)
+{
+  const auto start = steady_clock::now();
+  store.Scan(directory, true, index_path);
+  return Millis(steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "DIR [N]");
+  const auto directory = args.ExpectNextPath();
+  const unsigned n = args.IsEmpty() ? 0 : atoi(args.GetNext());
+  args.ExpectEnd();
+
+  if (n > 0)
+    Generate(directory, n);
+
+  const auto index_path = AllocatedPath::Build(directory, "tasks.idx");
+  File::Delete(index_path);
+
+  TaskStore store;
+
+  double ms = Scan(store, directory, nullptr);
+  printf("no index: %u tasks, %.1f ms\n", unsigned(store.Size()), ms);
+
+  ms = Scan(store, directory, index_path);
+  printf("cold index: %u tasks, %.1f ms\n", unsigned(store.Size()), ms);
+
+  ms = Scan(store, directory, index_path);
+  printf("warm index: %u tasks, %.1f ms\n", unsigned(store.Size()), ms);
+
+  if (n > 0) {
+    const unsigned modified = Modify(directory, n);
+    ms = Scan(store, directory, index_path);
+    printf("%u files modified: %u tasks, %.1f ms\n",
+           modified, unsigned(store.Size()), ms);
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,137 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Draw a few hundred changing text labels per frame, similar to the
+ * waypoint, airspace and InfoBox labels of the map display, and
+ * report the frame time and the number of glyphs rendered by
+ * FreeType.
+ */
+
+#define ENABLE_SCREEN
+#define ENABLE_CMDLINE
+#define USAGE "[FRAMES]"
+
+#include "Main.hpp"
+#include "ui/canvas/BufferCanvas.hpp"
+#include "ui/canvas/Font.hpp"
+#include "util/StaticString.hxx"
+#include "util/NumberParser.hpp"
+
+#include <chrono>
+
+static constexpr PixelSize canvas_size{800, 600};
+static constexpr unsigned N_LABELS = 300;
+
+static unsigned n_frames = 200;
+
+static void
+ParseCommandLine(Args &args)
+{
+  if (!args.IsEmpty()) {
+    const char *s = args.GetNext();
+    char *endptr;
+    n_frames = ParseUnsigned(s, &endptr);
+    if (endptr == s || *endptr != 0 || n_frames == 0)
+      args.UsageError();
+  }
+}
+
+static unsigned long
+GetRenderedGlyphCount() noexcept
+{
+#ifdef USE_FREETYPE
+  return Font::GetRenderedGlyphCount();
+#else
+  return 0;
+#endif
+}
+
+static void
+DrawFrame(Canvas &canvas, unsigned frame)
+{
+  canvas.ClearWhite();
+
+  for (unsigned i = 0; i < N_LABELS; ++i) {
+    const Font &font = i % 3 == 0 ? bold_font : normal_font;
+    canvas.Select(font);
+
+    StaticString<32> buffer;
+    switch (i % 3) {
+    case 0:
+      buffer.Format(_T("WP%03u %u m"), i, (frame * 7 + i * 131) % 4000);
+      break;
+
+    case 1:
+      buffer.Format(_T("%u.%u km"), (frame + i) % 500, (frame * 3 + i) % 10);
+      break;
+
+    default:
+      buffer.Format(_T("FL%03u"), (frame / 4 + i * 17) % 400);
+      break;
+    }
+
+    /* labels are usually measured before they are drawn */
+    const PixelSize size = canvas.CalcTextSize(buffer);
+    const int x = (i * 97) % (canvas_size.cx - size.cx);
+    const int y = (i * 53) % (canvas_size.cy - size.cy);
+    canvas.DrawText(x, y, buffer);
+  }
+}
+
+static void
+Main()
+{
+  if (!normal_font.IsDefined() || !bold_font.IsDefined())
+    throw std::runtime_error("Failed to load fonts");
+
+  BufferCanvas canvas;
+  canvas.Create(canvas_size);
+  canvas.SetTextColor(COLOR_BLACK);
+  canvas.SetBackgroundTransparent();
+
+  const unsigned long glyphs_before = GetRenderedGlyphCount();
+
+  /* the first frame fills the caches */
+  const auto t0 = std::chrono::steady_clock::now();
+  DrawFrame(canvas, 0);
+  const auto t1 = std::chrono::steady_clock::now();
+
+  const unsigned long glyphs_first = GetRenderedGlyphCount();
+
+  for (unsigned frame = 1; frame < n_frames; ++frame)
+    DrawFrame(canvas, frame);
+
+  const auto t2 = std::chrono::steady_clock::now();
+
+  const unsigned long glyphs_total = GetRenderedGlyphCount();
+
+  using Micros = std::chrono::duration<double, std::micro>;
+  printf("labels per frame: %u\n", N_LABELS);
+  printf("first frame: %.0f us, %lu glyphs rendered\n",
+         Micros(t1 - t0).count(), glyphs_first - glyphs_before);
+  if (n_frames > 1)
+    printf("next %u frames: %.0f us/frame, %lu glyphs rendered\n",
+           n_frames - 1, Micros(t2 - t1).count() / (n_frames - 1),
+           glyphs_total - glyphs_first);
+}
@@ -0,0 +1,135 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program measures the latency of panning the map over the
+ * topography of a map file, once with the shapefiles and once with
+ * the compiled topography files (*.xtp, see CompileTopography).
+ */
+
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Geo/GeoVector.hpp"
+#include "system/Args.hpp"
+#include "system/Clock.hpp"
+#include "io/ZipArchive.hpp"
+#include "io/ZipLineReader.hpp"
+#include "Operation/Operation.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <vector>
+
+#include <stdio.h>
+
+/**
+ * The number of panning steps on a circle around the map center.
+ */
+static constexpr unsigned NUM_STEPS = 360;
+
+static void
+Benchmark(ZipArchive &archive, bool use_compiled, double radius)
+{
+  const uint64_t load_start = MonotonicClockUS();
+
+  ZipLineReaderA reader(archive.get(), "topology.tpl");
+
+  TopographyStore topography;
+  NullOperationEnvironment operation;
+  topography.Load(operation, reader, nullptr, archive.get(), use_compiled);
+
+  const uint64_t load_duration = MonotonicClockUS() - load_start;
+
+  if (topography.size() == 0) {
+    fprintf(stderr, "No topography files\n");
+    return;
+  }
+
+  unsigned num_compiled = 0;
+  for (unsigned i = 0; i < topography.size(); ++i)
+    if (topography[i].IsCompiled())
+      ++num_compiled;
+
+  if (use_compiled && num_compiled == 0) {
+    printf("compiled: no *.xtp files in map file\n");
+    return;
+  }
+
+  const GeoPoint center = topography[0].GetCenter();
+
+  WindowProjection projection;
+  projection.SetScreenSize({640, 480});
+  projection.SetScreenOrigin(320, 240);
+  projection.SetGeoLocation(center);
+  projection.SetScaleFromRadius(10000);
+  projection.UpdateScreenBounds();
+
+  std::vector<uint64_t> durations;
+  durations.reserve(NUM_STEPS);
+
+  unsigned num_updates = 0;
+  for (unsigned i = 0; i < NUM_STEPS; ++i) {
+    const GeoVector v(radius, Angle::Degrees(i));
+    projection.SetGeoLocation(v.EndPoint(center));
+    projection.UpdateScreenBounds();
+
+    const uint64_t start = MonotonicClockUS();
+    num_updates += topography.ScanVisibility(projection);
+    durations.push_back(MonotonicClockUS() - start);
+  }
+
+  uint64_t total = 0;
+  for (auto i : durations)
+    total += i;
+
+  std::sort(durations.begin(), durations.end());
+
+  printf("%s: files=%u compiled=%u load=%.1fms"
+         " updates=%u pan total=%.1fms mean=%.1fus"
+         " p50=%uus p99=%uus max=%uus\n",
+         use_compiled ? "compiled" : "shapefile",
+         topography.size(), num_compiled, load_duration / 1000.,
+         num_updates, total / 1000., double(total) / NUM_STEPS,
+         unsigned(durations[NUM_STEPS / 2]),
+         unsigned(durations[NUM_STEPS * 99 / 100]),
+         unsigned(durations.back()));
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "MAPFILE [RADIUS_KM]");
+  const auto path = args.ExpectNextPath();
+  const double radius = args.IsEmpty() ? 50000 : args.ExpectNextDouble() * 1000;
+  args.ExpectEnd();
+
+  ZipArchive archive(path);
+
+  Benchmark(archive, false, radius);
+  Benchmark(archive, true, radius);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
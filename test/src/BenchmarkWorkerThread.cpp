@@ -0,0 +1,227 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program replays a synthetic GPS fix stream into a WorkerThread
+ * and measures how quickly each fix is processed, and how many fixes
+ * are coalesced with the next one (i.e. never seen by Tick()).
+ *
+ * Each fix arrives as a burst of three Trigger() calls 2 ms apart
+ * (like GGA, RMC and a vario sentence).  Tick() simulates the
+ * CalculationThread: a fast path followed by a slow job.  This is
+ * done with the fixed rate limits and the slow job running every
+ * 500 ms right after the fast path ("fixed"), and with the adaptive
+ * rate limits and the slow job being deferred by an IdleScheduler
+ * ("adaptive").
+ */
+
+#include "Computer/IdleScheduler.hpp"
+#include "thread/WorkerThread.hpp"
+#include "thread/Mutex.hxx"
+#include "time/PeriodClock.hpp"
+#include "system/Args.hpp"
+#include "util/NumberParser.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+struct Timings {
+  const char *name;
+  unsigned period_min, idle_min, delay;
+};
+
+static constexpr Timings timings[] = {
+  { "calc", 450, 100, 50 },
+  { "merge", 50, 20, 10 },
+};
+
+static void
+BusyWait(Clock::duration d)
+{
+  const auto end = Clock::now() + d;
+  while (Clock::now() < end) {}
+}
+
+class ReplaySimulation final : public WorkerThread {
+  const bool adaptive;
+  const Clock::duration fast_cost, slow_cost;
+  const Clock::duration fix_interval;
+
+  Mutex data_mutex;
+  unsigned fix = 0;
+  Clock::time_point fix_stamp;
+
+  unsigned last_seen = 0;
+
+  IdleScheduler scheduler;
+  PeriodClock slow_clock;
+
+public:
+  std::vector<double> latencies;
+  unsigned missed = 0;
+
+  ReplaySimulation(const Timings &t, bool _adaptive,
+                   Clock::duration _fast_cost, Clock::duration _slow_cost,
+                   Clock::duration _fix_interval)
+    :WorkerThread(t.name, t.period_min, t.idle_min, t.delay),
+     adaptive(_adaptive),
+     fast_cost(_fast_cost), slow_cost(_slow_cost),
+     fix_interval(_fix_interval) {
+    SetAdaptive(adaptive);
+
+    scheduler.Add("slow", std::chrono::milliseconds(500),
+                  std::chrono::seconds(2), slow_cost,
+                  [this](bool){ BusyWait(slow_cost); });
+  }
+
+  void NewFix() {
+    const std::lock_guard<Mutex> lock(data_mutex);
+    ++fix;
+    fix_stamp = Clock::now();
+  }
+
+protected:
+  void Tick() noexcept override {
+    const auto start = Clock::now();
+
+    unsigned current;
+    Clock::time_point stamp;
+    {
+      const std::lock_guard<Mutex> lock(data_mutex);
+      current = fix;
+      stamp = fix_stamp;
+    }
+
+    if (current == last_seen)
+      return;
+
+    missed += current - last_seen - 1;
+    last_seen = current;
+
+    BusyWait(fast_cost);
+
+    /* the result is "published" now */
+    latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - stamp).count());
+
+    if (adaptive) {
+      const auto elapsed = Clock::now() - start;
+      const auto budget = fix_interval / 2;
+      scheduler.Run(budget > elapsed
+                    ? budget - elapsed
+                    : Clock::duration::zero());
+    } else if (slow_clock.CheckUpdate(std::chrono::milliseconds(500)))
+      scheduler.RunAll();
+  }
+};
+
+static double
+Percentile(const std::vector<double> &sorted, unsigned percent)
+{
+  std::size_t i = sorted.size() * percent / 100;
+  if (i >= sorted.size())
+    i = sorted.size() - 1;
+  return sorted[i];
+}
+
+static void
+Run(const Timings &t, bool adaptive, unsigned rate, unsigned seconds,
+    unsigned fast_ms, unsigned slow_ms)
+{
+  const auto interval = std::chrono::microseconds(1000000 / rate);
+
+  ReplaySimulation thread(t, adaptive,
+                          std::chrono::milliseconds(fast_ms),
+                          std::chrono::milliseconds(slow_ms),
+                          interval);
+  thread.Start();
+
+  auto next = Clock::now();
+  const unsigned n = rate * seconds;
+  for (unsigned i = 0; i < n; ++i) {
+    next += interval;
+    std::this_thread::sleep_until(next);
+
+    thread.NewFix();
+    for (unsigned j = 0; j < 3; ++j) {
+      if (j > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      thread.Trigger();
+    }
+  }
+
+  /* let the thread catch up with the last fix */
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  thread.BeginStop();
+  thread.Join();
+
+  auto &latencies = thread.latencies;
+  std::sort(latencies.begin(), latencies.end());
+
+  printf("%s/%s: %u fixes, %u missed, p50=%.1f ms p99=%.1f ms max=%.1f ms\n",
+         t.name, adaptive ? "adaptive" : "fixed",
+         n, thread.missed,
+         latencies.empty() ? 0. : Percentile(latencies, 50),
+         latencies.empty() ? 0. : Percentile(latencies, 99),
+         latencies.empty() ? 0. : latencies.back());
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[RATE_HZ [SECONDS [FAST_MS [SLOW_MS]]]]");
+
+  unsigned rate = 10, seconds = 5, fast_ms = 2, slow_ms = 30;
+  if (!args.IsEmpty())
+    rate = ParseUnsigned(args.ExpectNext());
+  if (!args.IsEmpty())
+    seconds = ParseUnsigned(args.ExpectNext());
+  if (!args.IsEmpty())
+    fast_ms = ParseUnsigned(args.ExpectNext());
+  if (!args.IsEmpty())
+    slow_ms = ParseUnsigned(args.ExpectNext());
+  args.ExpectEnd();
+
+  if (rate == 0 || rate > 100 || seconds == 0) {
+    fprintf(stderr, "Invalid arguments\n");
+    return EXIT_FAILURE;
+  }
+
+  for (const auto &t : timings) {
+    Run(t, false, rate, seconds, fast_ms, slow_ms);
+    Run(t, true, rate, seconds, fast_ms, slow_ms);
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,218 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Build a thermal hotspot database from a collection of IGC files.
+ * The files are analysed in parallel, one worker thread per CPU.
+ * Afterwards, the database is opened and queried with random map
+ * windows to measure the query latency.
+ */
+
+#include "Thermal/HotspotDatabase.hpp"
+#include "Thermal/ClimbDetector.hpp"
+#include "Computer/CirclingComputer.hpp"
+#include "Computer/Settings.hpp"
+#include "DebugReplayIGC.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "util/PrintException.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using std::chrono::steady_clock;
+using Millis = std::chrono::duration<double, std::milli>;
+
+struct Worker {
+  HotspotDatabaseBuilder builder;
+  std::vector<GeoPoint> locations;
+  unsigned long n_fixes = 0;
+  unsigned n_errors = 0;
+
+  void AnalyseFlight(Path path);
+
+  void Run(const std::vector<const char *> &files,
+           std::atomic_uint &next) {
+    unsigned i;
+    while ((i = next++) < files.size()) {
+      try {
+        AnalyseFlight(Path(files[i]));
+      } catch (...) {
+        fprintf(stderr, "%s: ", files[i]);
+        PrintException(std::current_exception());
+        ++n_errors;
+      }
+    }
+  }
+};
+
+void
+Worker::AnalyseFlight(Path path)
+{
+  std::unique_ptr<DebugReplay> replay(DebugReplayIGC::Create(path));
+
+  CirclingSettings circling_settings;
+  circling_settings.SetDefaults();
+
+  CirclingComputer circling_computer;
+  circling_computer.Reset();
+
+  ClimbDetector detector;
+  DetectedClimb climb;
+
+  auto add = [this](const DetectedClimb &c){
+    builder.Add(c);
+    locations.push_back(c.location);
+  };
+
+  while (replay->Next()) {
+    ++n_fixes;
+
+    circling_computer.TurnRate(replay->SetCalculated(),
+                               replay->Basic(),
+                               replay->Calculated().flight);
+    circling_computer.Turning(replay->SetCalculated(),
+                              replay->Basic(),
+                              replay->Calculated().flight,
+                              circling_settings);
+
+    if (detector.Update(replay->Basic(), replay->Calculated(), climb))
+      add(climb);
+  }
+
+  if (detector.Finish(climb))
+    add(climb);
+
+  builder.AddFlight();
+}
+
+/**
+ * Query random map windows (2 to 100 km) around the given locations
+ * (all hours of the day) and print the latency.
+ */
+static void
+BenchmarkQueries(const HotspotDatabase &db,
+                 const std::vector<GeoPoint> &locations, unsigned n)
+{
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> index(0, locations.size() - 1);
+  std::uniform_real_distribution<double> size(0.02, 1.);
+
+  unsigned long n_results = 0;
+  double total = 0, max = 0;
+
+  for (unsigned i = 0; i < n; ++i) {
+    const double s = size(rng);
+    const GeoPoint &center = locations[index(rng)];
+    const double x = center.longitude.Degrees() - s / 2;
+    const double y = center.latitude.Degrees() - s / 2;
+    const GeoBounds query(GeoPoint(Angle::Degrees(x),
+                                   Angle::Degrees(y + s)),
+                          GeoPoint(Angle::Degrees(x + s),
+                                   Angle::Degrees(y)));
+
+    const auto start = steady_clock::now();
+    db.VisitWithin(query, -1, 1, [&n_results](const HotspotRecord &){
+      ++n_results;
+    });
+    const double us = Millis(steady_clock::now() - start).count() * 1000;
+
+    total += us;
+    if (us > max)
+      max = us;
+  }
+
+  printf("%u queries: %lu results, average %.1f us, max %.1f us\n",
+         n, n_results, total / n, max);
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "OUTPUT FILE.igc ...");
+  const auto output = args.ExpectNextPath();
+
+  std::vector<const char *> files;
+  do {
+    files.push_back(args.ExpectNext());
+  } while (!args.IsEmpty());
+
+  const unsigned n_threads =
+    std::max(std::min(std::thread::hardware_concurrency(),
+                      unsigned(files.size())), 1u);
+
+  const auto start = steady_clock::now();
+
+  std::vector<Worker> workers(n_threads);
+  std::vector<std::thread> threads;
+  std::atomic_uint next(0);
+  for (auto &worker : workers)
+    threads.emplace_back([&worker, &files, &next](){
+      worker.Run(files, next);
+    });
+
+  for (auto &thread : threads)
+    thread.join();
+
+  HotspotDatabaseBuilder builder;
+  std::vector<GeoPoint> locations;
+  unsigned long n_fixes = 0;
+  unsigned n_errors = 0;
+  for (const auto &worker : workers) {
+    builder.Merge(worker.builder);
+    locations.insert(locations.end(),
+                     worker.locations.begin(), worker.locations.end());
+    n_fixes += worker.n_fixes;
+    n_errors += worker.n_errors;
+  }
+
+  builder.Save(output);
+
+  const double seconds = Millis(steady_clock::now() - start).count() / 1000;
+
+  printf("%u flights (%u failed), %lu fixes, %u climbs, %u records "
+         "in %.2f s with %u threads\n",
+         builder.GetFlightCount(), n_errors, n_fixes,
+         builder.GetClimbCount(), builder.GetRecordCount(),
+         seconds, n_threads);
+  if (seconds > 0)
+    printf("%.1f flights/s, %.0f fixes/s\n",
+           builder.GetFlightCount() / seconds, n_fixes / seconds);
+
+  const auto db = HotspotDatabase::Open(output);
+  if (db == nullptr || locations.empty())
+    return EXIT_SUCCESS;
+
+  BenchmarkQueries(*db, locations, 1000);
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
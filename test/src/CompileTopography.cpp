@@ -0,0 +1,82 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program converts the shapefiles of a map file to compiled
+ * topography files (*.xtp), which can be added to the map file to
+ * speed up loading topography at runtime.
+ */
+
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Topography/CompiledTopographyWriter.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "io/ZipArchive.hpp"
+#include "io/ZipLineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "Operation/Operation.hpp"
+#include "util/PrintException.hxx"
+#include "util/StaticString.hxx"
+
+#include <stdio.h>
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "MAPFILE OUTDIR");
+  const auto path = args.ExpectNextPath();
+  const auto out_dir = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  ZipArchive archive(path);
+
+  ZipLineReaderA reader(archive.get(), "topology.tpl");
+
+  TopographyStore topography;
+  NullOperationEnvironment operation;
+  topography.Load(operation, reader, nullptr, archive.get(), false);
+
+  topography.LoadAll();
+
+  for (unsigned i = 0; i < topography.size(); ++i) {
+    const TopographyFile &file = topography[i];
+
+    NarrowString<256> name;
+    name.Format("%s.xtp", file.GetName());
+
+    const auto out_path = AllocatedPath::Build(out_dir, name.c_str());
+    FileOutputStream fos(out_path);
+    BufferedOutputStream bos(fos);
+    WriteCompiledTopography(file, bos);
+    bos.Flush();
+    fos.Commit();
+
+    printf("%s\n", name.c_str());
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -32,6 +32,13 @@ struct Emulator {
   DataHandler *handler;
   OperationEnvironment *env;
 
+  /**
+   * If non-zero, then the emulator slows down its responses to
+   * simulate a serial line with this baud rate; this is useful for
+   * benchmarks on a pseudo-TTY, which has no speed limit.
+   */
+  unsigned simulated_baud_rate = 0;
+
   virtual ~Emulator() {}
 };
 
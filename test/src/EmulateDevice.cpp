@@ -26,6 +26,11 @@ Copyright_License {
  * NMEA data read from stdin to it.  It is useful to feed WINE with
  * it: symlink ~/.wine/dosdevices/com1 to /tmp/nmea, and configure
  * "COM1" in XCSoar.
+ *
+ * If SIMULATED_BAUD is given, the emulator slows down its responses
+ * as if it were connected through a serial line with that speed.
+ * Together with a pseudo-TTY ("pty /tmp/flarm") and RunDownloadFlight,
+ * this can be used to benchmark flight downloads.
  */
 
 #include "FLARMEmulator.hpp"
@@ -60,9 +65,11 @@ LoadEmulator(Args &args)
 int
 main(int argc, char **argv)
 try {
-  Args args(argc, argv, "DRIVER PORT BAUD");
+  Args args(argc, argv, "DRIVER PORT BAUD [SIMULATED_BAUD]");
   Emulator *emulator = LoadEmulator(args);
   DebugPort debug_port(args);
+  if (!args.IsEmpty())
+    emulator->simulated_baud_rate = atoi(args.GetNext());
   args.ExpectEnd();
 
   ScopeGlobalAsioThread global_asio_thread;
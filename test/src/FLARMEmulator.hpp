@@ -27,6 +27,7 @@ Copyright_License {
 #include "DeviceEmulator.hpp"
 #include "Device/Util/LineSplitter.hpp"
 #include "Device/Driver/FLARM/BinaryProtocol.hpp"
+#include "Device/Driver/FLARM/CRC16.hpp"
 #include "Device/Util/NMEAWriter.hpp"
 #include "NMEA/InputLine.hpp"
 #include "NMEA/Checksum.hpp"
@@ -34,8 +35,11 @@ Copyright_License {
 #include "util/StaticFifoBuffer.hxx"
 #include "util/StaticString.hxx"
 
+#include <algorithm>
 #include <string>
 #include <map>
+
+#include <cassert>
 #include <stdio.h>
 #include <string.h>
 
@@ -45,6 +49,34 @@ class FLARMEmulator : public Emulator, PortLineSplitter {
   bool binary;
   StaticFifoBuffer<char, 256u> binary_buffer;
 
+  /**
+   * The number of flights in the emulated flight log.
+   */
+  static constexpr unsigned n_flights = 3;
+
+  /**
+   * The duration of each emulated flight in seconds.
+   */
+  static constexpr unsigned flight_duration = 3600;
+
+  static constexpr size_t igc_chunk_size = 512;
+
+  unsigned selected_flight = 0;
+
+  /**
+   * The IGC file of the selected flight.
+   */
+  std::string igc;
+  size_t igc_position = 0;
+
+  uint8_t send_buffer[2 + 1 + igc_chunk_size + 1];
+
+  /**
+   * The baud rates which were active before entering binary mode;
+   * they are restored when leaving it.
+   */
+  unsigned nmea_baud_rate, nmea_simulated_baud_rate;
+
 public:
   FLARMEmulator():binary(false) {
     handler = this;
@@ -95,79 +127,243 @@ private:
   void PFLAX() {
     binary = true;
     binary_buffer.Clear();
+
+    nmea_baud_rate = port->GetBaudrate();
+    nmea_simulated_baud_rate = simulated_baud_rate;
   }
 
-  size_t Unescape(const uint8_t *const data, const uint8_t *const end,
-                  void *_dest, size_t length) {
+  /**
+   * Unescape #length bytes from the given input buffer.
+   *
+   * @return the number of input bytes consumed, 0 if more input is
+   * needed, -1 if the frame is malformed
+   */
+  static int Unescape(const uint8_t *const data, const uint8_t *const end,
+                      void *_dest, size_t length) {
     uint8_t *dest = (uint8_t *)_dest;
 
-    const uint8_t *p;
-    for (p = data; length > 0; ++p) {
+    const uint8_t *p = data;
+    for (; length > 0; --length) {
       if (p >= end)
-        return std::min(p - data, end - data - 1);
+        return 0;
 
       if (*p == FLARM::START_FRAME)
-        return std::min(p - data, end - data - 1);
+        return -1;
 
       if (*p == FLARM::ESCAPE) {
         ++p;
         if (p >= end)
-          return std::min(p - data, end - data - 1);
+          return 0;
 
         if (*p == FLARM::ESCAPE_START)
           *dest++ = FLARM::START_FRAME;
         else if (*p == FLARM::ESCAPE_ESCAPE)
           *dest++ = FLARM::ESCAPE;
         else
-          return std::min(p - data, end - data - 1);
+          return -1;
       } else
         *dest++ = *p;
+
+      ++p;
     }
 
     return p - data;
   }
 
-  bool SendACK(uint16_t sequence_number) {
-    uint16_t payload = ToLE16(sequence_number);
+  /**
+   * Simulate the transfer time of a serial line.
+   */
+  void Throttle(size_t nbytes) {
+    if (simulated_baud_rate > 0)
+      env->Sleep(std::chrono::microseconds(uint64_t(nbytes) * 10 * 1000000
+                                           / simulated_baud_rate));
+  }
+
+  bool SendFrame(FLARM::MessageType type, uint16_t sequence_number,
+                 const void *payload, size_t length) {
     FLARM::FrameHeader header =
-      FLARM::PrepareFrameHeader(sequence_number, FLARM::MT_ACK,
-                                &payload, sizeof(payload));
-    return port->Write(FLARM::START_FRAME) &&
-      FLARM::SendEscaped(*port, &header, sizeof(header), *env,
-                         std::chrono::seconds(2)) &&
-      FLARM::SendEscaped(*port, &payload, sizeof(payload), *env,
-                         std::chrono::seconds(2));
+      FLARM::PrepareFrameHeader(sequence_number, type, payload, length);
+    if (!port->Write(FLARM::START_FRAME) ||
+        !FLARM::SendEscaped(*port, &header, sizeof(header), *env,
+                            std::chrono::seconds(2)) ||
+        !FLARM::SendEscaped(*port, payload, length, *env,
+                            std::chrono::seconds(2)))
+      return false;
+
+    Throttle(1 + sizeof(header) + length);
+    return true;
   }
 
-  size_t HandleBinary(const void *_data, size_t length) {
-    const uint8_t *const data = (const uint8_t *)_data, *end = data + length;
-    const uint8_t *p = data;
+  /**
+   * Send an ACK frame.  Its payload is the sequence number of the
+   * request, followed by the given data.
+   */
+  bool SendACK(uint16_t sequence_number,
+               const void *data=nullptr, size_t length=0) {
+    assert(length <= sizeof(send_buffer) - 2);
+
+    const uint16_t le_sequence_number = ToLE16(sequence_number);
+    memcpy(send_buffer, &le_sequence_number, 2);
+    if (length > 0)
+      memcpy(send_buffer + 2, data, length);
+
+    return SendFrame(FLARM::MT_ACK, sequence_number,
+                     send_buffer, 2 + length);
+  }
 
-    p = std::find(p, end, FLARM::START_FRAME);
-    if (p == NULL)
-      return length;
+  bool SendNACK(uint16_t sequence_number) {
+    uint16_t payload = ToLE16(sequence_number);
+    return SendFrame(FLARM::MT_NACK, sequence_number,
+                     &payload, sizeof(payload));
+  }
 
-    ++p;
+  /**
+   * Generate a synthetic IGC file for the given flight.
+   */
+  void GenerateFlight(unsigned i) {
+    char line[64];
+    snprintf(line, sizeof(line), "AFLAEMU FLIGHT:%u\r\nHFDTE010720\r\n",
+             i + 1);
+    igc = line;
+
+    for (unsigned t = 0; t < flight_duration; t += 4) {
+      const unsigned time = 12 * 3600 + i * flight_duration + t;
+      snprintf(line, sizeof(line),
+               "B%02u%02u%02u4730%03uN00830%03uEA%05u%05u\r\n",
+               time / 3600, time / 60 % 60, time % 60,
+               t % 1000, (t * 7) % 1000, 1000 + t % 500, 1050 + t % 500);
+      igc += line;
+    }
 
-    FLARM::FrameHeader header;
-    size_t nbytes = Unescape(p, end, &header, sizeof(header));
-    p += nbytes;
-    if (nbytes < sizeof(header))
-      return p - data;
+    igc_position = 0;
+  }
+
+  void SendRecordInfo(uint16_t sequence_number) {
+    const unsigned start = 12 * 3600 + selected_flight * flight_duration;
+
+    char info[128];
+    snprintf(info, sizeof(info),
+             "0710EMU%u.IGC|2020-07-01|%02u:%02u:00|%02u:%02u:00|EMULATOR|E|Club",
+             selected_flight,
+             start / 3600, start / 60 % 60,
+             flight_duration / 3600, flight_duration / 60 % 60);
+    SendACK(sequence_number, info, strlen(info) + 1);
+  }
+
+  void SendIGCData(uint16_t sequence_number) {
+    uint8_t data[1 + igc_chunk_size + 1];
+
+    size_t length = std::min(igc.length() - igc_position, igc_chunk_size);
+    memcpy(data + 1, igc.data() + igc_position, length);
+    igc_position += length;
+
+    data[0] = igc.empty() ? 100 : igc_position * 100 / igc.length();
+
+    if (igc_position >= igc.length())
+      /* end of file */
+      data[1 + length++] = 0x1A;
+
+    SendACK(sequence_number, data, 1 + length);
+  }
 
-    //XXX size_t payload_length = header.GetLength();
+  void SetBaudRate(unsigned baud_rate) {
+    port->Drain();
+    if (port->GetBaudrate() != 0)
+      port->SetBaudrate(baud_rate);
+
+    if (simulated_baud_rate > 0)
+      simulated_baud_rate = baud_rate;
+  }
+
+  void HandleFrame(const FLARM::FrameHeader &header,
+                   const uint8_t *payload, size_t length) {
+    const uint16_t sequence_number = header.sequence_number;
 
     switch (header.type) {
     case FLARM::MT_PING:
+      SendACK(sequence_number);
+      break;
+
+    case FLARM::MT_SETBAUDRATE:
+      if (length < 1 || FLARM::CodeToBaudRate(payload[0]) == 0) {
+        SendNACK(sequence_number);
+        break;
+      }
+
+      SendACK(sequence_number);
+      SetBaudRate(FLARM::CodeToBaudRate(payload[0]));
+      break;
+
     case FLARM::MT_SELECTRECORD:
-      SendACK(header.sequence_number);
+      if (length < 1 || payload[0] >= n_flights) {
+        SendNACK(sequence_number);
+        break;
+      }
+
+      selected_flight = payload[0];
+      GenerateFlight(selected_flight);
+      SendACK(sequence_number);
+      break;
+
+    case FLARM::MT_GETRECORDINFO:
+      SendRecordInfo(sequence_number);
+      break;
+
+    case FLARM::MT_GETIGCDATA:
+      SendIGCData(sequence_number);
       break;
 
     case FLARM::MT_EXIT:
-      SendACK(header.sequence_number);
+      SendACK(sequence_number);
       binary = false;
+
+      /* leaving binary mode restores the NMEA baud rate */
+      port->Drain();
+      if (nmea_baud_rate != 0)
+        port->SetBaudrate(nmea_baud_rate);
+      simulated_baud_rate = nmea_simulated_baud_rate;
       break;
     }
+  }
+
+  size_t HandleBinary(const void *_data, size_t length) {
+    const uint8_t *const data = (const uint8_t *)_data, *end = data + length;
+
+    const uint8_t *p = std::find(data, end, FLARM::START_FRAME);
+    if (p != data)
+      /* skip garbage before the start byte */
+      return p - data;
+
+    ++p;
+
+    FLARM::FrameHeader header;
+    int nbytes = Unescape(p, end, &header, sizeof(header));
+    if (nbytes <= 0)
+      /* wait for more data, or skip this malformed frame */
+      return nbytes == 0 ? 0 : 1;
+
+    p += nbytes;
+
+    uint8_t payload[64];
+    if (header.length < sizeof(header) ||
+        header.length - sizeof(header) > sizeof(payload))
+      return p - data;
+
+    const size_t payload_length = header.length - sizeof(header);
+
+    nbytes = Unescape(p, end, payload, payload_length);
+    if (nbytes < 0)
+      return p - data;
+    else if (nbytes == 0 && payload_length > 0)
+      return 0;
+
+    p += nbytes;
+
+    if (header.crc == FLARM::CalculateCRC(header,
+                                          payload_length > 0
+                                          ? payload : nullptr,
+                                          payload_length))
+      HandleFrame(header, payload, payload_length);
 
     return p - data;
   }
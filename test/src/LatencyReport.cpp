@@ -0,0 +1,152 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Reads a latency trace written by "xcsoar -latency-trace=FILE" and
+ * prints latency percentiles and a histogram for each stage.
+ */
+
+#include "time/LatencyTrace.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * The number of histogram buckets; bucket i counts latencies in the
+ * range [2^i, 2^(i+1)) microseconds, and the last bucket counts
+ * everything above.
+ */
+static constexpr unsigned N_BUCKETS = 20;
+
+static double
+ToMilliseconds(uint_least64_t ns)
+{
+  return ns / 1000000.;
+}
+
+static uint_least64_t
+Percentile(const std::vector<uint_least64_t> &sorted, unsigned percent)
+{
+  std::size_t i = sorted.size() * percent / 100;
+  if (i >= sorted.size())
+    i = sorted.size() - 1;
+  return sorted[i];
+}
+
+static unsigned
+GetBucket(uint_least64_t ns)
+{
+  uint_least64_t us = ns / 1000;
+  unsigned bucket = 0;
+  while (us > 1 && bucket < N_BUCKETS - 1) {
+    us >>= 1;
+    ++bucket;
+  }
+
+  return bucket;
+}
+
+static void
+PrintStage(LatencyTrace::Stage stage, std::vector<uint_least64_t> &latencies)
+{
+  printf("%s: %u samples\n", LatencyTrace::GetStageName(stage),
+         unsigned(latencies.size()));
+  if (latencies.empty())
+    return;
+
+  std::sort(latencies.begin(), latencies.end());
+
+  printf("  p50=%.3f ms p90=%.3f ms p99=%.3f ms max=%.3f ms\n",
+         ToMilliseconds(Percentile(latencies, 50)),
+         ToMilliseconds(Percentile(latencies, 90)),
+         ToMilliseconds(Percentile(latencies, 99)),
+         ToMilliseconds(latencies.back()));
+
+  std::array<unsigned, N_BUCKETS> histogram;
+  histogram.fill(0);
+  for (auto i : latencies)
+    ++histogram[GetBucket(i)];
+
+  const unsigned max_count =
+    *std::max_element(histogram.begin(), histogram.end());
+
+  for (unsigned i = 0; i < N_BUCKETS; ++i) {
+    if (histogram[i] == 0)
+      continue;
+
+    const unsigned width = histogram[i] * 50 / max_count;
+    if (i == N_BUCKETS - 1)
+      printf("  >=%8.3f ms %7u ", ToMilliseconds(1000ull << i),
+             histogram[i]);
+    else
+      printf("  <%9.3f ms %7u ", ToMilliseconds(2000ull << i),
+             histogram[i]);
+
+    for (unsigned j = 0; j < width; ++j)
+      putchar('#');
+    putchar('\n');
+  }
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE");
+  const auto path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  std::array<std::vector<uint_least64_t>,
+             unsigned(LatencyTrace::Stage::COUNT)> stages;
+
+  FileLineReaderA reader(path);
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    const char *name = strtok(line, " ");
+    const char *origin = strtok(nullptr, " ");
+    const char *latency = strtok(nullptr, " ");
+    if (name == nullptr || origin == nullptr || latency == nullptr)
+      continue;
+
+    const auto stage = LatencyTrace::ParseStageName(name);
+    if (stage == LatencyTrace::Stage::COUNT)
+      continue;
+
+    stages[unsigned(stage)].push_back(strtoull(latency, nullptr, 10));
+  }
+
+  for (unsigned i = 0; i < stages.size(); ++i)
+    PrintStage(LatencyTrace::Stage(i), stages[i]);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -24,26 +24,84 @@ Copyright_License {
 #include "Airspace/AirspaceParser.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "system/Args.hpp"
+#include "system/FileUtil.hpp"
 #include "io/FileLineReader.hpp"
 #include "Operation/Operation.hpp"
+#include "util/StringAPI.hxx"
 #include "util/PrintException.hxx"
 
+#include <chrono>
+
 #include <stdio.h>
 #include <tchar.h>
 
+static bool
+ParseFile(Airspaces &airspaces, Path path)
+{
+  FileLineReader reader(path, Charset::AUTO);
+  AirspaceParser parser(airspaces);
+
+  NullOperationEnvironment operation;
+  return parser.Parse(reader, operation);
+}
+
+/**
+ * Parse the file repeatedly and print the throughput.
+ */
+static bool
+Benchmark(Path path, unsigned n)
+{
+  const auto file_size = File::GetSize(path);
+
+  std::chrono::steady_clock::duration best =
+    std::chrono::steady_clock::duration::max();
+  unsigned n_airspaces = 0;
+
+  for (unsigned i = 0; i < n; ++i) {
+    Airspaces airspaces;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!ParseFile(airspaces, path))
+      return false;
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    best = std::min(best, duration);
+
+    airspaces.Optimise();
+    n_airspaces = airspaces.GetSize();
+  }
+
+  const double seconds = std::chrono::duration<double>(best).count();
+  printf("%u airspaces, %.1f ms, %.1f MB/s, %.0f airspaces/s\n",
+         n_airspaces, seconds * 1000,
+         file_size / seconds / (1024 * 1024),
+         n_airspaces / seconds);
+  return true;
+}
+
 int main(int argc, char **argv)
 try {
-  Args args(argc, argv, "PATH");
+  Args args(argc, argv, "[--benchmark] PATH");
+
+  const char *arg = args.PeekNext();
+  const bool benchmark = arg != nullptr && StringIsEqual(arg, "--benchmark");
+  if (benchmark)
+    args.Skip();
+
   const auto path = args.ExpectNextPath();
   args.ExpectEnd();
 
-  FileLineReader reader(path, Charset::AUTO);
+  if (benchmark) {
+    if (!Benchmark(path, 10)) {
+      fprintf(stderr, "Failed to parse input file\n");
+      return 1;
+    }
 
-  Airspaces airspaces;
-  AirspaceParser parser(airspaces);
+    return EXIT_SUCCESS;
+  }
 
-  NullOperationEnvironment operation;
-  if (!parser.Parse(reader, operation)) {
+  Airspaces airspaces;
+  if (!ParseFile(airspaces, path)) {
     fprintf(stderr, "Failed to parse input file\n");
     return 1;
   }
@@ -132,8 +132,8 @@ LoadReplay(DebugReplay *replay, GlideComputer &glide_computer,
 
   glide_computer.ProcessExhaustive();
 
-  blackboard.ReadBlackboardBasic(glide_computer.Basic());
-  blackboard.ReadBlackboardCalculated(glide_computer.Calculated());
+  blackboard.ReadBlackboardBasic(std::make_shared<const MoreData>(glide_computer.Basic()));
+  blackboard.ReadBlackboardCalculated(std::make_shared<const DerivedInfo>(glide_computer.Calculated()));
 }
 
 static DebugReplay *replay;
@@ -0,0 +1,198 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program replays a flight over a terrain (and optionally
+ * airspace) file and maintains the look-ahead corridor along the
+ * track, once incrementally and once rebuilding it from scratch for
+ * every fix.  It prints the time spent per fix and the difference
+ * between the two results in straight flight.
+ */
+
+#include "Computer/CorridorComputer.hpp"
+#include "Computer/CirclingComputer.hpp"
+#include "Computer/Settings.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "DebugReplay.hpp"
+#include "system/Args.hpp"
+#include "io/ZipArchive.hpp"
+#include "io/FileLineReader.hpp"
+#include "Operation/Operation.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <memory>
+
+#include <stdio.h>
+
+class Simulation {
+  const char *const name;
+  const bool incremental;
+
+  CorridorComputer computer;
+  CorridorInfo info;
+
+public:
+  unsigned n_fixes = 0;
+  std::chrono::steady_clock::duration total{}, max{};
+
+  Simulation(const char *_name, bool _incremental,
+             const Airspaces *airspaces)
+    :name(_name), incremental(_incremental), computer(airspaces) {
+    info.Clear();
+  }
+
+  const CorridorInfo &GetInfo() const {
+    return info;
+  }
+
+  void Step(const MoreData &basic, const DerivedInfo &calculated,
+            const ComputerSettings &settings, const RasterMap &map) {
+    if (!incremental)
+      computer.Reset();
+
+    const auto start = std::chrono::steady_clock::now();
+    computer.Update(basic, calculated, settings, &map, info);
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    ++n_fixes;
+    total += duration;
+    if (duration > max)
+      max = duration;
+  }
+
+  void Print() const {
+    using us = std::chrono::duration<double, std::micro>;
+    printf("%-12s fixes=%u avg=%.1fus max=%.1fus rebuilds=%u slices=%u\n",
+           name, n_fixes,
+           n_fixes > 0 ? us(total).count() / n_fixes : 0.,
+           us(max).count(),
+           computer.GetRebuildCount(), computer.GetScannedSliceCount());
+  }
+};
+
+static void
+LoadTerrain(ZipArchive &archive, RasterMap &map)
+{
+  NullOperationEnvironment operation;
+  if (!LoadTerrainOverview(archive.get(), map.GetTileCache(), operation))
+    throw std::runtime_error("Failed to load terrain");
+
+  map.UpdateProjection();
+
+  /* load all tiles, so loading doesn't invalidate the corridor
+     during the replay */
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(archive.get(), map.GetTileCache(), mutex,
+                       map.GetProjection(),
+                       map.GetMapCenter(), 1000000);
+  } while (map.IsDirty());
+}
+
+static void
+LoadAirspaces(Path path, Airspaces &airspaces)
+{
+  FileLineReader reader(path, Charset::AUTO);
+  AirspaceParser parser(airspaces);
+
+  NullOperationEnvironment operation;
+  if (!parser.Parse(reader, operation))
+    throw std::runtime_error("Failed to parse airspace file");
+
+  airspaces.Optimise();
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "DRIVER FILE TERRAIN [AIRSPACE]");
+  std::unique_ptr<DebugReplay> replay(CreateDebugReplay(args));
+  if (!replay)
+    return EXIT_FAILURE;
+
+  const auto terrain_path = args.ExpectNextPath();
+
+  Airspaces airspaces;
+  if (!args.IsEmpty())
+    LoadAirspaces(args.ExpectNextPath(), airspaces);
+
+  args.ExpectEnd();
+
+  ZipArchive archive(terrain_path);
+  RasterMap map;
+  LoadTerrain(archive, map);
+
+  /* CorridorComputer uses only these */
+  ComputerSettings settings;
+  settings.circling.SetDefaults();
+  settings.task.glide.SetDefaults();
+  settings.task.route_planner.SetDefaults();
+
+  CirclingComputer circling_computer;
+  circling_computer.Reset();
+
+  Simulation incremental("incremental", true, &airspaces);
+  Simulation full("full", false, &airspaces);
+
+  /* compare only in straight flight; the incremental corridor is
+     frozen while circling */
+  double max_delta = 0, sum_delta = 0;
+  unsigned n_compared = 0;
+
+  while (replay->Next()) {
+    circling_computer.TurnRate(replay->SetCalculated(),
+                               replay->Basic(),
+                               replay->Calculated().flight);
+    circling_computer.Turning(replay->SetCalculated(),
+                              replay->Basic(),
+                              replay->Calculated().flight,
+                              settings.circling);
+
+    replay->SetCalculated().glide_polar_safety = GlidePolar(0);
+
+    incremental.Step(replay->Basic(), replay->Calculated(), settings, map);
+    full.Step(replay->Basic(), replay->Calculated(), settings, map);
+
+    const CorridorInfo &a = incremental.GetInfo(), &b = full.GetInfo();
+    if (a.reach_available && b.reach_available &&
+        !replay->Calculated().circling) {
+      const double delta = fabs(a.min_clearance - b.min_clearance);
+      max_delta = std::max(max_delta, delta);
+      sum_delta += delta;
+      ++n_compared;
+    }
+  }
+
+  incremental.Print();
+  full.Print();
+  printf("clearance difference avg=%.0fm max=%.0fm\n",
+         n_compared > 0 ? sum_delta / n_compared : 0., max_delta);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
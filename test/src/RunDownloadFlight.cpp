@@ -31,6 +31,7 @@ Copyright_License {
 #include "DebugPort.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "system/ConvertPathName.hpp"
+#include "system/FileUtil.hpp"
 #include "Operation/ConsoleOperationEnvironment.hpp"
 #include "system/Args.hpp"
 #include "io/async/GlobalAsioThread.hpp"
@@ -39,6 +40,8 @@ Copyright_License {
 #include "util/ConvertString.hpp"
 #include "util/PrintException.hxx"
 
+#include <chrono>
+
 #include <stdio.h>
 
 bool
@@ -151,15 +154,24 @@ try {
     return EXIT_FAILURE;
   }
 
+  const auto start = std::chrono::steady_clock::now();
+
   if (!device->DownloadFlight(flight_list[flight_id], path, env)) {
     delete device;
     fprintf(stderr, "Failed to download flight\n");
     return EXIT_FAILURE;
   }
 
+  const std::chrono::duration<double> duration =
+    std::chrono::steady_clock::now() - start;
+
+  device->EnableNMEA(env);
   delete device;
 
-  printf("Flight downloaded successfully\n");
+  const uint64_t size = File::GetSize(path);
+  printf("Flight downloaded successfully: %llu bytes in %.2f s (%.0f bytes/s)\n",
+         (unsigned long long)size, duration.count(),
+         size / duration.count());
 
   return EXIT_SUCCESS;
 } catch (const std::exception &exception) {
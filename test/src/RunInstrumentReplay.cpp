@@ -0,0 +1,182 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Replay a flight through the glide computer with all
+ * instrumentation probes enabled, and print the aggregated report
+ * (see time/Instrument.hpp) at exit.  This requires a build with
+ * INSTRUMENT=y; otherwise the report is empty.
+ */
+
+#define ENABLE_DATA_PATH
+#define ENABLE_CMDLINE
+#define USAGE "[--map=FILE.xcm] [--task=FILE.tsk] [--idle=MS] DRIVER FILE"
+
+#include "Main.hpp"
+#include "DebugReplay.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/TaskEvents.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/Settings.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Task/LoadFile.hpp"
+#include "Profile/Profile.hpp"
+#include "Profile/ProfileKeys.hpp"
+#include "Operation/Operation.hpp"
+#include "system/Path.hpp"
+#include "time/Instrument.hpp"
+#include "util/StringCompare.hxx"
+#include "util/NumberParser.hpp"
+
+#include <chrono>
+#include <memory>
+
+#include <stdio.h>
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+void
+ConditionMonitorsUpdate(const NMEAInfo &basic, const DerivedInfo &calculated,
+                        const ComputerSettings &settings)
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent(const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent(const NMEAInfo &gps_info) {}
+void Logger::LogPoint(const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+static const char *map_path, *task_path;
+
+/**
+ * The time budget for the idle jobs after each fix, like the
+ * CalculationThread grants with a 1 Hz GPS.
+ */
+static std::chrono::milliseconds idle_budget(500);
+
+static std::unique_ptr<DebugReplay> replay;
+
+static void
+ParseCommandLine(Args &args)
+{
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--map=")) != nullptr) {
+      map_path = value;
+    } else if ((value = StringAfterPrefix(arg, "--task=")) != nullptr) {
+      task_path = value;
+    } else if ((value = StringAfterPrefix(arg, "--idle=")) != nullptr) {
+      char *endptr;
+      idle_budget = std::chrono::milliseconds(ParseUnsigned(value, &endptr));
+      if (endptr == value || *endptr != 0)
+        args.UsageError();
+    } else
+      args.UsageError();
+  }
+
+  replay.reset(CreateDebugReplay(args));
+  if (replay == nullptr)
+    exit(EXIT_FAILURE);
+
+  args.ExpectEnd();
+}
+
+static void
+Main()
+{
+  ComputerSettings settings_computer;
+  settings_computer.SetDefaults();
+  settings_computer.polar.glide_polar_task = GlidePolar(1);
+
+  NullOperationEnvironment operation;
+
+  std::unique_ptr<RasterTerrain> terrain;
+  if (map_path != nullptr) {
+    /* RasterTerrain obtains the map file from the profile */
+    Profile::SetPath(ProfileKeys::MapFile, Path(map_path));
+
+    terrain.reset(RasterTerrain::OpenTerrain(nullptr, operation));
+    if (terrain == nullptr)
+      throw std::runtime_error("Failed to load terrain");
+  }
+
+  const Waypoints way_points;
+  Airspaces airspace_database;
+
+  TaskManager task_manager(settings_computer.task, way_points);
+  task_manager.SetGlidePolar(settings_computer.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  ProtectedTaskManager protected_task_manager(task_manager,
+                                              settings_computer.task);
+
+  if (task_path != nullptr) {
+    std::unique_ptr<OrderedTask> task(LoadTask(Path(task_path),
+                                               settings_computer.task));
+    if (task == nullptr)
+      throw std::runtime_error("Failed to load task");
+
+    protected_task_manager.TaskCommit(*task);
+  }
+
+  GlideComputer glide_computer(settings_computer,
+                               way_points, airspace_database,
+                               protected_task_manager,
+                               task_events);
+  glide_computer.SetTerrain(terrain.get());
+  glide_computer.Initialise();
+
+  Instrument::Enable();
+
+  while (replay->Next()) {
+    glide_computer.ReadBlackboard(replay->Basic());
+    glide_computer.ProcessGPS();
+    glide_computer.ProcessLogging();
+    glide_computer.RunIdleJobs(idle_budget);
+  }
+
+  Instrument::Disable();
+
+#ifndef INSTRUMENT
+  fprintf(stderr, "Warning: compiled without INSTRUMENT=y\n");
+#endif
+
+  fputs(Instrument::FormatReport().c_str(), stdout);
+}
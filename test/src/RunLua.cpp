@@ -25,13 +25,20 @@ Copyright_License {
 #include "lua/Log.hpp"
 #include "lua/RunFile.hxx"
 #include "lua/Ptr.hpp"
+#include "lua/FieldIndex.hpp"
+#include "lua/Error.hxx"
 #include "system/Args.hpp"
+#include "util/StringAPI.hxx"
 #include "util/PrintException.hxx"
 
 extern "C" {
 #include <lua.h>
+#include <lauxlib.h>
 }
 
+#include <chrono>
+#include <iterator>
+
 #include <stdio.h>
 
 static int
@@ -41,9 +48,159 @@ l_alert(lua_State *L)
   return 0;
 }
 
+/**
+ * The field names of xcsoar.blackboard.  The real binding cannot be
+ * used here because it needs the whole user interface; the
+ * benchmark tables below return the field number instead.
+ */
+static constexpr const char *bench_field_names[] = {
+  "location", "altitude", "track", "ground_speed", "air_speed",
+  "bank_angle", "pitch_angle", "heading", "g_load",
+  "static_pressure", "pitot_pressure", "dynamic_pressure",
+  "temperature", "humidity", "voltage", "battery_level",
+  "noncomp_vario", "total_energy_vario", "netto_vario",
+};
+
+/**
+ * The old way: compare the key with each field name.
+ */
+static int
+l_bench_strcmp_index(lua_State *L)
+{
+  const char *name = lua_tostring(L, 2);
+  if (name == nullptr)
+    return 0;
+
+  for (unsigned i = 0; i < std::size(bench_field_names); ++i) {
+    if (StringIsEqual(name, bench_field_names[i])) {
+      lua_pushinteger(L, i);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static int
+l_bench_interned_index(lua_State *L)
+{
+  const int field = Lua::LookupField(L, lua_upvalueindex(1), 2);
+  if (field < 0)
+    return 0;
+
+  lua_pushinteger(L, field);
+  return 1;
+}
+
+static int
+l_bench_snapshot(lua_State *L)
+{
+  Lua::PushFieldSnapshot(L, lua_upvalueindex(1), [L](int field){
+    lua_pushinteger(L, field);
+    return true;
+  });
+  return 1;
+}
+
+/**
+ * Polls twelve values per call, like a script which displays them
+ * from a timer.
+ */
+static constexpr char bench_script[] = R"(
+local strcmp, interned = ...
+local keys = {
+  "location", "altitude", "track", "ground_speed", "air_speed",
+  "heading", "temperature", "voltage", "noncomp_vario",
+  "total_energy_vario", "netto_vario", "battery_level",
+}
+
+local function poll(t)
+  local sum = 0
+  for i = 1, #keys do
+    sum = sum + t[keys[i]]
+  end
+  return sum
+end
+
+return {
+  strcmp = function() return poll(strcmp) end,
+  interned = function() return poll(interned) end,
+  snapshot = function() return poll(interned.snapshot()) end,
+}
+)";
+
+static void
+PushBenchTable(lua_State *L, lua_CFunction index)
+{
+  lua_newtable(L);
+  lua_newtable(L);
+  Lua::PushFieldIndexClosure(L, index, bench_field_names);
+  lua_setfield(L, -2, "__index");
+  lua_setmetatable(L, -2);
+}
+
+static void
+RunBenchmark(lua_State *L, const char *name, unsigned n)
+{
+  lua_getfield(L, -1, name);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    lua_pushvalue(L, -1);
+    if (lua_pcall(L, 0, 1, 0))
+      throw Lua::PopError(L);
+    lua_pop(L, 1);
+  }
+  const std::chrono::duration<double, std::nano> duration =
+    std::chrono::steady_clock::now() - start;
+
+  lua_pop(L, 1);
+
+  printf("%-10s %8.0f ns per poll of 12 values\n", name, duration.count() / n);
+}
+
+/**
+ * Compare the cost of looking up blackboard fields with string
+ * comparisons, with interned keys, and with one snapshot() call.
+ */
+static void
+Benchmark(lua_State *L)
+{
+  if (luaL_loadstring(L, bench_script))
+    throw Lua::PopError(L);
+
+  PushBenchTable(L, l_bench_strcmp_index);
+  PushBenchTable(L, l_bench_interned_index);
+
+  Lua::PushFieldIndex(L, bench_field_names);
+  lua_pushcclosure(L, l_bench_snapshot, 1);
+  lua_setfield(L, -2, "snapshot");
+
+  if (lua_pcall(L, 2, 1, 0))
+    throw Lua::PopError(L);
+
+  constexpr unsigned n = 200000;
+  RunBenchmark(L, "strcmp", n);
+  RunBenchmark(L, "interned", n);
+  RunBenchmark(L, "snapshot", n);
+
+  lua_pop(L, 1);
+}
+
 int main(int argc, char **argv)
 try {
-  Args args(argc, argv, "FILE.lua");
+  Args args(argc, argv, "--benchmark | FILE.lua");
+
+  const char *arg = args.PeekNext();
+  if (arg != nullptr && StringIsEqual(arg, "--benchmark")) {
+    args.Skip();
+    args.ExpectEnd();
+
+    Lua::StatePtr state(Lua::NewBasicState());
+    Benchmark(state.get());
+    return EXIT_SUCCESS;
+  }
+
   const auto path = args.ExpectNextPath();
   args.ExpectEnd();
 
@@ -0,0 +1,272 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program replays a flight over the terrain and topography of a
+ * map file, driving the real #TerrainThread and #TopographyThread,
+ * and counts how often the visible area was not loaded completely,
+ * once without and once with prefetching ahead of the aircraft (see
+ * PredictMapLocation()).
+ *
+ * The flight is replayed faster than real time (see #REPLAY_SPEED),
+ * which emulates the background threads falling behind a fast
+ * aircraft.
+ */
+
+#include "MapWindow/Prefetch.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Terrain/Thread.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Topography/TopographyGlue.hpp"
+#include "Topography/Thread.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Computer/CirclingComputer.hpp"
+#include "Computer/Settings.hpp"
+#include "Profile/Profile.hpp"
+#include "Profile/ProfileKeys.hpp"
+#include "DebugReplay.hpp"
+#include "LocalPath.hpp"
+#include "system/Args.hpp"
+#include "system/Sleep.h"
+#include "Operation/Operation.hpp"
+#include "util/PrintException.hxx"
+
+#include <memory>
+#include <vector>
+
+#include <stdio.h>
+
+/**
+ * The radius of the simulated map screen [m].
+ */
+static constexpr double SCREEN_RADIUS = 10000;
+
+/**
+ * How much faster than real time is the flight replayed?
+ */
+static constexpr double REPLAY_SPEED = 100;
+
+struct Fix {
+  double time;
+
+  GeoPoint location;
+
+  /**
+   * The result of PredictMapLocation().
+   */
+  GeoPoint lookahead;
+};
+
+class Simulation {
+  const bool prefetch;
+
+  std::unique_ptr<RasterTerrain> terrain;
+  TopographyStore topography;
+
+  std::unique_ptr<TerrainThread> terrain_thread;
+  std::unique_ptr<TopographyThread> topography_thread;
+
+  WindowProjection projection;
+
+public:
+  /**
+   * The number of fixes where terrain tiles were missing in the
+   * visible area.
+   */
+  unsigned terrain_misses = 0;
+
+  /**
+   * The sum of visible terrain tiles which were not loaded, over all
+   * fixes.
+   */
+  unsigned terrain_gaps = 0;
+
+  /**
+   * The number of fixes where topography files had not been loaded
+   * for the visible area.
+   */
+  unsigned topography_misses = 0;
+
+  /**
+   * The sum of visible topography files whose cache did not cover the
+   * visible area, over all fixes.
+   */
+  unsigned topography_gaps = 0;
+
+  explicit Simulation(bool _prefetch)
+    :prefetch(_prefetch) {
+    NullOperationEnvironment operation;
+    terrain.reset(RasterTerrain::OpenTerrain(nullptr, operation));
+    LoadConfiguredTopography(topography, operation);
+
+    if (terrain)
+      terrain_thread = std::make_unique<TerrainThread>(*terrain, nullptr);
+
+    topography_thread = std::make_unique<TopographyThread>(topography,
+                                                           nullptr);
+
+    projection.SetScreenSize({640, 480});
+    projection.SetScreenOrigin(320, 240);
+    projection.SetScaleFromRadius(SCREEN_RADIUS);
+  }
+
+  ~Simulation() {
+    if (terrain_thread)
+      terrain_thread->LockStop();
+    topography_thread->LockStop();
+  }
+
+  void Run(const std::vector<Fix> &fixes);
+
+  void Print() const {
+    printf("%-12s terrain misses=%u gaps=%u"
+           " topography misses=%u gaps=%u\n",
+           prefetch ? "prefetch" : "no prefetch",
+           terrain_misses, terrain_gaps,
+           topography_misses, topography_gaps);
+  }
+
+private:
+  void Step(const Fix &fix);
+};
+
+inline void
+Simulation::Step(const Fix &fix)
+{
+  projection.SetGeoLocation(fix.location);
+  projection.UpdateScreenBounds();
+
+  /* check what the map would draw now, i.e. what the threads have
+     loaded since the previous fix */
+
+  if (terrain) {
+    const auto radius = projection.GetScreenWidthMeters() / 2;
+    RasterTerrain::Lease lease(*terrain);
+    const unsigned missing = lease->CountMissingTiles(fix.location, radius);
+    if (missing > 0) {
+      ++terrain_misses;
+      terrain_gaps += missing;
+    }
+  }
+
+  unsigned outdated = 0;
+  for (unsigned i = 0; i < topography.size(); ++i)
+    if (!topography[i].IsLoaded(projection))
+      ++outdated;
+
+  if (outdated > 0) {
+    ++topography_misses;
+    topography_gaps += outdated;
+  }
+
+  /* request the new area, like GlueMapWindow::UpdateScreenBounds()
+     does */
+
+  const GeoPoint lookahead = prefetch ? fix.lookahead : GeoPoint::Invalid();
+
+  if (terrain_thread)
+    terrain_thread->Trigger(projection, lookahead);
+  topography_thread->Trigger(projection, lookahead);
+}
+
+void
+Simulation::Run(const std::vector<Fix> &fixes)
+{
+  double last_time = fixes.empty() ? 0 : fixes.front().time;
+
+  for (const auto &fix : fixes) {
+    if (fix.time > last_time)
+      Sleep(unsigned((fix.time - last_time) * 1000 / REPLAY_SPEED));
+    last_time = fix.time;
+
+    Step(fix);
+  }
+}
+
+static std::vector<Fix>
+LoadFixes(DebugReplay &replay)
+{
+  CirclingSettings circling_settings;
+  circling_settings.SetDefaults();
+
+  CirclingComputer circling_computer;
+  circling_computer.Reset();
+
+  std::vector<Fix> fixes;
+
+  while (replay.Next()) {
+    const MoreData &basic = replay.Basic();
+
+    circling_computer.TurnRate(replay.SetCalculated(), basic,
+                               replay.Calculated().flight);
+    circling_computer.Turning(replay.SetCalculated(), basic,
+                              replay.Calculated().flight,
+                              circling_settings);
+
+    if (basic.location_available && basic.time_available)
+      fixes.push_back({basic.time, basic.location,
+                       PredictMapLocation(basic, replay.Calculated(),
+                                          SCREEN_RADIUS)});
+  }
+
+  return fixes;
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "MAPFILE DRIVER FILE");
+  const auto map_path = args.ExpectNextPath();
+
+  std::unique_ptr<DebugReplay> replay(CreateDebugReplay(args));
+  if (!replay)
+    return EXIT_FAILURE;
+
+  args.ExpectEnd();
+
+  InitialiseDataPath();
+
+  /* RasterTerrain and the topography loader obtain the map file from
+     the profile */
+  Profile::SetPath(ProfileKeys::MapFile, map_path);
+
+  const auto fixes = LoadFixes(*replay);
+
+  {
+    Simulation without(false);
+    without.Run(fixes);
+    without.Print();
+  }
+
+  {
+    Simulation with(true);
+    with.Run(fixes);
+    with.Print();
+  }
+
+  DeinitialiseDataPath();
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -166,8 +166,9 @@ GenerateBlackboard(MapWindow &map, const ComputerSettings &settings_computer,
   if (terrain != nullptr)
     while (terrain->UpdateTiles(nmea_info.location, 50000)) {}
 
-  map.ReadBlackboard(nmea_info, derived_info, settings_computer,
-                     settings_map);
+  map.ReadBlackboard(std::make_shared<const MoreData>(nmea_info),
+                     std::make_shared<const DerivedInfo>(derived_info),
+                     settings_computer, settings_map);
   map.SetLocation(nmea_info.location);
   map.UpdateScreenBounds();
 }
@@ -22,13 +22,22 @@ Copyright_License {
 */
 
 #include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/WaypointReaderBase.hpp"
+#include "Waypoint/WaypointFileType.hpp"
 #include "Waypoint/Factory.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "Engine/Waypoint/WaypointVisitor.hpp"
 #include "system/Args.hpp"
 #include "Operation/Operation.hpp"
+#include "io/FileLineReader.hpp"
+#include "util/StringAPI.hxx"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+
+#include <chrono>
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <tchar.h>
 
 class DumpVisitor : public WaypointVisitor {
@@ -42,27 +51,86 @@ public:
   }
 };
 
-int main(int argc, char **argv)
+static double
+ToMilliseconds(std::chrono::steady_clock::duration d)
 {
-  Args args(argc, argv, "PATH\n");
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[--benchmark] [--threads=N] PATH\n");
+
+  bool benchmark = false;
+  unsigned max_threads = 0;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr) {
+    const char *value;
+    if (StringIsEqual(arg, "--benchmark"))
+      benchmark = true;
+    else if ((value = StringAfterPrefix(arg, "--threads=")) != nullptr)
+      /* 1 disables the parallel parser */
+      max_threads = strtoul(value, nullptr, 10);
+    else
+      break;
+
+    args.Skip();
+  }
+
   const auto path = args.ExpectNextPath();
   args.ExpectEnd();
 
+  const auto file_type = DetermineWaypointFileType(path);
+
+  /* in benchmark mode, load the file several times and report the
+     best run */
+  const unsigned n = benchmark ? 5 : 1;
+
+  std::chrono::steady_clock::duration best_parse =
+    std::chrono::steady_clock::duration::max();
+  std::chrono::steady_clock::duration best_optimise = best_parse;
+
   Waypoints way_points;
 
-  NullOperationEnvironment operation;
-  if (!ReadWaypointFile(path, way_points,
-                        WaypointFactory(WaypointOrigin::NONE),
-                        operation)) {
-    fprintf(stderr, "ReadWaypointFile() has failed\n");
-    return EXIT_FAILURE;
+  for (unsigned i = 0; i < n; ++i) {
+    way_points.Clear();
+
+    auto reader = CreateWaypointReader(file_type,
+                                       WaypointFactory(WaypointOrigin::NONE));
+    if (!reader) {
+      fprintf(stderr, "Unsupported waypoint file type\n");
+      return EXIT_FAILURE;
+    }
+
+    reader->SetMaxThreads(max_threads);
+
+    NullOperationEnvironment operation;
+    const auto start = std::chrono::steady_clock::now();
+    FileLineReader line_reader(path, Charset::AUTO);
+    reader->Parse(way_points, line_reader, operation);
+
+    const auto parsed = std::chrono::steady_clock::now();
+    way_points.Optimise();
+    const auto optimised = std::chrono::steady_clock::now();
+
+    best_parse = std::min(best_parse, parsed - start);
+    best_optimise = std::min(best_optimise, optimised - parsed);
   }
 
-  way_points.Optimise();
+  fprintf(stderr, "Parse %.1f ms, Optimise %.1f ms\n",
+          ToMilliseconds(best_parse), ToMilliseconds(best_optimise));
+
   printf("Size %d\n", way_points.size());
 
+  if (benchmark)
+    return EXIT_SUCCESS;
+
   DumpVisitor visitor;
   way_points.VisitNamePrefix(_T(""), visitor);
 
   return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
 }
@@ -0,0 +1,135 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Verify that the AVX2 pixel operations (enabled by -mavx2) give the
+ * same results as the MMX and portable code they replace.
+ */
+
+#include "ui/canvas/memory/PixelTraits.hpp"
+#include "ui/canvas/memory/Optimised.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#if !defined(__AVX2__) || !defined(__MMX__) || defined(GREYSCALE)
+#error This test requires -mavx2
+#endif
+
+using Pixels = std::vector<BGRA8Color>;
+
+/* spans shorter, equal to and longer than one AVX2 vector, with
+   remainders for the MMX and portable code */
+static constexpr unsigned lengths[] = { 0, 1, 7, 8, 9, 15, 16, 17, 333 };
+
+static std::minstd_rand rng;
+
+static BGRA8Color
+RandomColor()
+{
+  const uint32_t i = rng();
+  return BGRA8Color(i, i >> 8, i >> 16, i >> 24);
+}
+
+static Pixels
+RandomPixels(unsigned n)
+{
+  Pixels p(n, BGRA8Color(0, 0, 0, 0));
+  std::generate(p.begin(), p.end(), RandomColor);
+  return p;
+}
+
+static bool
+TestFill(unsigned n)
+{
+  const BGRA8Color c = RandomColor();
+  Pixels p(n + 1, BGRA8Color(0, 0, 0, 0));
+  BGRAPixelTraits::FillPixels(p.data(), n, c);
+
+  return std::all_of(p.begin(), p.begin() + n,
+                     [c](const BGRA8Color &i){ return i == c; }) &&
+    p[n] == BGRA8Color(0, 0, 0, 0);
+}
+
+static bool
+TestAlphaFill(unsigned n, uint8_t alpha)
+{
+  const BGRA8Color c = RandomColor();
+  const Pixels src = RandomPixels(n);
+
+  Pixels expected = src;
+  MMXBGRAAlphaPixelOperations(alpha).FillPixels(expected.data(), n, c);
+
+  Pixels actual = src;
+  AlphaPixelOperations<BGRAPixelTraits>(alpha).FillPixels(actual.data(),
+                                                          n, c);
+  return actual == expected;
+}
+
+static bool
+TestAlphaCopy(unsigned n, uint8_t alpha)
+{
+  const Pixels src = RandomPixels(n), dest = RandomPixels(n);
+
+  Pixels expected = dest;
+  MMXBGRAAlphaPixelOperations(alpha).CopyPixels(expected.data(),
+                                                src.data(), n);
+
+  Pixels actual = dest;
+  AlphaPixelOperations<BGRAPixelTraits>(alpha).CopyPixels(actual.data(),
+                                                          src.data(), n);
+  return actual == expected;
+}
+
+static constexpr uint8_t alphas[] = { 0, 1, 0x80, 0xfe, 0xff };
+
+int main(int argc, char **argv)
+{
+  constexpr unsigned n_lengths = std::size(lengths);
+  plan_tests(n_lengths * 3);
+
+  if (!__builtin_cpu_supports("avx2")) {
+    skip(n_lengths * 3, 1, "CPU does not support AVX2");
+    return exit_status();
+  }
+
+  for (const unsigned n : lengths) {
+    bool fill = true, alpha_fill = true, alpha_copy = true;
+    for (unsigned i = 0; i < 100; ++i) {
+      fill &= TestFill(n);
+
+      for (const uint8_t alpha : alphas) {
+        alpha_fill &= TestAlphaFill(n, alpha);
+        alpha_copy &= TestAlphaCopy(n, alpha);
+      }
+    }
+
+    ok(fill, "fill %u", n);
+    ok(alpha_fill, "alpha fill %u", n);
+    ok(alpha_copy, "alpha copy %u", n);
+  }
+
+  return exit_status();
+}
@@ -0,0 +1,204 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Renderer/AirspaceScreenCache.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Airspace/Airspaces.hpp"
+#include "Airspace/AirspacePolygon.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <stdlib.h>
+
+/**
+ * The maximum deviation (in pixels) of a translated cached vertex
+ * from a fresh projection: #AirspaceScreenCache::MAX_PAN_ERROR plus
+ * the integer rounding of the cached vertex and of the offset.
+ */
+static constexpr int TOLERANCE = 3;
+
+static constexpr unsigned NUM_VERTICES = 16;
+
+static WindowProjection
+MakeProjection(GeoPoint location, double scale, Angle angle)
+{
+  WindowProjection projection;
+  projection.SetScreenSize({640, 480});
+  projection.SetScreenOrigin(320, 240);
+  projection.SetGeoLocation(location);
+  projection.SetScale(scale);
+  projection.SetScreenAngle(angle);
+  projection.UpdateScreenBounds();
+  return projection;
+}
+
+/**
+ * Move the map by the given number of pixels.
+ */
+static void
+Pan(WindowProjection &projection, int dx, int dy)
+{
+  projection.SetGeoLocation(projection.ScreenToGeo(320 + dx, 240 + dy));
+  projection.UpdateScreenBounds();
+}
+
+/**
+ * Create a ring of vertices around the given location which fits on
+ * the screen of MakeProjection() at the given scale.
+ */
+static std::vector<GeoPoint>
+MakeRing(GeoPoint center, double scale)
+{
+  const double radius_pixels = 200;
+  const Angle radius = Angle::Radians(radius_pixels /
+                                      (scale * 6371000));
+
+  std::vector<GeoPoint> ring;
+  for (unsigned i = 0; i < NUM_VERTICES; ++i) {
+    const auto sc = (Angle::FullCircle() * i / NUM_VERTICES).SinCos();
+    ring.emplace_back(center.longitude +
+                      radius * sc.second * center.latitude.invfastcosine(),
+                      center.latitude + radius * sc.first);
+  }
+
+  return ring;
+}
+
+/**
+ * Compare the cached polygon with a fresh projection of its vertices.
+ * Clipping may rotate the polygon, so all cyclic shifts are tried.
+ *
+ * @return the maximum deviation in pixels, or -1 if the vertex
+ * count differs
+ */
+static int
+Deviation(AirspaceScreenCache &cache, const AirspacePolygon &airspace,
+          const std::vector<GeoPoint> &vertices,
+          const WindowProjection &projection)
+{
+  const auto points = cache.GetPolygon(airspace, projection);
+  const unsigned n = vertices.size();
+  if (points.size != n)
+    return -1;
+
+  const PixelPoint offset = cache.GetOffset();
+
+  int best = -1;
+  for (unsigned shift = 0; shift < n; ++shift) {
+    int deviation = 0;
+    for (unsigned i = 0; i < n; ++i) {
+      const auto actual = points[(i + shift) % n] + offset;
+      const auto expected = projection.GeoToScreen(vertices[i]);
+      deviation = std::max(deviation,
+                           std::max(abs(actual.x - expected.x),
+                                    abs(actual.y - expected.y)));
+    }
+
+    if (best < 0 || deviation < best)
+      best = deviation;
+  }
+
+  return best;
+}
+
+static void
+TestCache(GeoPoint center, double scale)
+{
+  const auto vertices = MakeRing(center, scale);
+
+  Airspaces airspaces;
+  auto *airspace = new AirspacePolygon(vertices);
+  airspaces.Add(airspace);
+  airspaces.Optimise();
+
+  AirspaceScreenCache cache;
+
+  /* a fresh cache is exact */
+  auto projection = MakeProjection(center, scale, Angle::Zero());
+  cache.Update(airspaces, projection);
+  ok1(Deviation(cache, *airspace, vertices, projection) == 0);
+
+  /* pan north and south: a translation */
+  Pan(projection, 0, -100);
+  cache.Update(airspaces, projection);
+  ok1(cache.GetOffset().y != 0);
+  ok1(Deviation(cache, *airspace, vertices, projection) <= TOLERANCE);
+
+  Pan(projection, 0, 180);
+  cache.Update(airspaces, projection);
+  ok1(Deviation(cache, *airspace, vertices, projection) <= TOLERANCE);
+
+  /* pan east and west in small steps; the error grows with the
+     total distance, until the cache gets rebuilt */
+  bool ok = true;
+  for (unsigned i = 0; i < 20; ++i) {
+    Pan(projection, 15, 0);
+    cache.Update(airspaces, projection);
+    const int deviation = Deviation(cache, *airspace, vertices, projection);
+    if (deviation < 0 || deviation > TOLERANCE)
+      ok = false;
+  }
+  ok(ok, "east-west pan");
+
+  /* zoom: rebuild */
+  projection.SetScale(scale * 1.25);
+  projection.UpdateScreenBounds();
+  cache.Update(airspaces, projection);
+  ok1(cache.GetOffset() == PixelPoint(0, 0));
+  ok1(Deviation(cache, *airspace, vertices, projection) == 0);
+
+  /* rotate: rebuild */
+  projection.SetScreenAngle(Angle::Degrees(30));
+  projection.UpdateScreenBounds();
+  cache.Update(airspaces, projection);
+  ok1(cache.GetOffset() == PixelPoint(0, 0));
+  ok1(Deviation(cache, *airspace, vertices, projection) == 0);
+
+  /* pan the rotated map diagonally */
+  ok = true;
+  for (unsigned i = 0; i < 10; ++i) {
+    Pan(projection, 12, -8);
+    cache.Update(airspaces, projection);
+    const int deviation = Deviation(cache, *airspace, vertices, projection);
+    if (deviation < 0 || deviation > TOLERANCE)
+      ok = false;
+  }
+  ok(ok, "rotated pan");
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(30);
+
+  /* 50 km and 500 km across the screen */
+  TestCache(GeoPoint(Angle::Degrees(7), Angle::Degrees(51)), 640. / 50000);
+  TestCache(GeoPoint(Angle::Degrees(7), Angle::Degrees(51)), 640. / 500000);
+
+  /* high latitude, where east-west pans distort the most */
+  TestCache(GeoPoint(Angle::Degrees(20), Angle::Degrees(65)), 640. / 500000);
+
+  return exit_status();
+}
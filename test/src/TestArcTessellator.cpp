@@ -0,0 +1,118 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Geo/ArcTessellator.hpp"
+#include "Geo/Math.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+/**
+ * Returns the largest distance between ArcTessellator::Calculate()
+ * and FindLatitudeLongitude() on a full circle.
+ */
+static double
+MaxError(const GeoPoint center, double radius)
+{
+  const ArcTessellator arc(center, radius);
+
+  double max_error = 0;
+  for (unsigned i = 0; i < 360; i += 15) {
+    const Angle bearing = Angle::Degrees(i);
+    const double error = arc.Calculate(bearing)
+      .Distance(FindLatitudeLongitude(center, bearing, radius));
+    if (error > max_error)
+      max_error = error;
+  }
+
+  return max_error;
+}
+
+static void
+TestCalculate()
+{
+  static constexpr double latitudes[] = { -60, 0, 30, 47, 80 };
+  static constexpr double radii[] = { 1000, 10000, 50000, 100000 };
+
+  for (const double latitude : latitudes) {
+    const GeoPoint center(Angle::Degrees(7.5), Angle::Degrees(latitude));
+
+    for (const double radius : radii) {
+      const double error = MaxError(center, radius);
+      if (!ok1(error < 1 + radius * 2e-5))
+        printf("# latitude=%f radius=%f error=%f\n",
+               latitude, radius, error);
+    }
+  }
+
+  /* across the date line */
+  const GeoPoint center(Angle::Degrees(179.9), Angle::Degrees(10));
+  const ArcTessellator arc(center, 50000);
+  const GeoPoint east = arc.Calculate(Angle::QuarterCircle());
+  ok1(east.longitude.Degrees() < -179);
+  ok1(east.Distance(FindLatitudeLongitude(center, Angle::QuarterCircle(),
+                                          50000)) < 5);
+}
+
+static void
+TestAppendArc(Angle start, Angle end, int step, unsigned expected_size)
+{
+  const GeoPoint center(Angle::Degrees(10), Angle::Degrees(50));
+  const ArcTessellator arc(center, 20000);
+
+  std::vector<GeoPoint> points;
+  arc.AppendArc(points, start, end, step);
+  ok1(points.size() == expected_size);
+
+  /* each point must be where Calculate() would put it */
+  bool match = true;
+  for (unsigned i = 0; i < points.size(); ++i) {
+    const Angle bearing = start + Angle::Degrees(step * int(i + 1));
+    if (points[i].Distance(arc.Calculate(bearing)) > 0.001)
+      match = false;
+  }
+
+  ok1(match);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(20 + 2 + 4 * 2);
+
+  TestCalculate();
+
+  /* clockwise; 85 is the last point, because 90 is less than 1.5
+     steps away */
+  TestAppendArc(Angle::Zero(), Angle::Degrees(90), 5, 17);
+
+  /* counter-clockwise */
+  TestAppendArc(Angle::Degrees(90), Angle::Zero(), -5, 17);
+
+  /* full circle in 1 degree steps */
+  TestAppendArc(Angle::Zero(), Angle::FullCircle(), 1, 359);
+
+  /* too short for intermediate points */
+  TestAppendArc(Angle::Zero(), Angle::Degrees(2.5), 2, 0);
+
+  return exit_status();
+}
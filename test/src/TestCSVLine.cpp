@@ -26,6 +26,9 @@
 #include <cstring>
 #include <string>
 
+#include <cmath>
+#include <stdlib.h>
+
 static void
 Test1()
 {
@@ -97,13 +100,48 @@ Test2()
   ok1(!line.ReadChecked(temp_int) && temp_int == 42);
 }
 
+/**
+ * The fast decimal decoder must produce bit-exact strtod() results.
+ */
+static void
+TestDecimal()
+{
+  static const char *const values[] = {
+    "-12.345", "+7", ".5", "1.", "0.1", "4807.038", "01131.000",
+    "123456789.123456", "1e3", "-2.5E-2", "0x10", "-0",
+    "12345678901234567890.5", "0.0000000000000000000000001",
+  };
+
+  for (const char *value : values) {
+    CSVLine line(value);
+    double result;
+    ok1(line.ReadChecked(result) && result == strtod(value, nullptr) &&
+        std::signbit(result) == std::signbit(strtod(value, nullptr)));
+  }
+
+  CSVLine line("-42,+17,2147483647,4000000000,.,-,x");
+  long l;
+  ok1(line.ReadChecked(l) && l == -42);
+  ok1(line.ReadChecked(l) && l == 17);
+  ok1(line.ReadChecked(l) && l == 2147483647);
+
+  unsigned long ul;
+  ok1(line.ReadChecked(ul) && ul == 4000000000ul);
+
+  double d;
+  ok1(!line.ReadChecked(d));
+  ok1(!line.ReadChecked(d));
+  ok1(!line.ReadChecked(d));
+}
+
 int
 main(int argc, char **argv)
 {
-  plan_tests(19);
+  plan_tests(40);
 
   Test1();
   Test2();
+  TestDecimal();
 
   return exit_status();
 }
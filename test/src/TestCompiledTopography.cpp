@@ -0,0 +1,178 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/CompiledTopography.hpp"
+#include "Topography/shapelib/mapserver.h"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+#include <string.h>
+
+using namespace CompiledTopography;
+
+/**
+ * Builds a compiled topography file with one triangle, two tiles and
+ * one thinned index set.
+ */
+struct FileBuilder {
+  std::vector<uint32_t> tile_offsets{0, 1, 1};
+  std::vector<uint16_t> indices{3, 0, 1, 2};
+  uint32_t index_offset = 0;
+
+  template<typename T>
+  static void Append(std::vector<uint8_t> &dest, const T *src, size_t n) {
+    const uint8_t *p = (const uint8_t *)src;
+    dest.insert(dest.end(), p, p + n * sizeof(T));
+    dest.resize(Align(dest.size()));
+  }
+
+  AllocatedArray<uint8_t> Build() const {
+    static constexpr Point points[] = {
+      {0, 0}, {0.001f, 0}, {0, 0.001f},
+    };
+    static constexpr uint16_t lines[] = {3};
+    static constexpr uint32_t entries[] = {0};
+
+    Shape shape;
+    memset(&shape, 0, sizeof(shape));
+    shape.north_east = {0.001f, 0.001f};
+    shape.type = MS_SHAPE_POLYGON;
+    shape.num_lines = 1;
+    shape.label = NONE;
+    for (auto &i : shape.indices)
+      i = NONE;
+    shape.indices[1] = index_offset;
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.center_longitude = header.center_latitude = 0.1;
+    header.west = header.south = 0.09;
+    header.east = header.north = 0.11;
+    header.num_shapes = 1;
+    header.num_lines = 1;
+    header.num_points = 3;
+    header.num_indices = indices.size();
+    header.tile_columns = tile_offsets.size() - 1;
+    header.tile_rows = 1;
+    header.num_tile_entries = 1;
+
+    std::vector<uint8_t> file;
+    Append(file, &header, 1);
+    Append(file, &shape, 1);
+    Append(file, points, 3);
+    Append(file, lines, 1);
+    Append(file, indices.data(), indices.size());
+    Append(file, tile_offsets.data(), tile_offsets.size());
+    Append(file, entries, 1);
+
+    AllocatedArray<uint8_t> result(file.size());
+    std::copy(file.begin(), file.end(), result.begin());
+    return result;
+  }
+
+  bool Load() const {
+    Reader reader;
+    return reader.Load(Build());
+  }
+};
+
+static void
+TestValid()
+{
+  const FileBuilder builder;
+
+  Reader reader;
+  ok1(reader.Load(builder.Build()));
+  ok1(reader.IsDefined());
+  ok1(reader.GetNumShapes() == 1);
+
+  const Shape &shape = reader.GetShape(0);
+  ok1(reader.GetIndices(shape, 0) == nullptr);
+  ok1(reader.GetIndices(shape, 1) != nullptr);
+}
+
+static void
+TestTileOffsets()
+{
+  FileBuilder builder;
+
+  /* the last offset must match the number of entries */
+  builder.tile_offsets = {0, 1, 2};
+  ok1(!builder.Load());
+
+  /* intermediate offsets must not decrease or exceed the entries */
+  builder.tile_offsets = {0, 5, 1};
+  ok1(!builder.Load());
+
+  builder.tile_offsets = {1, 0, 1};
+  ok1(!builder.Load());
+}
+
+static void
+TestIndices()
+{
+  FileBuilder builder;
+
+  /* the index set starts beyond the index array */
+  builder.index_offset = 4;
+  ok1(!builder.Load());
+
+  /* the index run ends beyond the index array */
+  builder.index_offset = 0;
+  builder.indices = {200, 0, 1, 2};
+  ok1(!builder.Load());
+
+  /* a vertex index refers to a point of another shape */
+  builder.indices = {3, 0, 1, 9};
+  ok1(!builder.Load());
+}
+
+static void
+TestTruncated()
+{
+  const FileBuilder builder;
+  auto data = builder.Build();
+
+  AllocatedArray<uint8_t> truncated(data.size() - 8);
+  std::copy_n(data.begin(), truncated.size(), truncated.begin());
+
+  Reader reader;
+  ok1(!reader.Load(std::move(truncated)));
+  ok1(!reader.IsDefined());
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(5 + 3 + 3 + 2);
+
+  TestValid();
+  TestTileOffsets();
+  TestIndices();
+  TestTruncated();
+
+  return exit_status();
+}
@@ -0,0 +1,181 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thermal/HotspotDatabase.hpp"
+#include "Thermal/ClimbDetector.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "io/FileOutputStream.hxx"
+#include "util/PrintException.hxx"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+static DetectedClimb
+MakeClimb(double longitude, double latitude, double start_time,
+          double gain, double duration)
+{
+  DetectedClimb climb;
+  climb.location = GeoPoint(Angle::Degrees(longitude),
+                            Angle::Degrees(latitude));
+  climb.start_time = start_time;
+  climb.duration = duration;
+  climb.base_altitude = 800;
+  climb.top_altitude = 800 + gain;
+  return climb;
+}
+
+static GeoBounds
+MakeBounds(double west, double south, double east, double north)
+{
+  return GeoBounds(GeoPoint(Angle::Degrees(west), Angle::Degrees(north)),
+                   GeoPoint(Angle::Degrees(east), Angle::Degrees(south)));
+}
+
+static std::vector<HotspotRecord>
+Query(const HotspotDatabase &db, const GeoBounds &bounds,
+      int hour=-1, unsigned min_climbs=1)
+{
+  std::vector<HotspotRecord> result;
+  db.VisitWithin(bounds, hour, min_climbs, [&result](const HotspotRecord &r){
+    result.push_back(r);
+  });
+  return result;
+}
+
+static void
+TestEncoding()
+{
+  bool success = true;
+  for (unsigned x = 0; x < 65536; x += 257)
+    for (unsigned y = 0; y < 65536; y += 263) {
+      const uint32_t cell = HotspotDatabase::Encode(x, y);
+      if (HotspotDatabase::DecodeX(cell) != x ||
+          HotspotDatabase::DecodeY(cell) != y)
+        success = false;
+    }
+  ok1(success);
+
+  ok1(HotspotDatabase::Encode(1, 0) == 1);
+  ok1(HotspotDatabase::Encode(0, 1) == 2);
+  ok1(HotspotDatabase::Encode(0xffff, 0xffff) == 0xffffffff);
+
+  ok1(HotspotDatabase::LongitudeToX(-180) == 0);
+  ok1(HotspotDatabase::LongitudeToX(180) == 0xffff);
+  ok1(HotspotDatabase::LatitudeToY(0) == 0x8000);
+
+  ok1(HotspotDatabase::SolarHour(12 * 3600, 0) == 12);
+  ok1(HotspotDatabase::SolarHour(12 * 3600, 30) == 14);
+  ok1(HotspotDatabase::SolarHour(1800, -15) == 23);
+}
+
+static void
+TestDatabase(Path path)
+{
+  HotspotDatabaseBuilder a, b;
+  a.AddFlight();
+  a.Add(MakeClimb(7.5, 51.0, 12 * 3600, 600, 300));
+  a.Add(MakeClimb(10.0, 48.0, 13 * 3600, 1000, 500));
+
+  b.AddFlight();
+  b.AddFlight();
+  /* same cell and hour as the first climb */
+  b.Add(MakeClimb(7.5001, 51.0001, 12 * 3600 + 600, 400, 400));
+  /* same cell, different hour */
+  b.Add(MakeClimb(7.5, 51.0, 15 * 3600, 300, 300));
+  b.Add(MakeClimb(-100.0, 40.0, 20 * 3600, 500, 250));
+
+  a.Merge(b);
+  ok1(a.GetFlightCount() == 3);
+  ok1(a.GetClimbCount() == 5);
+  ok1(a.GetRecordCount() == 4);
+
+  a.Save(path);
+
+  const auto db = HotspotDatabase::Open(path);
+  ok1(db != nullptr);
+  if (db == nullptr) {
+    skip(10, 0, "Open() failed");
+    return;
+  }
+
+  ok1(db->GetFlightCount() == 3);
+  ok1(db->GetClimbCount() == 5);
+  ok1(db->GetRecordCount() == 4);
+
+  const auto germany = MakeBounds(7, 50.5, 8, 51.5);
+  ok1(Query(*db, germany).size() == 2);
+
+  auto result = Query(*db, germany, 12);
+  ok1(result.size() == 1 && result.front().n_climbs == 2 &&
+      equals(result.front().climb_rate, 1.5) &&
+      result.front().base_altitude == 800 &&
+      result.front().top_altitude == 1300 &&
+      result.front().GetLocation().Distance(GeoPoint(Angle::Degrees(7.5),
+                                                     Angle::Degrees(51.0))) < 20);
+
+  ok1(Query(*db, germany, -1, 2).size() == 1);
+  ok1(Query(*db, germany, 3).empty());
+  ok1(Query(*db, MakeBounds(9.9, 47.9, 10.1, 48.1)).size() == 1);
+  ok1(Query(*db, MakeBounds(-180, -90, 180, 90)).size() == 4);
+  ok1(Query(*db, MakeBounds(20, 20, 30, 30)).empty());
+}
+
+static void
+TestErrors(Path path)
+{
+  File::Delete(path);
+  ok1(HotspotDatabase::Open(path) == nullptr);
+
+  {
+    FileOutputStream file(path);
+    file.Write("XCSHOTSPgarbage", 15);
+    file.Commit();
+  }
+
+  bool thrown = false;
+  try {
+    HotspotDatabase::Open(path);
+  } catch (...) {
+    thrown = true;
+  }
+  ok1(thrown);
+}
+
+int main(int argc, char **argv)
+try {
+  plan_tests(26);
+
+  Directory::Create(Path(_T("output/test")));
+  const Path path(_T("output/test/hotspots.dat"));
+
+  TestEncoding();
+  TestDatabase(path);
+  TestErrors(path);
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,105 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Computer/IdleScheduler.hpp"
+#include "TestUtil.hpp"
+
+#include <string>
+#include <thread>
+
+using namespace std::chrono;
+
+static void
+TestSchedule()
+{
+  IdleScheduler scheduler;
+  std::string order;
+
+  scheduler.Add("a", seconds(1), seconds(2), milliseconds(10),
+                [&order](bool){ order.push_back('a'); });
+  scheduler.Add("b", seconds(1), seconds(5), milliseconds(100),
+                [&order](bool){ order.push_back('b'); });
+
+  const IdleScheduler::Clock::time_point t0(seconds(100));
+
+  /* new jobs are overdue: they run even without spare time, earliest
+     deadline first */
+  ok1(scheduler.Run(t0, IdleScheduler::Duration::zero()) == 2);
+  ok1(order == "ab");
+
+  /* not due yet */
+  order.clear();
+  ok1(scheduler.Run(t0 + milliseconds(500), seconds(1)) == 0);
+  ok1(order.empty());
+
+  /* both due, but only "a" fits */
+  ok1(scheduler.Run(t0 + seconds(1), milliseconds(50)) == 1);
+  ok1(order == "a");
+
+  /* both past their deadline */
+  order.clear();
+  ok1(scheduler.Run(t0 + seconds(5), IdleScheduler::Duration::zero()) == 2);
+  ok1(order == "ab");
+
+  unsigned runs = 0, late = 0;
+  scheduler.VisitStats([&runs, &late](const char *,
+                                      const IdleScheduler::Stats &stats){
+    runs += stats.runs;
+    late += stats.late;
+  });
+
+  ok1(runs == 5);
+  ok1(late == 2);
+  ok1(scheduler.GetOverruns() == 0);
+}
+
+static void
+TestRunAll()
+{
+  IdleScheduler scheduler;
+  bool exhaustive = false;
+
+  scheduler.Add("slow", seconds(1), seconds(1), IdleScheduler::Duration::zero(),
+                [&exhaustive](bool _exhaustive){
+    exhaustive = _exhaustive;
+    std::this_thread::sleep_for(milliseconds(1));
+  });
+
+  scheduler.RunAll(true);
+  ok1(exhaustive);
+  ok1(scheduler.GetOverruns() == 1);
+
+  scheduler.RunAll();
+  ok1(!exhaustive);
+  ok1(scheduler.GetOverruns() == 2);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(15);
+
+  TestSchedule();
+  TestRunAll();
+
+  return exit_status();
+}
@@ -0,0 +1,146 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "time/Instrument.hpp"
+#include "TestUtil.hpp"
+
+#include <thread>
+
+using namespace Instrument;
+
+static void
+TestBuckets()
+{
+  ok1(GetBucket(0) == 0);
+  ok1(GetBucket(999) == 0);
+  ok1(GetBucket(1000) == 1);
+  ok1(GetBucket(1999) == 1);
+  ok1(GetBucket(2000) == 2);
+  ok1(GetBucket(3000000) == 12);
+  ok1(GetBucket(~Stamp(0)) == N_BUCKETS - 1);
+}
+
+static void
+TestDisabled()
+{
+  ok1(!IsEnabled());
+
+  Count(Probe::TERRAIN_UNCHANGED);
+
+  {
+    const ScopedTimer timer(Probe::DRAW_FRAME);
+  }
+
+  const auto report = Collect();
+  ok1(report[unsigned(Probe::TERRAIN_UNCHANGED)].count == 0);
+  ok1(report[unsigned(Probe::DRAW_FRAME)].count == 0);
+}
+
+static void
+TestRecord()
+{
+  Enable();
+  ok1(IsEnabled());
+
+  Record(Probe::GLIDE_GPS, 500);
+  Record(Probe::GLIDE_GPS, 3000000);
+  Count(Probe::TERRAIN_UNCHANGED, 3);
+
+  {
+    const ScopedTimer timer(Probe::DRAW_FRAME);
+  }
+
+  const auto report = Collect();
+  const Summary &gps = report[unsigned(Probe::GLIDE_GPS)];
+  ok1(gps.count == 2);
+  ok1(gps.total == 3000500);
+  ok1(gps.max == 3000000);
+  ok1(gps.GetMean() == 1500250);
+  ok1(gps.buckets[0] == 1);
+  ok1(gps.buckets[12] == 1);
+
+  /* the upper bound of the bucket, but not more than the maximum */
+  ok1(gps.GetPercentile(0.4) == 1000);
+  ok1(gps.GetPercentile(0.9) == 3000000);
+
+  ok1(report[unsigned(Probe::TERRAIN_UNCHANGED)].count == 3);
+  ok1(IsCounter(Probe::TERRAIN_UNCHANGED));
+  ok1(!IsCounter(Probe::GLIDE_GPS));
+
+  ok1(report[unsigned(Probe::DRAW_FRAME)].count == 1);
+
+  /* only probes with samples are listed */
+  const std::string text = FormatReport(report);
+  ok1(text.find(GetProbeName(Probe::GLIDE_GPS)) != text.npos);
+  ok1(text.find(GetProbeName(Probe::ROUTE_SOLVE)) == text.npos);
+}
+
+static void
+TestThreads()
+{
+  /* the samples of exited threads are kept */
+  auto writer = []{
+    for (unsigned i = 0; i < 1000; ++i)
+      Record(Probe::ROUTE_REACH, 2000);
+  };
+
+  std::thread a(writer), b(writer);
+  a.join();
+  b.join();
+
+  const auto report = Collect();
+  const Summary &reach = report[unsigned(Probe::ROUTE_REACH)];
+  ok1(reach.count == 2000);
+  ok1(reach.total == 4000000);
+  ok1(reach.buckets[2] == 2000);
+}
+
+static void
+TestReset()
+{
+  Reset();
+
+  auto report = Collect();
+  ok1(report[unsigned(Probe::GLIDE_GPS)].count == 0);
+  ok1(report[unsigned(Probe::ROUTE_REACH)].count == 0);
+
+  Record(Probe::GLIDE_GPS, 100);
+
+  report = Collect();
+  ok1(report[unsigned(Probe::GLIDE_GPS)].count == 1);
+  ok1(report[unsigned(Probe::GLIDE_GPS)].max == 100);
+  ok1(report[unsigned(Probe::TERRAIN_UNCHANGED)].count == 0);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(7 + 3 + 15 + 3 + 5);
+
+  TestBuckets();
+  TestDisabled();
+  TestRecord();
+  TestThreads();
+  TestReset();
+
+  return exit_status();
+}
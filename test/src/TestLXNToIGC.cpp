@@ -25,8 +25,11 @@
 #include "io/BufferedOutputStream.hxx"
 #include "io/FileOutputStream.hxx"
 #include "util/PrintException.hxx"
+#include "util/Macros.hpp"
 #include "TestUtil.hpp"
 
+#include <algorithm>
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -37,8 +40,27 @@ static const char *lxn_path = "test/data/lxn_to_igc/18BF14K1.FIL";
 static const char *igc_in_path = "test/data/lxn_to_igc/18BF14K1.igc";
 static const char *igc_out_path = "output/18BF14K1.igc";
 
+/**
+ * Convert the whole file at once, or in chunks of the given size (to
+ * test reassembling packets which are split between two chunks).
+ */
+static bool
+Convert(const uint8_t *data, size_t size, size_t chunk_size,
+        BufferedOutputStream &os)
+{
+  if (chunk_size == 0)
+    return LX::ConvertLXNToIGC(data, size, os);
+
+  LX::LXNToIGCConverter converter(os);
+  for (size_t i = 0; i < size; i += chunk_size)
+    if (!converter.Feed(data + i, std::min(chunk_size, size - i)))
+      return false;
+
+  return converter.Finish();
+}
+
 static bool
-RunConversion()
+RunConversion(size_t chunk_size)
 {
   FILE *lxn_file = fopen(lxn_path, "rb");
   if (lxn_file == NULL) {
@@ -67,7 +89,8 @@ RunConversion()
     return false;
   }
 
-  bool success = ok1(LX::ConvertLXNToIGC(data, n, igc_bos));
+  bool success = ok(Convert((const uint8_t *)data, n, chunk_size, igc_bos),
+                    "conversion, chunk size %u", unsigned(chunk_size));
   free(data);
 
   igc_bos.Flush();
@@ -140,12 +163,16 @@ CompareFiles()
 
 int main(int argc, char **argv)
 try {
-  plan_tests(2);
+  static constexpr size_t chunk_sizes[] = { 0, 1, 7, 100, 4096 };
 
-  if (!RunConversion())
-    skip(1, 0, "conversion failed");
+  plan_tests(2 * ARRAY_SIZE(chunk_sizes));
 
-  ok1(CompareFiles());
+  for (const size_t chunk_size : chunk_sizes) {
+    if (!RunConversion(chunk_size))
+      skip(1, 0, "conversion failed");
+    else
+      ok(CompareFiles(), "compare, chunk size %u", unsigned(chunk_size));
+  }
 
   return exit_status();
 } catch (...) {
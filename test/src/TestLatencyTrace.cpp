@@ -0,0 +1,109 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "time/LatencyTrace.hpp"
+#include "TestUtil.hpp"
+
+#include <thread>
+
+using namespace LatencyTrace;
+
+static void
+TestStageNames()
+{
+  for (unsigned i = 0; i < unsigned(Stage::COUNT); ++i)
+    ok1(ParseStageName(GetStageName(Stage(i))) == Stage(i));
+
+  ok1(ParseStageName("foo") == Stage::COUNT);
+}
+
+static void
+TestDisabled()
+{
+  ok1(!IsEnabled());
+  ok1(Begin() == 0);
+
+  Record(Stage::MERGED, 1);
+  ok1(Collect().empty());
+}
+
+static void
+TestRing()
+{
+  Enable(8);
+  ok1(IsEnabled());
+  ok1(Begin() != 0);
+
+  /* samples without a time stamp are ignored */
+  Record(Stage::PARSED, 0);
+  ok1(Collect().empty());
+
+  Push(Stage::PARSED, 100, 150);
+  Push(Stage::MERGED, 100, 300);
+
+  auto events = Collect();
+  ok1(events.size() == 2);
+  ok1(events[0].stage == Stage::PARSED);
+  ok1(events[0].GetLatency() == 50);
+  ok1(events[1].stage == Stage::MERGED);
+  ok1(events[1].GetLatency() == 200);
+
+  /* overflow: only the most recent 8 events are kept */
+  for (unsigned i = 0; i < 20; ++i)
+    Push(Stage::DRAWN, i, i + 10);
+
+  events = Collect();
+  ok1(events.size() == 8);
+  ok1(events.front().origin == 12);
+  ok1(events.back().origin == 19);
+
+  /* concurrent writers */
+  auto writer = []{
+    for (unsigned i = 0; i < 10000; ++i)
+      Record(Stage::CALCULATED, 1);
+  };
+
+  std::thread a(writer), b(writer);
+  a.join();
+  b.join();
+
+  events = Collect();
+  ok1(events.size() == 8);
+
+  bool valid = true;
+  for (const auto &i : events)
+    if (i.stage != Stage::CALCULATED || i.origin != 1 || i.time < 1)
+      valid = false;
+  ok1(valid);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(unsigned(Stage::COUNT) + 17);
+
+  TestStageNames();
+  TestDisabled();
+  TestRing();
+
+  return exit_status();
+}
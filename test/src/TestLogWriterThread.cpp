@@ -0,0 +1,195 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/LogWriterThread.hpp"
+#include "io/OutputStream.hxx"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+#include "TestUtil.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <stdio.h>
+
+/**
+ * An #OutputStream which blocks until Open() is called.
+ */
+class GateOutputStream final : public OutputStream {
+  Mutex mutex;
+  Cond cond;
+  bool entered = false, open = false;
+
+public:
+  std::string data;
+
+  void WaitEntered() {
+    std::unique_lock<Mutex> lock(mutex);
+    cond.wait(lock, [this]{ return entered; });
+  }
+
+  void Open() {
+    const std::lock_guard<Mutex> lock(mutex);
+    open = true;
+    cond.notify_all();
+  }
+
+  void Write(const void *_data, size_t size) override {
+    {
+      std::unique_lock<Mutex> lock(mutex);
+      entered = true;
+      cond.notify_all();
+      cond.wait(lock, [this]{ return open; });
+    }
+
+    data.append((const char *)_data, size);
+  }
+};
+
+class FailingOutputStream final : public OutputStream {
+public:
+  void Write(const void *, size_t) override {
+    throw std::runtime_error("Injected failure");
+  }
+};
+
+static unsigned
+CountLines(const std::string &data)
+{
+  unsigned n = 0;
+  for (char ch : data)
+    if (ch == '\n')
+      ++n;
+  return n;
+}
+
+/**
+ * Stall the device while the producer submits lines, and verify that
+ * the producer doesn't wait for it.
+ */
+static void
+TestStall()
+{
+  static constexpr unsigned NUM_LINES = 20;
+
+  GateOutputStream os;
+  std::string expected;
+
+  {
+    LogWriterThread writer(os);
+
+    writer.Write("first");
+    writer.Flush();
+    os.WaitEntered();
+    expected.append("first\n");
+
+    /* the writer thread is now blocked inside the device; if Write()
+       or Flush() waited for it, this loop would never finish */
+    for (unsigned i = 0; i < NUM_LINES; ++i) {
+      char line[32];
+      snprintf(line, sizeof(line), "B%06u", i);
+      expected.append(line);
+      expected.push_back('\n');
+
+      writer.Write(line);
+      writer.Flush();
+    }
+
+    ok1(os.data.empty());
+    ok1(writer.GetDroppedCount() == 0);
+
+    os.Open();
+  }
+
+  ok1(os.data == expected);
+}
+
+/**
+ * Block the writer and overflow the queue.  TryWrite() must drop the
+ * excess lines, and Write() must wait for room instead of dropping
+ * them.
+ */
+static void
+TestOverflow()
+{
+  static constexpr unsigned EXCESS = 10;
+
+  GateOutputStream os;
+
+  {
+    LogWriterThread writer(os);
+
+    writer.Write("first");
+    writer.Flush();
+    os.WaitEntered();
+
+    unsigned accepted = 0;
+    for (unsigned i = 0; i < LogWriterThread::QUEUE_SIZE + EXCESS; ++i)
+      if (writer.TryWrite("line"))
+        ++accepted;
+
+    ok1(accepted == LogWriterThread::QUEUE_SIZE);
+    ok1(writer.GetDroppedCount() == EXCESS);
+
+    /* the queue is full; these calls return only after the device
+       has been opened */
+    std::thread opener([&os]{ os.Open(); });
+    for (unsigned i = 0; i < EXCESS; ++i)
+      writer.Write("line");
+    opener.join();
+
+    ok1(writer.GetDroppedCount() == EXCESS);
+  }
+
+  ok1(CountLines(os.data) == 1 + LogWriterThread::QUEUE_SIZE + EXCESS);
+}
+
+static void
+TestError()
+{
+  FailingOutputStream os;
+  LogWriterThread writer(os);
+
+  writer.Write("line");
+
+  bool thrown = false;
+  try {
+    writer.Sync();
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+
+  ok1(thrown);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(8);
+
+  TestStall();
+  TestOverflow();
+  TestError();
+
+  return exit_status();
+}
@@ -0,0 +1,291 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "lua/FieldIndex.hpp"
+#include "lua/Blackboard.hpp"
+#include "lua/Settings.hpp"
+#include "lua/Task.hpp"
+#include "lua/Instrument.hpp"
+#include "lua/Ptr.hpp"
+#include "Interface.hpp"
+#include "ActionInterface.hpp"
+#include "Components.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "time/Instrument.hpp"
+#include "TestUtil.hpp"
+
+extern "C" {
+#include <lua.h>
+#include <lualib.h>
+#include <lauxlib.h>
+}
+
+#include <memory>
+
+#include <stdio.h>
+
+/* the task manager is not needed because this test has no task;
+   these stubs only satisfy the linker */
+ProtectedTaskManager *protected_task_manager;
+
+WaypointPtr
+ProtectedTaskManager::GetActiveWaypoint() const
+{
+  return nullptr;
+}
+
+const OrderedTaskSettings
+ProtectedTaskManager::GetOrderedTaskSettings() const
+{
+  return OrderedTaskSettings();
+}
+
+static double set_mc = -1;
+
+void
+ActionInterface::SetMacCready(double mc, bool)
+{
+  set_mc = mc;
+}
+
+void
+ActionInterface::SetBugs(double, bool)
+{
+}
+
+void
+ActionInterface::SetBallast(double, bool)
+{
+}
+
+static bool
+Run(lua_State *L, const char *code)
+{
+  if (luaL_dostring(L, code) == 0)
+    return true;
+
+  fprintf(stderr, "%s\n", lua_tostring(L, -1));
+  lua_pop(L, 1);
+  return false;
+}
+
+static constexpr const char *test_field_names[] = {
+  "alpha", "bravo", "charlie",
+};
+
+static int
+l_lookup(lua_State *L)
+{
+  lua_pushinteger(L, Lua::LookupField(L, lua_upvalueindex(1), 1));
+  return 1;
+}
+
+static int
+l_snapshot(lua_State *L)
+{
+  /* omit "bravo" to check that unavailable fields are skipped */
+  Lua::PushFieldSnapshot(L, lua_upvalueindex(1), [L](int field){
+    if (field == 1)
+      return false;
+
+    lua_pushinteger(L, field * 10);
+    return true;
+  });
+  return 1;
+}
+
+static void
+TestFieldIndex(lua_State *L)
+{
+  Lua::PushFieldIndex(L, test_field_names);
+  const int index_idx = lua_gettop(L);
+
+  lua_pushstring(L, "charlie");
+  ok1(Lua::LookupField(L, index_idx, -1) == 2);
+  ok1(Lua::LookupField(L, -2, -1) == 2);
+  lua_pop(L, 1);
+
+  lua_pushstring(L, "delta");
+  ok1(Lua::LookupField(L, index_idx, -1) == -1);
+  lua_pop(L, 1);
+
+  /* non-string keys never match, not even the field number */
+  lua_pushinteger(L, 0);
+  ok1(Lua::LookupField(L, index_idx, -1) == -1);
+  lua_pop(L, 1);
+
+  ok1(lua_gettop(L) == index_idx);
+
+  /* the index as upvalue, shared by two closures */
+  lua_pushvalue(L, -1);
+  lua_pushcclosure(L, l_lookup, 1);
+  lua_setglobal(L, "lookup");
+  lua_pushcclosure(L, l_snapshot, 1);
+  lua_setglobal(L, "snapshot");
+
+  ok1(lua_gettop(L) == index_idx - 1);
+
+  ok1(Run(L, "assert(lookup('alpha') == 0)"
+          " assert(lookup('bravo') == 1)"
+          " assert(lookup('charlie') == 2)"
+          " assert(lookup('delta') == -1)"
+          " assert(lookup(1) == -1)"
+          " assert(lookup(nil) == -1)"));
+
+  ok1(Run(L, "local s = snapshot()"
+          " assert(s.alpha == 0 and s.bravo == nil and s.charlie == 20)"
+          " local n = 0 for _ in pairs(s) do n = n + 1 end"
+          " assert(n == 2)"
+          /* each call returns a new table */
+          " s.alpha = 5 assert(snapshot().alpha == 0)"));
+}
+
+static void
+TestBlackboard(lua_State *L)
+{
+  Lua::InitBlackboard(L);
+
+  auto basic = std::make_shared<MoreData>();
+  basic->Reset();
+  basic->clock = 100;
+  basic->location = GeoPoint(Angle::Degrees(7), Angle::Degrees(51));
+  basic->location_available.Update(basic->clock);
+  basic->ground_speed = 12.5;
+  basic->ground_speed_available.Update(basic->clock);
+  basic->track = Angle::Degrees(90);
+  basic->track_available.Update(basic->clock);
+  CommonInterface::ReadBlackboardBasic(basic);
+
+  ok1(Run(L, "local bb = xcsoar.blackboard"
+          " assert(bb.ground_speed == 12.5)"
+          " assert(near(bb.track, 90))"
+          " assert(near(bb.location.longitude, 7))"
+          " assert(near(bb.location.latitude, 51))"
+          " assert(bb.voltage == nil)"
+          " assert(bb.no_such_field == nil)"
+          " assert(bb[1] == nil)"));
+
+  ok1(Run(L, "local s = xcsoar.blackboard.snapshot()"
+          " assert(s.ground_speed == 12.5 and near(s.track, 90))"
+          " assert(near(s.location.latitude, 51))"
+          " assert(s.voltage == nil)"
+          " local n = 0 for _ in pairs(s) do n = n + 1 end"
+          " assert(n == 3)"));
+
+  /* a snapshot is a copy, the binding reads the current values */
+  auto basic2 = std::make_shared<MoreData>(*basic);
+  basic2->voltage = 12.8;
+  basic2->voltage_available.Update(basic2->clock);
+  basic2->ground_speed_available.Clear();
+  CommonInterface::ReadBlackboardBasic(basic2);
+
+  ok1(Run(L, "local bb = xcsoar.blackboard"
+          " assert(bb.voltage == 12.8)"
+          " assert(bb.ground_speed == nil)"
+          " local s = bb.snapshot()"
+          " assert(s.voltage == 12.8 and s.ground_speed == nil)"));
+}
+
+static void
+TestSettings(lua_State *L)
+{
+  Lua::InitSettings(L);
+
+  CommonInterface::SetComputerSettings().polar.bugs = 0.85;
+
+  ok1(Run(L, "assert(xcsoar.settings.bugs == 0.85)"
+          " assert(xcsoar.settings.no_such_field == nil)"
+          " xcsoar.settings.setmc(1.5)"));
+  ok1(set_mc == 1.5);
+}
+
+static void
+TestTask(lua_State *L)
+{
+  Lua::InitTask(L);
+
+  auto calculated = std::make_shared<DerivedInfo>();
+  calculated->Reset();
+  calculated->task_stats.task_valid = true;
+  calculated->task_stats.current_leg.vector_remaining =
+    GeoVector(5000, Angle::Degrees(45));
+  CommonInterface::ReadBlackboardCalculated(calculated);
+
+  ok1(Run(L, "assert(xcsoar.task.next_distance == 5000)"
+          " assert(near(xcsoar.task.bearing, 45))"
+          " assert(xcsoar.task.no_such_field == nil)"));
+
+  auto calculated2 = std::make_shared<DerivedInfo>(*calculated);
+  calculated2->task_stats.task_valid = false;
+  CommonInterface::ReadBlackboardCalculated(calculated2);
+
+  ok1(Run(L, "assert(xcsoar.task.next_distance == nil)"));
+}
+
+static void
+TestInstrument(lua_State *L)
+{
+  Lua::InitInstrument(L);
+
+  ok1(Run(L, "assert(xcsoar.instrument.enabled == false)"
+          " xcsoar.instrument.enable()"
+          " assert(xcsoar.instrument.enabled == true)"));
+  ok1(Instrument::IsEnabled());
+
+  Instrument::Record(Instrument::Probe::GLIDE_GPS, 2000000);
+
+  ok1(Run(L, "local r = xcsoar.instrument.report()"
+          " assert(type(r) == 'string' and r:find('glide.gps', 1, true))"
+          " xcsoar.instrument.reset()"));
+  ok1(Instrument::Collect()[unsigned(Instrument::Probe::GLIDE_GPS)].count == 0);
+
+  ok1(Run(L, "xcsoar.instrument.disable()"
+          " assert(xcsoar.instrument.enabled == false)"));
+  ok1(!Instrument::IsEnabled());
+}
+
+int
+main()
+{
+  plan_tests(21);
+
+  const Lua::StatePtr state(luaL_newstate());
+  lua_State *L = state.get();
+  luaL_openlibs(L);
+
+  lua_newtable(L);
+  lua_setglobal(L, "xcsoar");
+
+  /* angles are converted from radians, so compare with a tolerance */
+  Run(L, "function near(a, b) return math.abs(a - b) < 1e-6 end");
+
+  TestFieldIndex(L);
+  TestBlackboard(L);
+  TestSettings(L);
+  TestTask(L);
+  TestInstrument(L);
+
+  return exit_status();
+}
@@ -0,0 +1,147 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Geo/Flat/PackedRTree.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+#include <stdlib.h>
+
+struct Item : FlatBoundingBox {
+  unsigned id;
+
+  Item(FlatGeoPoint ll, FlatGeoPoint ur, unsigned _id)
+    :FlatBoundingBox(ll, ur), id(_id) {}
+};
+
+typedef PackedRTree<Item> Tree;
+
+static std::vector<Item>
+MakeItems(unsigned n)
+{
+  std::vector<Item> items;
+  for (unsigned i = 0; i < n; ++i) {
+    const FlatGeoPoint ll(rand() % 10000 - 5000, rand() % 10000 - 5000);
+    const FlatGeoPoint size(rand() % 500, rand() % 500);
+    items.emplace_back(ll, ll + size, i);
+  }
+
+  return items;
+}
+
+static std::vector<unsigned>
+Collect(Tree::const_query_iterator begin, Tree::const_query_iterator end)
+{
+  std::vector<unsigned> result;
+  for (; begin != end; ++begin)
+    result.push_back(begin->id);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+static bool
+OddFilter(const Item &item, const void *ctx)
+{
+  return item.id % 2 == *(const unsigned *)ctx;
+}
+
+/**
+ * Compare the results of random queries with a linear search.
+ */
+static bool
+TestQueries(unsigned n)
+{
+  const std::vector<Item> items = MakeItems(n);
+
+  Tree tree;
+  tree.Build(std::vector<Item>(items));
+  if (tree.size() != n)
+    return false;
+
+  if (n > 0) {
+    const Tree::Query all(tree.GetBounds());
+    if (Collect(tree.qbegin(all), tree.qend()).size() != n)
+      return false;
+  }
+
+  const unsigned one = 1;
+
+  for (unsigned i = 0; i < 100; ++i) {
+    const FlatGeoPoint a(rand() % 12000 - 6000, rand() % 12000 - 6000);
+    const FlatGeoPoint b(rand() % 12000 - 6000, rand() % 12000 - 6000);
+    const FlatBoundingBox box(a, rand() % 2000);
+
+    std::vector<unsigned> expected_box, expected_ray, expected_filter;
+    for (const auto &item : items) {
+      if (item.Overlaps(box)) {
+        expected_box.push_back(item.id);
+        if (item.id % 2 == one)
+          expected_filter.push_back(item.id);
+      }
+
+      if (item.Intersects(FlatRay(a, b)))
+        expected_ray.push_back(item.id);
+    }
+
+    std::sort(expected_box.begin(), expected_box.end());
+    std::sort(expected_ray.begin(), expected_ray.end());
+    std::sort(expected_filter.begin(), expected_filter.end());
+
+    if (Collect(tree.qbegin(Tree::Query(box)), tree.qend()) != expected_box)
+      return false;
+
+    if (Collect(tree.qbegin(Tree::Query(a, b)), tree.qend()) != expected_ray)
+      return false;
+
+    Tree::Query filtered(box);
+    filtered.SetFilter(OddFilter, &one);
+    if (Collect(tree.qbegin(filtered), tree.qend()) != expected_filter)
+      return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(8);
+
+  Tree tree;
+  ok1(tree.empty());
+  ok1(tree.qbegin(Tree::Query(FlatBoundingBox(FlatGeoPoint(0, 0), 1000))) ==
+      tree.qend());
+
+  ok1(TestQueries(0));
+  ok1(TestQueries(1));
+  ok1(TestQueries(Tree::NODE_SIZE));
+  ok1(TestQueries(Tree::NODE_SIZE + 1));
+  ok1(TestQueries(1000));
+
+  /* rebuilding replaces the old contents */
+  tree.Build(MakeItems(100));
+  tree.Build(MakeItems(3));
+  ok1(tree.size() == 3);
+
+  return exit_status();
+}
@@ -0,0 +1,195 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Verify that deferred rendering into row bands (#RenderQueue) gives
+ * the same pixels as immediate rendering, with different numbers of
+ * threads.
+ */
+
+#include "ui/canvas/VirtualCanvas.hpp"
+#include "ui/canvas/memory/RenderQueue.hpp"
+#include "ui/canvas/Font.hpp"
+#include "Look/FontDescription.hpp"
+#include "Screen/Init.hpp"
+#include "TestUtil.hpp"
+
+#include <random>
+#include <vector>
+
+#include <string.h>
+#include <tchar.h>
+
+static constexpr PixelSize SIZE{640, 480};
+
+/* including an uneven split and more bands than CPU cores */
+static constexpr unsigned thread_counts[] = { 1, 2, 3, 7, 3 };
+
+class TestCanvas final : public VirtualCanvas {
+public:
+  using VirtualCanvas::VirtualCanvas;
+
+  [[gnu::pure]]
+  bool operator==(const TestCanvas &other) const noexcept {
+    for (unsigned y = 0; y < buffer.height; ++y)
+      if (memcmp(buffer.At(0, y), other.buffer.At(0, y),
+                 buffer.width * sizeof(*buffer.data)) != 0)
+        return false;
+
+    return true;
+  }
+};
+
+static Color
+RandomColor(std::minstd_rand &r, uint8_t alpha=Color::OPAQUE)
+{
+  return Color(r() & 0xff, r() & 0xff, r() & 0xff, alpha);
+}
+
+/**
+ * A random point; with a margin, it may be outside of the canvas.
+ */
+static BulkPixelPoint
+RandomPoint(std::minstd_rand &r, int margin)
+{
+  return BulkPixelPoint(int(r() % (SIZE.cx + 2 * margin)) - margin,
+                        int(r() % (SIZE.cy + 2 * margin)) - margin);
+}
+
+static std::vector<BulkPixelPoint>
+RandomPoints(std::minstd_rand &r, unsigned n, int margin)
+{
+  std::vector<BulkPixelPoint> points;
+  for (unsigned i = 0; i < n; ++i)
+    points.push_back(RandomPoint(r, margin));
+  return points;
+}
+
+/**
+ * Draw the same pseudo-random scene each time.  It is interrupted by
+ * text, which flushes the queue, and each part between two flushes
+ * covers enough area to be rasterised in parallel.
+ */
+static void
+Paint(Canvas &canvas, const Font *font)
+{
+  std::minstd_rand r(42);
+
+  canvas.Clear(Color(0xf0, 0xf0, 0xe0));
+
+  for (unsigned part = 0; part < 4; ++part) {
+    /* translucent polygons, partly outside of the canvas, one of
+       them translated */
+    canvas.SelectNullPen();
+    for (unsigned i = 0; i < 4; ++i) {
+      const auto points = RandomPoints(r, 5 + r() % 20, 200);
+      canvas.Select(Brush(RandomColor(r, 0x60)));
+      if (i == 0)
+        canvas.DrawPolygon(points.data(), points.size(),
+                           PixelPoint(int(r() % 41) - 20,
+                                      int(r() % 41) - 20));
+      else
+        canvas.DrawPolygon(points.data(), points.size());
+    }
+
+    /* opaque polygons with an outline */
+    for (unsigned i = 0; i < 8; ++i) {
+      const auto points = RandomPoints(r, 3 + r() % 8, 50);
+      canvas.Select(Pen(1 + r() % 3, RandomColor(r)));
+      canvas.Select(Brush(RandomColor(r)));
+      canvas.DrawPolygon(points.data(), points.size());
+    }
+
+    /* thick, dashed and clipped lines */
+    for (unsigned i = 0; i < 30; ++i) {
+      static constexpr Pen::Style styles[] = {
+        Pen::SOLID, Pen::DASH1, Pen::DASH2, Pen::DASH3,
+      };
+
+      canvas.Select(Pen(styles[i % 4], 1 + r() % 8, RandomColor(r)));
+
+      if (i % 3 == 0) {
+        const auto a = RandomPoint(r, 2000), b = RandomPoint(r, 2000);
+        canvas.DrawLine(a.x, a.y, b.x, b.y);
+      } else {
+        const auto points = RandomPoints(r, 2 + r() % 10, 100);
+        canvas.DrawPolyline(points.data(), points.size());
+      }
+    }
+
+    /* circles */
+    canvas.Select(Pen(2, COLOR_BLACK));
+    for (unsigned i = 0; i < 20; ++i) {
+      const auto center = RandomPoint(r, 20);
+      canvas.Select(Brush(RandomColor(r, i % 2 == 0 ? 0x80 : 0xff)));
+      canvas.DrawCircle(center.x, center.y, 2 + r() % 60);
+    }
+
+    canvas.DrawFilledRectangle(int(r() % SIZE.cx), int(r() % SIZE.cy),
+                               int(r() % SIZE.cx), int(r() % SIZE.cy),
+                               RandomColor(r));
+
+    /* text cannot be deferred; it flushes the queue */
+    if (font != nullptr) {
+      canvas.Select(*font);
+      canvas.SetTextColor(RandomColor(r));
+      canvas.SetBackgroundTransparent();
+      const auto p = RandomPoint(r, 0);
+      canvas.DrawText(p.x, p.y, _T("Flush"));
+    } else
+      canvas.FlushDeferred();
+  }
+}
+
+int
+main()
+{
+  ScreenGlobalInit screen_init;
+
+  Font font;
+  const bool have_font = font.Load(FontDescription(16));
+
+  plan_tests(std::size(thread_counts));
+
+  TestCanvas immediate(SIZE);
+  Paint(immediate, have_font ? &font : nullptr);
+
+  /* one queue for all passes: its threads are reused */
+  RenderQueue queue;
+
+  for (const unsigned n : thread_counts) {
+    queue.SetThreadCount(n);
+
+    TestCanvas deferred(SIZE);
+    deferred.BeginDeferred(queue);
+    Paint(deferred, have_font ? &font : nullptr);
+    deferred.EndDeferred();
+
+    ok(deferred == immediate, "%u threads%s", n,
+       have_font ? "" : " (no font)");
+  }
+
+  font.Destroy();
+
+  return exit_status();
+}
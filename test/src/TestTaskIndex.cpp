@@ -0,0 +1,142 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Task/TaskIndex.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "io/FileOutputStream.hxx"
+#include "util/PrintException.hxx"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+static bool
+HasName(const TaskIndex::Entry &entry, unsigned i, const TCHAR *name)
+{
+  if (i >= entry.names.size())
+    return false;
+
+  const auto &n = entry.names[i];
+  return name == nullptr
+    ? !n
+    : n && StringIsEqual(n->c_str(), name);
+}
+
+static void
+TestRoundTrip(Path path)
+{
+  File::Delete(path);
+
+  {
+    TaskIndex index;
+    index.Load(path);
+    ok1(index.size() == 0);
+
+    const Path a(_T("/data/a.cup")), b(_T("/data/b.tsk"));
+    ok1(index.Lookup(a, 100, 200) == nullptr);
+
+    std::vector<std::optional<tstring>> names;
+    names.emplace_back(std::nullopt);
+    names.emplace_back(_T("Day 2: 312 km"));
+    index.Put(a, 100, 200, std::move(names));
+
+    names.clear();
+    names.emplace_back(_T("Task"));
+    index.Put(b, 5, 6, std::move(names));
+
+    index.Save(path);
+  }
+
+  {
+    TaskIndex index;
+    index.Load(path);
+    ok1(index.size() == 2);
+
+    /* modified files are not found */
+    ok1(index.Lookup(Path(_T("/data/a.cup")), 101, 200) == nullptr);
+    ok1(index.Lookup(Path(_T("/data/a.cup")), 100, 201) == nullptr);
+
+    const auto *entry = index.Lookup(Path(_T("/data/a.cup")), 100, 200);
+    ok1(entry != nullptr);
+    ok1(entry != nullptr && entry->names.size() == 2);
+    ok1(entry != nullptr && HasName(*entry, 0, nullptr));
+    ok1(entry != nullptr && HasName(*entry, 1, _T("Day 2: 312 km")));
+
+    /* without purging, the unused entry is kept */
+    index.Save(path, false);
+  }
+
+  {
+    TaskIndex index;
+    index.Load(path);
+    ok1(index.size() == 2);
+
+    const auto *entry = index.Lookup(Path(_T("/data/b.tsk")), 5, 6);
+    ok1(entry != nullptr && HasName(*entry, 0, _T("Task")));
+
+    /* "a.cup" was not used, it gets purged */
+    index.Save(path);
+  }
+
+  {
+    TaskIndex index;
+    index.Load(path);
+    ok1(index.size() == 1);
+    ok1(index.Lookup(Path(_T("/data/a.cup")), 100, 200) == nullptr);
+  }
+}
+
+static void
+TestMalformed(Path path)
+{
+  {
+    static constexpr char data[] =
+      "XCSoar task index 1\n"
+      "5 6 2 /data/b.tsk\n"
+      "+Task\n";
+
+    FileOutputStream file(path);
+    file.Write(data, sizeof(data) - 1);
+    file.Commit();
+  }
+
+  /* the second name is missing */
+  TaskIndex index;
+  index.Load(path);
+  ok1(index.size() == 0);
+}
+
+int main(int argc, char **argv)
+try {
+  plan_tests(14);
+
+  Directory::Create(Path(_T("output/test")));
+  const Path path(_T("output/test/tasks.idx"));
+
+  TestRoundTrip(path);
+  TestMalformed(path);
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,164 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FLARM/List.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * The prediction uses a flat projection; allow a small error.
+ */
+static bool
+NearlyEquals(double a, double b)
+{
+  return fabs(a - b) < b * 0.005;
+}
+
+static FlarmId
+MakeId(unsigned i)
+{
+  char buffer[16];
+  sprintf(buffer, "%06X", 0xDD0000 + i);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static bool
+CheckAll(const TrafficList &list)
+{
+  for (const auto &traffic : list.list)
+    if (list.FindTraffic(traffic.id) != &traffic)
+      return false;
+
+  return true;
+}
+
+static void
+TestIndex()
+{
+  TrafficList list;
+  list.Clear();
+
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; ++i) {
+    FlarmTraffic *traffic = list.AllocateTraffic(MakeId(i));
+    if (traffic == nullptr)
+      break;
+
+    traffic->valid.Update(1 + i % 2);
+  }
+
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(list.AllocateTraffic(MakeId(TrafficList::MAX_COUNT)) == nullptr);
+  ok1(CheckAll(list));
+  ok1(list.FindTraffic(MakeId(TrafficList::MAX_COUNT)) == nullptr);
+  ok1(list.FindTraffic(MakeId(7)) != nullptr &&
+      list.FindTraffic(MakeId(7))->id == MakeId(7));
+
+  /* the targets updated at 1s expire, the others stay */
+  list.Expire(3.5);
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT / 2);
+  ok1(CheckAll(list));
+  ok1(list.FindTraffic(MakeId(6)) == nullptr);
+  ok1(list.FindTraffic(MakeId(7)) != nullptr);
+
+  /* a copy has a valid index, too */
+  TrafficList other;
+  other.Clear();
+  FlarmTraffic *traffic = other.AllocateTraffic(MakeId(6));
+  traffic->valid.Update(3);
+  traffic = other.AllocateTraffic(MakeId(7));
+  traffic->valid.Update(3);
+
+  TrafficList copy = list;
+  copy.Complement(other);
+  ok1(copy.GetActiveTrafficCount() == TrafficList::MAX_COUNT / 2 + 1);
+  ok1(CheckAll(copy));
+  ok1(copy.FindTraffic(MakeId(6)) != nullptr);
+
+  list.Clear();
+  ok1(list.IsEmpty());
+  ok1(list.FindTraffic(MakeId(7)) == nullptr);
+}
+
+static void
+TestPrediction()
+{
+  FlarmTraffic traffic;
+  traffic.Clear();
+  traffic.location_available = true;
+  traffic.location = GeoPoint(Angle::Degrees(7.7), Angle::Degrees(51.4));
+  traffic.valid.Update(10);
+  traffic.speed = 20;
+  traffic.track = Angle::Degrees(90);
+  traffic.turn_rate = 0;
+  traffic.track_received = traffic.speed_received =
+    traffic.turn_rate_received = true;
+
+  /* no extrapolation into the past */
+  ok1(traffic.GetPredictedLocation(9) == traffic.location);
+
+  /* straight flight */
+  GeoVector v =
+    traffic.location.DistanceBearing(traffic.GetPredictedLocation(12));
+  ok1(NearlyEquals(v.distance, 40));
+  ok1(fabs(v.bearing.Degrees() - 90) < 0.1);
+
+  /* limited to a few seconds */
+  v = traffic.location.DistanceBearing(traffic.GetPredictedLocation(100));
+  ok1(NearlyEquals(v.distance, 100));
+
+  /* circling: 18 degrees per second for 5 seconds is a quarter
+     circle; the chord points to the middle of the turn */
+  traffic.turn_rate = 18;
+  v = traffic.location.DistanceBearing(traffic.GetPredictedLocation(15));
+  const double radius = 100 / (M_PI / 2);
+  ok1(NearlyEquals(v.distance, radius * M_SQRT2));
+  ok1(fabs(v.bearing.Degrees() - 135) < 0.1);
+
+  /* a turn rate calculated by FlarmComputer is ignored */
+  traffic.turn_rate_received = false;
+  v = traffic.location.DistanceBearing(traffic.GetPredictedLocation(12));
+  ok1(NearlyEquals(v.distance, 40));
+  ok1(fabs(v.bearing.Degrees() - 90) < 0.1);
+
+  /* no prediction from a calculated track */
+  traffic.track_received = false;
+  ok1(traffic.GetPredictedLocation(12) == traffic.location);
+  traffic.track_received = true;
+
+  /* a target standing still */
+  traffic.speed = 0;
+  ok1(traffic.GetPredictedLocation(12) == traffic.location);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(24);
+
+  TestIndex();
+  TestPrediction();
+
+  return exit_status();
+}
@@ -22,6 +22,7 @@
 
 #include "Waypoint/WaypointReader.hpp"
 #include "Waypoint/WaypointReaderBase.hpp"
+#include "Waypoint/WaypointReaderSeeYou.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Units/System.hpp"
@@ -31,6 +32,7 @@
 #include "util/StringAPI.hxx"
 #include "util/ExtractParameters.hpp"
 #include "Operation/Operation.hpp"
+#include "io/LineReader.hpp"
 
 #include <vector>
 
@@ -440,6 +442,73 @@ TestCompeGPS_UTM(wp_vector org_wp)
   }
 }
 
+/**
+ * Generates a large SeeYou file with numbered waypoints, followed by
+ * a task section with lines which look like waypoints.
+ */
+class GeneratedSeeYouReader final : public TLineReader {
+  const unsigned n;
+  unsigned i = 0;
+
+  TCHAR buffer[256];
+
+public:
+  explicit GeneratedSeeYouReader(unsigned _n):n(_n) {}
+
+  /* virtual methods from class TLineReader */
+  TCHAR *ReadLine() override {
+    const unsigned current = i++;
+
+    if (current == 0)
+      _tcscpy(buffer, _T("name,code,country,lat,lon,elev,style,rwdir,rwlen,freq,desc"));
+    else if (current <= n)
+      _stprintf(buffer, _T("\"WP%05u\",,,%02u%02u.000N,%03u%02u.000E,%um,1,,,,"),
+                current - 1, 40 + current % 10, current / 10 % 60,
+                current % 180, current / 7 % 60, current % 3000);
+    else if (current == n + 1)
+      _tcscpy(buffer, _T("-----Related Tasks-----"));
+    else if (current < 2 * n)
+      /* must be ignored */
+      _stprintf(buffer, _T("\"After%05u\",,,4700.000N,00800.000E,500m,1,,,,"),
+                current);
+    else
+      return nullptr;
+
+    return buffer;
+  }
+};
+
+static void
+TestParallel(unsigned max_threads)
+{
+  static constexpr unsigned n = 20000;
+
+  GeneratedSeeYouReader line_reader(n);
+  WaypointReaderSeeYou reader(WaypointFactory(WaypointOrigin::NONE));
+  reader.SetMaxThreads(max_threads);
+
+  Waypoints way_points;
+  NullOperationEnvironment operation;
+  reader.Parse(way_points, line_reader, operation);
+  way_points.Optimise();
+
+  ok1(way_points.size() == n);
+
+  /* the waypoints are numbered in file order, regardless of the
+     thread which has parsed them */
+  auto wp = way_points.LookupName(_T("WP00000"));
+  ok1(wp != nullptr && wp->id == 1);
+
+  wp = way_points.LookupName(_T("WP19999"));
+  ok1(wp != nullptr && wp->id == n);
+
+  wp = way_points.LookupId(12345);
+  ok1(wp != nullptr && wp->name == _T("WP12344"));
+
+  ok1(way_points.LookupName(_T("After20002")) == nullptr);
+  ok1(way_points.LookupName(_T("After39999")) == nullptr);
+}
+
 static wp_vector
 CreateOriginalWaypoints()
 {
@@ -537,7 +606,7 @@ int main(int argc, char **argv)
 {
   wp_vector org_wp = CreateOriginalWaypoints();
 
-  plan_tests(360);
+  plan_tests(372);
 
   TestExtractParameters();
 
@@ -550,5 +619,8 @@ int main(int argc, char **argv)
   TestCompeGPS(org_wp);
   TestCompeGPS_UTM(org_wp);
 
+  TestParallel(1);
+  TestParallel(4);
+
   return exit_status();
 }
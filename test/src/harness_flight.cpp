@@ -34,6 +34,7 @@
 #include "system/FileUtil.hpp"
 #include "test_debug.hpp"
 
+#include <chrono>
 #include <fstream>
 
 double
@@ -208,7 +209,14 @@ run_flight(TestFlightComponents components, TaskManager &task_manager,
       const AircraftState state = aircraft.GetState();
       const AircraftState state_last = aircraft.GetLastState();
       task_manager.Update(state, state_last);
+
+      const auto idle_start = std::chrono::steady_clock::now();
       task_manager.UpdateIdle(state);
+      const std::chrono::duration<double> idle_duration =
+        std::chrono::steady_clock::now() - idle_start;
+      result.idle_time += idle_duration.count();
+      ++result.idle_count;
+
       task_manager.UpdateAutoMC(state, 0);
     }
 
@@ -47,10 +47,16 @@ struct TestFlightResult
   double calc_cruise_efficiency;
   double calc_effective_mc;
 
+  /** wall clock time spent in TaskManager::UpdateIdle() (s) */
+  double idle_time;
+  /** number of TaskManager::UpdateIdle() calls */
+  unsigned idle_count;
+
   TestFlightResult()
     :result(false),
      time_elapsed(0.0), time_planned(1.0), time_remaining(0.0),
-     calc_cruise_efficiency(1.0), calc_effective_mc(1.0) {}
+     calc_cruise_efficiency(1.0), calc_effective_mc(1.0),
+     idle_time(0.0), idle_count(0) {}
 
   operator bool() {
     return result;
@@ -44,6 +44,10 @@ test_aat(int test_num, int n_wind)
   if (!fine || verbose)
     printf("# time ratio error (elapsed/target) %g\n", t_ratio);
 
+  if (timing && result.idle_count > 0)
+    printf("# solver time %.1f us/tick (%u ticks)\n",
+           result.idle_time * 1e6 / result.idle_count, result.idle_count);
+
   return fine;
 }
 
@@ -34,6 +34,7 @@
 int n_samples = 0;
 int interactive = 0;
 int output_skip = 5;
+int timing = 0;
 
 AutopilotParameters autopilot_parms;
 
@@ -103,12 +104,13 @@ ParseArgs(int argc, char** argv)
 	{"task", required_argument,       0, 'x'},
 	{"waypoints", required_argument,       0, 'w'},
 	{"rangethreshold", required_argument,       0, 'd'},
+	{"timing", no_argument,       0, 'T'},
 	{0, 0, 0, 0}
       };
     /* getopt_long stores the option index here. */
     int option_index = 0;
 
-    int c = getopt_long (argc, argv, "s:v:i:n:t:r:a:f:x:w:d:",
+    int c = getopt_long (argc, argv, "s:v:i:n:t:r:a:f:x:w:d:T",
                          long_options, &option_index);
     /* Detect the end of the options. */
     if (c == -1)
@@ -136,6 +138,9 @@ ParseArgs(int argc, char** argv)
     case 'd':
       range_threshold = atof(optarg);
       break;
+    case 'T':
+      timing = 1;
+      break;
     case 'a':
       autopilot_parms.start_alt = atof(optarg);
       break;
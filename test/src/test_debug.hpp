@@ -37,6 +37,7 @@ char WaitPrompt();
 extern int interactive;
 extern int verbose;
 extern int output_skip;
+extern int timing;
 
 extern AutopilotParameters autopilot_parms;
 
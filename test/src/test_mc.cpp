@@ -27,8 +27,11 @@
 #include "GlideSolvers/GlideResult.hpp"
 #include "GlideSolvers/MacCready.hpp"
 #include "Navigation/Aircraft.hpp"
+#include "Math/ZeroFinder.hpp"
 #include "system/FileUtil.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <stdio.h>
 #include <fstream>
 #include <string>
@@ -270,15 +273,111 @@ test_cb()
   return true;
 }
 
-int main() {
+/**
+ * Iterative speed to fly search, as GlidePolar::SpeedToFly() did it
+ * before it was solved analytically.  Used as reference.
+ */
+class ReferenceSpeedToFly final : public ZeroFinder {
+  const GlidePolar &polar;
+  const double net_sink_rate;
+  const double head_wind;
+
+public:
+  ReferenceSpeedToFly(const GlidePolar &_polar, const double _net_sink_rate,
+                      const double _head_wind)
+    :ZeroFinder(std::max(1., _polar.GetVMin() - _head_wind),
+                _polar.GetVMax() - _head_wind, 0.0001),
+     polar(_polar), net_sink_rate(_net_sink_rate), head_wind(_head_wind) {}
+
+  double f(const double V) override {
+    return (polar.MSinkRate(V + head_wind) + net_sink_rate) / V;
+  }
+
+  double Solve() {
+    return find_min(xmax) + head_wind;
+  }
+};
+
+static constexpr double stf_mc[] = { 0, 0.5, 1, 2, 4 };
+static constexpr double stf_head_wind[] = { -10, -5, 0, 5, 10, 15 };
+
+static bool
+test_stf_accuracy()
+{
+  double max_error = 0;
+
+  for (const double mc : stf_mc) {
+    GlidePolar polar(mc);
+
+    for (const double head_wind : stf_head_wind) {
+      for (double S = -3; S <= 3; S += 0.25) {
+        const double v = polar.SpeedToFly(S, head_wind);
+        const double v_ref = ReferenceSpeedToFly(polar, S, head_wind).Solve();
+        max_error = std::max(max_error, fabs(v - v_ref));
+      }
+    }
+  }
+
+  if (verbose || max_error >= 0.01)
+    printf("# stf max error %g m/s\n", max_error);
+
+  return max_error < 0.01;
+}
 
-  plan_tests(3);
+static void
+benchmark_stf()
+{
+  constexpr unsigned n = 200;
+
+  double sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  unsigned calls = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    for (const double mc : stf_mc) {
+      GlidePolar polar(mc);
+      for (const double head_wind : stf_head_wind) {
+        for (double S = -3; S <= 3; S += 0.25, ++calls)
+          sum += polar.SpeedToFly(S, head_wind);
+      }
+    }
+  }
+  const std::chrono::duration<double> analytic =
+    std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    for (const double mc : stf_mc) {
+      GlidePolar polar(mc);
+      for (const double head_wind : stf_head_wind) {
+        for (double S = -3; S <= 3; S += 0.25)
+          sum += ReferenceSpeedToFly(polar, S, head_wind).Solve();
+      }
+    }
+  }
+  const std::chrono::duration<double> iterative =
+    std::chrono::steady_clock::now() - start;
+
+  printf("# SpeedToFly: analytic %.0f, iterative %.0f calls/ms (%g)\n",
+         calls / (analytic.count() * 1000),
+         calls / (iterative.count() * 1000), sum);
+}
+
+int main(int argc, char **argv) {
+
+  if (!ParseArgs(argc, argv))
+    return 0;
+
+  plan_tests(4);
 
   Directory::Create(Path(_T("output/results")));
 
   ok(test_mc(),"mc output",0);
   ok(test_stf(),"mc stf",0);
   ok(test_cb(),"cruise bearing",0);
+  ok(test_stf_accuracy(),"stf accuracy",0);
+
+  if (timing)
+    benchmark_stf();
 
   return exit_status();
 
@@ -23,6 +23,15 @@
 #include "harness_flight.hpp"
 #include "harness_wind.hpp"
 #include "test_debug.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "GlideSolvers/GlideState.hpp"
+#include "GlideSolvers/GlideResult.hpp"
+#include "GlideSolvers/MacCready.hpp"
+#include "Math/ZeroFinder.hpp"
+
+#include <algorithm>
+#include <chrono>
 
 extern "C" {
 #include "tap.h"
@@ -56,6 +65,115 @@ test_speed_factor(int test_num, int n_wind)
   return retval;
 }
 
+/**
+ * Full range search for the glide speed which minimises the height
+ * loss per distance, as MacCready::OptimiseGlide() did it before it
+ * started from the analytic solution.  Used as reference.
+ */
+class ReferenceVopt final : public ZeroFinder {
+  const MacCready &mac;
+  const GlideState &task;
+
+public:
+  ReferenceVopt(const MacCready &_mac, const GlidePolar &polar,
+                const GlideState &_task)
+    :ZeroFinder(polar.GetVMin(), polar.GetVMax(), 0.001),
+     mac(_mac), task(_task) {}
+
+  double f(const double v) override {
+    const GlideResult res = mac.SolveGlide(task, v);
+    if (!res.IsOk() || res.vector.distance <= 0)
+      return 1000000;
+
+    return res.height_glide * 1024 / res.vector.distance;
+  }
+
+  double Solve() {
+    return f(find_min(xmin)) / 1024;
+  }
+};
+
+static double
+GlideRatio(const GlideResult &result)
+{
+  return result.height_glide / result.vector.distance;
+}
+
+static constexpr double vopt_wind[] = { 0, 5, 10, 15 };
+
+static bool
+test_vopt_accuracy()
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+
+  GlidePolar polar(0);
+  const MacCready mac(settings, polar);
+
+  double max_error = 0;
+
+  for (const double wind : vopt_wind) {
+    for (unsigned bearing = 0; bearing < 360; bearing += 15) {
+      const SpeedVector wind_vector(Angle::Degrees(bearing), wind);
+      const GlideState task(GeoVector(20000, Angle::Zero()), 0, 2000,
+                            wind_vector);
+
+      const double ratio = GlideRatio(mac.Solve(task));
+      const double ratio_ref = ReferenceVopt(mac, polar, task).Solve();
+      max_error = std::max(max_error, ratio / ratio_ref - 1);
+    }
+  }
+
+  if (verbose || max_error >= 1e-4)
+    printf("# vopt max relative error %g\n", max_error);
+
+  return max_error < 1e-4;
+}
+
+static void
+benchmark_vopt()
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+
+  GlidePolar polar(0);
+  const MacCready mac(settings, polar);
+
+  constexpr unsigned n = 200;
+
+  double sum = 0;
+  unsigned calls = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    for (const double wind : vopt_wind) {
+      for (unsigned bearing = 0; bearing < 360; bearing += 15, ++calls) {
+        const GlideState task(GeoVector(20000, Angle::Zero()), 0, 2000,
+                              SpeedVector(Angle::Degrees(bearing), wind));
+        sum += GlideRatio(mac.Solve(task));
+      }
+    }
+  }
+  const std::chrono::duration<double> current =
+    std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    for (const double wind : vopt_wind) {
+      for (unsigned bearing = 0; bearing < 360; bearing += 15) {
+        const GlideState task(GeoVector(20000, Angle::Zero()), 0, 2000,
+                              SpeedVector(Angle::Degrees(bearing), wind));
+        sum += ReferenceVopt(mac, polar, task).Solve();
+      }
+    }
+  }
+  const std::chrono::duration<double> reference =
+    std::chrono::steady_clock::now() - start;
+
+  printf("# OptimiseGlide: %.0f calls/ms, full search %.0f calls/ms (%g)\n",
+         calls / (current.count() * 1000),
+         calls / (reference.count() * 1000), sum);
+}
+
 int
 main(int argc, char** argv)
 {
@@ -66,7 +184,12 @@ main(int argc, char** argv)
     return 0;
 
   unsigned i = rand() % NUM_WIND;
-  plan_tests(2);
+  plan_tests(3);
+
+  ok(test_vopt_accuracy(), "vopt accuracy", 0);
+
+  if (timing)
+    benchmark_vopt();
 
   // tests whether flying at VOpt for OR task is optimal
   test_speed_factor(3, i);